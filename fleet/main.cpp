@@ -0,0 +1,461 @@
+/**
+ * ============================================================================
+ * BINSAI Fleet Tool
+ * Host-side command line for fleet ingestion (build: pio run -e fleet)
+ * ============================================================================
+ *
+ * USAGE:
+ *   binsai-fleet serve   [--port N] [--workers N]
+ *   binsai-fleet loadgen [--host A] [--port N] [--bins N] [--rate N] [--seconds N] [--threads N]
+ *   binsai-fleet bench   [--bins N] [--rate N] [--seconds N] [--workers N] [--threads N]
+ *   binsai-fleet route   [--bins N] [--seed N] [--capacity L] [--threads N]
+ *   binsai-fleet lorasim [--bins N] [--interval S] [--sf N] [--channels N] [--payload B]
+ *                        [--duty PERMILLE] [--hours N] [--seed N]
+ *   binsai-fleet ota-keygen --out KEY
+ *   binsai-fleet ota-pack --new BIN --key KEY --version V --security-version N [--old BIN] --out FILE
+ *   binsai-fleet perf-compare BASELINE CANDIDATE [--tolerance PCT] [--tail PCT] [--floor-us US]
+ *
+ * `serve` is the local stand-in for the cloud endpoint and prints ingest
+ * statistics every 5 s. `bench` runs server and load generator in one
+ * process over loopback and reports throughput and latency percentiles.
+ * `route` plans collection routes for a deterministic synthetic city.
+ * `lorasim` models bins sharing a LoRa channel. Without --interval it
+ * sweeps common reporting intervals so one can be chosen before buying
+ * radios.
+ * `ota-keygen` writes an Ed25519 signing seed and prints the public key to
+ * paste into src/main.cpp. `ota-pack` builds a signed update file (delta
+ * against --old when given, otherwise the full image), reports full and
+ * delta payload sizes and replays the patch in memory before writing it.
+ * --security-version must exceed FIRMWARE_SECURITY_VERSION of the units
+ * to update (they refuse anything at or below their own).
+ * `perf-compare` reads two binsai-perf reports (BENCH console capture or
+ * benchmark log) and exits 1 if a case regressed or disappeared.
+ * ============================================================================
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <FleetStore.h>
+#include <IngestServer.h>
+#include <LoadGenerator.h>
+#include <LatencyHistogram.h>
+#include <RoutePlanner.h>
+#include <LoraAirtime.h>
+#include <LoraUplink.h>
+#include <DeltaPatch.h>
+#include <FirmwareUpdate.h>
+#include <PerfCompare.h>
+
+#define FLEET_REPORT_INTERVAL_S     5
+
+static std::atomic<bool> stop_requested(false);
+
+static void handleSignal(int) {
+    stop_requested = true;
+}
+
+/**
+ * Look up "--name value" in argv
+ * @return Parsed value, or fallback if absent
+ */
+static long optionLong(int argc, char** argv, const char* name, long fallback) {
+    for (int i = 2; i + 1 < argc; i++) {
+        if (strcmp(argv[i], name) == 0) {
+            return strtol(argv[i + 1], NULL, 10);
+        }
+    }
+    return fallback;
+}
+
+static const char* optionString(int argc, char** argv, const char* name, const char* fallback) {
+    for (int i = 2; i + 1 < argc; i++) {
+        if (strcmp(argv[i], name) == 0) {
+            return argv[i + 1];
+        }
+    }
+    return fallback;
+}
+
+static void printLatency(const LatencyHistogram& histogram) {
+    printf("[FLEET] latency us: p50=%u p90=%u p99=%u p99.9=%u max=%u mean=%.1f (n=%llu)\n",
+           histogram.percentile(50), histogram.percentile(90), histogram.percentile(99),
+           histogram.percentile(99.9), histogram.max(), histogram.mean(),
+           (unsigned long long)histogram.count());
+}
+
+static int commandServe(int argc, char** argv) {
+    uint16_t port = (uint16_t)optionLong(argc, argv, "--port", FLEET_DEFAULT_PORT);
+    unsigned workers = (unsigned)optionLong(argc, argv, "--workers", std::thread::hardware_concurrency());
+
+    FleetStore store;
+    IngestServer server(store);
+    if (!server.start(port, workers)) {
+        return 1;
+    }
+    printf("[FLEET] listening on udp/%u with %u workers\n", server.port(), workers);
+
+    IngestStats_t previous;
+    memset(&previous, 0, sizeof(previous));
+    while (!stop_requested) {
+        for (int i = 0; i < FLEET_REPORT_INTERVAL_S * 10 && !stop_requested; i++) {
+            usleep(100000);
+        }
+        IngestStats_t now = server.stats();
+        LatencyHistogram latency;
+        server.latency(&latency);
+        printf("[FLEET] %zu bins, %.0f frames/s, accepted=%llu dup=%llu invalid=%llu\n",
+               store.binCount(), (double)(now.accepted - previous.accepted) / FLEET_REPORT_INTERVAL_S,
+               (unsigned long long)now.accepted, (unsigned long long)now.duplicates,
+               (unsigned long long)now.invalid);
+        if (latency.count() > 0) {
+            printLatency(latency);
+        }
+        server.resetLatency();
+        previous = now;
+    }
+
+    server.stop();
+    return 0;
+}
+
+static void loadConfigFromArgs(int argc, char** argv, LoadGeneratorConfig_t* config) {
+    loadGeneratorDefaults(config);
+    config->host = optionString(argc, argv, "--host", config->host);
+    config->port = (uint16_t)optionLong(argc, argv, "--port", config->port);
+    config->bin_count = (uint32_t)optionLong(argc, argv, "--bins", config->bin_count);
+    config->rate_per_second = (uint32_t)optionLong(argc, argv, "--rate", config->rate_per_second);
+    config->duration_ms = (uint32_t)optionLong(argc, argv, "--seconds", config->duration_ms / 1000) * 1000;
+    config->thread_count = (unsigned)optionLong(argc, argv, "--threads", config->thread_count);
+}
+
+static int commandLoadgen(int argc, char** argv) {
+    LoadGeneratorConfig_t config;
+    loadConfigFromArgs(argc, argv, &config);
+
+    printf("[LOADGEN] %u bins -> %s:%u at %u frames/s for %u ms\n", config.bin_count, config.host,
+           config.port, config.rate_per_second, config.duration_ms);
+    LoadGeneratorResult_t result = runLoadGenerator(config, &stop_requested);
+    printf("[LOADGEN] sent %llu frames in %u ms (%.0f frames/s), %llu send errors\n",
+           (unsigned long long)result.frames_sent, result.elapsed_ms,
+           result.elapsed_ms ? result.frames_sent * 1000.0 / result.elapsed_ms : 0.0,
+           (unsigned long long)result.send_errors);
+    return 0;
+}
+
+static int commandBench(int argc, char** argv) {
+    LoadGeneratorConfig_t config;
+    loadConfigFromArgs(argc, argv, &config);
+    unsigned workers = (unsigned)optionLong(argc, argv, "--workers", 2);
+
+    FleetStore store;
+    IngestServer server(store);
+    if (!server.start(0, workers)) {
+        return 1;
+    }
+    config.host = "127.0.0.1";
+    config.port = server.port();
+
+    LoadGeneratorResult_t result = runLoadGenerator(config, &stop_requested);
+    usleep(200000);  // Drain socket buffers
+    server.stop();
+
+    IngestStats_t stats = server.stats();
+    LatencyHistogram latency;
+    server.latency(&latency);
+
+    printf("[FLEET] bins=%u tracked=%zu sent=%llu accepted=%llu lost=%.2f%%\n", config.bin_count,
+           store.binCount(), (unsigned long long)result.frames_sent,
+           (unsigned long long)stats.accepted,
+           result.frames_sent ? 100.0 * (result.frames_sent - stats.accepted) / result.frames_sent : 0.0);
+    printf("[FLEET] ingest throughput: %.0f frames/s\n",
+           result.elapsed_ms ? stats.accepted * 1000.0 / result.elapsed_ms : 0.0);
+    printLatency(latency);
+    return 0;
+}
+
+static int commandRoute(int argc, char** argv) {
+    uint32_t bins = (uint32_t)optionLong(argc, argv, "--bins", 500);
+    uint32_t seed = (uint32_t)optionLong(argc, argv, "--seed", 1);
+
+    RoutePlannerConfig_t config;
+    routePlannerDefaults(&config);
+    config.vehicle_capacity = (float)optionLong(argc, argv, "--capacity", (long)config.vehicle_capacity);
+    config.thread_count = (unsigned)optionLong(argc, argv, "--threads", 0);
+
+    std::vector<RouteStop_t> stops;
+    routeSyntheticCity(bins, seed, &stops);
+    RoutePlan_t plan = RoutePlanner(config).plan(stops);
+
+    for (size_t r = 0; r < plan.routes.size(); r++) {
+        const Route_t& route = plan.routes[r];
+        printf("[ROUTE] truck %zu: %zu stops, %.0f L, %.1f km, priority %u\n", r + 1,
+               route.stops.size(), route.load, route.length_m / 1000.0, route.max_priority);
+    }
+    printf("[ROUTE] %u bins -> %zu trucks, %.1f km total (%.1f km before 2-opt/Or-opt), %.1f ms\n",
+           bins, plan.routes.size(), plan.total_length_m / 1000.0, plan.savings_length_m / 1000.0,
+           plan.graph_ms + plan.savings_ms + plan.improve_ms);
+    return 0;
+}
+
+static int commandLoraSim(int argc, char** argv) {
+    static const uint32_t SWEEP_INTERVALS_S[] = { 60, 120, 300, 600, 900, 1800, 3600 };
+
+    LoraSimConfig_t config;
+    loraSimDefaults(&config);
+    config.bins = (uint32_t)optionLong(argc, argv, "--bins", config.bins);
+    loraRadioDefaults(&config.radio, (uint8_t)optionLong(argc, argv, "--sf", config.radio.spreading_factor));
+    config.channels = (uint8_t)optionLong(argc, argv, "--channels", config.channels);
+    config.payload_bytes = (uint8_t)optionLong(argc, argv, "--payload", LORA_UPLINK_STATUS_SIZE);
+    config.duty_cycle = optionLong(argc, argv, "--duty", (long)(config.duty_cycle * 1000)) / 1000.0;
+    config.duration_s = (uint32_t)optionLong(argc, argv, "--hours", config.duration_s / 3600) * 3600;
+    config.seed = (uint32_t)optionLong(argc, argv, "--seed", config.seed);
+    long interval = optionLong(argc, argv, "--interval", 0);
+
+    if (config.radio.spreading_factor < 7 || config.radio.spreading_factor > 12 || config.channels == 0) {
+        fprintf(stderr, "[LORA] --sf must be 7..12 and --channels at least 1\n");
+        return 2;
+    }
+
+    printf("[LORA] %u bins, SF%u/125kHz, %u-byte payload, %.1f ms on air, %u channels, duty %.1f %% (min interval %.0f s)\n",
+           config.bins, config.radio.spreading_factor, config.payload_bytes,
+           loraAirtimeMs(config.radio, config.payload_bytes), config.channels, config.duty_cycle * 100.0,
+           config.duty_cycle > 0.0 ? loraAirtimeMs(config.radio, config.payload_bytes) / 1000.0 / config.duty_cycle : 0.0);
+    printf("[LORA] interval_s  uplinks/h  load_G  delivered  aloha  deferred\n");
+
+    size_t count = interval > 0 ? 1 : sizeof(SWEEP_INTERVALS_S) / sizeof(SWEEP_INTERVALS_S[0]);
+    for (size_t i = 0; i < count; i++) {
+        config.interval_s = interval > 0 ? (uint32_t)interval : SWEEP_INTERVALS_S[i];
+        LoraSimResult_t result = loraSimulateChannel(config);
+        printf("[LORA] %10u  %9.0f  %6.3f  %8.2f%%  %4.1f%%  %8llu\n", config.interval_s,
+               result.transmissions * 3600.0 / config.duration_s, result.offered_load,
+               result.delivery_ratio * 100.0, result.aloha_expected * 100.0,
+               (unsigned long long)result.duty_deferred);
+    }
+    return 0;
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>* data) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    uint8_t buffer[65536];
+    size_t length;
+    data->clear();
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data->insert(data->end(), buffer, buffer + length);
+    }
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+static bool writeFile(const char* path, const void* data, size_t length) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(data, 1, length, file) == length;
+    return fclose(file) == 0 && ok;
+}
+
+static int commandOtaKeygen(int argc, char** argv) {
+    const char* out = optionString(argc, argv, "--out", NULL);
+    if (!out) {
+        fprintf(stderr, "[OTA] --out is required\n");
+        return 2;
+    }
+
+    uint8_t seed[ED25519_SEED_SIZE];
+    FILE* random = fopen("/dev/urandom", "rb");
+    bool ok = random && fread(seed, 1, sizeof(seed), random) == sizeof(seed);
+    if (random) fclose(random);
+    if (!ok || !writeFile(out, seed, sizeof(seed)) || chmod(out, 0600) != 0) {
+        fprintf(stderr, "[OTA] cannot create %s\n", out);
+        return 1;
+    }
+
+    uint8_t public_key[ED25519_PUBLIC_KEY_SIZE];
+    ed25519PublicKey(seed, public_key);
+    printf("[OTA] signing seed written to %s (keep it off the devices)\n", out);
+    printf("const uint8_t OTA_SIGNING_PUBLIC_KEY[32] = {");
+    for (size_t i = 0; i < sizeof(public_key); i++) {
+        printf("%s0x%02x", i % 8 ? ", " : (i ? ",\n    " : "\n    "), public_key[i]);
+    }
+    printf("\n};\n");
+    return 0;
+}
+
+/**
+ * Replays a payload against the base image without touching flash
+ */
+class MemoryPatchIo : public PatchSource, public PatchSink {
+public:
+    explicit MemoryPatchIo(const std::vector<uint8_t>& source) : _source(source) {}
+
+    bool readSource(uint32_t offset, void* buffer, size_t length) override {
+        if ((size_t)offset + length > _source.size()) return false;
+        memcpy(buffer, _source.data() + offset, length);
+        return true;
+    }
+
+    bool writeTarget(const void* data, size_t length) override {
+        target.insert(target.end(), (const uint8_t*)data, (const uint8_t*)data + length);
+        return true;
+    }
+
+    std::vector<uint8_t> target;
+
+private:
+    const std::vector<uint8_t>& _source;
+};
+
+static int commandOtaPack(int argc, char** argv) {
+    const char* new_path = optionString(argc, argv, "--new", NULL);
+    const char* old_path = optionString(argc, argv, "--old", NULL);
+    const char* key_path = optionString(argc, argv, "--key", NULL);
+    const char* version = optionString(argc, argv, "--version", NULL);
+    long security_version = optionLong(argc, argv, "--security-version", 0);
+    const char* out = optionString(argc, argv, "--out", NULL);
+    if (!new_path || !key_path || !version || !out || strlen(version) >= FIRMWARE_VERSION_MAX ||
+        security_version <= 0 || (unsigned long)security_version > 0xFFFFFFFFUL) {
+        fprintf(stderr, "[OTA] --new, --key, --version (< %d chars), --security-version (> 0) and --out are required\n",
+                FIRMWARE_VERSION_MAX);
+        return 2;
+    }
+
+    std::vector<uint8_t> image, base, seed;
+    if (!readFile(new_path, &image) || image.empty() || (old_path && !readFile(old_path, &base)) ||
+        !readFile(key_path, &seed) || seed.size() != ED25519_SEED_SIZE) {
+        fprintf(stderr, "[OTA] cannot read image, base image or 32-byte key\n");
+        return 1;
+    }
+
+    FirmwareManifest_t manifest;
+    memset(&manifest, 0, sizeof(manifest));
+    manifest.magic = FIRMWARE_MANIFEST_MAGIC;
+    manifest.format = FIRMWARE_MANIFEST_FORMAT;
+    memcpy(manifest.version, version, strlen(version));   // Length checked above, rest stays NUL
+    manifest.security_version = (uint32_t)security_version;
+    manifest.target_size = (uint32_t)image.size();
+    Sha512::hash(image.data(), image.size(), manifest.target_digest);
+
+    std::vector<uint8_t> full, delta;
+    DeltaPatchStats_t full_stats, delta_stats;
+    deltaPatchCreate(NULL, 0, image.data(), image.size(), &full, &full_stats);
+    printf("[OTA] image %zu B, full payload %u B (%.1f%%)\n", image.size(), full_stats.patch_bytes,
+           100.0 * full_stats.patch_bytes / image.size());
+
+    const std::vector<uint8_t>* payload = &full;
+    if (old_path) {
+        deltaPatchCreate(base.data(), base.size(), image.data(), image.size(), &delta, &delta_stats);
+        printf("[OTA] delta payload %u B (%.2f%% of full): %u records, %u diff B (%u changed), %u new B\n",
+               delta_stats.patch_bytes, 100.0 * delta_stats.patch_bytes / full_stats.patch_bytes,
+               delta_stats.records, delta_stats.diff_bytes, delta_stats.diff_nonzero, delta_stats.extra_bytes);
+        manifest.flags = FIRMWARE_FLAG_DELTA;
+        manifest.source_size = (uint32_t)base.size();
+        Sha512::hash(base.data(), base.size(), manifest.source_digest);
+        payload = &delta;
+    }
+    manifest.payload_size = (uint32_t)payload->size();
+    firmwareManifestSign(&manifest, seed.data());
+
+    MemoryPatchIo replay(base);
+    DeltaPatchApplier applier(replay, replay);
+    if (applier.write(payload->data(), payload->size()) != DELTA_APPLY_DONE || replay.target != image) {
+        fprintf(stderr, "[OTA] replay of the payload did not reproduce the image\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> file((const uint8_t*)&manifest, (const uint8_t*)&manifest + sizeof(manifest));
+    file.insert(file.end(), payload->begin(), payload->end());
+    if (!writeFile(out, file.data(), file.size())) {
+        fprintf(stderr, "[OTA] cannot write %s\n", out);
+        return 1;
+    }
+    printf("[OTA] %s: %s (security %u) %s, %zu B (manifest %zu + payload %u)\n", out, version,
+           manifest.security_version, old_path ? "delta" : "full", file.size(), sizeof(manifest),
+           manifest.payload_size);
+    return 0;
+}
+
+static bool readPerfReport(const char* path, PerfReport_t* report) {
+    std::vector<uint8_t> text;
+    std::string error;
+    if (!readFile(path, &text)) {
+        fprintf(stderr, "[PERF] cannot read %s\n", path);
+        return false;
+    }
+    if (!perfReportParse((const char*)text.data(), text.size(), report, &error)) {
+        fprintf(stderr, "[PERF] %s: %s\n", path, error.c_str());
+        return false;
+    }
+    return true;
+}
+
+static int commandPerfCompare(int argc, char** argv) {
+    if (argc < 4 || argv[2][0] == '-' || argv[3][0] == '-') {
+        fprintf(stderr, "[PERF] usage: perf-compare BASELINE CANDIDATE [--tolerance PCT] [--tail PCT] [--floor-us US]\n");
+        return 2;
+    }
+    PerfReport_t baseline, candidate;
+    if (!readPerfReport(argv[2], &baseline) || !readPerfReport(argv[3], &candidate)) {
+        return 2;
+    }
+    if (baseline.target != candidate.target) {
+        fprintf(stderr, "[PERF] warning: comparing target %s with %s\n",
+                baseline.target.c_str(), candidate.target.c_str());
+    }
+
+    PerfCompareConfig_t config;
+    perfCompareDefaults(&config, baseline.target.c_str());
+    const char* tolerance = optionString(argc, argv, "--tolerance", NULL);
+    const char* tail = optionString(argc, argv, "--tail", NULL);
+    const char* floor_us = optionString(argc, argv, "--floor-us", NULL);
+    if (tolerance) config.tolerance_pct = (float)strtod(tolerance, NULL);
+    if (tail) config.tail_tolerance_pct = (float)strtod(tail, NULL);
+    if (floor_us) config.floor_us = (float)strtod(floor_us, NULL);
+
+    std::vector<PerfComparison_t> results;
+    size_t failing = perfCompare(baseline, candidate, config, &results);
+
+    printf("[PERF] %s (%s %s) -> %s (%s %s): median +%.0f%%, p99 +%.0f%% (0 = off), floor %.3f us\n",
+           baseline.firmware.c_str(), baseline.target.c_str(), baseline.device.c_str(),
+           candidate.firmware.c_str(), candidate.target.c_str(), candidate.device.c_str(),
+           config.tolerance_pct, config.tail_tolerance_pct, config.floor_us);
+    for (size_t i = 0; i < results.size(); i++) {
+        const PerfComparison_t& result = results[i];
+        printf("[PERF] %-22s %-9s %-8s %12.3f -> %12.3f (%+.1f%%)\n", result.name.c_str(),
+               perfVerdictName(result.verdict), result.metric, result.baseline, result.candidate,
+               result.change_pct);
+    }
+    printf("[PERF] %zu of %zu cases regressed or missing\n", failing, baseline.cases.size());
+    return failing > 0 ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+
+    const char* command = argc > 1 ? argv[1] : "";
+    if (strcmp(command, "serve") == 0) return commandServe(argc, argv);
+    if (strcmp(command, "loadgen") == 0) return commandLoadgen(argc, argv);
+    if (strcmp(command, "bench") == 0) return commandBench(argc, argv);
+    if (strcmp(command, "route") == 0) return commandRoute(argc, argv);
+    if (strcmp(command, "lorasim") == 0) return commandLoraSim(argc, argv);
+    if (strcmp(command, "ota-keygen") == 0) return commandOtaKeygen(argc, argv);
+    if (strcmp(command, "ota-pack") == 0) return commandOtaPack(argc, argv);
+    if (strcmp(command, "perf-compare") == 0) return commandPerfCompare(argc, argv);
+
+    fprintf(stderr, "usage: %s serve|loadgen|bench|route|lorasim|ota-keygen|ota-pack|perf-compare [options]\n", argv[0]);
+    return 2;
+}
@@ -0,0 +1,130 @@
+/**
+ * ============================================================================
+ * BINSAI Shared Data Definitions
+ * Telemetry and configuration structures used by firmware, lib/ modules and
+ * host-side tools
+ * ============================================================================
+ *
+ * SystemConfig_t is persisted as a binary blob (see lib/ConfigStore).
+ * Schema rules:
+ * - Append new fields at the END of the structure only
+ * - Bump CONFIG_SCHEMA_VERSION and add a migration hook for the new fields
+ * ============================================================================
+ */
+
+#ifndef BINSAI_DEFINITIONS_H
+#define BINSAI_DEFINITIONS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// CLASSIFICATION DEFAULTS (loaded into SystemConfig_t on first boot)
+// ============================================================================
+
+// Capacity Thresholds (Based on Section 3.4.1), level = count of breakpoints exceeded
+#define THRESHOLD_EMPTY_PERCENT     35.0f         // <=35%: Empty
+#define THRESHOLD_HALF_PERCENT      50.0f         // >35-50%: Half
+#define THRESHOLD_ALMOST_FULL       90.0f         // >50-90%: Almost Full, >90%: Full
+
+// Gas Concentration Thresholds (Based on Appendix 5)
+#define PPM_CLEAN_AIR_MAX           199.0f        // <=199 ppm: Clean/Normal
+#define PPM_INORGANIC_MAX           449.0f        // >199-449 ppm: Inorganic/Light odor
+#define PPM_ORGANIC_L1_MAX          800.0f        // >449-800 ppm: Organic L1, >800: Organic L2
+
+// Hysteresis and dwell (suppress level flapping at a boundary)
+#define CAPACITY_HYSTERESIS_PERCENT 2.0f          // Band around each capacity breakpoint
+#define GAS_HYSTERESIS_PPM          15.0f         // Band around each gas breakpoint
+#define CLASSIFICATION_DWELL_MS     6000          // New level must hold 3 sample intervals
+
+#define CLASSIFICATION_LEVEL_COUNT  4             // Levels 0-3
+#define CLASSIFICATION_BREAKPOINTS  (CLASSIFICATION_LEVEL_COUNT - 1)
+
+/**
+ * Sensor Data Structure
+ * Contains all telemetry data from sensor array
+ */
+typedef struct {
+    // Ultrasonic Sensor Data
+    float distance_cm;              // Measured distance in centimeters
+    float fill_percentage;          // Calculated fill percentage (0-100%)
+    float distance_spread_cm;       // Surface roughness across the ping burst
+    uint8_t distance_confidence;    // Burst confidence (0-100), see lib/UltrasonicBurst
+    float peak_fill_percentage;     // Highest probe of the array (0-100%)
+    uint8_t probes_used;            // Probes in the fused reading, see lib/ProbeArray
+    
+    // Gas Sensor Data
+    uint16_t adc_raw;              // Raw ADC value from MQ-135
+    uint16_t gas_millivolts;        // MQ-135 output after ADC calibration
+    float ppm_calculated;           // Calculated PPM value
+    float r0_calibrated;            // Calibrated R0 value
+    
+    // GPS Data
+    double latitude;                // Latitude in decimal degrees
+    double longitude;               // Longitude in decimal degrees
+    uint8_t satellite_count;        // Number of visible satellites
+    float hdop;                     // Horizontal dilution of precision
+    
+    // Derived Classification
+    uint8_t capacity_level;         // 0=Empty, 1=Half, 2=Almost Full, 3=Full
+    uint8_t waste_classification;   // 0=Clean, 1=Inorganic, 2=Organic L1, 3=Organic L2
+    uint8_t priority_level;         // 0-3 scale (0=Normal, 3=Critical)
+    
+    // Timestamps
+    uint32_t timestamp_unix;        // Unix timestamp
+    uint32_t timestamp_millis;      // Millisecond timestamp
+    
+    // Forecast
+    float hours_to_full;            // Predicted hours until 100% (-1 = unknown)
+    
+    // Environment (SHT3x or defaults, see lib/EnvCompensation)
+    float temperature_c;            // Air temperature used for compensation
+    float humidity_pct;             // Relative humidity used for compensation
+} SensorData_t;
+
+/**
+ * System Configuration Structure
+ * Contains all configurable system parameters
+ */
+typedef struct {
+    // Device Identification
+    char device_id[32];             // Unique device identifier
+    char firmware_version[16];      // Firmware version string
+    
+    // Network Configuration
+    char wifi_ssid[32];             // WiFi SSID
+    char wifi_password[32];         // WiFi password
+    char blynk_auth_token[34];      // Blynk authentication token
+    
+    // Calibration Parameters
+    float ultrasonic_offset_cm;     // Ultrasonic sensor mounting offset
+    float mq135_r0_calibrated;      // Calibrated R0 value for MQ-135
+    float mq135_temp_compensation;  // Extra ppm trim factor (1.0 = none; T curve in lib/EnvCompensation)
+    float mq135_humidity_compensation; // Extra ppm trim factor (1.0 = none; RH curve in lib/EnvCompensation)
+    
+    // Operational Thresholds
+    float critical_capacity_threshold;  // Capacity threshold for critical alerts
+    float critical_gas_threshold;       // Gas threshold for critical alerts
+    uint32_t sms_cooldown_period;       // Minimum time between SMS batches
+    
+    // Modular Configuration
+    bool is_modular_unit;           // True if device is modular deployment
+    uint8_t deployment_zone;        // Deployment zone identifier
+    char location_description[64];  // Human-readable location description
+    
+    // Classification Tables (schema v2)
+    float capacity_breakpoints[CLASSIFICATION_BREAKPOINTS];  // Ascending fill % breakpoints
+    float gas_breakpoints[CLASSIFICATION_BREAKPOINTS];       // Ascending ppm breakpoints
+    float capacity_hysteresis;      // Hysteresis band for capacity (%)
+    float gas_hysteresis;           // Hysteresis band for gas (ppm)
+    uint32_t classification_dwell_ms;   // Minimum time before a level change
+    
+    // MQ-135 Auto-Baseline (schema v3)
+    float mq135_r0_confidence;      // Trust in mq135_r0_calibrated (0-100, 0 = default)
+    bool mq135_auto_baseline;       // Background R0 recalibration enabled
+    
+    // Ultrasonic Probe Array (schema v4)
+    uint8_t ultrasonic_probe_count; // HC-SR04 probes fitted (1-4, see lib/ProbeArray)
+} SystemConfig_t;
+
+#endif  // BINSAI_DEFINITIONS_H
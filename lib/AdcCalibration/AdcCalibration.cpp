@@ -0,0 +1,105 @@
+/**
+ * BINSAI ADC Calibration - LUT construction, lookup and bench fit
+ */
+
+#include "AdcCalibration.h"
+#include <string.h>
+
+#define SEGMENT_COUNTS      (1 << ADC_LUT_SHIFT)
+
+uint16_t adcLutKnotRaw(uint8_t knot) {
+    uint32_t raw = (uint32_t)knot << ADC_LUT_SHIFT;
+    return raw > ADC_RAW_MAX ? ADC_RAW_MAX : (uint16_t)raw;
+}
+
+void adcLutLinear(AdcLut_t* lut, uint16_t full_scale_mv) {
+    for (uint8_t i = 0; i < ADC_LUT_POINTS; i++) {
+        lut->mv[i] = (uint16_t)(((uint32_t)adcLutKnotRaw(i) * full_scale_mv + ADC_RAW_MAX / 2) / ADC_RAW_MAX);
+    }
+}
+
+bool adcCorrectionIsValid(const AdcCorrection_t* correction) {
+    return correction->magic == ADC_CORRECTION_MAGIC && correction->points >= 2 &&
+           correction->points <= ADC_BENCH_MAX_POINTS;
+}
+
+void adcLutApplyCorrection(AdcLut_t* lut, const AdcCorrection_t* correction) {
+    if (!adcCorrectionIsValid(correction)) {
+        return;
+    }
+    for (uint8_t i = 0; i < ADC_LUT_POINTS; i++) {
+        int32_t mv = (int32_t)lut->mv[i] + correction->offset_mv[i];
+        if (mv < 0) mv = 0;
+        if (mv > UINT16_MAX) mv = UINT16_MAX;
+        lut->mv[i] = (uint16_t)mv;
+    }
+}
+
+uint16_t adcLutMillivolts(const AdcLut_t* lut, uint16_t raw) {
+    if (raw >= ADC_RAW_MAX) {
+        return lut->mv[ADC_LUT_POINTS - 1];
+    }
+
+    uint8_t knot = (uint8_t)(raw >> ADC_LUT_SHIFT);
+    int32_t fraction = raw & (SEGMENT_COUNTS - 1);
+    // The last segment ends at ADC_RAW_MAX, one count short
+    int32_t width = (knot == ADC_LUT_POINTS - 2) ? SEGMENT_COUNTS - 1 : SEGMENT_COUNTS;
+    int32_t delta = (int32_t)lut->mv[knot + 1] - lut->mv[knot];
+    int32_t rounding = delta >= 0 ? width / 2 : -width / 2;
+    return (uint16_t)(lut->mv[knot] + (delta * fraction + rounding) / width);
+}
+
+bool adcCorrectionFit(AdcCorrection_t* correction, const AdcLut_t* base,
+                      const AdcBenchPoint_t* points, uint8_t count) {
+    if (count < 2 || count > ADC_BENCH_MAX_POINTS) {
+        return false;
+    }
+
+    // Sort by raw (insertion sort, at most ADC_BENCH_MAX_POINTS)
+    AdcBenchPoint_t sorted[ADC_BENCH_MAX_POINTS];
+    for (uint8_t i = 0; i < count; i++) {
+        AdcBenchPoint_t point = points[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1].raw > point.raw) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = point;
+    }
+
+    // Residual of the base curve at each bench point
+    int32_t residual[ADC_BENCH_MAX_POINTS];
+    for (uint8_t i = 0; i < count; i++) {
+        if (i > 0 && (sorted[i].raw <= sorted[i - 1].raw || sorted[i].mv <= sorted[i - 1].mv)) {
+            return false;
+        }
+        residual[i] = (int32_t)sorted[i].mv - adcLutMillivolts(base, sorted[i].raw);
+    }
+
+    memset(correction, 0, sizeof(*correction));
+    uint8_t upper = 1;
+    for (uint8_t k = 0; k < ADC_LUT_POINTS; k++) {
+        int32_t raw = adcLutKnotRaw(k);
+        int32_t offset;
+        if (raw <= sorted[0].raw) {
+            offset = residual[0];
+        } else if (raw >= sorted[count - 1].raw) {
+            offset = residual[count - 1];
+        } else {
+            while (sorted[upper].raw < raw) {
+                upper++;
+            }
+            int32_t span = sorted[upper].raw - sorted[upper - 1].raw;
+            int32_t step = residual[upper] - residual[upper - 1];
+            int32_t into = raw - sorted[upper - 1].raw;
+            offset = residual[upper - 1] + (step * into + (step >= 0 ? span / 2 : -span / 2)) / span;
+        }
+        if (offset < INT16_MIN) offset = INT16_MIN;
+        if (offset > INT16_MAX) offset = INT16_MAX;
+        correction->offset_mv[k] = (int16_t)offset;
+    }
+
+    correction->magic = ADC_CORRECTION_MAGIC;
+    correction->points = count;
+    return true;
+}
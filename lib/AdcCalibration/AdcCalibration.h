@@ -0,0 +1,97 @@
+/**
+ * ============================================================================
+ * BINSAI ADC Calibration
+ * Raw ESP32 ADC counts to millivolts through a per-device lookup table
+ * ============================================================================
+ *
+ * The ESP32 ADC has a per-chip gain/offset error and bends away from a
+ * straight line near both rails (11 dB attenuation). Two layers fix this:
+ * - Base curve: the chip's eFuse characterisation (esp_adc_cal) sampled at
+ *   ADC_LUT_POINTS knots, or an ideal straight line without eFuse data
+ * - Correction: per-device offsets at the same knots, fitted on the bench
+ *   against a reference meter and stored in NVS (AdcCorrection_t)
+ *
+ * Both are folded into one AdcLut_t at boot. A reading is then one shift,
+ * one table index and an integer interpolation: no float, no extra samples.
+ *
+ * BENCH PROCEDURE (serial console, ADCCAL command):
+ * 1. Feed a known voltage into the sensor pin (potentiometer or DAC),
+ *    measured with a multimeter, across roughly 0.1-3.1 V
+ * 2. ADCCAL ADD <mV> at each step; the raw average is recorded against the
+ *    meter reading (at least 2 points, 8+ spread over the range recommended)
+ * 3. ADCCAL SAVE fits the residual (meter - base curve) at every knot,
+ *    linear between bench points and held flat beyond the outermost ones
+ * ============================================================================
+ */
+
+#ifndef BINSAI_ADC_CALIBRATION_H
+#define BINSAI_ADC_CALIBRATION_H
+
+#include <stdint.h>
+
+#define ADC_RAW_MAX                 4095      // 12-bit reading
+#define ADC_LUT_SHIFT               7         // 128 counts per segment
+#define ADC_LUT_POINTS              ((ADC_RAW_MAX >> ADC_LUT_SHIFT) + 2)  // 33 knots
+#define ADC_BENCH_MAX_POINTS        16
+#define ADC_CORRECTION_MAGIC        0x4C434441UL  // "ADCL" little-endian
+
+/**
+ * Millivolts at raw = knot << ADC_LUT_SHIFT (the last knot is taken at
+ * ADC_RAW_MAX)
+ */
+typedef struct {
+    uint16_t mv[ADC_LUT_POINTS];
+} AdcLut_t;
+
+/**
+ * Per-device correction (POD, persisted as one NVS blob)
+ */
+typedef struct {
+    uint32_t magic;                     // ADC_CORRECTION_MAGIC when fitted
+    uint8_t points;                     // Bench points behind the fit
+    uint8_t reserved;
+    int16_t offset_mv[ADC_LUT_POINTS];  // Added to the base curve per knot
+} AdcCorrection_t;
+
+/**
+ * One bench step: averaged raw reading at a metered input voltage
+ */
+typedef struct {
+    uint16_t raw;
+    uint16_t mv;
+} AdcBenchPoint_t;
+
+/**
+ * Raw value at which a knot is sampled
+ */
+uint16_t adcLutKnotRaw(uint8_t knot);
+
+/**
+ * Ideal straight line 0..full_scale_mv (no eFuse data)
+ */
+void adcLutLinear(AdcLut_t* lut, uint16_t full_scale_mv);
+
+/**
+ * Add a fitted correction to the base curve (no-op if not valid)
+ */
+void adcLutApplyCorrection(AdcLut_t* lut, const AdcCorrection_t* correction);
+
+/**
+ * Convert a raw reading (clamped to ADC_RAW_MAX)
+ * @return Millivolts
+ */
+uint16_t adcLutMillivolts(const AdcLut_t* lut, uint16_t raw);
+
+bool adcCorrectionIsValid(const AdcCorrection_t* correction);
+
+/**
+ * Fit per-knot offsets from bench points against the base curve
+ * @param base Uncorrected LUT (eFuse or linear)
+ * @param points Bench points in any order
+ * @return false with fewer than 2 points, or points whose raw and mV do
+ *         not both increase (duplicate or swapped readings)
+ */
+bool adcCorrectionFit(AdcCorrection_t* correction, const AdcLut_t* base,
+                      const AdcBenchPoint_t* points, uint8_t count);
+
+#endif  // BINSAI_ADC_CALIBRATION_H
@@ -0,0 +1,91 @@
+/**
+ * BINSAI Buzzer Sequencer - pattern table and state machine
+ */
+
+#include "BuzzerSequencer.h"
+
+// Shared step table (units of BUZZER_STEP_UNIT_MS), ON/OFF alternating
+static const uint8_t BUZZER_STEPS[] = {
+    // ERROR: 3x (100 on, 100 off)
+    10, 10, 10, 10, 10, 10,
+    // WARNING: 2x (200 on, 200 off)
+    20, 20, 20, 20,
+    // SUCCESS: 50/50/50/50/150
+    5, 5, 5, 5, 15,
+    // HALT: 100 on, 900 off
+    10, 90,
+};
+
+static const BuzzerPatternDef_t BUZZER_PATTERNS[BUZZER_PATTERN_COUNT] = {
+    {0, 0, 0,  0},   // NONE
+    {3, 0, 0,  6},   // ERROR
+    {2, 0, 6,  4},   // WARNING
+    {1, 0, 10, 5},   // SUCCESS
+    {4, 1, 15, 2},   // HALT
+};
+
+BuzzerSequencer::BuzzerSequencer()
+    : _pattern(BUZZER_PATTERN_NONE), _step(0), _output(false), _step_deadline_ms(0) {}
+
+bool BuzzerSequencer::play(uint8_t pattern, uint32_t now_ms) {
+    if (pattern == BUZZER_PATTERN_NONE || pattern >= BUZZER_PATTERN_COUNT) {
+        return false;
+    }
+
+    if (_pattern != BUZZER_PATTERN_NONE &&
+        BUZZER_PATTERNS[pattern].priority < BUZZER_PATTERNS[_pattern].priority) {
+        return false;  // Lower priority than the active pattern
+    }
+
+    _pattern = pattern;
+    _step = 0;
+    loadStep(now_ms);
+    return true;
+}
+
+bool BuzzerSequencer::tick(uint32_t now_ms) {
+    // Catch up on every step boundary passed since the last tick
+    while (_pattern != BUZZER_PATTERN_NONE &&
+           (int32_t)(now_ms - _step_deadline_ms) >= 0) {
+        const BuzzerPatternDef_t& def = BUZZER_PATTERNS[_pattern];
+        uint32_t boundary = _step_deadline_ms;
+
+        _step++;
+        if (_step >= def.step_count) {
+            if (!def.loop) {
+                stop();
+                break;
+            }
+            _step = 0;
+        }
+        loadStep(boundary);
+    }
+
+    return _output;
+}
+
+void BuzzerSequencer::stop() {
+    _pattern = BUZZER_PATTERN_NONE;
+    _step = 0;
+    _output = false;
+}
+
+uint32_t BuzzerSequencer::patternDurationMs(uint8_t pattern) {
+    if (pattern >= BUZZER_PATTERN_COUNT) {
+        return 0;
+    }
+
+    const BuzzerPatternDef_t& def = BUZZER_PATTERNS[pattern];
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < def.step_count; i++) {
+        total += BUZZER_STEPS[def.step_offset + i];
+    }
+    return total * BUZZER_STEP_UNIT_MS;
+}
+
+void BuzzerSequencer::loadStep(uint32_t start_ms) {
+    const BuzzerPatternDef_t& def = BUZZER_PATTERNS[_pattern];
+    _output = (_step % 2) == 0;
+    _step_deadline_ms = start_ms +
+        (uint32_t)BUZZER_STEPS[def.step_offset + _step] * BUZZER_STEP_UNIT_MS;
+}
@@ -0,0 +1,90 @@
+/**
+ * ============================================================================
+ * BINSAI Buzzer Sequencer
+ * Non-blocking piezo pattern engine
+ * ============================================================================
+ *
+ * Patterns are stored as a compact table of on/off step durations (10 ms
+ * units). The sequencer holds no hardware state: the firmware calls tick()
+ * from a periodic timer and drives PIN_BUZZER with the returned level, so the
+ * same code runs on host tests against a virtual clock.
+ *
+ * Priority rules:
+ * - A new pattern preempts the active one only if its priority is equal or
+ *   higher (critical > warning > success).
+ * - Looping patterns (system halt) keep playing until stop() is called.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_BUZZER_SEQUENCER_H
+#define BINSAI_BUZZER_SEQUENCER_H
+
+#include <stdint.h>
+
+// Pattern codes (kept compatible with the legacy beepPattern() arguments)
+#define BUZZER_PATTERN_NONE         0
+#define BUZZER_PATTERN_ERROR        1      // 3x 100 ms beeps
+#define BUZZER_PATTERN_WARNING      2      // 2x 200 ms beeps
+#define BUZZER_PATTERN_SUCCESS      3      // 50/50/50/50/150 ms chirp
+#define BUZZER_PATTERN_HALT         4      // 100 ms on / 900 ms off, looping
+#define BUZZER_PATTERN_COUNT        5
+
+#define BUZZER_STEP_UNIT_MS         10     // Duration unit of one table entry
+#define BUZZER_TICK_INTERVAL_MS     10     // Recommended timer period
+
+/**
+ * Pattern descriptor
+ * Steps alternate ON, OFF, ON, ... starting with ON
+ */
+typedef struct {
+    uint8_t priority;               // Higher value preempts lower
+    uint8_t loop;                   // 1 = restart after last step
+    uint8_t step_offset;            // Index into the shared step table
+    uint8_t step_count;             // Number of on/off steps
+} BuzzerPatternDef_t;
+
+class BuzzerSequencer {
+public:
+    BuzzerSequencer();
+
+    /**
+     * Request a pattern
+     * @param pattern Pattern code (BUZZER_PATTERN_*)
+     * @param now_ms Current time in milliseconds
+     * @return true if the pattern was accepted (not blocked by priority)
+     */
+    bool play(uint8_t pattern, uint32_t now_ms);
+
+    /**
+     * Advance the sequencer
+     * @param now_ms Current time in milliseconds
+     * @return Buzzer output level (true = ON)
+     */
+    bool tick(uint32_t now_ms);
+
+    /**
+     * Stop any active pattern immediately
+     */
+    void stop();
+
+    bool isActive() const { return _pattern != BUZZER_PATTERN_NONE; }
+    uint8_t activePattern() const { return _pattern; }
+    bool output() const { return _output; }
+
+    /**
+     * Total duration of one pass of a pattern
+     * @param pattern Pattern code
+     * @return Duration in milliseconds (0 for unknown patterns)
+     */
+    static uint32_t patternDurationMs(uint8_t pattern);
+
+private:
+    void loadStep(uint32_t start_ms);
+
+    uint8_t _pattern;
+    uint8_t _step;
+    bool _output;
+    uint32_t _step_deadline_ms;
+};
+
+#endif  // BINSAI_BUZZER_SEQUENCER_H
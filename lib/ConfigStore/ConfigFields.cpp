@@ -0,0 +1,184 @@
+/**
+ * BINSAI Configuration Field Table - descriptors, parsing and formatting
+ */
+
+#include "ConfigFields.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define CONFIG_FIELD(member, type, flags) \
+    { #member, type, flags, (uint16_t)offsetof(SystemConfig_t, member), \
+      (uint16_t)sizeof(((SystemConfig_t*)0)->member) }
+
+#define CONFIG_FIELD_ELEMENT(name, member, index, type) \
+    { name, type, 0, (uint16_t)(offsetof(SystemConfig_t, member) + \
+      (index) * sizeof(((SystemConfig_t*)0)->member[0])), \
+      (uint16_t)sizeof(((SystemConfig_t*)0)->member[0]) }
+
+const ConfigField_t CONFIG_FIELDS[] = {
+    CONFIG_FIELD(device_id,                   CONFIG_FIELD_STRING, 0),
+    CONFIG_FIELD(firmware_version,            CONFIG_FIELD_STRING, CONFIG_FIELD_FLAG_READONLY),
+    CONFIG_FIELD(wifi_ssid,                   CONFIG_FIELD_STRING, 0),
+    CONFIG_FIELD(wifi_password,               CONFIG_FIELD_STRING, CONFIG_FIELD_FLAG_SECRET),
+    CONFIG_FIELD(blynk_auth_token,            CONFIG_FIELD_STRING, CONFIG_FIELD_FLAG_SECRET),
+    CONFIG_FIELD(ultrasonic_offset_cm,        CONFIG_FIELD_FLOAT,  0),
+    CONFIG_FIELD(mq135_r0_calibrated,         CONFIG_FIELD_FLOAT,  0),
+    CONFIG_FIELD(mq135_temp_compensation,     CONFIG_FIELD_FLOAT,  0),
+    CONFIG_FIELD(mq135_humidity_compensation, CONFIG_FIELD_FLOAT,  0),
+    CONFIG_FIELD(critical_capacity_threshold, CONFIG_FIELD_FLOAT,  0),
+    CONFIG_FIELD(critical_gas_threshold,      CONFIG_FIELD_FLOAT,  0),
+    CONFIG_FIELD(sms_cooldown_period,         CONFIG_FIELD_UINT32, 0),
+    CONFIG_FIELD(is_modular_unit,             CONFIG_FIELD_BOOL,   0),
+    CONFIG_FIELD(deployment_zone,             CONFIG_FIELD_UINT8,  0),
+    CONFIG_FIELD(location_description,        CONFIG_FIELD_STRING, 0),
+    CONFIG_FIELD_ELEMENT("capacity_breakpoint_0", capacity_breakpoints, 0, CONFIG_FIELD_FLOAT),
+    CONFIG_FIELD_ELEMENT("capacity_breakpoint_1", capacity_breakpoints, 1, CONFIG_FIELD_FLOAT),
+    CONFIG_FIELD_ELEMENT("capacity_breakpoint_2", capacity_breakpoints, 2, CONFIG_FIELD_FLOAT),
+    CONFIG_FIELD_ELEMENT("gas_breakpoint_0",      gas_breakpoints,      0, CONFIG_FIELD_FLOAT),
+    CONFIG_FIELD_ELEMENT("gas_breakpoint_1",      gas_breakpoints,      1, CONFIG_FIELD_FLOAT),
+    CONFIG_FIELD_ELEMENT("gas_breakpoint_2",      gas_breakpoints,      2, CONFIG_FIELD_FLOAT),
+    CONFIG_FIELD(capacity_hysteresis,         CONFIG_FIELD_FLOAT,  0),
+    CONFIG_FIELD(gas_hysteresis,              CONFIG_FIELD_FLOAT,  0),
+    CONFIG_FIELD(classification_dwell_ms,     CONFIG_FIELD_UINT32, 0),
+    CONFIG_FIELD(mq135_r0_confidence,         CONFIG_FIELD_FLOAT,  0),
+    CONFIG_FIELD(mq135_auto_baseline,         CONFIG_FIELD_BOOL,   0),
+    CONFIG_FIELD(ultrasonic_probe_count,      CONFIG_FIELD_UINT8,  0),
+};
+
+const uint8_t CONFIG_FIELD_COUNT = sizeof(CONFIG_FIELDS) / sizeof(CONFIG_FIELDS[0]);
+
+const ConfigField_t* configFieldFind(const char* name) {
+    for (uint8_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        if (strcasecmp(CONFIG_FIELDS[i].name, name) == 0) {
+            return &CONFIG_FIELDS[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Parse an unsigned integer with range check
+ * @return true if the whole string was a valid number <= max_value
+ */
+static bool parseUnsigned(const char* value, uint32_t max_value, uint32_t* out) {
+    if (*value == '\0' || *value == '-') {
+        return false;
+    }
+
+    char* end = NULL;
+    unsigned long parsed = strtoul(value, &end, 0);
+    if (*end != '\0' || parsed > max_value) {
+        return false;
+    }
+
+    *out = (uint32_t)parsed;
+    return true;
+}
+
+bool configFieldSet(SystemConfig_t* config, const ConfigField_t* field, const char* value) {
+    if (field == NULL || value == NULL || (field->flags & CONFIG_FIELD_FLAG_READONLY)) {
+        return false;
+    }
+
+    uint8_t* target = (uint8_t*)config + field->offset;
+    uint32_t number = 0;
+
+    switch (field->type) {
+        case CONFIG_FIELD_STRING: {
+            size_t length = strlen(value);
+            if (length >= field->size) {
+                return false;  // Refuse silent truncation
+            }
+            memset(target, 0, field->size);
+            memcpy(target, value, length);
+            return true;
+        }
+
+        case CONFIG_FIELD_FLOAT: {
+            char* end = NULL;
+            float parsed = strtof(value, &end);
+            if (end == value || *end != '\0' || parsed != parsed) {
+                return false;  // Empty, trailing garbage or NaN
+            }
+            memcpy(target, &parsed, sizeof(parsed));
+            return true;
+        }
+
+        case CONFIG_FIELD_UINT32:
+            if (!parseUnsigned(value, 0xFFFFFFFFUL, &number)) return false;
+            memcpy(target, &number, sizeof(uint32_t));
+            return true;
+
+        case CONFIG_FIELD_UINT8:
+            if (!parseUnsigned(value, 0xFF, &number)) return false;
+            *target = (uint8_t)number;
+            return true;
+
+        case CONFIG_FIELD_BOOL: {
+            bool parsed;
+            if (strcmp(value, "1") == 0 || strcasecmp(value, "true") == 0) {
+                parsed = true;
+            } else if (strcmp(value, "0") == 0 || strcasecmp(value, "false") == 0) {
+                parsed = false;
+            } else {
+                return false;
+            }
+            memcpy(target, &parsed, sizeof(parsed));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t configFieldFormat(const SystemConfig_t* config, const ConfigField_t* field,
+                         char* buffer, size_t capacity) {
+    if (field == NULL || capacity == 0) {
+        return 0;
+    }
+
+    const uint8_t* source = (const uint8_t*)config + field->offset;
+    int written = 0;
+
+    if (field->flags & CONFIG_FIELD_FLAG_SECRET) {
+        written = snprintf(buffer, capacity, "%s", source[0] ? "********" : "");
+        return written < 0 ? 0 : ((size_t)written < capacity ? (size_t)written : capacity - 1);
+    }
+
+    switch (field->type) {
+        case CONFIG_FIELD_STRING:
+            // Field may be unterminated if it came from a corrupted blob
+            written = snprintf(buffer, capacity, "%.*s", (int)field->size, (const char*)source);
+            break;
+
+        case CONFIG_FIELD_FLOAT: {
+            float value;
+            memcpy(&value, source, sizeof(value));
+            written = snprintf(buffer, capacity, "%.4f", value);
+            break;
+        }
+
+        case CONFIG_FIELD_UINT32: {
+            uint32_t value;
+            memcpy(&value, source, sizeof(value));
+            written = snprintf(buffer, capacity, "%lu", (unsigned long)value);
+            break;
+        }
+
+        case CONFIG_FIELD_UINT8:
+            written = snprintf(buffer, capacity, "%u", (unsigned)source[0]);
+            break;
+
+        case CONFIG_FIELD_BOOL:
+            written = snprintf(buffer, capacity, "%s", source[0] ? "true" : "false");
+            break;
+    }
+
+    if (written < 0) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return (size_t)written < capacity ? (size_t)written : capacity - 1;
+}
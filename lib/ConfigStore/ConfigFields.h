@@ -0,0 +1,60 @@
+/**
+ * ============================================================================
+ * BINSAI Configuration Field Table
+ * Name/type/offset descriptors for every SystemConfig_t field
+ * ============================================================================
+ *
+ * Used by the serial console (GET/SET) and any tool that needs to address
+ * configuration fields by name without heap allocation.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_CONFIG_FIELDS_H
+#define BINSAI_CONFIG_FIELDS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "definitions.h"
+
+typedef enum {
+    CONFIG_FIELD_STRING = 0,        // char[] (NUL-terminated, truncated on set)
+    CONFIG_FIELD_FLOAT,             // float
+    CONFIG_FIELD_UINT32,            // uint32_t
+    CONFIG_FIELD_UINT8,             // uint8_t
+    CONFIG_FIELD_BOOL               // bool (accepts 0/1/true/false)
+} ConfigFieldType_t;
+
+#define CONFIG_FIELD_FLAG_SECRET    0x01   // Value masked when formatted
+#define CONFIG_FIELD_FLAG_READONLY  0x02   // Rejected by configFieldSet()
+
+typedef struct {
+    const char* name;               // Console/JSON key
+    uint8_t type;                   // ConfigFieldType_t
+    uint8_t flags;                  // CONFIG_FIELD_FLAG_*
+    uint16_t offset;                // offsetof(SystemConfig_t, field)
+    uint16_t size;                  // sizeof(field)
+} ConfigField_t;
+
+extern const ConfigField_t CONFIG_FIELDS[];
+extern const uint8_t CONFIG_FIELD_COUNT;
+
+/**
+ * Find a field by name (case-insensitive)
+ * @return Field descriptor, or NULL if unknown
+ */
+const ConfigField_t* configFieldFind(const char* name);
+
+/**
+ * Parse and store a value
+ * @return true if the value was valid and stored
+ */
+bool configFieldSet(SystemConfig_t* config, const ConfigField_t* field, const char* value);
+
+/**
+ * Format a field value as text
+ * @return Number of characters written (excluding NUL)
+ */
+size_t configFieldFormat(const SystemConfig_t* config, const ConfigField_t* field,
+                         char* buffer, size_t capacity);
+
+#endif  // BINSAI_CONFIG_FIELDS_H
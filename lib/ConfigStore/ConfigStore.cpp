@@ -0,0 +1,179 @@
+/**
+ * BINSAI Configuration Store - A/B slot selection, CRC and migrations
+ */
+
+#include "ConfigStore.h"
+#include <string.h>
+#include "ConfigFields.h"
+
+/**
+ * v1 -> v2: classification tables moved from firmware macros into config
+ */
+static void migrateAddClassificationTables(SystemConfig_t* config) {
+    config->capacity_breakpoints[0] = THRESHOLD_EMPTY_PERCENT;
+    config->capacity_breakpoints[1] = THRESHOLD_HALF_PERCENT;
+    config->capacity_breakpoints[2] = THRESHOLD_ALMOST_FULL;
+    config->gas_breakpoints[0] = PPM_CLEAN_AIR_MAX;
+    config->gas_breakpoints[1] = PPM_INORGANIC_MAX;
+    config->gas_breakpoints[2] = PPM_ORGANIC_L1_MAX;
+    config->capacity_hysteresis = CAPACITY_HYSTERESIS_PERCENT;
+    config->gas_hysteresis = GAS_HYSTERESIS_PPM;
+    config->classification_dwell_ms = CLASSIFICATION_DWELL_MS;
+}
+
+/**
+ * v2 -> v3: background MQ-135 baseline. An R0 stored by an older firmware
+ * has no confidence, so the first confident estimate replaces it
+ */
+static void migrateAddAutoBaseline(SystemConfig_t* config) {
+    config->mq135_r0_confidence = 0.0f;
+    config->mq135_auto_baseline = true;
+}
+
+/**
+ * v3 -> v4: probe array. Existing units have the single original probe
+ */
+static void migrateAddProbeArray(SystemConfig_t* config) {
+    config->ultrasonic_probe_count = 1;
+}
+
+// Migration hooks indexed by source schema (entry v upgrades v -> v+1).
+// Entry 0 is NULL: the legacy Preferences layout is imported by the firmware.
+static const ConfigMigrationHook_t CONFIG_MIGRATIONS[CONFIG_SCHEMA_VERSION] = {
+    NULL,                               // v0 -> v1: legacy import in loadSystemConfiguration()
+    migrateAddClassificationTables,     // v1 -> v2
+    migrateAddAutoBaseline,             // v2 -> v3
+    migrateAddProbeArray,               // v3 -> v4
+};
+
+uint32_t configCrc32(const void* data, size_t length) {
+    // Nibble-wise table keeps flash usage at 64 bytes
+    static const uint32_t CRC_TABLE[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+        0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ CRC_TABLE[crc & 0x0F];
+        crc = (crc >> 4) ^ CRC_TABLE[crc & 0x0F];
+    }
+
+    return crc ^ 0xFFFFFFFFUL;
+}
+
+ConfigStore::ConfigStore(ConfigStorageBackend& backend)
+    : _backend(backend), _active_slot(CONFIG_SLOT_NONE), _sequence(0), _loaded_schema(0) {}
+
+bool ConfigStore::validateSlot(const uint8_t* blob, size_t length, ConfigBlobHeader_t* header) {
+    if (length < sizeof(ConfigBlobHeader_t)) {
+        return false;
+    }
+
+    memcpy(header, blob, sizeof(ConfigBlobHeader_t));
+
+    if (header->magic != CONFIG_BLOB_MAGIC ||
+        header->schema_version == 0 ||
+        header->schema_version > CONFIG_SCHEMA_VERSION ||
+        header->payload_length > sizeof(SystemConfig_t) ||
+        length != sizeof(ConfigBlobHeader_t) + header->payload_length) {
+        return false;
+    }
+
+    return configCrc32(blob + sizeof(ConfigBlobHeader_t), header->payload_length) == header->crc32;
+}
+
+ConfigLoadResult_t ConfigStore::load(SystemConfig_t* config) {
+    uint8_t blob[CONFIG_BLOB_MAX_SIZE];
+    uint8_t best_payload[sizeof(SystemConfig_t)];
+    ConfigBlobHeader_t header;
+    ConfigBlobHeader_t best_header = {0, 0, 0, 0, 0};
+    bool any_data = false;
+    uint8_t best_slot = CONFIG_SLOT_NONE;
+
+    // Each slot is read exactly once; the newest valid payload is kept
+    for (uint8_t slot = 0; slot < CONFIG_SLOT_COUNT; slot++) {
+        size_t length = _backend.readSlot(slot, blob, sizeof(blob));
+        if (length == 0) {
+            continue;
+        }
+        any_data = true;
+
+        if (!validateSlot(blob, length, &header)) {
+            continue;
+        }
+
+        // Wrap-safe comparison of commit counters
+        if (best_slot != CONFIG_SLOT_NONE &&
+            (int32_t)(header.sequence - best_header.sequence) <= 0) {
+            continue;
+        }
+
+        memcpy(best_payload, blob + sizeof(ConfigBlobHeader_t), header.payload_length);
+        best_slot = slot;
+        best_header = header;
+    }
+
+    if (best_slot == CONFIG_SLOT_NONE) {
+        _active_slot = CONFIG_SLOT_NONE;
+        return any_data ? CONFIG_LOAD_CORRUPT : CONFIG_LOAD_EMPTY;
+    }
+
+    // Older payloads are shorter: overlay onto caller defaults. A CRC only
+    // proves the blob is intact, so strings are terminated here, not trusted
+    memcpy(config, best_payload, best_header.payload_length);
+    for (uint8_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        if (CONFIG_FIELDS[i].type == CONFIG_FIELD_STRING) {
+            ((char*)config)[CONFIG_FIELDS[i].offset + CONFIG_FIELDS[i].size - 1] = '\0';
+        }
+    }
+
+    _active_slot = best_slot;
+    _sequence = best_header.sequence;
+    _loaded_schema = best_header.schema_version;
+
+    if (best_header.schema_version < CONFIG_SCHEMA_VERSION) {
+        applyMigrations(config, best_header.schema_version);
+        return CONFIG_LOAD_MIGRATED;
+    }
+
+    return CONFIG_LOAD_OK;
+}
+
+bool ConfigStore::commit(const SystemConfig_t& config) {
+    uint8_t blob[CONFIG_BLOB_MAX_SIZE];
+    ConfigBlobHeader_t header;
+
+    header.magic = CONFIG_BLOB_MAGIC;
+    header.schema_version = CONFIG_SCHEMA_VERSION;
+    header.payload_length = sizeof(SystemConfig_t);
+    header.sequence = _sequence + 1;
+    header.crc32 = configCrc32(&config, sizeof(SystemConfig_t));
+
+    memcpy(blob, &header, sizeof(header));
+    memcpy(blob + sizeof(header), &config, sizeof(SystemConfig_t));
+
+    // Always write the slot that does not hold the active config
+    uint8_t target_slot = (_active_slot == 0) ? 1 : 0;
+    if (!_backend.writeSlot(target_slot, blob, sizeof(blob))) {
+        return false;
+    }
+
+    _active_slot = target_slot;
+    _sequence = header.sequence;
+    _loaded_schema = CONFIG_SCHEMA_VERSION;
+    return true;
+}
+
+void ConfigStore::applyMigrations(SystemConfig_t* config, uint16_t from_version) {
+    for (uint16_t version = from_version; version < CONFIG_SCHEMA_VERSION; version++) {
+        if (CONFIG_MIGRATIONS[version] != NULL) {
+            CONFIG_MIGRATIONS[version](config);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * ============================================================================
+ * BINSAI Configuration Store
+ * Versioned, CRC-protected SystemConfig_t blob with A/B slots
+ * ============================================================================
+ *
+ * LAYOUT (per slot):
+ * [ConfigBlobHeader_t][SystemConfig_t payload]
+ *
+ * COMMIT PROTOCOL:
+ * - Each commit writes the whole blob to the slot NOT holding the active
+ *   config, with sequence = active sequence + 1
+ * - On load both slots are validated (magic, schema, length, CRC32) and the
+ *   valid slot with the newest sequence wins
+ * - A torn or corrupted write therefore always leaves the previous config
+ * - String fields of a loaded config are always NUL-terminated
+ *
+ * MIGRATION:
+ * - SystemConfig_t is append-only; an older payload is copied over the
+ *   caller's defaults and CONFIG_MIGRATIONS[v] upgrades schema v -> v+1
+ * - Schema 0 is the legacy key-per-field Preferences layout, imported by
+ *   the firmware before the first commit
+ * ============================================================================
+ */
+
+#ifndef BINSAI_CONFIG_STORE_H
+#define BINSAI_CONFIG_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "definitions.h"
+
+#define CONFIG_BLOB_MAGIC           0x43534E42UL  // "BNSC" little-endian
+#define CONFIG_SCHEMA_VERSION       4             // Current SystemConfig_t schema
+#define CONFIG_SLOT_COUNT           2             // A/B slots
+#define CONFIG_SLOT_NONE            0xFF
+
+/**
+ * Blob header stored in front of every slot payload
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;                 // CONFIG_BLOB_MAGIC
+    uint16_t schema_version;        // Schema of the payload
+    uint16_t payload_length;        // sizeof(SystemConfig_t) at write time
+    uint32_t sequence;              // Monotonic commit counter
+    uint32_t crc32;                 // CRC32 over the payload
+} ConfigBlobHeader_t;
+
+#define CONFIG_BLOB_MAX_SIZE        (sizeof(ConfigBlobHeader_t) + sizeof(SystemConfig_t))
+
+/**
+ * Load result codes
+ */
+typedef enum {
+    CONFIG_LOAD_OK = 0,             // Current schema loaded
+    CONFIG_LOAD_MIGRATED,           // Older schema loaded and upgraded (commit advised)
+    CONFIG_LOAD_EMPTY,              // No blob stored in either slot
+    CONFIG_LOAD_CORRUPT             // Blobs present but none valid
+} ConfigLoadResult_t;
+
+/**
+ * Migration hook: upgrade a config from schema v to v+1 in place
+ */
+typedef void (*ConfigMigrationHook_t)(SystemConfig_t* config);
+
+/**
+ * Storage backend for the two slots (NVS in firmware, RAM in tests)
+ */
+class ConfigStorageBackend {
+public:
+    virtual ~ConfigStorageBackend() {}
+
+    /**
+     * Read a slot
+     * @return Number of bytes read (0 if the slot is empty)
+     */
+    virtual size_t readSlot(uint8_t slot, void* buffer, size_t capacity) = 0;
+
+    /**
+     * Write a complete slot
+     * @return true if all bytes were persisted
+     */
+    virtual bool writeSlot(uint8_t slot, const void* data, size_t length) = 0;
+};
+
+class ConfigStore {
+public:
+    explicit ConfigStore(ConfigStorageBackend& backend);
+
+    /**
+     * Load the newest valid configuration
+     * @param config Pre-filled with defaults; overwritten by the stored blob
+     * @return Load result code
+     */
+    ConfigLoadResult_t load(SystemConfig_t* config);
+
+    /**
+     * Atomically persist a configuration to the inactive slot
+     * @return true if the blob was written
+     */
+    bool commit(const SystemConfig_t& config);
+
+    uint8_t activeSlot() const { return _active_slot; }
+    uint32_t sequence() const { return _sequence; }
+    uint16_t loadedSchemaVersion() const { return _loaded_schema; }
+
+    /**
+     * Bring a config from an older schema up to CONFIG_SCHEMA_VERSION
+     */
+    static void applyMigrations(SystemConfig_t* config, uint16_t from_version);
+
+private:
+    bool validateSlot(const uint8_t* blob, size_t length, ConfigBlobHeader_t* header);
+
+    ConfigStorageBackend& _backend;
+    uint8_t _active_slot;
+    uint32_t _sequence;
+    uint16_t _loaded_schema;
+};
+
+/**
+ * CRC-32 (IEEE 802.3, reflected) over a buffer
+ */
+uint32_t configCrc32(const void* data, size_t length);
+
+#endif  // BINSAI_CONFIG_STORE_H
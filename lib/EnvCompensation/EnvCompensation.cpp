@@ -0,0 +1,115 @@
+/**
+ * BINSAI Environmental Compensation - correction tables and SHT3x decoding
+ */
+
+#include "EnvCompensation.h"
+
+#define MQ135_TABLE_MIN_C       -10
+#define MQ135_TABLE_STEP_C      5
+#define MQ135_TABLE_SIZE        11
+#define MQ135_HUMIDITY_SLOPE    0.0018f   // CF per %RH
+#define MQ135_HUMIDITY_BASE     33.0f     // %RH of the tabulated curve
+
+#define SOUND_TABLE_MIN_C       -20
+#define SOUND_TABLE_STEP_C      5
+#define SOUND_TABLE_SIZE        17
+#define SOUND_HUMIDITY_SLOPE    0.00000124f   // cm/us per %RH
+
+// CF(T, 33 %RH), -10..40 C
+static const float MQ135_CF_TABLE[MQ135_TABLE_SIZE] = {
+    1.70218f, 1.54003f, 1.39538f, 1.26823f, 1.15858f, 1.06643f,
+    0.99178f, 0.93463f, 0.89498f, 0.87283f, 0.86818f
+};
+
+// Dry-air speed of sound [cm/us], -20..60 C
+static const float SOUND_SPEED_TABLE[SOUND_TABLE_SIZE] = {
+    0.031894f, 0.032207f, 0.032518f, 0.032825f, 0.033130f, 0.033432f,
+    0.033731f, 0.034028f, 0.034321f, 0.034613f, 0.034902f, 0.035189f,
+    0.035473f, 0.035755f, 0.036035f, 0.036313f, 0.036588f
+};
+
+/**
+ * Linear interpolation in a table with uniform steps, held at both ends
+ */
+static float tableLookup(const float* table, uint8_t size, float min_x, float step, float x) {
+    float position = (x - min_x) / step;
+    if (position <= 0.0f) return table[0];
+    if (position >= size - 1) return table[size - 1];
+    uint8_t index = (uint8_t)position;
+    float fraction = position - index;
+    return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
+static float mq135Cf(float temperature_c, float humidity_pct) {
+    return tableLookup(MQ135_CF_TABLE, MQ135_TABLE_SIZE, MQ135_TABLE_MIN_C, MQ135_TABLE_STEP_C, temperature_c) -
+           MQ135_HUMIDITY_SLOPE * (humidity_pct - MQ135_HUMIDITY_BASE);
+}
+
+float envMq135Factor(float temperature_c, float humidity_pct) {
+    return mq135Cf(temperature_c, humidity_pct) /
+           mq135Cf(ENV_DEFAULT_TEMPERATURE_C, ENV_DEFAULT_HUMIDITY_PCT);
+}
+
+float envSoundSpeed(float temperature_c, float humidity_pct) {
+    return tableLookup(SOUND_SPEED_TABLE, SOUND_TABLE_SIZE, SOUND_TABLE_MIN_C, SOUND_TABLE_STEP_C, temperature_c) +
+           SOUND_HUMIDITY_SLOPE * humidity_pct;
+}
+
+/**
+ * Store conditions and refresh the cached corrections
+ */
+static void applyConditions(EnvCompensation_t* env, float temperature_c, float humidity_pct) {
+    env->temperature_c = temperature_c;
+    env->humidity_pct = humidity_pct;
+    env->sound_speed_cm_us = envSoundSpeed(temperature_c, humidity_pct);
+    env->gas_rs_factor = envMq135Factor(temperature_c, humidity_pct);
+}
+
+void envInit(EnvCompensation_t* env) {
+    env->source = ENV_SOURCE_DEFAULT;
+    env->updated_ms = 0;
+    applyConditions(env, ENV_DEFAULT_TEMPERATURE_C, ENV_DEFAULT_HUMIDITY_PCT);
+}
+
+bool envUpdate(EnvCompensation_t* env, float temperature_c, float humidity_pct, uint32_t now_ms) {
+    if (!(temperature_c >= ENV_TEMPERATURE_MIN_C && temperature_c <= ENV_TEMPERATURE_MAX_C) ||
+        !(humidity_pct >= 0.0f && humidity_pct <= 100.0f)) {
+        return false;
+    }
+
+    env->source = ENV_SOURCE_SENSOR;
+    env->updated_ms = now_ms;
+    applyConditions(env, temperature_c, humidity_pct);
+    return true;
+}
+
+bool envExpire(EnvCompensation_t* env, uint32_t now_ms) {
+    if (env->source != ENV_SOURCE_SENSOR || now_ms - env->updated_ms < ENV_STALE_MS) {
+        return false;
+    }
+    envInit(env);
+    return true;
+}
+
+uint8_t envSht3xCrc(const uint8_t* data, size_t length) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+bool envSht3xDecode(const uint8_t* frame, float* temperature_c, float* humidity_pct) {
+    if (envSht3xCrc(frame, 2) != frame[2] || envSht3xCrc(frame + 3, 2) != frame[5]) {
+        return false;
+    }
+
+    uint16_t raw_t = (uint16_t)((frame[0] << 8) | frame[1]);
+    uint16_t raw_h = (uint16_t)((frame[3] << 8) | frame[4]);
+    *temperature_c = -45.0f + 175.0f * raw_t / 65535.0f;
+    *humidity_pct = 100.0f * raw_h / 65535.0f;
+    return true;
+}
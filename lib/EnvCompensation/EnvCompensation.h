@@ -0,0 +1,108 @@
+/**
+ * ============================================================================
+ * BINSAI Environmental Compensation
+ * Temperature / humidity correction for the MQ-135 and the ultrasonic ranger
+ * ============================================================================
+ *
+ * CONDITIONS:
+ * - From an optional SHT3x on the LCD I2C bus (single-shot, decoded here),
+ *   or ENV_DEFAULT_* when no sensor answers or its last reading is older
+ *   than ENV_STALE_MS
+ * - Both corrections are derived once per update and cached, so the sensor
+ *   read paths only multiply / divide
+ *
+ * MQ-135: RS / RS(ENV_DEFAULT_*) from the datasheet sensitivity curves,
+ *   CF(T, H) = 0.00035 T^2 - 0.02718 T + 1.39538 - 0.0018 (H - 33),
+ *   tabulated every 5 C over -10..40 C (the fit turns upward above 40 C
+ *   where the datasheet curve is flat, so it is held there). The research
+ *   regression was fitted at the default conditions, so the factor is 1.0
+ *   there and compensation is a no-op without a sensor.
+ *
+ * SOUND: 331.3 m/s * sqrt(1 + T / 273.15), tabulated every 5 C over
+ *   -20..60 C, plus 0.0124 m/s per %RH for water vapour.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_ENV_COMPENSATION_H
+#define BINSAI_ENV_COMPENSATION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ENV_DEFAULT_TEMPERATURE_C   25.0f     // Lab conditions of the research regression
+#define ENV_DEFAULT_HUMIDITY_PCT    60.0f
+#define ENV_STALE_MS                60000     // Sensor silent this long: back to defaults
+#define ENV_TEMPERATURE_MIN_C       -40.0f    // Plausible sensor range; outside is a bad read
+#define ENV_TEMPERATURE_MAX_C       85.0f
+
+#define ENV_SHT3X_ADDRESS           0x44      // ADDR low; 0x45 with ADDR high
+#define ENV_SHT3X_ADDRESS_ALT       0x45
+#define ENV_SHT3X_MEASURE_MSB       0x24      // Single shot, high repeatability,
+#define ENV_SHT3X_MEASURE_LSB       0x00      // no clock stretching (15 ms)
+#define ENV_SHT3X_FRAME_SIZE        6         // T(2) CRC H(2) CRC
+
+typedef enum {
+    ENV_SOURCE_DEFAULT = 0,
+    ENV_SOURCE_SENSOR
+} EnvSource_t;
+
+/**
+ * Current conditions and the corrections derived from them
+ */
+typedef struct {
+    float temperature_c;
+    float humidity_pct;
+    uint8_t source;                 // EnvSource_t
+    uint32_t updated_ms;            // Last accepted sensor reading
+    float sound_speed_cm_us;        // Speed of sound [cm/us]
+    float gas_rs_factor;            // Measured RS / RS at the default conditions
+} EnvCompensation_t;
+
+/**
+ * Start from the default conditions
+ */
+void envInit(EnvCompensation_t* env);
+
+/**
+ * Accept a sensor reading and refresh the derived corrections
+ * @return false (nothing changed) for readings outside the plausible range
+ */
+bool envUpdate(EnvCompensation_t* env, float temperature_c, float humidity_pct, uint32_t now_ms);
+
+/**
+ * Fall back to the defaults once the sensor has been silent ENV_STALE_MS
+ * @return true if this call reverted to the defaults
+ */
+bool envExpire(EnvCompensation_t* env, uint32_t now_ms);
+
+/**
+ * MQ-135 RS of clean air at the default conditions
+ * @param rs Measured sensor resistance (any unit)
+ */
+inline float envCompensateRs(const EnvCompensation_t* env, float rs) {
+    return rs / env->gas_rs_factor;
+}
+
+/**
+ * Speed of sound from the table
+ * @return cm/us
+ */
+float envSoundSpeed(float temperature_c, float humidity_pct);
+
+/**
+ * MQ-135 RS relative to the default conditions, from the table
+ */
+float envMq135Factor(float temperature_c, float humidity_pct);
+
+/**
+ * Sensirion CRC-8 (poly 0x31, init 0xFF)
+ */
+uint8_t envSht3xCrc(const uint8_t* data, size_t length);
+
+/**
+ * Decode a single-shot measurement frame
+ * @return false on a CRC mismatch
+ */
+bool envSht3xDecode(const uint8_t* frame, float* temperature_c, float* humidity_pct);
+
+#endif  // BINSAI_ENV_COMPENSATION_H
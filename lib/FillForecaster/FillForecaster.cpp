@@ -0,0 +1,224 @@
+/**
+ * BINSAI Fill Forecaster - bucketing, weighted regression and seasonality
+ */
+
+#include "FillForecaster.h"
+#include <math.h>
+#include <string.h>
+
+#define SECONDS_PER_HOUR    3600UL
+#define SECONDS_PER_DAY     86400UL
+#define BUCKET_SECONDS      (FORECAST_BUCKET_MINUTES * 60UL)
+#define BUCKET_HOURS        (FORECAST_BUCKET_MINUTES / 60.0f)
+
+uint8_t forecastDayOfWeek(uint32_t unix_s) {
+    // 1970-01-01 was a Thursday
+    return (uint8_t)((((unix_s + FORECAST_UTC_OFFSET_S) / SECONDS_PER_DAY) + 4) % 7);
+}
+
+/**
+ * Restart the trend after a collection (seasonality is kept)
+ */
+static void resetTrend(FillForecastState_t* state) {
+    state->s_w = 0.0f;
+    state->s_t = 0.0f;
+    state->s_tt = 0.0f;
+    state->s_y = 0.0f;
+    state->s_ty = 0.0f;
+    state->trend_buckets = 0;
+    state->last_bucket_end_s = 0;
+}
+
+void forecastInit(FillForecastState_t* state, uint32_t now_s) {
+    memset(state, 0, sizeof(*state));
+    state->magic = FORECAST_STATE_MAGIC;
+    state->bucket_start_s = now_s;
+}
+
+bool forecastIsValid(const FillForecastState_t* state) {
+    return state->magic == FORECAST_STATE_MAGIC &&
+           state->ring_head < FORECAST_RING_SIZE &&
+           state->ring_count <= FORECAST_RING_SIZE;
+}
+
+/**
+ * Weekday multiplier on the trend rate (1.0 until enough history)
+ */
+static float dayFactor(const FillForecastState_t* state, uint8_t day) {
+    if (state->day_buckets[day] < FORECAST_MIN_SEASON_BUCKETS) {
+        return 1.0f;
+    }
+
+    float sum = 0.0f;
+    uint8_t days = 0;
+    for (uint8_t d = 0; d < 7; d++) {
+        if (state->day_buckets[d] >= FORECAST_MIN_SEASON_BUCKETS) {
+            sum += state->day_rate[d];
+            days++;
+        }
+    }
+
+    float mean = sum / days;
+    if (mean <= FORECAST_MIN_RATE) {
+        return 1.0f;
+    }
+
+    float factor = state->day_rate[day] / mean;
+    if (factor < 0.25f) factor = 0.25f;
+    if (factor > 4.0f) factor = 4.0f;
+    return factor;
+}
+
+/**
+ * Close the open bucket: store it, fold it into the regression and
+ * update the weekday rate
+ */
+static void closeBucket(FillForecastState_t* state, uint32_t now_s) {
+    float average = state->bucket_sum / state->bucket_samples;
+
+    // History ring (0.5% resolution)
+    float scaled = average * 2.0f + 0.5f;
+    state->ring[state->ring_head] = (uint8_t)(scaled < 0.0f ? 0.0f : (scaled > 200.0f ? 200.0f : scaled));
+    state->ring_head = (state->ring_head + 1) % FORECAST_RING_SIZE;
+    if (state->ring_count < FORECAST_RING_SIZE) {
+        state->ring_count++;
+    }
+
+    if (state->last_bucket_end_s != 0) {
+        float dt_h = (float)(now_s - state->last_bucket_end_s) / SECONDS_PER_HOUR;
+
+        // Shift the time axis so the new bucket sits at t = 0
+        state->s_ty -= dt_h * state->s_y;
+        state->s_tt += -2.0f * dt_h * state->s_t + dt_h * dt_h * state->s_w;
+        state->s_t -= dt_h * state->s_w;
+
+        // Forget old buckets (gaps decay proportionally)
+        float decay = powf(FORECAST_DECAY, dt_h / BUCKET_HOURS);
+        state->s_w *= decay;
+        state->s_t *= decay;
+        state->s_tt *= decay;
+        state->s_y *= decay;
+        state->s_ty *= decay;
+
+        // Weekday rate from consecutive buckets
+        if (dt_h > 0.0f) {
+            float rate = (average - state->last_bucket_fill) / dt_h;
+            uint8_t day = forecastDayOfWeek(now_s - BUCKET_SECONDS / 2);
+            if (state->day_buckets[day] == 0) {
+                state->day_rate[day] = rate;
+            } else {
+                state->day_rate[day] += FORECAST_SEASON_ALPHA * (rate - state->day_rate[day]);
+            }
+            if (state->day_buckets[day] < 0xFFFF) {
+                state->day_buckets[day]++;
+            }
+        }
+    }
+
+    state->s_w += 1.0f;
+    state->s_y += average;
+
+    state->trend_buckets++;
+    state->last_bucket_fill = average;
+    state->last_bucket_end_s = now_s;
+    state->bucket_start_s = now_s;
+    state->bucket_sum = 0.0f;
+    state->bucket_samples = 0;
+}
+
+bool forecastUpdate(FillForecastState_t* state, float fill_percentage, uint32_t now_s) {
+    if (isnan(fill_percentage)) {
+        return false;
+    }
+
+    // Clock went backwards (reboot without wall clock): restart the window
+    if (now_s < state->bucket_start_s) {
+        resetTrend(state);
+        state->bucket_start_s = now_s;
+        state->bucket_sum = 0.0f;
+        state->bucket_samples = 0;
+    }
+
+    // Collection detection against the most recent level
+    float reference = (state->bucket_samples > 0)
+        ? state->bucket_sum / state->bucket_samples
+        : state->last_bucket_fill;
+    bool has_reference = state->bucket_samples > 0 || state->trend_buckets > 0;
+
+    if (has_reference && reference - fill_percentage > FORECAST_EMPTY_DROP_PERCENT) {
+        resetTrend(state);
+        state->collections++;
+        state->bucket_start_s = now_s;
+        state->bucket_sum = 0.0f;
+        state->bucket_samples = 0;
+    }
+
+    state->bucket_sum += fill_percentage;
+    state->bucket_samples++;
+
+    if (now_s - state->bucket_start_s >= BUCKET_SECONDS) {
+        closeBucket(state, now_s);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Weighted least-squares slope (%/hour) of the trend window
+ */
+static float trendSlope(const FillForecastState_t* state) {
+    if (state->trend_buckets < FORECAST_MIN_BUCKETS) {
+        return 0.0f;
+    }
+
+    float denominator = state->s_w * state->s_tt - state->s_t * state->s_t;
+    if (fabsf(denominator) < 1e-6f) {
+        return 0.0f;
+    }
+    return (state->s_w * state->s_ty - state->s_t * state->s_y) / denominator;
+}
+
+float forecastFillRate(const FillForecastState_t* state) {
+    return trendSlope(state);
+}
+
+float forecastHoursToFull(const FillForecastState_t* state, uint32_t now_s) {
+    if (state->trend_buckets < FORECAST_MIN_BUCKETS) {
+        return FORECAST_UNKNOWN;
+    }
+
+    float slope = trendSlope(state);
+
+    // Fill level now = regression intercept extrapolated from the newest bucket
+    float since_h = (float)(now_s - state->last_bucket_end_s) / SECONDS_PER_HOUR;
+    float intercept = (state->s_y - slope * state->s_t) / state->s_w;
+    float remaining = 100.0f - (intercept + slope * since_h);
+    if (remaining <= 0.0f) {
+        return 0.0f;
+    }
+
+    // The trend mostly reflects today: normalise it, then walk day segments
+    float base_rate = slope / dayFactor(state, forecastDayOfWeek(now_s));
+    if (base_rate <= FORECAST_MIN_RATE) {
+        return FORECAST_HORIZON_HOURS;
+    }
+
+    float hours = 0.0f;
+    uint32_t cursor_s = now_s;
+    while (hours < FORECAST_HORIZON_HOURS) {
+        uint32_t into_day = (cursor_s + FORECAST_UTC_OFFSET_S) % SECONDS_PER_DAY;
+        float segment_h = (float)(SECONDS_PER_DAY - into_day) / SECONDS_PER_HOUR;
+        float rate = base_rate * dayFactor(state, forecastDayOfWeek(cursor_s));
+
+        if (rate * segment_h >= remaining) {
+            hours += remaining / rate;
+            break;
+        }
+
+        remaining -= rate * segment_h;
+        hours += segment_h;
+        cursor_s += SECONDS_PER_DAY - into_day;
+    }
+
+    return hours < FORECAST_HORIZON_HOURS ? hours : FORECAST_HORIZON_HOURS;
+}
@@ -0,0 +1,109 @@
+/**
+ * ============================================================================
+ * BINSAI Fill Forecaster
+ * On-device time-to-full prediction from the fill-level history
+ * ============================================================================
+ *
+ * MODEL:
+ * - Raw 2 s samples are averaged into FORECAST_BUCKET_MINUTES buckets; each
+ *   closed bucket is stored in a fixed ring (1 byte, 0.5% resolution)
+ * - Trend: exponentially weighted linear regression over the buckets.
+ *   Sums are kept relative to the newest bucket (time axis shifted on each
+ *   update), so every update is O(1) and stays accurate in float
+ * - Seasonality: per day-of-week fill rate, as a multiplier on the trend
+ * - A drop of FORECAST_EMPTY_DROP_PERCENT marks a collection and restarts
+ *   the trend (seasonality is kept)
+ *
+ * The state is a POD struct so the firmware can place it in RTC memory and
+ * keep the history across deep sleep / soft resets.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_FILL_FORECASTER_H
+#define BINSAI_FILL_FORECASTER_H
+
+#include <stdint.h>
+
+#define FORECAST_BUCKET_MINUTES     15      // Downsampling interval
+#define FORECAST_RING_SIZE          96      // 24 h of buckets
+#define FORECAST_DECAY              0.97f   // Regression weight kept per bucket (~8 h memory)
+#define FORECAST_SEASON_ALPHA       0.05f   // Day-of-week rate smoothing
+#define FORECAST_MIN_BUCKETS        4       // Buckets before a forecast is published
+#define FORECAST_MIN_SEASON_BUCKETS 16      // Buckets per weekday before its factor is trusted
+#define FORECAST_EMPTY_DROP_PERCENT 20.0f   // Drop treated as a collection event
+#define FORECAST_HORIZON_HOURS      336.0f  // 14 days; longer forecasts are clamped
+#define FORECAST_MIN_RATE           0.01f   // %/h below which the bin is "not filling"
+#define FORECAST_UNKNOWN            -1.0f   // hoursToFull() when no forecast is possible
+#define FORECAST_UTC_OFFSET_S       25200   // Day boundaries in WIB (UTC+7)
+#define FORECAST_STATE_MAGIC        0x46524354UL  // "FRCT"
+
+/**
+ * Forecaster state (POD, suitable for RTC_DATA_ATTR)
+ */
+typedef struct {
+    uint32_t magic;                     // FORECAST_STATE_MAGIC when initialized
+
+    // Downsampling
+    uint32_t bucket_start_s;            // Start of the open bucket
+    float bucket_sum;                   // Sum of raw samples in the open bucket
+    uint16_t bucket_samples;            // Raw samples in the open bucket
+    float last_bucket_fill;             // Average of the last closed bucket
+    uint32_t last_bucket_end_s;         // Close time of the last bucket
+
+    // History ring (0.5% units)
+    uint8_t ring[FORECAST_RING_SIZE];
+    uint8_t ring_head;                  // Next write index
+    uint8_t ring_count;                 // Valid entries
+
+    // Exponentially weighted regression (t in hours, relative to newest bucket)
+    float s_w;                          // Sum of weights
+    float s_t;                          // Sum of w*t
+    float s_tt;                         // Sum of w*t^2
+    float s_y;                          // Sum of w*y
+    float s_ty;                         // Sum of w*t*y
+    uint16_t trend_buckets;             // Buckets since the last collection
+
+    // Day-of-week seasonality (%/h)
+    float day_rate[7];
+    uint16_t day_buckets[7];
+
+    uint32_t collections;               // Collection events detected
+} FillForecastState_t;
+
+/**
+ * Reset all history (call once after a cold boot)
+ */
+void forecastInit(FillForecastState_t* state, uint32_t now_s);
+
+/**
+ * Check whether a (possibly RTC-retained) state is usable
+ */
+bool forecastIsValid(const FillForecastState_t* state);
+
+/**
+ * Add a raw fill sample
+ * @param fill_percentage Current fill level (0-100)
+ * @param now_s Timestamp in seconds (Unix time when available)
+ * @return true if a bucket was closed by this sample
+ */
+bool forecastUpdate(FillForecastState_t* state, float fill_percentage, uint32_t now_s);
+
+/**
+ * Current fill rate from the weighted trend
+ * @return %/hour (0 when not enough data)
+ */
+float forecastFillRate(const FillForecastState_t* state);
+
+/**
+ * Predicted hours until the bin reaches 100%
+ * @return Hours (clamped to FORECAST_HORIZON_HOURS), 0 if already full, or
+ *         FORECAST_UNKNOWN when there is not enough history
+ */
+float forecastHoursToFull(const FillForecastState_t* state, uint32_t now_s);
+
+/**
+ * Day of week for a Unix timestamp (0=Sunday)
+ */
+uint8_t forecastDayOfWeek(uint32_t unix_s);
+
+#endif  // BINSAI_FILL_FORECASTER_H
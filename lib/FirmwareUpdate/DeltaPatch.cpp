@@ -0,0 +1,406 @@
+/**
+ * BINSAI Delta Patch - suffix-array diff, streaming applier
+ */
+
+#include "DeltaPatch.h"
+#include <string.h>
+#include <algorithm>
+
+namespace {
+
+/**
+ * Suffix array of s[0..n) plus the empty suffix (always sa[0] == n),
+ * by prefix doubling; fine for app images of a few MB on the build host
+ */
+void buildSuffixArray(const uint8_t* s, int64_t n, std::vector<int32_t>* out) {
+    std::vector<int32_t>& sa = *out;
+    std::vector<int32_t> rank(n + 1), next(n + 1);
+    sa.resize(n + 1);
+    for (int64_t i = 0; i < n; i++) {
+        rank[i] = s[i];
+    }
+    rank[n] = -1;
+    for (int64_t i = 0; i <= n; i++) {
+        sa[i] = (int32_t)i;
+    }
+
+    for (int64_t k = 1;; k <<= 1) {
+        auto second = [&](int32_t i) { return i + k <= n ? rank[i + k] : -1; };
+        auto less = [&](int32_t a, int32_t b) {
+            return rank[a] != rank[b] ? rank[a] < rank[b] : second(a) < second(b);
+        };
+        std::sort(sa.begin(), sa.end(), less);
+
+        next[sa[0]] = 0;
+        for (int64_t i = 1; i <= n; i++) {
+            next[sa[i]] = next[sa[i - 1]] + (less(sa[i - 1], sa[i]) ? 1 : 0);
+        }
+        rank.swap(next);
+        if (rank[sa[n]] == n) {
+            break;
+        }
+    }
+}
+
+int64_t matchLength(const uint8_t* a, int64_t a_size, const uint8_t* b, int64_t b_size) {
+    int64_t i = 0;
+    while (i < a_size && i < b_size && a[i] == b[i]) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * Longest match of target[0..] in source via binary search of the suffix array
+ */
+int64_t searchLongest(const std::vector<int32_t>& sa, const uint8_t* source, int64_t source_size,
+                      const uint8_t* target, int64_t target_size, int64_t* position) {
+    int64_t start = 0;
+    int64_t end = source_size;
+    while (end - start >= 2) {
+        int64_t middle = start + (end - start) / 2;
+        int64_t compare = std::min<int64_t>(source_size - sa[middle], target_size);
+        if (memcmp(source + sa[middle], target, (size_t)compare) < 0) {
+            start = middle;
+        } else {
+            end = middle;
+        }
+    }
+
+    int64_t x = matchLength(source + sa[start], source_size - sa[start], target, target_size);
+    int64_t y = matchLength(source + sa[end], source_size - sa[end], target, target_size);
+    if (x > y) {
+        *position = sa[start];
+        return x;
+    }
+    *position = sa[end];
+    return y;
+}
+
+void putVarint(std::vector<uint8_t>* out, uint64_t value) {
+    while (value >= 0x80) {
+        out->push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out->push_back((uint8_t)value);
+}
+
+uint64_t zigzag(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+}  // namespace
+
+void deltaPatchCreate(const uint8_t* source, size_t source_size, const uint8_t* target, size_t target_size,
+                      std::vector<uint8_t>* patch, DeltaPatchStats_t* stats) {
+    DeltaPatchStats_t local;
+    memset(&local, 0, sizeof(local));
+
+    const int64_t old_size = (int64_t)source_size;
+    const int64_t new_size = (int64_t)target_size;
+    std::vector<int32_t> sa;
+    buildSuffixArray(source, old_size, &sa);
+
+    std::vector<uint8_t> body;
+    body.reserve(target_size / 4 + 64);
+
+    // bsdiff 4 scan: extend approximate matches forwards and backwards so
+    // shifted code becomes a run of small differences
+    int64_t scan = 0, length = 0, position = 0;
+    int64_t last_scan = 0, last_position = 0, last_offset = 0;
+    while (scan < new_size) {
+        int64_t old_score = 0;
+        int64_t score_cursor = scan += length;
+        for (; scan < new_size; scan++) {
+            length = searchLongest(sa, source, old_size, target + scan, new_size - scan, &position);
+            for (; score_cursor < scan + length; score_cursor++) {
+                if (score_cursor + last_offset < old_size && source[score_cursor + last_offset] == target[score_cursor]) {
+                    old_score++;
+                }
+            }
+            if ((length == old_score && length != 0) || length > old_score + 8) {
+                break;
+            }
+            if (scan + last_offset < old_size && source[scan + last_offset] == target[scan]) {
+                old_score--;
+            }
+        }
+
+        if (length == old_score && scan != new_size) {
+            continue;
+        }
+
+        int64_t forward = 0;
+        {
+            int64_t matched = 0, best = 0;
+            for (int64_t i = 0; last_scan + i < scan && last_position + i < old_size;) {
+                if (source[last_position + i] == target[last_scan + i]) matched++;
+                i++;
+                if (matched * 2 - i > best * 2 - forward) {
+                    best = matched;
+                    forward = i;
+                }
+            }
+        }
+
+        int64_t backward = 0;
+        if (scan < new_size) {
+            int64_t matched = 0, best = 0;
+            for (int64_t i = 1; scan >= last_scan + i && position >= i; i++) {
+                if (source[position - i] == target[scan - i]) matched++;
+                if (matched * 2 - i > best * 2 - backward) {
+                    best = matched;
+                    backward = i;
+                }
+            }
+        }
+
+        if (last_scan + forward > scan - backward) {
+            int64_t overlap = (last_scan + forward) - (scan - backward);
+            int64_t matched = 0, best = 0, split = 0;
+            for (int64_t i = 0; i < overlap; i++) {
+                if (target[last_scan + forward - overlap + i] == source[last_position + forward - overlap + i]) matched++;
+                if (target[scan - backward + i] == source[position - backward + i]) matched--;
+                if (matched > best) {
+                    best = matched;
+                    split = i + 1;
+                }
+            }
+            forward += split - overlap;
+            backward -= split;
+        }
+
+        int64_t extra = (scan - backward) - (last_scan + forward);
+        int64_t seek = (position - backward) - (last_position + forward);
+        putVarint(&body, (uint64_t)forward);
+        putVarint(&body, (uint64_t)extra);
+        putVarint(&body, zigzag(seek));
+        for (int64_t i = 0; i < forward; i++) {
+            uint8_t delta = (uint8_t)(target[last_scan + i] - source[last_position + i]);
+            local.diff_nonzero += delta != 0;
+            body.push_back(delta);
+        }
+        body.insert(body.end(), target + last_scan + forward, target + last_scan + forward + extra);
+
+        local.records++;
+        local.diff_bytes += (uint32_t)forward;
+        local.extra_bytes += (uint32_t)extra;
+
+        last_scan = scan - backward;
+        last_position = position - backward;
+        last_offset = position - scan;
+    }
+
+    DeltaPatchHeader_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = DELTA_PATCH_MAGIC;
+    header.version = DELTA_PATCH_VERSION;
+    header.window_bits = LZSS_WINDOW_BITS;
+    header.length_bits = LZSS_LENGTH_BITS;
+    header.source_size = (uint32_t)source_size;
+    header.target_size = (uint32_t)target_size;
+
+    size_t start = patch->size();
+    const uint8_t* raw = (const uint8_t*)&header;
+    patch->insert(patch->end(), raw, raw + sizeof(header));
+    lzssCompress(body.data(), body.size(), patch);
+
+    local.body_bytes = (uint32_t)body.size();
+    local.patch_bytes = (uint32_t)(patch->size() - start);
+    if (stats) {
+        *stats = local;
+    }
+}
+
+DeltaPatchApplier::DeltaPatchApplier(PatchSource& source, PatchSink& sink)
+    : _source(source), _sink(sink) {
+    reset();
+}
+
+void DeltaPatchApplier::reset() {
+    _lzss.reset();
+    _status = DELTA_APPLY_RUNNING;
+    memset(&_header, 0, sizeof(_header));
+    _header_received = 0;
+    _stage = FIELD_DIFF;
+    _varint = 0;
+    _varint_shift = 0;
+    _diff_remaining = 0;
+    _extra_remaining = 0;
+    _pending_seek = 0;
+    _source_cursor = 0;
+    _target_written = 0;
+    _out_length = 0;
+}
+
+bool DeltaPatchApplier::flush() {
+    if (_out_length && !_sink.writeTarget(_out, _out_length)) {
+        _status = DELTA_APPLY_SINK_ERROR;
+        return false;
+    }
+    _target_written += (uint32_t)_out_length;
+    _out_length = 0;
+    return true;
+}
+
+bool DeltaPatchApplier::emit(const uint8_t* data, size_t length) {
+    while (length) {
+        size_t take = std::min(length, sizeof(_out) - _out_length);
+        memcpy(_out + _out_length, data, take);
+        _out_length += take;
+        data += take;
+        length -= take;
+        if (_out_length == sizeof(_out) && !flush()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * A record (or the whole image) has been emitted
+ */
+void DeltaPatchApplier::finishControl() {
+    _stage = FIELD_DIFF;
+    if (_target_written + _out_length == _header.target_size && flush()) {
+        _status = DELTA_APPLY_DONE;
+    }
+}
+
+void DeltaPatchApplier::consumeBody(const uint8_t* data, size_t length) {
+    while (_status == DELTA_APPLY_RUNNING) {
+        if (_stage == STAGE_DIFF && _diff_remaining == 0) {
+            _stage = STAGE_EXTRA;
+        }
+        if (_stage == STAGE_EXTRA && _extra_remaining == 0) {
+            _source_cursor += _pending_seek;
+            finishControl();
+            continue;
+        }
+        if (length == 0) {
+            break;
+        }
+
+        if (_stage == STAGE_DIFF) {
+            size_t take = std::min<size_t>(length, _diff_remaining);
+            if (!_source.readSource((uint32_t)_source_cursor, _source_chunk, take)) {
+                _status = DELTA_APPLY_SOURCE_ERROR;
+                return;
+            }
+            for (size_t i = 0; i < take; i++) {
+                _source_chunk[i] = (uint8_t)(_source_chunk[i] + data[i]);
+            }
+            if (!emit(_source_chunk, take)) return;
+            _source_cursor += take;
+            _diff_remaining -= (uint32_t)take;
+            data += take;
+            length -= take;
+            continue;
+        }
+        if (_stage == STAGE_EXTRA) {
+            size_t take = std::min<size_t>(length, _extra_remaining);
+            if (!emit(data, take)) return;
+            _extra_remaining -= (uint32_t)take;
+            data += take;
+            length -= take;
+            continue;
+        }
+
+        uint8_t byte = *data++;
+        length--;
+        _varint |= (uint64_t)(byte & 0x7F) << _varint_shift;
+        _varint_shift += 7;
+        if (byte & 0x80) {
+            if (_varint_shift > 63) {
+                _status = DELTA_APPLY_CORRUPT;
+            }
+            continue;
+        }
+        uint64_t value = _varint;
+        _varint = 0;
+        _varint_shift = 0;
+
+        uint64_t room = _header.target_size - (_target_written + _out_length);
+        if (_stage == FIELD_DIFF) {
+            if (value > room) {
+                _status = DELTA_APPLY_CORRUPT;
+                return;
+            }
+            _diff_remaining = (uint32_t)value;
+            _stage = FIELD_EXTRA;
+        } else if (_stage == FIELD_EXTRA) {
+            if (value > room - _diff_remaining) {
+                _status = DELTA_APPLY_CORRUPT;
+                return;
+            }
+            _extra_remaining = (uint32_t)value;
+            _stage = FIELD_SEEK;
+        } else {
+            if (_diff_remaining &&
+                (_source_cursor < 0 || _source_cursor + _diff_remaining > (int64_t)_header.source_size)) {
+                _status = DELTA_APPLY_SOURCE_ERROR;
+                return;
+            }
+            _pending_seek = unzigzag(value);
+            _stage = STAGE_DIFF;
+        }
+    }
+}
+
+DeltaApplyStatus_t DeltaPatchApplier::write(const uint8_t* data, size_t length) {
+    if (_status != DELTA_APPLY_RUNNING) {
+        return _status;
+    }
+
+    if (_header_received < sizeof(_header)) {
+        size_t take = std::min(length, sizeof(_header) - _header_received);
+        memcpy((uint8_t*)&_header + _header_received, data, take);
+        _header_received += take;
+        data += take;
+        length -= take;
+        if (_header_received < sizeof(_header)) {
+            return _status;
+        }
+        if (_header.magic != DELTA_PATCH_MAGIC || _header.version != DELTA_PATCH_VERSION ||
+            _header.window_bits != LZSS_WINDOW_BITS || _header.length_bits != LZSS_LENGTH_BITS) {
+            _status = DELTA_APPLY_BAD_HEADER;
+            return _status;
+        }
+        if (_header.target_size == 0) {
+            _status = DELTA_APPLY_DONE;
+            return _status;
+        }
+    }
+
+    while (_status == DELTA_APPLY_RUNNING) {
+        size_t consumed = 0;
+        size_t decoded = _lzss.decode(data, length, &consumed, _decoded, sizeof(_decoded));
+        data += consumed;
+        length -= consumed;
+        if (_lzss.corrupt()) {
+            _status = DELTA_APPLY_CORRUPT;
+            break;
+        }
+        consumeBody(_decoded, decoded);
+        if (decoded < sizeof(_decoded)) {
+            break;
+        }
+    }
+    return _status;
+}
+
+const char* deltaApplyStatusName(DeltaApplyStatus_t status) {
+    switch (status) {
+        case DELTA_APPLY_RUNNING:       return "running";
+        case DELTA_APPLY_DONE:          return "done";
+        case DELTA_APPLY_BAD_HEADER:    return "bad header";
+        case DELTA_APPLY_CORRUPT:       return "corrupt";
+        case DELTA_APPLY_SOURCE_ERROR:  return "source error";
+        case DELTA_APPLY_SINK_ERROR:    return "sink error";
+    }
+    return "unknown";
+}
@@ -0,0 +1,147 @@
+/**
+ * ============================================================================
+ * BINSAI Delta Patch
+ * bsdiff-style binary delta with an LZSS-compressed, streamable body
+ * ============================================================================
+ *
+ * PATCH LAYOUT:
+ * [DeltaPatchHeader_t][LZSS body]
+ *
+ * BODY (after LZSS), repeated until target_size bytes are produced:
+ *   varint diff_length, varint extra_length, zigzag varint seek
+ *   diff_length bytes  added (mod 256) to source bytes at the source cursor
+ *   extra_length bytes copied verbatim
+ *   source cursor += diff_length + seek
+ *
+ * This is bsdiff 4 (Percival) with the three streams interleaved per
+ * record instead of three bzip2 blocks, so the device can apply it with a
+ * forward-only read of the patch, random reads of the running image and a
+ * sequential write of the new slot. Relocated code shows up as mostly-zero
+ * diff bytes, which is what the LZSS long matches are tuned for.
+ *
+ * A source of size 0 gives a plain compressed image (one extra record).
+ *
+ * deltaPatchCreate() builds a suffix array of the source and runs on the
+ * build host; DeltaPatchApplier is heap-free and runs on the ESP32.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_DELTA_PATCH_H
+#define BINSAI_DELTA_PATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "LzssCodec.h"
+
+#define DELTA_PATCH_MAGIC           0x544C4442UL  // "BDLT" little-endian
+#define DELTA_PATCH_VERSION         1
+#define DELTA_APPLY_CHUNK           256         // Decode / flash write granularity
+
+/**
+ * Patch header, stored uncompressed in front of the body
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;                 // DELTA_PATCH_MAGIC
+    uint8_t version;                // DELTA_PATCH_VERSION
+    uint8_t window_bits;            // LZSS_WINDOW_BITS at encode time
+    uint8_t length_bits;            // LZSS_LENGTH_BITS at encode time
+    uint8_t reserved;
+    uint32_t source_size;           // Base image bytes (0 = full image)
+    uint32_t target_size;           // New image bytes
+} DeltaPatchHeader_t;
+
+typedef struct {
+    uint32_t records;               // Control triples
+    uint32_t diff_bytes;            // Bytes derived from the source
+    uint32_t diff_nonzero;          // ... that differ from the source
+    uint32_t extra_bytes;           // Bytes with no source match
+    uint32_t body_bytes;            // Body before LZSS
+    uint32_t patch_bytes;           // Header + compressed body
+} DeltaPatchStats_t;
+
+/**
+ * Build a patch that turns source into target (appends to patch)
+ * @param stats Optional breakdown of the patch
+ */
+void deltaPatchCreate(const uint8_t* source, size_t source_size, const uint8_t* target, size_t target_size,
+                      std::vector<uint8_t>* patch, DeltaPatchStats_t* stats);
+
+/**
+ * Random-access reader for the base image (running app slot)
+ */
+class PatchSource {
+public:
+    virtual ~PatchSource() {}
+    virtual bool readSource(uint32_t offset, void* buffer, size_t length) = 0;
+};
+
+/**
+ * Sequential writer for the new image (inactive app slot)
+ */
+class PatchSink {
+public:
+    virtual ~PatchSink() {}
+    virtual bool writeTarget(const void* data, size_t length) = 0;
+};
+
+typedef enum {
+    DELTA_APPLY_RUNNING = 0,        // Waiting for more patch bytes
+    DELTA_APPLY_DONE,               // target_size bytes written
+    DELTA_APPLY_BAD_HEADER,         // Magic, version or LZSS parameters
+    DELTA_APPLY_CORRUPT,            // Body inconsistent with the header
+    DELTA_APPLY_SOURCE_ERROR,       // Read outside / failure of the base image
+    DELTA_APPLY_SINK_ERROR          // Flash write failed
+} DeltaApplyStatus_t;
+
+class DeltaPatchApplier {
+public:
+    DeltaPatchApplier(PatchSource& source, PatchSink& sink);
+
+    void reset();
+
+    /**
+     * Feed the next patch bytes (any chunk size, including the header)
+     * @return Running until the image is complete, then Done; errors stick
+     */
+    DeltaApplyStatus_t write(const uint8_t* data, size_t length);
+
+    DeltaApplyStatus_t status() const { return _status; }
+    bool hasHeader() const { return _header_received == sizeof(DeltaPatchHeader_t); }
+    const DeltaPatchHeader_t& header() const { return _header; }
+    uint32_t targetWritten() const { return _target_written; }
+
+private:
+    typedef enum { FIELD_DIFF = 0, FIELD_EXTRA, FIELD_SEEK, STAGE_DIFF, STAGE_EXTRA } Stage_t;
+
+    void consumeBody(const uint8_t* data, size_t length);
+    void finishControl();
+    bool emit(const uint8_t* data, size_t length);
+    bool flush();
+
+    PatchSource& _source;
+    PatchSink& _sink;
+    LzssDecoder _lzss;
+    DeltaApplyStatus_t _status;
+
+    DeltaPatchHeader_t _header;
+    size_t _header_received;
+
+    Stage_t _stage;
+    uint64_t _varint;               // Field being decoded
+    uint8_t _varint_shift;
+    uint32_t _diff_remaining;
+    uint32_t _extra_remaining;
+    int64_t _pending_seek;          // Applied once the record is emitted
+    int64_t _source_cursor;
+    uint32_t _target_written;       // Bytes handed to the sink
+
+    uint8_t _decoded[DELTA_APPLY_CHUNK];
+    uint8_t _source_chunk[DELTA_APPLY_CHUNK];
+    uint8_t _out[DELTA_APPLY_CHUNK];
+    size_t _out_length;
+};
+
+const char* deltaApplyStatusName(DeltaApplyStatus_t status);
+
+#endif  // BINSAI_DELTA_PATCH_H
@@ -0,0 +1,413 @@
+/**
+ * BINSAI Ed25519 - GF(2^255-19) arithmetic, extended twisted Edwards points
+ */
+
+#include "Ed25519.h"
+#include <string.h>
+#include "Sha512.h"
+
+namespace {
+
+typedef int64_t Fe[16];             // Field element, 16 signed 16-bit limbs
+
+const Fe FE_ZERO = { 0 };
+const Fe FE_ONE = { 1 };
+const Fe FE_D = { 0x78a3, 0x1359, 0x4dca, 0x75eb, 0xd8ab, 0x4141, 0x0a4d, 0x0070,
+                  0xe898, 0x7779, 0x4079, 0x8cc7, 0xfe73, 0x2b6f, 0x6cee, 0x5203 };
+const Fe FE_D2 = { 0xf159, 0x26b2, 0x9b94, 0xebd6, 0xb156, 0x8283, 0x149a, 0x00e0,
+                   0xd130, 0xeef3, 0x80f2, 0x198e, 0xfce7, 0x56df, 0xd9dc, 0x2406 };
+const Fe FE_BASE_X = { 0xd51a, 0x8f25, 0x2d60, 0xc956, 0xa7b2, 0x9525, 0xc760, 0x692c,
+                       0xdc5c, 0xfdd6, 0xe231, 0xc0a4, 0x53fe, 0xcd6e, 0x36d3, 0x2169 };
+const Fe FE_BASE_Y = { 0x6658, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666,
+                       0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666 };
+const Fe FE_SQRT_M1 = { 0xa0b0, 0x4a0e, 0x1b27, 0xc4ee, 0xe478, 0xad2f, 0x1806, 0x2f43,
+                        0xd7a7, 0x3dfb, 0x0099, 0x2b4d, 0xdf0b, 0x4fc1, 0x2480, 0x2b83 };
+
+// Group order L = 2^252 + 27742317777372353535851937790883648493, little-endian
+const int64_t ORDER_L[32] = { 0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+                              0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+                              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x10 };
+
+bool equal32(const uint8_t* a, const uint8_t* b) {
+    uint8_t diff = 0;
+    for (int i = 0; i < 32; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+void feCopy(Fe out, const Fe a) {
+    for (int i = 0; i < 16; i++) out[i] = a[i];
+}
+
+void feCarry(Fe o) {
+    for (int i = 0; i < 16; i++) {
+        o[i] += (int64_t)1 << 16;
+        int64_t carry = o[i] >> 16;
+        o[(i + 1) * (i < 15)] += carry - 1 + 37 * (carry - 1) * (i == 15);
+        o[i] -= carry * 65536;
+    }
+}
+
+/**
+ * Constant-time swap of p and q when bit is 1
+ */
+void feSwap(Fe p, Fe q, int bit) {
+    int64_t mask = ~((int64_t)bit - 1);
+    for (int i = 0; i < 16; i++) {
+        int64_t t = mask & (p[i] ^ q[i]);
+        p[i] ^= t;
+        q[i] ^= t;
+    }
+}
+
+void fePack(uint8_t* out, const Fe n) {
+    Fe m, t;
+    feCopy(t, n);
+    feCarry(t);
+    feCarry(t);
+    feCarry(t);
+    for (int pass = 0; pass < 2; pass++) {
+        m[0] = t[0] - 0xffed;
+        for (int i = 1; i < 15; i++) {
+            m[i] = t[i] - 0xffff - ((m[i - 1] >> 16) & 1);
+            m[i - 1] &= 0xffff;
+        }
+        m[15] = t[15] - 0x7fff - ((m[14] >> 16) & 1);
+        int borrow = (int)((m[15] >> 16) & 1);
+        m[14] &= 0xffff;
+        feSwap(t, m, 1 - borrow);
+    }
+    for (int i = 0; i < 16; i++) {
+        out[2 * i] = (uint8_t)(t[i] & 0xff);
+        out[2 * i + 1] = (uint8_t)(t[i] >> 8);
+    }
+}
+
+bool feEqual(const Fe a, const Fe b) {
+    uint8_t pa[32], pb[32];
+    fePack(pa, a);
+    fePack(pb, b);
+    return equal32(pa, pb);
+}
+
+uint8_t feParity(const Fe a) {
+    uint8_t packed[32];
+    fePack(packed, a);
+    return packed[0] & 1;
+}
+
+void feUnpack(Fe out, const uint8_t* n) {
+    for (int i = 0; i < 16; i++) {
+        out[i] = n[2 * i] + ((int64_t)n[2 * i + 1] << 8);
+    }
+    out[15] &= 0x7fff;
+}
+
+void feAdd(Fe o, const Fe a, const Fe b) {
+    for (int i = 0; i < 16; i++) o[i] = a[i] + b[i];
+}
+
+void feSub(Fe o, const Fe a, const Fe b) {
+    for (int i = 0; i < 16; i++) o[i] = a[i] - b[i];
+}
+
+void feMul(Fe o, const Fe a, const Fe b) {
+    int64_t t[31];
+    for (int i = 0; i < 31; i++) t[i] = 0;
+    for (int i = 0; i < 16; i++) {
+        for (int j = 0; j < 16; j++) {
+            t[i + j] += a[i] * b[j];
+        }
+    }
+    for (int i = 0; i < 15; i++) {
+        t[i] += 38 * t[i + 16];
+    }
+    for (int i = 0; i < 16; i++) o[i] = t[i];
+    feCarry(o);
+    feCarry(o);
+}
+
+void feSquare(Fe o, const Fe a) {
+    feMul(o, a, a);
+}
+
+void feInvert(Fe o, const Fe in) {
+    Fe c;
+    feCopy(c, in);
+    for (int a = 253; a >= 0; a--) {
+        feSquare(c, c);
+        if (a != 2 && a != 4) feMul(c, c, in);
+    }
+    feCopy(o, c);
+}
+
+/**
+ * in^((p-5)/8), the square-root helper for point decompression
+ */
+void fePow2523(Fe o, const Fe in) {
+    Fe c;
+    feCopy(c, in);
+    for (int a = 250; a >= 0; a--) {
+        feSquare(c, c);
+        if (a != 1) feMul(c, c, in);
+    }
+    feCopy(o, c);
+}
+
+// Points are (X, Y, Z, T) with x = X/Z, y = Y/Z, xy = T/Z
+void pointAdd(Fe p[4], Fe q[4]) {
+    Fe a, b, c, d, t, e, f, g, h;
+    feSub(a, p[1], p[0]);
+    feSub(t, q[1], q[0]);
+    feMul(a, a, t);
+    feAdd(b, p[0], p[1]);
+    feAdd(t, q[0], q[1]);
+    feMul(b, b, t);
+    feMul(c, p[3], q[3]);
+    feMul(c, c, FE_D2);
+    feMul(d, p[2], q[2]);
+    feAdd(d, d, d);
+    feSub(e, b, a);
+    feSub(f, d, c);
+    feAdd(g, d, c);
+    feAdd(h, b, a);
+    feMul(p[0], e, f);
+    feMul(p[1], h, g);
+    feMul(p[2], g, f);
+    feMul(p[3], e, h);
+}
+
+void pointSwap(Fe p[4], Fe q[4], int bit) {
+    for (int i = 0; i < 4; i++) feSwap(p[i], q[i], bit);
+}
+
+void pointPack(uint8_t* out, Fe p[4]) {
+    Fe tx, ty, zi;
+    feInvert(zi, p[2]);
+    feMul(tx, p[0], zi);
+    feMul(ty, p[1], zi);
+    fePack(out, ty);
+    out[31] ^= (uint8_t)(feParity(tx) << 7);
+}
+
+/**
+ * p = s * q (q is clobbered), constant-time ladder over all 256 bits
+ */
+void scalarMult(Fe p[4], Fe q[4], const uint8_t* s) {
+    feCopy(p[0], FE_ZERO);
+    feCopy(p[1], FE_ONE);
+    feCopy(p[2], FE_ONE);
+    feCopy(p[3], FE_ZERO);
+    for (int i = 255; i >= 0; i--) {
+        int bit = (s[i / 8] >> (i & 7)) & 1;
+        pointSwap(p, q, bit);
+        pointAdd(q, p);
+        pointAdd(p, p);
+        pointSwap(p, q, bit);
+    }
+}
+
+void scalarBase(Fe p[4], const uint8_t* s) {
+    Fe q[4];
+    feCopy(q[0], FE_BASE_X);
+    feCopy(q[1], FE_BASE_Y);
+    feCopy(q[2], FE_ONE);
+    feMul(q[3], FE_BASE_X, FE_BASE_Y);
+    scalarMult(p, q, s);
+}
+
+/**
+ * y below p (RFC 8032 section 5.1.3 rejects y >= p)
+ */
+bool pointIsCanonical(const uint8_t* packed) {
+    Fe y;
+    uint8_t check[32];
+    feUnpack(y, packed);
+    fePack(check, y);
+    check[31] |= packed[31] & 0x80;
+    return equal32(check, packed);
+}
+
+/**
+ * 8 * p is the identity: one of the eight torsion points. As a public key
+ * it makes k*A vanish for every fourth or eighth challenge (the all-zero
+ * placeholder key decodes to one), as R it lets signatures be malleated
+ */
+bool pointIsSmallOrder(Fe p[4]) {
+    Fe q[4];
+    for (int i = 0; i < 4; i++) feCopy(q[i], p[i]);
+    for (int i = 0; i < 3; i++) pointAdd(q, q);
+    return feEqual(q[0], FE_ZERO) && feEqual(q[1], q[2]);
+}
+
+/**
+ * Decompress a point and negate it
+ * @return false if the encoding is not on the curve or not canonical
+ */
+bool pointUnpackNeg(Fe r[4], const uint8_t* packed) {
+    Fe t, chk, num, den, den2, den4, den6;
+    if (!pointIsCanonical(packed)) return false;
+    feCopy(r[2], FE_ONE);
+    feUnpack(r[1], packed);
+    feSquare(num, r[1]);
+    feMul(den, num, FE_D);
+    feSub(num, num, r[2]);
+    feAdd(den, r[2], den);
+
+    feSquare(den2, den);
+    feSquare(den4, den2);
+    feMul(den6, den4, den2);
+    feMul(t, den6, num);
+    feMul(t, t, den);
+
+    fePow2523(t, t);
+    feMul(t, t, num);
+    feMul(t, t, den);
+    feMul(t, t, den);
+    feMul(r[0], t, den);
+
+    feSquare(chk, r[0]);
+    feMul(chk, chk, den);
+    if (!feEqual(chk, num)) feMul(r[0], r[0], FE_SQRT_M1);
+
+    feSquare(chk, r[0]);
+    feMul(chk, chk, den);
+    if (!feEqual(chk, num)) return false;
+
+    // x = 0 has no negative: a set sign bit is a second encoding
+    if (feEqual(r[0], FE_ZERO) && (packed[31] >> 7)) return false;
+    if (feParity(r[0]) == (packed[31] >> 7)) feSub(r[0], FE_ZERO, r[0]);
+
+    feMul(r[3], r[0], r[1]);
+    return true;
+}
+
+/**
+ * r = x mod L, x holds 64 limbs of up to ~2^60
+ */
+void reduceModL(uint8_t* r, int64_t x[64]) {
+    int64_t carry;
+    int i, j;
+    for (i = 63; i >= 32; --i) {
+        carry = 0;
+        for (j = i - 32; j < i - 12; ++j) {
+            x[j] += carry - 16 * x[i] * ORDER_L[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+    carry = 0;
+    for (j = 0; j < 32; j++) {
+        x[j] += carry - (x[31] >> 4) * ORDER_L[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    for (j = 0; j < 32; j++) {
+        x[j] -= carry * ORDER_L[j];
+    }
+    for (i = 0; i < 32; i++) {
+        x[i + 1] += x[i] >> 8;
+        r[i] = (uint8_t)(x[i] & 255);
+    }
+}
+
+void reduceHash(uint8_t* r, const uint8_t hash[SHA512_DIGEST_SIZE]) {
+    int64_t x[64];
+    for (int i = 0; i < 64; i++) x[i] = hash[i];
+    reduceModL(r, x);
+}
+
+/**
+ * Signature S must be canonical (< L) to rule out malleated signatures
+ */
+bool scalarIsCanonical(const uint8_t* s) {
+    for (int i = 31; i >= 0; i--) {
+        if (s[i] < ORDER_L[i]) return true;
+        if (s[i] > ORDER_L[i]) return false;
+    }
+    return false;
+}
+
+void expandSeed(const uint8_t* seed, uint8_t expanded[SHA512_DIGEST_SIZE]) {
+    Sha512::hash(seed, ED25519_SEED_SIZE, expanded);
+    expanded[0] &= 248;
+    expanded[31] &= 127;
+    expanded[31] |= 64;
+}
+
+}  // namespace
+
+void ed25519PublicKey(const uint8_t seed[ED25519_SEED_SIZE], uint8_t public_key[ED25519_PUBLIC_KEY_SIZE]) {
+    uint8_t expanded[SHA512_DIGEST_SIZE];
+    Fe p[4];
+    expandSeed(seed, expanded);
+    scalarBase(p, expanded);
+    pointPack(public_key, p);
+}
+
+void ed25519Sign(const uint8_t seed[ED25519_SEED_SIZE], const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE],
+                 const void* message, size_t length, uint8_t signature[ED25519_SIGNATURE_SIZE]) {
+    uint8_t expanded[SHA512_DIGEST_SIZE];
+    uint8_t nonce[SHA512_DIGEST_SIZE];
+    uint8_t challenge[SHA512_DIGEST_SIZE];
+    Fe p[4];
+    Sha512 sha;
+
+    expandSeed(seed, expanded);
+
+    // r = H(prefix || M) mod L, R = rB
+    sha.update(expanded + 32, 32);
+    sha.update(message, length);
+    sha.finish(nonce);
+    reduceHash(nonce, nonce);
+    scalarBase(p, nonce);
+    pointPack(signature, p);
+
+    // k = H(R || A || M) mod L
+    sha.update(signature, 32);
+    sha.update(public_key, ED25519_PUBLIC_KEY_SIZE);
+    sha.update(message, length);
+    sha.finish(challenge);
+    reduceHash(challenge, challenge);
+
+    // S = (r + k * a) mod L
+    int64_t x[64];
+    for (int i = 0; i < 64; i++) x[i] = 0;
+    for (int i = 0; i < 32; i++) x[i] = nonce[i];
+    for (int i = 0; i < 32; i++) {
+        for (int j = 0; j < 32; j++) {
+            x[i + j] += (int64_t)challenge[i] * expanded[j];
+        }
+    }
+    reduceModL(signature + 32, x);
+}
+
+bool ed25519Verify(const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE], const void* message, size_t length,
+                   const uint8_t signature[ED25519_SIGNATURE_SIZE]) {
+    Fe p[4], q[4];
+    uint8_t challenge[SHA512_DIGEST_SIZE];
+    uint8_t check[32];
+
+    // Small-order A or R would verify forged or malleated signatures
+    if (!scalarIsCanonical(signature + 32) || !pointUnpackNeg(p, signature) || pointIsSmallOrder(p) ||
+        !pointUnpackNeg(q, public_key) || pointIsSmallOrder(q)) {
+        return false;
+    }
+
+    Sha512 sha;
+    sha.update(signature, 32);
+    sha.update(public_key, ED25519_PUBLIC_KEY_SIZE);
+    sha.update(message, length);
+    sha.finish(challenge);
+    reduceHash(challenge, challenge);
+
+    // R' = S*B - k*A must encode to R
+    scalarMult(p, q, challenge);
+    scalarBase(q, signature + 32);
+    pointAdd(p, q);
+    pointPack(check, p);
+    return equal32(check, signature);
+}
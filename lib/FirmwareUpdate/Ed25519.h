@@ -0,0 +1,45 @@
+/**
+ * ============================================================================
+ * BINSAI Ed25519
+ * RFC 8032 signatures for firmware manifests
+ * ============================================================================
+ *
+ * Field and group arithmetic follow TweetNaCl (public domain): 16 x 16-bit
+ * limbs in int64_t, no tables, no heap. Small enough for the bootloader-less
+ * update path on the ESP32 and identical on the host, where the fleet tool
+ * signs manifests with the same code.
+ *
+ * The device only ever verifies; the 32-byte seed stays on the build host.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_ED25519_H
+#define BINSAI_ED25519_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ED25519_SEED_SIZE           32
+#define ED25519_PUBLIC_KEY_SIZE     32
+#define ED25519_SIGNATURE_SIZE      64
+
+/**
+ * Derive the public key for a secret seed
+ */
+void ed25519PublicKey(const uint8_t seed[ED25519_SEED_SIZE], uint8_t public_key[ED25519_PUBLIC_KEY_SIZE]);
+
+/**
+ * Sign a message (deterministic, RFC 8032 section 5.1.6)
+ */
+void ed25519Sign(const uint8_t seed[ED25519_SEED_SIZE], const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE],
+                 const void* message, size_t length, uint8_t signature[ED25519_SIGNATURE_SIZE]);
+
+/**
+ * Verify a detached signature
+ * Non-canonical or small-order keys and R values never verify
+ * @return true if the signature is valid for this key and message
+ */
+bool ed25519Verify(const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE], const void* message, size_t length,
+                   const uint8_t signature[ED25519_SIGNATURE_SIZE]);
+
+#endif  // BINSAI_ED25519_H
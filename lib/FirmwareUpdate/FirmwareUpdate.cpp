@@ -0,0 +1,253 @@
+/**
+ * BINSAI Firmware Update - manifest checks, verified slot writes, boot guard
+ */
+
+#include "FirmwareUpdate.h"
+#include <string.h>
+
+void firmwareManifestSign(FirmwareManifest_t* manifest, const uint8_t seed[ED25519_SEED_SIZE]) {
+    uint8_t public_key[ED25519_PUBLIC_KEY_SIZE];
+    ed25519PublicKey(seed, public_key);
+    ed25519Sign(seed, public_key, manifest, FIRMWARE_SIGNED_SIZE, manifest->signature);
+}
+
+bool firmwareManifestVerify(const FirmwareManifest_t& manifest, const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE]) {
+    return ed25519Verify(public_key, &manifest, FIRMWARE_SIGNED_SIZE, manifest.signature);
+}
+
+FirmwareUpdater::FirmwareUpdater(FirmwareUpdateBackend& backend, const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE],
+                                 uint32_t security_version)
+    : _backend(backend), _public_key(public_key), _security_version(security_version), _patch(backend, *this),
+      _status(FIRMWARE_UPDATE_IDLE), _payload_received(0) {
+    memset(&_manifest, 0, sizeof(_manifest));
+}
+
+bool FirmwareUpdater::hasSigningKey() const {
+    uint8_t bits = 0;
+    for (size_t i = 0; i < ED25519_PUBLIC_KEY_SIZE; i++) {
+        bits |= _public_key[i];
+    }
+    return bits != 0;
+}
+
+FirmwareUpdateStatus_t FirmwareUpdater::fail(FirmwareUpdateStatus_t status) {
+    if (_status == FIRMWARE_UPDATE_RECEIVING) {
+        _backend.abortUpdate();
+    }
+    _status = status;
+    return _status;
+}
+
+FirmwareUpdateStatus_t FirmwareUpdater::begin(const FirmwareManifest_t& manifest) {
+    abort();
+    _manifest = manifest;
+
+    if (!hasSigningKey()) {
+        return fail(FIRMWARE_UPDATE_NO_SIGNING_KEY);
+    }
+    if (manifest.magic != FIRMWARE_MANIFEST_MAGIC || manifest.format != FIRMWARE_MANIFEST_FORMAT ||
+        manifest.target_size == 0 || manifest.payload_size < sizeof(DeltaPatchHeader_t)) {
+        return fail(FIRMWARE_UPDATE_BAD_MANIFEST);
+    }
+    if (!firmwareManifestVerify(manifest, _public_key)) {
+        return fail(FIRMWARE_UPDATE_BAD_SIGNATURE);
+    }
+    if (manifest.security_version <= _security_version) {
+        return fail(FIRMWARE_UPDATE_DOWNGRADE);
+    }
+
+    // Check the base before erasing anything: a delta against another
+    // build would only fail at the final digest, after a full download
+    if (manifest.flags & FIRMWARE_FLAG_DELTA) {
+        uint8_t chunk[DELTA_APPLY_CHUNK];
+        uint8_t digest[SHA512_DIGEST_SIZE];
+        Sha512 sha;
+        for (uint32_t offset = 0; offset < manifest.source_size; offset += sizeof(chunk)) {
+            size_t length = manifest.source_size - offset < sizeof(chunk) ? manifest.source_size - offset : sizeof(chunk);
+            if (!_backend.readSource(offset, chunk, length)) {
+                return fail(FIRMWARE_UPDATE_WRONG_BASE);
+            }
+            sha.update(chunk, length);
+        }
+        sha.finish(digest);
+        if (memcmp(digest, manifest.source_digest, sizeof(digest)) != 0) {
+            return fail(FIRMWARE_UPDATE_WRONG_BASE);
+        }
+    }
+
+    if (!_backend.beginUpdate(manifest.target_size)) {
+        return fail(FIRMWARE_UPDATE_FLASH_ERROR);
+    }
+    _patch.reset();
+    _image_hash.reset();
+    _payload_received = 0;
+    _status = FIRMWARE_UPDATE_RECEIVING;
+    return _status;
+}
+
+bool FirmwareUpdater::writeTarget(const void* data, size_t length) {
+    _image_hash.update(data, length);
+    return _backend.writeTarget(data, length);
+}
+
+FirmwareUpdateStatus_t FirmwareUpdater::write(const uint8_t* data, size_t length) {
+    if (_status != FIRMWARE_UPDATE_RECEIVING) {
+        return _status;
+    }
+    if (length > _manifest.payload_size - _payload_received) {
+        return fail(FIRMWARE_UPDATE_PATCH_ERROR);
+    }
+
+    bool had_header = _patch.hasHeader();
+    DeltaApplyStatus_t result = _patch.write(data, length);
+    _payload_received += (uint32_t)length;
+
+    if (!had_header && _patch.hasHeader()) {
+        const DeltaPatchHeader_t& header = _patch.header();
+        uint32_t expected_source = (_manifest.flags & FIRMWARE_FLAG_DELTA) ? _manifest.source_size : 0;
+        if (header.source_size != expected_source || header.target_size != _manifest.target_size) {
+            return fail(FIRMWARE_UPDATE_PATCH_ERROR);
+        }
+    }
+
+    if (result == DELTA_APPLY_SINK_ERROR) {
+        return fail(FIRMWARE_UPDATE_FLASH_ERROR);
+    }
+    if (result != DELTA_APPLY_RUNNING && result != DELTA_APPLY_DONE) {
+        return fail(FIRMWARE_UPDATE_PATCH_ERROR);
+    }
+    if (_payload_received < _manifest.payload_size) {
+        return _status;
+    }
+
+    if (result != DELTA_APPLY_DONE) {
+        return fail(FIRMWARE_UPDATE_PATCH_ERROR);
+    }
+    uint8_t digest[SHA512_DIGEST_SIZE];
+    _image_hash.finish(digest);
+    if (memcmp(digest, _manifest.target_digest, sizeof(digest)) != 0) {
+        return fail(FIRMWARE_UPDATE_DIGEST_MISMATCH);
+    }
+    if (!_backend.finishUpdate()) {
+        return fail(FIRMWARE_UPDATE_FLASH_ERROR);
+    }
+    _status = FIRMWARE_UPDATE_READY;
+    return _status;
+}
+
+bool FirmwareUpdater::activate() {
+    if (_status != FIRMWARE_UPDATE_READY) {
+        return false;
+    }
+
+    FirmwareBootRecord_t record;
+    memset(&record, 0, sizeof(record));
+    record.magic = FIRMWARE_BOOT_MAGIC;
+    record.state = FIRMWARE_BOOT_PENDING;
+    memcpy(record.version, _manifest.version, FIRMWARE_VERSION_MAX);
+    if (!_backend.saveBootRecord(record)) {
+        return false;
+    }
+    if (!_backend.switchSlot()) {
+        record.state = FIRMWARE_BOOT_CONFIRMED;
+        _backend.saveBootRecord(record);
+        return false;
+    }
+    _status = FIRMWARE_UPDATE_IDLE;
+    return true;
+}
+
+void FirmwareUpdater::abort() {
+    if (_status == FIRMWARE_UPDATE_RECEIVING) {
+        _backend.abortUpdate();
+    }
+    _status = FIRMWARE_UPDATE_IDLE;
+    _payload_received = 0;
+}
+
+FirmwareBootGuard::FirmwareBootGuard(FirmwareUpdateBackend& backend, uint32_t health_window_ms, uint8_t max_attempts)
+    : _backend(backend), _health_window_ms(health_window_ms), _max_attempts(max_attempts),
+      _trial(false), _boot_ms(0) {
+    memset(&_record, 0, sizeof(_record));
+}
+
+FirmwareBootAction_t FirmwareBootGuard::rollBack() {
+    _trial = false;
+    _record.state = FIRMWARE_BOOT_ROLLED_BACK;
+    _backend.saveBootRecord(_record);
+    _backend.switchSlot();
+    return FIRMWARE_BOOT_ROLLBACK;
+}
+
+FirmwareBootAction_t FirmwareBootGuard::onBoot(uint32_t now_ms, const char* running_version) {
+    _trial = false;
+    if (!_backend.loadBootRecord(&_record) || _record.magic != FIRMWARE_BOOT_MAGIC ||
+        _record.state != FIRMWARE_BOOT_PENDING) {
+        return FIRMWARE_BOOT_NORMAL;
+    }
+
+    // Still on the old image: the switch failed or the bootloader already
+    // reverted it, so there is nothing to switch back from
+    if (strncmp(_record.version, running_version, FIRMWARE_VERSION_MAX) != 0) {
+        _record.state = FIRMWARE_BOOT_ROLLED_BACK;
+        _backend.saveBootRecord(_record);
+        return FIRMWARE_BOOT_NORMAL;
+    }
+
+    _record.attempts++;
+    if (_record.attempts > _max_attempts) {
+        return rollBack();
+    }
+    _backend.saveBootRecord(_record);
+    _trial = true;
+    _boot_ms = now_ms;
+    return FIRMWARE_BOOT_TRIAL;
+}
+
+FirmwareBootAction_t FirmwareBootGuard::loop(uint32_t now_ms, bool healthy) {
+    if (!_trial) {
+        return FIRMWARE_BOOT_NORMAL;
+    }
+
+    uint32_t uptime = now_ms - _boot_ms;
+    if (healthy && uptime >= FIRMWARE_HEALTH_SETTLE_MS) {
+        _trial = false;
+        _record.state = FIRMWARE_BOOT_CONFIRMED;
+        _record.attempts = 0;
+        _backend.saveBootRecord(_record);
+        _backend.confirmSlot();
+        return FIRMWARE_BOOT_HEALTHY;
+    }
+    if (uptime >= _health_window_ms) {
+        return rollBack();
+    }
+    return FIRMWARE_BOOT_TRIAL;
+}
+
+bool firmwareSensorCycleOk(float distance_cm, uint16_t gas_millivolts, uint16_t gas_supply_mv) {
+    return distance_cm >= 0.0f && gas_millivolts > FIRMWARE_HEALTH_RAIL_MV &&
+           gas_millivolts + FIRMWARE_HEALTH_RAIL_MV < gas_supply_mv;
+}
+
+bool firmwareHealthy(bool initialized, bool uplink_connected, uint32_t last_sensor_ok_ms,
+                     uint32_t max_sensor_age_ms, uint32_t now_ms) {
+    bool sensors_ok = last_sensor_ok_ms != 0 && now_ms - last_sensor_ok_ms <= max_sensor_age_ms;
+    return initialized && sensors_ok && uplink_connected;
+}
+
+const char* firmwareUpdateStatusName(FirmwareUpdateStatus_t status) {
+    switch (status) {
+        case FIRMWARE_UPDATE_IDLE:              return "idle";
+        case FIRMWARE_UPDATE_RECEIVING:         return "receiving";
+        case FIRMWARE_UPDATE_READY:             return "ready";
+        case FIRMWARE_UPDATE_BAD_MANIFEST:      return "bad manifest";
+        case FIRMWARE_UPDATE_NO_SIGNING_KEY:    return "no signing key";
+        case FIRMWARE_UPDATE_BAD_SIGNATURE:     return "bad signature";
+        case FIRMWARE_UPDATE_DOWNGRADE:         return "security version not newer";
+        case FIRMWARE_UPDATE_WRONG_BASE:        return "wrong base image";
+        case FIRMWARE_UPDATE_PATCH_ERROR:       return "patch error";
+        case FIRMWARE_UPDATE_FLASH_ERROR:       return "flash error";
+        case FIRMWARE_UPDATE_DIGEST_MISMATCH:   return "digest mismatch";
+    }
+    return "unknown";
+}
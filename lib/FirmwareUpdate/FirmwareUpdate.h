@@ -0,0 +1,250 @@
+/**
+ * ============================================================================
+ * BINSAI Firmware Update
+ * Signed manifests, streamed A/B slot updates and health-checked rollback
+ * ============================================================================
+ *
+ * UPDATE FILE:
+ * [FirmwareManifest_t][DeltaPatch payload]
+ *
+ * FLOW:
+ * - begin(): refused outright while the compiled-in key is the all-zero
+ *   placeholder; then manifest magic/format, Ed25519 signature against
+ *   that key, a security_version above the running image's (an old signed
+ *   release replayed over plain HTTP cannot downgrade a unit), then (delta
+ *   only) SHA-512 of the running image must equal source_digest before a
+ *   byte of flash is erased
+ * - write(): payload chunks from any transport (WiFi HTTP today, SIM800L
+ *   AT+HTTPREAD later) go through DeltaPatchApplier into the inactive slot
+ *   while the SHA-512 of the output is accumulated
+ * - At payload_size bytes the new image digest must equal target_digest;
+ *   activate() then marks the boot record PENDING and switches slots
+ *
+ * ROLLBACK (FirmwareBootGuard, first thing in setup()):
+ * - PENDING and running the pending version: every boot counts an attempt;
+ *   more than FIRMWARE_MAX_BOOT_ATTEMPTS (crash / watchdog loops) switches
+ *   back
+ * - The trial image must report healthy within FIRMWARE_HEALTH_WINDOW_MS,
+ *   otherwise the guard switches back to the previous slot
+ * - Healthy once: CONFIRMED, and the backend cancels any bootloader rollback
+ * ============================================================================
+ */
+
+#ifndef BINSAI_FIRMWARE_UPDATE_H
+#define BINSAI_FIRMWARE_UPDATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "DeltaPatch.h"
+#include "Ed25519.h"
+#include "Sha512.h"
+
+#define FIRMWARE_MANIFEST_MAGIC     0x41544F42UL  // "BOTA" little-endian
+#define FIRMWARE_MANIFEST_FORMAT    2             // 2: security_version
+#define FIRMWARE_VERSION_MAX        16
+#define FIRMWARE_FLAG_DELTA         0x0001        // Payload needs the running image
+
+#define FIRMWARE_BOOT_MAGIC         0x54424E42UL  // "BNBT" little-endian
+#define FIRMWARE_MAX_BOOT_ATTEMPTS  3
+#define FIRMWARE_HEALTH_SETTLE_MS   30000UL       // Minimum uptime before confirming
+#define FIRMWARE_HEALTH_WINDOW_MS   300000UL      // Trial deadline
+#define FIRMWARE_HEALTH_RAIL_MV     50            // Gas output this close to a rail: open or shorted
+
+/**
+ * Signed update descriptor, sent in front of the payload
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;                 // FIRMWARE_MANIFEST_MAGIC
+    uint16_t format;                // FIRMWARE_MANIFEST_FORMAT
+    uint16_t flags;                 // FIRMWARE_FLAG_*
+    char version[FIRMWARE_VERSION_MAX];         // Target version, NUL-padded
+    uint32_t security_version;      // Anti-rollback counter, above the running image's
+    uint32_t source_size;           // Base image bytes (delta only)
+    uint8_t source_digest[SHA512_DIGEST_SIZE];  // SHA-512 of the base image
+    uint32_t target_size;           // New image bytes
+    uint8_t target_digest[SHA512_DIGEST_SIZE];  // SHA-512 of the new image
+    uint32_t payload_size;          // Patch bytes after the manifest
+    uint8_t signature[ED25519_SIGNATURE_SIZE];  // Over every field above
+} FirmwareManifest_t;
+
+#define FIRMWARE_SIGNED_SIZE        (sizeof(FirmwareManifest_t) - ED25519_SIGNATURE_SIZE)
+
+typedef enum {
+    FIRMWARE_BOOT_CONFIRMED = 0,    // Running image is trusted
+    FIRMWARE_BOOT_PENDING,          // New image on trial
+    FIRMWARE_BOOT_ROLLED_BACK       // Trial failed, previous image restored
+} FirmwareBootState_t;
+
+/**
+ * Persisted across reboots (NVS in firmware)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;                 // FIRMWARE_BOOT_MAGIC
+    uint8_t state;                  // FirmwareBootState_t
+    uint8_t attempts;               // Boots of the pending image so far
+    uint16_t reserved;
+    char version[FIRMWARE_VERSION_MAX];         // Pending / rejected version
+} FirmwareBootRecord_t;
+
+/**
+ * A/B app slots and the boot record (esp_ota_* + NVS in firmware, RAM in tests)
+ */
+class FirmwareUpdateBackend : public PatchSource, public PatchSink {
+public:
+    /**
+     * Erase / open the inactive slot for an image of this size
+     */
+    virtual bool beginUpdate(uint32_t image_size) = 0;
+
+    /**
+     * Close the inactive slot after the last writeTarget()
+     */
+    virtual bool finishUpdate() = 0;
+
+    virtual void abortUpdate() = 0;
+
+    /**
+     * Boot the other slot on the next restart
+     */
+    virtual bool switchSlot() = 0;
+
+    /**
+     * The running image is good (cancel any bootloader-level rollback)
+     */
+    virtual void confirmSlot() = 0;
+
+    virtual bool loadBootRecord(FirmwareBootRecord_t* record) = 0;
+    virtual bool saveBootRecord(const FirmwareBootRecord_t& record) = 0;
+};
+
+typedef enum {
+    FIRMWARE_UPDATE_IDLE = 0,
+    FIRMWARE_UPDATE_RECEIVING,      // Payload streaming
+    FIRMWARE_UPDATE_READY,          // Verified, activate() to boot it
+    FIRMWARE_UPDATE_BAD_MANIFEST,   // Magic, format or sizes
+    FIRMWARE_UPDATE_NO_SIGNING_KEY, // Placeholder key compiled in, updates disabled
+    FIRMWARE_UPDATE_BAD_SIGNATURE,
+    FIRMWARE_UPDATE_DOWNGRADE,      // security_version not above the running one
+    FIRMWARE_UPDATE_WRONG_BASE,     // Delta built against another image
+    FIRMWARE_UPDATE_PATCH_ERROR,    // Payload corrupt or too long / short
+    FIRMWARE_UPDATE_FLASH_ERROR,
+    FIRMWARE_UPDATE_DIGEST_MISMATCH
+} FirmwareUpdateStatus_t;
+
+class FirmwareUpdater : private PatchSink {
+public:
+    /**
+     * @param security_version Anti-rollback counter of the running image
+     */
+    FirmwareUpdater(FirmwareUpdateBackend& backend, const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE],
+                    uint32_t security_version);
+
+    /**
+     * Verify a manifest and open the inactive slot
+     * @return Receiving on success, otherwise the rejection reason
+     */
+    FirmwareUpdateStatus_t begin(const FirmwareManifest_t& manifest);
+
+    /**
+     * Feed payload bytes
+     * @return Receiving, Ready after the last byte, or an error (sticky)
+     */
+    FirmwareUpdateStatus_t write(const uint8_t* data, size_t length);
+
+    /**
+     * Mark the verified image pending and boot it on the next restart
+     */
+    bool activate();
+
+    void abort();
+
+    /**
+     * False while the compiled-in key is the all-zero placeholder
+     */
+    bool hasSigningKey() const;
+
+    FirmwareUpdateStatus_t status() const { return _status; }
+    const FirmwareManifest_t& manifest() const { return _manifest; }
+    uint32_t payloadReceived() const { return _payload_received; }
+    uint32_t imageWritten() const { return _patch.targetWritten(); }
+
+private:
+    bool writeTarget(const void* data, size_t length) override;
+    FirmwareUpdateStatus_t fail(FirmwareUpdateStatus_t status);
+
+    FirmwareUpdateBackend& _backend;
+    const uint8_t* _public_key;
+    uint32_t _security_version;
+    DeltaPatchApplier _patch;
+    Sha512 _image_hash;
+    FirmwareManifest_t _manifest;
+    FirmwareUpdateStatus_t _status;
+    uint32_t _payload_received;
+};
+
+typedef enum {
+    FIRMWARE_BOOT_NORMAL = 0,       // Nothing to do
+    FIRMWARE_BOOT_TRIAL,            // Pending image running, health window open
+    FIRMWARE_BOOT_HEALTHY,          // Trial image just confirmed
+    FIRMWARE_BOOT_ROLLBACK          // Slot switched back: restart now
+} FirmwareBootAction_t;
+
+class FirmwareBootGuard {
+public:
+    explicit FirmwareBootGuard(FirmwareUpdateBackend& backend,
+                               uint32_t health_window_ms = FIRMWARE_HEALTH_WINDOW_MS,
+                               uint8_t max_attempts = FIRMWARE_MAX_BOOT_ATTEMPTS);
+
+    /**
+     * Count this boot against a pending image
+     * @param running_version Version of this build; a mismatch with the
+     *        pending version means the slot switch never took effect
+     * @return Trial, Rollback (too many attempts) or Normal
+     */
+    FirmwareBootAction_t onBoot(uint32_t now_ms, const char* running_version);
+
+    /**
+     * Periodic health check while on trial
+     * @param healthy Caller's verdict for this cycle (sensors + uplink)
+     */
+    FirmwareBootAction_t loop(uint32_t now_ms, bool healthy);
+
+    bool onTrial() const { return _trial; }
+    const FirmwareBootRecord_t& record() const { return _record; }
+
+private:
+    FirmwareBootAction_t rollBack();
+
+    FirmwareUpdateBackend& _backend;
+    uint32_t _health_window_ms;
+    uint8_t _max_attempts;
+    FirmwareBootRecord_t _record;
+    bool _trial;
+    uint32_t _boot_ms;
+};
+
+/**
+ * Sensor part of the trial health check: the ultrasonic array fused a
+ * distance (blind zone reads 0, failure -1) and the MQ-135 output is off
+ * both rails. The ppm value is clamped and cannot show a dead pipeline
+ */
+bool firmwareSensorCycleOk(float distance_cm, uint16_t gas_millivolts, uint16_t gas_supply_mv);
+
+/**
+ * Verdict for FirmwareBootGuard::loop()
+ * @param last_sensor_ok_ms Last cycle firmwareSensorCycleOk() passed, 0 = none
+ * @param max_sensor_age_ms How stale that cycle may be
+ */
+bool firmwareHealthy(bool initialized, bool uplink_connected, uint32_t last_sensor_ok_ms,
+                     uint32_t max_sensor_age_ms, uint32_t now_ms);
+
+/**
+ * Sign a manifest in place (build host)
+ */
+void firmwareManifestSign(FirmwareManifest_t* manifest, const uint8_t seed[ED25519_SEED_SIZE]);
+
+bool firmwareManifestVerify(const FirmwareManifest_t& manifest, const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE]);
+
+const char* firmwareUpdateStatusName(FirmwareUpdateStatus_t status);
+
+#endif  // BINSAI_FIRMWARE_UPDATE_H
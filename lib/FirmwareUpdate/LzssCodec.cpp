@@ -0,0 +1,179 @@
+/**
+ * BINSAI LZSS Codec - hash-chain encoder, incremental decoder
+ */
+
+#include "LzssCodec.h"
+#include <string.h>
+
+#define LZSS_TOKEN_BITS             (1 + LZSS_WINDOW_BITS + LZSS_LENGTH_BITS)
+#define LZSS_HASH_BITS              15
+#define LZSS_CHAIN_LIMIT            256         // Candidates tried per position
+#define LZSS_GOOD_MATCH             258         // Stop searching once this long
+#define LZSS_NO_POSITION            0xFFFFFFFFUL
+
+namespace {
+
+class TokenWriter {
+public:
+    explicit TokenWriter(std::vector<uint8_t>* out) : _out(out), _bits(0), _count(0) {}
+
+    void put(uint32_t value, uint8_t width) {
+        _bits = (_bits << width) | value;
+        _count += width;
+        while (_count >= 8) {
+            _count -= 8;
+            _out->push_back((uint8_t)(_bits >> _count));
+        }
+    }
+
+    void flush() {
+        if (_count) {
+            _out->push_back((uint8_t)(_bits << (8 - _count)));
+            _count = 0;
+        }
+    }
+
+private:
+    std::vector<uint8_t>* _out;
+    uint32_t _bits;
+    uint8_t _count;
+};
+
+inline uint32_t hash3(const uint8_t* p) {
+    return (uint32_t)((uint32_t)(p[0] << 16 | p[1] << 8 | p[2]) * 2654435761U) >> (32 - LZSS_HASH_BITS);
+}
+
+}  // namespace
+
+void lzssCompress(const uint8_t* data, size_t length, std::vector<uint8_t>* out) {
+    std::vector<uint32_t> head(1U << LZSS_HASH_BITS, LZSS_NO_POSITION);
+    std::vector<uint32_t> chain(LZSS_WINDOW_SIZE, LZSS_NO_POSITION);
+    TokenWriter writer(out);
+
+    size_t pos = 0;
+    while (pos < length) {
+        size_t best_length = 0;
+        size_t best_distance = 0;
+
+        if (pos + LZSS_MIN_MATCH <= length) {
+            size_t limit = length - pos < LZSS_MAX_MATCH ? length - pos : LZSS_MAX_MATCH;
+            uint32_t candidate = head[hash3(data + pos)];
+            for (int tries = 0; candidate != LZSS_NO_POSITION && tries < LZSS_CHAIN_LIMIT; tries++) {
+                size_t distance = pos - candidate;
+                if (distance > LZSS_WINDOW_SIZE) {
+                    break;
+                }
+                size_t match = 0;
+                while (match < limit && data[candidate + match] == data[pos + match]) {
+                    match++;
+                }
+                if (match > best_length) {
+                    best_length = match;
+                    best_distance = distance;
+                    if (match == limit || match >= LZSS_GOOD_MATCH) break;
+                }
+                uint32_t next = chain[candidate & (LZSS_WINDOW_SIZE - 1)];
+                if (next == LZSS_NO_POSITION || next >= candidate) break;
+                candidate = next;
+            }
+        }
+
+        size_t advance;
+        if (best_length >= LZSS_MIN_MATCH) {
+            writer.put(0, 1);
+            writer.put((uint32_t)(best_distance - 1), LZSS_WINDOW_BITS);
+            size_t field = best_length - LZSS_MIN_MATCH;
+            if (field < LZSS_LENGTH_ESCAPE) {
+                writer.put((uint32_t)field, LZSS_LENGTH_BITS);
+            } else {
+                writer.put(LZSS_LENGTH_ESCAPE, LZSS_LENGTH_BITS);
+                writer.put((uint32_t)(field - LZSS_LENGTH_ESCAPE), LZSS_EXTENSION_BITS);
+            }
+            advance = best_length;
+        } else {
+            writer.put(0x100 | data[pos], 9);
+            advance = 1;
+        }
+
+        for (size_t end = pos + advance; pos < end; pos++) {
+            if (pos + LZSS_MIN_MATCH <= length) {
+                uint32_t h = hash3(data + pos);
+                chain[pos & (LZSS_WINDOW_SIZE - 1)] = head[h];
+                head[h] = (uint32_t)pos;
+            }
+        }
+    }
+    writer.flush();
+}
+
+void LzssDecoder::reset() {
+    _bits = 0;
+    _bit_count = 0;
+    _match_distance = 0;
+    _match_remaining = 0;
+    _extending = false;
+    _produced = 0;
+    _corrupt = false;
+}
+
+size_t LzssDecoder::decode(const uint8_t* in, size_t length, size_t* consumed, uint8_t* out, size_t capacity) {
+    size_t taken = 0;
+    size_t written = 0;
+
+    while (written < capacity && !_corrupt) {
+        if (_match_remaining) {
+            uint8_t byte = _window[(_produced - _match_distance) & (LZSS_WINDOW_SIZE - 1)];
+            _window[_produced & (LZSS_WINDOW_SIZE - 1)] = byte;
+            _produced++;
+            out[written++] = byte;
+            _match_remaining--;
+            continue;
+        }
+
+        while (_bit_count < LZSS_TOKEN_BITS && taken < length) {
+            _bits = (_bits << 8) | in[taken++];
+            _bit_count += 8;
+        }
+        if (_bit_count == 0) {
+            break;
+        }
+
+        if (_extending) {
+            if (_bit_count < LZSS_EXTENSION_BITS) break;
+            _bit_count -= LZSS_EXTENSION_BITS;
+            _match_remaining = LZSS_MIN_MATCH + LZSS_LENGTH_ESCAPE +
+                               ((_bits >> _bit_count) & ((1UL << LZSS_EXTENSION_BITS) - 1));
+            _extending = false;
+            _bits &= (1UL << _bit_count) - 1;
+            continue;
+        }
+
+        bool literal = (_bits >> (_bit_count - 1)) & 1;
+        if (literal) {
+            if (_bit_count < 9) break;
+            _bit_count -= 9;
+            uint8_t byte = (uint8_t)(_bits >> _bit_count);
+            _window[_produced & (LZSS_WINDOW_SIZE - 1)] = byte;
+            _produced++;
+            out[written++] = byte;
+        } else {
+            if (_bit_count < LZSS_TOKEN_BITS) break;
+            _bit_count -= LZSS_TOKEN_BITS;
+            uint32_t token = (_bits >> _bit_count) & ((1UL << (LZSS_TOKEN_BITS - 1)) - 1);
+            uint32_t field = token & ((1U << LZSS_LENGTH_BITS) - 1);
+            _match_distance = (uint16_t)((token >> LZSS_LENGTH_BITS) + 1);
+            if (field == LZSS_LENGTH_ESCAPE) {
+                _extending = true;
+            } else {
+                _match_remaining = field + LZSS_MIN_MATCH;
+            }
+            if (_match_distance > _produced) {
+                _corrupt = true;
+            }
+        }
+        _bits &= (1UL << _bit_count) - 1;
+    }
+
+    *consumed = taken;
+    return written;
+}
@@ -0,0 +1,74 @@
+/**
+ * ============================================================================
+ * BINSAI LZSS Codec
+ * heatshrink-style bit-packed LZSS with a fixed 4 KB window
+ * ============================================================================
+ *
+ * STREAM (MSB-first bits, last byte zero-padded):
+ *   '1' + 8 bits                      literal byte
+ *   '0' + 12 bits + 8 bits            back-reference: distance - 1,
+ *                                     length - LZSS_MIN_MATCH
+ *   ... length field 255 + 16 bits    long back-reference: length -
+ *                                     LZSS_MIN_MATCH - 255 follows
+ *
+ * The decoder is incremental: compressed bytes arrive in arbitrary chunks
+ * (HTTP body, SIM800L AT+HTTPREAD blocks) and decoded bytes are pulled into
+ * a caller buffer, so device RAM is the 4 KB window plus a few words.
+ * Long matches (up to 64 KB, 37 bits) keep the zero runs of a delta body
+ * nearly free, which is most of what bzip2 buys bsdiff.
+ * The encoder is a greedy hash-chain match finder for the build host.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_LZSS_CODEC_H
+#define BINSAI_LZSS_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#define LZSS_WINDOW_BITS            12
+#define LZSS_LENGTH_BITS            8
+#define LZSS_WINDOW_SIZE            (1U << LZSS_WINDOW_BITS)
+#define LZSS_MIN_MATCH              3           // 21-bit token vs 27 bits of literals
+#define LZSS_LENGTH_ESCAPE          ((1U << LZSS_LENGTH_BITS) - 1)
+#define LZSS_EXTENSION_BITS         16
+#define LZSS_MAX_MATCH              (LZSS_MIN_MATCH + LZSS_LENGTH_ESCAPE + (1UL << LZSS_EXTENSION_BITS) - 1)
+
+/**
+ * Compress a buffer (appends to out)
+ */
+void lzssCompress(const uint8_t* data, size_t length, std::vector<uint8_t>* out);
+
+class LzssDecoder {
+public:
+    LzssDecoder() { reset(); }
+
+    void reset();
+
+    /**
+     * Decode from a compressed chunk into out
+     * @param consumed Set to the number of input bytes taken
+     * @return Bytes written to out; call again while either side has room
+     */
+    size_t decode(const uint8_t* in, size_t length, size_t* consumed, uint8_t* out, size_t capacity);
+
+    /**
+     * A back-reference pointed before the start of the stream
+     */
+    bool corrupt() const { return _corrupt; }
+
+    uint32_t produced() const { return _produced; }
+
+private:
+    uint8_t _window[LZSS_WINDOW_SIZE];
+    uint32_t _bits;                 // Bit accumulator, right-aligned
+    uint8_t _bit_count;
+    uint16_t _match_distance;
+    uint32_t _match_remaining;
+    bool _extending;                // Escape seen, 16-bit length pending
+    uint32_t _produced;
+    bool _corrupt;
+};
+
+#endif  // BINSAI_LZSS_CODEC_H
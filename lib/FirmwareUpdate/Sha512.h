@@ -0,0 +1,40 @@
+/**
+ * ============================================================================
+ * BINSAI SHA-512
+ * Streaming FIPS 180-4 SHA-512 for image digests and Ed25519
+ * ============================================================================
+ */
+
+#ifndef BINSAI_SHA512_H
+#define BINSAI_SHA512_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SHA512_DIGEST_SIZE          64
+#define SHA512_BLOCK_SIZE           128
+
+class Sha512 {
+public:
+    Sha512() { reset(); }
+
+    void reset();
+    void update(const void* data, size_t length);
+
+    /**
+     * Write the digest and reset for the next message
+     */
+    void finish(uint8_t digest[SHA512_DIGEST_SIZE]);
+
+    static void hash(const void* data, size_t length, uint8_t digest[SHA512_DIGEST_SIZE]);
+
+private:
+    void compress(const uint8_t* block);
+
+    uint64_t _state[8];
+    uint64_t _length;               // Bytes hashed so far
+    uint8_t _buffer[SHA512_BLOCK_SIZE];
+    size_t _buffered;
+};
+
+#endif  // BINSAI_SHA512_H
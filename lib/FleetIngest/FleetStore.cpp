@@ -0,0 +1,258 @@
+/**
+ * BINSAI Fleet Store - sharded index and per-bin history ring
+ */
+
+#include "FleetStore.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FLEET_INITIAL_SLOTS         64      // Power of two
+#define FLEET_MAX_LOAD_PERCENT      70
+
+FleetStore::FleetStore(size_t shard_count)
+    : _shard_count(shard_count ? shard_count : 1),
+      _shards(new Shard[shard_count ? shard_count : 1]) {
+    for (size_t i = 0; i < _shard_count; i++) {
+        _shards[i].slots.assign(FLEET_INITIAL_SLOTS, 0);
+    }
+}
+
+uint64_t FleetStore::hashDeviceId(const char* device_id, size_t length) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)device_id[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+int32_t FleetStore::findBin(const Shard& shard, uint64_t hash, const char* id, size_t length) {
+    size_t mask = shard.slots.size() - 1;
+    for (size_t probe = (size_t)hash & mask;; probe = (probe + 1) & mask) {
+        uint32_t slot = shard.slots[probe];
+        if (slot == 0) {
+            return -1;
+        }
+        const BinState_t& bin = shard.bins[slot - 1];
+        if (bin.id_hash == hash && strncmp(bin.device_id, id, length) == 0 &&
+            bin.device_id[length] == '\0') {
+            return (int32_t)(slot - 1);
+        }
+    }
+}
+
+int32_t FleetStore::findBinByHash(const Shard& shard, uint64_t hash) {
+    size_t mask = shard.slots.size() - 1;
+    for (size_t probe = (size_t)hash & mask;; probe = (probe + 1) & mask) {
+        uint32_t slot = shard.slots[probe];
+        if (slot == 0) {
+            return -1;
+        }
+        if (shard.bins[slot - 1].id_hash == hash) {
+            return (int32_t)(slot - 1);
+        }
+    }
+}
+
+void FleetStore::insertSlot(Shard& shard, uint64_t hash, uint32_t bin_index) {
+    size_t mask = shard.slots.size() - 1;
+    size_t probe = (size_t)hash & mask;
+    while (shard.slots[probe] != 0) {
+        probe = (probe + 1) & mask;
+    }
+    shard.slots[probe] = bin_index + 1;
+}
+
+void FleetStore::growSlots(Shard& shard) {
+    shard.slots.assign(shard.slots.size() * 2, 0);
+    for (uint32_t i = 0; i < shard.bins.size(); i++) {
+        insertSlot(shard, shard.bins[i].id_hash, i);
+    }
+}
+
+FleetIngestResult_t FleetStore::ingest(const TelemetryFrameView& frame, uint32_t received_ms) {
+    if (!frame.validate()) {
+        return FLEET_INGEST_INVALID;
+    }
+
+    const char* id = frame.deviceId();
+    size_t length = frame.deviceIdLength();
+    uint64_t hash = hashDeviceId(id, length);
+    Shard& shard = shardFor(hash);
+
+    BinSample_t sample;
+    sample.timestamp_unix = frame.timestampUnix();
+    sample.received_ms = received_ms;
+    sample.fill_centi = frame.fillCentiPercent();
+    sample.ppm_deci = frame.ppmDeci();
+    sample.capacity_level = frame.capacityLevel();
+    sample.waste_classification = frame.wasteClassification();
+    sample.priority_level = frame.priorityLevel();
+    sample.flags = frame.flags();
+    uint32_t sequence = frame.sequence();
+    uint8_t boot_epoch = frame.bootEpoch();
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    FleetIngestResult_t result = FLEET_INGEST_OK;
+    int32_t index = findBin(shard, hash, id, length);
+    BinState_t* bin;
+
+    if (index < 0) {
+        if ((shard.bins.size() + 1) * 100 > shard.slots.size() * FLEET_MAX_LOAD_PERCENT) {
+            growSlots(shard);
+        }
+        shard.bins.emplace_back();
+        bin = &shard.bins.back();
+        memset(bin, 0, sizeof(*bin));
+        memcpy(bin->device_id, id, length);
+        bin->id_hash = hash;
+        insertSlot(shard, hash, (uint32_t)(shard.bins.size() - 1));
+        result = FLEET_INGEST_NEW_BIN;
+    } else {
+        bin = &shard.bins[index];
+        // The sequence restarts with the device; a newer boot epoch starts
+        // a new run, frames from an older one arrived late (both wrap-safe)
+        int8_t epoch_delta = (int8_t)(boot_epoch - bin->boot_epoch);
+        bool stale_epoch = boot_epoch != 0 && bin->boot_epoch != 0 && epoch_delta < 0;
+        if (boot_epoch != 0 && epoch_delta != 0 && !stale_epoch) {
+            bin->restarts++;
+        } else {
+            // Anything not strictly newer is a duplicate or reordered
+            int32_t delta = (int32_t)(sequence - bin->last_sequence);
+            if (stale_epoch || delta <= 0) {
+                bin->frames_duplicate++;
+                return FLEET_INGEST_DUPLICATE;
+            }
+            bin->frames_lost += (uint32_t)(delta - 1);
+        }
+    }
+
+    bin->last_sequence = sequence;
+    bin->boot_epoch = boot_epoch;
+    bin->frames_accepted++;
+    bool spatial_changed = !bin->indexed ||
+                           abs(bin->indexed_latitude_e7 - frame.latitudeE7()) > FLEET_SPATIAL_MOVE_E7 ||
+                           abs(bin->indexed_longitude_e7 - frame.longitudeE7()) > FLEET_SPATIAL_MOVE_E7 ||
+                           bin->deployment_zone != frame.deploymentZone() ||
+                           bin->latest.priority_level != sample.priority_level;
+    bin->latitude_e7 = frame.latitudeE7();
+    bin->longitude_e7 = frame.longitudeE7();
+    bin->deployment_zone = frame.deploymentZone();
+    bin->hours_to_full_deci = frame.hoursToFullDeci();
+    bin->latest = sample;
+
+    bool has_fix = (sample.flags & TELEMETRY_FLAG_GPS_FIX) != 0;
+    if ((spatial_changed && has_fix) || bin->indexed != has_fix) {
+        updateSpatial(bin, has_fix);
+    }
+
+    bin->history[bin->history_head] = sample;
+    bin->history_head = (uint16_t)((bin->history_head + 1) % FLEET_HISTORY_DEPTH);
+    if (bin->history_count < FLEET_HISTORY_DEPTH) {
+        bin->history_count++;
+    }
+
+    return result;
+}
+
+void FleetStore::updateSpatial(BinState_t* bin, bool has_fix) {
+    std::lock_guard<std::mutex> lock(_spatial_mutex);
+    if (!has_fix) {
+        // Keep the last fixed position out of queries until GPS recovers
+        _spatial.remove(bin->id_hash);
+        bin->indexed = false;
+        return;
+    }
+
+    SpatialPoint_t point;
+    point.id = bin->id_hash;
+    point.latitude = bin->latitude_e7 / 1e7;
+    point.longitude = bin->longitude_e7 / 1e7;
+    point.zone = bin->deployment_zone;
+    point.priority = bin->latest.priority_level;
+    _spatial.upsert(point);
+    bin->indexed = true;
+    bin->indexed_latitude_e7 = bin->latitude_e7;
+    bin->indexed_longitude_e7 = bin->longitude_e7;
+}
+
+bool FleetStore::lookup(const char* device_id, BinState_t* state) const {
+    size_t length = strnlen(device_id, TELEMETRY_DEVICE_ID_LEN);
+    uint64_t hash = hashDeviceId(device_id, length);
+    const Shard& shard = shardFor(hash);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    int32_t index = findBin(shard, hash, device_id, length);
+    if (index < 0) {
+        return false;
+    }
+    *state = shard.bins[index];
+    return true;
+}
+
+bool FleetStore::lookupHash(uint64_t id_hash, BinState_t* state) const {
+    const Shard& shard = shardFor(id_hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    int32_t index = findBinByHash(shard, id_hash);
+    if (index < 0) {
+        return false;
+    }
+    *state = shard.bins[index];
+    return true;
+}
+
+size_t FleetStore::binsWithinRadius(double latitude, double longitude, double radius_m, uint8_t min_priority,
+                                    std::vector<SpatialHit_t>* hits) const {
+    std::lock_guard<std::mutex> lock(_spatial_mutex);
+    return _spatial.withinRadius(latitude, longitude, radius_m, min_priority, hits);
+}
+
+size_t FleetStore::nearestBins(double latitude, double longitude, size_t k, uint8_t min_priority,
+                               std::vector<SpatialHit_t>* hits) const {
+    std::lock_guard<std::mutex> lock(_spatial_mutex);
+    return _spatial.nearest(latitude, longitude, k, min_priority, hits);
+}
+
+size_t FleetStore::binsInZone(uint8_t zone, std::vector<uint64_t>* id_hashes) const {
+    std::lock_guard<std::mutex> lock(_spatial_mutex);
+    return _spatial.inZone(zone, id_hashes);
+}
+
+size_t FleetStore::history(const char* device_id, BinSample_t* samples, size_t max_samples) const {
+    size_t length = strnlen(device_id, TELEMETRY_DEVICE_ID_LEN);
+    uint64_t hash = hashDeviceId(device_id, length);
+    const Shard& shard = shardFor(hash);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    int32_t index = findBin(shard, hash, device_id, length);
+    if (index < 0) {
+        return 0;
+    }
+
+    const BinState_t& bin = shard.bins[index];
+    size_t count = bin.history_count < max_samples ? bin.history_count : max_samples;
+    size_t start = (bin.history_head + FLEET_HISTORY_DEPTH - count) % FLEET_HISTORY_DEPTH;
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = bin.history[(start + i) % FLEET_HISTORY_DEPTH];
+    }
+    return count;
+}
+
+void FleetStore::forEach(const std::function<void(const BinState_t&)>& visitor) const {
+    for (size_t s = 0; s < _shard_count; s++) {
+        std::lock_guard<std::mutex> lock(_shards[s].mutex);
+        for (size_t i = 0; i < _shards[s].bins.size(); i++) {
+            visitor(_shards[s].bins[i]);
+        }
+    }
+}
+
+size_t FleetStore::binCount() const {
+    size_t total = 0;
+    for (size_t s = 0; s < _shard_count; s++) {
+        std::lock_guard<std::mutex> lock(_shards[s].mutex);
+        total += _shards[s].bins.size();
+    }
+    return total;
+}
@@ -0,0 +1,163 @@
+/**
+ * ============================================================================
+ * BINSAI Fleet Store
+ * Sharded per-bin latest-state table with bounded history
+ * ============================================================================
+ *
+ * Bins are sharded by an FNV-1a hash of device_id; each shard has its own
+ * mutex, an open-addressed index and a dense BinState_t array, so ingest
+ * threads only contend when two frames land in the same shard. Ingest does
+ * not allocate once a bin has been seen.
+ *
+ * History is a fixed ring of compact samples per bin (FLEET_HISTORY_DEPTH).
+ * Sequence numbers detect duplicates/reordering (dropped) and gaps (lost).
+ * They start again at 1 after a device reset, so a frame with a newer boot
+ * epoch is accepted as a restart whatever its sequence; frames without an
+ * epoch (0) are judged by sequence alone.
+ *
+ * Bins with a GPS fix are mirrored into a SpatialIndex keyed by id_hash
+ * for radius / nearest / zone queries. It is only touched when position,
+ * zone or priority changes, so its single lock stays off the hot path
+ * (lock order: shard, then spatial).
+ * ============================================================================
+ */
+
+#ifndef BINSAI_FLEET_STORE_H
+#define BINSAI_FLEET_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "SpatialIndex.h"
+#include "TelemetryFrame.h"
+
+#define FLEET_HISTORY_DEPTH         96      // 48 h at 30 min cadence
+#define FLEET_DEFAULT_SHARDS        64
+#define FLEET_SPATIAL_MOVE_E7       200     // ~20 m; smaller GPS jitter is not re-indexed
+
+typedef enum {
+    FLEET_INGEST_OK = 0,
+    FLEET_INGEST_NEW_BIN,       // Accepted, first frame from this device
+    FLEET_INGEST_DUPLICATE,     // Sequence not newer than last accepted, or older boot epoch
+    FLEET_INGEST_INVALID        // Failed frame validation
+} FleetIngestResult_t;
+
+/**
+ * Compact history sample (16 bytes)
+ */
+typedef struct {
+    uint32_t timestamp_unix;
+    uint32_t received_ms;           // Server clock at ingest
+    uint16_t fill_centi;            // 0.01 %
+    uint16_t ppm_deci;              // 0.1 ppm
+    uint8_t capacity_level;
+    uint8_t waste_classification;
+    uint8_t priority_level;
+    uint8_t flags;
+} BinSample_t;
+
+/**
+ * Per-bin state
+ */
+typedef struct {
+    char device_id[TELEMETRY_DEVICE_ID_LEN + 1];
+    uint64_t id_hash;
+    BinSample_t latest;
+    int32_t latitude_e7;
+    int32_t longitude_e7;
+    int16_t hours_to_full_deci;
+    uint8_t deployment_zone;
+    bool indexed;                   // Present in the spatial index
+    int32_t indexed_latitude_e7;    // Position last written to the index
+    int32_t indexed_longitude_e7;
+    uint32_t last_sequence;
+    uint32_t frames_accepted;
+    uint32_t frames_duplicate;
+    uint32_t frames_lost;           // Sum of sequence gaps
+    uint32_t restarts;              // Boot epoch changes seen
+    uint8_t boot_epoch;             // Of the last accepted frame
+    BinSample_t history[FLEET_HISTORY_DEPTH];
+    uint16_t history_head;          // Next write position
+    uint16_t history_count;
+} BinState_t;
+
+class FleetStore {
+public:
+    explicit FleetStore(size_t shard_count = FLEET_DEFAULT_SHARDS);
+
+    /**
+     * Validate and apply one frame
+     * @param frame Received frame view (validated here)
+     * @param received_ms Server clock for the history sample
+     */
+    FleetIngestResult_t ingest(const TelemetryFrameView& frame, uint32_t received_ms);
+
+    /**
+     * Copy a bin's state out under its shard lock
+     * @return false if the device is unknown
+     */
+    bool lookup(const char* device_id, BinState_t* state) const;
+
+    /**
+     * Same as lookup(), by BinState_t::id_hash (spatial query results)
+     */
+    bool lookupHash(uint64_t id_hash, BinState_t* state) const;
+
+    /**
+     * Copy up to max_samples history entries, oldest first
+     * @return Number of samples written
+     */
+    size_t history(const char* device_id, BinSample_t* samples, size_t max_samples) const;
+
+    /**
+     * Visit every bin (one shard locked at a time)
+     */
+    void forEach(const std::function<void(const BinState_t&)>& visitor) const;
+
+    /**
+     * Bins within radius_m whose priority_level >= min_priority, nearest first
+     * Hit ids are BinState_t::id_hash.
+     */
+    size_t binsWithinRadius(double latitude, double longitude, double radius_m, uint8_t min_priority,
+                            std::vector<SpatialHit_t>* hits) const;
+
+    /**
+     * k nearest bins whose priority_level >= min_priority
+     */
+    size_t nearestBins(double latitude, double longitude, size_t k, uint8_t min_priority,
+                       std::vector<SpatialHit_t>* hits) const;
+
+    /**
+     * id_hash of every located bin in a deployment zone
+     */
+    size_t binsInZone(uint8_t zone, std::vector<uint64_t>* id_hashes) const;
+
+    size_t binCount() const;
+    size_t shardCount() const { return _shard_count; }
+
+    static uint64_t hashDeviceId(const char* device_id, size_t length);
+
+private:
+    struct Shard {
+        mutable std::mutex mutex;
+        std::vector<uint32_t> slots;    // Open-addressed: bin index + 1, 0 = empty
+        std::vector<BinState_t> bins;
+    };
+
+    Shard& shardFor(uint64_t hash) const { return _shards[(hash >> 32) % _shard_count]; }
+    static int32_t findBin(const Shard& shard, uint64_t hash, const char* id, size_t length);
+    static int32_t findBinByHash(const Shard& shard, uint64_t hash);
+    void updateSpatial(BinState_t* bin, bool has_fix);
+    static void insertSlot(Shard& shard, uint64_t hash, uint32_t bin_index);
+    static void growSlots(Shard& shard);
+
+    size_t _shard_count;
+    std::unique_ptr<Shard[]> _shards;
+    SpatialIndex _spatial;
+    mutable std::mutex _spatial_mutex;
+};
+
+#endif  // BINSAI_FLEET_STORE_H
@@ -0,0 +1,220 @@
+/**
+ * BINSAI Fleet Ingest Server - SO_REUSEPORT workers with recvmmsg batching
+ */
+
+#include "IngestServer.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#define FLEET_RECV_BUFFER_BYTES     (8 * 1024 * 1024)
+#define FLEET_POLL_TIMEOUT_MS       100
+#define FLEET_DATAGRAM_FRAMES       8       // GPRS batches (GPRS_BATCH_MAX)
+#define FLEET_DATAGRAM_MAX          (FLEET_DATAGRAM_FRAMES * TELEMETRY_FRAME_SIZE)
+
+uint32_t fleetMonotonicMicros() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+}
+
+void fleetDatagramFrames(size_t length, size_t* frames, size_t* frame_length) {
+    if (length > TELEMETRY_FRAME_SIZE && length % TELEMETRY_FRAME_SIZE == 0) {
+        *frames = length / TELEMETRY_FRAME_SIZE;
+        *frame_length = TELEMETRY_FRAME_SIZE;
+    } else {
+        *frames = 1;
+        *frame_length = length;
+    }
+}
+
+IngestServer::IngestServer(FleetStore& store) : _store(store), _running(false), _port(0) {
+    memset(&_stopped, 0, sizeof(_stopped));
+}
+
+IngestServer::~IngestServer() {
+    stop();
+}
+
+int IngestServer::openSocket(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+    int buffer_bytes = FLEET_RECV_BUFFER_BYTES;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_bytes, sizeof(buffer_bytes));
+    struct timeval timeout = {0, FLEET_POLL_TIMEOUT_MS * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool IngestServer::start(uint16_t port, unsigned worker_count) {
+    if (_running.load()) {
+        return false;
+    }
+    if (worker_count == 0) {
+        worker_count = 1;
+    }
+
+    _port = port;
+    memset(&_stopped, 0, sizeof(_stopped));
+    _stopped_latency.reset();
+    for (unsigned i = 0; i < worker_count; i++) {
+        int fd = openSocket(_port);
+        if (fd < 0) {
+            fprintf(stderr, "[FLEET] bind port %u failed: %s\n", _port, strerror(errno));
+            for (size_t w = 0; w < _workers.size(); w++) close(_workers[w]->fd);
+            _workers.clear();
+            return false;
+        }
+        if (_port == 0) {
+            // Ephemeral port: remaining workers join the one the kernel picked
+            struct sockaddr_in bound;
+            socklen_t length = sizeof(bound);
+            getsockname(fd, (struct sockaddr*)&bound, &length);
+            _port = ntohs(bound.sin_port);
+        }
+
+        std::unique_ptr<Worker> worker(new Worker());
+        worker->fd = fd;
+        worker->datagrams = 0;
+        worker->accepted = 0;
+        worker->new_bins = 0;
+        worker->duplicates = 0;
+        worker->invalid = 0;
+        _workers.push_back(std::move(worker));
+    }
+
+    _running = true;
+    for (size_t i = 0; i < _workers.size(); i++) {
+        Worker* worker = _workers[i].get();
+        worker->thread = std::thread(&IngestServer::run, this, worker);
+    }
+    return true;
+}
+
+void IngestServer::stop() {
+    if (!_running.exchange(false)) {
+        return;
+    }
+    for (size_t i = 0; i < _workers.size(); i++) {
+        _workers[i]->thread.join();
+        close(_workers[i]->fd);
+    }
+
+    // Keep the session's counters; a later start() must not find these workers
+    _stopped = stats();
+    latency(&_stopped_latency);
+    _workers.clear();
+}
+
+void IngestServer::run(Worker* worker) {
+    static_assert(TELEMETRY_FRAME_SIZE <= FLEET_DATAGRAM_MAX, "Datagram buffer too small");
+
+    uint8_t buffers[FLEET_RECV_BATCH][FLEET_DATAGRAM_MAX];
+    struct iovec iov[FLEET_RECV_BATCH];
+    struct mmsghdr messages[FLEET_RECV_BATCH];
+
+    memset(messages, 0, sizeof(messages));
+    for (int i = 0; i < FLEET_RECV_BATCH; i++) {
+        iov[i].iov_base = buffers[i];
+        iov[i].iov_len = FLEET_DATAGRAM_MAX;
+        messages[i].msg_hdr.msg_iov = &iov[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (_running.load(std::memory_order_relaxed)) {
+        int received = recvmmsg(worker->fd, messages, FLEET_RECV_BATCH, MSG_WAITFORONE, NULL);
+        if (received <= 0) {
+            continue;  // Timeout (EAGAIN) or EINTR: re-check _running
+        }
+
+        uint64_t accepted = 0, new_bins = 0, duplicates = 0, invalid = 0;
+        uint32_t traces[FLEET_RECV_BATCH * FLEET_DATAGRAM_FRAMES];
+        int trace_count = 0;
+        uint32_t received_ms = fleetMonotonicMicros() / 1000;
+
+        for (int i = 0; i < received; i++) {
+            size_t frames, frame_length;
+            fleetDatagramFrames(messages[i].msg_len, &frames, &frame_length);
+            for (size_t f = 0; f < frames; f++) {
+                TelemetryFrameView frame(buffers[i] + f * frame_length, frame_length);
+                FleetIngestResult_t result = _store.ingest(frame, received_ms);
+
+                if (result == FLEET_INGEST_OK || result == FLEET_INGEST_NEW_BIN) {
+                    accepted++;
+                    new_bins += (result == FLEET_INGEST_NEW_BIN);
+                    if (frame.traceMicros() != 0) {
+                        traces[trace_count++] = frame.traceMicros();
+                    }
+                } else if (result == FLEET_INGEST_DUPLICATE) {
+                    duplicates++;
+                } else {
+                    invalid++;
+                }
+            }
+        }
+
+        if (trace_count > 0) {
+            uint32_t now_us = fleetMonotonicMicros();
+            std::lock_guard<std::mutex> lock(worker->latency_mutex);
+            for (int i = 0; i < trace_count; i++) {
+                worker->latency.record(now_us - traces[i]);
+            }
+        }
+
+        worker->datagrams.fetch_add((uint64_t)received, std::memory_order_relaxed);
+        worker->accepted.fetch_add(accepted, std::memory_order_relaxed);
+        worker->new_bins.fetch_add(new_bins, std::memory_order_relaxed);
+        worker->duplicates.fetch_add(duplicates, std::memory_order_relaxed);
+        worker->invalid.fetch_add(invalid, std::memory_order_relaxed);
+    }
+}
+
+IngestStats_t IngestServer::stats() const {
+    IngestStats_t total = _stopped;
+    for (size_t i = 0; i < _workers.size(); i++) {
+        total.datagrams += _workers[i]->datagrams.load();
+        total.accepted += _workers[i]->accepted.load();
+        total.new_bins += _workers[i]->new_bins.load();
+        total.duplicates += _workers[i]->duplicates.load();
+        total.invalid += _workers[i]->invalid.load();
+    }
+    return total;
+}
+
+void IngestServer::latency(LatencyHistogram* merged) const {
+    merged->reset();
+    merged->merge(_stopped_latency);
+    for (size_t i = 0; i < _workers.size(); i++) {
+        std::lock_guard<std::mutex> lock(_workers[i]->latency_mutex);
+        merged->merge(_workers[i]->latency);
+    }
+}
+
+void IngestServer::resetLatency() {
+    _stopped_latency.reset();
+    for (size_t i = 0; i < _workers.size(); i++) {
+        std::lock_guard<std::mutex> lock(_workers[i]->latency_mutex);
+        _workers[i]->latency.reset();
+    }
+}
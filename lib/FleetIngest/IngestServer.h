@@ -0,0 +1,109 @@
+/**
+ * ============================================================================
+ * BINSAI Fleet Ingest Server
+ * Multi-threaded UDP receiver feeding a FleetStore (Linux)
+ * ============================================================================
+ *
+ * Each worker binds its own SO_REUSEPORT socket so the kernel spreads
+ * datagrams across workers, drains it with recvmmsg() batches into a
+ * per-worker buffer, and parses frames in place with TelemetryFrameView.
+ * A datagram carries one frame, or up to 8 back to back (GPRS batches).
+ * Frames carrying a load generator trace_us are timed into a per-worker
+ * LatencyHistogram (send -> state table updated, same host clock).
+ *
+ * This is also the local stand-in for the cloud endpoint during
+ * development: point FLEET_INGEST_HOST in firmware at the machine running
+ * `binsai-fleet serve`.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_INGEST_SERVER_H
+#define BINSAI_INGEST_SERVER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "FleetStore.h"
+#include "LatencyHistogram.h"
+
+#define FLEET_DEFAULT_PORT          47100
+#define FLEET_RECV_BATCH            64
+
+typedef struct {
+    uint64_t datagrams;
+    uint64_t accepted;
+    uint64_t new_bins;
+    uint64_t duplicates;
+    uint64_t invalid;
+} IngestStats_t;
+
+/**
+ * Monotonic microseconds, truncated to 32 bits (matches trace_us)
+ */
+uint32_t fleetMonotonicMicros();
+
+/**
+ * Frames in a datagram: whole multiples of TELEMETRY_FRAME_SIZE are split,
+ * any other length is passed on as one frame (and fails validation)
+ */
+void fleetDatagramFrames(size_t length, size_t* frames, size_t* frame_length);
+
+class IngestServer {
+public:
+    explicit IngestServer(FleetStore& store);
+    ~IngestServer();
+
+    /**
+     * Bind workers and start receiving
+     * @param port UDP port (0 picks an ephemeral port, see port())
+     * @param worker_count Receive threads
+     * @return false if any socket fails to bind
+     */
+    bool start(uint16_t port, unsigned worker_count);
+
+    /**
+     * Join and release the workers; their counters stay readable until the
+     * next start()
+     */
+    void stop();
+
+    uint16_t port() const { return _port; }
+
+    /**
+     * Totals of the running (or last stopped) session
+     */
+    IngestStats_t stats() const;
+
+    /**
+     * Merge all worker latency histograms (same session as stats())
+     */
+    void latency(LatencyHistogram* merged) const;
+    void resetLatency();
+
+private:
+    struct Worker {
+        int fd;
+        std::thread thread;
+        std::atomic<uint64_t> datagrams;
+        std::atomic<uint64_t> accepted;
+        std::atomic<uint64_t> new_bins;
+        std::atomic<uint64_t> duplicates;
+        std::atomic<uint64_t> invalid;
+        mutable std::mutex latency_mutex;
+        LatencyHistogram latency;
+    };
+
+    static int openSocket(uint16_t port);
+    void run(Worker* worker);
+
+    FleetStore& _store;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    IngestStats_t _stopped;                 // Last session, kept after stop()
+    LatencyHistogram _stopped_latency;
+    std::atomic<bool> _running;
+    uint16_t _port;
+};
+
+#endif  // BINSAI_INGEST_SERVER_H
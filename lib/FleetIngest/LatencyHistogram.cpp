@@ -0,0 +1,72 @@
+/**
+ * BINSAI Fleet Latency Histogram - bucket mapping and percentiles
+ */
+
+#include "LatencyHistogram.h"
+#include <string.h>
+
+void LatencyHistogram::reset() {
+    memset(_buckets, 0, sizeof(_buckets));
+    _count = 0;
+    _sum = 0;
+    _max = 0;
+}
+
+uint32_t LatencyHistogram::bucketIndex(uint32_t value_us) {
+    if (value_us < LATENCY_LINEAR_LIMIT) {
+        return value_us;
+    }
+    uint32_t exponent = 31 - __builtin_clz(value_us);          // >= 6
+    uint32_t sub = (value_us >> (exponent - LATENCY_SUB_BUCKET_BITS)) & (LATENCY_SUB_BUCKETS - 1);
+    return LATENCY_LINEAR_LIMIT + (exponent - 6) * LATENCY_SUB_BUCKETS + sub;
+}
+
+uint32_t LatencyHistogram::bucketUpperBound(uint32_t index) {
+    if (index < LATENCY_LINEAR_LIMIT) {
+        return index;
+    }
+    uint32_t exponent = (index - LATENCY_LINEAR_LIMIT) / LATENCY_SUB_BUCKETS + 6;
+    uint32_t sub = (index - LATENCY_LINEAR_LIMIT) % LATENCY_SUB_BUCKETS;
+    uint64_t width = 1ULL << (exponent - LATENCY_SUB_BUCKET_BITS);
+    uint64_t upper = (1ULL << exponent) + (sub + 1) * width - 1;
+    return upper > 0xFFFFFFFFULL ? 0xFFFFFFFFUL : (uint32_t)upper;
+}
+
+void LatencyHistogram::record(uint32_t value_us) {
+    _buckets[bucketIndex(value_us)]++;
+    _count++;
+    _sum += value_us;
+    if (value_us > _max) {
+        _max = value_us;
+    }
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (uint32_t i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        _buckets[i] += other._buckets[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    if (other._max > _max) {
+        _max = other._max;
+    }
+}
+
+uint32_t LatencyHistogram::percentile(double percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(percentile / 100.0 * _count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > _count) rank = _count;
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        seen += _buckets[i];
+        if (seen >= rank) {
+            uint32_t upper = bucketUpperBound(i);
+            return upper < _max ? upper : _max;
+        }
+    }
+    return _max;
+}
@@ -0,0 +1,51 @@
+/**
+ * ============================================================================
+ * BINSAI Fleet Latency Histogram
+ * Fixed-bucket log-linear histogram for microsecond latencies
+ * ============================================================================
+ *
+ * Values below 64 us get exact buckets; above that each power of two is
+ * split into 32 sub-buckets (~3% resolution) up to 2^32 us. One histogram
+ * per worker thread, merged for reporting, so recording never contends.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_LATENCY_HISTOGRAM_H
+#define BINSAI_LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+
+#define LATENCY_LINEAR_LIMIT        64
+#define LATENCY_SUB_BUCKET_BITS     5
+#define LATENCY_SUB_BUCKETS         (1 << LATENCY_SUB_BUCKET_BITS)
+#define LATENCY_BUCKET_COUNT        (LATENCY_LINEAR_LIMIT + (32 - 6) * LATENCY_SUB_BUCKETS)
+
+class LatencyHistogram {
+public:
+    LatencyHistogram() { reset(); }
+
+    void reset();
+    void record(uint32_t value_us);
+    void merge(const LatencyHistogram& other);
+
+    uint64_t count() const { return _count; }
+    uint32_t max() const { return _max; }
+    double mean() const { return _count ? (double)_sum / _count : 0.0; }
+
+    /**
+     * Upper bound of the bucket holding the given percentile
+     * @param percentile 0-100
+     */
+    uint32_t percentile(double percentile) const;
+
+private:
+    static uint32_t bucketIndex(uint32_t value_us);
+    static uint32_t bucketUpperBound(uint32_t index);
+
+    uint64_t _buckets[LATENCY_BUCKET_COUNT];
+    uint64_t _count;
+    uint64_t _sum;
+    uint32_t _max;
+};
+
+#endif  // BINSAI_LATENCY_HISTOGRAM_H
@@ -0,0 +1,209 @@
+/**
+ * BINSAI Fleet Load Generator - paced sendmmsg() senders
+ */
+
+#include "LoadGenerator.h"
+#include "IngestServer.h"
+#include "TelemetryFrame.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+
+/**
+ * Synthetic state for one simulated bin
+ */
+typedef struct {
+    char device_id[TELEMETRY_DEVICE_ID_LEN + 1];
+    uint32_t sequence;
+    float fill;
+    float fill_step;
+    float ppm;
+    double latitude;
+    double longitude;
+    uint8_t zone;
+} SimulatedBin_t;
+
+static uint32_t xorshift32(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static float randomUnit(uint32_t* state) {
+    return (xorshift32(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+static uint64_t monotonicMicros64() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+void loadGeneratorDefaults(LoadGeneratorConfig_t* config) {
+    config->host = "127.0.0.1";
+    config->port = FLEET_DEFAULT_PORT;
+    config->bin_count = LOADGEN_DEFAULT_BINS;
+    config->rate_per_second = 100000;
+    config->duration_ms = 5000;
+    config->thread_count = 2;
+    config->seed = 0x42494E53;  // "BINS"
+}
+
+void loadGeneratorDeviceId(uint32_t bin, char* buffer, size_t capacity) {
+    snprintf(buffer, capacity, "SIM-%06u", (unsigned)bin);
+}
+
+/**
+ * Advance a simulated bin by one report and encode it
+ */
+static void stepBin(SimulatedBin_t* bin, uint32_t* rng, uint8_t* frame) {
+    bin->fill += bin->fill_step;
+    if (bin->fill >= 100.0f) {
+        bin->fill = randomUnit(rng) * 5.0f;  // Collected
+    }
+    bin->ppm += (randomUnit(rng) - 0.45f) * 20.0f;
+    if (bin->ppm < 50.0f) bin->ppm = 50.0f;
+    if (bin->ppm > 1500.0f) bin->ppm = 400.0f;
+
+    SensorData_t data;
+    memset(&data, 0, sizeof(data));
+    data.fill_percentage = bin->fill;
+    data.distance_cm = 40.0f * (1.0f - bin->fill / 100.0f);
+    data.ppm_calculated = bin->ppm;
+    data.latitude = bin->latitude;
+    data.longitude = bin->longitude;
+    data.satellite_count = 7;
+    data.hdop = 1.2f;
+    data.capacity_level = bin->fill > THRESHOLD_ALMOST_FULL ? 3 : bin->fill > THRESHOLD_HALF_PERCENT ? 2 :
+                          bin->fill > THRESHOLD_EMPTY_PERCENT ? 1 : 0;
+    data.waste_classification = bin->ppm > PPM_ORGANIC_L1_MAX ? 3 : bin->ppm > PPM_INORGANIC_MAX ? 2 :
+                                bin->ppm > PPM_CLEAN_AIR_MAX ? 1 : 0;
+    data.priority_level = data.capacity_level;
+    data.timestamp_unix = (uint32_t)time(NULL);
+    data.hours_to_full = -1.0f;
+
+    TelemetryFrameMeta_t meta;
+    meta.device_id = bin->device_id;
+    meta.sequence = ++bin->sequence;
+    meta.flags = TELEMETRY_FLAG_GPS_FIX | (data.capacity_level == 3 ? TELEMETRY_FLAG_CRITICAL : 0);
+    meta.deployment_zone = bin->zone;
+    meta.trace_us = fleetMonotonicMicros() | 1;     // Never 0 (= untraced)
+    meta.boot_epoch = 0;
+    telemetryEncode(data, meta, frame, TELEMETRY_FRAME_SIZE);
+}
+
+static void senderThread(const LoadGeneratorConfig_t* config, uint32_t first_bin, uint32_t bin_count,
+                         uint32_t thread_rate, const std::atomic<bool>* stop,
+                         LoadGeneratorResult_t* result) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config->port);
+    inet_pton(AF_INET, config->host, &addr.sin_addr);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        result->send_errors++;
+        if (fd >= 0) close(fd);
+        return;
+    }
+
+    uint32_t rng = config->seed ^ (first_bin * 2654435761U);
+    if (rng == 0) rng = 1;
+    std::vector<SimulatedBin_t> bins(bin_count);
+    for (uint32_t i = 0; i < bin_count; i++) {
+        SimulatedBin_t& bin = bins[i];
+        loadGeneratorDeviceId(first_bin + i, bin.device_id, sizeof(bin.device_id));
+        bin.sequence = 0;
+        bin.fill = randomUnit(&rng) * 100.0f;
+        bin.fill_step = 0.05f + randomUnit(&rng) * 0.5f;
+        bin.ppm = 100.0f + randomUnit(&rng) * 600.0f;
+        bin.latitude = -7.80 + randomUnit(&rng) * 0.15;   // Yogyakarta
+        bin.longitude = 110.32 + randomUnit(&rng) * 0.15;
+        bin.zone = (uint8_t)((first_bin + i) % LOADGEN_ZONE_COUNT + 1);
+    }
+
+    uint8_t frames[LOADGEN_SEND_BATCH][TELEMETRY_FRAME_SIZE];
+    struct iovec iov[LOADGEN_SEND_BATCH];
+    struct mmsghdr messages[LOADGEN_SEND_BATCH];
+    memset(messages, 0, sizeof(messages));
+    for (int i = 0; i < LOADGEN_SEND_BATCH; i++) {
+        iov[i].iov_base = frames[i];
+        iov[i].iov_len = TELEMETRY_FRAME_SIZE;
+        messages[i].msg_hdr.msg_iov = &iov[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    uint64_t start_us = monotonicMicros64();
+    uint64_t end_us = start_us + (uint64_t)config->duration_ms * 1000ULL;
+    uint32_t next_bin = 0;
+
+    while (true) {
+        uint64_t now_us = monotonicMicros64();
+        if (now_us >= end_us || (stop && stop->load())) {
+            break;
+        }
+
+        if (thread_rate > 0) {
+            uint64_t allowed = (now_us - start_us) * thread_rate / 1000000ULL;
+            if (result->frames_sent + LOADGEN_SEND_BATCH > allowed) {
+                usleep(100);
+                continue;
+            }
+        }
+
+        for (int i = 0; i < LOADGEN_SEND_BATCH; i++) {
+            stepBin(&bins[next_bin], &rng, frames[i]);
+            next_bin = (next_bin + 1) % bin_count;
+        }
+
+        int sent = sendmmsg(fd, messages, LOADGEN_SEND_BATCH, 0);
+        if (sent < 0) {
+            result->send_errors++;
+        } else {
+            result->frames_sent += (uint64_t)sent;
+        }
+    }
+
+    close(fd);
+}
+
+LoadGeneratorResult_t runLoadGenerator(const LoadGeneratorConfig_t& config,
+                                       const std::atomic<bool>* stop) {
+    LoadGeneratorResult_t total;
+    memset(&total, 0, sizeof(total));
+
+    unsigned thread_count = config.thread_count ? config.thread_count : 1;
+    if (thread_count > config.bin_count) {
+        thread_count = config.bin_count ? config.bin_count : 1;
+    }
+
+    std::vector<LoadGeneratorResult_t> results(thread_count);
+    std::vector<std::thread> threads;
+    uint64_t start_us = monotonicMicros64();
+
+    uint32_t per_thread = config.bin_count / thread_count;
+    for (unsigned t = 0; t < thread_count; t++) {
+        memset(&results[t], 0, sizeof(results[t]));
+        uint32_t first = t * per_thread;
+        uint32_t count = (t == thread_count - 1) ? config.bin_count - first : per_thread;
+        threads.push_back(std::thread(senderThread, &config, first, count,
+                                      config.rate_per_second / thread_count, stop, &results[t]));
+    }
+
+    for (unsigned t = 0; t < thread_count; t++) {
+        threads[t].join();
+        total.frames_sent += results[t].frames_sent;
+        total.send_errors += results[t].send_errors;
+    }
+    total.elapsed_ms = (uint32_t)((monotonicMicros64() - start_us) / 1000);
+    return total;
+}
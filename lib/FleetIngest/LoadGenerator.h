@@ -0,0 +1,59 @@
+/**
+ * ============================================================================
+ * BINSAI Fleet Load Generator
+ * Simulates a fleet of bins sending telemetry frames over UDP
+ * ============================================================================
+ *
+ * Bins are split across sender threads. Each bin has a synthetic fill
+ * ramp with its own rate and phase so the state table sees realistic
+ * churn (collections, class changes). Frames go out in sendmmsg()
+ * batches paced against the target aggregate rate and carry trace_us so
+ * the server can time send -> ingest.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_LOAD_GENERATOR_H
+#define BINSAI_LOAD_GENERATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#define LOADGEN_DEFAULT_BINS        10000
+#define LOADGEN_SEND_BATCH          32
+#define LOADGEN_ZONE_COUNT          14      // Kecamatan in Kota Yogyakarta
+
+typedef struct {
+    const char* host;               // IPv4 address
+    uint16_t port;
+    uint32_t bin_count;
+    uint32_t rate_per_second;       // Aggregate frames/s (0 = unpaced)
+    uint32_t duration_ms;
+    unsigned thread_count;
+    uint32_t seed;
+} LoadGeneratorConfig_t;
+
+typedef struct {
+    uint64_t frames_sent;
+    uint64_t send_errors;
+    uint32_t elapsed_ms;
+} LoadGeneratorResult_t;
+
+/**
+ * Fill in defaults (127.0.0.1, 10k bins, 100k frames/s, 5 s, 2 threads)
+ */
+void loadGeneratorDefaults(LoadGeneratorConfig_t* config);
+
+/**
+ * Device id for simulated bin n ("SIM-000042")
+ */
+void loadGeneratorDeviceId(uint32_t bin, char* buffer, size_t capacity);
+
+/**
+ * Run to completion (blocks for duration_ms)
+ * @param stop Optional external stop flag
+ */
+LoadGeneratorResult_t runLoadGenerator(const LoadGeneratorConfig_t& config,
+                                       const std::atomic<bool>* stop = NULL);
+
+#endif  // BINSAI_LOAD_GENERATOR_H
@@ -0,0 +1,161 @@
+/**
+ * BINSAI Gas Baseline - point averaging, daily percentile and window estimate
+ */
+
+#include "GasBaseline.h"
+#include <math.h>
+#include <string.h>
+
+static float logMin() { return logf(BASELINE_RS_MIN_KOHM); }
+static float logSpan() { return logf(BASELINE_RS_MAX_KOHM) - logf(BASELINE_RS_MIN_KOHM); }
+
+static uint8_t histogramBin(float rs_kohm) {
+    float position = (logf(rs_kohm) - logMin()) / logSpan() * BASELINE_HISTOGRAM_BINS;
+    if (position < 0.0f) return 0;
+    if (position >= BASELINE_HISTOGRAM_BINS) return BASELINE_HISTOGRAM_BINS - 1;
+    return (uint8_t)position;
+}
+
+void baselineInit(GasBaselineState_t* state, uint32_t now_s) {
+    memset(state, 0, sizeof(*state));
+    state->magic = BASELINE_STATE_MAGIC;
+    state->point_start_s = now_s;
+}
+
+bool baselineIsValid(const GasBaselineState_t* state) {
+    return state->magic == BASELINE_STATE_MAGIC &&
+           state->day_head < BASELINE_WINDOW_DAYS &&
+           state->day_count <= BASELINE_WINDOW_DAYS &&
+           state->day_points < BASELINE_DAY_POINTS;
+}
+
+float baselineDayPercentile(const GasBaselineState_t* state, float fraction) {
+    if (state->day_points == 0) {
+        return 0.0f;
+    }
+    if (fraction < 0.0f) fraction = 0.0f;
+    if (fraction > 1.0f) fraction = 1.0f;
+
+    // Walk the cumulative counts, interpolate inside the crossing bin
+    float target = fraction * state->day_points;
+    float below = 0.0f;
+    uint8_t bin = 0;
+    for (; bin < BASELINE_HISTOGRAM_BINS - 1; bin++) {
+        if (below + state->histogram[bin] >= target && state->histogram[bin] > 0) {
+            break;
+        }
+        below += state->histogram[bin];
+    }
+
+    float within = state->histogram[bin] ? (target - below) / state->histogram[bin] : 0.5f;
+    if (within < 0.0f) within = 0.0f;
+    if (within > 1.0f) within = 1.0f;
+    return expf(logMin() + (bin + within) * logSpan() / BASELINE_HISTOGRAM_BINS);
+}
+
+/**
+ * Close the baseline day: its percentile enters the window
+ */
+static void closeDay(GasBaselineState_t* state) {
+    state->day_rs[state->day_head] = baselineDayPercentile(state, BASELINE_PERCENTILE);
+    state->day_head = (state->day_head + 1) % BASELINE_WINDOW_DAYS;
+    if (state->day_count < BASELINE_WINDOW_DAYS) {
+        state->day_count++;
+    }
+    state->days_total++;
+
+    memset(state->histogram, 0, sizeof(state->histogram));
+    state->day_points = 0;
+}
+
+bool baselineUpdate(GasBaselineState_t* state, float rs_kohm, uint32_t now_s) {
+    bool day_closed = false;
+
+    // Unsigned difference: a reboot (uptime restarting) also closes the point
+    if (now_s - state->point_start_s >= BASELINE_POINT_S) {
+        if (state->point_samples > 0) {
+            float average = state->point_sum / state->point_samples;
+            uint8_t bin = histogramBin(average);
+            state->histogram[bin]++;
+            state->day_points++;
+            if (state->day_points >= BASELINE_DAY_POINTS) {
+                closeDay(state);
+                day_closed = true;
+            }
+        }
+        state->point_start_s = now_s;
+        state->point_sum = 0.0f;
+        state->point_samples = 0;
+    }
+
+    if (rs_kohm > 0.0f && state->point_samples < UINT16_MAX) {
+        state->point_sum += rs_kohm;
+        state->point_samples++;
+    }
+    return day_closed;
+}
+
+bool baselineEstimate(const GasBaselineState_t* state, float clean_air_ratio,
+                      GasBaselineEstimate_t* estimate) {
+    memset(estimate, 0, sizeof(*estimate));
+    if (state->day_count == 0 || clean_air_ratio <= 0.0f) {
+        return false;
+    }
+
+    // Median of the window (insertion sort, at most BASELINE_WINDOW_DAYS)
+    float sorted[BASELINE_WINDOW_DAYS];
+    uint8_t n = state->day_count;
+    for (uint8_t i = 0; i < n; i++) {
+        float value = state->day_rs[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+    float median = (n & 1) ? sorted[n / 2] : 0.5f * (sorted[n / 2 - 1] + sorted[n / 2]);
+
+    float mean = 0.0f;
+    for (uint8_t i = 0; i < n; i++) {
+        mean += sorted[i];
+    }
+    mean /= n;
+    float variance = 0.0f;
+    for (uint8_t i = 0; i < n; i++) {
+        variance += (sorted[i] - mean) * (sorted[i] - mean);
+    }
+    variance /= n;
+
+    float stability = mean > 0.0f ? 1.0f - sqrtf(variance) / mean / BASELINE_MAX_CV : 0.0f;
+    if (stability < 0.0f) stability = 0.0f;
+    float coverage = (float)n / BASELINE_WINDOW_DAYS;
+
+    estimate->rs_clean_kohm = median;
+    estimate->r0_kohm = median / clean_air_ratio;
+    estimate->confidence = 100.0f * coverage * stability;
+    estimate->days = n;
+    return true;
+}
+
+bool baselineNextR0(const GasBaselineEstimate_t* estimate, float current_r0,
+                    float current_confidence, float* next_r0) {
+    if (estimate->days == 0 || estimate->r0_kohm <= 0.0f ||
+        estimate->confidence < BASELINE_MIN_CONFIDENCE) {
+        return false;
+    }
+
+    if (current_r0 <= 0.0f || current_confidence < BASELINE_MIN_CONFIDENCE) {
+        *next_r0 = estimate->r0_kohm;
+        return true;
+    }
+
+    // Trusted R0: follow slow sensor drift, ignore a sudden jump
+    float low = current_r0 * (1.0f - BASELINE_MAX_STEP);
+    float high = current_r0 * (1.0f + BASELINE_MAX_STEP);
+    float value = estimate->r0_kohm;
+    if (value < low) value = low;
+    if (value > high) value = high;
+    *next_r0 = value;
+    return true;
+}
@@ -0,0 +1,120 @@
+/**
+ * ============================================================================
+ * BINSAI Gas Baseline
+ * Background MQ-135 R0 recalibration from the clean-air sensor resistance
+ * ============================================================================
+ *
+ * MODEL:
+ * - RS samples (2 s) are averaged into BASELINE_POINT_S points
+ * - Each point goes into a log-spaced RS histogram for the current
+ *   baseline day (BASELINE_DAY_POINTS points = 24 h of sampling, so
+ *   days stretch across power cuts instead of being cut short)
+ * - When a day closes its BASELINE_PERCENTILE RS is the clean-air
+ *   reading of that day. Gas lowers the MQ-135 resistance, so the
+ *   cleanest air is the HIGH end of RS (the low end of ADC / ppm)
+ * - The last BASELINE_WINDOW_DAYS daily values form the sliding window;
+ *   the estimate is their median, R0 = RS_clean / clean air ratio
+ * - Confidence (0-100) = window coverage x day-to-day stability, where
+ *   stability falls linearly from 1 to 0 as the coefficient of variation
+ *   of the daily values reaches BASELINE_MAX_CV
+ *
+ * Nothing here blocks: one O(1) histogram increment per point, and a
+ * O(BASELINE_HISTOGRAM_BINS) scan once a day.
+ *
+ * The state is a POD struct so the firmware can store it in NVS and keep
+ * the window across reboots.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_GAS_BASELINE_H
+#define BINSAI_GAS_BASELINE_H
+
+#include <stdint.h>
+
+#define BASELINE_POINT_S            60        // RS averaging interval
+#define BASELINE_DAY_POINTS         1440      // Points per baseline day
+#define BASELINE_WINDOW_DAYS        7         // Sliding window of daily values
+#define BASELINE_PERCENTILE         0.90f     // Daily clean-air percentile of RS
+#define BASELINE_HISTOGRAM_BINS     128       // Log-spaced bins per day
+#define BASELINE_RS_MIN_KOHM        0.01f     // Histogram range; samples are clamped
+#define BASELINE_RS_MAX_KOHM        100.0f
+#define BASELINE_MAX_CV             0.5f      // Daily value spread at which confidence is 0
+#define BASELINE_MIN_CONFIDENCE     60.0f     // Estimates below this are not applied
+#define BASELINE_MAX_STEP           0.05f     // Max relative R0 change per day once trusted
+#define BASELINE_STATE_MAGIC        0x4C425347UL  // "GSBL" little-endian
+
+/**
+ * Baseline state (POD, persisted as one NVS blob)
+ */
+typedef struct {
+    uint32_t magic;                     // BASELINE_STATE_MAGIC when initialized
+
+    // Point averaging
+    uint32_t point_start_s;             // Start of the open point
+    float point_sum;                    // Sum of RS samples in the open point
+    uint16_t point_samples;
+
+    // Current day
+    uint16_t day_points;                // Points in the histogram
+    uint16_t histogram[BASELINE_HISTOGRAM_BINS];
+
+    // Sliding window of daily clean-air RS [kOhm]
+    float day_rs[BASELINE_WINDOW_DAYS];
+    uint8_t day_head;                   // Next write index
+    uint8_t day_count;                  // Valid entries
+    uint16_t days_total;                // Days closed since init
+} GasBaselineState_t;
+
+typedef struct {
+    float rs_clean_kohm;                // Median daily clean-air RS
+    float r0_kohm;                      // rs_clean_kohm / clean air ratio
+    float confidence;                   // 0-100
+    uint8_t days;                       // Daily values behind the estimate
+} GasBaselineEstimate_t;
+
+/**
+ * Reset the window (first boot, or after a manual CALIBRATE)
+ */
+void baselineInit(GasBaselineState_t* state, uint32_t now_s);
+
+/**
+ * Check whether a stored state is usable
+ */
+bool baselineIsValid(const GasBaselineState_t* state);
+
+/**
+ * Add a raw RS sample
+ * @param rs_kohm Sensor resistance in kOhm (non-positive samples are ignored)
+ * @param now_s Monotonic seconds (uptime is fine; reboots just close the point)
+ * @return true if a baseline day was closed by this sample
+ */
+bool baselineUpdate(GasBaselineState_t* state, float rs_kohm, uint32_t now_s);
+
+/**
+ * Current estimate from the window
+ * @param clean_air_ratio RS/R0 of the sensor in clean air
+ * @return false while no day has closed yet
+ */
+bool baselineEstimate(const GasBaselineState_t* state, float clean_air_ratio,
+                      GasBaselineEstimate_t* estimate);
+
+/**
+ * R0 to store after a day closes
+ * @param current_r0 R0 in use
+ * @param current_confidence Confidence of current_r0 (0 = factory default)
+ * @param next_r0 Receives the new R0
+ * @return false if the estimate is not confident enough to apply.
+ *         An untrusted R0 (confidence below BASELINE_MIN_CONFIDENCE) is
+ *         replaced outright, a trusted one moves at most BASELINE_MAX_STEP
+ */
+bool baselineNextR0(const GasBaselineEstimate_t* estimate, float current_r0,
+                    float current_confidence, float* next_r0);
+
+/**
+ * RS at a percentile of the current (open) day
+ * @param fraction 0.0-1.0
+ * @return kOhm, or 0 without points
+ */
+float baselineDayPercentile(const GasBaselineState_t* state, float fraction);
+
+#endif  // BINSAI_GAS_BASELINE_H
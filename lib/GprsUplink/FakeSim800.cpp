@@ -0,0 +1,158 @@
+/**
+ * BINSAI Fake SIM800L - scripted AT replies on a virtual clock
+ */
+
+#include "FakeSim800.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FAKE_SIM800_CTRL_Z          26
+
+FakeSim800::FakeSim800(const FakeSim800Timing_t& timing)
+    : _timing(timing), _now_ms(0), _registered(true), _activation_failures(0), _send_failures(0), _pdp(false),
+      _socket(false), _mode(INPUT_COMMAND), _datagram_length(0), _awaiting(false), _prompt_pending(false),
+      _interleaves(0), _reply_offset(0) {}
+
+size_t FakeSim800::count(const char* prefix) const {
+    size_t matches = 0;
+    for (size_t i = 0; i < _commands.size(); i++) {
+        matches += _commands[i].compare(0, strlen(prefix), prefix) == 0;
+    }
+    return matches;
+}
+
+void FakeSim800::dropContext() {
+    _pdp = false;
+    _socket = false;
+    reply("+PDP: DEACT", 0, false);
+}
+
+size_t FakeSim800::write(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        char c = (char)data[i];
+        if (_mode != INPUT_COMMAND && _prompt_pending) {
+            continue;
+        }
+        if (_mode == INPUT_DATAGRAM) {
+            _input.push_back(c);
+            if (_input.size() == _datagram_length) {
+                _mode = INPUT_COMMAND;
+                bool failed = !_socket || _send_failures > 0;
+                if (_send_failures > 0) {
+                    _send_failures--;
+                }
+                if (!failed) {
+                    _datagrams.push_back(std::vector<uint8_t>(_input.begin(), _input.end()));
+                }
+                reply(failed ? "SEND FAIL" : "SEND OK", _timing.reply_ms);
+                _input.clear();
+            }
+        } else if (_mode == INPUT_SMS) {
+            if (c == FAKE_SIM800_CTRL_Z) {
+                _mode = INPUT_COMMAND;
+                _messages.push_back(_input);
+                _input.clear();
+                reply("+CMGS: 7", _timing.network_ms, false);
+                reply("OK", 0);
+            } else {
+                _input.push_back(c);
+            }
+        } else if (c == '\r' || c == '\n') {
+            if (!_input.empty()) {
+                std::string command = _input;
+                _input.clear();
+                handleCommand(command);
+            }
+        } else {
+            _input.push_back(c);
+        }
+    }
+    return length;
+}
+
+size_t FakeSim800::read(uint8_t* buffer, size_t capacity) {
+    size_t copied = 0;
+    while (copied < capacity && !_replies.empty() && _replies.front().deliver_ms <= _now_ms) {
+        const Reply_t& front = _replies.front();
+        size_t chunk = front.text.size() - _reply_offset;
+        if (chunk > capacity - copied) {
+            chunk = capacity - copied;
+        }
+        memcpy(buffer + copied, front.text.data() + _reply_offset, chunk);
+        copied += chunk;
+        _reply_offset += chunk;
+        if (_reply_offset == front.text.size()) {
+            if (front.final) {
+                _awaiting = false;
+            } else if (front.text == "\r\n> ") {
+                _prompt_pending = false;
+            }
+            _replies.pop_front();
+            _reply_offset = 0;
+        }
+    }
+    return copied;
+}
+
+void FakeSim800::reply(const std::string& line, uint32_t delay_ms, bool final) {
+    Reply_t entry;
+    entry.deliver_ms = _now_ms + delay_ms;
+    if (!_replies.empty() && _replies.back().deliver_ms > entry.deliver_ms) {
+        entry.deliver_ms = _replies.back().deliver_ms;
+    }
+    entry.text = "\r\n" + line + "\r\n";
+    entry.final = final;
+    _replies.push_back(entry);
+}
+
+void FakeSim800::prompt(uint32_t delay_ms) {
+    reply("", delay_ms, false);
+    _replies.back().text = "\r\n> ";
+    _prompt_pending = true;
+}
+
+void FakeSim800::handleCommand(const std::string& command) {
+    _commands.push_back(command);
+    if (_awaiting) {
+        _interleaves++;
+    }
+    _awaiting = true;
+
+    if (command == "AT+CIPSHUT") {
+        _pdp = false;
+        _socket = false;
+        reply("SHUT OK", _timing.reply_ms);
+    } else if (command == "AT+CGATT=1") {
+        reply(_registered ? "OK" : "ERROR", _timing.reply_ms);
+    } else if (command == "AT+CIICR") {
+        bool failed = !_registered || _activation_failures > 0;
+        if (_activation_failures > 0) {
+            _activation_failures--;
+        }
+        _pdp = !failed;
+        reply(failed ? "ERROR" : "OK", _timing.network_ms);
+    } else if (command == "AT+CIFSR") {
+        reply(_pdp ? "10.64.12.7" : "ERROR", _timing.reply_ms);
+    } else if (command.compare(0, 11, "AT+CIPSTART") == 0) {
+        if (_pdp) {
+            _socket = true;
+            reply("OK", _timing.reply_ms, false);
+            reply("CONNECT OK", _timing.network_ms);
+        } else {
+            reply("ERROR", _timing.reply_ms);
+        }
+    } else if (command.compare(0, 11, "AT+CIPSEND=") == 0) {
+        _datagram_length = (size_t)atoi(command.c_str() + 11);
+        if (_socket && _datagram_length > 0) {
+            _mode = INPUT_DATAGRAM;
+            prompt(_timing.reply_ms);
+        } else {
+            reply("ERROR", _timing.reply_ms);
+        }
+    } else if (command.compare(0, 8, "AT+CMGS=") == 0) {
+        _mode = INPUT_SMS;
+        prompt(_timing.reply_ms);
+    } else {
+        reply("OK", _timing.reply_ms);
+    }
+}
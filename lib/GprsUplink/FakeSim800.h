@@ -0,0 +1,122 @@
+/**
+ * ============================================================================
+ * BINSAI Fake SIM800L
+ * AT command stand-in for host tests of the GPRS link and modem arbiter
+ * ============================================================================
+ *
+ * Answers the subset of SIM800L commands the firmware uses: GPRS bring-up
+ * (CIPSHUT, CGATT, CSTT, CIICR, CIFSR, CIPSTART), UDP CIPSEND with the '>'
+ * prompt, and SMS (CMGS, text ended by Ctrl+Z). Anything else gets OK.
+ * Replies arrive reply_ms later on the caller's clock; PDP activation,
+ * socket open and SMS submission take network_ms.
+ *
+ * Like the modem, data written before the '>' prompt has been read (such
+ * as the LF after the command's CR) is discarded.
+ *
+ * Faults: no GPRS registration, a number of failed PDP activations, the
+ * network dropping the context (+PDP: DEACT) and failed sends.
+ *
+ * It also checks the arbitration contract: a command written while the
+ * previous one is still unanswered (reply not yet read) counts as an
+ * interleave.
+ *
+ * Drive it with advance(now) before each loop(now) of the code under test.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_FAKE_SIM800_H
+#define BINSAI_FAKE_SIM800_H
+
+#include <stdint.h>
+#include <deque>
+#include <string>
+#include <vector>
+#include "GprsLink.h"
+
+typedef struct {
+    uint32_t reply_ms;              // Local command reply delay
+    uint32_t network_ms;            // CIICR / CIPSTART / CMGS delay
+} FakeSim800Timing_t;
+
+class FakeSim800 : public ModemPort {
+public:
+    explicit FakeSim800(const FakeSim800Timing_t& timing);
+
+    size_t write(const uint8_t* data, size_t length) override;
+    size_t read(uint8_t* buffer, size_t capacity) override;
+
+    void advance(uint32_t now_ms) { _now_ms = now_ms; }
+
+    /**
+     * While false, AT+CGATT=1 fails
+     */
+    void setRegistered(bool registered) { _registered = registered; }
+
+    /**
+     * The next count AT+CIICR calls answer ERROR
+     */
+    void failActivations(uint32_t count) { _activation_failures = count; }
+
+    /**
+     * Network drops the PDP context: "+PDP: DEACT" now, sends fail until
+     * the next bring-up
+     */
+    void dropContext();
+
+    /**
+     * The next count datagrams answer SEND FAIL
+     */
+    void failSends(uint32_t count) { _send_failures = count; }
+
+    const std::vector<std::string>& commands() const { return _commands; }
+    const std::vector<std::vector<uint8_t> >& datagrams() const { return _datagrams; }
+    const std::vector<std::string>& messages() const { return _messages; }
+    uint32_t interleaves() const { return _interleaves; }
+    bool contextActive() const { return _pdp; }
+    bool socketOpen() const { return _socket; }
+
+    /**
+     * Commands written so far that start with prefix
+     */
+    size_t count(const char* prefix) const;
+
+private:
+    typedef enum {
+        INPUT_COMMAND = 0,
+        INPUT_DATAGRAM,             // n bytes after the CIPSEND prompt
+        INPUT_SMS                   // Text until Ctrl+Z
+    } InputMode_t;
+
+    typedef struct {
+        uint32_t deliver_ms;
+        std::string text;
+        bool final;                 // Ends the exchange
+    } Reply_t;
+
+    void handleCommand(const std::string& command);
+    void reply(const std::string& line, uint32_t delay_ms, bool final = true);
+    void prompt(uint32_t delay_ms);
+
+    FakeSim800Timing_t _timing;
+    uint32_t _now_ms;
+    bool _registered;
+    uint32_t _activation_failures;
+    uint32_t _send_failures;
+    bool _pdp;
+    bool _socket;
+
+    InputMode_t _mode;
+    std::string _input;
+    size_t _datagram_length;
+    bool _awaiting;                 // Command answered only partly (or not yet read)
+    bool _prompt_pending;           // Bytes before the '>' is read are discarded
+    uint32_t _interleaves;
+
+    std::deque<Reply_t> _replies;
+    size_t _reply_offset;
+    std::vector<std::string> _commands;
+    std::vector<std::vector<uint8_t> > _datagrams;
+    std::vector<std::string> _messages;
+};
+
+#endif  // BINSAI_FAKE_SIM800_H
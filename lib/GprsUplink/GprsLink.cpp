@@ -0,0 +1,309 @@
+/**
+ * BINSAI GPRS Link - SIM800L bring-up and UDP send state machine
+ */
+
+#include "GprsLink.h"
+#include <stdio.h>
+#include <string.h>
+
+#define GPRS_LATENCY_WEIGHT         4             // EWMA: new sample weighs 1/4
+
+typedef enum {
+    OPEN_SHUT = 0,
+    OPEN_ATTACH,
+    OPEN_APN,
+    OPEN_ACTIVATE,
+    OPEN_ADDRESS,
+    OPEN_CONNECT,
+    OPEN_STEPS
+} OpenStep_t;
+
+typedef enum {
+    SEND_PROMPT = 0,                // AT+CIPSEND=<n> written, waiting for '>'
+    SEND_RESULT                     // Payload written, waiting for SEND OK
+} SendStep_t;
+
+void gprsLinkDefaults(GprsLinkConfig_t* config) {
+    config->apn = "internet";
+    config->username = "";
+    config->password = "";
+    config->host = "";
+    config->port = 0;
+    config->command_timeout_ms = 10000;
+    config->network_timeout_ms = 45000;
+    config->retry_min_ms = 5000;
+    config->retry_max_ms = 300000;
+}
+
+/**
+ * AT+CIFSR answers with the bare dotted local address
+ */
+static bool isAddressLine(const char* line) {
+    bool dot = false;
+    if (*line < '0' || *line > '9') {
+        return false;
+    }
+    for (; *line; line++) {
+        if (*line == '.') {
+            dot = true;
+        } else if (*line < '0' || *line > '9') {
+            return false;
+        }
+    }
+    return dot;
+}
+
+GprsLink::GprsLink(ModemPort& port, ModemArbiter& arbiter, const GprsLinkConfig_t& config)
+    : _port(port), _arbiter(arbiter), _config(config), _state(GPRS_LINK_DOWN), _send_status(GPRS_SEND_IDLE),
+      _want_open(false), _step(0), _in_flight(false), _command_ms(0), _timeout_ms(0), _started_ms(0),
+      _retry_at_ms(0), _backoff_ms(config.retry_min_ms), _latency_ms(0), _line_length(0), _payload_length(0) {
+    memset(&_stats, 0, sizeof(_stats));
+    _command[0] = '\0';
+    _line[0] = '\0';
+}
+
+void GprsLink::open(uint32_t now_ms) {
+    if (!_want_open) {
+        _want_open = true;
+        _retry_at_ms = now_ms;
+        _backoff_ms = _config.retry_min_ms;
+    }
+}
+
+void GprsLink::close() {
+    _want_open = false;
+}
+
+bool GprsLink::send(const uint8_t* data, size_t length, uint32_t now_ms) {
+    if (_state != GPRS_LINK_READY || length == 0 || length > GPRS_MAX_PAYLOAD) {
+        return false;
+    }
+    memcpy(_payload, data, length);
+    _payload_length = length;
+    _state = GPRS_LINK_SENDING;
+    _step = SEND_PROMPT;
+    _send_status = GPRS_SEND_BUSY;
+    _started_ms = now_ms;
+    return true;
+}
+
+void GprsLink::loop(uint32_t now_ms) {
+    if (_in_flight) {
+        receive(now_ms);
+        if (_in_flight && now_ms - _command_ms >= _timeout_ms) {
+            finishCommand(false, now_ms);
+        }
+        return;
+    }
+
+    switch (_state) {
+        case GPRS_LINK_DOWN:
+            if (_want_open && (int32_t)(now_ms - _retry_at_ms) >= 0) {
+                _state = GPRS_LINK_OPENING;
+                _step = OPEN_SHUT;
+                _started_ms = now_ms;
+                startCommand(now_ms);
+            }
+            break;
+
+        case GPRS_LINK_OPENING:
+            if (!_want_open) {
+                _state = GPRS_LINK_CLOSING;
+            }
+            startCommand(now_ms);
+            break;
+
+        case GPRS_LINK_READY:
+            if (!_want_open) {
+                _state = GPRS_LINK_CLOSING;
+                startCommand(now_ms);
+            } else if (_arbiter.owner() == MODEM_USER_NONE) {
+                receive(now_ms);    // "CLOSED" / "+PDP: DEACT"
+            }
+            break;
+
+        case GPRS_LINK_SENDING:
+        case GPRS_LINK_CLOSING:
+            startCommand(now_ms);
+            break;
+    }
+}
+
+bool GprsLink::startCommand(uint32_t now_ms) {
+    if (!_arbiter.tryAcquire(MODEM_USER_GPRS, now_ms)) {
+        return false;
+    }
+
+    _timeout_ms = _config.command_timeout_ms;
+    if (_state == GPRS_LINK_CLOSING) {
+        snprintf(_command, sizeof(_command), "AT+CIPSHUT");
+    } else if (_state == GPRS_LINK_SENDING) {
+        snprintf(_command, sizeof(_command), "AT+CIPSEND=%u", (unsigned)_payload_length);
+    } else {
+        switch (_step) {
+            case OPEN_SHUT:
+                snprintf(_command, sizeof(_command), "AT+CIPSHUT");
+                break;
+            case OPEN_ATTACH:
+                snprintf(_command, sizeof(_command), "AT+CGATT=1");
+                break;
+            case OPEN_APN:
+                snprintf(_command, sizeof(_command), "AT+CSTT=\"%s\",\"%s\",\"%s\"", _config.apn,
+                         _config.username, _config.password);
+                break;
+            case OPEN_ACTIVATE:
+                snprintf(_command, sizeof(_command), "AT+CIICR");
+                _timeout_ms = _config.network_timeout_ms;
+                break;
+            case OPEN_ADDRESS:
+                snprintf(_command, sizeof(_command), "AT+CIFSR");
+                break;
+            default:
+                snprintf(_command, sizeof(_command), "AT+CIPSTART=\"UDP\",\"%s\",%u", _config.host,
+                         (unsigned)_config.port);
+                _timeout_ms = _config.network_timeout_ms;
+                break;
+        }
+    }
+
+    _line_length = 0;
+    _port.write((const uint8_t*)_command, strlen(_command));
+    _port.write((const uint8_t*)"\r\n", 2);
+    _in_flight = true;
+    _command_ms = now_ms;
+    return true;
+}
+
+void GprsLink::receive(uint32_t now_ms) {
+    uint8_t buffer[64];
+    size_t received;
+    while ((received = _port.read(buffer, sizeof(buffer))) > 0) {
+        for (size_t i = 0; i < received; i++) {
+            char c = (char)buffer[i];
+            if (c == '\n') {
+                _line[_line_length] = '\0';
+                if (_line_length > 0) {
+                    handleLine(_line, now_ms);
+                }
+                _line_length = 0;
+            } else if (c != '\r' && _line_length < GPRS_LINE_MAX - 1) {
+                _line[_line_length++] = c;
+            }
+
+            // The send prompt ("> ") has no line ending
+            if (_in_flight && _state == GPRS_LINK_SENDING && _step == SEND_PROMPT &&
+                _line_length > 0 && _line[0] == '>') {
+                _line_length = 0;
+                _port.write(_payload, _payload_length);
+                _step = SEND_RESULT;
+                _command_ms = now_ms;
+            }
+        }
+    }
+}
+
+void GprsLink::handleLine(const char* line, uint32_t now_ms) {
+    if (strcmp(line, "CLOSED") == 0 || strncmp(line, "+PDP: DEACT", 11) == 0) {
+        if (_state == GPRS_LINK_READY || _state == GPRS_LINK_SENDING) {
+            if (_state == GPRS_LINK_SENDING) {
+                _send_status = GPRS_SEND_FAILED;
+                _stats.send_failures++;
+            }
+            _stats.drops++;
+            if (_in_flight) {
+                _in_flight = false;
+                _arbiter.release(MODEM_USER_GPRS);
+            }
+            _state = GPRS_LINK_DOWN;
+            _retry_at_ms = now_ms;
+            return;
+        }
+    }
+    if (!_in_flight) {
+        return;
+    }
+
+    if (strcmp(line, "ERROR") == 0 || strncmp(line, "+CME ERROR", 10) == 0 ||
+        strcmp(line, "CONNECT FAIL") == 0 || strcmp(line, "SEND FAIL") == 0) {
+        finishCommand(false, now_ms);
+        return;
+    }
+
+    bool done = false;
+    if (_state == GPRS_LINK_CLOSING) {
+        done = strcmp(line, "SHUT OK") == 0;
+    } else if (_state == GPRS_LINK_SENDING) {
+        done = _step == SEND_RESULT && strcmp(line, "SEND OK") == 0;
+    } else if (_step == OPEN_SHUT) {
+        done = strcmp(line, "SHUT OK") == 0;
+    } else if (_step == OPEN_ADDRESS) {
+        done = isAddressLine(line);
+    } else if (_step == OPEN_CONNECT) {
+        done = strcmp(line, "CONNECT OK") == 0 || strcmp(line, "ALREADY CONNECT") == 0;
+    } else {
+        done = strcmp(line, "OK") == 0;
+    }
+    if (done) {
+        finishCommand(true, now_ms);
+    }
+}
+
+void GprsLink::finishCommand(bool success, uint32_t now_ms) {
+    _in_flight = false;
+    _arbiter.release(MODEM_USER_GPRS);
+
+    if (_state == GPRS_LINK_CLOSING) {
+        _state = GPRS_LINK_DOWN;
+        return;
+    }
+
+    if (_state == GPRS_LINK_SENDING) {
+        if (!success) {
+            // A socket that refuses a datagram is not trusted again
+            _send_status = GPRS_SEND_FAILED;
+            _stats.send_failures++;
+            _stats.drops++;
+            _state = GPRS_LINK_DOWN;
+            _retry_at_ms = now_ms;
+            return;
+        }
+        uint32_t elapsed = now_ms - _started_ms;
+        _latency_ms = _latency_ms == 0 ? elapsed
+                                       : _latency_ms + ((int32_t)(elapsed - _latency_ms)) / GPRS_LATENCY_WEIGHT;
+        _send_status = GPRS_SEND_DONE;
+        _stats.sends++;
+        _stats.payload_bytes += (uint32_t)_payload_length;
+        _stats.last_send_ms = elapsed;
+        _state = GPRS_LINK_READY;
+        return;
+    }
+
+    if (!success) {
+        fail(now_ms);
+        return;
+    }
+    if (++_step == OPEN_STEPS) {
+        _state = GPRS_LINK_READY;
+        _send_status = GPRS_SEND_IDLE;
+        _backoff_ms = _config.retry_min_ms;
+        _stats.opens++;
+        _stats.last_open_ms = now_ms - _started_ms;
+    }
+}
+
+void GprsLink::fail(uint32_t now_ms) {
+    _stats.open_failures++;
+    _state = GPRS_LINK_DOWN;
+    _retry_at_ms = now_ms + _backoff_ms;
+    _backoff_ms = _backoff_ms * 2 < _config.retry_max_ms ? _backoff_ms * 2 : _config.retry_max_ms;
+}
+
+const char* gprsLinkStateName(GprsLinkState_t state) {
+    switch (state) {
+        case GPRS_LINK_OPENING: return "opening";
+        case GPRS_LINK_READY:   return "ready";
+        case GPRS_LINK_SENDING: return "sending";
+        case GPRS_LINK_CLOSING: return "closing";
+        default:                return "down";
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * ============================================================================
+ * BINSAI GPRS Link
+ * Non-blocking SIM800L data bearer: PDP context and one UDP socket
+ * ============================================================================
+ *
+ * BRING-UP (one AT exchange per step, modem released in between so SMS
+ * alerts can go out while the PDP context is being activated):
+ *   AT+CIPSHUT                          SHUT OK   (clear a stale context)
+ *   AT+CGATT=1                          OK        (attach to GPRS)
+ *   AT+CSTT="<apn>","<user>","<pass>"   OK
+ *   AT+CIICR                            OK        (activate PDP context)
+ *   AT+CIFSR                            <local IP>
+ *   AT+CIPSTART="UDP","<host>",<port>   OK, CONNECT OK
+ *
+ * SEND: AT+CIPSEND=<n>, wait for the '>' prompt, write n bytes, wait for
+ * SEND OK. Each send() is one UDP datagram.
+ *
+ * "CLOSED" or "+PDP: DEACT" while up drops the link; so does a failed
+ * send. open() keeps retrying with exponential backoff until close().
+ *
+ * Every exchange holds the ModemArbiter as MODEM_USER_GPRS, and the port is
+ * only read while no other user holds the modem. All timing comes from the
+ * now_ms passed in, so the link runs against FakeSim800 on the host.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_GPRS_LINK_H
+#define BINSAI_GPRS_LINK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ModemArbiter.h"
+
+#define GPRS_MAX_PAYLOAD            512           // Bytes per CIPSEND (SIM800L allows 1460)
+#define GPRS_LINE_MAX               96
+#define GPRS_COMMAND_MAX            128
+
+/**
+ * Modem UART (HardwareSerial on the device, FakeSim800 on host)
+ */
+class ModemPort {
+public:
+    virtual ~ModemPort() {}
+
+    /**
+     * @return Bytes accepted
+     */
+    virtual size_t write(const uint8_t* data, size_t length) = 0;
+
+    /**
+     * Non-blocking read
+     * @return Bytes copied, 0 if nothing is pending
+     */
+    virtual size_t read(uint8_t* buffer, size_t capacity) = 0;
+};
+
+typedef enum {
+    GPRS_LINK_DOWN = 0,             // Closed, or waiting for the next attempt
+    GPRS_LINK_OPENING,
+    GPRS_LINK_READY,                // Socket open, no send in progress
+    GPRS_LINK_SENDING,
+    GPRS_LINK_CLOSING
+} GprsLinkState_t;
+
+typedef enum {
+    GPRS_SEND_IDLE = 0,             // Nothing sent since open
+    GPRS_SEND_BUSY,
+    GPRS_SEND_DONE,                 // Last send() got SEND OK
+    GPRS_SEND_FAILED
+} GprsSendStatus_t;
+
+/**
+ * Strings are not copied and must outlive the link
+ */
+typedef struct {
+    const char* apn;
+    const char* username;           // "" for none
+    const char* password;           // "" for none
+    const char* host;
+    uint16_t port;
+    uint32_t command_timeout_ms;    // Local commands (attach, APN, IP, send)
+    uint32_t network_timeout_ms;    // AT+CIICR / AT+CIPSTART
+    uint32_t retry_min_ms;
+    uint32_t retry_max_ms;
+} GprsLinkConfig_t;
+
+typedef struct {
+    uint32_t opens;
+    uint32_t open_failures;
+    uint32_t drops;                 // Lost while up (CLOSED, PDP deact, failed send)
+    uint32_t sends;
+    uint32_t send_failures;
+    uint32_t payload_bytes;
+    uint32_t last_open_ms;          // Duration of the last bring-up
+    uint32_t last_send_ms;          // AT+CIPSEND -> SEND OK
+} GprsLinkStats_t;
+
+/**
+ * Defaults: 10 s commands, 45 s network steps, retry 5 s .. 5 min
+ */
+void gprsLinkDefaults(GprsLinkConfig_t* config);
+
+class GprsLink {
+public:
+    GprsLink(ModemPort& port, ModemArbiter& arbiter, const GprsLinkConfig_t& config);
+
+    /**
+     * Bring the link up and keep it up (retried until close())
+     */
+    void open(uint32_t now_ms);
+
+    /**
+     * Shut the socket and PDP context once the current exchange ends
+     */
+    void close();
+
+    /**
+     * Start one datagram (copied)
+     * @return false if not ready or length exceeds GPRS_MAX_PAYLOAD
+     */
+    bool send(const uint8_t* data, size_t length, uint32_t now_ms);
+
+    void loop(uint32_t now_ms);
+
+    GprsLinkState_t state() const { return _state; }
+    bool ready() const { return _state == GPRS_LINK_READY; }
+    GprsSendStatus_t sendStatus() const { return _send_status; }
+
+    /**
+     * Smoothed send latency, 0 until the first SEND OK
+     */
+    uint32_t latencyMs() const { return _latency_ms; }
+
+    const GprsLinkStats_t& stats() const { return _stats; }
+
+private:
+    bool startCommand(uint32_t now_ms);
+    void finishCommand(bool success, uint32_t now_ms);
+    void handleLine(const char* line, uint32_t now_ms);
+    void receive(uint32_t now_ms);
+    void fail(uint32_t now_ms);
+
+    ModemPort& _port;
+    ModemArbiter& _arbiter;
+    GprsLinkConfig_t _config;
+    GprsLinkState_t _state;
+    GprsSendStatus_t _send_status;
+    GprsLinkStats_t _stats;
+
+    bool _want_open;
+    uint8_t _step;                  // Bring-up step, or send phase
+    bool _in_flight;                // Command written, reply pending
+    uint32_t _command_ms;
+    uint32_t _timeout_ms;
+    uint32_t _started_ms;           // Bring-up or send start
+    uint32_t _retry_at_ms;
+    uint32_t _backoff_ms;
+    uint32_t _latency_ms;
+
+    char _command[GPRS_COMMAND_MAX];
+    char _line[GPRS_LINE_MAX];
+    size_t _line_length;
+    uint8_t _payload[GPRS_MAX_PAYLOAD];
+    size_t _payload_length;
+};
+
+const char* gprsLinkStateName(GprsLinkState_t state);
+
+#endif  // BINSAI_GPRS_LINK_H
@@ -0,0 +1,232 @@
+/**
+ * BINSAI GPRS Uplink - bearer selection and batched frame queue
+ */
+
+#include "GprsUplink.h"
+#include <string.h>
+
+#define GPRS_DEFAULT_OPEN_MS        15000         // Bring-up estimate before the first one
+#define GPRS_DEFAULT_SEND_MS        2000          // CIPSEND estimate before the first one
+
+int bearerSelect(const BearerStatus_t* bearers, uint8_t count, uint32_t max_latency_ms) {
+    int best = -1;
+    for (uint8_t i = 0; i < count; i++) {
+        const BearerStatus_t& candidate = bearers[i];
+        if (!candidate.available) {
+            continue;
+        }
+        if (best < 0) {
+            best = i;
+            continue;
+        }
+
+        const BearerStatus_t& current = bearers[best];
+        bool meets = candidate.latency_ms <= max_latency_ms;
+        bool current_meets = current.latency_ms <= max_latency_ms;
+        if (meets != current_meets) {
+            if (meets) best = i;
+        } else if (meets) {
+            // Both fast enough: cheapest, then fastest
+            if (candidate.cost_per_kb < current.cost_per_kb ||
+                (candidate.cost_per_kb == current.cost_per_kb && candidate.latency_ms < current.latency_ms)) {
+                best = i;
+            }
+        } else if (candidate.latency_ms < current.latency_ms ||
+                   (candidate.latency_ms == current.latency_ms && candidate.cost_per_kb < current.cost_per_kb)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+const char* bearerName(int bearer) {
+    switch (bearer) {
+        case BEARER_WIFI:   return "wifi";
+        case BEARER_GPRS:   return "gprs";
+        default:            return "none";
+    }
+}
+
+void gprsUplinkDefaults(GprsUplinkPolicy_t* policy) {
+    policy->sample_interval_ms = 60000;
+    policy->batch_frames = GPRS_BATCH_MAX;
+    policy->max_delay_ms = 600000;
+    policy->urgent_delay_ms = 0;
+    policy->daily_budget_bytes = 2097152;
+    policy->idle_close_ms = 900000;
+}
+
+void gprsBudgetRestore(GprsBudget_t* budget, uint32_t mono_s) {
+    if (budget->magic != GPRS_BUDGET_MAGIC) {
+        memset(budget, 0, sizeof(*budget));
+        budget->magic = GPRS_BUDGET_MAGIC;
+        budget->start_s = mono_s;
+    } else if (budget->start_s > mono_s) {
+        budget->start_s = mono_s;
+    }
+}
+
+void gprsBudgetRoll(GprsBudget_t* budget, uint32_t unix_s, uint32_t mono_s) {
+    if (unix_s != 0) {
+        uint32_t day = unix_s / GPRS_BUDGET_WINDOW_S;
+        if (budget->day != 0 && budget->day != day) {
+            budget->used_bytes = 0;
+        }
+        budget->day = day;
+        return;
+    }
+    if (budget->day == 0 && mono_s - budget->start_s >= GPRS_BUDGET_WINDOW_S) {
+        budget->start_s = mono_s;
+        budget->used_bytes = 0;
+    }
+}
+
+GprsTelemetryTransport::GprsTelemetryTransport(ModemPort& port, ModemArbiter& arbiter,
+                                               const GprsLinkConfig_t& link, const GprsUplinkPolicy_t& policy)
+    : _link(port, arbiter, link), _policy(policy), _active(false), _last_critical(false), _sampled(false),
+      _last_sample_ms(0), _last_traffic_ms(0), _budget(&_own_budget), _in_flight(0), _head(0), _count(0) {
+    if (_policy.batch_frames == 0 || _policy.batch_frames > GPRS_BATCH_MAX) {
+        _policy.batch_frames = GPRS_BATCH_MAX;
+    }
+    memset(&_stats, 0, sizeof(_stats));
+    _own_budget.magic = 0;
+    gprsBudgetRestore(&_own_budget, 0);
+}
+
+bool GprsTelemetryTransport::connected() const {
+    return _link.state() == GPRS_LINK_READY || _link.state() == GPRS_LINK_SENDING;
+}
+
+void GprsTelemetryTransport::setActive(bool active) {
+    _active = active;
+}
+
+void GprsTelemetryTransport::attachBudget(GprsBudget_t* budget, uint32_t mono_s) {
+    gprsBudgetRestore(budget, mono_s);
+    _budget = budget;
+    _stats.budget_used_bytes = _budget->used_bytes;
+}
+
+void GprsTelemetryTransport::setBudgetClock(uint32_t unix_s, uint32_t mono_s) {
+    gprsBudgetRoll(_budget, unix_s, mono_s);
+    _stats.budget_used_bytes = _budget->used_bytes;
+}
+
+uint32_t GprsTelemetryTransport::expectedLatencyMs() const {
+    uint32_t send_ms = _link.latencyMs() ? _link.latencyMs() : GPRS_DEFAULT_SEND_MS;
+    if (connected()) {
+        return send_ms;
+    }
+    uint32_t open_ms = _link.stats().opens ? _link.stats().last_open_ms : GPRS_DEFAULT_OPEN_MS;
+    return open_ms + send_ms;
+}
+
+bool GprsTelemetryTransport::publishSample(const SensorData_t& data, const TelemetryFrameMeta_t& meta,
+                                           uint32_t now_ms) {
+    if (!_active) {
+        return false;
+    }
+
+    bool critical = (meta.flags & TELEMETRY_FLAG_CRITICAL) != 0;
+    bool urgent = critical && !_last_critical;
+    _last_critical = critical;
+    if (!urgent && _sampled && now_ms - _last_sample_ms < _policy.sample_interval_ms) {
+        return false;
+    }
+    _sampled = true;
+    _last_sample_ms = now_ms;
+
+    if (!urgent && _policy.daily_budget_bytes > 0 && _budget->used_bytes >= _policy.daily_budget_bytes) {
+        _stats.frames_dropped_budget++;
+        return false;
+    }
+
+    if (_count == GPRS_QUEUE_FRAMES) {
+        _stats.frames_dropped_full++;
+        if (_in_flight > 0) {
+            return false;           // Oldest frames are in the datagram being sent
+        }
+        _head = (_head + 1) % GPRS_QUEUE_FRAMES;
+        _count--;
+    }
+
+    QueuedFrame_t& slot = entry(_count);
+    if (telemetryEncode(data, meta, slot.frame, sizeof(slot.frame)) != TELEMETRY_FRAME_SIZE) {
+        return false;
+    }
+    slot.queued_ms = now_ms;
+    slot.urgent = urgent;
+    _count++;
+    _stats.frames_queued++;
+    if (urgent) {
+        _stats.frames_urgent++;
+    }
+    return true;
+}
+
+void GprsTelemetryTransport::loop(uint32_t now_ms) {
+    _link.loop(now_ms);
+    if (_in_flight > 0 && _link.sendStatus() != GPRS_SEND_BUSY) {
+        completeBatch(now_ms);
+    }
+
+    if (_count > 0) {
+        _link.open(now_ms);
+        if (_in_flight == 0 && _link.ready() && flushDue(now_ms)) {
+            sendBatch(now_ms);
+        }
+    } else if (_link.state() != GPRS_LINK_DOWN || !_active) {
+        if (!_active || (_policy.idle_close_ms > 0 && now_ms - _last_traffic_ms >= _policy.idle_close_ms)) {
+            _link.close();
+        }
+    }
+}
+
+bool GprsTelemetryTransport::flushDue(uint32_t now_ms) {
+    if (!_active || _count >= _policy.batch_frames) {
+        return true;
+    }
+    if (now_ms - entry(0).queued_ms >= _policy.max_delay_ms) {
+        return true;
+    }
+    for (size_t i = 0; i < _count; i++) {
+        if (entry(i).urgent && now_ms - entry(i).queued_ms >= _policy.urgent_delay_ms) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GprsTelemetryTransport::sendBatch(uint32_t now_ms) {
+    uint8_t frames = (uint8_t)(_count < _policy.batch_frames ? _count : _policy.batch_frames);
+    for (uint8_t i = 0; i < frames; i++) {
+        memcpy(_datagram + i * TELEMETRY_FRAME_SIZE, entry(i).frame, TELEMETRY_FRAME_SIZE);
+    }
+    if (_link.send(_datagram, frames * TELEMETRY_FRAME_SIZE, now_ms)) {
+        _in_flight = frames;
+    }
+}
+
+void GprsTelemetryTransport::completeBatch(uint32_t now_ms) {
+    uint8_t frames = _in_flight;
+    _in_flight = 0;
+    if (_link.sendStatus() != GPRS_SEND_DONE) {
+        return;                     // Frames stay queued for the next datagram
+    }
+
+    for (uint8_t i = 0; i < frames; i++) {
+        uint32_t delay = now_ms - entry(0).queued_ms;
+        if (delay > _stats.max_delay_ms) {
+            _stats.max_delay_ms = delay;
+        }
+        _head = (_head + 1) % GPRS_QUEUE_FRAMES;
+        _count--;
+    }
+    uint32_t wire = frames * TELEMETRY_FRAME_SIZE + GPRS_DATAGRAM_OVERHEAD;
+    _stats.frames_sent += frames;
+    _stats.datagrams++;
+    _stats.wire_bytes += wire;
+    _budget->used_bytes += wire;
+    _stats.budget_used_bytes = _budget->used_bytes;
+    _last_traffic_ms = now_ms;
+}
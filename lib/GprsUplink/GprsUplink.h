@@ -0,0 +1,188 @@
+/**
+ * ============================================================================
+ * BINSAI GPRS Uplink
+ * Bearer selection and batched telemetry over the SIM800L when WiFi is down
+ * ============================================================================
+ *
+ * BEARER POLICY: bearerSelect() picks the cheapest available bearer whose
+ * expected latency meets the caller's bound, else the fastest available
+ * one. Firmware feeds it WiFi (free) and GPRS (metered, slower); the GPRS
+ * transport is active only while it is the selected bearer.
+ *
+ * BATCHING: GPRS is billed per byte and each datagram costs a CIPSEND
+ * exchange, so samples are decimated to sample_interval_ms and packed as
+ * whole TelemetryFrames, up to GPRS_BATCH_MAX per UDP datagram, to the
+ * fleet ingest server (which splits multi-frame datagrams). A batch is
+ * sent when it is full, when its oldest frame has waited max_delay_ms, or
+ * once an urgent frame (first sample of a critical condition) has waited
+ * urgent_delay_ms. Over the daily byte budget only urgent frames are kept.
+ * The budget lives in a GprsBudget_t the firmware keeps in RTC memory, so
+ * a crash-looping unit cannot start a fresh day on every boot; its window
+ * is the UTC calendar day once the time service is set, 24 h on the
+ * monotonic RTC clock (which keeps counting through resets) before that.
+ *
+ * Frames stay queued until SEND OK, so a dropped link resends them after
+ * reconnecting; SEND OK is the last confirmation (UDP has no ack). The
+ * PDP context is opened when the first frame is queued (bring-up overlaps
+ * the batching wait) and shut after idle_close_ms without traffic.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_GPRS_UPLINK_H
+#define BINSAI_GPRS_UPLINK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "GprsLink.h"
+#include "TelemetryTransport.h"
+
+#define GPRS_BATCH_MAX              (GPRS_MAX_PAYLOAD / TELEMETRY_FRAME_SIZE)
+#define GPRS_QUEUE_FRAMES           32            // Held while the link is down (2 KB)
+#define GPRS_DATAGRAM_OVERHEAD      28            // IPv4 + UDP headers, billed per datagram
+#define GPRS_BUDGET_WINDOW_S        86400UL
+#define GPRS_BUDGET_MAGIC           0x54474442UL  // "BDGT" little-endian
+
+typedef enum {
+    BEARER_WIFI = 0,
+    BEARER_GPRS,
+    BEARER_COUNT
+} Bearer_t;
+
+typedef struct {
+    bool available;
+    uint16_t cost_per_kb;           // Relative tariff, 0 = free
+    uint32_t latency_ms;            // Expected time to deliver a sample
+} BearerStatus_t;
+
+/**
+ * @return Index of the chosen bearer, -1 if none is available
+ */
+int bearerSelect(const BearerStatus_t* bearers, uint8_t count, uint32_t max_latency_ms);
+
+const char* bearerName(int bearer);
+
+typedef struct {
+    uint32_t sample_interval_ms;    // Normal samples queued at most this often
+    uint8_t batch_frames;           // Frames per datagram (1..GPRS_BATCH_MAX)
+    uint32_t max_delay_ms;          // Longest wait of a normal frame
+    uint32_t urgent_delay_ms;       // Longest wait of an urgent frame
+    uint32_t daily_budget_bytes;    // Wire bytes per budget window, 0 = unlimited
+    uint32_t idle_close_ms;         // Shut the PDP context when idle, 0 = keep it up
+} GprsUplinkPolicy_t;
+
+typedef struct {
+    uint32_t frames_queued;
+    uint32_t frames_urgent;
+    uint32_t frames_sent;           // Confirmed by SEND OK
+    uint32_t frames_dropped_full;   // Evicted from a full queue
+    uint32_t frames_dropped_budget; // Refused over the daily budget
+    uint32_t datagrams;
+    uint32_t wire_bytes;            // Payload + GPRS_DATAGRAM_OVERHEAD
+    uint32_t budget_used_bytes;     // Current budget window
+    uint32_t max_delay_ms;          // Queue -> SEND OK, worst frame
+} GprsUplinkStats_t;
+
+/**
+ * Daily byte budget (RTC-retained in firmware)
+ */
+typedef struct {
+    uint32_t magic;                 // GPRS_BUDGET_MAGIC
+    uint32_t day;                   // UTC day (unix / 86400), 0 until the clock is set
+    uint32_t start_s;               // Window start on the monotonic clock while day is 0
+    uint32_t used_bytes;
+} GprsBudget_t;
+
+/**
+ * Keep a retained budget, or start an empty one if it is corrupt
+ * (power loss); a monotonic clock that restarted rebases the window
+ */
+void gprsBudgetRestore(GprsBudget_t* budget, uint32_t mono_s);
+
+/**
+ * Start a new window when the UTC day changes (unix_s != 0) or, before
+ * the clock is set, GPRS_BUDGET_WINDOW_S after the last one. The first
+ * set clock turns the running window into today's, bytes included
+ */
+void gprsBudgetRoll(GprsBudget_t* budget, uint32_t unix_s, uint32_t mono_s);
+
+/**
+ * Defaults: 1 sample/min, 8 frames/datagram, 10 min max delay, urgent
+ * frames at once, 2 MB/day, close after 15 min idle
+ */
+void gprsUplinkDefaults(GprsUplinkPolicy_t* policy);
+
+class GprsTelemetryTransport : public TelemetryTransport {
+public:
+    GprsTelemetryTransport(ModemPort& port, ModemArbiter& arbiter, const GprsLinkConfig_t& link,
+                           const GprsUplinkPolicy_t& policy);
+
+    const char* name() const override { return "GPRS"; }
+    void loop(uint32_t now_ms) override;
+    bool connected() const override;
+
+    /**
+     * Queue the sample if due (see sample_interval_ms / urgent frames)
+     * @return false if inactive, decimated or refused
+     */
+    bool publishSample(const SensorData_t& data, const TelemetryFrameMeta_t& meta,
+                       uint32_t now_ms) override;
+
+    /**
+     * Follow the bearer selection; queued frames are still drained over
+     * GPRS after deactivation, then the link is shut
+     */
+    void setActive(bool active);
+    bool active() const { return _active; }
+
+    /**
+     * Account against a retained budget instead of the built-in one
+     */
+    void attachBudget(GprsBudget_t* budget, uint32_t mono_s);
+
+    /**
+     * Current time for the budget window (call before publishSample())
+     * @param unix_s UTC seconds, 0 while the clock is not set
+     * @param mono_s Monotonic seconds that keep counting through resets
+     */
+    void setBudgetClock(uint32_t unix_s, uint32_t mono_s);
+
+    /**
+     * Bring-up (if down) plus send latency, for bearerSelect()
+     */
+    uint32_t expectedLatencyMs() const;
+
+    size_t queued() const { return _count; }
+    const GprsUplinkStats_t& stats() const { return _stats; }
+    GprsLink& link() { return _link; }
+
+private:
+    typedef struct {
+        uint8_t frame[TELEMETRY_FRAME_SIZE];
+        uint32_t queued_ms;
+        bool urgent;
+    } QueuedFrame_t;
+
+    QueuedFrame_t& entry(size_t index) { return _queue[(_head + index) % GPRS_QUEUE_FRAMES]; }
+    bool flushDue(uint32_t now_ms);
+    void sendBatch(uint32_t now_ms);
+    void completeBatch(uint32_t now_ms);
+
+    GprsLink _link;
+    GprsUplinkPolicy_t _policy;
+    GprsUplinkStats_t _stats;
+    bool _active;
+    bool _last_critical;
+    bool _sampled;
+    uint32_t _last_sample_ms;
+    uint32_t _last_traffic_ms;
+    GprsBudget_t _own_budget;
+    GprsBudget_t* _budget;
+    uint8_t _in_flight;             // Frames in the datagram being sent
+
+    QueuedFrame_t _queue[GPRS_QUEUE_FRAMES];
+    size_t _head;
+    size_t _count;
+    uint8_t _datagram[GPRS_MAX_PAYLOAD];
+};
+
+#endif  // BINSAI_GPRS_UPLINK_H
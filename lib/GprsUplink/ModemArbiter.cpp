@@ -0,0 +1,70 @@
+/**
+ * BINSAI Modem Arbiter - priority lock with lease timeout
+ */
+
+#include "ModemArbiter.h"
+#include <string.h>
+
+ModemArbiter::ModemArbiter(uint32_t lease_ms)
+    : _lease_ms(lease_ms), _owner(MODEM_USER_NONE), _acquired_ms(0) {
+    memset(_waiting, 0, sizeof(_waiting));
+    memset(_waiting_ms, 0, sizeof(_waiting_ms));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+bool ModemArbiter::tryAcquire(ModemUser_t user, uint32_t now_ms) {
+    if (user <= MODEM_USER_NONE || user >= MODEM_USER_COUNT) {
+        return false;
+    }
+    if (_owner == user) {
+        return true;
+    }
+
+    if (_owner != MODEM_USER_NONE && now_ms - _acquired_ms >= _lease_ms) {
+        _owner = MODEM_USER_NONE;
+        _stats.evictions++;
+    }
+
+    if (_owner != MODEM_USER_NONE || yieldRequested(user, now_ms)) {
+        _waiting[user] = true;
+        _waiting_ms[user] = now_ms;
+        _stats.contended++;
+        return false;
+    }
+
+    _waiting[user] = false;
+    _owner = user;
+    _acquired_ms = now_ms;
+    _stats.grants++;
+    return true;
+}
+
+void ModemArbiter::release(ModemUser_t user) {
+    if (_owner == user) {
+        _owner = MODEM_USER_NONE;
+    }
+}
+
+void ModemArbiter::cancel(ModemUser_t user) {
+    if (user > MODEM_USER_NONE && user < MODEM_USER_COUNT) {
+        _waiting[user] = false;
+    }
+}
+
+bool ModemArbiter::yieldRequested(ModemUser_t user, uint32_t now_ms) const {
+    for (int other = user + 1; other < MODEM_USER_COUNT; other++) {
+        if (_waiting[other] && now_ms - _waiting_ms[other] < _lease_ms) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* modemUserName(ModemUser_t user) {
+    switch (user) {
+        case MODEM_USER_GPRS:   return "gprs";
+        case MODEM_USER_TIME:   return "time";
+        case MODEM_USER_SMS:    return "sms";
+        default:                return "none";
+    }
+}
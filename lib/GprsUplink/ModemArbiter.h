@@ -0,0 +1,84 @@
+/**
+ * ============================================================================
+ * BINSAI Modem Arbiter
+ * Shares the SIM800L UART between SMS, clock polls and the GPRS bearer
+ * ============================================================================
+ *
+ * The modem answers one AT command at a time, so a command and its reply
+ * (or a CIPSEND prompt + payload + SEND OK) must not be interleaved with
+ * another user's command. Each user holds the modem for one exchange:
+ *
+ * - tryAcquire() succeeds when the modem is free (or already held by the
+ *   caller) and no higher-priority user is waiting
+ * - A user that could not get the modem stays registered as waiting, so
+ *   lower-priority users stop starting new exchanges until it is served
+ *   (or stops retrying for lease_ms)
+ * - A holder that does not release within lease_ms (hung exchange, lost
+ *   reply) is evicted on the next tryAcquire() by another user
+ *
+ * Priorities: SMS alerts > clock poll > GPRS data.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_MODEM_ARBITER_H
+#define BINSAI_MODEM_ARBITER_H
+
+#include <stdint.h>
+
+#define MODEM_DEFAULT_LEASE_MS      60000         // Longest single exchange (SMS send, PDP activation)
+
+typedef enum {
+    MODEM_USER_NONE = 0,
+    MODEM_USER_GPRS,                // Lowest priority
+    MODEM_USER_TIME,
+    MODEM_USER_SMS,
+    MODEM_USER_COUNT
+} ModemUser_t;
+
+typedef struct {
+    uint32_t grants;
+    uint32_t contended;             // tryAcquire() refused
+    uint32_t evictions;             // Holders dropped after their lease
+} ModemArbiterStats_t;
+
+class ModemArbiter {
+public:
+    explicit ModemArbiter(uint32_t lease_ms = MODEM_DEFAULT_LEASE_MS);
+
+    /**
+     * Take the modem for one exchange
+     * @return false if another user holds it or a higher-priority user waits
+     */
+    bool tryAcquire(ModemUser_t user, uint32_t now_ms);
+
+    /**
+     * End an exchange (no-op unless user holds the modem)
+     */
+    void release(ModemUser_t user);
+
+    /**
+     * Stop waiting without acquiring (e.g. the caller gave up)
+     */
+    void cancel(ModemUser_t user);
+
+    /**
+     * True when a higher-priority user is waiting; the holder should finish
+     * its exchange and not start another
+     */
+    bool yieldRequested(ModemUser_t user, uint32_t now_ms) const;
+
+    ModemUser_t owner() const { return _owner; }
+    const ModemArbiterStats_t& stats() const { return _stats; }
+
+private:
+    uint32_t _lease_ms;
+    ModemUser_t _owner;
+    uint32_t _acquired_ms;
+    bool _waiting[MODEM_USER_COUNT];
+    uint32_t _waiting_ms[MODEM_USER_COUNT];     // Last refused tryAcquire()
+    ModemArbiterStats_t _stats;
+};
+
+const char* modemUserName(ModemUser_t user);
+
+#endif  // BINSAI_MODEM_ARBITER_H
@@ -0,0 +1,270 @@
+/**
+ * BINSAI Health Monitor - reset classification, run-time accounting and
+ * boot report encoding
+ */
+
+#include "HealthMonitor.h"
+#include "TelemetryFrame.h"
+#include <string.h>
+
+static const char* const RESET_REASON_NAMES[HEALTH_RESET_COUNT] = {
+    "unknown", "power_on", "external", "software", "panic", "int_wdt",
+    "task_wdt", "other_wdt", "deep_sleep", "brownout", "sdio"
+};
+
+static const char* const PHASE_NAMES[HEALTH_PHASE_COUNT] = {
+    "boot", "setup", "transports", "sensors", "logging", "fleet",
+    "notify", "sms", "display", "console", "firmware", "idle"
+};
+
+static const char* const FAULT_NAMES[] = { "none", "panic", "task_wdt" };
+
+static void putU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void putU32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t getU16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool healthResetIsFailure(HealthResetReason_t reason) {
+    switch (reason) {
+        case HEALTH_RESET_PANIC:
+        case HEALTH_RESET_INT_WDT:
+        case HEALTH_RESET_TASK_WDT:
+        case HEALTH_RESET_OTHER_WDT:
+        case HEALTH_RESET_BROWNOUT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+const char* healthResetReasonName(uint8_t reason) {
+    return reason < HEALTH_RESET_COUNT ? RESET_REASON_NAMES[reason] : "?";
+}
+
+const char* healthPhaseName(uint8_t phase) {
+    return phase < HEALTH_PHASE_COUNT ? PHASE_NAMES[phase] : "?";
+}
+
+HealthMonitor::HealthMonitor(HealthStore& store, HealthRtcRecord_t& rtc, uint32_t persist_interval_s)
+    : _store(store), _rtc(rtc), _persist_interval_s(persist_interval_s ? persist_interval_s : 1),
+      _boot_ms(0), _ready(false), _report_pending(false) {
+    memset(&_stats, 0, sizeof(_stats));
+    memset(&_report, 0, sizeof(_report));
+}
+
+void HealthMonitor::onBoot(HealthResetReason_t reason, uint32_t now_ms) {
+    if (!_store.loadStats(&_stats) || _stats.magic != HEALTH_STATS_MAGIC) {
+        memset(&_stats, 0, sizeof(_stats));
+        _stats.magic = HEALTH_STATS_MAGIC;
+    }
+
+    // Power loss leaves RTC memory random; only trust fields in range
+    bool previous = _rtc.magic == HEALTH_RTC_MAGIC && _rtc.phase < HEALTH_PHASE_COUNT &&
+                    _rtc.fault <= HEALTH_FAULT_TASK_WDT &&
+                    _rtc.backtrace_depth <= HEALTH_BACKTRACE_DEPTH;
+
+    // The task watchdog ends in a panic; its hook marks the record first
+    if (previous && reason == HEALTH_RESET_PANIC && _rtc.fault == HEALTH_FAULT_TASK_WDT) {
+        reason = HEALTH_RESET_TASK_WDT;
+    }
+
+    memset(&_report, 0, sizeof(_report));
+    _report.reset_reason = (uint8_t)reason;
+    if (previous) {
+        _stats.uptime_s += _rtc.unsaved_s;
+        _report.flags |= HEALTH_REPORT_FLAG_PREVIOUS;
+        _report.phase = _rtc.phase;
+        _report.fault = _rtc.fault;
+        _report.previous_uptime_s = _rtc.uptime_s;
+        _report.backtrace_depth = _rtc.backtrace_depth;
+        memcpy(_report.backtrace, _rtc.backtrace, _rtc.backtrace_depth * sizeof(uint32_t));
+    }
+
+    _stats.boots++;
+    if (healthResetIsFailure(reason)) {
+        _stats.failures++;
+        if (reason == HEALTH_RESET_BROWNOUT) {
+            _stats.brownouts++;
+        } else if (reason == HEALTH_RESET_PANIC) {
+            _stats.panics++;
+        } else {
+            _stats.watchdog_resets++;
+        }
+    }
+    _store.saveStats(_stats);
+
+    memset(&_rtc, 0, sizeof(_rtc));
+    _rtc.magic = HEALTH_RTC_MAGIC;
+    _rtc.phase = HEALTH_PHASE_SETUP;
+    _rtc.last_ms = now_ms;
+
+    _boot_ms = now_ms;
+    _ready = false;
+    _report_pending = false;
+    fillCounters();
+}
+
+void HealthMonitor::loop(uint32_t now_ms) {
+    uint32_t elapsed = now_ms - _rtc.last_ms;
+    if (elapsed < 1000) {
+        return;
+    }
+    uint32_t seconds = elapsed / 1000;
+    _rtc.uptime_s += seconds;
+    _rtc.unsaved_s += seconds;
+    _rtc.last_ms += seconds * 1000;
+
+    if (_rtc.unsaved_s >= _persist_interval_s) {
+        // Cleared before the write: a crash during it loses run time
+        // (pessimistic MTBF) rather than counting it twice
+        _stats.uptime_s += _rtc.unsaved_s;
+        _rtc.unsaved_s = 0;
+        _store.saveStats(_stats);
+    }
+}
+
+void HealthMonitor::markReady(uint32_t now_ms) {
+    if (_ready) {
+        return;
+    }
+    _ready = true;
+
+    _stats.last_restart_ms = now_ms - _boot_ms;
+    _stats.restart_total_ms += _stats.last_restart_ms;
+    _stats.restarts_timed++;
+    _store.saveStats(_stats);
+
+    fillCounters();
+    _report_pending = true;
+}
+
+uint32_t HealthMonitor::mtbfSeconds() const {
+    if (_stats.failures == 0) {
+        return HEALTH_MTBF_NONE;
+    }
+    return (_stats.uptime_s + _rtc.unsaved_s) / _stats.failures;
+}
+
+uint32_t HealthMonitor::meanRestartMs() const {
+    return _stats.restarts_timed ? _stats.restart_total_ms / _stats.restarts_timed : 0;
+}
+
+void HealthMonitor::fillCounters() {
+    _report.boots = _stats.boots;
+    _report.failures = _stats.failures;
+    _report.brownouts = _stats.brownouts;
+    _report.watchdog_resets = _stats.watchdog_resets;
+    _report.panics = _stats.panics;
+    _report.mtbf_s = mtbfSeconds();
+    _report.restart_ms = _ready ? _stats.last_restart_ms : 0;
+}
+
+size_t healthReportEncode(const HealthReport_t& report, uint8_t* out, size_t capacity) {
+    if (capacity < HEALTH_REPORT_SIZE) {
+        return 0;
+    }
+
+    memset(out, 0, HEALTH_REPORT_SIZE);
+    putU16(out + 0, HEALTH_REPORT_MAGIC);
+    out[2] = HEALTH_REPORT_VERSION;
+    out[3] = report.reset_reason;
+    out[4] = report.phase;
+    out[5] = report.fault;
+    out[6] = report.backtrace_depth > HEALTH_BACKTRACE_DEPTH ? HEALTH_BACKTRACE_DEPTH : report.backtrace_depth;
+    out[7] = report.flags;
+    putU32(out + 8, report.previous_uptime_s);
+    putU32(out + 12, report.boots);
+    putU32(out + 16, report.failures);
+    putU32(out + 20, report.brownouts);
+    putU32(out + 24, report.watchdog_resets);
+    putU32(out + 28, report.panics);
+    putU32(out + 32, report.mtbf_s);
+    putU32(out + 36, report.restart_ms);
+    for (uint8_t i = 0; i < out[6]; i++) {
+        putU32(out + 40 + 4 * i, report.backtrace[i]);
+    }
+    putU16(out + 72, telemetryCrc16(out, HEALTH_REPORT_SIZE - 2));
+    return HEALTH_REPORT_SIZE;
+}
+
+bool healthReportDecode(const uint8_t* data, size_t length, HealthReport_t* report) {
+    if (length != HEALTH_REPORT_SIZE || getU16(data) != HEALTH_REPORT_MAGIC ||
+        data[2] != HEALTH_REPORT_VERSION || data[6] > HEALTH_BACKTRACE_DEPTH ||
+        getU16(data + 72) != telemetryCrc16(data, HEALTH_REPORT_SIZE - 2)) {
+        return false;
+    }
+
+    memset(report, 0, sizeof(*report));
+    report->reset_reason = data[3];
+    report->phase = data[4];
+    report->fault = data[5];
+    report->backtrace_depth = data[6];
+    report->flags = data[7];
+    report->previous_uptime_s = getU32(data + 8);
+    report->boots = getU32(data + 12);
+    report->failures = getU32(data + 16);
+    report->brownouts = getU32(data + 20);
+    report->watchdog_resets = getU32(data + 24);
+    report->panics = getU32(data + 28);
+    report->mtbf_s = getU32(data + 32);
+    report->restart_ms = getU32(data + 36);
+    for (uint8_t i = 0; i < report->backtrace_depth; i++) {
+        report->backtrace[i] = getU32(data + 40 + 4 * i);
+    }
+    return true;
+}
+
+static void appendHex32(TextBuffer& out, uint32_t value) {
+    static const char DIGITS[] = "0123456789abcdef";
+    char text[10] = { '0', 'x' };
+    for (uint8_t i = 0; i < 8; i++) {
+        text[2 + i] = DIGITS[(value >> (28 - 4 * i)) & 0x0F];
+    }
+    out.append(text, sizeof(text));
+}
+
+void healthReportFormat(const HealthReport_t& report, TextBuffer& out) {
+    bool previous = (report.flags & HEALTH_REPORT_FLAG_PREVIOUS) != 0;
+
+    out.append("reset=").append(healthResetReasonName(report.reset_reason));
+    if (previous) {
+        out.append(" phase=").append(healthPhaseName(report.phase))
+           .append(" fault=").append(report.fault <= HEALTH_FAULT_TASK_WDT ? FAULT_NAMES[report.fault] : "?")
+           .append(" run=").appendUnsigned(report.previous_uptime_s).append('s');
+    }
+    out.append(" boots=").appendUnsigned(report.boots)
+       .append(" failures=").appendUnsigned(report.failures)
+       .append(" brownouts=").appendUnsigned(report.brownouts)
+       .append(" wdt=").appendUnsigned(report.watchdog_resets)
+       .append(" panics=").appendUnsigned(report.panics)
+       .append(" mtbf=");
+    if (report.mtbf_s == HEALTH_MTBF_NONE) {
+        out.append('-');
+    } else {
+        out.appendUnsigned(report.mtbf_s).append('s');
+    }
+    out.append(" restart=").appendUnsigned(report.restart_ms).append("ms");
+
+    if (previous && report.backtrace_depth) {
+        out.append(" bt=");
+        for (uint8_t i = 0; i < report.backtrace_depth && i < HEALTH_BACKTRACE_DEPTH; i++) {
+            if (i) out.append(',');
+            appendHex32(out, report.backtrace[i]);
+        }
+    }
+}
@@ -0,0 +1,244 @@
+/**
+ * ============================================================================
+ * BINSAI Health Monitor
+ * Reset reasons, crash context and reliability counters across reboots
+ * ============================================================================
+ *
+ * Two records survive a reset:
+ * - HealthRtcRecord_t (RTC_NOINIT memory in firmware): the loop phase the
+ *   device was in, run time, and the fault type / PC chain written by the
+ *   panic and task watchdog hooks. Lost on power loss, which the magic
+ *   detects
+ * - HealthStats_t (NVS through HealthStore): boots, failures by kind, total
+ *   run time and restart times. Run time is flushed every
+ *   persist_interval_s, so a power cut loses at most that much
+ *
+ * A failure is a panic, a watchdog (interrupt / task / other) or a brownout
+ * reset. Power-on, external, software and deep-sleep resets are not.
+ * MTBF = total run time / failures. Restart time = boot until the first
+ * uplink connection (markReady()).
+ *
+ * After markReady() the boot report (previous run + counters) is pending
+ * until a transport delivers it: HEALTH_REPORT_SIZE bytes on MQTT, one text
+ * line on Blynk and Serial.
+ *
+ * BINARY REPORT (little-endian, HEALTH_REPORT_SIZE bytes):
+ *   off size field
+ *   0   2    magic 0xB15C
+ *   2   1    version
+ *   3   1    reset reason (HealthResetReason_t)
+ *   4   1    last phase of the previous run (HealthPhase_t)
+ *   5   1    fault (HealthFault_t)
+ *   6   1    backtrace depth (0..8)
+ *   7   1    flags (bit0 previous run record valid)
+ *   8   4    previous run time [s]
+ *   12  4    boots
+ *   16  4    failures
+ *   20  4    brownouts
+ *   24  4    watchdog resets
+ *   28  4    panics
+ *   32  4    MTBF [s] (0xFFFFFFFF before the first failure)
+ *   36  4    restart time of this boot [ms]
+ *   40  32   backtrace PCs, unused entries 0
+ *   72  2    crc16 (CCITT-FALSE over bytes 0..71)
+ * ============================================================================
+ */
+
+#ifndef BINSAI_HEALTH_MONITOR_H
+#define BINSAI_HEALTH_MONITOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "TextBuffer.h"
+
+#define HEALTH_RTC_MAGIC            0x48544C48UL  // "HLTH" little-endian
+#define HEALTH_STATS_MAGIC          0x54534C48UL  // "HLST" little-endian
+#define HEALTH_BACKTRACE_DEPTH      8
+#define HEALTH_PERSIST_INTERVAL_S   600           // Run-time flush to NVS
+#define HEALTH_MTBF_NONE            0xFFFFFFFFUL  // No failure recorded yet
+
+#define HEALTH_REPORT_MAGIC         0xB15C
+#define HEALTH_REPORT_VERSION       1
+#define HEALTH_REPORT_SIZE          74
+#define HEALTH_REPORT_FLAG_PREVIOUS 0x01
+
+/**
+ * Portable copy of esp_reset_reason_t
+ */
+typedef enum {
+    HEALTH_RESET_UNKNOWN = 0,
+    HEALTH_RESET_POWER_ON,
+    HEALTH_RESET_EXTERNAL,
+    HEALTH_RESET_SOFTWARE,
+    HEALTH_RESET_PANIC,
+    HEALTH_RESET_INT_WDT,
+    HEALTH_RESET_TASK_WDT,
+    HEALTH_RESET_OTHER_WDT,
+    HEALTH_RESET_DEEP_SLEEP,
+    HEALTH_RESET_BROWNOUT,
+    HEALTH_RESET_SDIO,
+    HEALTH_RESET_COUNT
+} HealthResetReason_t;
+
+/**
+ * Loop-phase markers, one per step of loop() plus setup
+ */
+typedef enum {
+    HEALTH_PHASE_BOOT = 0,
+    HEALTH_PHASE_SETUP,
+    HEALTH_PHASE_TRANSPORTS,
+    HEALTH_PHASE_SENSORS,
+    HEALTH_PHASE_LOGGING,
+    HEALTH_PHASE_FLEET,
+    HEALTH_PHASE_NOTIFY,
+    HEALTH_PHASE_SMS,
+    HEALTH_PHASE_DISPLAY,
+    HEALTH_PHASE_CONSOLE,
+    HEALTH_PHASE_FIRMWARE,
+    HEALTH_PHASE_IDLE,
+    HEALTH_PHASE_COUNT
+} HealthPhase_t;
+
+typedef enum {
+    HEALTH_FAULT_NONE = 0,
+    HEALTH_FAULT_PANIC,             // CPU exception / abort, PCs captured
+    HEALTH_FAULT_TASK_WDT           // Task watchdog fired
+} HealthFault_t;
+
+/**
+ * RTC-retained crash context. Written from the panic / watchdog hooks, so
+ * plain stores only.
+ */
+typedef struct {
+    uint32_t magic;                 // HEALTH_RTC_MAGIC while trustworthy
+    uint32_t uptime_s;              // Run time of the current boot
+    uint32_t unsaved_s;             // ... not yet added to HealthStats_t
+    uint32_t last_ms;               // millis() of the last whole second counted
+    uint8_t phase;                  // HealthPhase_t
+    uint8_t fault;                  // HealthFault_t
+    uint8_t backtrace_depth;
+    uint8_t reserved;
+    uint32_t backtrace[HEALTH_BACKTRACE_DEPTH];
+} HealthRtcRecord_t;
+
+/**
+ * Persisted reliability counters (NVS in firmware)
+ */
+typedef struct {
+    uint32_t magic;                 // HEALTH_STATS_MAGIC
+    uint32_t boots;
+    uint32_t failures;              // Panic + watchdog + brownout resets
+    uint32_t brownouts;
+    uint32_t watchdog_resets;
+    uint32_t panics;
+    uint32_t uptime_s;              // Run time over all boots
+    uint32_t restarts_timed;        // Boots that reached markReady()
+    uint32_t restart_total_ms;
+    uint32_t last_restart_ms;
+} HealthStats_t;
+
+typedef struct {
+    uint8_t reset_reason;           // HealthResetReason_t
+    uint8_t phase;                  // Last phase of the previous run
+    uint8_t fault;                  // HealthFault_t of the previous run
+    uint8_t backtrace_depth;
+    uint8_t flags;                  // HEALTH_REPORT_FLAG_*
+    uint32_t previous_uptime_s;
+    uint32_t boots;
+    uint32_t failures;
+    uint32_t brownouts;
+    uint32_t watchdog_resets;
+    uint32_t panics;
+    uint32_t mtbf_s;                // HEALTH_MTBF_NONE before the first failure
+    uint32_t restart_ms;
+    uint32_t backtrace[HEALTH_BACKTRACE_DEPTH];
+} HealthReport_t;
+
+/**
+ * Stats persistence (Preferences in firmware, RAM in tests)
+ */
+class HealthStore {
+public:
+    virtual ~HealthStore() {}
+    virtual bool loadStats(HealthStats_t* stats) = 0;
+    virtual bool saveStats(const HealthStats_t& stats) = 0;
+};
+
+class HealthMonitor {
+public:
+    HealthMonitor(HealthStore& store, HealthRtcRecord_t& rtc,
+                  uint32_t persist_interval_s = HEALTH_PERSIST_INTERVAL_S);
+
+    /**
+     * Classify the reset, fold the previous run into the stats and re-arm
+     * the RTC record. Call once, first thing in setup().
+     */
+    void onBoot(HealthResetReason_t reason, uint32_t now_ms);
+
+    /**
+     * Count run time, flush it to the store every persist interval
+     */
+    void loop(uint32_t now_ms);
+
+    void setPhase(HealthPhase_t phase) { _rtc.phase = (uint8_t)phase; }
+
+    /**
+     * Service restored (first uplink): records the restart time and makes
+     * the boot report pending. Later calls do nothing.
+     */
+    void markReady(uint32_t now_ms);
+
+    bool ready() const { return _ready; }
+    bool reportPending() const { return _report_pending; }
+    const HealthReport_t& report() const { return _report; }
+    void reportDelivered() { _report_pending = false; }
+
+    const HealthStats_t& stats() const { return _stats; }
+    uint32_t uptimeSeconds() const { return _rtc.uptime_s; }
+    HealthPhase_t phase() const { return (HealthPhase_t)_rtc.phase; }
+
+    /**
+     * @return Run time per failure, HEALTH_MTBF_NONE without failures
+     */
+    uint32_t mtbfSeconds() const;
+
+    uint32_t meanRestartMs() const;
+
+private:
+    void fillCounters();
+
+    HealthStore& _store;
+    HealthRtcRecord_t& _rtc;
+    uint32_t _persist_interval_s;
+    HealthStats_t _stats;
+    HealthReport_t _report;
+    uint32_t _boot_ms;
+    bool _ready;
+    bool _report_pending;
+};
+
+/**
+ * Panic, watchdog and brownout resets count as failures
+ */
+bool healthResetIsFailure(HealthResetReason_t reason);
+
+const char* healthResetReasonName(uint8_t reason);
+const char* healthPhaseName(uint8_t phase);
+
+/**
+ * Serialize the binary report
+ * @return HEALTH_REPORT_SIZE, or 0 if capacity is too small
+ */
+size_t healthReportEncode(const HealthReport_t& report, uint8_t* out, size_t capacity);
+
+/**
+ * @return false on wrong size, magic, version or CRC
+ */
+bool healthReportDecode(const uint8_t* data, size_t length, HealthReport_t* report);
+
+/**
+ * One line: reset=brownout phase=sensors run=3600s boots=12 failures=3 ...
+ */
+void healthReportFormat(const HealthReport_t& report, TextBuffer& out);
+
+#endif  // BINSAI_HEALTH_MONITOR_H
@@ -0,0 +1,168 @@
+/**
+ * BINSAI LoRa Airtime & Channel Simulator - time on air, ALOHA channel model
+ */
+
+#include "LoraAirtime.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+void loraRadioDefaults(LoraRadioConfig_t* config, uint8_t spreading_factor) {
+    config->spreading_factor = spreading_factor;
+    config->bandwidth_hz = 125000;
+    config->coding_rate = 1;
+    config->preamble_symbols = 8;
+    config->explicit_header = true;
+    config->crc = true;
+    config->low_data_rate_optimize = spreading_factor >= 11;
+}
+
+double loraAirtimeMs(const LoraRadioConfig_t& radio, size_t payload_bytes) {
+    double symbol_ms = (double)(1UL << radio.spreading_factor) * 1000.0 / radio.bandwidth_hz;
+    double preamble_ms = (radio.preamble_symbols + 4.25) * symbol_ms;
+
+    int sf = radio.spreading_factor;
+    int length = (int)(payload_bytes + LORAWAN_OVERHEAD_BYTES);
+    int numerator = 8 * length - 4 * sf + 28 + (radio.crc ? 16 : 0) - (radio.explicit_header ? 0 : 20);
+    int denominator = 4 * (sf - (radio.low_data_rate_optimize ? 2 : 0));
+    int blocks = numerator > 0 ? (numerator + denominator - 1) / denominator : 0;
+    double payload_symbols = 8 + blocks * (radio.coding_rate + 4);
+
+    return preamble_ms + payload_symbols * symbol_ms;
+}
+
+void loraSimDefaults(LoraSimConfig_t* config) {
+    config->bins = 500;
+    config->interval_s = 600;
+    config->jitter_ms = 30000;
+    config->channels = 2;
+    config->payload_bytes = 8;
+    loraRadioDefaults(&config->radio, 9);
+    config->duty_cycle = 0.01;
+    config->capture_db = 6.0;
+    config->duration_s = 86400;
+    config->seed = 1;
+}
+
+namespace {
+
+/**
+ * splitmix64: small, seedable, identical on every host
+ */
+class SimRandom {
+public:
+    explicit SimRandom(uint64_t seed) : _state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+    uint64_t _state;
+};
+
+typedef struct {
+    int64_t start_us;
+    uint32_t bin;
+    uint8_t channel;
+    double interferer_dbm;          // Strongest overlapping frame, -inf if none
+} Uplink_t;
+
+bool byStart(const Uplink_t& a, const Uplink_t& b) {
+    return a.start_us < b.start_us;
+}
+
+}  // namespace
+
+LoraSimResult_t loraSimulateChannel(const LoraSimConfig_t& config) {
+    LoraSimResult_t result;
+    memset(&result, 0, sizeof(result));
+
+    uint8_t channels = config.channels ? config.channels : 1;
+    result.airtime_ms = loraAirtimeMs(config.radio, config.payload_bytes);
+    int64_t airtime_us = (int64_t)llround(result.airtime_ms * 1000.0);
+    int64_t off_us = config.duty_cycle > 0.0
+                         ? (int64_t)llround(result.airtime_ms * 1000.0 * (1.0 / config.duty_cycle - 1.0))
+                         : 0;
+    int64_t interval_us = (int64_t)config.interval_s * 1000000;
+    int64_t jitter_us = (int64_t)config.jitter_ms * 1000;
+    int64_t end_us = (int64_t)config.duration_s * 1000000;
+
+    result.device_duty = config.interval_s ? result.airtime_ms / (config.interval_s * 1000.0) : 1.0;
+    result.min_interval_s = config.duty_cycle > 0.0 ? result.airtime_ms / 1000.0 / config.duty_cycle : 0.0;
+
+    SimRandom random(config.seed * 0x2545F4914F6CDD1DULL + 1);
+    std::vector<double> rssi(config.bins);
+    std::vector<Uplink_t> uplinks;
+    uplinks.reserve((size_t)config.bins * (config.duration_s / (config.interval_s ? config.interval_s : 1) + 1));
+
+    for (uint32_t bin = 0; bin < config.bins; bin++) {
+        rssi[bin] = LORA_SIM_RSSI_MIN + random.uniform() * (LORA_SIM_RSSI_MAX - LORA_SIM_RSSI_MIN);
+
+        int64_t scheduled = (int64_t)(random.uniform() * interval_us);
+        int64_t allowed = 0;
+        while (scheduled < end_us) {
+            int64_t jitter = jitter_us ? (int64_t)(random.uniform() * 2 * jitter_us) - jitter_us : 0;
+            int64_t start = scheduled + jitter;
+            if (start < 0) start = 0;
+            if (start < allowed) {
+                start = allowed;
+                result.duty_deferred++;
+            }
+            if (start >= end_us) {
+                break;
+            }
+
+            Uplink_t uplink;
+            uplink.start_us = start;
+            uplink.bin = bin;
+            uplink.channel = (uint8_t)(random.next() % channels);
+            uplink.interferer_dbm = -INFINITY;
+            uplinks.push_back(uplink);
+
+            allowed = start + airtime_us + off_us;
+            scheduled += interval_us;
+        }
+    }
+
+    std::sort(uplinks.begin(), uplinks.end(), byStart);
+
+    // Same airtime for every frame: a frame can only overlap later frames
+    // that start before it ends
+    for (size_t i = 0; i < uplinks.size(); i++) {
+        for (size_t j = i + 1; j < uplinks.size() && uplinks[j].start_us < uplinks[i].start_us + airtime_us; j++) {
+            if (uplinks[j].channel != uplinks[i].channel) {
+                continue;
+            }
+            uplinks[i].interferer_dbm = std::max(uplinks[i].interferer_dbm, rssi[uplinks[j].bin]);
+            uplinks[j].interferer_dbm = std::max(uplinks[j].interferer_dbm, rssi[uplinks[i].bin]);
+        }
+    }
+
+    for (size_t i = 0; i < uplinks.size(); i++) {
+        const Uplink_t& uplink = uplinks[i];
+        result.transmissions++;
+        if (uplink.interferer_dbm == -INFINITY) {
+            result.delivered++;
+        } else if (config.capture_db >= 0.0 && rssi[uplink.bin] - uplink.interferer_dbm >= config.capture_db) {
+            result.delivered++;
+            result.captured++;
+        } else {
+            result.collided++;
+        }
+    }
+
+    if (result.transmissions) {
+        result.delivery_ratio = (double)result.delivered / result.transmissions;
+        result.offered_load = result.transmissions * result.airtime_ms / 1000.0 /
+                              ((double)config.duration_s * channels);
+        result.aloha_expected = exp(-2.0 * result.offered_load);
+    }
+    return result;
+}
@@ -0,0 +1,97 @@
+/**
+ * ============================================================================
+ * BINSAI LoRa Airtime & Channel Simulator
+ * Time-on-air, duty cycle and shared-channel delivery for sizing uplinks
+ * ============================================================================
+ *
+ * loraAirtimeMs() is the Semtech SX127x time-on-air formula (AN1200.13)
+ * applied to the full LoRaWAN PHYPayload: application bytes plus 13 bytes
+ * of MHDR, FHDR, FPort and MIC.
+ *
+ * loraSimulateChannel() is a discrete-event model of N bins on one gateway.
+ * - Each bin reports every interval_s with +-jitter_ms of uniform jitter,
+ *   starting at a random phase.
+ * - Each uplink goes on a random channel.
+ * - Each device is held to the duty-cycle limit: after transmitting it
+ *   stays off for airtime * (1/duty - 1).
+ * - Every bin uses the same SF, so uplinks that overlap on the same
+ *   channel collide.
+ * - Capture effect: a frame still survives if it is capture_db stronger
+ *   than every overlapping frame. Per-bin RSSI is uniform over
+ *   LORA_SIM_RSSI_MIN..MAX dBm.
+ * - All bins are assumed to be in range. Downlinks and gateway
+ *   half-duplex are not modelled.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_LORA_AIRTIME_H
+#define BINSAI_LORA_AIRTIME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LORAWAN_OVERHEAD_BYTES      13          // MHDR 1 + FHDR 7 + FPort 1 + MIC 4
+#define LORA_SIM_RSSI_MIN           -125.0
+#define LORA_SIM_RSSI_MAX           -95.0
+
+typedef struct {
+    uint8_t spreading_factor;       // 7..12
+    uint32_t bandwidth_hz;          // 125000 / 250000 / 500000
+    uint8_t coding_rate;            // 1..4 for 4/5..4/8
+    uint16_t preamble_symbols;      // LoRaWAN: 8
+    bool explicit_header;
+    bool crc;                       // Uplinks: true
+    bool low_data_rate_optimize;    // Required when symbol time >= 16 ms
+} LoraRadioConfig_t;
+
+/**
+ * LoRaWAN uplink defaults: 125 kHz, 4/5, 8 preamble symbols, explicit header,
+ * CRC on, low data rate optimisation for SF11/SF12
+ */
+void loraRadioDefaults(LoraRadioConfig_t* config, uint8_t spreading_factor);
+
+/**
+ * Time on air of one uplink
+ * @param payload_bytes Application payload (LoRaWAN overhead is added)
+ */
+double loraAirtimeMs(const LoraRadioConfig_t& radio, size_t payload_bytes);
+
+typedef struct {
+    uint32_t bins;
+    uint32_t interval_s;            // Reporting interval per bin
+    uint32_t jitter_ms;             // +- uniform jitter per uplink
+    uint8_t channels;               // Uplink channels (random hopping)
+    uint8_t payload_bytes;
+    LoraRadioConfig_t radio;
+    double duty_cycle;              // Per-device limit (0.01 = 1 %), 0 = none
+    double capture_db;              // Capture threshold, negative disables capture
+    uint32_t duration_s;
+    uint32_t seed;
+} LoraSimConfig_t;
+
+typedef struct {
+    uint64_t transmissions;
+    uint64_t delivered;
+    uint64_t collided;
+    uint64_t captured;              // Overlapped but survived by capture
+    uint64_t duty_deferred;         // Uplinks pushed back by the duty-cycle limit
+    double airtime_ms;              // Per uplink
+    double device_duty;             // Airtime / interval for one bin
+    double min_interval_s;          // Shortest interval the duty cycle allows
+    double offered_load;            // G: airtime-weighted uplinks per channel
+    double delivery_ratio;
+    double aloha_expected;          // Pure ALOHA e^(-2G), no capture
+} LoraSimResult_t;
+
+/**
+ * Defaults: 500 bins, 10 min interval, +-30 s jitter, 2 channels (AS923),
+ * 8-byte status payload at SF9, 1 % duty cycle, 6 dB capture, 24 h
+ */
+void loraSimDefaults(LoraSimConfig_t* config);
+
+/**
+ * Run the channel model (deterministic for a given seed)
+ */
+LoraSimResult_t loraSimulateChannel(const LoraSimConfig_t& config);
+
+#endif  // BINSAI_LORA_AIRTIME_H
@@ -0,0 +1,146 @@
+/**
+ * BINSAI LoRa Uplink Codec - bit packing, anchor tracking
+ */
+
+#include "LoraUplink.h"
+#include <math.h>
+#include <string.h>
+#include "TelemetryFrame.h"
+
+#define LORA_LAT_OFFSET             9000000L    // 90 deg in 1e-5
+#define LORA_LON_OFFSET             18000000L   // 180 deg in 1e-5
+#define LORA_COMMON_BITS            37
+
+/**
+ * MSB-first writer over a zeroed buffer
+ */
+static void putBits(uint8_t* buffer, size_t* bit, uint32_t value, uint8_t width) {
+    for (int i = width - 1; i >= 0; i--) {
+        if ((value >> i) & 1) {
+            buffer[*bit >> 3] |= (uint8_t)(0x80 >> (*bit & 7));
+        }
+        (*bit)++;
+    }
+}
+
+static uint32_t getBits(const uint8_t* buffer, size_t* bit, uint8_t width) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < width; i++) {
+        value = (value << 1) | ((buffer[*bit >> 3] >> (7 - (*bit & 7))) & 1);
+        (*bit)++;
+    }
+    return value;
+}
+
+/**
+ * Round value * scale into 0..max
+ */
+static uint32_t quantize(float value, float scale, uint32_t max) {
+    float scaled = value * scale + 0.5f;
+    if (!(scaled > 0.0f)) return 0;
+    if (scaled >= (float)max) return max;
+    return (uint32_t)scaled;
+}
+
+static void putCommon(uint8_t* buffer, size_t* bit, uint8_t type, const SensorData_t& data, uint8_t flags) {
+    putBits(buffer, bit, type, 1);
+    putBits(buffer, bit, quantize(data.fill_percentage, 2.0f, 200), 8);
+    putBits(buffer, bit, quantize(data.ppm_calculated, 0.5f, 1023), 10);
+    putBits(buffer, bit, data.capacity_level & 0x03, 2);
+    putBits(buffer, bit, data.waste_classification & 0x03, 2);
+    putBits(buffer, bit, data.priority_level & 0x03, 2);
+    putBits(buffer, bit, (flags & TELEMETRY_FLAG_GPS_FIX) ? 1 : 0, 1);
+    putBits(buffer, bit, (flags & TELEMETRY_FLAG_CRITICAL) ? 1 : 0, 1);
+    putBits(buffer, bit, data.hours_to_full < 0.0f ? LORA_HOURS_UNKNOWN
+                                                   : quantize(data.hours_to_full, 2.0f, LORA_HOURS_UNKNOWN - 1), 10);
+}
+
+LoraUplinkEncoder::LoraUplinkEncoder(uint16_t anchor_refresh)
+    : _anchor_refresh(anchor_refresh), _has_anchor(false), _since_anchor(0),
+      _anchor_lat(0), _anchor_lon(0) {}
+
+size_t LoraUplinkEncoder::encode(const SensorData_t& data, uint8_t flags, uint8_t* buffer, size_t capacity) {
+    if (capacity < LORA_UPLINK_MAX_SIZE) {
+        return 0;
+    }
+
+    bool fix = (flags & TELEMETRY_FLAG_GPS_FIX) != 0;
+    int32_t lat = (int32_t)lround(data.latitude * LORA_POSITION_SCALE);
+    int32_t lon = (int32_t)lround(data.longitude * LORA_POSITION_SCALE);
+    int32_t delta_lat = fix ? lat - _anchor_lat : 0;
+    int32_t delta_lon = fix ? lon - _anchor_lon : 0;
+
+    bool anchor = fix && (!_has_anchor || _since_anchor >= _anchor_refresh ||
+                          delta_lat > LORA_DELTA_LIMIT || delta_lat < -LORA_DELTA_LIMIT ||
+                          delta_lon > LORA_DELTA_LIMIT || delta_lon < -LORA_DELTA_LIMIT);
+
+    memset(buffer, 0, LORA_UPLINK_MAX_SIZE);
+    size_t bit = 0;
+
+    if (anchor) {
+        _anchor_lat = lat;
+        _anchor_lon = lon;
+        _has_anchor = true;
+        _since_anchor = 0;
+
+        putCommon(buffer, &bit, LORA_FRAME_ANCHOR, data, flags);
+        putBits(buffer, &bit, (uint32_t)(lat + LORA_LAT_OFFSET), 25);
+        putBits(buffer, &bit, (uint32_t)(lon + LORA_LON_OFFSET), 26);
+        return LORA_UPLINK_ANCHOR_SIZE;
+    }
+
+    if (_has_anchor) {
+        _since_anchor++;
+    }
+    putCommon(buffer, &bit, LORA_FRAME_STATUS, data, flags);
+    putBits(buffer, &bit, (uint32_t)delta_lat & 0xFFF, 12);
+    putBits(buffer, &bit, (uint32_t)delta_lon & 0xFFF, 12);
+    return LORA_UPLINK_STATUS_SIZE;
+}
+
+static int32_t signExtend12(uint32_t value) {
+    return (value & 0x800) ? (int32_t)value - 0x1000 : (int32_t)value;
+}
+
+bool LoraUplinkDecoder::decode(const uint8_t* buffer, size_t length, SensorData_t* data, uint8_t* flags) {
+    if (length < 1) {
+        return false;
+    }
+    uint8_t type = loraFrameType(buffer);
+    if (length != (type == LORA_FRAME_ANCHOR ? LORA_UPLINK_ANCHOR_SIZE : LORA_UPLINK_STATUS_SIZE)) {
+        return false;
+    }
+
+    SensorData_t decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    size_t bit = 1;
+    decoded.fill_percentage = getBits(buffer, &bit, 8) * 0.5f;
+    decoded.ppm_calculated = getBits(buffer, &bit, 10) * 2.0f;
+    decoded.capacity_level = (uint8_t)getBits(buffer, &bit, 2);
+    decoded.waste_classification = (uint8_t)getBits(buffer, &bit, 2);
+    decoded.priority_level = (uint8_t)getBits(buffer, &bit, 2);
+    bool fix = getBits(buffer, &bit, 1) != 0;
+    bool critical = getBits(buffer, &bit, 1) != 0;
+    uint32_t hours = getBits(buffer, &bit, 10);
+    decoded.hours_to_full = (hours == LORA_HOURS_UNKNOWN) ? -1.0f : hours * 0.5f;
+
+    if (type == LORA_FRAME_ANCHOR) {
+        _anchor_lat = (int32_t)getBits(buffer, &bit, 25) - LORA_LAT_OFFSET;
+        _anchor_lon = (int32_t)getBits(buffer, &bit, 26) - LORA_LON_OFFSET;
+        _has_anchor = true;
+        decoded.latitude = _anchor_lat / LORA_POSITION_SCALE;
+        decoded.longitude = _anchor_lon / LORA_POSITION_SCALE;
+    } else if (fix) {
+        if (!_has_anchor) {
+            return false;
+        }
+        int32_t delta_lat = signExtend12(getBits(buffer, &bit, 12));
+        int32_t delta_lon = signExtend12(getBits(buffer, &bit, 12));
+        decoded.latitude = (_anchor_lat + delta_lat) / LORA_POSITION_SCALE;
+        decoded.longitude = (_anchor_lon + delta_lon) / LORA_POSITION_SCALE;
+    }
+
+    *data = decoded;
+    *flags = (uint8_t)((fix ? TELEMETRY_FLAG_GPS_FIX : 0) | (critical ? TELEMETRY_FLAG_CRITICAL : 0));
+    return true;
+}
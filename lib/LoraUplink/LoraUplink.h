@@ -0,0 +1,100 @@
+/**
+ * ============================================================================
+ * BINSAI LoRa Uplink Codec
+ * Bit-packed SensorData_t for 11-byte LoRaWAN application payloads
+ * ============================================================================
+ *
+ * Two frame types, both MSB-first bit packed. The first 37 bits are shared:
+ *   bits field            encoding
+ *     1  type             0 = status, 1 = anchor
+ *     8  fill_percentage  0.5 % steps, 0..200
+ *    10  ppm_calculated   2 ppm steps, saturates at 2046 ppm
+ *     2  capacity_level
+ *     2  waste_classification
+ *     2  priority_level
+ *     1  gps fix          (TELEMETRY_FLAG_GPS_FIX)
+ *     1  critical         (TELEMETRY_FLAG_CRITICAL)
+ *    10  hours_to_full    0.5 h steps up to 511 h, 1023 = unknown
+ *
+ * Status (LORA_UPLINK_STATUS_SIZE = 8 bytes) then adds:
+ *    12  latitude delta   signed, 1e-5 deg (~1.1 m) from the anchor
+ *    12  longitude delta  signed, 1e-5 deg
+ *
+ * Anchor (LORA_UPLINK_ANCHOR_SIZE = 11 bytes) then adds:
+ *    25  latitude         (lat + 90) * 1e5
+ *    26  longitude        (lon + 180) * 1e5
+ *
+ * The encoder sends an anchor first. It sends another when the delta
+ * leaves +-2047 (about 2.2 km), and every anchor_refresh frames so a
+ * network server that missed one recovers. Bins do not move, so nearly
+ * every uplink is an 8-byte status, which fits DR0 on every region.
+ * Without a GPS fix the deltas are 0 and the fix flag is clear.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_LORA_UPLINK_H
+#define BINSAI_LORA_UPLINK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "definitions.h"
+
+#define LORA_UPLINK_STATUS_SIZE     8
+#define LORA_UPLINK_ANCHOR_SIZE     11
+#define LORA_UPLINK_MAX_SIZE        LORA_UPLINK_ANCHOR_SIZE
+#define LORA_ANCHOR_REFRESH         24          // Frames between forced anchors
+#define LORA_POSITION_SCALE         1e5         // Units per degree
+#define LORA_DELTA_LIMIT            2047
+#define LORA_HOURS_UNKNOWN          1023
+
+#define LORA_FRAME_STATUS           0
+#define LORA_FRAME_ANCHOR           1
+
+class LoraUplinkEncoder {
+public:
+    explicit LoraUplinkEncoder(uint16_t anchor_refresh = LORA_ANCHOR_REFRESH);
+
+    /**
+     * Encode one sample, choosing status or anchor
+     * @param flags TELEMETRY_FLAG_* (GPS fix gates the position fields)
+     * @return Bytes written, 0 if capacity < LORA_UPLINK_MAX_SIZE
+     */
+    size_t encode(const SensorData_t& data, uint8_t flags, uint8_t* buffer, size_t capacity);
+
+    /**
+     * Make the next frame an anchor (e.g. after a LoRaWAN rejoin)
+     */
+    void forceAnchor() { _has_anchor = false; }
+
+private:
+    uint16_t _anchor_refresh;
+    bool _has_anchor;
+    uint16_t _since_anchor;
+    int32_t _anchor_lat;
+    int32_t _anchor_lon;
+};
+
+class LoraUplinkDecoder {
+public:
+    LoraUplinkDecoder() : _has_anchor(false), _anchor_lat(0), _anchor_lon(0) {}
+
+    /**
+     * Decode into the fields the uplink carries (others are zeroed)
+     * @return false on bad length/type, or a status frame with no anchor yet
+     */
+    bool decode(const uint8_t* buffer, size_t length, SensorData_t* data, uint8_t* flags);
+
+    bool hasAnchor() const { return _has_anchor; }
+
+private:
+    bool _has_anchor;
+    int32_t _anchor_lat;
+    int32_t _anchor_lon;
+};
+
+/**
+ * Frame type of an encoded uplink (LORA_FRAME_*)
+ */
+inline uint8_t loraFrameType(const uint8_t* buffer) { return buffer[0] >> 7; }
+
+#endif  // BINSAI_LORA_UPLINK_H
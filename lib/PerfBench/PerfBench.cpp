@@ -0,0 +1,170 @@
+/**
+ * BINSAI Performance Bench - runner, statistics and report writer
+ */
+
+#include "PerfBench.h"
+#include <TextBuffer.h>
+#include <string.h>
+#include <algorithm>
+
+#define PERF_SAMPLE_NS_MAX          4294967295ULL
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * Nearest-rank percentile of sorted samples, in microseconds
+ */
+static float sortedPercentileUs(const uint32_t* sorted_ns, size_t count, uint32_t percent) {
+    size_t rank = (size_t)(((uint64_t)count * percent + 99) / 100);
+    if (rank == 0) rank = 1;
+    return sorted_ns[rank - 1] / 1000.0f;
+}
+
+void perfStatsFromSamples(uint32_t* samples_ns, size_t count, uint32_t failures, PerfBenchStats_t* out) {
+    memset(out, 0, sizeof(*out));
+    out->failures = failures;
+    if (count == 0) {
+        return;
+    }
+
+    std::sort(samples_ns, samples_ns + count);
+    uint64_t sum_ns = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum_ns += samples_ns[i];
+    }
+
+    out->samples = (uint32_t)count;
+    out->min_us = samples_ns[0] / 1000.0f;
+    out->p50_us = sortedPercentileUs(samples_ns, count, 50);
+    out->p90_us = sortedPercentileUs(samples_ns, count, 90);
+    out->p99_us = sortedPercentileUs(samples_ns, count, 99);
+    out->max_us = samples_ns[count - 1] / 1000.0f;
+    out->mean_us = (float)((double)sum_ns / count / 1000.0);
+}
+
+void perfStatsFromHistogram(const MetricHistogramSnapshot_t& snapshot, PerfBenchStats_t* out) {
+    memset(out, 0, sizeof(*out));
+    if (snapshot.count == 0) {
+        return;
+    }
+
+    uint8_t first = 0;
+    while (first < METRICS_HISTOGRAM_BUCKETS - 1 && snapshot.buckets[first] == 0) {
+        first++;
+    }
+
+    out->samples = snapshot.count;
+    out->min_us = first == 0 ? 0.0f : (float)metricsBucketUpperUs(first - 1);
+    out->p50_us = (float)metricsQuantileUs(snapshot, 0.50f);
+    out->p90_us = (float)metricsQuantileUs(snapshot, 0.90f);
+    out->p99_us = (float)metricsQuantileUs(snapshot, 0.99f);
+    out->max_us = (float)snapshot.max_us;
+    out->mean_us = (float)snapshot.sum_us / snapshot.count;
+    if (out->min_us > out->max_us) {
+        out->min_us = out->max_us;
+    }
+}
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+PerfBench::PerfBench(uint32_t* samples_ns, size_t capacity)
+    : _samples(samples_ns), _capacity(capacity), _yield(nullptr) {}
+
+bool PerfBench::run(PerfBenchCase_t fn, void* context, size_t iterations, size_t warmup, uint32_t batch,
+                    PerfBenchStats_t* out) {
+    if (iterations == 0 || batch == 0 || _capacity == 0) {
+        return false;
+    }
+    if (iterations > _capacity) {
+        iterations = _capacity;
+    }
+
+    for (size_t i = 0; i < warmup; i++) {
+        fn(context);
+        if (_yield) _yield();
+    }
+
+    uint32_t failures = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        uint32_t start_us = metricsNowUs();
+        for (uint32_t b = 0; b < batch; b++) {
+            failures += fn(context) ? 0 : 1;
+        }
+        uint64_t sample_ns = (uint64_t)(metricsNowUs() - start_us) * 1000 / batch;
+        _samples[i] = sample_ns > PERF_SAMPLE_NS_MAX ? (uint32_t)PERF_SAMPLE_NS_MAX : (uint32_t)sample_ns;
+        if (_yield) _yield();
+    }
+
+    perfStatsFromSamples(_samples, iterations, failures, out);
+    return true;
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+
+/**
+ * Quoted JSON string (quote, backslash and control characters escaped)
+ */
+static void appendJsonString(TextBuffer& line, const char* text, size_t max_length) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    line.append('"');
+    for (size_t i = 0; text && text[i] != '\0' && i < max_length; i++) {
+        char c = text[i];
+        if (c == '"' || c == '\\') {
+            line.append('\\').append(c);
+        } else if ((uint8_t)c < 0x20) {
+            line.append("\\u00").append(HEX_DIGITS[(uint8_t)c >> 4]).append(HEX_DIGITS[c & 0x0F]);
+        } else {
+            line.append(c);
+        }
+    }
+    line.append('"');
+}
+
+static void appendField(TextBuffer& line, const char* key, float value_us) {
+    line.append(",\"").append(key).append("\":").appendFixed(value_us, 3);
+}
+
+PerfReportWriter::PerfReportWriter(PerfReportSink_t sink, void* context)
+    : _sink(sink), _context(context), _cases(0) {}
+
+void PerfReportWriter::begin(const PerfReportHeader_t& header) {
+    FixedText<PERF_REPORT_LINE_MAX> line;
+    line.append("{\"schema\":\"" PERF_REPORT_SCHEMA "\",\"firmware\":");
+    appendJsonString(line, header.firmware, PERF_HEADER_TEXT_MAX);
+    line.append(",\"target\":");
+    appendJsonString(line, header.target, PERF_HEADER_TEXT_MAX);
+    line.append(",\"device\":");
+    appendJsonString(line, header.device, PERF_HEADER_TEXT_MAX);
+    line.append(",\"cases\":[");
+    _sink(line.c_str(), line.length(), _context);
+    _cases = 0;
+}
+
+void PerfReportWriter::add(const char* name, const PerfBenchStats_t& stats) {
+    // Separator leads so the last case needs no lookahead
+    FixedText<PERF_REPORT_LINE_MAX> line;
+    line.append(_cases == 0 ? "{\"name\":" : ",{\"name\":");
+    appendJsonString(line, name, PERF_CASE_NAME_MAX);
+    line.append(",\"n\":").appendUnsigned(stats.samples);
+    line.append(",\"failures\":").appendUnsigned(stats.failures);
+    appendField(line, "min_us", stats.min_us);
+    appendField(line, "p50_us", stats.p50_us);
+    appendField(line, "p90_us", stats.p90_us);
+    appendField(line, "p99_us", stats.p99_us);
+    appendField(line, "max_us", stats.max_us);
+    appendField(line, "mean_us", stats.mean_us);
+    line.append('}');
+    _sink(line.c_str(), line.length(), _context);
+    _cases++;
+}
+
+void PerfReportWriter::end() {
+    _sink("]}", 2, _context);
+}
@@ -0,0 +1,136 @@
+/**
+ * ============================================================================
+ * BINSAI Performance Bench
+ * Timed cases and the versioned JSON report shared by firmware and host
+ * ============================================================================
+ *
+ * DESIGN:
+ * - PerfBench times a case function a fixed number of iterations (after
+ *   untimed warm-up) on metricsNowUs() and keeps one sample per iteration
+ *   in caller storage: no heap, so the same runner drives the BENCH
+ *   console command on the ESP32 and the host benchmark suite
+ * - Sub-microsecond host cases run in batches; a sample is the batch time
+ *   divided by the batch size, stored in nanoseconds (saturating at 4.29 s)
+ * - Percentiles are nearest-rank over the sorted samples. Live loop
+ *   distributions come from RuntimeMetrics histograms instead and are
+ *   interpolated inside their power-of-two buckets
+ * - The report is one JSON object, streamed a line at a time through a
+ *   sink (no document in RAM):
+ *
+ *     {"schema":"binsai-perf/1","firmware":"2.0.0","target":"esp32","device":"BINSAI-001","cases":[
+ *     {"name":"loop_us","n":5120,"failures":0,"min_us":...,"p50_us":...,"p90_us":...,
+ *      "p99_us":...,"max_us":...,"mean_us":...}
+ *     ,{"name":"ultrasonic_read","n":20,...}
+ *     ]}
+ *
+ *   The schema major version changes only when a field changes meaning or
+ *   is removed; readers ignore fields they do not know. A case that could
+ *   not run (no modem, Blynk offline) is still listed with n=0
+ * - PerfCompare (host) reads reports back and flags regressions between
+ *   two firmware versions (binsai-fleet perf-compare)
+ * ============================================================================
+ */
+
+#ifndef BINSAI_PERF_BENCH_H
+#define BINSAI_PERF_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <RuntimeMetrics.h>
+
+#define PERF_REPORT_SCHEMA          "binsai-perf/1"
+#define PERF_REPORT_LINE_MAX        256    // Longest streamed line incl. NUL
+#define PERF_CASE_NAME_MAX          31     // Longer names are truncated
+#define PERF_HEADER_TEXT_MAX        47     // Firmware, target and device strings
+
+typedef struct {
+    uint32_t samples;
+    uint32_t failures;              // Iterations whose case returned false
+    float min_us;
+    float p50_us;
+    float p90_us;
+    float p99_us;
+    float max_us;
+    float mean_us;
+} PerfBenchStats_t;
+
+/**
+ * One iteration (or batch) of a case
+ * @return false if the operation failed (timeout, no reply); still timed
+ */
+typedef bool (*PerfBenchCase_t)(void* context);
+
+/**
+ * Called between timed iterations (watchdog feed, servicing transports)
+ */
+typedef void (*PerfBenchYield_t)();
+
+/**
+ * Nearest-rank statistics, sorting samples in place
+ * @param samples_ns Per-iteration times in nanoseconds
+ */
+void perfStatsFromSamples(uint32_t* samples_ns, size_t count, uint32_t failures, PerfBenchStats_t* out);
+
+/**
+ * Statistics of a RuntimeMetrics histogram (min is the lower bound of the
+ * first occupied bucket, mean uses the wrapped sum of the snapshot)
+ */
+void perfStatsFromHistogram(const MetricHistogramSnapshot_t& snapshot, PerfBenchStats_t* out);
+
+class PerfBench {
+public:
+    /**
+     * @param samples_ns Caller storage; iterations beyond capacity are
+     *        clamped to it
+     */
+    PerfBench(uint32_t* samples_ns, size_t capacity);
+
+    void setYield(PerfBenchYield_t yield) { _yield = yield; }
+
+    /**
+     * Time a case
+     * @param iterations Timed samples (1 .. capacity)
+     * @param warmup Untimed calls first (caches, lazily built tables)
+     * @param batch Calls per sample; the sample is their mean
+     * @return false if iterations is 0 or batch is 0
+     */
+    bool run(PerfBenchCase_t fn, void* context, size_t iterations, size_t warmup, uint32_t batch,
+             PerfBenchStats_t* out);
+
+private:
+    uint32_t* _samples;
+    size_t _capacity;
+    PerfBenchYield_t _yield;
+};
+
+typedef struct {
+    const char* firmware;           // FIRMWARE_VERSION or a git describe
+    const char* target;             // "esp32", "host"
+    const char* device;             // Device id, build host, ...
+} PerfReportHeader_t;
+
+/**
+ * Receives the report a line at a time (text is NUL-terminated, no newline)
+ */
+typedef void (*PerfReportSink_t)(const char* line, size_t length, void* context);
+
+class PerfReportWriter {
+public:
+    PerfReportWriter(PerfReportSink_t sink, void* context);
+
+    void begin(const PerfReportHeader_t& header);
+    void add(const char* name, const PerfBenchStats_t& stats);
+    void end();
+
+    /**
+     * Cases written since begin()
+     */
+    size_t cases() const { return _cases; }
+
+private:
+    PerfReportSink_t _sink;
+    void* _context;
+    size_t _cases;
+};
+
+#endif  // BINSAI_PERF_BENCH_H
@@ -0,0 +1,465 @@
+/**
+ * BINSAI Performance Report Comparison - JSON reader and regression rules
+ */
+
+#include "PerfCompare.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PERF_SCHEMA_PREFIX          "binsai-perf/"
+#define PERF_SCHEMA_MAJOR           1
+#define PERF_NUMBER_MAX             40     // Longest number literal accepted
+
+// ============================================================================
+// JSON reader
+// ============================================================================
+
+namespace {
+
+class JsonReader {
+public:
+    JsonReader(const char* text, size_t length, std::string* error)
+        : _text(text), _length(length), _pos(0), _error(error), _failed(false) {}
+
+    void seek(size_t pos) { _pos = pos; }
+
+    bool fail(const char* reason) {
+        if (!_failed && _error) {
+            char message[96];
+            snprintf(message, sizeof(message), "offset %lu: %s", (unsigned long)_pos, reason);
+            *_error = message;
+        }
+        _failed = true;
+        return false;
+    }
+
+    void skipSpace() {
+        while (_pos < _length && (_text[_pos] == ' ' || _text[_pos] == '\t' ||
+                                  _text[_pos] == '\r' || _text[_pos] == '\n')) {
+            _pos++;
+        }
+    }
+
+    /**
+     * Consume c (after whitespace) if it is next
+     */
+    bool accept(char c) {
+        skipSpace();
+        if (_pos < _length && _text[_pos] == c) {
+            _pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool expect(char c) {
+        if (accept(c)) {
+            return true;
+        }
+        char reason[24];
+        snprintf(reason, sizeof(reason), "expected '%c'", c);
+        return fail(reason);
+    }
+
+    bool parseString(std::string* out) {
+        if (!expect('"')) {
+            return false;
+        }
+        out->clear();
+        while (_pos < _length) {
+            char c = _text[_pos++];
+            if (c == '"') {
+                return true;
+            }
+            if ((uint8_t)c < 0x20) {
+                return fail("control character in string");
+            }
+            if (c != '\\') {
+                out->push_back(c);
+                continue;
+            }
+            if (_pos >= _length) {
+                break;
+            }
+            char escape = _text[_pos++];
+            switch (escape) {
+                case '"': case '\\': case '/': out->push_back(escape); break;
+                case 'b': out->push_back('\b'); break;
+                case 'f': out->push_back('\f'); break;
+                case 'n': out->push_back('\n'); break;
+                case 'r': out->push_back('\r'); break;
+                case 't': out->push_back('\t'); break;
+                case 'u': {
+                    uint32_t code = 0;
+                    for (int i = 0; i < 4; i++, _pos++) {
+                        if (_pos >= _length) {
+                            return fail("truncated \\u escape");
+                        }
+                        char h = _text[_pos];
+                        code <<= 4;
+                        if (h >= '0' && h <= '9') code |= (uint32_t)(h - '0');
+                        else if (h >= 'a' && h <= 'f') code |= (uint32_t)(h - 'a' + 10);
+                        else if (h >= 'A' && h <= 'F') code |= (uint32_t)(h - 'A' + 10);
+                        else return fail("bad \\u escape");
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default:
+                    return fail("bad escape");
+            }
+        }
+        return fail("unterminated string");
+    }
+
+    bool parseNumber(double* out) {
+        skipSpace();
+        size_t start = _pos;
+        if (_pos < _length && _text[_pos] == '-') _pos++;
+        if (!digits()) {
+            return fail("expected number");
+        }
+        if (_pos < _length && _text[_pos] == '.') {
+            _pos++;
+            if (!digits()) return fail("expected digits after '.'");
+        }
+        if (_pos < _length && (_text[_pos] == 'e' || _text[_pos] == 'E')) {
+            _pos++;
+            if (_pos < _length && (_text[_pos] == '+' || _text[_pos] == '-')) _pos++;
+            if (!digits()) return fail("expected exponent");
+        }
+        if (_pos - start >= PERF_NUMBER_MAX) {
+            return fail("number too long");
+        }
+        char literal[PERF_NUMBER_MAX];
+        memcpy(literal, _text + start, _pos - start);
+        literal[_pos - start] = '\0';
+        *out = strtod(literal, NULL);
+        return true;
+    }
+
+    /**
+     * Non-negative integer that fits 32 bits (sample and failure counts)
+     */
+    bool parseCount(uint32_t* out) {
+        double value;
+        if (!parseNumber(&value)) {
+            return false;
+        }
+        if (value < 0.0 || value > 4294967295.0 || value != (double)(uint32_t)value) {
+            return fail("expected a count");
+        }
+        *out = (uint32_t)value;
+        return true;
+    }
+
+    bool parseFloat(float* out) {
+        double value;
+        if (!parseNumber(&value)) {
+            return false;
+        }
+        *out = (float)value;
+        return true;
+    }
+
+    bool skipValue(int depth) {
+        if (depth > PERF_REPORT_DEPTH_MAX) {
+            return fail("nesting too deep");
+        }
+        skipSpace();
+        if (_pos >= _length) {
+            return fail("unexpected end");
+        }
+        char c = _text[_pos];
+        if (c == '"') {
+            std::string ignored;
+            return parseString(&ignored);
+        }
+        if (c == '{' || c == '[') {
+            char close = c == '{' ? '}' : ']';
+            _pos++;
+            if (accept(close)) {
+                return true;
+            }
+            do {
+                if (c == '{') {
+                    std::string key;
+                    if (!parseString(&key) || !expect(':')) return false;
+                }
+                if (!skipValue(depth + 1)) return false;
+            } while (accept(','));
+            return expect(close);
+        }
+        if (literal("true") || literal("false") || literal("null")) {
+            return true;
+        }
+        double ignored;
+        return parseNumber(&ignored);
+    }
+
+private:
+    bool digits() {
+        size_t start = _pos;
+        while (_pos < _length && _text[_pos] >= '0' && _text[_pos] <= '9') {
+            _pos++;
+        }
+        return _pos > start;
+    }
+
+    bool literal(const char* word) {
+        size_t n = strlen(word);
+        if (_length - _pos >= n && memcmp(_text + _pos, word, n) == 0) {
+            _pos += n;
+            return true;
+        }
+        return false;
+    }
+
+    static void appendUtf8(std::string* out, uint32_t code) {
+        if (code < 0x80) {
+            out->push_back((char)code);
+        } else if (code < 0x800) {
+            out->push_back((char)(0xC0 | (code >> 6)));
+            out->push_back((char)(0x80 | (code & 0x3F)));
+        } else {
+            out->push_back((char)(0xE0 | (code >> 12)));
+            out->push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            out->push_back((char)(0x80 | (code & 0x3F)));
+        }
+    }
+
+    const char* _text;
+    size_t _length;
+    size_t _pos;
+    std::string* _error;
+    bool _failed;
+};
+
+}  // namespace
+
+static bool parseCase(JsonReader& json, PerfReportCase_t* out) {
+    memset(&out->stats, 0, sizeof(out->stats));
+    out->name.clear();
+    bool named = false;
+
+    if (!json.expect('{')) {
+        return false;
+    }
+    if (json.accept('}')) {
+        return json.fail("case without a name");
+    }
+    do {
+        std::string key;
+        if (!json.parseString(&key) || !json.expect(':')) return false;
+
+        bool ok;
+        if (key == "name") { ok = json.parseString(&out->name); named = true; }
+        else if (key == "n") ok = json.parseCount(&out->stats.samples);
+        else if (key == "failures") ok = json.parseCount(&out->stats.failures);
+        else if (key == "min_us") ok = json.parseFloat(&out->stats.min_us);
+        else if (key == "p50_us") ok = json.parseFloat(&out->stats.p50_us);
+        else if (key == "p90_us") ok = json.parseFloat(&out->stats.p90_us);
+        else if (key == "p99_us") ok = json.parseFloat(&out->stats.p99_us);
+        else if (key == "max_us") ok = json.parseFloat(&out->stats.max_us);
+        else if (key == "mean_us") ok = json.parseFloat(&out->stats.mean_us);
+        else ok = json.skipValue(1);
+        if (!ok) return false;
+    } while (json.accept(','));
+
+    if (!json.expect('}')) {
+        return false;
+    }
+    return named || json.fail("case without a name");
+}
+
+static bool schemaSupported(const std::string& schema) {
+    size_t prefix = strlen(PERF_SCHEMA_PREFIX);
+    if (schema.compare(0, prefix, PERF_SCHEMA_PREFIX) != 0 || schema.size() == prefix) {
+        return false;
+    }
+    return atoi(schema.c_str() + prefix) == PERF_SCHEMA_MAJOR;
+}
+
+/**
+ * Offset of the first '{' whose first key is "schema", or length
+ */
+static size_t findReport(const char* text, size_t length) {
+    static const char KEY[] = "\"schema\"";
+
+    for (size_t start = 0; start < length; start++) {
+        if (text[start] != '{') {
+            continue;
+        }
+        size_t key = start + 1;
+        while (key < length && (text[key] == ' ' || text[key] == '\t' || text[key] == '\r' || text[key] == '\n')) {
+            key++;
+        }
+        if (length - key >= sizeof(KEY) - 1 && memcmp(text + key, KEY, sizeof(KEY) - 1) == 0) {
+            return start;
+        }
+    }
+    return length;
+}
+
+bool perfReportParse(const char* text, size_t length, PerfReport_t* out, std::string* error) {
+    out->schema.clear();
+    out->firmware.clear();
+    out->target.clear();
+    out->device.clear();
+    out->cases.clear();
+
+    JsonReader json(text, length, error);
+    size_t start = findReport(text, length);
+    if (start == length) {
+        return json.fail("no {\"schema\" report found");
+    }
+    json.seek(start);
+
+    if (!json.expect('{')) {
+        return false;
+    }
+    do {
+        std::string key;
+        if (!json.parseString(&key) || !json.expect(':')) return false;
+
+        bool ok;
+        if (key == "schema") {
+            ok = json.parseString(&out->schema);
+            if (ok && !schemaSupported(out->schema)) {
+                return json.fail("unsupported schema version");
+            }
+        } else if (key == "firmware") {
+            ok = json.parseString(&out->firmware);
+        } else if (key == "target") {
+            ok = json.parseString(&out->target);
+        } else if (key == "device") {
+            ok = json.parseString(&out->device);
+        } else if (key == "cases") {
+            ok = json.expect('[');
+            if (ok && !json.accept(']')) {
+                do {
+                    out->cases.push_back(PerfReportCase_t());
+                    ok = parseCase(json, &out->cases.back());
+                } while (ok && json.accept(','));
+                ok = ok && json.expect(']');
+            }
+        } else {
+            ok = json.skipValue(1);
+        }
+        if (!ok) return false;
+    } while (json.accept(','));
+
+    return json.expect('}');
+}
+
+const PerfReportCase_t* perfReportFind(const PerfReport_t& report, const char* name) {
+    for (size_t i = 0; i < report.cases.size(); i++) {
+        if (report.cases[i].name == name) {
+            return &report.cases[i];
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// Comparison
+// ============================================================================
+
+void perfCompareDefaults(PerfCompareConfig_t* config, const char* target) {
+    bool host = target && strcmp(target, "host") == 0;
+    config->tolerance_pct = host ? PERF_COMPARE_HOST_TOLERANCE_PCT : PERF_COMPARE_TOLERANCE_PCT;
+    config->tail_tolerance_pct = host ? 0.0f : PERF_COMPARE_TAIL_TOLERANCE_PCT;
+    config->floor_us = host ? PERF_COMPARE_HOST_FLOOR_US : PERF_COMPARE_FLOOR_US;
+    config->min_samples = PERF_COMPARE_MIN_SAMPLES;
+}
+
+static float changePct(float baseline, float candidate) {
+    return baseline > 0.0f ? 100.0f * (candidate - baseline) / baseline : 0.0f;
+}
+
+static bool grewBeyond(float baseline, float candidate, float tolerance_pct, float floor_us) {
+    return candidate - baseline > floor_us && candidate > baseline * (1.0f + tolerance_pct / 100.0f);
+}
+
+static void setResult(PerfComparison_t* result, PerfVerdict_t verdict, const char* metric,
+                      float baseline, float candidate) {
+    result->verdict = verdict;
+    result->metric = metric;
+    result->baseline = baseline;
+    result->candidate = candidate;
+    result->change_pct = changePct(baseline, candidate);
+}
+
+static void compareCase(const PerfBenchStats_t& base, const PerfBenchStats_t& cand,
+                        const PerfCompareConfig_t& config, PerfComparison_t* result) {
+    if (base.samples < config.min_samples || cand.samples < config.min_samples) {
+        setResult(result, PERF_VERDICT_SKIPPED, "n", (float)base.samples, (float)cand.samples);
+        return;
+    }
+
+    // Failure rate in percent of samples (a batch can fail more than once)
+    float base_failures = 100.0f * base.failures / base.samples;
+    float cand_failures = 100.0f * cand.failures / cand.samples;
+    if (cand.failures > 0 && cand_failures > base_failures) {
+        setResult(result, PERF_VERDICT_REGRESSED, "failures", (float)base.failures, (float)cand.failures);
+        return;
+    }
+
+    if (grewBeyond(base.p50_us, cand.p50_us, config.tolerance_pct, config.floor_us)) {
+        setResult(result, PERF_VERDICT_REGRESSED, "p50_us", base.p50_us, cand.p50_us);
+    } else if (config.tail_tolerance_pct > 0.0f &&
+               grewBeyond(base.p99_us, cand.p99_us, config.tail_tolerance_pct, config.floor_us)) {
+        setResult(result, PERF_VERDICT_REGRESSED, "p99_us", base.p99_us, cand.p99_us);
+    } else if (grewBeyond(cand.p50_us, base.p50_us, config.tolerance_pct, config.floor_us)) {
+        setResult(result, PERF_VERDICT_IMPROVED, "p50_us", base.p50_us, cand.p50_us);
+    } else {
+        setResult(result, PERF_VERDICT_SAME, "p50_us", base.p50_us, cand.p50_us);
+    }
+}
+
+size_t perfCompare(const PerfReport_t& baseline, const PerfReport_t& candidate,
+                   const PerfCompareConfig_t& config, std::vector<PerfComparison_t>* out) {
+    out->clear();
+    size_t failing = 0;
+
+    for (size_t i = 0; i < baseline.cases.size(); i++) {
+        const PerfReportCase_t& base = baseline.cases[i];
+        const PerfReportCase_t* cand = perfReportFind(candidate, base.name.c_str());
+
+        PerfComparison_t result;
+        result.name = base.name;
+        if (!cand) {
+            setResult(&result, PERF_VERDICT_MISSING, "n", (float)base.stats.samples, 0.0f);
+        } else {
+            compareCase(base.stats, cand->stats, config, &result);
+        }
+        if (result.verdict == PERF_VERDICT_REGRESSED || result.verdict == PERF_VERDICT_MISSING) {
+            failing++;
+        }
+        out->push_back(result);
+    }
+
+    for (size_t i = 0; i < candidate.cases.size(); i++) {
+        const PerfReportCase_t& cand = candidate.cases[i];
+        if (!perfReportFind(baseline, cand.name.c_str())) {
+            PerfComparison_t result;
+            result.name = cand.name;
+            setResult(&result, PERF_VERDICT_ADDED, "p50_us", 0.0f, cand.stats.p50_us);
+            out->push_back(result);
+        }
+    }
+    return failing;
+}
+
+const char* perfVerdictName(PerfVerdict_t verdict) {
+    switch (verdict) {
+        case PERF_VERDICT_SAME: return "same";
+        case PERF_VERDICT_IMPROVED: return "improved";
+        case PERF_VERDICT_REGRESSED: return "REGRESSED";
+        case PERF_VERDICT_MISSING: return "MISSING";
+        case PERF_VERDICT_ADDED: return "added";
+        case PERF_VERDICT_SKIPPED: return "skipped";
+        default: return "unknown";
+    }
+}
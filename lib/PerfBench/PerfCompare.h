@@ -0,0 +1,101 @@
+/**
+ * ============================================================================
+ * BINSAI Performance Report Comparison (host only)
+ * Reads binsai-perf reports back and flags regressions between versions
+ * ============================================================================
+ *
+ * - The parser is a small recursive-descent JSON reader. It starts at the
+ *   first `{"schema"` in the text, so a raw Unity log or a serial capture
+ *   (without per-line prefixes such as the monitor's time filter) can be
+ *   passed as is; anything after the closing brace is ignored
+ * - A case regresses when its median or p99 grows by more than the
+ *   tolerance AND by more than an absolute floor (a 3 us case doubling to
+ *   6 us is timer noise on the ESP32), or when its failure rate rises.
+ *   p99 gets a wider tolerance: with 20 samples it is the maximum. Host
+ *   reports time batched sub-microsecond cases on shared machines: a
+ *   10 ns floor, a wider median tolerance and no tail check (a host p99
+ *   is the scheduler, not the code)
+ * - Cases with fewer than min_samples on either side are skipped (the
+ *   sensor or uplink was not there); a case that disappears is flagged
+ * ============================================================================
+ */
+
+#ifndef BINSAI_PERF_COMPARE_H
+#define BINSAI_PERF_COMPARE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "PerfBench.h"
+
+#define PERF_COMPARE_TOLERANCE_PCT      10.0f   // Median
+#define PERF_COMPARE_TAIL_TOLERANCE_PCT 25.0f   // p99
+#define PERF_COMPARE_FLOOR_US           20.0f   // ESP32 micros() jitter
+#define PERF_COMPARE_HOST_TOLERANCE_PCT 25.0f   // Shared CI runners drift ~10% per run
+#define PERF_COMPARE_HOST_FLOOR_US      0.010f  // Batched host cases: 10 ns
+#define PERF_COMPARE_MIN_SAMPLES        5
+#define PERF_REPORT_DEPTH_MAX           8       // Nesting accepted in unknown fields
+
+typedef struct {
+    std::string name;
+    PerfBenchStats_t stats;
+} PerfReportCase_t;
+
+typedef struct {
+    std::string schema;
+    std::string firmware;
+    std::string target;
+    std::string device;
+    std::vector<PerfReportCase_t> cases;
+} PerfReport_t;
+
+/**
+ * Parse the first report in text
+ * @param error Receives "offset N: reason" on failure (may be NULL)
+ * @return false on malformed JSON, a missing schema or another major version
+ */
+bool perfReportParse(const char* text, size_t length, PerfReport_t* out, std::string* error);
+
+const PerfReportCase_t* perfReportFind(const PerfReport_t& report, const char* name);
+
+typedef enum {
+    PERF_VERDICT_SAME = 0,
+    PERF_VERDICT_IMPROVED,
+    PERF_VERDICT_REGRESSED,
+    PERF_VERDICT_MISSING,           // In the baseline only
+    PERF_VERDICT_ADDED,             // In the candidate only
+    PERF_VERDICT_SKIPPED            // Too few samples to judge
+} PerfVerdict_t;
+
+typedef struct {
+    float tolerance_pct;
+    float tail_tolerance_pct;       // 0 disables the p99 check
+    float floor_us;
+    uint32_t min_samples;
+} PerfCompareConfig_t;
+
+typedef struct {
+    std::string name;
+    PerfVerdict_t verdict;
+    const char* metric;             // "p50_us", "p99_us", "failures" (what decided it)
+    float baseline;
+    float candidate;
+    float change_pct;               // Relative to the baseline, 0 if it was 0
+} PerfComparison_t;
+
+/**
+ * Thresholds for reports of a target ("host" gets a nanosecond floor and
+ * wider tolerances, anything else the ESP32 values)
+ */
+void perfCompareDefaults(PerfCompareConfig_t* config, const char* target);
+
+/**
+ * Compare case by case, baseline order first, then added cases
+ * @return Number of cases that fail the comparison (regressed or missing)
+ */
+size_t perfCompare(const PerfReport_t& baseline, const PerfReport_t& candidate,
+                   const PerfCompareConfig_t& config, std::vector<PerfComparison_t>* out);
+
+const char* perfVerdictName(PerfVerdict_t verdict);
+
+#endif  // BINSAI_PERF_COMPARE_H
@@ -0,0 +1,126 @@
+/**
+ * BINSAI Probe Array - trigger schedule, health scores and fusion
+ */
+
+#include "ProbeArray.h"
+#include <math.h>
+
+uint8_t probeTriggerSlot(uint8_t probe, uint8_t round, uint8_t count) {
+    return (uint8_t)((probe + round) % count);
+}
+
+uint8_t probeInSlot(uint8_t slot, uint8_t round, uint8_t count) {
+    return (uint8_t)((slot + count - round % count) % count);
+}
+
+uint32_t probeStaggerUs(uint8_t round, uint8_t count) {
+    return PROBE_STAGGER_US + (uint32_t)((round / count) % PROBE_DITHER_STEPS) * PROBE_DITHER_US;
+}
+
+uint32_t probeRoundPeriodUs(uint8_t count, float sound_speed_cm_us) {
+    uint32_t widest = PROBE_STAGGER_US + (PROBE_DITHER_STEPS - 1) * PROBE_DITHER_US;
+    return burstPingPeriodUs(sound_speed_cm_us) + (uint32_t)(count - 1) * widest;
+}
+
+void probeHealthInit(ProbeHealth_t* health) {
+    health->score = 100;
+    health->failure_streak = 0;
+    health->bursts = 0;
+    health->failed_bursts = 0;
+}
+
+void probeHealthUpdate(ProbeHealth_t* health, bool valid, uint8_t confidence) {
+    int16_t target = valid ? confidence : 0;
+    int16_t score = health->score;
+    int16_t step = (target - score) / PROBE_HEALTH_GAIN;
+    if (step == 0 && target != score) {
+        step = target > score ? 1 : -1;     // Always converge
+    }
+    health->score = (uint8_t)(score + step);
+
+    health->bursts++;
+    if (valid) {
+        health->failure_streak = 0;
+    } else {
+        health->failed_bursts++;
+        if (health->failure_streak < UINT8_MAX) health->failure_streak++;
+    }
+}
+
+/**
+ * Waste height / bin height, clamped to 0-1 (0 for NaN or a bad height)
+ */
+static float fillFraction(float distance_cm, float bin_height_cm) {
+    float fill = 1.0f - distance_cm / bin_height_cm;
+    if (!(fill > 0.0f) || !(bin_height_cm > 0.0f)) return 0.0f;
+    if (fill > 1.0f) return 1.0f;
+    return fill;
+}
+
+float probeFillPercentage(float distance_cm, float bin_height_cm) {
+    return fillFraction(distance_cm, bin_height_cm) * 100.0f;
+}
+
+bool probeArrayFuse(const BurstEstimate_t* estimates, const bool* valid, const ProbeHealth_t* health,
+                    uint8_t count, float bin_height_cm, ProbeFusion_t* fusion) {
+    if (count > PROBE_ARRAY_MAX) {
+        count = PROBE_ARRAY_MAX;
+    }
+
+    fusion->distance_cm = 0.0f;
+    fusion->fill_percentage = 0.0f;
+    fusion->peak_fill_percentage = 0.0f;
+    fusion->spread_cm = 0.0f;
+    fusion->confidence = 0;
+    fusion->used = 0;
+    fusion->degraded = false;
+
+    // Healthy probes with a reading; all probes with a reading as fallback
+    bool use[PROBE_ARRAY_MAX];
+    uint8_t used = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        use[i] = valid[i] && probeHealthy(&health[i]);
+        if (use[i]) used++;
+    }
+    if (used == 0) {
+        for (uint8_t i = 0; i < count; i++) {
+            use[i] = valid[i];
+            if (use[i]) used++;
+        }
+        fusion->degraded = used > 0;
+    }
+    if (used == 0) {
+        return false;
+    }
+
+    float fill_sum = 0.0f;
+    float distance_sum = 0.0f;
+    float distance_sq_sum = 0.0f;
+    float spread_sq_sum = 0.0f;
+    uint32_t confidence_sum = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (!use[i]) continue;
+        float fill = fillFraction(estimates[i].distance_cm, bin_height_cm);
+        fill_sum += fill;
+        if (fill * 100.0f > fusion->peak_fill_percentage) {
+            fusion->peak_fill_percentage = fill * 100.0f;
+        }
+        distance_sum += estimates[i].distance_cm;
+        distance_sq_sum += estimates[i].distance_cm * estimates[i].distance_cm;
+        spread_sq_sum += estimates[i].spread_cm * estimates[i].spread_cm;
+        confidence_sum += estimates[i].confidence;
+    }
+
+    float fill = fill_sum / used;
+    fusion->fill_percentage = fill * 100.0f;
+    fusion->distance_cm = (1.0f - fill) * bin_height_cm;
+
+    float mean = distance_sum / used;
+    float between = distance_sq_sum / used - mean * mean;
+    if (between < 0.0f) between = 0.0f;     // Rounding
+    fusion->spread_cm = sqrtf(spread_sq_sum / used + between);
+
+    fusion->confidence = (uint8_t)((confidence_sum / used) * used / count);
+    fusion->used = used;
+    return true;
+}
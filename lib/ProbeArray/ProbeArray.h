@@ -0,0 +1,123 @@
+/**
+ * ============================================================================
+ * BINSAI Probe Array
+ * Scheduling, health scoring and volumetric fusion for 1-4 HC-SR04 probes
+ * ============================================================================
+ *
+ * SCHEDULING:
+ * - A round triggers every probe once, a stagger apart, and the echoes
+ *   are captured concurrently (edge interrupts in the firmware)
+ * - The trigger order rotates every round and the stagger steps through
+ *   PROBE_DITHER_STEPS values every full rotation. An echo a probe picks
+ *   up from a neighbour's ping is shifted by the stagger between them, so
+ *   it lands at a different apparent distance (or outside the window)
+ *   from round to round while the probe's own echo stays put; the burst
+ *   outlier test (lib/UltrasonicBurst) removes it
+ * - Rounds are spaced like single-probe bursts plus the widest stagger
+ *   span
+ *
+ * HEALTH (per probe, 0-100):
+ * - Exponential average of burst confidence (0 for a failed burst) with
+ *   weight 1 / PROBE_HEALTH_GAIN; new probes start at 100
+ * - Below PROBE_HEALTHY_SCORE a probe is left out of the fusion while it
+ *   has healthy peers with a reading
+ *
+ * FUSION:
+ * - Probes are mounted so each covers an equal share of the opening; the
+ *   volumetric fill is the mean of their fill fractions (waste height /
+ *   bin height, clamped)
+ * - distance_cm is the single-probe distance that gives the same fill,
+ *   so the firmware fill pipeline is unchanged
+ * - spread_cm pools in-burst spread and probe-to-probe differences:
+ *   sqrt(mean(spread_i^2) + variance(distance_i))
+ * - confidence = (probes used / probes fitted) x mean burst confidence
+ *
+ * Distances are acoustic (sensor face to surface), as in UltrasonicBurst.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_PROBE_ARRAY_H
+#define BINSAI_PROBE_ARRAY_H
+
+#include <stdint.h>
+#include "UltrasonicBurst.h"
+
+#define PROBE_ARRAY_MAX             4
+#define PROBE_STAGGER_US            3000      // Base trigger spacing inside a round
+#define PROBE_DITHER_US             600       // Stagger step (~10 cm of apparent distance)
+#define PROBE_DITHER_STEPS          4
+#define PROBE_HEALTH_GAIN           4         // Score moves 1/4 of the way per burst
+#define PROBE_HEALTHY_SCORE         40
+
+/**
+ * Per-probe health, kept across readings
+ */
+typedef struct {
+    uint8_t score;                  // 0-100
+    uint8_t failure_streak;         // Consecutive failed bursts (saturates)
+    uint32_t bursts;
+    uint32_t failed_bursts;
+} ProbeHealth_t;
+
+/**
+ * Fused reading of all probes
+ */
+typedef struct {
+    float distance_cm;              // Single-probe equivalent of fill_percentage
+    float fill_percentage;          // Volumetric fill (0-100)
+    float peak_fill_percentage;     // Highest probe (0-100)
+    float spread_cm;                // Pooled surface roughness
+    uint8_t confidence;             // 0-100
+    uint8_t used;                   // Probes in the estimate
+    bool degraded;                  // No healthy probe had a reading; all valid ones used
+} ProbeFusion_t;
+
+/**
+ * Position of a probe in the trigger order of a round (0 = first)
+ */
+uint8_t probeTriggerSlot(uint8_t probe, uint8_t round, uint8_t count);
+
+/**
+ * Probe fired in a given slot (inverse of probeTriggerSlot)
+ */
+uint8_t probeInSlot(uint8_t slot, uint8_t round, uint8_t count);
+
+/**
+ * Trigger spacing between consecutive slots of a round
+ */
+uint32_t probeStaggerUs(uint8_t round, uint8_t count);
+
+/**
+ * Minimum start-to-start spacing between rounds
+ */
+uint32_t probeRoundPeriodUs(uint8_t count, float sound_speed_cm_us);
+
+void probeHealthInit(ProbeHealth_t* health);
+
+/**
+ * Score one burst
+ * @param valid burstEstimate() succeeded
+ */
+void probeHealthUpdate(ProbeHealth_t* health, bool valid, uint8_t confidence);
+
+inline bool probeHealthy(const ProbeHealth_t* health) {
+    return health->score >= PROBE_HEALTHY_SCORE;
+}
+
+/**
+ * Fill level of one distance (sensor face to surface minus the mounting
+ * offset), clamped to 0-100; NaN and infinite distances give 0 or 100,
+ * never NaN
+ */
+float probeFillPercentage(float distance_cm, float bin_height_cm);
+
+/**
+ * Fuse per-probe burst estimates
+ * @param valid Result of burstEstimate() per probe
+ * @param bin_height_cm Acoustic distance of an empty bin
+ * @return false if no probe has a reading
+ */
+bool probeArrayFuse(const BurstEstimate_t* estimates, const bool* valid, const ProbeHealth_t* health,
+                    uint8_t count, float bin_height_cm, ProbeFusion_t* fusion);
+
+#endif  // BINSAI_PROBE_ARRAY_H
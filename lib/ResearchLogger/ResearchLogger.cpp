@@ -0,0 +1,323 @@
+/**
+ * BINSAI Research Logger - record codec, block writer and replay
+ */
+
+#include "ResearchLogger.h"
+#include "ConfigStore.h"
+#include <math.h>
+#include <string.h>
+
+static void putU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void putU32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t getU16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * Scale and saturate a float into an unsigned 16-bit fixed point field
+ */
+static uint16_t scaleU16(float value, float scale) {
+    float scaled = value * scale + 0.5f;
+    if (!(scaled > 0.0f)) return 0;
+    if (scaled > 65535.0f) return 65535;
+    return (uint16_t)scaled;
+}
+
+void researchLogEncodeRecord(const ResearchLogRecord_t& record, uint8_t* out) {
+    memset(out, 0, RESEARCH_LOG_RECORD_SIZE);
+    putU32(out + 0, record.millis);
+    putU32(out + 4, (uint32_t)((uint64_t)record.unix_ms & 0xFFFFFFFFULL));
+    putU32(out + 8, (uint32_t)((uint64_t)record.unix_ms >> 32));
+    putU16(out + 12, scaleU16(record.distance_cm, 100.0f));
+    putU16(out + 14, scaleU16(record.fill_percentage, 100.0f));
+    putU16(out + 16, scaleU16(record.ppm_calculated, 10.0f));
+    putU16(out + 18, record.adc_raw);
+    putU32(out + 20, (uint32_t)(int32_t)lround(record.latitude * 1e7));
+    putU32(out + 24, (uint32_t)(int32_t)lround(record.longitude * 1e7));
+    out[28] = record.satellite_count;
+    out[29] = record.gps_fix ? RESEARCH_LOG_FLAG_GPS_FIX : 0;
+    out[30] = record.capacity_level;
+    out[31] = record.waste_classification;
+    out[32] = record.priority_level;
+
+    float hours = record.hours_to_full < 0.0f ? -1.0f : record.hours_to_full;
+    float deci = hours * 10.0f;
+    if (deci > 32767.0f) deci = 32767.0f;
+    putU16(out + 34, (uint16_t)(int16_t)lroundf(deci));
+}
+
+void researchLogDecodeRecord(const uint8_t* data, ResearchLogRecord_t* record) {
+    record->millis = getU32(data + 0);
+    record->unix_ms = (int64_t)((uint64_t)getU32(data + 4) | ((uint64_t)getU32(data + 8) << 32));
+    record->distance_cm = getU16(data + 12) / 100.0f;
+    record->fill_percentage = getU16(data + 14) / 100.0f;
+    record->ppm_calculated = getU16(data + 16) / 10.0f;
+    record->adc_raw = getU16(data + 18);
+    record->latitude = (int32_t)getU32(data + 20) / 1e7;
+    record->longitude = (int32_t)getU32(data + 24) / 1e7;
+    record->satellite_count = data[28];
+    record->gps_fix = (data[29] & RESEARCH_LOG_FLAG_GPS_FIX) != 0;
+    record->capacity_level = data[30];
+    record->waste_classification = data[31];
+    record->priority_level = data[32];
+    int16_t deci = (int16_t)getU16(data + 34);
+    record->hours_to_full = deci < 0 ? -1.0f : deci / 10.0f;
+}
+
+bool researchLogCheckBlock(const uint8_t* block, uint32_t* sequence, uint16_t* count) {
+    if (getU32(block) != RESEARCH_LOG_MAGIC || block[12] != RESEARCH_LOG_VERSION ||
+        block[13] != RESEARCH_LOG_RECORD_SIZE || getU16(block + 14) > RESEARCH_LOG_BLOCK_RECORDS) {
+        return false;
+    }
+    if (configCrc32(block + 8, RESEARCH_LOG_BLOCK_SIZE - 8) != getU32(block + 4)) {
+        return false;
+    }
+    *sequence = getU32(block + 8);
+    *count = getU16(block + 14);
+    return true;
+}
+
+ResearchLogger::ResearchLogger(ResearchLogBackend& backend)
+    : _backend(backend), _ready(false), _have_files(false), _file_open(false), _oldest_index(0),
+      _next_index(0), _file_index(0), _file_bytes(0), _used_bytes(0), _sequence(0), _unsynced(0),
+      _staged(0), _first_staged_ms(0) {
+    memset(&_config, 0, sizeof(_config));
+    memset(&_stats, 0, sizeof(_stats));
+    memset(_block, 0, sizeof(_block));
+}
+
+bool ResearchLogger::begin(const ResearchLogConfig_t& config) {
+    _config = config;
+    _config.file_bytes -= _config.file_bytes % RESEARCH_LOG_BLOCK_SIZE;
+    if (_config.file_bytes < RESEARCH_LOG_BLOCK_SIZE) {
+        _config.file_bytes = RESEARCH_LOG_BLOCK_SIZE;
+    }
+    if (_config.budget_bytes < _config.file_bytes) {
+        _config.budget_bytes = _config.file_bytes;
+    }
+    if (_config.sync_blocks == 0) {
+        _config.sync_blocks = 1;
+    }
+
+    _file_open = false;
+    _staged = 0;
+    _unsynced = 0;
+    _used_bytes = 0;
+    _sequence = 0;
+    _oldest_index = 0;
+    _next_index = 0;
+
+    uint32_t first, last;
+    _have_files = _backend.fileRange(&first, &last);
+    if (_have_files) {
+        _oldest_index = first;
+        _next_index = last + 1;
+        for (uint32_t index = first; index <= last; index++) {
+            _used_bytes += _backend.fileSize(index);
+        }
+
+        // Continue the sequence after the newest intact block
+        bool found = false;
+        for (uint32_t index = last + 1; index-- > first && !found;) {
+            uint32_t blocks = _backend.fileSize(index) / RESEARCH_LOG_BLOCK_SIZE;
+            while (blocks-- > 0) {
+                uint32_t sequence;
+                uint16_t count;
+                if (_backend.readFile(index, blocks * RESEARCH_LOG_BLOCK_SIZE, _block, RESEARCH_LOG_BLOCK_SIZE) &&
+                    researchLogCheckBlock(_block, &sequence, &count)) {
+                    _sequence = sequence + 1;
+                    found = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    memset(_block, 0, sizeof(_block));
+    _ready = true;
+    return true;
+}
+
+bool ResearchLogger::append(const ResearchLogRecord_t& record, uint32_t now_ms) {
+    if (!_ready) {
+        return false;
+    }
+    if (_staged == 0) {
+        _first_staged_ms = now_ms;
+    }
+    researchLogEncodeRecord(record, _block + RESEARCH_LOG_HEADER_SIZE + _staged * RESEARCH_LOG_RECORD_SIZE);
+    _staged++;
+    _stats.records++;
+
+    if (_staged == RESEARCH_LOG_BLOCK_RECORDS) {
+        return writeBlock();
+    }
+    return true;
+}
+
+void ResearchLogger::loop(uint32_t now_ms) {
+    if (_ready && _staged > 0 && _config.flush_interval_ms > 0 &&
+        now_ms - _first_staged_ms >= _config.flush_interval_ms) {
+        flush();
+    }
+}
+
+bool ResearchLogger::flush() {
+    if (!_ready) {
+        return false;
+    }
+    if (_staged > 0) {
+        _stats.partial_blocks++;
+        if (!writeBlock()) {
+            return false;
+        }
+    }
+    if (_file_open && _unsynced > 0) {
+        _unsynced = 0;
+        _stats.syncs++;
+        if (!_backend.sync()) {
+            _stats.write_errors++;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ResearchLogger::rotate() {
+    if (_file_open) {
+        if (_unsynced > 0) {
+            _unsynced = 0;
+            _stats.syncs++;
+            if (!_backend.sync()) {
+                _stats.write_errors++;
+            }
+        }
+        _backend.close();
+        _file_open = false;
+    }
+
+    // Make room for a full new file, oldest first
+    while (_have_files && _oldest_index < _next_index &&
+           _used_bytes + _config.file_bytes > _config.budget_bytes) {
+        uint32_t size = _backend.fileSize(_oldest_index);
+        if (!_backend.removeFile(_oldest_index)) {
+            break;
+        }
+        _used_bytes = size < _used_bytes ? _used_bytes - size : 0;
+        _stats.files_removed++;
+        _oldest_index++;
+    }
+
+    if (!_backend.openAppend(_next_index)) {
+        return false;
+    }
+    if (!_have_files) {
+        _oldest_index = _next_index;
+        _have_files = true;
+    }
+    _file_index = _next_index++;
+    _file_bytes = 0;
+    _file_open = true;
+    _stats.files_opened++;
+    return true;
+}
+
+bool ResearchLogger::writeBlock() {
+    uint16_t count = _staged;
+    _staged = 0;
+
+    putU32(_block + 0, RESEARCH_LOG_MAGIC);
+    putU32(_block + 8, _sequence++);
+    _block[12] = RESEARCH_LOG_VERSION;
+    _block[13] = RESEARCH_LOG_RECORD_SIZE;
+    putU16(_block + 14, count);
+    size_t used = RESEARCH_LOG_HEADER_SIZE + count * RESEARCH_LOG_RECORD_SIZE;
+    memset(_block + used, 0, RESEARCH_LOG_BLOCK_SIZE - used);
+    putU32(_block + 4, configCrc32(_block + 8, RESEARCH_LOG_BLOCK_SIZE - 8));
+
+    bool written = (_file_open && _file_bytes + RESEARCH_LOG_BLOCK_SIZE <= _config.file_bytes) || rotate();
+    written = written && _backend.append(_block, RESEARCH_LOG_BLOCK_SIZE);
+    if (!written) {
+        // Next block goes to a fresh file; the lost sequence shows as a gap
+        _stats.write_errors++;
+        _stats.records_dropped += count;
+        if (_file_open) {
+            _backend.close();
+            _file_open = false;
+        }
+        return false;
+    }
+
+    _file_bytes += RESEARCH_LOG_BLOCK_SIZE;
+    _used_bytes += RESEARCH_LOG_BLOCK_SIZE;
+    _stats.blocks++;
+    _stats.records_written += count;
+    _stats.bytes_written += RESEARCH_LOG_BLOCK_SIZE;
+
+    if (++_unsynced >= _config.sync_blocks) {
+        _unsynced = 0;
+        _stats.syncs++;
+        if (!_backend.sync()) {
+            _stats.write_errors++;
+            return false;
+        }
+    }
+    return true;
+}
+
+void researchLogReplay(ResearchLogBackend& backend, ResearchLogVisitor_t visit, void* context,
+                       ResearchLogScan_t* scan) {
+    memset(scan, 0, sizeof(*scan));
+    uint32_t first, last;
+    if (!backend.fileRange(&first, &last)) {
+        return;
+    }
+
+    uint8_t block[RESEARCH_LOG_BLOCK_SIZE];
+    bool have_sequence = false;
+    uint32_t expected = 0;
+    for (uint32_t index = first; index <= last; index++) {
+        uint32_t blocks = backend.fileSize(index) / RESEARCH_LOG_BLOCK_SIZE;
+        if (blocks > 0) {
+            scan->files++;
+        }
+        for (uint32_t b = 0; b < blocks; b++) {
+            uint32_t sequence;
+            uint16_t count;
+            if (!backend.readFile(index, b * RESEARCH_LOG_BLOCK_SIZE, block, sizeof(block)) ||
+                !researchLogCheckBlock(block, &sequence, &count)) {
+                scan->corrupt_blocks++;
+                continue;
+            }
+            if (have_sequence && sequence != expected) {
+                scan->sequence_gaps += sequence > expected ? sequence - expected : 1;
+            }
+            have_sequence = true;
+            expected = sequence + 1;
+            scan->blocks++;
+
+            for (uint16_t i = 0; i < count; i++) {
+                ResearchLogRecord_t record;
+                researchLogDecodeRecord(block + RESEARCH_LOG_HEADER_SIZE + i * RESEARCH_LOG_RECORD_SIZE, &record);
+                scan->records++;
+                if (visit) {
+                    visit(record, context);
+                }
+            }
+        }
+    }
+}
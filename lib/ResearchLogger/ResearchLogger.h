@@ -0,0 +1,227 @@
+/**
+ * ============================================================================
+ * BINSAI Research Logger
+ * Durable on-device research log: staged records, aligned CRC blocks,
+ * rotating append-only files
+ * ============================================================================
+ *
+ * RECORD LAYOUT (little-endian, RESEARCH_LOG_RECORD_SIZE bytes):
+ *  off size field
+ *    0   4  millis
+ *    4   8  unix_ms (0 = clock not synced)
+ *   12   2  distance (0.01 cm)
+ *   14   2  fill_percentage (0.01 %)
+ *   16   2  ppm (0.1 ppm)
+ *   18   2  adc_raw
+ *   20   4  latitude  (1e-7 deg)
+ *   24   4  longitude (1e-7 deg)
+ *   28   1  satellite_count
+ *   29   1  flags (bit0 GPS fix)
+ *   30   1  capacity_level
+ *   31   1  waste_classification
+ *   32   1  priority_level
+ *   33   1  reserved (0)
+ *   34   2  hours_to_full (0.1 h, -10 = unknown)
+ *
+ * BLOCK LAYOUT (RESEARCH_LOG_BLOCK_SIZE bytes):
+ *    0   4  magic
+ *    4   4  crc32 (configCrc32 over bytes 8..end of block)
+ *    8   4  sequence (monotonic across files and boots)
+ *   12   1  version
+ *   13   1  record size
+ *   14   2  record count
+ *   16      records, then zero padding
+ *
+ * POWER-LOSS SAFETY:
+ * - Files are append-only and only ever grow by whole blocks; a written
+ *   block is never rewritten, so a torn write can only damage the block
+ *   being written. Readers skip blocks that fail the CRC (or a partial
+ *   trailing block) and see the lost records as a sequence gap
+ * - Every boot starts a new file rather than appending to one that may
+ *   end in a torn block
+ *
+ * WRITE POLICY:
+ * - Records are staged in RAM and written as one block when it is full
+ * - fsync every sync_blocks blocks
+ * - A partial (zero-padded) block is written once its first record has
+ *   waited flush_interval_ms, bounding the data lost to a power cut
+ * - Files rotate at file_bytes; the oldest files are deleted to keep the
+ *   log under budget_bytes
+ * ============================================================================
+ */
+
+#ifndef BINSAI_RESEARCH_LOGGER_H
+#define BINSAI_RESEARCH_LOGGER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define RESEARCH_LOG_MAGIC          0x474C5242UL  // "BRLG" little-endian
+#define RESEARCH_LOG_VERSION        1
+#define RESEARCH_LOG_BLOCK_SIZE     512           // SD sector, 2 LittleFS program pages
+#define RESEARCH_LOG_HEADER_SIZE    16
+#define RESEARCH_LOG_RECORD_SIZE    36
+#define RESEARCH_LOG_BLOCK_RECORDS  ((RESEARCH_LOG_BLOCK_SIZE - RESEARCH_LOG_HEADER_SIZE) / RESEARCH_LOG_RECORD_SIZE)
+
+#define RESEARCH_LOG_FLAG_GPS_FIX   0x01
+
+/**
+ * One research sample (the logResearchData() CSV columns)
+ */
+typedef struct {
+    uint32_t millis;
+    int64_t unix_ms;
+    float distance_cm;
+    float fill_percentage;
+    float ppm_calculated;
+    uint16_t adc_raw;
+    bool gps_fix;
+    double latitude;
+    double longitude;
+    uint8_t satellite_count;
+    uint8_t capacity_level;
+    uint8_t waste_classification;
+    uint8_t priority_level;
+    float hours_to_full;            // < 0 = unknown
+} ResearchLogRecord_t;
+
+typedef struct {
+    uint32_t file_bytes;            // Rotate after this size (whole blocks)
+    uint32_t budget_bytes;          // Delete oldest files to stay under this
+    uint8_t sync_blocks;            // fsync every N blocks (>= 1)
+    uint32_t flush_interval_ms;     // Max staging time of a record, 0 = full blocks only
+} ResearchLogConfig_t;
+
+typedef struct {
+    uint32_t records;               // Accepted into staging
+    uint32_t records_written;       // In blocks accepted by the backend
+    uint32_t records_dropped;       // In blocks the backend failed to write
+    uint32_t blocks;
+    uint32_t partial_blocks;        // Written before full (flush interval / flush())
+    uint32_t syncs;
+    uint32_t files_opened;
+    uint32_t files_removed;
+    uint32_t write_errors;
+    uint32_t bytes_written;         // Headers and padding included
+} ResearchLogStats_t;
+
+/**
+ * File storage (LittleFS in firmware, RAM in tests). Files are numbered;
+ * at most one is open for appending.
+ */
+class ResearchLogBackend {
+public:
+    virtual ~ResearchLogBackend() {}
+
+    /**
+     * Lowest and highest existing file number
+     * @return false if there are no files
+     */
+    virtual bool fileRange(uint32_t* first, uint32_t* last) = 0;
+
+    /**
+     * @return Size in bytes, 0 if the file does not exist
+     */
+    virtual uint32_t fileSize(uint32_t index) = 0;
+
+    virtual bool readFile(uint32_t index, uint32_t offset, void* buffer, size_t length) = 0;
+
+    /**
+     * Create a file and make it the append target (closes the previous one)
+     */
+    virtual bool openAppend(uint32_t index) = 0;
+
+    /**
+     * @return true if all bytes were accepted
+     */
+    virtual bool append(const void* data, size_t length) = 0;
+
+    /**
+     * Make appended data durable (fsync)
+     */
+    virtual bool sync() = 0;
+
+    virtual void close() = 0;
+    virtual bool removeFile(uint32_t index) = 0;
+};
+
+class ResearchLogger {
+public:
+    explicit ResearchLogger(ResearchLogBackend& backend);
+
+    /**
+     * Pick up the file numbering and block sequence of an existing log.
+     * No file is created until the first block is written.
+     */
+    bool begin(const ResearchLogConfig_t& config);
+
+    /**
+     * Stage a record; writes a block when the staging buffer is full
+     * @return false if not started or a block write failed
+     */
+    bool append(const ResearchLogRecord_t& record, uint32_t now_ms);
+
+    /**
+     * Apply the flush interval
+     */
+    void loop(uint32_t now_ms);
+
+    /**
+     * Write staged records (partial block) and fsync
+     */
+    bool flush();
+
+    bool ready() const { return _ready; }
+    uint8_t staged() const { return _staged; }
+    uint32_t fileIndex() const { return _file_index; }
+    uint32_t nextSequence() const { return _sequence; }
+    uint32_t usedBytes() const { return _used_bytes; }
+    const ResearchLogStats_t& stats() const { return _stats; }
+
+private:
+    bool writeBlock();
+    bool rotate();
+
+    ResearchLogBackend& _backend;
+    ResearchLogConfig_t _config;
+    ResearchLogStats_t _stats;
+    bool _ready;
+    bool _have_files;
+    bool _file_open;
+    uint32_t _oldest_index;
+    uint32_t _next_index;
+    uint32_t _file_index;
+    uint32_t _file_bytes;
+    uint32_t _used_bytes;
+    uint32_t _sequence;
+    uint8_t _unsynced;
+    uint8_t _staged;
+    uint32_t _first_staged_ms;
+    uint8_t _block[RESEARCH_LOG_BLOCK_SIZE];
+};
+
+void researchLogEncodeRecord(const ResearchLogRecord_t& record, uint8_t* out);
+void researchLogDecodeRecord(const uint8_t* data, ResearchLogRecord_t* record);
+
+/**
+ * Validate a block (magic, version, record size and count, CRC)
+ */
+bool researchLogCheckBlock(const uint8_t* block, uint32_t* sequence, uint16_t* count);
+
+typedef struct {
+    uint32_t files;
+    uint32_t blocks;
+    uint32_t corrupt_blocks;        // Failed the CRC or header checks
+    uint32_t sequence_gaps;         // Missing sequence numbers (dropped / torn blocks)
+    uint32_t records;
+} ResearchLogScan_t;
+
+typedef void (*ResearchLogVisitor_t)(const ResearchLogRecord_t& record, void* context);
+
+/**
+ * Visit every record of every valid block, oldest file first
+ */
+void researchLogReplay(ResearchLogBackend& backend, ResearchLogVisitor_t visit, void* context,
+                       ResearchLogScan_t* scan);
+
+#endif  // BINSAI_RESEARCH_LOGGER_H
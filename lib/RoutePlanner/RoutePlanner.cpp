@@ -0,0 +1,414 @@
+/**
+ * BINSAI Route Planner - sparse savings construction and local search
+ */
+
+#include "RoutePlanner.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#define ROUTE_DEPOT_LATITUDE        -7.7956     // Yogyakarta (Piyungan transfer depot side)
+#define ROUTE_DEPOT_LONGITUDE       110.3695
+#define ROUTE_METRES_PER_DEGREE     111320.0
+#define ROUTE_IMPROVE_EPSILON       1e-3        // Metres; ignore float noise
+#define ROUTE_OR_OPT_MAX_SEGMENT    3
+#define ROUTE_GRID_MAX_DIM          1024
+
+/**
+ * Projected stop coordinates, node 0 is the depot
+ */
+struct RouteGeometry {
+    std::vector<double> x;
+    std::vector<double> y;
+    double circuity;
+
+    double distance(uint32_t a, uint32_t b) const {
+        double dx = x[a] - x[b];
+        double dy = y[a] - y[b];
+        return sqrt(dx * dx + dy * dy) * circuity;
+    }
+};
+
+typedef struct {
+    double saving;
+    uint32_t a;
+    uint32_t b;
+} RouteSaving_t;
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * Run fn(index) for index in [0, count) across threads (work stealing by
+ * atomic counter; fn must only write state owned by its index)
+ */
+template <typename Fn>
+static void parallelFor(size_t count, unsigned thread_count, Fn fn) {
+    if (thread_count <= 1 || count < 2) {
+        for (size_t i = 0; i < count; i++) fn(i);
+        return;
+    }
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < thread_count; t++) {
+        threads.push_back(std::thread([&]() {
+            for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) fn(i);
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++) threads[t].join();
+}
+
+static uint32_t xorshift32(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static double randomUnit(uint32_t* state) {
+    return (xorshift32(state) >> 8) * (1.0 / 16777216.0);
+}
+
+void routePlannerDefaults(RoutePlannerConfig_t* config) {
+    config->depot_latitude = ROUTE_DEPOT_LATITUDE;
+    config->depot_longitude = ROUTE_DEPOT_LONGITUDE;
+    config->vehicle_capacity = ROUTE_DEFAULT_CAPACITY;
+    config->max_stops_per_route = 0;
+    config->neighbor_count = ROUTE_DEFAULT_NEIGHBORS;
+    config->circuity_factor = ROUTE_DEFAULT_CIRCUITY;
+    config->thread_count = 0;
+}
+
+RouteStop_t routeStopFromSensor(const SensorData_t& data, uint32_t id, float bin_volume) {
+    RouteStop_t stop;
+    memset(&stop, 0, sizeof(stop));     // Deterministic padding for comparisons
+    stop.id = id;
+    stop.latitude = data.latitude;
+    stop.longitude = data.longitude;
+    float fill = data.fill_percentage < 0.0f ? 0.0f : data.fill_percentage > 100.0f ? 100.0f : data.fill_percentage;
+    stop.demand = fill / 100.0f * bin_volume;
+    stop.priority = data.priority_level;
+    return stop;
+}
+
+void routeSyntheticCity(uint32_t stop_count, uint32_t seed, std::vector<RouteStop_t>* stops) {
+    uint32_t rng = seed ? seed : 1;
+    uint32_t cluster_count = stop_count / 150 + 3;
+    std::vector<double> cluster_lat(cluster_count), cluster_lon(cluster_count);
+    for (uint32_t c = 0; c < cluster_count; c++) {
+        cluster_lat[c] = ROUTE_DEPOT_LATITUDE + (randomUnit(&rng) - 0.5) * 0.16;
+        cluster_lon[c] = ROUTE_DEPOT_LONGITUDE + (randomUnit(&rng) - 0.5) * 0.16;
+    }
+
+    stops->clear();
+    stops->reserve(stop_count);
+    for (uint32_t i = 0; i < stop_count; i++) {
+        uint32_t c = xorshift32(&rng) % cluster_count;
+        // Box-Muller, ~650 m spread per neighbourhood
+        double r = sqrt(-2.0 * log(randomUnit(&rng) + 1e-12)) * 0.006;
+        double theta = randomUnit(&rng) * 2.0 * M_PI;
+
+        SensorData_t data;
+        memset(&data, 0, sizeof(data));
+        data.latitude = cluster_lat[c] + r * cos(theta);
+        data.longitude = cluster_lon[c] + r * sin(theta);
+        data.fill_percentage = (float)(20.0 + randomUnit(&rng) * 80.0);
+        data.capacity_level = data.fill_percentage > THRESHOLD_ALMOST_FULL ? 3 :
+                              data.fill_percentage > THRESHOLD_HALF_PERCENT ? 2 : 1;
+        data.priority_level = data.capacity_level;
+        stops->push_back(routeStopFromSensor(data, i, ROUTE_DEFAULT_BIN_VOLUME));
+    }
+}
+
+/**
+ * Closed tour length: depot -> route -> depot
+ */
+static double tourLength(const RouteGeometry& geo, const std::vector<uint32_t>& route) {
+    if (route.empty()) return 0.0;
+    double length = geo.distance(0, route.front()) + geo.distance(route.back(), 0);
+    for (size_t i = 1; i < route.size(); i++) {
+        length += geo.distance(route[i - 1], route[i]);
+    }
+    return length;
+}
+
+/**
+ * First-improvement 2-opt on [0, route..., 0]
+ * @return true if the tour changed
+ */
+static bool improveTwoOpt(const RouteGeometry& geo, std::vector<uint32_t>& tour) {
+    bool changed = false;
+    bool improved = true;
+    size_t n = tour.size();
+    while (improved) {
+        improved = false;
+        for (size_t i = 0; i + 2 < n; i++) {
+            for (size_t j = i + 2; j + 1 < n; j++) {
+                double delta = geo.distance(tour[i], tour[j]) + geo.distance(tour[i + 1], tour[j + 1]) -
+                               geo.distance(tour[i], tour[i + 1]) - geo.distance(tour[j], tour[j + 1]);
+                if (delta < -ROUTE_IMPROVE_EPSILON) {
+                    std::reverse(tour.begin() + i + 1, tour.begin() + j + 1);
+                    improved = changed = true;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+/**
+ * First-improvement Or-opt: relocate segments of 1-3 stops (either
+ * orientation) elsewhere in the same tour
+ * @return true if the tour changed
+ */
+static bool improveOrOpt(const RouteGeometry& geo, std::vector<uint32_t>& tour) {
+    bool changed = false;
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        size_t n = tour.size();
+        for (size_t length = 1; length <= ROUTE_OR_OPT_MAX_SEGMENT && !improved; length++) {
+            // Segment tour[s .. e], never the depot ends
+            for (size_t s = 1; s + length < n && !improved; s++) {
+                size_t e = s + length - 1;
+                uint32_t prev = tour[s - 1], next = tour[e + 1];
+                uint32_t first = tour[s], last = tour[e];
+                double removed = geo.distance(prev, first) + geo.distance(last, next) - geo.distance(prev, next);
+
+                for (size_t p = 0; p + 1 < n && !improved; p++) {
+                    if (p + 1 >= s && p <= e) continue;  // Edge touches the segment
+                    uint32_t a = tour[p], b = tour[p + 1];
+                    double base = geo.distance(a, b);
+                    double forward = geo.distance(a, first) + geo.distance(last, b) - base;
+                    double reversed = geo.distance(a, last) + geo.distance(first, b) - base;
+                    bool use_reversed = reversed < forward;
+                    if ((use_reversed ? reversed : forward) - removed < -ROUTE_IMPROVE_EPSILON) {
+                        std::vector<uint32_t> segment(tour.begin() + s, tour.begin() + e + 1);
+                        if (use_reversed) std::reverse(segment.begin(), segment.end());
+                        tour.erase(tour.begin() + s, tour.begin() + e + 1);
+                        size_t insert_at = (p < s) ? p + 1 : p + 1 - length;
+                        tour.insert(tour.begin() + insert_at, segment.begin(), segment.end());
+                        improved = changed = true;
+                    }
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+RoutePlanner::RoutePlanner(const RoutePlannerConfig_t& config) : _config(config) {
+    if (_config.neighbor_count == 0) _config.neighbor_count = ROUTE_DEFAULT_NEIGHBORS;
+    if (_config.circuity_factor <= 0.0f) _config.circuity_factor = ROUTE_DEFAULT_CIRCUITY;
+    if (_config.thread_count == 0) {
+        _config.thread_count = std::thread::hardware_concurrency();
+        if (_config.thread_count == 0) _config.thread_count = 1;
+    }
+}
+
+RoutePlan_t RoutePlanner::plan(const std::vector<RouteStop_t>& stops) const {
+    RoutePlan_t plan;
+    plan.total_length_m = 0.0;
+    plan.savings_length_m = 0.0;
+    plan.graph_edges = 0;
+    plan.graph_ms = plan.savings_ms = plan.improve_ms = 0.0;
+
+    const uint32_t n = (uint32_t)stops.size();
+    if (n == 0) return plan;
+
+    // 1. Projection (node 0 = depot, node i+1 = stops[i])
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    RouteGeometry geo;
+    geo.circuity = _config.circuity_factor;
+    geo.x.resize(n + 1);
+    geo.y.resize(n + 1);
+    double cos_lat = cos(_config.depot_latitude * M_PI / 180.0);
+    geo.x[0] = geo.y[0] = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        geo.x[i + 1] = (stops[i].longitude - _config.depot_longitude) * ROUTE_METRES_PER_DEGREE * cos_lat;
+        geo.y[i + 1] = (stops[i].latitude - _config.depot_latitude) * ROUTE_METRES_PER_DEGREE;
+    }
+
+    // 2. Sparse k-NN graph, one neighbour list per stop, searched through a
+    //    uniform grid in expanding rings (~k stops per cell)
+    const uint32_t k = std::min<uint32_t>(_config.neighbor_count, n - 1);
+    double min_x = geo.x[1], max_x = geo.x[1], min_y = geo.y[1], max_y = geo.y[1];
+    for (uint32_t node = 2; node <= n; node++) {
+        min_x = std::min(min_x, geo.x[node]);
+        max_x = std::max(max_x, geo.x[node]);
+        min_y = std::min(min_y, geo.y[node]);
+        max_y = std::max(max_y, geo.y[node]);
+    }
+    double cell = sqrt(std::max((max_x - min_x) * (max_y - min_y), 1.0) * std::max(k, 1u) / n);
+    cell = std::max(cell, 1.0);
+    int32_t grid_w = std::min<int32_t>((int32_t)((max_x - min_x) / cell) + 1, ROUTE_GRID_MAX_DIM);
+    int32_t grid_h = std::min<int32_t>((int32_t)((max_y - min_y) / cell) + 1, ROUTE_GRID_MAX_DIM);
+    cell = std::max((max_x - min_x) / grid_w, (max_y - min_y) / grid_h) + 1e-6;
+
+    std::vector<int32_t> cell_of(n + 1);
+    std::vector<uint32_t> cell_start((size_t)grid_w * grid_h + 1, 0);
+    std::vector<uint32_t> cell_items(n);
+    for (uint32_t node = 1; node <= n; node++) {
+        int32_t cx = std::min((int32_t)((geo.x[node] - min_x) / cell), grid_w - 1);
+        int32_t cy = std::min((int32_t)((geo.y[node] - min_y) / cell), grid_h - 1);
+        cell_of[node] = cy * grid_w + cx;
+        cell_start[cell_of[node] + 1]++;
+    }
+    for (size_t c = 1; c < cell_start.size(); c++) cell_start[c] += cell_start[c - 1];
+    std::vector<uint32_t> fill(cell_start.begin(), cell_start.end() - 1);
+    for (uint32_t node = 1; node <= n; node++) cell_items[fill[cell_of[node]]++] = node;
+
+    std::vector<uint32_t> neighbors((size_t)n * k);
+    parallelFor(n, _config.thread_count, [&](size_t i) {
+        std::vector<std::pair<double, uint32_t> > best;
+        best.reserve(k + 1);
+        uint32_t node = (uint32_t)i + 1;
+        int32_t cx = cell_of[node] % grid_w, cy = cell_of[node] / grid_w;
+
+        for (int32_t ring = 0; k > 0; ring++) {
+            if (ring > grid_w && ring > grid_h) break;
+            if (best.size() == k && best.front().first <= (ring - 1) * cell * geo.circuity) break;
+
+            for (int32_t y = cy - ring; y <= cy + ring; y++) {
+                if (y < 0 || y >= grid_h) continue;
+                bool edge_row = (y == cy - ring || y == cy + ring);
+                for (int32_t x = cx - ring; x <= cx + ring; x += edge_row ? 1 : 2 * ring) {
+                    if (x >= 0 && x < grid_w) {
+                        size_t c = (size_t)y * grid_w + x;
+                        for (uint32_t item = cell_start[c]; item < cell_start[c + 1]; item++) {
+                            uint32_t other = cell_items[item];
+                            if (other == node) continue;
+                            double d = geo.distance(node, other);
+                            if (best.size() < k) {
+                                best.push_back(std::make_pair(d, other));
+                                std::push_heap(best.begin(), best.end());
+                            } else if (d < best.front().first) {
+                                std::pop_heap(best.begin(), best.end());
+                                best.back() = std::make_pair(d, other);
+                                std::push_heap(best.begin(), best.end());
+                            }
+                        }
+                    }
+                    if (ring == 0) break;
+                }
+            }
+        }
+        std::sort_heap(best.begin(), best.end());
+        for (uint32_t j = 0; j < best.size(); j++) neighbors[i * k + j] = best[j].second;
+    });
+    plan.graph_ms = elapsedMs(start);
+
+    // 3. Clarke-Wright savings over graph edges
+    start = std::chrono::steady_clock::now();
+    std::vector<RouteSaving_t> savings;
+    savings.reserve((size_t)n * k);
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t a = i + 1;
+        for (uint32_t j = 0; j < k; j++) {
+            uint32_t b = neighbors[(size_t)i * k + j];
+            RouteSaving_t saving;
+            saving.a = std::min(a, b);
+            saving.b = std::max(a, b);
+            saving.saving = geo.distance(0, a) + geo.distance(0, b) - geo.distance(a, b);
+            savings.push_back(saving);
+        }
+    }
+    std::sort(savings.begin(), savings.end(), [](const RouteSaving_t& l, const RouteSaving_t& r) {
+        if (l.saving != r.saving) return l.saving > r.saving;
+        return l.a != r.a ? l.a < r.a : l.b < r.b;
+    });
+    savings.erase(std::unique(savings.begin(), savings.end(),
+                              [](const RouteSaving_t& l, const RouteSaving_t& r) {
+                                  return l.a == r.a && l.b == r.b;
+                              }), savings.end());
+    plan.graph_edges = savings.size();
+
+    std::vector<std::vector<uint32_t> > routes(n + 1);
+    std::vector<uint32_t> route_of(n + 1);
+    std::vector<float> load(n + 1);
+    for (uint32_t node = 1; node <= n; node++) {
+        routes[node].push_back(node);
+        route_of[node] = node;
+        load[node] = stops[node - 1].demand;
+    }
+
+    for (size_t s = 0; s < savings.size(); s++) {
+        if (savings[s].saving <= 0.0) break;
+        uint32_t a = savings[s].a, b = savings[s].b;
+        uint32_t ra = route_of[a], rb = route_of[b];
+        if (ra == rb) continue;
+
+        std::vector<uint32_t>& route_a = routes[ra];
+        std::vector<uint32_t>& route_b = routes[rb];
+        bool a_end = route_a.back() == a, a_start = route_a.front() == a;
+        bool b_end = route_b.back() == b, b_start = route_b.front() == b;
+        if (!(a_end || a_start) || !(b_end || b_start)) continue;  // Interior stop
+        if (load[ra] + load[rb] > _config.vehicle_capacity) continue;
+        if (_config.max_stops_per_route &&
+            route_a.size() + route_b.size() > _config.max_stops_per_route) continue;
+
+        // Orient as [... a] + [b ...] and absorb route b into route a
+        if (!a_end) std::reverse(route_a.begin(), route_a.end());
+        if (!b_start) std::reverse(route_b.begin(), route_b.end());
+        for (size_t i = 0; i < route_b.size(); i++) route_of[route_b[i]] = ra;
+        route_a.insert(route_a.end(), route_b.begin(), route_b.end());
+        route_b.clear();
+        load[ra] += load[rb];
+    }
+
+    std::vector<uint32_t> live;
+    for (uint32_t r = 1; r <= n; r++) {
+        if (!routes[r].empty()) {
+            live.push_back(r);
+            plan.savings_length_m += tourLength(geo, routes[r]);
+        }
+    }
+    plan.savings_ms = elapsedMs(start);
+
+    // 4. Local search per route, in parallel
+    start = std::chrono::steady_clock::now();
+    plan.routes.resize(live.size());
+    parallelFor(live.size(), _config.thread_count, [&](size_t index) {
+        const std::vector<uint32_t>& nodes = routes[live[index]];
+        std::vector<uint32_t> tour;
+        tour.reserve(nodes.size() + 2);
+        tour.push_back(0);
+        tour.insert(tour.end(), nodes.begin(), nodes.end());
+        tour.push_back(0);
+
+        bool changed = true;
+        while (changed) {
+            changed = improveTwoOpt(geo, tour);
+            changed = improveOrOpt(geo, tour) || changed;
+        }
+
+        Route_t& route = plan.routes[index];
+        route.load = 0.0f;
+        route.max_priority = 0;
+        for (size_t i = 1; i + 1 < tour.size(); i++) {
+            const RouteStop_t& stop = stops[tour[i] - 1];
+            route.stops.push_back(tour[i] - 1);
+            route.load += stop.demand;
+            if (stop.priority > route.max_priority) route.max_priority = stop.priority;
+        }
+        std::vector<uint32_t> inner(tour.begin() + 1, tour.end() - 1);
+        route.length_m = tourLength(geo, inner);
+    });
+    plan.improve_ms = elapsedMs(start);
+
+    std::stable_sort(plan.routes.begin(), plan.routes.end(), [](const Route_t& l, const Route_t& r) {
+        if (l.max_priority != r.max_priority) return l.max_priority > r.max_priority;
+        return l.length_m < r.length_m;
+    });
+    for (size_t r = 0; r < plan.routes.size(); r++) {
+        plan.total_length_m += plan.routes[r].length_m;
+    }
+    return plan;
+}
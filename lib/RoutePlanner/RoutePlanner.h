@@ -0,0 +1,100 @@
+/**
+ * ============================================================================
+ * BINSAI Route Planner
+ * Capacitated collection routes for city-scale fleets (host side)
+ * ============================================================================
+ *
+ * PIPELINE:
+ * 1. Project stops to local metres around the depot (equirectangular,
+ *    accurate to <0.1% at city scale) and scale by a road circuity factor.
+ * 2. Sparse graph: k nearest neighbours per stop (built in parallel).
+ * 3. Clarke-Wright savings over graph edges only, O(n*k log n*k) instead
+ *    of the O(n^2) full matrix that ruled out routing on the ESP32
+ *    (ISSUES.md #002).
+ * 4. Per-route 2-opt and Or-opt (segments of 1-3 stops), routes improved
+ *    in parallel across threads. Results do not depend on thread count.
+ *
+ * Routes are returned ordered by highest stop priority, then length, so
+ * critical bins are dispatched first.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_ROUTE_PLANNER_H
+#define BINSAI_ROUTE_PLANNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "definitions.h"
+
+#define ROUTE_DEFAULT_NEIGHBORS     16
+#define ROUTE_DEFAULT_CIRCUITY      1.3f    // Road distance / straight line
+#define ROUTE_DEFAULT_CAPACITY      8000.0f // Litres per truck
+#define ROUTE_DEFAULT_BIN_VOLUME    120.0f  // Litres per bin
+
+typedef struct {
+    uint32_t id;                    // Caller's identifier (index, device hash...)
+    double latitude;
+    double longitude;
+    float demand;                   // Litres to collect
+    uint8_t priority;               // SensorData_t priority_level (0-3)
+} RouteStop_t;
+
+typedef struct {
+    double depot_latitude;
+    double depot_longitude;
+    float vehicle_capacity;         // Same unit as RouteStop_t::demand
+    uint32_t max_stops_per_route;   // 0 = unlimited
+    uint8_t neighbor_count;         // k of the sparse graph
+    float circuity_factor;
+    unsigned thread_count;          // 0 = hardware concurrency
+} RoutePlannerConfig_t;
+
+typedef struct {
+    std::vector<uint32_t> stops;    // Indices into the input stop array
+    float load;
+    double length_m;                // Depot -> stops -> depot
+    uint8_t max_priority;
+} Route_t;
+
+typedef struct {
+    std::vector<Route_t> routes;
+    double total_length_m;
+    double savings_length_m;        // Before 2-opt/Or-opt
+    size_t graph_edges;
+    double graph_ms;
+    double savings_ms;
+    double improve_ms;
+} RoutePlan_t;
+
+/**
+ * Defaults: Yogyakarta depot, 8 m^3 truck, k=16, circuity 1.3
+ */
+void routePlannerDefaults(RoutePlannerConfig_t* config);
+
+/**
+ * Build a stop from a device sample (demand = fill % of bin_volume)
+ */
+RouteStop_t routeStopFromSensor(const SensorData_t& data, uint32_t id, float bin_volume);
+
+/**
+ * Deterministic synthetic city: clustered neighbourhoods around the
+ * default depot, fill/priority distributed like field data
+ */
+void routeSyntheticCity(uint32_t stop_count, uint32_t seed, std::vector<RouteStop_t>* stops);
+
+class RoutePlanner {
+public:
+    explicit RoutePlanner(const RoutePlannerConfig_t& config);
+
+    /**
+     * Plan routes covering every stop exactly once
+     * Stops whose demand exceeds vehicle capacity get a dedicated route.
+     */
+    RoutePlan_t plan(const std::vector<RouteStop_t>& stops) const;
+
+private:
+    RoutePlannerConfig_t _config;
+};
+
+#endif  // BINSAI_ROUTE_PLANNER_H
@@ -0,0 +1,113 @@
+/**
+ * BINSAI Heap Counter - linker-wrapped allocator entry points
+ */
+
+#include "HeapCounter.h"
+
+#ifdef BINSAI_HEAP_COUNTER
+
+#include <atomic>
+#include <stddef.h>
+
+#ifdef ARDUINO
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#define HEAP_COUNTER_ATTR           IRAM_ATTR   // Heap may be used with flash cache off
+#else
+#define HEAP_COUNTER_ATTR
+#endif
+
+static std::atomic<uint32_t> heap_allocations(0);
+static std::atomic<uint32_t> heap_frees(0);
+static std::atomic<uint32_t> heap_task_allocations(0);
+static std::atomic<const void*> heap_tracked_task(nullptr);
+
+#ifdef ARDUINO
+static HEAP_COUNTER_ATTR const void* currentTask() {
+    return xTaskGetCurrentTaskHandle();
+}
+#else
+static const void* currentTask() {
+    static thread_local char marker;            // Static TLS: no allocation
+    return &marker;
+}
+#endif
+
+static HEAP_COUNTER_ATTR void countAllocation() {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (heap_tracked_task.load(std::memory_order_relaxed) == currentTask()) {
+        heap_task_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+void __real_free(void* pointer);
+
+HEAP_COUNTER_ATTR void* __wrap_malloc(size_t size) {
+    countAllocation();
+    return __real_malloc(size);
+}
+
+HEAP_COUNTER_ATTR void* __wrap_calloc(size_t count, size_t size) {
+    countAllocation();
+    return __real_calloc(count, size);
+}
+
+HEAP_COUNTER_ATTR void* __wrap_realloc(void* pointer, size_t size) {
+    countAllocation();
+    return __real_realloc(pointer, size);
+}
+
+HEAP_COUNTER_ATTR void __wrap_free(void* pointer) {
+    if (pointer) {
+        heap_frees.fetch_add(1, std::memory_order_relaxed);
+    }
+    __real_free(pointer);
+}
+}
+
+uint32_t heapAllocationCount() {
+    return heap_allocations.load(std::memory_order_relaxed);
+}
+
+uint32_t heapFreeCount() {
+    return heap_frees.load(std::memory_order_relaxed);
+}
+
+void heapCounterTrackCurrentTask() {
+    heap_tracked_task.store(currentTask(), std::memory_order_relaxed);
+}
+
+uint32_t heapTaskAllocationCount() {
+    return heap_task_allocations.load(std::memory_order_relaxed);
+}
+
+bool heapCounterEnabled() {
+    return true;
+}
+
+#else
+
+uint32_t heapAllocationCount() {
+    return 0;
+}
+
+uint32_t heapFreeCount() {
+    return 0;
+}
+
+void heapCounterTrackCurrentTask() {}
+
+uint32_t heapTaskAllocationCount() {
+    return 0;
+}
+
+bool heapCounterEnabled() {
+    return false;
+}
+
+#endif  // BINSAI_HEAP_COUNTER
@@ -0,0 +1,44 @@
+/**
+ * ============================================================================
+ * BINSAI Heap Counter
+ * Counts malloc / calloc / realloc / free calls made through the C heap
+ * ============================================================================
+ *
+ * Built with -DBINSAI_HEAP_COUNTER and the linker flags
+ *   -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free
+ * every call (Arduino String, operator new, lwIP, mbedTLS) goes through the
+ * counting wrappers below. Direct heap_caps_malloc() callers are not seen.
+ * The totals include every task (WiFi, lwIP, esp_timer); the task count
+ * only sees the one task registered with heapCounterTrackCurrentTask()
+ * (a thread on the host), so it can show that task allocates nothing.
+ * Without the flag the counters read zero and enabled() is false, so host
+ * builds and tests are unaffected.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_HEAP_COUNTER_H
+#define BINSAI_HEAP_COUNTER_H
+
+#include <stdint.h>
+
+/**
+ * Allocations since boot (malloc + calloc + realloc), wraps at 2^32
+ */
+uint32_t heapAllocationCount();
+
+uint32_t heapFreeCount();
+
+/**
+ * Count the calling task's allocations in heapTaskAllocationCount() from
+ * now on (one task at a time; the last caller wins)
+ */
+void heapCounterTrackCurrentTask();
+
+/**
+ * Allocations made by the tracked task, wraps at 2^32
+ */
+uint32_t heapTaskAllocationCount();
+
+bool heapCounterEnabled();
+
+#endif  // BINSAI_HEAP_COUNTER_H
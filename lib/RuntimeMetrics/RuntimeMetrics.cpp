@@ -0,0 +1,293 @@
+/**
+ * BINSAI Runtime Metrics - registry, atomic updates, quantiles, formatting
+ */
+
+#include "RuntimeMetrics.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+static uint32_t defaultClockUs() {
+    return micros();
+}
+#else
+#include <chrono>
+
+static uint32_t defaultClockUs() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+static MetricsClock_t metrics_clock = defaultClockUs;
+
+void metricsSetClock(MetricsClock_t clock) {
+    metrics_clock = clock ? clock : defaultClockUs;
+}
+
+uint32_t metricsNowUs() {
+    return metrics_clock();
+}
+
+// ============================================================================
+// Registry
+// ============================================================================
+
+Metric::Metric(MetricsRegistry& registry, const char* name, MetricType_t type)
+    : _name(name), _type(type), _next(nullptr) {
+    registry.add(this);
+}
+
+void MetricsRegistry::add(Metric* metric) {
+    // Append so listings follow declaration order; runs during static init
+    Metric** link = &_head;
+    while (*link) {
+        link = &(*link)->_next;
+    }
+    *link = metric;
+    _count++;
+}
+
+const Metric* MetricsRegistry::find(const char* name) const {
+    for (const Metric* metric = _head; metric; metric = metric->next()) {
+        if (strcmp(metric->name(), name) == 0) {
+            return metric;
+        }
+    }
+    return nullptr;
+}
+
+void MetricsRegistry::closeWindow() {
+    for (Metric* metric = _head; metric; metric = metric->_next) {
+        metric->closeWindow();
+    }
+}
+
+void MetricsRegistry::reset() {
+    for (Metric* metric = _head; metric; metric = metric->_next) {
+        metric->reset();
+    }
+}
+
+/**
+ * snprintf that reports what actually fit
+ */
+static size_t formatClamped(char* buffer, size_t capacity, int written) {
+    if (written < 0 || capacity == 0) {
+        if (capacity) buffer[0] = '\0';
+        return 0;
+    }
+    return (size_t)written < capacity ? (size_t)written : capacity - 1;
+}
+
+// ============================================================================
+// Counter
+// ============================================================================
+
+size_t MetricCounter::format(char* buffer, size_t capacity, bool window) const {
+    return formatClamped(buffer, capacity,
+        snprintf(buffer, capacity, "%s %s=%lu", name(), window ? "delta" : "total",
+                 (unsigned long)(window ? _window : value())));
+}
+
+void MetricCounter::closeWindow() {
+    uint32_t now = value();
+    _window = now - _window_start;
+    _window_start = now;
+}
+
+void MetricCounter::reset() {
+    _value.store(0, std::memory_order_relaxed);
+    _window_start = 0;
+    _window = 0;
+}
+
+// ============================================================================
+// Gauge
+// ============================================================================
+
+static void atomicMin(std::atomic<int32_t>& target, int32_t value) {
+    int32_t current = target.load(std::memory_order_relaxed);
+    while (value < current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+static void atomicMax(std::atomic<int32_t>& target, int32_t value) {
+    int32_t current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+MetricGauge::MetricGauge(MetricsRegistry& registry, const char* name)
+    : Metric(registry, name, METRIC_GAUGE) {
+    reset();
+}
+
+void MetricGauge::set(int32_t value) {
+    _value.store(value, std::memory_order_relaxed);
+    atomicMin(_min, value);
+    atomicMax(_max, value);
+    atomicMin(_open_min, value);
+    atomicMax(_open_max, value);
+}
+
+size_t MetricGauge::format(char* buffer, size_t capacity, bool window) const {
+    int32_t low = window ? _window_min : min();
+    int32_t high = window ? _window_max : max();
+    if (low > high) {
+        // Never set (in this window)
+        return formatClamped(buffer, capacity, snprintf(buffer, capacity, "%s value=-", name()));
+    }
+    return formatClamped(buffer, capacity,
+        snprintf(buffer, capacity, "%s value=%ld min=%ld max=%ld", name(),
+                 (long)value(), (long)low, (long)high));
+}
+
+void MetricGauge::closeWindow() {
+    _window_min = _open_min.exchange(INT32_MAX, std::memory_order_relaxed);
+    _window_max = _open_max.exchange(INT32_MIN, std::memory_order_relaxed);
+}
+
+void MetricGauge::reset() {
+    _value.store(0, std::memory_order_relaxed);
+    _min.store(INT32_MAX, std::memory_order_relaxed);
+    _max.store(INT32_MIN, std::memory_order_relaxed);
+    _open_min.store(INT32_MAX, std::memory_order_relaxed);
+    _open_max.store(INT32_MIN, std::memory_order_relaxed);
+    _window_min = INT32_MAX;
+    _window_max = INT32_MIN;
+}
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+uint8_t metricsBucketIndex(uint32_t us) {
+    uint32_t scaled = us >> METRICS_FIRST_BUCKET_SHIFT;
+    uint32_t index = scaled ? 32 - __builtin_clz(scaled) : 0;
+    return (uint8_t)(index < METRICS_HISTOGRAM_BUCKETS ? index : METRICS_HISTOGRAM_BUCKETS - 1);
+}
+
+uint32_t metricsBucketUpperUs(uint8_t bucket) {
+    if (bucket >= METRICS_HISTOGRAM_BUCKETS - 1) {
+        return UINT32_MAX;
+    }
+    return 1UL << (bucket + METRICS_FIRST_BUCKET_SHIFT);
+}
+
+static uint32_t bucketLowerUs(uint8_t bucket) {
+    return bucket ? 1UL << (bucket + METRICS_FIRST_BUCKET_SHIFT - 1) : 0;
+}
+
+uint32_t metricsQuantileUs(const MetricHistogramSnapshot_t& snapshot, float q) {
+    if (snapshot.count == 0) {
+        return 0;
+    }
+    if (q < 0.0f) q = 0.0f;
+    if (q > 1.0f) q = 1.0f;
+
+    // Rank of the sample we want (1-based), located by walking the buckets
+    uint32_t rank = (uint32_t)(q * snapshot.count + 0.999f);
+    if (rank == 0) rank = 1;
+    if (rank > snapshot.count) rank = snapshot.count;
+
+    uint32_t seen = 0;
+    for (uint8_t bucket = 0; bucket < METRICS_HISTOGRAM_BUCKETS; bucket++) {
+        uint32_t in_bucket = snapshot.buckets[bucket];
+        if (seen + in_bucket < rank) {
+            seen += in_bucket;
+            continue;
+        }
+        uint32_t lower = bucketLowerUs(bucket);
+        uint32_t upper = metricsBucketUpperUs(bucket);
+        if (upper > snapshot.max_us) upper = snapshot.max_us;
+        if (upper <= lower) return upper;
+        uint32_t estimate = lower + (uint32_t)((uint64_t)(upper - lower) * (rank - seen) / in_bucket);
+        return estimate < snapshot.max_us ? estimate : snapshot.max_us;
+    }
+    return snapshot.max_us;
+}
+
+MetricHistogram::MetricHistogram(MetricsRegistry& registry, const char* name)
+    : Metric(registry, name, METRIC_HISTOGRAM) {
+    reset();
+}
+
+void MetricHistogram::record(uint32_t us) {
+    _buckets[metricsBucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum_us.fetch_add(us, std::memory_order_relaxed);
+
+    // Maxima rarely change, so the CAS loop almost never runs
+    uint32_t current = _max_us.load(std::memory_order_relaxed);
+    while (us > current && !_max_us.compare_exchange_weak(current, us, std::memory_order_relaxed)) {
+    }
+    current = _window_max_us.load(std::memory_order_relaxed);
+    while (us > current && !_window_max_us.compare_exchange_weak(current, us, std::memory_order_relaxed)) {
+    }
+}
+
+void MetricHistogram::snapshot(MetricHistogramSnapshot_t* out) const {
+    for (uint8_t i = 0; i < METRICS_HISTOGRAM_BUCKETS; i++) {
+        out->buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+    }
+    out->count = _count.load(std::memory_order_relaxed);
+    out->sum_us = _sum_us.load(std::memory_order_relaxed);
+    out->max_us = _max_us.load(std::memory_order_relaxed);
+}
+
+size_t MetricHistogram::format(char* buffer, size_t capacity, bool window) const {
+    MetricHistogramSnapshot_t lifetime;
+    const MetricHistogramSnapshot_t* view = &_window;
+    if (!window) {
+        snapshot(&lifetime);
+        view = &lifetime;
+    }
+
+    // Lifetime sums wrap after ~71 minutes of accumulated time; the mean is
+    // only printed for windows, where the delta is exact
+    if (window && view->count) {
+        return formatClamped(buffer, capacity,
+            snprintf(buffer, capacity, "%s n=%lu mean=%lu p50=%lu p90=%lu p99=%lu max=%lu", name(),
+                     (unsigned long)view->count, (unsigned long)(view->sum_us / view->count),
+                     (unsigned long)metricsQuantileUs(*view, 0.50f),
+                     (unsigned long)metricsQuantileUs(*view, 0.90f),
+                     (unsigned long)metricsQuantileUs(*view, 0.99f),
+                     (unsigned long)view->max_us));
+    }
+    return formatClamped(buffer, capacity,
+        snprintf(buffer, capacity, "%s n=%lu p50=%lu p90=%lu p99=%lu max=%lu", name(),
+                 (unsigned long)view->count,
+                 (unsigned long)metricsQuantileUs(*view, 0.50f),
+                 (unsigned long)metricsQuantileUs(*view, 0.90f),
+                 (unsigned long)metricsQuantileUs(*view, 0.99f),
+                 (unsigned long)view->max_us));
+}
+
+void MetricHistogram::closeWindow() {
+    MetricHistogramSnapshot_t now;
+    snapshot(&now);
+    for (uint8_t i = 0; i < METRICS_HISTOGRAM_BUCKETS; i++) {
+        _window.buckets[i] = now.buckets[i] - _window_start.buckets[i];
+    }
+    _window.count = now.count - _window_start.count;
+    _window.sum_us = now.sum_us - _window_start.sum_us;
+    _window.max_us = _window_max_us.exchange(0, std::memory_order_relaxed);
+    _window_start = now;
+}
+
+void MetricHistogram::reset() {
+    for (uint8_t i = 0; i < METRICS_HISTOGRAM_BUCKETS; i++) {
+        _buckets[i].store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _sum_us.store(0, std::memory_order_relaxed);
+    _max_us.store(0, std::memory_order_relaxed);
+    _window_max_us.store(0, std::memory_order_relaxed);
+    memset(&_window_start, 0, sizeof(_window_start));
+    memset(&_window, 0, sizeof(_window));
+}
@@ -0,0 +1,228 @@
+/**
+ * ============================================================================
+ * BINSAI Runtime Metrics
+ * Counters, gauges and fixed-bucket latency histograms
+ * ============================================================================
+ *
+ * DESIGN:
+ * - Metrics are globals that link themselves into a registry when they are
+ *   constructed; nothing is allocated and the registry is just a list head
+ * - Updates are relaxed atomics (one fetch_add per field), so a metric can
+ *   be written from the loop task, an esp_timer callback or the other core
+ *   without a lock. Readers may see a histogram mid-update; that is one
+ *   sample of skew, not corruption
+ * - Histogram buckets are powers of two starting at 64 us, so recording is
+ *   a count-leading-zeros and three atomic adds (~1 us on the ESP32)
+ * - closeWindow() turns the cumulative values into per-interval deltas for
+ *   the research log, while the console shows lifetime totals
+ * ============================================================================
+ */
+
+#ifndef BINSAI_RUNTIME_METRICS_H
+#define BINSAI_RUNTIME_METRICS_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#define METRICS_HISTOGRAM_BUCKETS   16     // 64 us ... 1 s, last one open-ended
+#define METRICS_FIRST_BUCKET_SHIFT  6      // Bucket 0 holds samples < 2^6 us
+
+typedef enum {
+    METRIC_COUNTER = 0,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM
+} MetricType_t;
+
+/**
+ * Microsecond clock used by MetricScopedTimer (micros() in firmware,
+ * steady_clock on the host; tests install a fake)
+ */
+typedef uint32_t (*MetricsClock_t)();
+
+void metricsSetClock(MetricsClock_t clock);
+uint32_t metricsNowUs();
+
+class MetricsRegistry;
+
+class Metric {
+public:
+    const char* name() const { return _name; }
+    MetricType_t type() const { return _type; }
+    const Metric* next() const { return _next; }
+
+    /**
+     * One "name key=value ..." line, lifetime or last closed window
+     * @return Characters written (excluding NUL), truncated to capacity
+     */
+    virtual size_t format(char* buffer, size_t capacity, bool window) const = 0;
+
+    /**
+     * Start a new reporting interval
+     */
+    virtual void closeWindow() = 0;
+
+    virtual void reset() = 0;
+
+protected:
+    Metric(MetricsRegistry& registry, const char* name, MetricType_t type);
+    virtual ~Metric() {}
+
+private:
+    friend class MetricsRegistry;
+    const char* _name;
+    MetricType_t _type;
+    Metric* _next;
+};
+
+class MetricsRegistry {
+public:
+    constexpr MetricsRegistry() : _head(nullptr), _count(0) {}
+
+    const Metric* first() const { return _head; }
+    size_t count() const { return _count; }
+    const Metric* find(const char* name) const;
+
+    void closeWindow();
+    void reset();
+
+private:
+    friend class Metric;
+    void add(Metric* metric);
+
+    Metric* _head;
+    size_t _count;
+};
+
+/**
+ * Monotonic event count (wraps at 2^32)
+ */
+class MetricCounter : public Metric {
+public:
+    MetricCounter(MetricsRegistry& registry, const char* name)
+        : Metric(registry, name, METRIC_COUNTER), _value(0), _window_start(0), _window(0) {}
+
+    void add(uint32_t amount = 1) { _value.fetch_add(amount, std::memory_order_relaxed); }
+    uint32_t value() const { return _value.load(std::memory_order_relaxed); }
+    uint32_t window() const { return _window; }
+
+    size_t format(char* buffer, size_t capacity, bool window) const override;
+    void closeWindow() override;
+    void reset() override;
+
+private:
+    std::atomic<uint32_t> _value;
+    uint32_t _window_start;
+    uint32_t _window;
+};
+
+/**
+ * Last value plus low / high watermarks (heap, fragmentation, queue depth)
+ */
+class MetricGauge : public Metric {
+public:
+    MetricGauge(MetricsRegistry& registry, const char* name);
+
+    void set(int32_t value);
+    int32_t value() const { return _value.load(std::memory_order_relaxed); }
+    int32_t min() const { return _min.load(std::memory_order_relaxed); }
+    int32_t max() const { return _max.load(std::memory_order_relaxed); }
+
+    size_t format(char* buffer, size_t capacity, bool window) const override;
+    void closeWindow() override;
+    void reset() override;
+
+private:
+    std::atomic<int32_t> _value;
+    std::atomic<int32_t> _min;
+    std::atomic<int32_t> _max;
+    std::atomic<int32_t> _open_min;     // Watermarks of the current window
+    std::atomic<int32_t> _open_max;
+    int32_t _window_min;                // Watermarks of the last closed window
+    int32_t _window_max;
+};
+
+typedef struct {
+    uint32_t buckets[METRICS_HISTOGRAM_BUCKETS];
+    uint32_t count;
+    uint32_t sum_us;                // Wraps; only differences are meaningful
+    uint32_t max_us;
+} MetricHistogramSnapshot_t;
+
+/**
+ * Latency distribution in microseconds
+ */
+class MetricHistogram : public Metric {
+public:
+    MetricHistogram(MetricsRegistry& registry, const char* name);
+
+    void record(uint32_t us);
+
+    /**
+     * Cumulative state (sum_us is lifetime modulo 2^32)
+     */
+    void snapshot(MetricHistogramSnapshot_t* out) const;
+
+    /**
+     * Deltas over the last closed window (max_us is the window maximum)
+     */
+    const MetricHistogramSnapshot_t& window() const { return _window; }
+
+    size_t format(char* buffer, size_t capacity, bool window) const override;
+    void closeWindow() override;
+    void reset() override;
+
+private:
+    std::atomic<uint32_t> _buckets[METRICS_HISTOGRAM_BUCKETS];
+    std::atomic<uint32_t> _count;
+    std::atomic<uint32_t> _sum_us;
+    std::atomic<uint32_t> _max_us;
+    std::atomic<uint32_t> _window_max_us;
+    MetricHistogramSnapshot_t _window_start;
+    MetricHistogramSnapshot_t _window;
+};
+
+/**
+ * Bucket index for a sample (branch-free apart from the clamp)
+ */
+uint8_t metricsBucketIndex(uint32_t us);
+
+/**
+ * Exclusive upper bound of a bucket in microseconds (UINT32_MAX for the last)
+ */
+uint32_t metricsBucketUpperUs(uint8_t bucket);
+
+/**
+ * Quantile estimate, interpolated inside the bucket and capped at max_us
+ * @param q 0.0 .. 1.0
+ * @return Microseconds, 0 if the snapshot is empty
+ */
+uint32_t metricsQuantileUs(const MetricHistogramSnapshot_t& snapshot, float q);
+
+/**
+ * Times the enclosing scope into a histogram
+ */
+class MetricScopedTimer {
+public:
+    explicit MetricScopedTimer(MetricHistogram& histogram)
+        : _histogram(histogram), _start_us(metricsNowUs()) {}
+    ~MetricScopedTimer() { _histogram.record(metricsNowUs() - _start_us); }
+
+private:
+    MetricScopedTimer(const MetricScopedTimer&);
+    MetricScopedTimer& operator=(const MetricScopedTimer&);
+
+    MetricHistogram& _histogram;
+    uint32_t _start_us;
+};
+
+#define METRICS_CONCAT_INNER(a, b)  a##b
+#define METRICS_CONCAT(a, b)        METRICS_CONCAT_INNER(a, b)
+
+/**
+ * METRIC_TIME_SCOPE(metric_gas_read_us); at the top of a function or block
+ */
+#define METRIC_TIME_SCOPE(histogram) \
+    MetricScopedTimer METRICS_CONCAT(metric_scope_, __LINE__)(histogram)
+
+#endif  // BINSAI_RUNTIME_METRICS_H
@@ -0,0 +1,142 @@
+/**
+ * BINSAI Serial Console - tokenizer, lookup and line handling
+ */
+
+#include "SerialConsole.h"
+#include <stdio.h>
+#include <string.h>
+
+void ConsoleOutput::print(const char* text) {
+    write(text, strlen(text));
+}
+
+void ConsoleOutput::println(const char* text) {
+    write(text, strlen(text));
+    write("\r\n", 2);
+}
+
+void ConsoleOutput::printf(const char* format, ...) {
+    char buffer[CONSOLE_FORMAT_BUFFER];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    if (length > 0) {
+        write(buffer, (size_t)length < sizeof(buffer) ? (size_t)length : sizeof(buffer) - 1);
+    }
+}
+
+uint8_t consoleTokenize(char* line, char* tokens[], uint8_t max_tokens) {
+    uint8_t count = 0;
+    char* cursor = line;
+
+    while (*cursor != '\0' && count < max_tokens) {
+        while (*cursor == ' ' || *cursor == '\t') {
+            cursor++;
+        }
+        if (*cursor == '\0') {
+            break;
+        }
+
+        if (*cursor == '"') {
+            // Quoted token: runs to the closing quote (or end of line)
+            tokens[count++] = ++cursor;
+            while (*cursor != '\0' && *cursor != '"') {
+                cursor++;
+            }
+        } else {
+            tokens[count++] = cursor;
+            while (*cursor != '\0' && *cursor != ' ' && *cursor != '\t') {
+                cursor++;
+            }
+        }
+
+        if (*cursor != '\0') {
+            *cursor++ = '\0';
+        }
+    }
+
+    return count;
+}
+
+const ConsoleCommand_t* consoleFind(const ConsoleCommand_t* table, size_t count,
+                                    const char* name) {
+    uint32_t hash = consoleHash(name);
+
+    for (size_t i = 0; i < count; i++) {
+        if (table[i].hash != hash) {
+            continue;
+        }
+
+        // Confirm the match to rule out hash collisions with unknown input
+        const char* a = table[i].name;
+        const char* b = name;
+        while (*a != '\0' && *a == consoleUpper(*b)) {
+            a++;
+            b++;
+        }
+        if (*a == '\0' && *b == '\0') {
+            return &table[i];
+        }
+    }
+
+    return NULL;
+}
+
+SerialConsole::SerialConsole(const ConsoleCommand_t* table, size_t count, ConsoleOutput& out)
+    : _table(table), _table_count(count), _out(out), _length(0), _overflow(false),
+      _command_count(0), _error_count(0) {
+    _line[0] = '\0';
+}
+
+bool SerialConsole::feed(char c) {
+    if (c == '\r' || c == '\n') {
+        bool dispatched = false;
+
+        if (_overflow) {
+            _out.println("ERROR line too long");
+            _error_count++;
+        } else if (_length > 0) {
+            _line[_length] = '\0';
+            dispatched = execute(_line);
+        }
+
+        _length = 0;
+        _overflow = false;
+        return dispatched;
+    }
+
+    if (_length < CONSOLE_LINE_MAX - 1) {
+        _line[_length++] = c;
+    } else {
+        _overflow = true;
+    }
+    return false;
+}
+
+bool SerialConsole::execute(char* line) {
+    char* argv[CONSOLE_MAX_TOKENS];
+    uint8_t argc = consoleTokenize(line, argv, CONSOLE_MAX_TOKENS);
+
+    if (argc == 0) {
+        return false;
+    }
+
+    const ConsoleCommand_t* command = consoleFind(_table, _table_count, argv[0]);
+    if (command == NULL) {
+        _out.printf("ERROR unknown command: %s\r\n", argv[0]);
+        _error_count++;
+        return false;
+    }
+
+    if (argc - 1 < command->min_args) {
+        _out.printf("ERROR usage: %s\r\n", command->usage);
+        _error_count++;
+        return false;
+    }
+
+    _command_count++;
+    command->handler(argc, argv, _out);
+    return true;
+}
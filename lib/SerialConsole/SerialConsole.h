@@ -0,0 +1,126 @@
+/**
+ * ============================================================================
+ * BINSAI Serial Console
+ * Zero-allocation line editor, tokenizer and command dispatcher
+ * ============================================================================
+ *
+ * DESIGN:
+ * - Input is collected into a fixed line buffer; overlong lines are dropped
+ * - Tokens are split in place (no copies, no heap)
+ * - Command tables are constexpr arrays; names are hashed at compile time
+ *   (FNV-1a, case-insensitive) so lookup is one hash plus one compare
+ * - consoleTableIsValid() lets the firmware static_assert on duplicate names
+ * ============================================================================
+ */
+
+#ifndef BINSAI_SERIAL_CONSOLE_H
+#define BINSAI_SERIAL_CONSOLE_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CONSOLE_LINE_MAX            128    // Bytes per command line (incl. NUL)
+#define CONSOLE_MAX_TOKENS          8      // Command name + arguments
+#define CONSOLE_FORMAT_BUFFER       128    // printf() scratch buffer
+
+/**
+ * Output sink (Serial in firmware, memory buffer in tests)
+ */
+class ConsoleOutput {
+public:
+    virtual ~ConsoleOutput() {}
+    virtual void write(const char* data, size_t length) = 0;
+
+    void print(const char* text);
+    void println(const char* text);
+    void printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+typedef void (*ConsoleHandler_t)(uint8_t argc, char* argv[], ConsoleOutput& out);
+
+typedef struct {
+    const char* name;               // Upper-case command name
+    uint32_t hash;                  // consoleHash(name)
+    uint8_t min_args;               // Required arguments after the name
+    const char* usage;              // Help text
+    ConsoleHandler_t handler;
+} ConsoleCommand_t;
+
+/**
+ * Case-insensitive FNV-1a hash, usable in constant expressions
+ */
+constexpr char consoleUpper(char c) {
+    return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+}
+
+constexpr uint32_t consoleHash(const char* text, uint32_t hash = 2166136261UL) {
+    return (*text == '\0') ? hash
+        : consoleHash(text + 1, (hash ^ (uint8_t)consoleUpper(*text)) * 16777619UL);
+}
+
+#define CONSOLE_COMMAND(name, min_args, usage, handler) \
+    { name, consoleHash(name), min_args, usage, handler }
+
+/**
+ * Compile-time check that no two commands share a hash
+ */
+constexpr bool consoleHashUnique(const ConsoleCommand_t* table, size_t count,
+                                 size_t i, size_t j) {
+    return (i >= count) ? true
+        : (j >= count) ? consoleHashUnique(table, count, i + 1, i + 2)
+        : (table[i].hash != table[j].hash) && consoleHashUnique(table, count, i, j + 1);
+}
+
+constexpr bool consoleTableIsValid(const ConsoleCommand_t* table, size_t count) {
+    return consoleHashUnique(table, count, 0, 1);
+}
+
+/**
+ * Split a line into whitespace-separated tokens in place
+ * Double quotes group a token containing spaces (e.g. SSIDs)
+ * @return Number of tokens (at most max_tokens)
+ */
+uint8_t consoleTokenize(char* line, char* tokens[], uint8_t max_tokens);
+
+/**
+ * Find a command by name
+ * @return Command entry, or NULL if unknown
+ */
+const ConsoleCommand_t* consoleFind(const ConsoleCommand_t* table, size_t count,
+                                    const char* name);
+
+/**
+ * Fixed-buffer console session
+ */
+class SerialConsole {
+public:
+    SerialConsole(const ConsoleCommand_t* table, size_t count, ConsoleOutput& out);
+
+    /**
+     * Feed one received character
+     * @return true if a complete line was dispatched
+     */
+    bool feed(char c);
+
+    /**
+     * Tokenize and dispatch a complete line (modified in place)
+     * @return true if a command handler ran
+     */
+    bool execute(char* line);
+
+    uint32_t commandCount() const { return _command_count; }
+    uint32_t errorCount() const { return _error_count; }
+
+private:
+    const ConsoleCommand_t* _table;
+    size_t _table_count;
+    ConsoleOutput& _out;
+    char _line[CONSOLE_LINE_MAX];
+    uint8_t _length;
+    bool _overflow;
+    uint32_t _command_count;
+    uint32_t _error_count;
+};
+
+#endif  // BINSAI_SERIAL_CONSOLE_H
@@ -0,0 +1,218 @@
+/**
+ * BINSAI Spatial Index - bucket maintenance and ring/box queries
+ */
+
+#include "SpatialIndex.h"
+#include <math.h>
+#include <algorithm>
+
+#define SPATIAL_METRES_PER_DEGREE   111320.0
+#define SPATIAL_FULL_SCAN_FACTOR    4       // Cells to visit vs occupied buckets
+
+static bool hitCloser(const SpatialHit_t& a, const SpatialHit_t& b) {
+    return a.distance_m != b.distance_m ? a.distance_m < b.distance_m : a.id < b.id;
+}
+
+SpatialIndex::SpatialIndex(double cell_deg) : _cell_deg(cell_deg > 0.0 ? cell_deg : SPATIAL_DEFAULT_CELL_DEG) {}
+
+double SpatialIndex::distanceMetres(double lat_a, double lon_a, double lat_b, double lon_b) {
+    double mean_lat = (lat_a + lat_b) * 0.5 * M_PI / 180.0;
+    double dx = (lon_b - lon_a) * cos(mean_lat);
+    double dy = lat_b - lat_a;
+    return sqrt(dx * dx + dy * dy) * SPATIAL_METRES_PER_DEGREE;
+}
+
+int32_t SpatialIndex::cellCoordinate(double degrees) const {
+    return (int32_t)floor(degrees / _cell_deg);
+}
+
+uint64_t SpatialIndex::cellKey(int32_t lat_cell, int32_t lon_cell) {
+    return ((uint64_t)(uint32_t)lat_cell << 32) | (uint32_t)lon_cell;
+}
+
+void SpatialIndex::detachFromBucket(const Location_t& location) {
+    std::unordered_map<uint64_t, std::vector<SpatialPoint_t> >::iterator it = _buckets.find(location.cell);
+    std::vector<SpatialPoint_t>& bucket = it->second;
+    if (location.bucket_slot + 1 != bucket.size()) {
+        bucket[location.bucket_slot] = bucket.back();
+        _locations[bucket.back().id].bucket_slot = location.bucket_slot;
+    }
+    bucket.pop_back();
+    if (bucket.empty()) {
+        _buckets.erase(it);
+    }
+}
+
+void SpatialIndex::detachFromZone(const Location_t& location) {
+    std::vector<uint64_t>& members = _zones[location.zone];
+    if (location.zone_slot + 1 != members.size()) {
+        members[location.zone_slot] = members.back();
+        _locations[members.back()].zone_slot = location.zone_slot;
+    }
+    members.pop_back();
+}
+
+bool SpatialIndex::upsert(const SpatialPoint_t& point) {
+    uint64_t cell = cellKey(cellCoordinate(point.latitude), cellCoordinate(point.longitude));
+    std::unordered_map<uint64_t, Location_t>::iterator it = _locations.find(point.id);
+
+    if (it == _locations.end()) {
+        std::vector<SpatialPoint_t>& bucket = _buckets[cell];
+        Location_t location;
+        location.cell = cell;
+        location.bucket_slot = (uint32_t)bucket.size();
+        location.zone = point.zone;
+        location.zone_slot = (uint32_t)_zones[point.zone].size();
+        bucket.push_back(point);
+        _zones[point.zone].push_back(point.id);
+        _locations[point.id] = location;
+        return true;
+    }
+
+    // Copy: detach*() rewrites slots of the entries they move
+    Location_t location = it->second;
+    if (location.cell == cell) {
+        _buckets[cell][location.bucket_slot] = point;
+    } else {
+        detachFromBucket(location);
+        std::vector<SpatialPoint_t>& bucket = _buckets[cell];
+        location.cell = cell;
+        location.bucket_slot = (uint32_t)bucket.size();
+        bucket.push_back(point);
+    }
+
+    if (location.zone != point.zone) {
+        detachFromZone(location);
+        location.zone = point.zone;
+        location.zone_slot = (uint32_t)_zones[point.zone].size();
+        _zones[point.zone].push_back(point.id);
+    }
+
+    it->second = location;
+    return false;
+}
+
+bool SpatialIndex::remove(uint64_t id) {
+    std::unordered_map<uint64_t, Location_t>::iterator it = _locations.find(id);
+    if (it == _locations.end()) {
+        return false;
+    }
+    Location_t location = it->second;
+    detachFromBucket(location);
+    detachFromZone(location);
+    _locations.erase(id);
+    return true;
+}
+
+bool SpatialIndex::find(uint64_t id, SpatialPoint_t* point) const {
+    std::unordered_map<uint64_t, Location_t>::const_iterator it = _locations.find(id);
+    if (it == _locations.end()) {
+        return false;
+    }
+    *point = _buckets.find(it->second.cell)->second[it->second.bucket_slot];
+    return true;
+}
+
+void SpatialIndex::scanCell(int32_t lat_cell, int32_t lon_cell, double latitude, double longitude,
+                            double max_distance_m, uint8_t min_priority,
+                            std::vector<SpatialHit_t>* hits) const {
+    std::unordered_map<uint64_t, std::vector<SpatialPoint_t> >::const_iterator it =
+        _buckets.find(cellKey(lat_cell, lon_cell));
+    if (it == _buckets.end()) {
+        return;
+    }
+    const std::vector<SpatialPoint_t>& bucket = it->second;
+    for (size_t i = 0; i < bucket.size(); i++) {
+        if (bucket[i].priority < min_priority) continue;
+        double distance = distanceMetres(latitude, longitude, bucket[i].latitude, bucket[i].longitude);
+        if (distance <= max_distance_m) {
+            SpatialHit_t hit = {bucket[i].id, distance};
+            hits->push_back(hit);
+        }
+    }
+}
+
+size_t SpatialIndex::withinRadius(double latitude, double longitude, double radius_m, uint8_t min_priority,
+                                  std::vector<SpatialHit_t>* results) const {
+    results->clear();
+    double lat_span = radius_m / SPATIAL_METRES_PER_DEGREE;
+    double cos_lat = cos((fabs(latitude) + lat_span) * M_PI / 180.0);
+    double lon_span = radius_m / (SPATIAL_METRES_PER_DEGREE * (cos_lat > 0.01 ? cos_lat : 0.01));
+
+    int32_t lat_lo = cellCoordinate(latitude - lat_span), lat_hi = cellCoordinate(latitude + lat_span);
+    int32_t lon_lo = cellCoordinate(longitude - lon_span), lon_hi = cellCoordinate(longitude + lon_span);
+    double cells = (double)(lat_hi - lat_lo + 1) * (lon_hi - lon_lo + 1);
+
+    if (cells > (double)_buckets.size() * SPATIAL_FULL_SCAN_FACTOR) {
+        // Query box covers most of the map: walk occupied buckets instead
+        for (std::unordered_map<uint64_t, std::vector<SpatialPoint_t> >::const_iterator it = _buckets.begin();
+             it != _buckets.end(); ++it) {
+            scanCell((int32_t)(it->first >> 32), (int32_t)(uint32_t)it->first, latitude, longitude,
+                     radius_m, min_priority, results);
+        }
+    } else {
+        for (int32_t lat_cell = lat_lo; lat_cell <= lat_hi; lat_cell++) {
+            for (int32_t lon_cell = lon_lo; lon_cell <= lon_hi; lon_cell++) {
+                scanCell(lat_cell, lon_cell, latitude, longitude, radius_m, min_priority, results);
+            }
+        }
+    }
+
+    std::sort(results->begin(), results->end(), hitCloser);
+    return results->size();
+}
+
+size_t SpatialIndex::nearest(double latitude, double longitude, size_t k, uint8_t min_priority,
+                             std::vector<SpatialHit_t>* results) const {
+    results->clear();
+    if (k == 0 || _locations.empty()) {
+        return 0;
+    }
+
+    // Smallest cell edge near the query, so rings never over-claim coverage
+    double cos_lat = cos((fabs(latitude) + 1.0) * M_PI / 180.0);
+    double cell_m = _cell_deg * SPATIAL_METRES_PER_DEGREE * (cos_lat > 0.01 ? cos_lat : 0.01);
+    const double unbounded = 1e300;
+    int32_t center_lat = cellCoordinate(latitude), center_lon = cellCoordinate(longitude);
+
+    for (int32_t ring = 0;; ring++) {
+        double side = 2.0 * ring + 1.0;
+        if (side * side > (double)_buckets.size() * SPATIAL_FULL_SCAN_FACTOR + 9.0) {
+            // Sparse neighbourhood: finish with a full scan
+            results->clear();
+            for (std::unordered_map<uint64_t, std::vector<SpatialPoint_t> >::const_iterator it = _buckets.begin();
+                 it != _buckets.end(); ++it) {
+                scanCell((int32_t)(it->first >> 32), (int32_t)(uint32_t)it->first, latitude, longitude,
+                         unbounded, min_priority, results);
+            }
+            break;
+        }
+
+        for (int32_t lat_cell = center_lat - ring; lat_cell <= center_lat + ring; lat_cell++) {
+            bool edge_row = (lat_cell == center_lat - ring || lat_cell == center_lat + ring);
+            int32_t step = (edge_row || ring == 0) ? 1 : 2 * ring;
+            for (int32_t lon_cell = center_lon - ring; lon_cell <= center_lon + ring; lon_cell += step) {
+                scanCell(lat_cell, lon_cell, latitude, longitude, unbounded, min_priority, results);
+            }
+        }
+
+        // Anything outside this ring is at least ring * cell_m away
+        if (results->size() >= k) {
+            std::nth_element(results->begin(), results->begin() + (k - 1), results->end(), hitCloser);
+            if ((*results)[k - 1].distance_m <= ring * cell_m) {
+                break;
+            }
+        }
+    }
+
+    std::sort(results->begin(), results->end(), hitCloser);
+    if (results->size() > k) {
+        results->resize(k);
+    }
+    return results->size();
+}
+
+size_t SpatialIndex::inZone(uint8_t zone, std::vector<uint64_t>* ids) const {
+    *ids = _zones[zone];
+    return ids->size();
+}
@@ -0,0 +1,109 @@
+/**
+ * ============================================================================
+ * BINSAI Spatial Index
+ * Grid-bucket index over bin coordinates for dispatcher queries (host side)
+ * ============================================================================
+ *
+ * Points live in fixed-size lat/lon cells (geohash-style buckets, default
+ * 0.0025 deg ~ 275 m) held in a hash map, so an update is O(1): look the
+ * id up, swap-remove it from its old bucket if the cell changed, append to
+ * the new one. A parallel per-zone list serves `deployment_zone` queries.
+ *
+ * Queries:
+ * - withinRadius(): scan the cells overlapping the bounding box
+ * - nearest():      expand rings of cells until the k-th hit is closer
+ *                   than any unvisited ring
+ * - inZone():       copy the zone list
+ *
+ * Distances use a local equirectangular approximation (error < 0.1%
+ * within a few km). Not thread-safe; FleetStore serialises access.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_SPATIAL_INDEX_H
+#define BINSAI_SPATIAL_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#define SPATIAL_DEFAULT_CELL_DEG    0.0025
+#define SPATIAL_ZONE_COUNT          256     // uint8_t deployment_zone
+
+typedef struct {
+    uint64_t id;
+    double latitude;
+    double longitude;
+    uint8_t zone;
+    uint8_t priority;
+} SpatialPoint_t;
+
+typedef struct {
+    uint64_t id;
+    double distance_m;
+} SpatialHit_t;
+
+class SpatialIndex {
+public:
+    explicit SpatialIndex(double cell_deg = SPATIAL_DEFAULT_CELL_DEG);
+
+    /**
+     * Insert or move a point
+     * @return true if the point was new
+     */
+    bool upsert(const SpatialPoint_t& point);
+
+    /**
+     * @return false if the id is unknown
+     */
+    bool remove(uint64_t id);
+
+    bool find(uint64_t id, SpatialPoint_t* point) const;
+    size_t size() const { return _locations.size(); }
+
+    /**
+     * Points within radius_m with priority >= min_priority, nearest first
+     * @return Number of hits (results is cleared first)
+     */
+    size_t withinRadius(double latitude, double longitude, double radius_m, uint8_t min_priority,
+                        std::vector<SpatialHit_t>* results) const;
+
+    /**
+     * k nearest points with priority >= min_priority, nearest first
+     */
+    size_t nearest(double latitude, double longitude, size_t k, uint8_t min_priority,
+                   std::vector<SpatialHit_t>* results) const;
+
+    /**
+     * Ids of every point in a zone (unordered)
+     */
+    size_t inZone(uint8_t zone, std::vector<uint64_t>* ids) const;
+
+    /**
+     * Equirectangular distance in metres
+     */
+    static double distanceMetres(double lat_a, double lon_a, double lat_b, double lon_b);
+
+private:
+    typedef struct {
+        uint64_t cell;
+        uint32_t bucket_slot;
+        uint32_t zone_slot;
+        uint8_t zone;
+    } Location_t;
+
+    int32_t cellCoordinate(double degrees) const;
+    static uint64_t cellKey(int32_t lat_cell, int32_t lon_cell);
+    void detachFromBucket(const Location_t& location);
+    void detachFromZone(const Location_t& location);
+    void scanCell(int32_t lat_cell, int32_t lon_cell, double latitude, double longitude,
+                  double max_distance_m, uint8_t min_priority, std::vector<SpatialHit_t>* hits) const;
+
+    double _cell_deg;
+    std::unordered_map<uint64_t, std::vector<SpatialPoint_t> > _buckets;
+    std::unordered_map<uint64_t, Location_t> _locations;
+    std::vector<uint64_t> _zones[SPATIAL_ZONE_COUNT];
+};
+
+#endif  // BINSAI_SPATIAL_INDEX_H
@@ -0,0 +1,118 @@
+/**
+ * BINSAI Telemetry Frame - encoder, CRC and view helpers
+ */
+
+#include "TelemetryFrame.h"
+#include <math.h>
+#include <string.h>
+
+static void putU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void putU32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * Scale and saturate a float into an unsigned 16-bit fixed point field
+ */
+static uint16_t scaleU16(float value, float scale) {
+    float scaled = value * scale + 0.5f;
+    if (!(scaled > 0.0f)) return 0;
+    if (scaled > 65535.0f) return 65535;
+    return (uint16_t)scaled;
+}
+
+uint16_t telemetryCrc16(const uint8_t* data, size_t length) {
+    // Nibble-wise table, same trade-off as configCrc32()
+    static const uint16_t CRC_TABLE[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+    };
+
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc = (uint16_t)((crc << 4) ^ CRC_TABLE[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ CRC_TABLE[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+uint8_t telemetryBootEpoch(uint32_t boots) {
+    return (uint8_t)(boots % 255 + 1);
+}
+
+size_t telemetryEncode(const SensorData_t& data, const TelemetryFrameMeta_t& meta,
+                       uint8_t* buffer, size_t capacity) {
+    if (capacity < TELEMETRY_FRAME_SIZE) {
+        return 0;
+    }
+
+    memset(buffer, 0, TELEMETRY_FRAME_SIZE);
+    putU16(buffer + 0, TELEMETRY_FRAME_MAGIC);
+    buffer[2] = TELEMETRY_FRAME_VERSION;
+    buffer[3] = meta.flags;
+    putU32(buffer + 4, meta.sequence);
+    strncpy((char*)buffer + 8, meta.device_id, TELEMETRY_DEVICE_ID_LEN);
+    putU32(buffer + 24, data.timestamp_unix);
+    putU32(buffer + 28, data.timestamp_millis);
+    putU32(buffer + 32, (uint32_t)(int32_t)lround(data.latitude * 1e7));
+    putU32(buffer + 36, (uint32_t)(int32_t)lround(data.longitude * 1e7));
+    putU16(buffer + 40, scaleU16(data.fill_percentage, 100.0f));
+    putU16(buffer + 42, scaleU16(data.distance_cm, 10.0f));
+    putU16(buffer + 44, scaleU16(data.ppm_calculated, 10.0f));
+    putU16(buffer + 46, data.adc_raw);
+    buffer[48] = data.capacity_level;
+    buffer[49] = data.waste_classification;
+    buffer[50] = data.priority_level;
+    buffer[51] = data.satellite_count;
+
+    float hours = data.hours_to_full < 0.0f ? -1.0f : data.hours_to_full;
+    if (hours > 3276.0f) hours = 3276.0f;
+    putU16(buffer + 52, (uint16_t)(int16_t)lroundf(hours * 10.0f));
+    putU16(buffer + 54, scaleU16(data.hdop, 100.0f));
+    putU32(buffer + 56, meta.trace_us);
+    buffer[60] = meta.deployment_zone;
+    buffer[61] = meta.boot_epoch;
+    putU16(buffer + 62, telemetryCrc16(buffer, TELEMETRY_FRAME_SIZE - 2));
+
+    return TELEMETRY_FRAME_SIZE;
+}
+
+bool TelemetryFrameView::validate() const {
+    return _length >= TELEMETRY_FRAME_SIZE &&
+           u16(0) == TELEMETRY_FRAME_MAGIC &&
+           _data[2] == TELEMETRY_FRAME_VERSION &&
+           u16(TELEMETRY_FRAME_SIZE - 2) == telemetryCrc16(_data, TELEMETRY_FRAME_SIZE - 2);
+}
+
+size_t TelemetryFrameView::deviceIdLength() const {
+    size_t length = 0;
+    while (length < TELEMETRY_DEVICE_ID_LEN && _data[8 + length] != '\0') {
+        length++;
+    }
+    return length;
+}
+
+void TelemetryFrameView::decode(SensorData_t* data) const {
+    memset(data, 0, sizeof(*data));
+    data->timestamp_unix = timestampUnix();
+    data->timestamp_millis = timestampMillis();
+    data->latitude = latitudeE7() / 1e7;
+    data->longitude = longitudeE7() / 1e7;
+    data->fill_percentage = fillCentiPercent() / 100.0f;
+    data->distance_cm = distanceMm() / 10.0f;
+    data->ppm_calculated = ppmDeci() / 10.0f;
+    data->adc_raw = adcRaw();
+    data->capacity_level = capacityLevel();
+    data->waste_classification = wasteClassification();
+    data->priority_level = priorityLevel();
+    data->satellite_count = satelliteCount();
+    data->hours_to_full = hoursToFullDeci() < 0 ? -1.0f : hoursToFullDeci() / 10.0f;
+    data->hdop = hdopCenti() / 100.0f;
+}
@@ -0,0 +1,134 @@
+/**
+ * ============================================================================
+ * BINSAI Telemetry Frame
+ * Fixed-size binary encoding of SensorData_t for fleet ingestion
+ * ============================================================================
+ *
+ * FRAME LAYOUT (little-endian, TELEMETRY_FRAME_SIZE bytes):
+ *  off size field
+ *    0   2  magic (0xB15A)
+ *    2   1  version
+ *    3   1  flags (TELEMETRY_FLAG_*)
+ *    4   4  sequence (per device, wraps)
+ *    8  16  device_id (NUL-padded)
+ *   24   4  timestamp_unix
+ *   28   4  timestamp_millis
+ *   32   4  latitude  (1e-7 deg)
+ *   36   4  longitude (1e-7 deg)
+ *   40   2  fill_percentage (0.01 %)
+ *   42   2  distance (mm)
+ *   44   2  ppm (0.1 ppm)
+ *   46   2  adc_raw
+ *   48   1  capacity_level
+ *   49   1  waste_classification
+ *   50   1  priority_level
+ *   51   1  satellite_count
+ *   52   2  hours_to_full (0.1 h, -10 = unknown)
+ *   54   2  hdop (0.01)
+ *   56   4  trace_us (load generator send time, 0 on devices)
+ *   60   1  deployment_zone (SystemConfig_t, since v2)
+ *   61   1  boot_epoch (low byte of the device boot count, 0 = not sent)
+ *   62   2  crc16 (CCITT-FALSE over bytes 0..61)
+ *
+ * TelemetryFrameView reads fields straight out of a received buffer
+ * (no copy, no allocation) once validate() has passed.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_TELEMETRY_FRAME_H
+#define BINSAI_TELEMETRY_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "definitions.h"
+
+#define TELEMETRY_FRAME_MAGIC       0xB15A
+#define TELEMETRY_FRAME_VERSION     2
+#define TELEMETRY_FRAME_SIZE        64
+#define TELEMETRY_DEVICE_ID_LEN     16
+
+#define TELEMETRY_FLAG_GPS_FIX      0x01
+#define TELEMETRY_FLAG_CRITICAL     0x02
+
+/**
+ * Per-frame fields that are not part of SensorData_t
+ */
+typedef struct {
+    const char* device_id;          // Truncated to TELEMETRY_DEVICE_ID_LEN
+    uint32_t sequence;
+    uint8_t flags;                  // TELEMETRY_FLAG_*
+    uint8_t deployment_zone;
+    uint32_t trace_us;              // 0 outside the load generator
+    uint8_t boot_epoch;             // Changes on every device restart, 0 = unknown
+} TelemetryFrameMeta_t;
+
+/**
+ * Encode a sensor sample
+ * @return Bytes written (TELEMETRY_FRAME_SIZE), or 0 if capacity too small
+ */
+size_t telemetryEncode(const SensorData_t& data, const TelemetryFrameMeta_t& meta,
+                       uint8_t* buffer, size_t capacity);
+
+/**
+ * Boot epoch for a persistent boot count: cycles through 1..255, never 0
+ */
+uint8_t telemetryBootEpoch(uint32_t boots);
+
+/**
+ * CRC-16/CCITT-FALSE
+ */
+uint16_t telemetryCrc16(const uint8_t* data, size_t length);
+
+/**
+ * Zero-copy accessor over a received frame
+ */
+class TelemetryFrameView {
+public:
+    TelemetryFrameView(const uint8_t* data, size_t length) : _data(data), _length(length) {}
+
+    /**
+     * Check size, magic, version and CRC
+     */
+    bool validate() const;
+
+    uint8_t flags() const { return _data[3]; }
+    uint32_t sequence() const { return u32(4); }
+    const char* deviceId() const { return (const char*)(_data + 8); }  // Not NUL-terminated at 16 chars
+    size_t deviceIdLength() const;
+    uint32_t timestampUnix() const { return u32(24); }
+    uint32_t timestampMillis() const { return u32(28); }
+    int32_t latitudeE7() const { return (int32_t)u32(32); }
+    int32_t longitudeE7() const { return (int32_t)u32(36); }
+    uint16_t fillCentiPercent() const { return u16(40); }
+    uint16_t distanceMm() const { return u16(42); }
+    uint16_t ppmDeci() const { return u16(44); }
+    uint16_t adcRaw() const { return u16(46); }
+    uint8_t capacityLevel() const { return _data[48]; }
+    uint8_t wasteClassification() const { return _data[49]; }
+    uint8_t priorityLevel() const { return _data[50]; }
+    uint8_t satelliteCount() const { return _data[51]; }
+    int16_t hoursToFullDeci() const { return (int16_t)u16(52); }
+    uint16_t hdopCenti() const { return u16(54); }
+    uint32_t traceMicros() const { return u32(56); }
+    uint8_t deploymentZone() const { return _data[60]; }
+    uint8_t bootEpoch() const { return _data[61]; }
+
+    /**
+     * Expand into a SensorData_t (for tools that need the full struct)
+     */
+    void decode(SensorData_t* data) const;
+
+private:
+    uint16_t u16(size_t offset) const {
+        return (uint16_t)(_data[offset] | (_data[offset + 1] << 8));
+    }
+    uint32_t u32(size_t offset) const {
+        return (uint32_t)_data[offset] | ((uint32_t)_data[offset + 1] << 8) |
+               ((uint32_t)_data[offset + 2] << 16) | ((uint32_t)_data[offset + 3] << 24);
+    }
+
+    const uint8_t* _data;
+    size_t _length;
+};
+
+#endif  // BINSAI_TELEMETRY_FRAME_H
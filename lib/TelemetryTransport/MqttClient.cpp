@@ -0,0 +1,386 @@
+/**
+ * BINSAI MQTT Client - QoS 1 publisher with offline queue
+ */
+
+#include "MqttClient.h"
+#include <string.h>
+
+void mqttClientDefaults(MqttClientConfig_t* config) {
+    config->client_id = "binsai";
+    config->username = NULL;
+    config->password = NULL;
+    config->topic = "binsai/telemetry";
+    config->event_topic = NULL;
+    config->keepalive_s = 60;
+    config->max_inflight = 4;
+    config->ack_timeout_ms = 10000;
+}
+
+size_t mqttEncodeLength(uint32_t length, uint8_t* out) {
+    size_t used = 0;
+    do {
+        uint8_t digit = (uint8_t)(length & 0x7F);
+        length >>= 7;
+        out[used++] = (uint8_t)(digit | (length ? 0x80 : 0));
+    } while (length && used < 4);
+    return used;
+}
+
+int mqttDecodeLength(const uint8_t* data, size_t available, uint32_t* length) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; i++) {
+        if (i >= available) {
+            return 0;
+        }
+        value |= (uint32_t)(data[i] & 0x7F) << (7 * i);
+        if (!(data[i] & 0x80)) {
+            *length = value;
+            return (int)(i + 1);
+        }
+    }
+    return -1;
+}
+
+static size_t putString(uint8_t* out, const char* text) {
+    size_t length = strlen(text);
+    out[0] = (uint8_t)(length >> 8);
+    out[1] = (uint8_t)length;
+    memcpy(out + 2, text, length);
+    return length + 2;
+}
+
+MqttClient::MqttClient(MqttStream& stream, const MqttClientConfig_t& config)
+    : _stream(stream), _config(config), _state(MQTT_STATE_DISCONNECTED),
+      _head(0), _count(0), _packet_id(0), _attempted(false), _attempt_ms(0),
+      _backoff_ms(MQTT_RECONNECT_MIN_MS), _last_tx_ms(0), _ping_outstanding(false),
+      _ping_ms(0), _rx_length(0) {
+    memset(&_stats, 0, sizeof(_stats));
+    if (_config.max_inflight < 1) _config.max_inflight = 1;
+    if (_config.max_inflight > MQTT_MAX_INFLIGHT) _config.max_inflight = MQTT_MAX_INFLIGHT;
+}
+
+bool MqttClient::publish(const uint8_t* payload, size_t length, uint32_t now_ms, MqttTopic_t topic) {
+    // Fixed header (max 5) + topic + packet id + payload must fit one packet
+    const char* name = topicName((uint8_t)topic);
+    if (!name || length > MQTT_MAX_PAYLOAD ||
+        5 + 2 + strlen(name) + 2 + length > MQTT_MAX_PACKET) {
+        return false;
+    }
+
+    if (_count == MQTT_QUEUE_DEPTH) {
+        _head = (_head + 1) % MQTT_QUEUE_DEPTH;
+        _count--;
+        _stats.dropped++;
+    }
+
+    QueuedMessage_t& message = entry(_count);
+    memcpy(message.payload, payload, length);
+    message.length = (uint8_t)length;
+    message.topic = (uint8_t)topic;
+    message.sent = false;
+    message.dup = false;
+    message.acked = false;
+    message.packet_id = 0;
+    message.queued_ms = now_ms;
+    message.sent_ms = 0;
+    _count++;
+    _stats.published++;
+
+    if (_state == MQTT_STATE_CONNECTED) {
+        sendPending(now_ms);
+    }
+    return true;
+}
+
+void MqttClient::loop(uint32_t now_ms) {
+    if (_state != MQTT_STATE_DISCONNECTED && !_stream.isOpen()) {
+        dropConnection(now_ms);
+    }
+
+    if (_state == MQTT_STATE_DISCONNECTED) {
+        if (!_attempted || now_ms - _attempt_ms >= _backoff_ms) {
+            startConnect(now_ms);
+        }
+        return;
+    }
+
+    receive(now_ms);
+
+    if (_state == MQTT_STATE_CONNECTING) {
+        if (now_ms - _attempt_ms >= _config.ack_timeout_ms) {
+            dropConnection(now_ms);
+        }
+        return;
+    }
+    if (_state != MQTT_STATE_CONNECTED) {
+        return;
+    }
+
+    // Only the oldest in-flight message can be the first to time out
+    for (size_t i = 0; i < _count; i++) {
+        QueuedMessage_t& message = entry(i);
+        if (message.sent && !message.acked) {
+            if (now_ms - message.sent_ms >= _config.ack_timeout_ms) {
+                dropConnection(now_ms);
+                return;
+            }
+            break;
+        }
+    }
+
+    if (_config.keepalive_s) {
+        uint32_t keepalive_ms = (uint32_t)_config.keepalive_s * 1000;
+        if (_ping_outstanding) {
+            if (now_ms - _ping_ms >= keepalive_ms) {
+                dropConnection(now_ms);
+                return;
+            }
+        } else if (now_ms - _last_tx_ms >= keepalive_ms) {
+            const uint8_t ping[2] = { MQTT_PACKET_PINGREQ, 0 };
+            if (!sendPacket(ping, sizeof(ping), now_ms)) {
+                return;
+            }
+            _ping_outstanding = true;
+            _ping_ms = now_ms;
+        }
+    }
+
+    sendPending(now_ms);
+}
+
+void MqttClient::disconnect(uint32_t now_ms) {
+    if (_state == MQTT_STATE_CONNECTED) {
+        const uint8_t packet[2] = { MQTT_PACKET_DISCONNECT, 0 };
+        if (!sendPacket(packet, sizeof(packet), now_ms)) {
+            return;
+        }
+    }
+    if (_state != MQTT_STATE_DISCONNECTED) {
+        dropConnection(now_ms);
+    }
+}
+
+void MqttClient::startConnect(uint32_t now_ms) {
+    _attempted = true;
+    _attempt_ms = now_ms;
+    _rx_length = 0;
+    _ping_outstanding = false;
+
+    size_t remaining = 10 + 2 + strlen(_config.client_id);
+    uint8_t flags = 0;  // CleanSession=0: broker keeps the session and our in-flight ids
+    if (_config.username) {
+        flags |= 0x80;
+        remaining += 2 + strlen(_config.username);
+    }
+    if (_config.password) {
+        flags |= 0x40;
+        remaining += 2 + strlen(_config.password);
+    }
+    if (5 + remaining > MQTT_MAX_PACKET) {
+        _backoff_ms = MQTT_RECONNECT_MAX_MS;  // Configuration error, do not spin
+        return;
+    }
+
+    if (!_stream.open()) {
+        _backoff_ms = (_backoff_ms * 2 > MQTT_RECONNECT_MAX_MS) ? MQTT_RECONNECT_MAX_MS : _backoff_ms * 2;
+        return;
+    }
+
+    size_t length = 0;
+    _tx[length++] = MQTT_PACKET_CONNECT;
+    length += mqttEncodeLength((uint32_t)remaining, _tx + length);
+    length += putString(_tx + length, "MQTT");
+    _tx[length++] = 4;  // Protocol level 3.1.1
+    _tx[length++] = flags;
+    _tx[length++] = (uint8_t)(_config.keepalive_s >> 8);
+    _tx[length++] = (uint8_t)_config.keepalive_s;
+    length += putString(_tx + length, _config.client_id);
+    if (_config.username) length += putString(_tx + length, _config.username);
+    if (_config.password) length += putString(_tx + length, _config.password);
+
+    _state = MQTT_STATE_CONNECTING;
+    sendPacket(_tx, length, now_ms);
+}
+
+void MqttClient::dropConnection(uint32_t now_ms) {
+    if (_state != MQTT_STATE_CONNECTED) {
+        _backoff_ms = (_backoff_ms * 2 > MQTT_RECONNECT_MAX_MS) ? MQTT_RECONNECT_MAX_MS : _backoff_ms * 2;
+    }
+
+    _stream.close();
+    _state = MQTT_STATE_DISCONNECTED;
+    _attempt_ms = now_ms;
+    _rx_length = 0;
+    _ping_outstanding = false;
+
+    for (size_t i = 0; i < _count; i++) {
+        QueuedMessage_t& message = entry(i);
+        if (message.sent) {
+            message.sent = false;
+            message.dup = true;
+        }
+    }
+}
+
+void MqttClient::receive(uint32_t now_ms) {
+    while (_rx_length < MQTT_MAX_PACKET) {
+        size_t received = _stream.read(_rx + _rx_length, MQTT_MAX_PACKET - _rx_length);
+        if (received == 0) {
+            break;
+        }
+        _rx_length += received;
+        _stats.bytes_received += received;
+    }
+
+    size_t offset = 0;
+    while (_rx_length - offset >= 2) {
+        uint32_t remaining = 0;
+        int used = mqttDecodeLength(_rx + offset + 1, _rx_length - offset - 1, &remaining);
+        if (used == 0) {
+            break;
+        }
+        size_t total = 1 + (size_t)used + remaining;
+        if (used < 0 || total > MQTT_MAX_PACKET) {
+            dropConnection(now_ms);  // Malformed, or larger than anything we expect
+            return;
+        }
+        if (_rx_length - offset < total) {
+            break;
+        }
+
+        handlePacket(_rx + offset, 1 + (size_t)used, remaining, now_ms);
+        if (_state == MQTT_STATE_DISCONNECTED) {
+            return;
+        }
+        offset += total;
+    }
+
+    memmove(_rx, _rx + offset, _rx_length - offset);
+    _rx_length -= offset;
+}
+
+void MqttClient::handlePacket(const uint8_t* packet, size_t header_length, size_t remaining,
+                              uint32_t now_ms) {
+    const uint8_t* body = packet + header_length;
+
+    switch (packet[0] & 0xF0) {
+        case MQTT_PACKET_CONNACK:
+            if (_state != MQTT_STATE_CONNECTING || remaining < 2) {
+                break;
+            }
+            if (body[1] != 0) {
+                dropConnection(now_ms);
+                _backoff_ms = MQTT_RECONNECT_MAX_MS;  // Refused (auth / client id)
+                break;
+            }
+            _state = MQTT_STATE_CONNECTED;
+            _backoff_ms = MQTT_RECONNECT_MIN_MS;
+            _stats.connects++;
+            if (body[0] & 0x01) {
+                _stats.session_resumed++;
+            }
+            break;
+
+        case MQTT_PACKET_PUBACK:
+            if (remaining >= 2) {
+                handlePuback((uint16_t)((body[0] << 8) | body[1]), now_ms);
+            }
+            break;
+
+        case MQTT_PACKET_PINGRESP:
+            _ping_outstanding = false;
+            break;
+
+        case MQTT_PACKET_PUBLISH: {
+            // Not subscribed, but a resumed session may still deliver: ack QoS 1
+            size_t topic_length = remaining >= 2 ? (size_t)((body[0] << 8) | body[1]) : remaining;
+            if (((packet[0] >> 1) & 0x03) == 1 && remaining >= 2 + topic_length + 2) {
+                uint8_t ack[4] = { MQTT_PACKET_PUBACK, 2, body[2 + topic_length], body[3 + topic_length] };
+                sendPacket(ack, sizeof(ack), now_ms);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void MqttClient::handlePuback(uint16_t packet_id, uint32_t now_ms) {
+    for (size_t i = 0; i < _count; i++) {
+        QueuedMessage_t& message = entry(i);
+        if (message.sent && !message.acked && message.packet_id == packet_id) {
+            message.acked = true;
+            _stats.acked++;
+            _stats.last_latency_ms = now_ms - message.queued_ms;
+            if (_stats.last_latency_ms > _stats.max_latency_ms) {
+                _stats.max_latency_ms = _stats.last_latency_ms;
+            }
+            break;
+        }
+    }
+
+    while (_count && entry(0).acked) {
+        _head = (_head + 1) % MQTT_QUEUE_DEPTH;
+        _count--;
+    }
+}
+
+void MqttClient::sendPending(uint32_t now_ms) {
+    size_t inflight = 0;
+
+    for (size_t i = 0; i < _count; i++) {
+        QueuedMessage_t& message = entry(i);
+        if (message.acked) {
+            continue;
+        }
+        if (message.sent) {
+            inflight++;
+            continue;
+        }
+        if (inflight >= _config.max_inflight) {
+            break;
+        }
+        if (message.packet_id == 0) {
+            message.packet_id = nextPacketId();
+        }
+
+        const char* topic = topicName(message.topic);
+        size_t length = 0;
+        _tx[length++] = (uint8_t)(MQTT_PACKET_PUBLISH | (message.dup ? 0x08 : 0) | 0x02);
+        length += mqttEncodeLength((uint32_t)(2 + strlen(topic) + 2 + message.length), _tx + length);
+        length += putString(_tx + length, topic);
+        _tx[length++] = (uint8_t)(message.packet_id >> 8);
+        _tx[length++] = (uint8_t)message.packet_id;
+        memcpy(_tx + length, message.payload, message.length);
+        length += message.length;
+
+        if (!sendPacket(_tx, length, now_ms)) {
+            return;
+        }
+        if (message.dup) {
+            _stats.resent++;
+        }
+        message.sent = true;
+        message.sent_ms = now_ms;
+        inflight++;
+    }
+}
+
+bool MqttClient::sendPacket(const uint8_t* packet, size_t length, uint32_t now_ms) {
+    size_t written = _stream.write(packet, length);
+    _stats.bytes_sent += written;
+    if (written != length) {
+        dropConnection(now_ms);
+        return false;
+    }
+    _last_tx_ms = now_ms;
+    return true;
+}
+
+uint16_t MqttClient::nextPacketId() {
+    if (++_packet_id == 0) {
+        _packet_id = 1;
+    }
+    return _packet_id;
+}
@@ -0,0 +1,208 @@
+/**
+ * ============================================================================
+ * BINSAI MQTT Client
+ * Minimal MQTT 3.1.1 publisher: QoS 1, persistent session, offline queue
+ * ============================================================================
+ *
+ * Publish-only client for a telemetry topic and an optional event topic
+ * (boot health reports). Messages are copied into a
+ * fixed ring (MQTT_QUEUE_DEPTH entries, no heap) and stay there until the
+ * broker's PUBACK arrives, so samples taken while the link is down are
+ * delivered in order after reconnecting. When the ring is full the oldest
+ * message is dropped.
+ *
+ * CONNECT always uses CleanSession=0. After a reconnect every unacknowledged
+ * PUBLISH is resent with DUP=1 as MQTT 3.1.1 section 4.4 requires. There is
+ * no timer-based retransmission. A missing PUBACK (ack_timeout_ms) or PINGRESP
+ * (keepalive) is treated as a dead connection and handled the same way.
+ *
+ * Every packet is built in one buffer and passed to MqttStream::write() in a
+ * single call. On TLS that is one record per packet.
+ *
+ * All timing comes from the now_ms passed to loop()/publish(), so the
+ * client runs unchanged against a simulated clock on the host.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_MQTT_CLIENT_H
+#define BINSAI_MQTT_CLIENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MQTT_DEFAULT_PORT           1883
+#define MQTT_MAX_PACKET             256
+#define MQTT_MAX_PAYLOAD            96
+#define MQTT_QUEUE_DEPTH            32
+#define MQTT_MAX_INFLIGHT           8
+#define MQTT_RECONNECT_MIN_MS       1000
+#define MQTT_RECONNECT_MAX_MS       60000
+
+#define MQTT_PACKET_CONNECT         0x10
+#define MQTT_PACKET_CONNACK         0x20
+#define MQTT_PACKET_PUBLISH         0x30
+#define MQTT_PACKET_PUBACK          0x40
+#define MQTT_PACKET_PINGREQ         0xC0
+#define MQTT_PACKET_PINGRESP        0xD0
+#define MQTT_PACKET_DISCONNECT      0xE0
+
+/**
+ * Byte stream under the client (WiFiClient on the device, loopback on host)
+ */
+class MqttStream {
+public:
+    virtual ~MqttStream() {}
+
+    /**
+     * (Re)open the connection to the broker
+     */
+    virtual bool open() = 0;
+    virtual bool isOpen() = 0;
+    virtual void close() = 0;
+
+    /**
+     * @return Bytes accepted (short write means the connection is unusable)
+     */
+    virtual size_t write(const uint8_t* data, size_t length) = 0;
+
+    /**
+     * Non-blocking read
+     * @return Bytes copied, 0 if nothing is pending
+     */
+    virtual size_t read(uint8_t* buffer, size_t capacity) = 0;
+};
+
+typedef enum {
+    MQTT_TOPIC_TELEMETRY = 0,       // MqttClientConfig_t::topic
+    MQTT_TOPIC_EVENT                // MqttClientConfig_t::event_topic
+} MqttTopic_t;
+
+typedef enum {
+    MQTT_STATE_DISCONNECTED = 0,
+    MQTT_STATE_CONNECTING,          // CONNECT sent, waiting for CONNACK
+    MQTT_STATE_CONNECTED
+} MqttState_t;
+
+/**
+ * Strings are not copied and must outlive the client
+ */
+typedef struct {
+    const char* client_id;          // Also the persistent session key
+    const char* username;           // NULL for none
+    const char* password;           // NULL for none
+    const char* topic;
+    const char* event_topic;        // NULL disables MQTT_TOPIC_EVENT
+    uint16_t keepalive_s;
+    uint8_t max_inflight;           // Unacknowledged PUBLISH window (1..MQTT_MAX_INFLIGHT)
+    uint32_t ack_timeout_ms;        // PUBACK / CONNACK wait before dropping the link
+} MqttClientConfig_t;
+
+typedef struct {
+    uint32_t published;             // publish() calls accepted
+    uint32_t acked;
+    uint32_t resent;                // DUP retransmissions after reconnect
+    uint32_t dropped;               // Evicted from a full queue
+    uint32_t connects;              // CONNACKs accepted
+    uint32_t session_resumed;       // ... of which had session_present set
+    uint32_t bytes_sent;
+    uint32_t bytes_received;
+    uint32_t last_latency_ms;       // publish() -> PUBACK, most recent message
+    uint32_t max_latency_ms;
+} MqttStats_t;
+
+/**
+ * Defaults: 60 s keepalive, 4 in flight, 10 s ack timeout
+ */
+void mqttClientDefaults(MqttClientConfig_t* config);
+
+class MqttClient {
+public:
+    MqttClient(MqttStream& stream, const MqttClientConfig_t& config);
+
+    /**
+     * Queue a QoS 1 message on one of the configured topics (sent from loop())
+     * @return false if the payload exceeds MQTT_MAX_PAYLOAD or the topic is
+     *         not configured
+     */
+    bool publish(const uint8_t* payload, size_t length, uint32_t now_ms,
+                 MqttTopic_t topic = MQTT_TOPIC_TELEMETRY);
+
+    /**
+     * Connect / reconnect with backoff, read acks, keep alive and send
+     * queued messages. Call every loop iteration.
+     */
+    void loop(uint32_t now_ms);
+
+    /**
+     * Send DISCONNECT and close. Queue and session are kept. loop()
+     * reconnects after the backoff.
+     */
+    void disconnect(uint32_t now_ms);
+
+    MqttState_t state() const { return _state; }
+    bool connected() const { return _state == MQTT_STATE_CONNECTED; }
+    size_t queued() const { return _count; }
+    const MqttStats_t& stats() const { return _stats; }
+
+private:
+    typedef struct {
+        uint8_t payload[MQTT_MAX_PAYLOAD];
+        uint8_t length;
+        uint8_t topic;              // MqttTopic_t
+        bool sent;                  // In flight on the current connection
+        bool dup;                   // Was sent on an earlier connection
+        bool acked;                 // Waiting to be popped from the head
+        uint16_t packet_id;
+        uint32_t queued_ms;
+        uint32_t sent_ms;
+    } QueuedMessage_t;
+
+    QueuedMessage_t& entry(size_t index) { return _queue[(_head + index) % MQTT_QUEUE_DEPTH]; }
+    const char* topicName(uint8_t topic) const {
+        return topic == MQTT_TOPIC_EVENT ? _config.event_topic : _config.topic;
+    }
+
+    void startConnect(uint32_t now_ms);
+    void dropConnection(uint32_t now_ms);
+    void receive(uint32_t now_ms);
+    void handlePacket(const uint8_t* packet, size_t header_length, size_t remaining, uint32_t now_ms);
+    void handlePuback(uint16_t packet_id, uint32_t now_ms);
+    void sendPending(uint32_t now_ms);
+    bool sendPacket(const uint8_t* packet, size_t length, uint32_t now_ms);
+    uint16_t nextPacketId();
+
+    MqttStream& _stream;
+    MqttClientConfig_t _config;
+    MqttState_t _state;
+    MqttStats_t _stats;
+
+    QueuedMessage_t _queue[MQTT_QUEUE_DEPTH];
+    size_t _head;
+    size_t _count;
+    uint16_t _packet_id;
+
+    bool _attempted;
+    uint32_t _attempt_ms;
+    uint32_t _backoff_ms;
+    uint32_t _last_tx_ms;
+    bool _ping_outstanding;
+    uint32_t _ping_ms;
+
+    uint8_t _tx[MQTT_MAX_PACKET];
+    uint8_t _rx[MQTT_MAX_PACKET];
+    size_t _rx_length;
+};
+
+/**
+ * Encode an MQTT remaining-length varint
+ * @return Bytes written (1..4)
+ */
+size_t mqttEncodeLength(uint32_t length, uint8_t* out);
+
+/**
+ * Decode an MQTT remaining-length varint
+ * @return Bytes consumed, 0 if incomplete, -1 if malformed
+ */
+int mqttDecodeLength(const uint8_t* data, size_t available, uint32_t* length);
+
+#endif  // BINSAI_MQTT_CLIENT_H
@@ -0,0 +1,194 @@
+/**
+ * BINSAI MQTT Loopback Broker - broker stand-in over a simulated link
+ */
+
+#include "MqttLoopbackBroker.h"
+#include <string.h>
+
+MqttLoopbackBroker::MqttLoopbackBroker(const MqttLinkModel_t& link)
+    : _link(link), _client_end(*this), _online(true), _connected(false), _acking(true),
+      _now_ms(0), _up_busy_ms(0), _down_busy_ms(0) {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void MqttLoopbackBroker::setOnline(bool online) {
+    _online = online;
+    if (!online) {
+        closeConnection();
+    }
+}
+
+void MqttLoopbackBroker::closeConnection() {
+    // Bytes still on the wire are lost with the connection
+    _connected = false;
+    _up.clear();
+    _down.clear();
+    _rx.clear();
+    _client_end._read_offset = 0;
+}
+
+void MqttLoopbackBroker::transmit(std::deque<Chunk_t>* queue, uint32_t* busy_until, const uint8_t* data,
+                                  size_t length, uint64_t* segments, uint64_t* wire_bytes) {
+    uint32_t wire = (uint32_t)length + _link.segment_overhead;
+    uint32_t start = (_now_ms > *busy_until) ? _now_ms : *busy_until;
+    uint32_t serialise = _link.bits_per_ms ? (wire * 8 + _link.bits_per_ms - 1) / _link.bits_per_ms : 0;
+    *busy_until = start + serialise;
+
+    Chunk_t chunk;
+    chunk.deliver_ms = *busy_until + _link.one_way_ms;
+    chunk.bytes.assign(data, data + length);
+    queue->push_back(chunk);
+
+    (*segments)++;
+    *wire_bytes += wire;
+}
+
+bool MqttLoopbackBroker::ClientEnd::open() {
+    if (!_broker._online) {
+        return false;
+    }
+    _broker.closeConnection();
+    _broker._connected = true;
+    return true;
+}
+
+size_t MqttLoopbackBroker::ClientEnd::write(const uint8_t* data, size_t length) {
+    if (!_broker._connected) {
+        return 0;
+    }
+    _broker.transmit(&_broker._up, &_broker._up_busy_ms, data, length,
+                     &_broker._stats.segments_up, &_broker._stats.wire_bytes_up);
+    return length;
+}
+
+size_t MqttLoopbackBroker::ClientEnd::read(uint8_t* buffer, size_t capacity) {
+    size_t copied = 0;
+    std::deque<Chunk_t>& down = _broker._down;
+    while (copied < capacity && !down.empty() && down.front().deliver_ms <= _broker._now_ms) {
+        const std::vector<uint8_t>& bytes = down.front().bytes;
+        size_t take = bytes.size() - _read_offset;
+        if (take > capacity - copied) {
+            take = capacity - copied;
+        }
+        memcpy(buffer + copied, &bytes[_read_offset], take);
+        copied += take;
+        _read_offset += take;
+        if (_read_offset == bytes.size()) {
+            down.pop_front();
+            _read_offset = 0;
+        }
+    }
+    return copied;
+}
+
+void MqttLoopbackBroker::advance(uint32_t now_ms) {
+    _now_ms = now_ms;
+
+    while (_connected && !_up.empty() && _up.front().deliver_ms <= now_ms) {
+        _rx.insert(_rx.end(), _up.front().bytes.begin(), _up.front().bytes.end());
+        _up.pop_front();
+    }
+
+    size_t offset = 0;
+    while (_connected && _rx.size() - offset >= 2) {
+        uint32_t remaining = 0;
+        int used = mqttDecodeLength(&_rx[offset + 1], _rx.size() - offset - 1, &remaining);
+        if (used < 0) {
+            closeConnection();
+            return;
+        }
+        if (used == 0 || _rx.size() - offset < 1 + (size_t)used + remaining) {
+            break;
+        }
+        handlePacket(&_rx[offset], 1 + (size_t)used, remaining);
+        offset += 1 + (size_t)used + remaining;
+    }
+
+    if (_connected) {
+        _rx.erase(_rx.begin(), _rx.begin() + offset);
+    }
+}
+
+void MqttLoopbackBroker::reply(const uint8_t* data, size_t length) {
+    transmit(&_down, &_down_busy_ms, data, length, &_stats.segments_down, &_stats.wire_bytes_down);
+}
+
+void MqttLoopbackBroker::handlePacket(const uint8_t* packet, size_t header_length, size_t remaining) {
+    const uint8_t* body = packet + header_length;
+
+    switch (packet[0] & 0xF0) {
+        case MQTT_PACKET_CONNECT: {
+            // "MQTT", level, flags, keepalive, then the client id string
+            if (remaining < 12) {
+                closeConnection();
+                return;
+            }
+            bool clean = (body[7] & 0x02) != 0;
+            size_t id_length = (size_t)((body[10] << 8) | body[11]);
+            std::string client_id((const char*)body + 12, id_length < remaining - 12 ? id_length : remaining - 12);
+
+            bool present = !clean && _sessions.count(client_id);
+            if (clean) {
+                _sessions.erase(client_id);
+            } else {
+                _sessions.insert(client_id);
+            }
+            _stats.connects++;
+            if (present) {
+                _stats.sessions_resumed++;
+            }
+
+            const uint8_t connack[4] = { MQTT_PACKET_CONNACK, 2, (uint8_t)(present ? 1 : 0), 0 };
+            reply(connack, sizeof(connack));
+            break;
+        }
+
+        case MQTT_PACKET_PUBLISH: {
+            if (remaining < 2) {
+                break;
+            }
+            MqttBrokerMessage_t message;
+            size_t topic_length = (size_t)((body[0] << 8) | body[1]);
+            size_t offset = 2 + topic_length;
+            message.qos = (uint8_t)((packet[0] >> 1) & 0x03);
+            message.dup = (packet[0] & 0x08) != 0;
+            message.packet_id = 0;
+            if (message.qos > 0) {
+                if (remaining < offset + 2) break;
+                message.packet_id = (uint16_t)((body[offset] << 8) | body[offset + 1]);
+                offset += 2;
+            }
+            if (remaining < offset) {
+                break;
+            }
+            message.topic.assign((const char*)body + 2, topic_length);
+            message.payload.assign(body + offset, body + remaining);
+            message.arrival_ms = _now_ms;
+            _messages.push_back(message);
+
+            if (message.qos == 1) {
+                if (_acking) {
+                    const uint8_t puback[4] = { MQTT_PACKET_PUBACK, 2, (uint8_t)(message.packet_id >> 8),
+                                                (uint8_t)message.packet_id };
+                    reply(puback, sizeof(puback));
+                } else {
+                    _stats.pubacks_withheld++;
+                }
+            }
+            break;
+        }
+
+        case MQTT_PACKET_PINGREQ: {
+            const uint8_t pingresp[2] = { MQTT_PACKET_PINGRESP, 0 };
+            reply(pingresp, sizeof(pingresp));
+            break;
+        }
+
+        case MQTT_PACKET_DISCONNECT:
+            closeConnection();
+            break;
+
+        default:
+            break;
+    }
+}
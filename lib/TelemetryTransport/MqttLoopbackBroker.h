@@ -0,0 +1,130 @@
+/**
+ * ============================================================================
+ * BINSAI MQTT Loopback Broker
+ * In-memory broker stand-in and link model for host tests
+ * ============================================================================
+ *
+ * Handles enough of the broker side of MQTT 3.1.1 to test MqttClient:
+ * CONNECT (persistent sessions keyed by client id), QoS 0/1 PUBLISH,
+ * PINGREQ and DISCONNECT. It can be taken offline or told to withhold
+ * PUBACKs to simulate outages and lost acks.
+ *
+ * Both directions go through a link model on the caller's clock. Each
+ * write() becomes one segment that is serialised at bits_per_ms and
+ * arrives one_way_ms later. Wire bytes include segment_overhead (TCP/IP
+ * headers, plus the TLS record when modelling TLS), so byte counts can be
+ * compared with the Blynk path.
+ *
+ * Drive it with advance(now) before each MqttClient::loop(now).
+ * ============================================================================
+ */
+
+#ifndef BINSAI_MQTT_LOOPBACK_BROKER_H
+#define BINSAI_MQTT_LOOPBACK_BROKER_H
+
+#include <stdint.h>
+#include <deque>
+#include <set>
+#include <string>
+#include <vector>
+#include "MqttClient.h"
+
+#define MQTT_LINK_TCPIP_OVERHEAD    40      // IPv4 + TCP headers per segment
+#define MQTT_LINK_TLS_OVERHEAD      29      // TLS 1.2 AES-GCM record: header + nonce + tag
+
+typedef struct {
+    uint32_t one_way_ms;
+    uint32_t bits_per_ms;           // 0 = unlimited (1000 = 1 Mbit/s)
+    uint16_t segment_overhead;      // Added to every write() on the wire
+} MqttLinkModel_t;
+
+typedef struct {
+    std::string topic;
+    std::vector<uint8_t> payload;
+    uint16_t packet_id;
+    uint8_t qos;
+    bool dup;
+    uint32_t arrival_ms;
+} MqttBrokerMessage_t;
+
+typedef struct {
+    uint64_t segments_up;
+    uint64_t wire_bytes_up;         // Client -> broker including overhead
+    uint64_t segments_down;
+    uint64_t wire_bytes_down;
+    uint32_t connects;
+    uint32_t sessions_resumed;
+    uint32_t pubacks_withheld;
+} MqttBrokerStats_t;
+
+class MqttLoopbackBroker {
+public:
+    explicit MqttLoopbackBroker(const MqttLinkModel_t& link);
+
+    /**
+     * Client end of the link
+     */
+    MqttStream& stream() { return _client_end; }
+
+    /**
+     * Deliver due bytes to the broker, handle them and queue replies
+     */
+    void advance(uint32_t now_ms);
+
+    /**
+     * Offline drops the current connection and refuses open()
+     */
+    void setOnline(bool online);
+
+    /**
+     * While false, QoS 1 PUBLISH is stored but never acknowledged
+     */
+    void setAcking(bool acking) { _acking = acking; }
+
+    const std::vector<MqttBrokerMessage_t>& messages() const { return _messages; }
+    const MqttBrokerStats_t& stats() const { return _stats; }
+
+private:
+    typedef struct {
+        uint32_t deliver_ms;
+        std::vector<uint8_t> bytes;
+    } Chunk_t;
+
+    class ClientEnd : public MqttStream {
+    public:
+        explicit ClientEnd(MqttLoopbackBroker& broker) : _broker(broker), _read_offset(0) {}
+        bool open() override;
+        bool isOpen() override { return _broker._connected; }
+        void close() override { _broker.closeConnection(); }
+        size_t write(const uint8_t* data, size_t length) override;
+        size_t read(uint8_t* buffer, size_t capacity) override;
+
+    private:
+        friend class MqttLoopbackBroker;
+        MqttLoopbackBroker& _broker;
+        size_t _read_offset;
+    };
+
+    void transmit(std::deque<Chunk_t>* queue, uint32_t* busy_until, const uint8_t* data,
+                  size_t length, uint64_t* segments, uint64_t* wire_bytes);
+    void handlePacket(const uint8_t* packet, size_t header_length, size_t remaining);
+    void reply(const uint8_t* data, size_t length);
+    void closeConnection();
+
+    MqttLinkModel_t _link;
+    ClientEnd _client_end;
+    bool _online;
+    bool _connected;
+    bool _acking;
+    uint32_t _now_ms;
+    uint32_t _up_busy_ms;
+    uint32_t _down_busy_ms;
+    std::deque<Chunk_t> _up;
+    std::deque<Chunk_t> _down;
+    std::vector<uint8_t> _rx;
+    std::set<std::string> _sessions;
+    std::vector<MqttBrokerMessage_t> _messages;
+    MqttBrokerStats_t _stats;
+};
+
+#endif  // BINSAI_MQTT_LOOPBACK_BROKER_H
@@ -0,0 +1,29 @@
+/**
+ * BINSAI Telemetry Transport - MQTT sample and health report encoding
+ */
+
+#include "TelemetryTransport.h"
+#include <stdio.h>
+
+bool MqttTelemetryTransport::publishSample(const SensorData_t& data, const TelemetryFrameMeta_t& meta,
+                                           uint32_t now_ms) {
+    uint8_t frame[TELEMETRY_FRAME_SIZE];
+    size_t length = telemetryEncode(data, meta, frame, sizeof(frame));
+    return length && _client.publish(frame, length, now_ms);
+}
+
+bool MqttTelemetryTransport::publishHealth(const HealthReport_t& report, uint32_t now_ms) {
+    uint8_t payload[HEALTH_REPORT_SIZE];
+    size_t length = healthReportEncode(report, payload, sizeof(payload));
+    return length && _client.publish(payload, length, now_ms, MQTT_TOPIC_EVENT);
+}
+
+bool mqttTelemetryTopic(const char* device_id, char* buffer, size_t capacity) {
+    int written = snprintf(buffer, capacity, "binsai/%s/telemetry", device_id);
+    return written > 0 && (size_t)written < capacity;
+}
+
+bool mqttHealthTopic(const char* device_id, char* buffer, size_t capacity) {
+    int written = snprintf(buffer, capacity, "binsai/%s/health", device_id);
+    return written > 0 && (size_t)written < capacity;
+}
@@ -0,0 +1,86 @@
+/**
+ * ============================================================================
+ * BINSAI Telemetry Transport
+ * Pluggable per-sample uplink behind the sensor loop
+ * ============================================================================
+ *
+ * Firmware keeps a short list of transports (Blynk virtual pins, MQTT) and
+ * gives each one the same sample every INTERVAL_SENSOR_READ_MS. When a
+ * transport is offline it either drops the sample (Blynk) or queues it
+ * (MQTT).
+ *
+ * MqttTelemetryTransport publishes the sample as a single TelemetryFrame,
+ * the same 64-byte layout the fleet UDP uplink uses, to
+ * binsai/<device_id>/telemetry with QoS 1. The boot health report
+ * (HealthMonitor) goes to binsai/<device_id>/health when that event topic
+ * is configured.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_TELEMETRY_TRANSPORT_H
+#define BINSAI_TELEMETRY_TRANSPORT_H
+
+#include <stdint.h>
+#include "definitions.h"
+#include "HealthMonitor.h"
+#include "MqttClient.h"
+#include "TelemetryFrame.h"
+
+class TelemetryTransport {
+public:
+    virtual ~TelemetryTransport() {}
+
+    virtual const char* name() const = 0;
+
+    /**
+     * Connection upkeep, called every loop iteration
+     */
+    virtual void loop(uint32_t now_ms) = 0;
+
+    virtual bool connected() const = 0;
+
+    /**
+     * Hand over one sample
+     * @return false if the sample was dropped
+     */
+    virtual bool publishSample(const SensorData_t& data, const TelemetryFrameMeta_t& meta,
+                               uint32_t now_ms) = 0;
+
+    /**
+     * Hand over the boot health report
+     * @return false if this transport does not carry events or is offline
+     */
+    virtual bool publishHealth(const HealthReport_t&, uint32_t) { return false; }
+};
+
+class MqttTelemetryTransport : public TelemetryTransport {
+public:
+    MqttTelemetryTransport(MqttStream& stream, const MqttClientConfig_t& config)
+        : _client(stream, config) {}
+
+    const char* name() const override { return "MQTT"; }
+    void loop(uint32_t now_ms) override { _client.loop(now_ms); }
+    bool connected() const override { return _client.connected(); }
+    bool publishSample(const SensorData_t& data, const TelemetryFrameMeta_t& meta,
+                       uint32_t now_ms) override;
+    bool publishHealth(const HealthReport_t& report, uint32_t now_ms) override;
+
+    MqttClient& client() { return _client; }
+
+private:
+    MqttClient _client;
+};
+
+/**
+ * Format binsai/<device_id>/telemetry
+ * @return false if the buffer is too small
+ */
+bool mqttTelemetryTopic(const char* device_id, char* buffer, size_t capacity);
+
+/**
+ * Format binsai/<device_id>/health
+ * @return false if the buffer is too small
+ */
+bool mqttHealthTopic(const char* device_id, char* buffer, size_t capacity);
+
+#endif  // BINSAI_TELEMETRY_TRANSPORT_H
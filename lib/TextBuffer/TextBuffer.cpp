@@ -0,0 +1,122 @@
+/**
+ * BINSAI Text Buffer - bounded appends and printf-free number formatting
+ */
+
+#include "TextBuffer.h"
+#include <string.h>
+
+size_t textFormatUnsigned(char* out, uint32_t value) {
+    char reversed[TEXT_UNSIGNED_MAX];
+    size_t count = 0;
+    do {
+        reversed[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    for (size_t i = 0; i < count; i++) {
+        out[i] = reversed[count - 1 - i];
+    }
+    return count;
+}
+
+TextBuffer::TextBuffer(char* storage, size_t capacity)
+    : _data(storage), _capacity(capacity), _length(0), _truncated(false) {
+    _data[0] = '\0';
+}
+
+void TextBuffer::clear() {
+    _length = 0;
+    _truncated = false;
+    _data[0] = '\0';
+}
+
+TextBuffer& TextBuffer::append(const char* text, size_t length) {
+    size_t room = _capacity - 1 - _length;
+    if (length > room) {
+        length = room;
+        _truncated = true;
+    }
+    memcpy(_data + _length, text, length);
+    _length += length;
+    _data[_length] = '\0';
+    return *this;
+}
+
+TextBuffer& TextBuffer::append(const char* text) {
+    return append(text, strlen(text));
+}
+
+TextBuffer& TextBuffer::append(char c) {
+    return append(&c, 1);
+}
+
+TextBuffer& TextBuffer::appendUnsigned(uint32_t value) {
+    char digits[TEXT_UNSIGNED_MAX];
+    return append(digits, textFormatUnsigned(digits, value));
+}
+
+TextBuffer& TextBuffer::appendSigned(int32_t value) {
+    if (value < 0) {
+        append('-');
+        return appendUnsigned(0U - (uint32_t)value);
+    }
+    return appendUnsigned((uint32_t)value);
+}
+
+TextBuffer& TextBuffer::appendFixed(double value, uint8_t decimals) {
+    if (value != value) return append("nan");
+    if (value > 1.7976931348623157e308 || value < -1.7976931348623157e308) return append("inf");
+    if (value > 4294967040.0) return append("ovf");
+    if (value < -4294967040.0) return append("-ovf");
+
+    if (decimals > TEXT_FIXED_DECIMALS_MAX) {
+        decimals = TEXT_FIXED_DECIMALS_MAX;
+    }
+
+    // Same steps as Print::printFloat: round in floating point, then print
+    // the integer part and peel off one fractional digit at a time
+    double number = value;
+    if (number < 0.0) {
+        append('-');
+        number = -number;
+    }
+    double rounding = 0.5;
+    for (uint8_t i = 0; i < decimals; i++) {
+        rounding /= 10.0;
+    }
+    number += rounding;
+
+    uint32_t integer_part = (uint32_t)number;
+    double remainder = number - (double)integer_part;
+    appendUnsigned(integer_part);
+
+    if (decimals > 0) {
+        append('.');
+    }
+    while (decimals-- > 0) {
+        remainder *= 10.0;
+        uint8_t digit = (uint8_t)remainder;
+        append((char)('0' + digit));
+        remainder -= digit;
+    }
+    return *this;
+}
+
+void TextBuffer::pushRolling(char c) {
+    if (_length + 1 >= _capacity) {
+        size_t keep = (_capacity - 1) / 2;
+        memmove(_data, _data + _length - keep, keep);
+        _length = keep;
+    }
+    _data[_length++] = c;
+    _data[_length] = '\0';
+}
+
+bool TextBuffer::endsWith(const char* suffix) const {
+    size_t length = strlen(suffix);
+    return length <= _length && memcmp(_data + _length - length, suffix, length) == 0;
+}
+
+bool TextBuffer::contains(const char* needle) const {
+    return strstr(_data, needle) != NULL;
+}
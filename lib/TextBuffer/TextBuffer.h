@@ -0,0 +1,95 @@
+/**
+ * ============================================================================
+ * BINSAI Text Buffer
+ * Fixed-capacity string building without heap or printf
+ * ============================================================================
+ *
+ * Replaces Arduino String on the alert and telemetry paths, where every
+ * `+` is a realloc and months of uptime fragment the 520 KB heap.
+ *
+ * - TextBuffer writes into caller storage (a stack array, a struct field)
+ *   and silently truncates at capacity; truncated() reports it
+ * - FixedText<N> bundles its own storage for locals
+ * - Numbers are formatted by hand: newlib's printf("%f") path allocates
+ *   dtoa scratch on first use per task, and it is ~10x slower. appendFixed()
+ *   prints exactly what Arduino Print::print(float, digits) prints
+ * - pushRolling() keeps the newest characters of an unbounded stream (AT
+ *   command replies) so endsWith() can match a token as it arrives
+ * ============================================================================
+ */
+
+#ifndef BINSAI_TEXT_BUFFER_H
+#define BINSAI_TEXT_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TEXT_UNSIGNED_MAX           10     // Digits in UINT32_MAX
+#define TEXT_FIXED_DECIMALS_MAX     7      // Beyond float precision anyway
+
+class TextBuffer {
+public:
+    /**
+     * @param storage Caller-owned memory, NUL-terminated on construction
+     * @param capacity Bytes in storage, including the terminator (>= 1)
+     */
+    TextBuffer(char* storage, size_t capacity);
+
+    void clear();
+
+    TextBuffer& append(const char* text);
+    TextBuffer& append(const char* text, size_t length);
+    TextBuffer& append(char c);
+    TextBuffer& appendUnsigned(uint32_t value);
+    TextBuffer& appendSigned(int32_t value);
+
+    /**
+     * Fixed-point decimal, rounded half away from zero
+     * NaN prints "nan", infinities "inf" and |value| > 4294967040 "ovf" /
+     * "-ovf", matching Arduino Print
+     */
+    TextBuffer& appendFixed(double value, uint8_t decimals);
+
+    /**
+     * Append one character of a stream, discarding the oldest half of the
+     * buffer when full (keep capacity > 2x the longest token to match)
+     */
+    void pushRolling(char c);
+
+    bool endsWith(const char* suffix) const;
+    bool contains(const char* needle) const;
+
+    const char* c_str() const { return _data; }
+    size_t length() const { return _length; }
+    size_t capacity() const { return _capacity; }
+    bool truncated() const { return _truncated; }
+
+private:
+    TextBuffer(const TextBuffer&);
+    TextBuffer& operator=(const TextBuffer&);
+
+    char* _data;
+    size_t _capacity;
+    size_t _length;
+    bool _truncated;
+};
+
+/**
+ * TextBuffer with inline storage
+ */
+template <size_t N>
+class FixedText : public TextBuffer {
+public:
+    FixedText() : TextBuffer(_storage, N) {}
+
+private:
+    char _storage[N];
+};
+
+/**
+ * Decimal digits of value into out (no terminator)
+ * @return Digits written (1 .. TEXT_UNSIGNED_MAX)
+ */
+size_t textFormatUnsigned(char* out, uint32_t value);
+
+#endif  // BINSAI_TEXT_BUFFER_H
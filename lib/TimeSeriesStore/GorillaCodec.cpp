@@ -0,0 +1,113 @@
+/**
+ * BINSAI Gorilla Codec - timestamp and XOR value streams
+ */
+
+#include "GorillaCodec.h"
+
+void TimestampEncoder::append(int64_t timestamp) {
+    if (_count++ == 0) {
+        _writer->write((uint64_t)timestamp, 64);
+        _previous = timestamp;
+        return;
+    }
+
+    int64_t delta = timestamp - _previous;
+    int64_t dod = delta - _delta;
+    _delta = delta;
+    _previous = timestamp;
+
+    if (dod == 0) {
+        _writer->write(0x0, 1);
+    } else if (dod >= -63 && dod <= 64) {
+        _writer->write(0x2, 2);
+        _writer->write((uint64_t)(dod + 63), 7);
+    } else if (dod >= -255 && dod <= 256) {
+        _writer->write(0x6, 3);
+        _writer->write((uint64_t)(dod + 255), 9);
+    } else if (dod >= -2047 && dod <= 2048) {
+        _writer->write(0xE, 4);
+        _writer->write((uint64_t)(dod + 2047), 12);
+    } else {
+        _writer->write(0xF, 4);
+        _writer->write((uint64_t)dod, 64);
+    }
+}
+
+int64_t TimestampDecoder::next() {
+    if (_count++ == 0) {
+        _previous = (int64_t)_reader->read(64);
+        return _previous;
+    }
+
+    int64_t dod;
+    if (!_reader->readBit()) {
+        dod = 0;
+    } else if (!_reader->readBit()) {
+        dod = (int64_t)_reader->read(7) - 63;
+    } else if (!_reader->readBit()) {
+        dod = (int64_t)_reader->read(9) - 255;
+    } else if (!_reader->readBit()) {
+        dod = (int64_t)_reader->read(12) - 2047;
+    } else {
+        dod = (int64_t)_reader->read(64);
+    }
+
+    _delta += dod;
+    _previous += _delta;
+    return _previous;
+}
+
+void XorEncoder::append(uint64_t bits) {
+    if (_count++ == 0) {
+        _writer->write(bits, _width);
+        _previous = bits;
+        return;
+    }
+
+    uint64_t x = bits ^ _previous;
+    _previous = bits;
+    if (x == 0) {
+        _writer->write(0x0, 1);
+        return;
+    }
+
+    uint8_t field_bits = (_width == 64) ? 6 : 5;
+    uint8_t leading = (uint8_t)(__builtin_clzll(x) - (64 - _width));
+    uint8_t trailing = (uint8_t)__builtin_ctzll(x);
+
+    if (_leading != 0xFF && leading >= _leading && trailing >= _trailing) {
+        // Reuse the previous meaningful-bit window
+        _writer->write(0x2, 2);
+        _writer->write(x >> _trailing, (uint8_t)(_width - _leading - _trailing));
+    } else {
+        uint8_t length = (uint8_t)(_width - leading - trailing);
+        _writer->write(0x3, 2);
+        _writer->write(leading, field_bits);
+        _writer->write(length - 1, field_bits);
+        _writer->write(x >> trailing, length);
+        _leading = leading;
+        _trailing = trailing;
+    }
+}
+
+uint64_t XorDecoder::next() {
+    if (_count++ == 0) {
+        _previous = _reader->read(_width);
+        return _previous;
+    }
+
+    if (!_reader->readBit()) {
+        return _previous;
+    }
+
+    if (_reader->readBit()) {
+        uint8_t field_bits = (_width == 64) ? 6 : 5;
+        _leading = (uint8_t)_reader->read(field_bits);
+        uint8_t length = (uint8_t)(_reader->read(field_bits) + 1);
+        _trailing = (uint8_t)(_width - _leading - length);
+    }
+
+    uint8_t length = (uint8_t)(_width - _leading - _trailing);
+    _previous ^= _reader->read(length) << _trailing;
+    return _previous;
+}
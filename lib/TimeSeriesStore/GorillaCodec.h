@@ -0,0 +1,159 @@
+/**
+ * ============================================================================
+ * BINSAI Gorilla Codec
+ * Bit streams, delta-of-delta timestamps and XOR-compressed values
+ * ============================================================================
+ *
+ * Encodings follow Pelkonen et al., "Gorilla" (VLDB 2015):
+ *
+ * Timestamps (int64 ms), delta-of-delta D against the previous delta:
+ *   D == 0              '0'
+ *   D in [-63, 64]      '10'   + 7 bits
+ *   D in [-255, 256]    '110'  + 9 bits
+ *   D in [-2047, 2048]  '1110' + 12 bits
+ *   otherwise           '1111' + 64 bits
+ *
+ * Values (32- or 64-bit patterns), X = value ^ previous:
+ *   X == 0                         '0'
+ *   fits previous zero window      '10' + meaningful bits
+ *   otherwise                      '11' + leading zeros + (length - 1) + bits
+ *
+ * Field widths are 5/5 bits for 32-bit values and 6/6 for 64-bit values.
+ * Integer columns reuse the 32-bit XOR path: repeated levels cost 1 bit.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_GORILLA_CODEC_H
+#define BINSAI_GORILLA_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>* out) : _out(out), _accumulator(0), _bits(0) {}
+
+    void write(uint64_t value, uint8_t count) {
+        for (uint8_t remaining = count; remaining > 0;) {
+            uint8_t take = remaining < (uint8_t)(8 - _bits) ? remaining : (uint8_t)(8 - _bits);
+            uint8_t chunk = (uint8_t)((value >> (remaining - take)) & ((1U << take) - 1));
+            _accumulator = (uint8_t)((_accumulator << take) | chunk);
+            _bits += take;
+            remaining -= take;
+            if (_bits == 8) {
+                _out->push_back(_accumulator);
+                _accumulator = 0;
+                _bits = 0;
+            }
+        }
+    }
+
+    void writeBit(bool bit) { write(bit ? 1 : 0, 1); }
+
+    /**
+     * Pad the final byte with zeros
+     */
+    void flush() {
+        if (_bits > 0) {
+            _out->push_back((uint8_t)(_accumulator << (8 - _bits)));
+            _accumulator = 0;
+            _bits = 0;
+        }
+    }
+
+private:
+    std::vector<uint8_t>* _out;
+    uint8_t _accumulator;
+    uint8_t _bits;
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t length) : _data(data), _length(length), _position(0) {}
+
+    /**
+     * Read count bits MSB-first; bits past the end read as 0
+     */
+    uint64_t read(uint8_t count) {
+        uint64_t value = 0;
+        for (uint8_t remaining = count; remaining > 0;) {
+            size_t byte = _position >> 3;
+            uint8_t offset = (uint8_t)(_position & 7);
+            uint8_t take = remaining < (uint8_t)(8 - offset) ? remaining : (uint8_t)(8 - offset);
+            uint8_t current = byte < _length ? _data[byte] : 0;
+            uint8_t chunk = (uint8_t)((current >> (8 - offset - take)) & ((1U << take) - 1));
+            value = (value << take) | chunk;
+            _position += take;
+            remaining -= take;
+        }
+        return value;
+    }
+
+    bool readBit() { return read(1) != 0; }
+    bool overrun() const { return (_position + 7) / 8 > _length; }
+
+private:
+    const uint8_t* _data;
+    size_t _length;
+    size_t _position;       // In bits
+};
+
+class TimestampEncoder {
+public:
+    explicit TimestampEncoder(BitWriter* writer) : _writer(writer), _count(0), _previous(0), _delta(0) {}
+    void append(int64_t timestamp);
+
+private:
+    BitWriter* _writer;
+    uint32_t _count;
+    int64_t _previous;
+    int64_t _delta;
+};
+
+class TimestampDecoder {
+public:
+    explicit TimestampDecoder(BitReader* reader) : _reader(reader), _count(0), _previous(0), _delta(0) {}
+    int64_t next();
+
+private:
+    BitReader* _reader;
+    uint32_t _count;
+    int64_t _previous;
+    int64_t _delta;
+};
+
+/**
+ * XOR value encoder over raw bit patterns of width 32 or 64
+ */
+class XorEncoder {
+public:
+    XorEncoder(BitWriter* writer, uint8_t width)
+        : _writer(writer), _width(width), _count(0), _previous(0), _leading(0xFF), _trailing(0) {}
+    void append(uint64_t bits);
+
+private:
+    BitWriter* _writer;
+    uint8_t _width;
+    uint32_t _count;
+    uint64_t _previous;
+    uint8_t _leading;
+    uint8_t _trailing;
+};
+
+class XorDecoder {
+public:
+    XorDecoder(BitReader* reader, uint8_t width)
+        : _reader(reader), _width(width), _count(0), _previous(0), _leading(0), _trailing(0) {}
+    uint64_t next();
+
+private:
+    BitReader* _reader;
+    uint8_t _width;
+    uint32_t _count;
+    uint64_t _previous;
+    uint8_t _leading;
+    uint8_t _trailing;
+};
+
+#endif  // BINSAI_GORILLA_CODEC_H
@@ -0,0 +1,512 @@
+/**
+ * BINSAI Time-Series Store - segment writer, mmap reader and queries
+ */
+
+#include "TimeSeriesStore.h"
+#include "GorillaCodec.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+
+#define TS_STREAM_COUNT             (TS_COLUMN_COUNT + 1)   // Stream 0 = timestamps
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t column_count;
+    uint32_t record_count;
+    uint32_t reserved;
+    int64_t t_min;
+    int64_t t_max;
+    char device_id[TS_DEVICE_ID_LEN];
+    uint32_t stream_offset[TS_STREAM_COUNT + 1];   // Last entry = end of file
+} SegmentHeader_t;
+
+typedef enum {
+    TS_KIND_F32,
+    TS_KIND_F64,
+    TS_KIND_U32
+} TsColumnKind_t;
+
+typedef struct {
+    const char* name;
+    TsColumnKind_t kind;
+} TsColumnInfo_t;
+
+static const TsColumnInfo_t TS_COLUMNS[TS_COLUMN_COUNT] = {
+    {"distance",      TS_KIND_F32},
+    {"fill",          TS_KIND_F32},
+    {"ppm",           TS_KIND_F32},
+    {"hours_to_full", TS_KIND_F32},
+    {"latitude",      TS_KIND_F64},
+    {"longitude",     TS_KIND_F64},
+    {"adc_raw",       TS_KIND_U32},
+    {"gps_fix",       TS_KIND_U32},
+    {"satellites",    TS_KIND_U32},
+    {"capacity",      TS_KIND_U32},
+    {"waste_class",   TS_KIND_U32},
+    {"priority",      TS_KIND_U32},
+};
+
+static uint64_t floatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static uint64_t doubleBits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * Raw bit pattern of one column of a record
+ */
+static uint64_t columnBits(const ResearchRecord_t& record, int column) {
+    switch (column) {
+        case TS_COLUMN_DISTANCE:       return floatBits(record.distance_cm);
+        case TS_COLUMN_FILL:           return floatBits(record.fill_percentage);
+        case TS_COLUMN_PPM:            return floatBits(record.ppm_calculated);
+        case TS_COLUMN_HOURS_TO_FULL:  return floatBits(record.hours_to_full);
+        case TS_COLUMN_LATITUDE:       return doubleBits(record.latitude);
+        case TS_COLUMN_LONGITUDE:      return doubleBits(record.longitude);
+        case TS_COLUMN_ADC_RAW:        return record.adc_raw;
+        case TS_COLUMN_GPS_FIX:        return record.gps_fix;
+        case TS_COLUMN_SATELLITES:     return record.satellite_count;
+        case TS_COLUMN_CAPACITY_LEVEL: return record.capacity_level;
+        case TS_COLUMN_WASTE_CLASS:    return record.waste_classification;
+        default:                       return record.priority_level;
+    }
+}
+
+static double bitsToValue(uint64_t bits, TsColumnKind_t kind) {
+    if (kind == TS_KIND_F32) {
+        uint32_t narrow = (uint32_t)bits;
+        float value;
+        memcpy(&value, &narrow, sizeof(value));
+        return value;
+    }
+    if (kind == TS_KIND_F64) {
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    return (double)(uint32_t)bits;
+}
+
+static void setColumn(ResearchRecord_t* record, int column, double value) {
+    switch (column) {
+        case TS_COLUMN_DISTANCE:       record->distance_cm = (float)value; break;
+        case TS_COLUMN_FILL:           record->fill_percentage = (float)value; break;
+        case TS_COLUMN_PPM:            record->ppm_calculated = (float)value; break;
+        case TS_COLUMN_HOURS_TO_FULL:  record->hours_to_full = (float)value; break;
+        case TS_COLUMN_LATITUDE:       record->latitude = value; break;
+        case TS_COLUMN_LONGITUDE:      record->longitude = value; break;
+        case TS_COLUMN_ADC_RAW:        record->adc_raw = (uint16_t)value; break;
+        case TS_COLUMN_GPS_FIX:        record->gps_fix = (uint8_t)value; break;
+        case TS_COLUMN_SATELLITES:     record->satellite_count = (uint8_t)value; break;
+        case TS_COLUMN_CAPACITY_LEVEL: record->capacity_level = (uint8_t)value; break;
+        case TS_COLUMN_WASTE_CLASS:    record->waste_classification = (uint8_t)value; break;
+        default:                       record->priority_level = (uint8_t)value; break;
+    }
+}
+
+int tsColumnFromName(const char* name) {
+    for (int i = 0; i < TS_COLUMN_COUNT; i++) {
+        if (strcasecmp(name, TS_COLUMNS[i].name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool researchRecordFromCsv(const char* line, int64_t base_unix_ms, ResearchRecord_t* record) {
+    static const char PREFIX[] = "[RESEARCH] ";
+    if (strncmp(line, PREFIX, sizeof(PREFIX) - 1) == 0) {
+        line += sizeof(PREFIX) - 1;
+    }
+
+    // 13 columns, plus unix_ms from firmware with the time service
+    double fields[14];
+    const char* cursor = line;
+    int count = 0;
+    while (count < 14) {
+        char* end;
+        fields[count] = strtod(cursor, &end);
+        if (end == cursor) return false;
+        cursor = end;
+        count++;
+        if (*cursor != ',') break;
+        cursor++;
+    }
+    if (count < 13 || *cursor == ',') return false;
+    while (*cursor == '\r' || *cursor == '\n' || *cursor == ' ') cursor++;
+    if (*cursor != '\0') return false;
+
+    memset(record, 0, sizeof(*record));
+    record->timestamp_ms = base_unix_ms + (int64_t)fields[0];
+    if (count == 14 && fields[13] > 0.0) {
+        record->timestamp_ms = (int64_t)fields[13];     // Synced wall clock
+    }
+    record->distance_cm = (float)fields[1];
+    record->fill_percentage = (float)fields[2];
+    record->ppm_calculated = (float)fields[3];
+    record->adc_raw = (uint16_t)fields[4];
+    record->gps_fix = (uint8_t)fields[5];
+    record->latitude = fields[6];
+    record->longitude = fields[7];
+    record->satellite_count = (uint8_t)fields[8];
+    record->capacity_level = (uint8_t)fields[9];
+    record->waste_classification = (uint8_t)fields[10];
+    record->priority_level = (uint8_t)fields[11];
+    record->hours_to_full = (float)fields[12];
+    return true;
+}
+
+int researchRecordToCsv(const ResearchRecord_t& record, int64_t base_unix_ms, char* buffer, size_t capacity) {
+    return snprintf(buffer, capacity, "%" PRId64 ",%.2f,%.2f,%.2f,%u,%u,%.6f,%.6f,%u,%u,%u,%u,%.1f",
+                    record.timestamp_ms - base_unix_ms, record.distance_cm, record.fill_percentage,
+                    record.ppm_calculated, record.adc_raw, record.gps_fix, record.latitude,
+                    record.longitude, record.satellite_count, record.capacity_level,
+                    record.waste_classification, record.priority_level, record.hours_to_full);
+}
+
+TimeSeriesStore::TimeSeriesStore(const std::string& root) : _root(root) {}
+
+TimeSeriesStore::~TimeSeriesStore() {
+    for (std::map<std::string, Partition>::iterator it = _partitions.begin(); it != _partitions.end(); ++it) {
+        for (size_t i = 0; i < it->second.segments.size(); i++) {
+            unmapSegment(&it->second.segments[i]);
+        }
+    }
+}
+
+bool TimeSeriesStore::mapSegment(const std::string& path, Segment* segment) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(SegmentHeader_t)) {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    SegmentHeader_t header;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != TS_SEGMENT_MAGIC || header.version != TS_SEGMENT_VERSION ||
+        header.column_count != TS_COLUMN_COUNT || header.stream_offset[TS_STREAM_COUNT] != info.st_size) {
+        munmap(data, (size_t)info.st_size);
+        return false;
+    }
+
+    segment->path = path;
+    segment->data = (const uint8_t*)data;
+    segment->length = (size_t)info.st_size;
+    segment->t_min = header.t_min;
+    segment->t_max = header.t_max;
+    segment->record_count = header.record_count;
+    return true;
+}
+
+void TimeSeriesStore::unmapSegment(Segment* segment) {
+    if (segment->data) {
+        munmap((void*)segment->data, segment->length);
+        segment->data = NULL;
+    }
+}
+
+
+bool TimeSeriesStore::open() {
+    mkdir(_root.c_str(), 0755);
+    DIR* root = opendir(_root.c_str());
+    if (!root) {
+        return false;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(root)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+        std::string device_dir = _root + "/" + entry->d_name;
+        DIR* partition_dir = opendir(device_dir.c_str());
+        if (!partition_dir) continue;
+
+        Partition& partition = _partitions[entry->d_name];
+        struct dirent* file;
+        while ((file = readdir(partition_dir)) != NULL) {
+            std::string name = file->d_name;
+            std::string path = device_dir + "/" + name;
+            if (name.size() > 4 && name.compare(name.size() - 4, 4, ".tmp") == 0) {
+                unlink(path.c_str());  // Interrupted writeSegment()
+                continue;
+            }
+            if (name.size() <= 4 || name.compare(name.size() - 4, 4, ".tsb") != 0) continue;
+
+            Segment segment;
+            if (mapSegment(path, &segment)) {
+                partition.segments.push_back(segment);
+            } else {
+                fprintf(stderr, "[TSDB] skipping unreadable segment %s\n", path.c_str());
+            }
+        }
+        closedir(partition_dir);
+
+        std::sort(partition.segments.begin(), partition.segments.end(),
+                  [](const Segment& a, const Segment& b) { return a.t_min < b.t_min; });
+    }
+    closedir(root);
+    return true;
+}
+
+bool TimeSeriesStore::append(const char* device_id, const ResearchRecord_t& record) {
+    size_t length = strnlen(device_id, TS_DEVICE_ID_LEN);
+    if (length == 0 || length >= TS_DEVICE_ID_LEN || strchr(device_id, '/') || device_id[0] == '.') {
+        return false;
+    }
+
+    Partition& partition = _partitions[device_id];
+    const ResearchRecord_t* last = NULL;
+    if (!partition.pending.empty()) {
+        last = &partition.pending.back();
+    }
+    if ((last && record.timestamp_ms < last->timestamp_ms) ||
+        (!last && !partition.segments.empty() && record.timestamp_ms <= partition.segments.back().t_max)) {
+        return false;  // Out of order
+    }
+
+    partition.pending.push_back(record);
+    if (partition.pending.size() >= TS_SEGMENT_RECORDS) {
+        return writeSegment(device_id, partition);
+    }
+    return true;
+}
+
+bool TimeSeriesStore::flush() {
+    bool ok = true;
+    for (std::map<std::string, Partition>::iterator it = _partitions.begin(); it != _partitions.end(); ++it) {
+        if (!it->second.pending.empty()) {
+            ok = writeSegment(it->first, it->second) && ok;
+        }
+    }
+    return ok;
+}
+
+bool TimeSeriesStore::writeSegment(const std::string& device_id, Partition& partition) {
+    const std::vector<ResearchRecord_t>& records = partition.pending;
+
+    SegmentHeader_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = TS_SEGMENT_MAGIC;
+    header.version = TS_SEGMENT_VERSION;
+    header.column_count = TS_COLUMN_COUNT;
+    header.record_count = (uint32_t)records.size();
+    header.t_min = records.front().timestamp_ms;
+    header.t_max = records.back().timestamp_ms;
+    strncpy(header.device_id, device_id.c_str(), sizeof(header.device_id) - 1);
+
+    std::vector<uint8_t> body;
+    body.reserve(records.size() * 8);
+
+    header.stream_offset[0] = sizeof(SegmentHeader_t);
+    {
+        BitWriter writer(&body);
+        TimestampEncoder encoder(&writer);
+        for (size_t i = 0; i < records.size(); i++) encoder.append(records[i].timestamp_ms);
+        writer.flush();
+    }
+    for (int column = 0; column < TS_COLUMN_COUNT; column++) {
+        header.stream_offset[column + 1] = (uint32_t)(sizeof(SegmentHeader_t) + body.size());
+        BitWriter writer(&body);
+        XorEncoder encoder(&writer, TS_COLUMNS[column].kind == TS_KIND_F64 ? 64 : 32);
+        for (size_t i = 0; i < records.size(); i++) encoder.append(columnBits(records[i], column));
+        writer.flush();
+    }
+    header.stream_offset[TS_STREAM_COUNT] = (uint32_t)(sizeof(SegmentHeader_t) + body.size());
+
+    std::string directory = _root + "/" + device_id;
+    mkdir(directory.c_str(), 0755);
+    char name[32];
+    snprintf(name, sizeof(name), "/%016" PRIx64 ".tsb", (uint64_t)header.t_min);
+    std::string path = directory + name;
+    std::string temp = path + ".tmp";
+
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header) &&
+              write(fd, body.data(), body.size()) == (ssize_t)body.size() &&
+              fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(temp.c_str(), path.c_str()) != 0) {
+        unlink(temp.c_str());
+        return false;
+    }
+
+    Segment segment;
+    if (!mapSegment(path, &segment)) {
+        return false;
+    }
+    partition.segments.push_back(segment);
+    partition.pending.clear();
+    return true;
+}
+
+bool TimeSeriesStore::decodeTimestamps(const Segment& segment, std::vector<int64_t>* timestamps) {
+    const SegmentHeader_t* header = (const SegmentHeader_t*)segment.data;
+    uint32_t start = header->stream_offset[0];
+    uint32_t end = header->stream_offset[1];
+    BitReader reader(segment.data + start, end - start);
+    TimestampDecoder decoder(&reader);
+
+    timestamps->resize(segment.record_count);
+    for (uint32_t i = 0; i < segment.record_count; i++) {
+        (*timestamps)[i] = decoder.next();
+    }
+    return !reader.overrun();
+}
+
+bool TimeSeriesStore::decodeColumn(const Segment& segment, int column, std::vector<double>* values) {
+    const SegmentHeader_t* header = (const SegmentHeader_t*)segment.data;
+    uint32_t start = header->stream_offset[column + 1];
+    uint32_t end = header->stream_offset[column + 2];
+    TsColumnKind_t kind = TS_COLUMNS[column].kind;
+    BitReader reader(segment.data + start, end - start);
+    XorDecoder decoder(&reader, kind == TS_KIND_F64 ? 64 : 32);
+
+    values->resize(segment.record_count);
+    for (uint32_t i = 0; i < segment.record_count; i++) {
+        (*values)[i] = bitsToValue(decoder.next(), kind);
+    }
+    return !reader.overrun();
+}
+
+size_t TimeSeriesStore::scan(const char* device_id, int64_t from_ms, int64_t to_ms,
+                             const std::function<void(const ResearchRecord_t&)>& visitor) const {
+    std::map<std::string, Partition>::const_iterator it = _partitions.find(device_id);
+    if (it == _partitions.end()) {
+        return 0;
+    }
+
+    size_t visited = 0;
+    std::vector<int64_t> timestamps;
+    std::vector<double> columns[TS_COLUMN_COUNT];
+    const std::vector<Segment>& segments = it->second.segments;
+
+    for (size_t s = 0; s < segments.size(); s++) {
+        const Segment& segment = segments[s];
+        if (segment.t_max < from_ms) continue;
+        if (segment.t_min >= to_ms) break;
+
+        if (!decodeTimestamps(segment, &timestamps)) continue;
+        bool ok = true;
+        for (int column = 0; column < TS_COLUMN_COUNT; column++) {
+            ok = decodeColumn(segment, column, &columns[column]) && ok;
+        }
+        if (!ok) continue;
+
+        size_t first = std::lower_bound(timestamps.begin(), timestamps.end(), from_ms) - timestamps.begin();
+        for (size_t i = first; i < timestamps.size() && timestamps[i] < to_ms; i++) {
+            ResearchRecord_t record;
+            memset(&record, 0, sizeof(record));
+            record.timestamp_ms = timestamps[i];
+            for (int column = 0; column < TS_COLUMN_COUNT; column++) {
+                setColumn(&record, column, columns[column][i]);
+            }
+            visitor(record);
+            visited++;
+        }
+    }
+    return visited;
+}
+
+/**
+ * Floor division that rounds toward -infinity for bucket alignment
+ */
+static int64_t floorToBucket(int64_t value, int64_t bucket) {
+    int64_t quotient = value / bucket;
+    if (value % bucket != 0 && value < 0) quotient--;
+    return quotient * bucket;
+}
+
+size_t TimeSeriesStore::aggregate(const char* device_id, TsColumn_t column, int64_t from_ms, int64_t to_ms,
+                                  int64_t bucket_ms, std::vector<TsAggregate_t>* out) const {
+    out->clear();
+    std::map<std::string, Partition>::const_iterator it = _partitions.find(device_id);
+    if (it == _partitions.end() || bucket_ms <= 0 || column >= TS_COLUMN_COUNT) {
+        return 0;
+    }
+
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    const std::vector<Segment>& segments = it->second.segments;
+    double sum = 0.0;
+
+    for (size_t s = 0; s < segments.size(); s++) {
+        const Segment& segment = segments[s];
+        if (segment.t_max < from_ms) continue;
+        if (segment.t_min >= to_ms) break;
+        if (!decodeTimestamps(segment, &timestamps) || !decodeColumn(segment, column, &values)) continue;
+
+        size_t first = std::lower_bound(timestamps.begin(), timestamps.end(), from_ms) - timestamps.begin();
+        for (size_t i = first; i < timestamps.size() && timestamps[i] < to_ms; i++) {
+            int64_t bucket = floorToBucket(timestamps[i], bucket_ms);
+            double value = values[i];
+            if (out->empty() || out->back().bucket_start_ms != bucket) {
+                if (!out->empty()) out->back().mean = sum / out->back().count;
+                TsAggregate_t aggregate = {bucket, 0, value, value, 0.0, value};
+                out->push_back(aggregate);
+                sum = 0.0;
+            }
+            TsAggregate_t& current = out->back();
+            current.count++;
+            if (value < current.min) current.min = value;
+            if (value > current.max) current.max = value;
+            current.last = value;
+            sum += value;
+        }
+    }
+    if (!out->empty()) out->back().mean = sum / out->back().count;
+    return out->size();
+}
+
+std::vector<std::string> TimeSeriesStore::devices() const {
+    std::vector<std::string> names;
+    for (std::map<std::string, Partition>::const_iterator it = _partitions.begin(); it != _partitions.end(); ++it) {
+        names.push_back(it->first);
+    }
+    return names;
+}
+
+uint64_t TimeSeriesStore::storedBytes() const {
+    uint64_t total = 0;
+    for (std::map<std::string, Partition>::const_iterator it = _partitions.begin(); it != _partitions.end(); ++it) {
+        for (size_t i = 0; i < it->second.segments.size(); i++) total += it->second.segments[i].length;
+    }
+    return total;
+}
+
+uint64_t TimeSeriesStore::storedRecords() const {
+    uint64_t total = 0;
+    for (std::map<std::string, Partition>::const_iterator it = _partitions.begin(); it != _partitions.end(); ++it) {
+        for (size_t i = 0; i < it->second.segments.size(); i++) total += it->second.segments[i].record_count;
+    }
+    return total;
+}
@@ -0,0 +1,171 @@
+/**
+ * ============================================================================
+ * BINSAI Time-Series Store
+ * Columnar, compressed store for research logs (host side)
+ * ============================================================================
+ *
+ * LAYOUT:
+ *   <root>/<device_id>/<t_min as 16 hex digits>.tsb
+ *
+ * Each device is its own partition. A partition holds immutable segments
+ * of up to TS_SEGMENT_RECORDS records. A segment is a fixed header
+ * followed by one byte-aligned stream per column (GorillaCodec.h):
+ * delta-of-delta timestamps, XOR floats/doubles, XOR integers.
+ * Segments are written to a temp file and renamed, so readers never see
+ * a partial segment.
+ *
+ * Reads mmap() every segment. Range scans skip segments by their header
+ * [t_min, t_max] and decode only the columns they need. aggregate()
+ * decodes just the timestamp column and one value column.
+ *
+ * append() buffers per device until a segment fills or flush() is
+ * called. Queries only see flushed segments.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_TIME_SERIES_STORE_H
+#define BINSAI_TIME_SERIES_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#define TS_SEGMENT_RECORDS          8192    // ~5.7 days at the 60 s research cadence
+#define TS_SEGMENT_MAGIC            0x47455354  // "TSEG"
+#define TS_SEGMENT_VERSION          1
+#define TS_DEVICE_ID_LEN            32
+
+/**
+ * One logResearchData() row
+ */
+typedef struct {
+    int64_t timestamp_ms;           // Unix milliseconds
+    float distance_cm;
+    float fill_percentage;
+    float ppm_calculated;
+    float hours_to_full;
+    double latitude;
+    double longitude;
+    uint16_t adc_raw;
+    uint8_t gps_fix;
+    uint8_t satellite_count;
+    uint8_t capacity_level;
+    uint8_t waste_classification;
+    uint8_t priority_level;
+} ResearchRecord_t;
+
+typedef enum {
+    TS_COLUMN_DISTANCE = 0,
+    TS_COLUMN_FILL,
+    TS_COLUMN_PPM,
+    TS_COLUMN_HOURS_TO_FULL,
+    TS_COLUMN_LATITUDE,
+    TS_COLUMN_LONGITUDE,
+    TS_COLUMN_ADC_RAW,
+    TS_COLUMN_GPS_FIX,
+    TS_COLUMN_SATELLITES,
+    TS_COLUMN_CAPACITY_LEVEL,
+    TS_COLUMN_WASTE_CLASS,
+    TS_COLUMN_PRIORITY,
+    TS_COLUMN_COUNT
+} TsColumn_t;
+
+typedef struct {
+    int64_t bucket_start_ms;
+    uint32_t count;
+    double min;
+    double max;
+    double mean;
+    double last;
+} TsAggregate_t;
+
+/**
+ * Parse one research CSV line as printed by logResearchData()
+ * ("[RESEARCH] " prefix optional). The CSV millis column is added to
+ * base_unix_ms, unless the optional trailing unix_ms column is non-zero
+ * (device clock synced), which is used as is.
+ * @return false on malformed input
+ */
+bool researchRecordFromCsv(const char* line, int64_t base_unix_ms, ResearchRecord_t* record);
+
+/**
+ * Format a record in the logResearchData() CSV layout (no prefix)
+ * @return Characters written (excluding NUL)
+ */
+int researchRecordToCsv(const ResearchRecord_t& record, int64_t base_unix_ms, char* buffer, size_t capacity);
+
+/**
+ * Column lookup by name ("fill", "ppm", ...), -1 if unknown
+ */
+int tsColumnFromName(const char* name);
+
+class TimeSeriesStore {
+public:
+    explicit TimeSeriesStore(const std::string& root);
+    ~TimeSeriesStore();
+    TimeSeriesStore(const TimeSeriesStore&) = delete;
+    TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+
+    /**
+     * Map existing segments under root (creates root if missing)
+     */
+    bool open();
+
+    /**
+     * Buffer one record; writes a segment when the device buffer fills
+     * Records must arrive in timestamp order per device.
+     */
+    bool append(const char* device_id, const ResearchRecord_t& record);
+
+    /**
+     * Write every partial buffer as a segment
+     */
+    bool flush();
+
+    /**
+     * Visit records with from_ms <= timestamp < to_ms in time order
+     * @return Records visited
+     */
+    size_t scan(const char* device_id, int64_t from_ms, int64_t to_ms,
+                const std::function<void(const ResearchRecord_t&)>& visitor) const;
+
+    /**
+     * Downsample one column into fixed buckets aligned to bucket_ms
+     * Empty buckets are omitted.
+     */
+    size_t aggregate(const char* device_id, TsColumn_t column, int64_t from_ms, int64_t to_ms,
+                     int64_t bucket_ms, std::vector<TsAggregate_t>* out) const;
+
+    std::vector<std::string> devices() const;
+    uint64_t storedBytes() const;
+    uint64_t storedRecords() const;
+
+private:
+    struct Segment {
+        std::string path;
+        const uint8_t* data;
+        size_t length;
+        int64_t t_min;
+        int64_t t_max;
+        uint32_t record_count;
+    };
+
+    struct Partition {
+        std::vector<Segment> segments;              // Sorted by t_min
+        std::vector<ResearchRecord_t> pending;
+    };
+
+    bool writeSegment(const std::string& device_id, Partition& partition);
+    bool mapSegment(const std::string& path, Segment* segment);
+    static void unmapSegment(Segment* segment);
+    static bool decodeColumn(const Segment& segment, int column, std::vector<double>* values);
+    static bool decodeTimestamps(const Segment& segment, std::vector<int64_t>* timestamps);
+
+    std::string _root;
+    std::map<std::string, Partition> _partitions;
+};
+
+#endif  // BINSAI_TIME_SERIES_STORE_H
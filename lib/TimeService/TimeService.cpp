@@ -0,0 +1,145 @@
+/**
+ * BINSAI Time Service - source selection, drift estimate and parsers
+ */
+
+#include "TimeService.h"
+#include <stdio.h>
+#include <string.h>
+
+void timeServiceInit(TimeState_t* state) {
+    memset(state, 0, sizeof(*state));
+    state->magic = TIME_STATE_MAGIC;
+}
+
+bool timeServiceRestore(TimeState_t* state, uint64_t mono_us) {
+    if (state->magic != TIME_STATE_MAGIC || state->source > TIME_SOURCE_NTP ||
+        mono_us < state->anchor_mono_us) {
+        timeServiceInit(state);
+        return false;
+    }
+    return state->source != TIME_SOURCE_NONE;
+}
+
+/**
+ * UTC predicted from the anchor with a given rate correction
+ */
+static int64_t predictMs(const TimeState_t* state, uint64_t mono_us, float drift_ppm) {
+    double elapsed_us = (double)(mono_us - state->anchor_mono_us);
+    return state->anchor_unix_ms + (int64_t)(elapsed_us * (1.0 - drift_ppm * 1e-6) / 1000.0);
+}
+
+static bool isPrecise(uint8_t source) {
+    return source == TIME_SOURCE_GPS || source == TIME_SOURCE_NTP;
+}
+
+bool timeServiceSync(TimeState_t* state, uint8_t source, int64_t unix_ms, uint64_t mono_us) {
+    if (source == TIME_SOURCE_NONE || source > TIME_SOURCE_NTP || unix_ms < TIME_MIN_UNIX_S * 1000) {
+        return false;
+    }
+
+    bool valid = timeServiceValid(state) && mono_us >= state->anchor_mono_us;
+    if (valid && source < state->source && timeServiceSyncAgeS(state, mono_us) < TIME_HOLDOVER_S) {
+        return false;
+    }
+
+    state->last_step_ms = valid ? (int32_t)(unix_ms - predictMs(state, mono_us, state->drift_ppm)) : 0;
+
+    if (isPrecise(source)) {
+        if (state->drift_ref_unix_ms == 0 || mono_us < state->drift_ref_mono_us) {
+            state->drift_ref_unix_ms = unix_ms;
+            state->drift_ref_mono_us = mono_us;
+        } else if (mono_us - state->drift_ref_mono_us >= (uint64_t)TIME_DRIFT_MIN_INTERVAL_S * 1000000ULL) {
+            // Free-running error since the reference is the rate sample
+            double elapsed_us = (double)(mono_us - state->drift_ref_mono_us);
+            double error_us = elapsed_us - (double)(unix_ms - state->drift_ref_unix_ms) * 1000.0;
+            float sample = (float)(error_us / elapsed_us * 1e6);
+            if (sample > -TIME_MAX_DRIFT_PPM && sample < TIME_MAX_DRIFT_PPM) {
+                if (state->drift_samples == 0) {
+                    state->drift_ppm = sample;
+                } else {
+                    state->drift_ppm += (sample - state->drift_ppm) / TIME_DRIFT_GAIN;
+                }
+                if (state->drift_samples < UINT8_MAX) state->drift_samples++;
+            }
+            state->drift_ref_unix_ms = unix_ms;
+            state->drift_ref_mono_us = mono_us;
+        }
+    }
+
+    state->magic = TIME_STATE_MAGIC;
+    state->source = source;
+    state->anchor_unix_ms = unix_ms;
+    state->anchor_mono_us = mono_us;
+    if (state->syncs < UINT16_MAX) state->syncs++;
+    return true;
+}
+
+int64_t timeServiceNowMs(const TimeState_t* state, uint64_t mono_us) {
+    if (!timeServiceValid(state) || mono_us < state->anchor_mono_us) {
+        return 0;
+    }
+    return predictMs(state, mono_us, state->drift_ppm);
+}
+
+uint32_t timeServiceSyncAgeS(const TimeState_t* state, uint64_t mono_us) {
+    if (!timeServiceValid(state) || mono_us < state->anchor_mono_us) {
+        return UINT32_MAX;
+    }
+    uint64_t age_s = (mono_us - state->anchor_mono_us) / 1000000ULL;
+    return age_s > UINT32_MAX ? UINT32_MAX : (uint32_t)age_s;
+}
+
+const char* timeSourceName(uint8_t source) {
+    switch (source) {
+        case TIME_SOURCE_GSM: return "gsm";
+        case TIME_SOURCE_GPS: return "gps";
+        case TIME_SOURCE_NTP: return "ntp";
+        default:              return "none";
+    }
+}
+
+int64_t timeFromCivil(int year, int month, int day, int hour, int minute, int second) {
+    // Days from 1970-01-01 in the proleptic Gregorian calendar (March-based years)
+    int64_t y = year - (month <= 2 ? 1 : 0);
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t year_of_era = y - era * 400;
+    int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    int64_t days = era * 146097 + day_of_era - 719468;
+    return days * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+bool timeCivilValid(int year, int month, int day, int hour, int minute, int second) {
+    static const uint8_t DAYS_IN_MONTH[12] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (year < 1970 || year > 2099 || month < 1 || month > 12 || day < 1 || day > DAYS_IN_MONTH[month - 1]) {
+        return false;
+    }
+    if (month == 2 && day == 29 && (year % 4 != 0 || (year % 100 == 0 && year % 400 != 0))) {
+        return false;
+    }
+    return hour >= 0 && hour <= 23 && minute >= 0 && minute <= 59 && second >= 0 && second <= 60;
+}
+
+bool timeParseCclk(const char* reply, int64_t* unix_ms) {
+    const char* field = strstr(reply, "+CCLK: \"");
+    if (field == NULL) {
+        return false;
+    }
+
+    int yy, month, day, hour, minute, second, quarters;
+    char sign;
+    if (sscanf(field + 8, "%2d/%2d/%2d,%2d:%2d:%2d%c%2d", &yy, &month, &day, &hour, &minute, &second,
+               &sign, &quarters) != 8 || (sign != '+' && sign != '-')) {
+        return false;
+    }
+    // %2d also takes a sign ("-1"), so every field is range-checked
+    if (yy < 0 || !timeCivilValid(2000 + yy, month, day, hour, minute, second) ||
+        quarters < 0 || quarters > (sign == '+' ? 56 : 48)) {
+        return false;
+    }
+
+    int64_t local_s = timeFromCivil(2000 + yy, month, day, hour, minute, second);
+    int64_t offset_s = (int64_t)quarters * 15 * 60;
+    *unix_ms = (sign == '+' ? local_s - offset_s : local_s + offset_s) * 1000;
+    return true;
+}
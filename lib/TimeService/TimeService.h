@@ -0,0 +1,116 @@
+/**
+ * ============================================================================
+ * BINSAI Time Service
+ * UTC from SNTP, GPS or the SIM800L clock, held on a drift-corrected RTC
+ * ============================================================================
+ *
+ * MODEL:
+ * - Wall clock = anchor UTC + (monotonic now - anchor monotonic), corrected
+ *   by the estimated rate error of the monotonic clock. The firmware uses
+ *   the RTC slow clock, which keeps counting through deep sleep and
+ *   software resets (not power loss), so the state lives in RTC memory
+ *   and is checked on boot (magic, clock not restarted)
+ * - Each accepted sync re-anchors (steps) the clock. Records keep their
+ *   own monotonic millis, so a step never reorders a unit's records
+ *
+ * SOURCES (best first): NTP (WiFi), GPS (RMC), GSM (AT+CCLK, network
+ * time via NITZ). A weaker source is ignored while a better one has
+ * synced within TIME_HOLDOVER_S; any source beats no time at all.
+ *
+ * DRIFT: NTP and GPS syncs are compared with a reference sync at least
+ * TIME_DRIFT_MIN_INTERVAL_S earlier; the free-running monotonic error over
+ * that interval gives a rate sample (ppm), and the sync becomes the next
+ * reference. Samples are averaged with weight 1 / TIME_DRIFT_GAIN, so
+ * frequent syncs (GPS every few seconds) do not shorten the baseline.
+ * GSM time has 1 s resolution and is never used.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_TIME_SERVICE_H
+#define BINSAI_TIME_SERVICE_H
+
+#include <stdint.h>
+
+#define TIME_STATE_MAGIC            0x454D4954UL  // "TIME" little-endian
+#define TIME_MIN_UNIX_S             1735689600LL  // 2025-01-01; earlier is an unset clock
+#define TIME_HOLDOVER_S             21600         // 6 h before a weaker source may take over
+#define TIME_DRIFT_MIN_INTERVAL_S   1800          // Shortest interval for a rate sample
+#define TIME_DRIFT_GAIN             4
+#define TIME_MAX_DRIFT_PPM          5000.0f       // Larger samples are bad syncs, not drift
+
+typedef enum {
+    TIME_SOURCE_NONE = 0,
+    TIME_SOURCE_GSM,
+    TIME_SOURCE_GPS,
+    TIME_SOURCE_NTP
+} TimeSource_t;
+
+/**
+ * Clock state (POD, kept in RTC memory by the firmware)
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t source;                 // TimeSource_t of the anchor
+    uint8_t drift_samples;          // Rate samples so far (saturates)
+    uint16_t syncs;                 // Accepted syncs (saturates)
+    int64_t anchor_unix_ms;
+    uint64_t anchor_mono_us;
+    int64_t drift_ref_unix_ms;      // Reference sync for the next rate sample, 0 = none
+    uint64_t drift_ref_mono_us;
+    float drift_ppm;                // Monotonic clock rate error, + = runs fast
+    int32_t last_step_ms;           // Correction applied by the last sync
+} TimeState_t;
+
+/**
+ * Start without time
+ */
+void timeServiceInit(TimeState_t* state);
+
+/**
+ * Keep a state retained across deep sleep / reset, or start over if it is
+ * corrupt or the monotonic clock restarted (power loss)
+ * @return true if the retained time was kept
+ */
+bool timeServiceRestore(TimeState_t* state, uint64_t mono_us);
+
+inline bool timeServiceValid(const TimeState_t* state) {
+    return state->magic == TIME_STATE_MAGIC && state->source != TIME_SOURCE_NONE;
+}
+
+/**
+ * Offer a UTC reading taken at mono_us
+ * @return true if it was accepted (the clock was re-anchored)
+ */
+bool timeServiceSync(TimeState_t* state, uint8_t source, int64_t unix_ms, uint64_t mono_us);
+
+/**
+ * Current UTC in milliseconds, 0 without time
+ */
+int64_t timeServiceNowMs(const TimeState_t* state, uint64_t mono_us);
+
+/**
+ * Seconds since the last accepted sync
+ */
+uint32_t timeServiceSyncAgeS(const TimeState_t* state, uint64_t mono_us);
+
+const char* timeSourceName(uint8_t source);
+
+/**
+ * Seconds since 1970-01-01 for a UTC calendar date and time
+ */
+int64_t timeFromCivil(int year, int month, int day, int hour, int minute, int second);
+
+/**
+ * Check a calendar date and time of day (1970-2099, leap days, leap
+ * second) before timeFromCivil(), which silently normalizes anything
+ */
+bool timeCivilValid(int year, int month, int day, int hour, int minute, int second);
+
+/**
+ * Parse a SIM800L clock reply: +CCLK: "yy/MM/dd,hh:mm:ss+zz" where zz is
+ * the local offset in quarter hours (UTC-12 to UTC+14)
+ * @return false if no well-formed +CCLK line was found
+ */
+bool timeParseCclk(const char* reply, int64_t* unix_ms);
+
+#endif  // BINSAI_TIME_SERVICE_H
@@ -0,0 +1,130 @@
+/**
+ * BINSAI Ultrasonic Burst - ping timing and robust surface estimate
+ */
+
+#include "UltrasonicBurst.h"
+#include <math.h>
+
+#define MAD_TO_SIGMA    1.4826f   // MAD of a normal distribution -> standard deviation
+
+uint32_t burstEchoTimeoutUs(float range_cm, float sound_speed_cm_us) {
+    return (uint32_t)(2.0f * range_cm / sound_speed_cm_us) + 1;
+}
+
+uint32_t burstPingPeriodUs(float sound_speed_cm_us) {
+    return burstEchoTimeoutUs(BURST_MAX_RANGE_CM, sound_speed_cm_us) + BURST_RING_DOWN_US;
+}
+
+/**
+ * Insertion sort (at most BURST_MAX_PINGS values)
+ */
+static void sortValues(float* values, uint8_t count) {
+    for (uint8_t i = 1; i < count; i++) {
+        float value = values[i];
+        uint8_t j = i;
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+/**
+ * Median of sorted values
+ */
+static float sortedMedian(const float* values, uint8_t count) {
+    return (count & 1) ? values[count / 2] : 0.5f * (values[count / 2 - 1] + values[count / 2]);
+}
+
+bool burstEstimate(const uint32_t* echo_us, uint8_t count, float sound_speed_cm_us,
+                   float range_cm, BurstEstimate_t* estimate) {
+    if (count > BURST_MAX_PINGS) {
+        count = BURST_MAX_PINGS;
+    }
+
+    estimate->distance_cm = 0.0f;
+    estimate->spread_cm = 0.0f;
+    estimate->confidence = 0;
+    estimate->pings = count;
+    estimate->accepted = 0;
+    estimate->no_echo = 0;
+    estimate->blind = 0;
+    estimate->outliers = 0;
+    estimate->in_blind_zone = false;
+    if (count == 0) {
+        return false;
+    }
+
+    // Convert and drop missing / blind-zone echoes
+    float distance[BURST_MAX_PINGS];
+    uint8_t valid = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        float cm = echo_us[i] * sound_speed_cm_us / 2.0f;
+        if (echo_us[i] == 0 || cm > range_cm) {
+            estimate->no_echo++;
+        } else if (cm < BURST_BLIND_ZONE_CM) {
+            estimate->blind++;
+        } else {
+            distance[valid++] = cm;
+        }
+    }
+
+    if (2 * estimate->blind > count) {
+        estimate->in_blind_zone = true;
+        estimate->confidence = (uint8_t)(100 * estimate->blind / count);
+        return true;
+    }
+    if (2 * valid <= count) {
+        return false;
+    }
+
+    // Outliers: far from the median in robust (MAD) units
+    sortValues(distance, valid);
+    float median = sortedMedian(distance, valid);
+    float deviation[BURST_MAX_PINGS];
+    for (uint8_t i = 0; i < valid; i++) {
+        deviation[i] = fabsf(distance[i] - median);
+    }
+    sortValues(deviation, valid);
+    float limit = BURST_OUTLIER_MADS * MAD_TO_SIGMA * sortedMedian(deviation, valid);
+    if (limit < BURST_OUTLIER_MIN_CM) {
+        limit = BURST_OUTLIER_MIN_CM;
+    }
+
+    // distance[] stays sorted while compacting
+    uint8_t accepted = 0;
+    for (uint8_t i = 0; i < valid; i++) {
+        if (fabsf(distance[i] - median) <= limit) {
+            distance[accepted++] = distance[i];
+        }
+    }
+    estimate->outliers = valid - accepted;
+    estimate->accepted = accepted;
+    if (2 * accepted <= count) {
+        return false;
+    }
+
+    uint8_t trim = (uint8_t)(accepted * BURST_TRIM_FRACTION);
+    float sum = 0.0f;
+    for (uint8_t i = trim; i < accepted - trim; i++) {
+        sum += distance[i];
+    }
+    estimate->distance_cm = sum / (accepted - 2 * trim);
+
+    float mean = 0.0f;
+    for (uint8_t i = 0; i < accepted; i++) {
+        mean += distance[i];
+    }
+    mean /= accepted;
+    float variance = 0.0f;
+    for (uint8_t i = 0; i < accepted; i++) {
+        variance += (distance[i] - mean) * (distance[i] - mean);
+    }
+    estimate->spread_cm = sqrtf(variance / accepted);
+
+    float flatness = 1.0f - estimate->spread_cm / BURST_SPREAD_FULL_CM;
+    if (flatness < 0.0f) flatness = 0.0f;
+    estimate->confidence = (uint8_t)(100.0f * accepted / count * flatness + 0.5f);
+    return true;
+}
@@ -0,0 +1,83 @@
+/**
+ * ============================================================================
+ * BINSAI Ultrasonic Burst
+ * Robust waste surface estimate from a burst of HC-SR04 pings
+ * ============================================================================
+ *
+ * TIMING:
+ * - Pings are spaced by the round trip to BURST_MAX_RANGE_CM plus the
+ *   transducer ring-down, so an echo from the previous ping has died out
+ *   before the next trigger (~26 ms at 25 C instead of the datasheet's
+ *   conservative 60 ms)
+ * - Each echo wait is bounded by the caller's range (the bin depth), so a
+ *   missing echo costs the bin round trip rather than pulseIn's 30 ms
+ *
+ * ESTIMATE (per burst, N <= BURST_MAX_PINGS):
+ * - No echo / beyond range: dropped
+ * - Inside the BURST_BLIND_ZONE_CM blind zone: counted; when most pings
+ *   land there the surface is at the sensor (ISSUES.md #003) and the
+ *   estimate is 0 cm
+ * - Cross-talk and multipath echoes: dropped when further than
+ *   max(BURST_OUTLIER_MIN_CM, BURST_OUTLIER_MADS x MAD) from the median
+ * - Surface: mean of the remaining pings with BURST_TRIM_FRACTION cut
+ *   from each end; spread: their standard deviation (surface roughness
+ *   plus timing noise)
+ * - Confidence (0-100) = accepted fraction x flatness, where flatness
+ *   falls linearly from 1 to 0 as the spread reaches BURST_SPREAD_FULL_CM
+ *
+ * Distances here are acoustic (sensor face to surface); the firmware adds
+ * the mounting offset afterwards.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_ULTRASONIC_BURST_H
+#define BINSAI_ULTRASONIC_BURST_H
+
+#include <stdint.h>
+
+#define BURST_MAX_PINGS             16
+#define BURST_BLIND_ZONE_CM         2.0f      // HC-SR04 minimum range
+#define BURST_MAX_RANGE_CM          400.0f    // HC-SR04 maximum range
+#define BURST_RING_DOWN_US          2000      // Transducer settling after an echo
+#define BURST_OUTLIER_MIN_CM        1.5f      // Never reject closer than this to the median
+#define BURST_OUTLIER_MADS          3.0f      // Rejection threshold in scaled MADs
+#define BURST_TRIM_FRACTION         0.2f      // Cut from each end before averaging
+#define BURST_SPREAD_FULL_CM        10.0f     // Spread at which confidence reaches 0
+
+/**
+ * Result of one burst
+ */
+typedef struct {
+    float distance_cm;              // Trimmed mean; 0 when in the blind zone
+    float spread_cm;                // Standard deviation of accepted pings
+    uint8_t confidence;             // 0-100
+    uint8_t pings;
+    uint8_t accepted;
+    uint8_t no_echo;                // Timeouts and echoes beyond range
+    uint8_t blind;                  // Echoes inside the blind zone
+    uint8_t outliers;               // Cross-talk / multipath rejections
+    bool in_blind_zone;
+} BurstEstimate_t;
+
+/**
+ * Echo wait for a surface up to range_cm away
+ * @param sound_speed_cm_us Speed of sound [cm/us]
+ */
+uint32_t burstEchoTimeoutUs(float range_cm, float sound_speed_cm_us);
+
+/**
+ * Minimum trigger-to-trigger spacing between pings
+ */
+uint32_t burstPingPeriodUs(float sound_speed_cm_us);
+
+/**
+ * Reduce a burst of echo widths to a surface estimate
+ * @param echo_us Echo pulse widths, 0 for a timeout
+ * @param range_cm Farthest plausible surface (echoes beyond are dropped)
+ * @return false when neither the surface nor the blind zone has a majority
+ *         of the pings (estimate->distance_cm is then unset)
+ */
+bool burstEstimate(const uint32_t* echo_us, uint8_t count, float sound_speed_cm_us,
+                   float range_cm, BurstEstimate_t* estimate);
+
+#endif  // BINSAI_ULTRASONIC_BURST_H
@@ -0,0 +1,96 @@
+/**
+ * BINSAI Waste Classifier - table validation and hysteresis state machine
+ */
+
+#include "WasteClassifier.h"
+#include <math.h>
+
+bool classifierTableValid(const ClassifierTable_t& table) {
+    if (!(table.hysteresis >= 0.0f) || isinf(table.hysteresis)) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < CLASSIFICATION_BREAKPOINTS; i++) {
+        if (isnan(table.breakpoints[i]) || isinf(table.breakpoints[i])) {
+            return false;
+        }
+        if (i > 0 && !(table.breakpoints[i] > table.breakpoints[i - 1])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void classifierDefaultCapacityTable(ClassifierTable_t* table) {
+    table->breakpoints[0] = THRESHOLD_EMPTY_PERCENT;
+    table->breakpoints[1] = THRESHOLD_HALF_PERCENT;
+    table->breakpoints[2] = THRESHOLD_ALMOST_FULL;
+    table->hysteresis = CAPACITY_HYSTERESIS_PERCENT;
+    table->min_dwell_ms = CLASSIFICATION_DWELL_MS;
+}
+
+void classifierDefaultGasTable(ClassifierTable_t* table) {
+    table->breakpoints[0] = PPM_CLEAN_AIR_MAX;
+    table->breakpoints[1] = PPM_INORGANIC_MAX;
+    table->breakpoints[2] = PPM_ORGANIC_L1_MAX;
+    table->hysteresis = GAS_HYSTERESIS_PPM;
+    table->min_dwell_ms = CLASSIFICATION_DWELL_MS;
+}
+
+HysteresisClassifier::HysteresisClassifier()
+    : _level(0), _candidate(0), _initialized(false), _candidate_since_ms(0), _transitions(0) {
+    classifierDefaultCapacityTable(&_table);
+}
+
+bool HysteresisClassifier::configure(const ClassifierTable_t& table) {
+    if (!classifierTableValid(table)) {
+        return false;
+    }
+    _table = table;
+    return true;
+}
+
+void HysteresisClassifier::reset() {
+    _initialized = false;
+    _level = 0;
+    _candidate = 0;
+}
+
+uint8_t HysteresisClassifier::update(float value, uint32_t now_ms) {
+    if (isnan(value)) {
+        return _level;  // Keep last level on invalid input
+    }
+
+    if (!_initialized) {
+        _level = classifyLevel(_table.breakpoints, value);
+        _candidate = _level;
+        _initialized = true;
+        return _level;
+    }
+
+    // Shifted lookups implement the hysteresis band on every breakpoint
+    uint8_t up_level = classifyLevel(_table.breakpoints, value - _table.hysteresis);
+    uint8_t down_level = classifyLevel(_table.breakpoints, value + _table.hysteresis);
+    uint8_t target = (up_level > _level) ? up_level
+                   : (down_level < _level) ? down_level
+                   : _level;
+
+    if (target == _level) {
+        _candidate = _level;
+        return _level;
+    }
+
+    if (target != _candidate) {
+        // New candidate: start the dwell timer
+        _candidate = target;
+        _candidate_since_ms = now_ms;
+    }
+
+    if (now_ms - _candidate_since_ms >= _table.min_dwell_ms) {
+        _level = _candidate;
+        _transitions++;
+    }
+
+    return _level;
+}
@@ -0,0 +1,100 @@
+/**
+ * ============================================================================
+ * BINSAI Waste Classifier
+ * Table-driven level classification with hysteresis and dwell time
+ * ============================================================================
+ *
+ * LEVEL LOOKUP:
+ * level = number of breakpoints strictly exceeded by the value. With
+ * capacity breakpoints {35, 50, 90}: 35.0 -> 0 (EMPTY), 35.1 -> 1 (HALF),
+ * 90.0 -> 2 (ALMOST FULL), 90.1 -> 3 (FULL). The sum of comparisons compiles
+ * to branch-free code over the sorted table.
+ *
+ * HYSTERESIS:
+ * - Moving up requires value > breakpoint + band
+ * - Moving down requires value <= breakpoint - band
+ * - The candidate level must then hold for min_dwell_ms before it is
+ *   reported, so noise at a boundary cannot flip the level every sample
+ *
+ * Shared by the firmware and the integration sketches in test/integration.
+ * ============================================================================
+ */
+
+#ifndef BINSAI_WASTE_CLASSIFIER_H
+#define BINSAI_WASTE_CLASSIFIER_H
+
+#include <stdint.h>
+#include "definitions.h"
+
+/**
+ * Classifier parameters (one table per measured quantity)
+ */
+typedef struct {
+    float breakpoints[CLASSIFICATION_BREAKPOINTS];  // Strictly ascending
+    float hysteresis;               // Band around each breakpoint (>= 0)
+    uint32_t min_dwell_ms;          // Candidate level hold time
+} ClassifierTable_t;
+
+/**
+ * Branch-free level lookup
+ * @return Number of breakpoints exceeded (0..CLASSIFICATION_BREAKPOINTS)
+ */
+static inline uint8_t classifyLevel(const float breakpoints[CLASSIFICATION_BREAKPOINTS], float value) {
+    uint8_t level = 0;
+    for (uint8_t i = 0; i < CLASSIFICATION_BREAKPOINTS; i++) {
+        level += (uint8_t)(value > breakpoints[i]);
+    }
+    return level;
+}
+
+/**
+ * Check that a breakpoint table is finite and strictly ascending
+ */
+bool classifierTableValid(const ClassifierTable_t& table);
+
+/**
+ * Default tables from include/definitions.h
+ */
+void classifierDefaultCapacityTable(ClassifierTable_t* table);
+void classifierDefaultGasTable(ClassifierTable_t* table);
+
+/**
+ * Stateful classifier with hysteresis and minimum dwell time
+ */
+class HysteresisClassifier {
+public:
+    HysteresisClassifier();
+
+    /**
+     * Replace the classification table (invalid tables are rejected)
+     * @return true if the table was accepted
+     */
+    bool configure(const ClassifierTable_t& table);
+
+    /**
+     * Classify a new sample
+     * @param value Measured value
+     * @param now_ms Current time in milliseconds
+     * @return Reported (debounced) level
+     */
+    uint8_t update(float value, uint32_t now_ms);
+
+    /**
+     * Forget history; the next sample is reported immediately
+     */
+    void reset();
+
+    uint8_t level() const { return _level; }
+    uint32_t transitionCount() const { return _transitions; }
+    const ClassifierTable_t& table() const { return _table; }
+
+private:
+    ClassifierTable_t _table;
+    uint8_t _level;
+    uint8_t _candidate;
+    bool _initialized;
+    uint32_t _candidate_since_ms;
+    uint32_t _transitions;
+};
+
+#endif  // BINSAI_WASTE_CLASSIFIER_H
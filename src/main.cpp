@@ -62,6 +62,8 @@
 #define V11_PRIORITY_LEVEL          11     // Integer: Urgency scale (0-3)
 #define V12_WASTE_TYPE              12     // String: Organic/Inorganic classification
 #define V13_RECOMMENDATION          13     // String: Operational instructions
+#define V14_TIME_TO_FULL            14     // Double: Forecast hours until full (-1 unknown)
+#define V15_RUNTIME_METRICS         15     // String: Loop / Blynk latency and heap summary
 #define V20_LATITUDE                20     // Double: GPS latitude
 #define V21_LONGITUDE               21     // Double: GPS longitude
 
@@ -70,8 +72,14 @@
 // ============================================================================
 
 // Sensor Interfaces
-#define PIN_ULTRASONIC_TRIG         GPIO_NUM_5     // HC-SR04 Trigger
-#define PIN_ULTRASONIC_ECHO         GPIO_NUM_18    // HC-SR04 Echo
+#define PIN_ULTRASONIC_TRIG         GPIO_NUM_5     // HC-SR04 Trigger (probe 1)
+#define PIN_ULTRASONIC_ECHO         GPIO_NUM_18    // HC-SR04 Echo (probe 1)
+#define PIN_ULTRASONIC_TRIG_2       GPIO_NUM_26    // Optional probes 2-4 (ultrasonic_probe_count)
+#define PIN_ULTRASONIC_ECHO_2       GPIO_NUM_19
+#define PIN_ULTRASONIC_TRIG_3       GPIO_NUM_14
+#define PIN_ULTRASONIC_ECHO_3       GPIO_NUM_23
+#define PIN_ULTRASONIC_TRIG_4       GPIO_NUM_32
+#define PIN_ULTRASONIC_ECHO_4       GPIO_NUM_33
 #define PIN_GAS_SENSOR              GPIO_NUM_34    // MQ-135 Analog Output
 #define PIN_BUZZER                  GPIO_NUM_25    // Piezo buzzer
 
@@ -94,24 +102,23 @@
 // Bin Specifications
 #define BIN_HEIGHT_CM               40.0f         // Maximum bin height
 #define SENSOR_MOUNT_HEIGHT_CM      3.0f          // Ultrasonic sensor mounting offset
+#define ULTRASONIC_BURST_PINGS      7             // Rounds per reading, ~150 ms per probe (see lib/UltrasonicBurst)
+#define ULTRASONIC_ECHO_LEAD_US     1000          // Trigger to echo-line rise (40 kHz burst) with margin
 
-// Capacity Thresholds (Based on Section 3.4.1)
-#define THRESHOLD_EMPTY_PERCENT     35.0f         // 0-35%: Empty
-#define THRESHOLD_HALF_PERCENT      50.0f         // 36-50%: Half
-#define THRESHOLD_ALMOST_FULL       90.0f         // 51-90%: Almost Full
-#define THRESHOLD_CRITICAL          90.1f         // >90%: Critical (Full)
-
-// Gas Concentration Thresholds (Based on Appendix 5)
-#define PPM_CLEAN_AIR_MAX           199.0f        // 0-199 ppm: Clean/Normal
-#define PPM_INORGANIC_MAX           449.0f        // 200-449 ppm: Inorganic/Light odor
-#define PPM_ORGANIC_L1_MAX          800.0f        // 450-800 ppm: Organic (starting decay)
-#define PPM_ORGANIC_L2_MIN          801.0f        // >800 ppm: Critical decomposition
+// Capacity and gas classification thresholds are configuration defaults
+// shared with lib/WasteClassifier, see include/definitions.h
 
 // Gas Sensor Calibration (From Section 4.3.1: PPM = 0.002348 * ADC^2.856)
 #define MQ135_COEFFICIENT_A         0.002348f
 #define MQ135_COEFFICIENT_B         2.856f
 #define MQ135_LOAD_RESISTOR         1.0f          // RL = 1kΩ
 #define MQ135_CLEAN_AIR_RATIO       3.6f          // RS/R0 ratio in clean air
+#define MQ135_R0_REFERENCE          10.0f         // R0 (kOhm) of the sensor the regression was fit on
+#define MQ135_SUPPLY_MV             3300          // Divider supply / linear ADC full scale
+
+// ADC Characterisation (see lib/AdcCalibration)
+#define ADC_DEFAULT_VREF_MV         1100          // Used when the eFuse holds no Vref
+#define ADC_BENCH_SAMPLES           64            // Raw reads averaged per ADCCAL ADD step
 
 // Timing Intervals (Based on Research Methodology)
 #define INTERVAL_SENSOR_READ_MS     2000          // 2s interval for Blynk updates
@@ -119,12 +126,35 @@
 #define INTERVAL_GPS_CHECK_MS       10000         // 10s GPS validation
 #define INTERVAL_DISPLAY_ROTATE_MS  4000          // 4s LCD display rotation
 #define INTERVAL_SMS_COOLDOWN_MS    300000        // 5 minutes between SMS batches
+#define INTERVAL_FLEET_UPLINK_MS    30000         // 30s telemetry frames to fleet server
+#define INTERVAL_GSM_TIME_MS        3600000       // Hourly SIM800L clock poll (fallback time source)
+#define INTERVAL_GSM_TIME_RETRY_MS  60000         // Poll interval until the first sync
 
 // System Constants
-#define CALIBRATION_DURATION_MS     60000         // 60s MQ-135 calibration
+#define GAS_BASELINE_WARMUP_MS      600000        // 10 min MQ-135 heater warm-up before baseline samples
+#define GAS_BASELINE_PERSIST_MS     3600000       // Hourly baseline window checkpoint to NVS
 #define SMS_SEND_TIMEOUT_MS         30000         // 30s SMS transmission timeout
 #define GPS_FIX_TIMEOUT_MS          60000         // 60s maximum GPS acquisition
 #define WIFI_CONNECT_TIMEOUT_MS     20000         // 20s WiFi connection timeout
+#define TIME_STEP_LOG_MS            1000          // Log clock steps at least this large
+#define GSM_REPLY_WINDOW            64            // Newest AT reply bytes kept for matching
+#define HEALTH_WATCHDOG_TIMEOUT_S   30            // Task watchdog: longest stall before a reset
+
+// Hardware-in-the-loop Benchmark (BENCH console command, lib/PerfBench)
+#define BENCH_DEFAULT_ITERATIONS    20            // Timed calls per case
+#define BENCH_MAX_ITERATIONS        100
+#define BENCH_GSM_TIMEOUT_MS        1000          // AT round trip counted as failed after this
+
+// Research Log (LittleFS on the "spiffs" partition, see lib/ResearchLogger)
+#define RESEARCH_LOG_DIR            "/research"
+#define RESEARCH_LOG_FILE_BYTES     65536         // Rotate files at 64 KB (128 blocks)
+#define RESEARCH_LOG_BUDGET_BYTES   1048576       // 1 MB of the 1.375 MB partition (~2 years of records)
+#define RESEARCH_LOG_SYNC_BLOCKS    1             // fsync every block
+#define RESEARCH_LOG_FLUSH_MS       600000        // Records wait at most 10 min in RAM
+
+// Firmware Identification
+#define FIRMWARE_VERSION            "2.0.0"
+#define FIRMWARE_SECURITY_VERSION   1             // Anti-rollback: OTA only accepts higher
 
 // ============================================================================
 // SECTION 5: NETWORK & COMMUNICATION CONFIGURATION
@@ -134,6 +164,33 @@
 const char* WIFI_SSID = "YOUR_WIFI_SSID";
 const char* WIFI_PASSWORD = "YOUR_WIFI_PASSWORD";
 
+// Fleet Ingest Server (binsai-fleet serve); empty host disables the uplink
+#define FLEET_INGEST_HOST           ""
+#define FLEET_INGEST_PORT           47100
+
+// GPRS fallback for the fleet uplink while WiFi is down: SIM800L data
+// bearer, frames batched per datagram; empty APN disables it
+#define GPRS_APN                    "internet"
+#define GPRS_USERNAME               ""
+#define GPRS_PASSWORD               ""
+#define GPRS_DAILY_BUDGET_BYTES     2097152       // Wire bytes/day, then only alert frames
+#define GPRS_COST_PER_KB            10            // Tariff relative to WiFi (0)
+#define BEARER_MAX_LATENCY_MS       60000         // Expected delivery bound for bearer choice
+#define MODEM_ACQUIRE_TIMEOUT_MS    50000         // SMS wait covering a PDP activation in flight
+
+// MQTT Telemetry Broker (one QoS 1 TelemetryFrame per sample); empty host disables it
+#define MQTT_BROKER_HOST            ""
+#define MQTT_BROKER_PORT            1883
+#define MQTT_USERNAME               ""
+#define MQTT_PASSWORD               ""
+#define MQTT_CONNECT_TIMEOUT_MS     3000
+
+// Firmware Updates (OTA <url>): signed with `binsai-fleet ota-keygen` seed;
+// OTA stays disabled while this is the all-zero placeholder key
+#define OTA_STALL_TIMEOUT_MS        15000         // Abort if the download stalls
+#define OTA_CHUNK_SIZE              1024          // Payload bytes per read
+const uint8_t OTA_SIGNING_PUBLIC_KEY[32] = { 0 };
+
 // Emergency Contact Numbers (International Format Required)
 const char* EMERGENCY_NUMBERS[] = {
     "+62_YOUR_NUMBER_PHONE1",     // Primary contact
@@ -162,77 +219,58 @@ const char* SMS_TEMPLATE_TEST =
 #include <Arduino.h>
 #include <WiFi.h>
 #include <WiFiClientSecure.h>
+#include <WiFiUdp.h>
 #include <BlynkSimpleEsp32.h>
 #include <Wire.h>
 #include <LiquidCrystal_I2C.h>
 #include <TinyGPSPlus.h>
 #include <Preferences.h>
 #include <ArduinoJson.h>
+#include <HTTPClient.h>
+#include <LittleFS.h>
+#include <esp_timer.h>
+#include <esp_sntp.h>
+#include <esp32/clk.h>
+#include <esp_adc_cal.h>
+#include <esp_ota_ops.h>
+#include <esp_task_wdt.h>
+#include <esp_debug_helpers.h>
+#include <esp_private/panic_internal.h>
+#include <freertos/xtensa_context.h>
+
+#include "definitions.h"
+
+// BINSAI local modules (lib/)
+#include <BuzzerSequencer.h>
+#include <ConfigStore.h>
+#include <ConfigFields.h>
+#include <SerialConsole.h>
+#include <WasteClassifier.h>
+#include <FillForecaster.h>
+#include <GasBaseline.h>
+#include <AdcCalibration.h>
+#include <EnvCompensation.h>
+#include <UltrasonicBurst.h>
+#include <ProbeArray.h>
+#include <TimeService.h>
+#include <ResearchLogger.h>
+#include <TelemetryFrame.h>
+#include <TelemetryTransport.h>
+#include <ModemArbiter.h>
+#include <GprsUplink.h>
+#include <FirmwareUpdate.h>
+#include <HealthMonitor.h>
+#include <RuntimeMetrics.h>
+#include <PerfBench.h>
+#include <HeapCounter.h>
+#include <TextBuffer.h>
 
 // ============================================================================
 // SECTION 7: DATA STRUCTURES & TYPE DEFINITIONS
 // ============================================================================
 
-/**
- * Sensor Data Structure
- * Contains all telemetry data from sensor array
- */
-typedef struct {
-    // Ultrasonic Sensor Data
-    float distance_cm;              // Measured distance in centimeters
-    float fill_percentage;          // Calculated fill percentage (0-100%)
-    
-    // Gas Sensor Data
-    uint16_t adc_raw;              // Raw ADC value from MQ-135
-    float ppm_calculated;           // Calculated PPM value
-    float r0_calibrated;            // Calibrated R0 value
-    
-    // GPS Data
-    double latitude;                // Latitude in decimal degrees
-    double longitude;               // Longitude in decimal degrees
-    uint8_t satellite_count;        // Number of visible satellites
-    float hdop;                     // Horizontal dilution of precision
-    
-    // Derived Classification
-    uint8_t capacity_level;         // 0=Empty, 1=Half, 2=Almost Full, 3=Full
-    uint8_t waste_classification;   // 0=Clean, 1=Inorganic, 2=Organic L1, 3=Organic L2
-    uint8_t priority_level;         // 0-3 scale (0=Normal, 3=Critical)
-    
-    // Timestamps
-    uint32_t timestamp_unix;        // Unix timestamp
-    uint32_t timestamp_millis;      // Millisecond timestamp
-} SensorData_t;
-
-/**
- * System Configuration Structure
- * Contains all configurable system parameters
- */
-typedef struct {
-    // Device Identification
-    char device_id[32];             // Unique device identifier
-    char firmware_version[16];      // Firmware version string
-    
-    // Network Configuration
-    char wifi_ssid[32];             // WiFi SSID
-    char wifi_password[32];         // WiFi password
-    char blynk_auth_token[34];      // Blynk authentication token
-    
-    // Calibration Parameters
-    float ultrasonic_offset_cm;     // Ultrasonic sensor mounting offset
-    float mq135_r0_calibrated;      // Calibrated R0 value for MQ-135
-    float mq135_temp_compensation;  // Temperature compensation factor
-    float mq135_humidity_compensation; // Humidity compensation factor
-    
-    // Operational Thresholds
-    float critical_capacity_threshold;  // Capacity threshold for critical alerts
-    float critical_gas_threshold;       // Gas threshold for critical alerts
-    uint32_t sms_cooldown_period;       // Minimum time between SMS batches
-    
-    // Modular Configuration
-    bool is_modular_unit;           // True if device is modular deployment
-    uint8_t deployment_zone;        // Deployment zone identifier
-    char location_description[64];  // Human-readable location description
-} SystemConfig_t;
+// SensorData_t and SystemConfig_t are shared with lib/ modules and host
+// tools, see include/definitions.h
 
 /**
  * Notification State Structure
@@ -254,6 +292,18 @@ typedef struct {
     char sms_recipient_buffer[20];  // Buffer for recipient number
 } NotificationState_t;
 
+/**
+ * Echo Capture Structure
+ * One per ultrasonic probe, written by the echo-pin edge interrupt
+ */
+typedef struct {
+    gpio_num_t pin;                 // Echo pin
+    volatile bool armed;            // Waiting for this round's echo
+    volatile bool high;             // Rising edge seen
+    volatile uint32_t rise_us;      // Rising edge timestamp
+    volatile uint32_t width_us;     // Echo width, 0 until the falling edge
+} EchoCapture_t;
+
 // ============================================================================
 // SECTION 8: GLOBAL OBJECT INSTANCES
 // ============================================================================
@@ -264,12 +314,434 @@ TinyGPSPlus gps_parser;
 HardwareSerial gps_serial(1);      // UART1 for GPS
 HardwareSerial gsm_serial(2);      // UART2 for GSM
 Preferences nvs_storage;           // Non-volatile storage
+BuzzerSequencer buzzer_sequencer;  // Background beep pattern engine
+esp_timer_handle_t buzzer_timer = NULL;
+portMUX_TYPE buzzer_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * NVS-backed A/B slots for the configuration blob
+ * Caller must hold nvs_storage open (namespace "binsai_cfg")
+ */
+class NvsConfigBackend : public ConfigStorageBackend {
+public:
+    size_t readSlot(uint8_t slot, void* buffer, size_t capacity) override {
+        const char* key = (slot == 0) ? "cfg_a" : "cfg_b";
+        if (!nvs_storage.isKey(key)) {
+            return 0;
+        }
+        return nvs_storage.getBytes(key, buffer, capacity);
+    }
+    
+    bool writeSlot(uint8_t slot, const void* data, size_t length) override {
+        const char* key = (slot == 0) ? "cfg_a" : "cfg_b";
+        return nvs_storage.putBytes(key, data, length) == length;
+    }
+};
+
+NvsConfigBackend nvs_config_backend;
+ConfigStore config_store(nvs_config_backend);
+
+/**
+ * A/B app partitions (ota_0 / ota_1 in the default table) through esp_ota_*,
+ * boot record in NVS namespace "binsai_ota"
+ */
+class EspFirmwareBackend : public FirmwareUpdateBackend {
+public:
+    bool readSource(uint32_t offset, void* buffer, size_t length) override {
+        const esp_partition_t* running = esp_ota_get_running_partition();
+        return running && esp_partition_read(running, offset, buffer, length) == ESP_OK;
+    }
+    
+    bool writeTarget(const void* data, size_t length) override {
+        return _handle && esp_ota_write(_handle, data, length) == ESP_OK;
+    }
+    
+    bool beginUpdate(uint32_t image_size) override {
+        const esp_partition_t* target = esp_ota_get_next_update_partition(NULL);
+        _handle = 0;
+        return target && image_size <= target->size && esp_ota_begin(target, image_size, &_handle) == ESP_OK;
+    }
+    
+    bool finishUpdate() override {
+        // esp_ota_end() also checks the app image header and checksum
+        esp_err_t result = esp_ota_end(_handle);
+        _handle = 0;
+        return result == ESP_OK;
+    }
+    
+    void abortUpdate() override {
+        if (_handle) {
+            esp_ota_abort(_handle);
+            _handle = 0;
+        }
+    }
+    
+    bool switchSlot() override {
+        const esp_partition_t* other = esp_ota_get_next_update_partition(NULL);
+        return other && esp_ota_set_boot_partition(other) == ESP_OK;
+    }
+    
+    void confirmSlot() override {
+        esp_ota_mark_app_valid_cancel_rollback();
+    }
+    
+    bool loadBootRecord(FirmwareBootRecord_t* record) override {
+        Preferences prefs;
+        if (!prefs.begin("binsai_ota", true)) {
+            return false;
+        }
+        size_t length = prefs.isKey("boot") ? prefs.getBytes("boot", record, sizeof(*record)) : 0;
+        prefs.end();
+        return length == sizeof(*record);
+    }
+    
+    bool saveBootRecord(const FirmwareBootRecord_t& record) override {
+        Preferences prefs;
+        if (!prefs.begin("binsai_ota", false)) {
+            return false;
+        }
+        bool saved = prefs.putBytes("boot", &record, sizeof(record)) == sizeof(record);
+        prefs.end();
+        return saved;
+    }
+    
+private:
+    esp_ota_handle_t _handle = 0;
+};
+
+EspFirmwareBackend firmware_backend;
+FirmwareUpdater firmware_updater(firmware_backend, OTA_SIGNING_PUBLIC_KEY, FIRMWARE_SECURITY_VERSION);
+FirmwareBootGuard firmware_boot_guard(firmware_backend);
+
+/**
+ * Reliability counters in NVS namespace "binsai_health"
+ */
+class NvsHealthStore : public HealthStore {
+public:
+    bool loadStats(HealthStats_t* stats) override {
+        Preferences prefs;
+        if (!prefs.begin("binsai_health", true)) {
+            return false;
+        }
+        size_t length = prefs.isKey("stats") ? prefs.getBytes("stats", stats, sizeof(*stats)) : 0;
+        prefs.end();
+        return length == sizeof(*stats);
+    }
+    
+    bool saveStats(const HealthStats_t& stats) override {
+        Preferences prefs;
+        if (!prefs.begin("binsai_health", false)) {
+            return false;
+        }
+        bool saved = prefs.putBytes("stats", &stats, sizeof(stats)) == sizeof(stats);
+        prefs.end();
+        return saved;
+    }
+};
+
+// Crash context survives panic, watchdog and brownout resets (not power loss)
+RTC_NOINIT_ATTR HealthRtcRecord_t health_rtc;
+NvsHealthStore health_store;
+HealthMonitor health_monitor(health_store, health_rtc);
+
+/**
+ * Research log files on LittleFS: RESEARCH_LOG_DIR/<8-digit index>.blg
+ */
+class LittleFsLogBackend : public ResearchLogBackend {
+public:
+    bool fileRange(uint32_t* first, uint32_t* last) override {
+        File dir = LittleFS.open(RESEARCH_LOG_DIR);
+        if (!dir || !dir.isDirectory()) {
+            return false;
+        }
+        bool found = false;
+        for (File entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+            const char* name = strrchr(entry.name(), '/');
+            name = name ? name + 1 : entry.name();
+            char* end;
+            uint32_t index = strtoul(name, &end, 10);
+            if (end == name || strcmp(end, ".blg") != 0) {
+                continue;
+            }
+            if (!found || index < *first) *first = index;
+            if (!found || index > *last) *last = index;
+            found = true;
+        }
+        return found;
+    }
+    
+    uint32_t fileSize(uint32_t index) override {
+        File file = LittleFS.open(path(index), "r");
+        return file ? (uint32_t)file.size() : 0;
+    }
+    
+    bool readFile(uint32_t index, uint32_t offset, void* buffer, size_t length) override {
+        File file = LittleFS.open(path(index), "r");
+        return file && file.seek(offset) && file.read((uint8_t*)buffer, length) == length;
+    }
+    
+    bool openAppend(uint32_t index) override {
+        close();
+        _file = LittleFS.open(path(index), "a");
+        return (bool)_file;
+    }
+    
+    bool append(const void* data, size_t length) override {
+        return _file && _file.write((const uint8_t*)data, length) == length;
+    }
+    
+    bool sync() override {
+        if (!_file) {
+            return false;
+        }
+        _file.flush();      // fflush + fsync in the VFS layer
+        return true;
+    }
+    
+    void close() override {
+        if (_file) {
+            _file.close();
+        }
+    }
+    
+    bool removeFile(uint32_t index) override {
+        return LittleFS.remove(path(index));
+    }
+    
+private:
+    const char* path(uint32_t index) {
+        snprintf(_path, sizeof(_path), RESEARCH_LOG_DIR "/%08lu.blg", (unsigned long)index);
+        return _path;
+    }
+    
+    File _file;
+    char _path[32];
+};
+
+LittleFsLogBackend research_log_backend;
+ResearchLogger research_logger(research_log_backend);
+
+HealthResetReason_t healthResetReason(esp_reset_reason_t reason) {
+    switch (reason) {
+        case ESP_RST_POWERON:   return HEALTH_RESET_POWER_ON;
+        case ESP_RST_EXT:       return HEALTH_RESET_EXTERNAL;
+        case ESP_RST_SW:        return HEALTH_RESET_SOFTWARE;
+        case ESP_RST_PANIC:     return HEALTH_RESET_PANIC;
+        case ESP_RST_INT_WDT:   return HEALTH_RESET_INT_WDT;
+        case ESP_RST_TASK_WDT:  return HEALTH_RESET_TASK_WDT;
+        case ESP_RST_WDT:       return HEALTH_RESET_OTHER_WDT;
+        case ESP_RST_DEEPSLEEP: return HEALTH_RESET_DEEP_SLEEP;
+        case ESP_RST_BROWNOUT:  return HEALTH_RESET_BROWNOUT;
+        case ESP_RST_SDIO:      return HEALTH_RESET_SDIO;
+        default:                return HEALTH_RESET_UNKNOWN;
+    }
+}
+
+/**
+ * Task watchdog ISR hook (weak in ESP-IDF): mark the record before the
+ * watchdog panics, so the reset is not mistaken for a crash
+ */
+extern "C" void IRAM_ATTR esp_task_wdt_isr_user_handler(void) {
+    health_rtc.fault = HEALTH_FAULT_TASK_WDT;
+}
+
+extern "C" void __real_esp_panic_handler(panic_info_t* info);
+
+/**
+ * Runs in front of the IDF panic handler (-Wl,--wrap=esp_panic_handler) and
+ * keeps the faulting PC chain in RTC memory. IRAM and plain stores only:
+ * the flash cache may be disabled here.
+ */
+extern "C" void IRAM_ATTR __wrap_esp_panic_handler(panic_info_t* info) {
+    if (health_rtc.fault == HEALTH_FAULT_NONE) {
+        health_rtc.fault = HEALTH_FAULT_PANIC;
+    }
+    
+    const XtExcFrame* exception = (const XtExcFrame*)info->frame;
+    if (exception && health_rtc.backtrace_depth == 0) {
+        esp_backtrace_frame_t frame = {};
+        frame.pc = exception->pc;
+        frame.sp = exception->a1;
+        frame.next_pc = exception->a0;
+        
+        uint8_t depth = 0;
+        health_rtc.backtrace[depth++] = frame.pc;
+        while (depth < HEALTH_BACKTRACE_DEPTH && frame.next_pc && esp_backtrace_get_next_frame(&frame)) {
+            // Windowed ABI: bits 31:30 hold the call size, PC - 3 is the call
+            health_rtc.backtrace[depth++] = ((frame.pc & 0x3FFFFFFFUL) | 0x40000000UL) - 3;
+        }
+        health_rtc.backtrace_depth = depth;
+    }
+    
+    __real_esp_panic_handler(info);
+}
+
+/**
+ * Task watchdog with panic on timeout, subscribed per FreeRTOS task: the
+ * Arduino loop task (setup() + loop(), fed every iteration and inside the
+ * blocking GSM / Blynk / OTA waits) and both idle tasks, which catch a core
+ * starved by a busy task. Tasks added later must call esp_task_wdt_add().
+ */
+void armTaskWatchdog() {
+    esp_task_wdt_init(HEALTH_WATCHDOG_TIMEOUT_S, true);
+    esp_task_wdt_add(NULL);
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+        TaskHandle_t idle = xTaskGetIdleTaskHandleForCPU(core);
+        if (esp_task_wdt_status(idle) == ESP_ERR_NOT_FOUND) {
+            esp_task_wdt_add(idle);
+        }
+    }
+}
+
+// Debounced level classifiers (tables loaded from system_config)
+HysteresisClassifier capacity_classifier;
+HysteresisClassifier gas_classifier;
+
+// Fill-level history and trend, retained in RTC memory across soft resets
+RTC_DATA_ATTR FillForecastState_t fill_forecast_state;
+
+// Gas pin raw -> mV: eFuse curve + bench correction (NVS namespace "binsai_adc")
+AdcLut_t gas_adc_lut;
+AdcCorrection_t gas_adc_correction;
+esp_adc_cal_value_t gas_adc_source = ESP_ADC_CAL_VAL_DEFAULT_VREF;
+AdcBenchPoint_t adc_bench_points[ADC_BENCH_MAX_POINTS];
+uint8_t adc_bench_count = 0;
+
+// Temperature / humidity for gas and sound-speed correction (optional SHT3x)
+EnvCompensation_t env_compensation;
+uint8_t env_sensor_address = 0;     // 0 = no sensor, fixed defaults
+bool env_measurement_pending = false;
+
+// Ultrasonic probe array (probe 1 is the original PIN_ULTRASONIC_* pair)
+const gpio_num_t PROBE_TRIG_PINS[PROBE_ARRAY_MAX] = {
+    PIN_ULTRASONIC_TRIG, PIN_ULTRASONIC_TRIG_2, PIN_ULTRASONIC_TRIG_3, PIN_ULTRASONIC_TRIG_4
+};
+const gpio_num_t PROBE_ECHO_PINS[PROBE_ARRAY_MAX] = {
+    PIN_ULTRASONIC_ECHO, PIN_ULTRASONIC_ECHO_2, PIN_ULTRASONIC_ECHO_3, PIN_ULTRASONIC_ECHO_4
+};
+EchoCapture_t probe_capture[PROBE_ARRAY_MAX];
+ProbeHealth_t probe_health[PROBE_ARRAY_MAX];
+uint8_t probe_count = 0;            // Probes attached (0 until applyProbeConfiguration())
+
+// UTC on the RTC slow clock (esp_clk_rtc_time), kept across deep sleep and
+// soft resets; SNTP results arrive on the lwIP task and are applied in loop()
+RTC_NOINIT_ATTR TimeState_t time_state;
+volatile bool sntp_sync_pending = false;
+int64_t sntp_sync_unix_ms = 0;
+uint64_t sntp_sync_mono_us = 0;
+uint32_t last_gsm_time_poll = 0;
+
+// MQ-135 clean-air window, checkpointed to NVS namespace "binsai_gas"
+GasBaselineState_t gas_baseline_state;
+uint32_t last_gas_baseline_save = 0;
+
+// Fleet uplink (UDP telemetry frames)
+WiFiUDP fleet_udp;
+uint32_t fleet_sequence = 0;
+
+/**
+ * gsm_serial as the GPRS link's modem port
+ */
+class SerialModemPort : public ModemPort {
+public:
+    size_t write(const uint8_t* data, size_t length) override {
+        return gsm_serial.write(data, length);
+    }
+    
+    size_t read(uint8_t* buffer, size_t capacity) override {
+        size_t count = 0;
+        while (count < capacity && gsm_serial.available()) {
+            buffer[count++] = (uint8_t)gsm_serial.read();
+        }
+        return count;
+    }
+};
+
+GprsLinkConfig_t gprsLinkConfig() {
+    GprsLinkConfig_t config;
+    gprsLinkDefaults(&config);
+    config.apn = GPRS_APN;
+    config.username = GPRS_USERNAME;
+    config.password = GPRS_PASSWORD;
+    config.host = FLEET_INGEST_HOST;
+    config.port = FLEET_INGEST_PORT;
+    return config;
+}
+
+GprsUplinkPolicy_t gprsUplinkPolicy() {
+    GprsUplinkPolicy_t policy;
+    gprsUplinkDefaults(&policy);
+    policy.sample_interval_ms = 0;          // Paced by INTERVAL_FLEET_UPLINK_MS
+    policy.daily_budget_bytes = GPRS_DAILY_BUDGET_BYTES;
+    return policy;
+}
+
+// GPRS fallback bearer; the arbiter serializes it with SMS and clock polls
+ModemArbiter modem_arbiter;
+SerialModemPort gsm_port;
+GprsTelemetryTransport gprs_transport(gsm_port, modem_arbiter, gprsLinkConfig(), gprsUplinkPolicy());
+RTC_NOINIT_ATTR GprsBudget_t gprs_budget;   // Survives resets: no fresh budget per crash
+int fleet_bearer = -1;              // Bearer_t of the fleet uplink, -1 = offline
+
+/**
+ * Plain TCP to the MQTT broker for MqttClient
+ */
+class WiFiMqttStream : public MqttStream {
+public:
+    bool open() override {
+        if (WiFi.status() != WL_CONNECTED) {
+            return false;
+        }
+        if (!_client.connect(MQTT_BROKER_HOST, MQTT_BROKER_PORT, MQTT_CONNECT_TIMEOUT_MS)) {
+            return false;
+        }
+        _client.setNoDelay(true);
+        return true;
+    }
+    
+    bool isOpen() override { return _client.connected(); }
+    void close() override { _client.stop(); }
+    
+    size_t write(const uint8_t* data, size_t length) override {
+        return _client.write(data, length);
+    }
+    
+    size_t read(uint8_t* buffer, size_t capacity) override {
+        int available = _client.available();
+        if (available <= 0) {
+            return 0;
+        }
+        int received = _client.read(buffer, (size_t)available < capacity ? (size_t)available : capacity);
+        return received > 0 ? (size_t)received : 0;
+    }
+    
+private:
+    WiFiClient _client;
+};
 
 // Data Instances
 SensorData_t current_sensor_data = {0};
 SystemConfig_t system_config = {0};
 NotificationState_t notification_state = {0};
 
+// MQTT telemetry transport (topics filled in once the device id is loaded)
+char mqtt_topic[64] = {0};
+char mqtt_health_topic[64] = {0};
+WiFiMqttStream mqtt_stream;
+
+MqttClientConfig_t mqttTransportConfig() {
+    MqttClientConfig_t config;
+    mqttClientDefaults(&config);
+    config.client_id = system_config.device_id;
+    config.username = MQTT_USERNAME[0] ? MQTT_USERNAME : NULL;
+    config.password = MQTT_PASSWORD[0] ? MQTT_PASSWORD : NULL;
+    config.topic = mqtt_topic;
+    config.event_topic = mqtt_health_topic;
+    return config;
+}
+
+MqttTelemetryTransport mqtt_transport(mqtt_stream, mqttTransportConfig());
+
 // System State Variables
 volatile bool system_initialized = false;
 volatile bool wifi_connected = false;
@@ -281,11 +753,31 @@ volatile bool critical_condition_active = false;
 
 // Timing Variables
 uint32_t last_sensor_update = 0;
+uint32_t last_sensor_ok = 0;              // Last cycle firmwareSensorCycleOk() passed
 uint32_t last_data_log = 0;
 uint32_t last_display_update = 0;
 uint32_t last_gps_check = 0;
+uint32_t last_fleet_uplink = 0;
 uint32_t system_start_time = 0;
 
+// Runtime Metrics (METRICS console command, [METRICS] log lines, V15)
+MetricsRegistry runtime_metrics;
+MetricHistogram metric_loop_us(runtime_metrics, "loop_us");              // Work per iteration
+MetricHistogram metric_loop_period_us(runtime_metrics, "loop_period_us"); // Start-to-start jitter
+MetricHistogram metric_transports_us(runtime_metrics, "transports_us");
+MetricHistogram metric_blynk_run_us(runtime_metrics, "blynk_run_us");
+MetricHistogram metric_blynk_pins_us(runtime_metrics, "blynk_pins_us");
+MetricHistogram metric_ultrasonic_us(runtime_metrics, "ultrasonic_read_us");
+MetricHistogram metric_gas_read_us(runtime_metrics, "gas_read_us");
+MetricHistogram metric_sms_send_us(runtime_metrics, "sms_send_us");
+MetricHistogram metric_lcd_render_us(runtime_metrics, "lcd_render_us");
+MetricCounter metric_ultrasonic_errors(runtime_metrics, "ultrasonic_errors");
+MetricGauge metric_heap_free(runtime_metrics, "heap_free");
+MetricGauge metric_heap_max_block(runtime_metrics, "heap_max_block");
+MetricGauge metric_heap_frag_pct(runtime_metrics, "heap_frag_pct");       // 100 - largest block / free
+MetricGauge metric_loop_heap_allocs(runtime_metrics, "loop_heap_allocs"); // Loop task only, needs BINSAI_HEAP_COUNTER
+uint32_t loop_last_start_us = 0;
+
 // Rolling averages for sensor stabilization
 float distance_rolling_avg[10] = {0};
 float ppm_rolling_avg[10] = {0};
@@ -311,15 +803,17 @@ bool initializeHardwareComponents() {
     Serial.println("==========================================");
     
     // 2. Initialize GPIO Pins
-    pinMode(PIN_ULTRASONIC_TRIG, OUTPUT);
-    pinMode(PIN_ULTRASONIC_ECHO, INPUT);
     pinMode(PIN_BUZZER, OUTPUT);
     pinMode(PIN_SIM800L_PWRKEY, OUTPUT);
     
-    digitalWrite(PIN_ULTRASONIC_TRIG, LOW);
     digitalWrite(PIN_BUZZER, LOW);
     digitalWrite(PIN_SIM800L_PWRKEY, LOW);
     
+    // Start background buzzer sequencer
+    if (!initializeBuzzer()) {
+        Serial.println("[WARNING] Buzzer timer unavailable");
+    }
+    
     // 3. Initialize I2C Bus
     Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
     delay(100);
@@ -330,6 +824,9 @@ bool initializeHardwareComponents() {
         return false;
     }
     
+    // 4b. Optional temperature/humidity sensor on the same bus
+    initializeEnvironmentSensor();
+    
     // 5. Initialize UART for GPS and GSM
     gps_serial.begin(9600, SERIAL_8N1, PIN_GPS_RX, PIN_GPS_TX);
     gsm_serial.begin(9600, SERIAL_8N1, PIN_SIM800L_RX, PIN_SIM800L_TX);
@@ -339,11 +836,18 @@ bool initializeHardwareComponents() {
     while (gps_serial.available()) gps_serial.read();
     while (gsm_serial.available()) gsm_serial.read();
     
-    // 7. Load configuration from NVS
+    // 7. Load configuration from NVS (stored blob overlays defaults)
+    initializeDefaultConfiguration();
     if (!loadSystemConfiguration()) {
         Serial.println("[WARNING] Using default configuration");
-        initializeDefaultConfiguration();
     }
+    applyClassifierConfiguration();
+    applyProbeConfiguration();
+    initializeAdcCalibration();
+    loadGasBaseline();
+    
+    // 8. Research log on internal flash (runs without it)
+    initializeResearchLog();
     
     Serial.println("[INIT] Hardware initialization complete");
     return true;
@@ -397,75 +901,136 @@ bool initializeLCDDisplay() {
 // SECTION 10: SYSTEM CONFIGURATION MANAGEMENT
 // ============================================================================
 
+/**
+ * Import configuration written by firmware before the blob format (schema 0)
+ * Caller must hold nvs_storage open
+ */
+void importLegacyConfiguration() {
+    char buffer[64];
+    
+    if (nvs_storage.getString("device_id", buffer, sizeof(buffer)) > 1) {
+        strncpy(system_config.device_id, buffer, sizeof(system_config.device_id) - 1);
+    }
+    if (nvs_storage.getString("wifi_ssid", buffer, sizeof(buffer)) > 1) {
+        strncpy(system_config.wifi_ssid, buffer, sizeof(system_config.wifi_ssid) - 1);
+    }
+    if (nvs_storage.getString("wifi_pass", buffer, sizeof(buffer)) > 1) {
+        strncpy(system_config.wifi_password, buffer, sizeof(system_config.wifi_password) - 1);
+    }
+    
+    system_config.mq135_r0_calibrated = 
+        nvs_storage.getFloat("mq135_r0", system_config.mq135_r0_calibrated);
+    system_config.ultrasonic_offset_cm = 
+        nvs_storage.getFloat("us_offset", system_config.ultrasonic_offset_cm);
+    system_config.critical_capacity_threshold = 
+        nvs_storage.getFloat("crit_cap", system_config.critical_capacity_threshold);
+    system_config.critical_gas_threshold = 
+        nvs_storage.getFloat("crit_gas", system_config.critical_gas_threshold);
+    system_config.sms_cooldown_period = 
+        nvs_storage.getUInt("sms_cd", system_config.sms_cooldown_period);
+}
+
 /**
  * Load system configuration from non-volatile storage
+ * system_config must already hold defaults; the stored blob overlays them
  * @return true if configuration loaded successfully
  */
 bool loadSystemConfiguration() {
+    uint32_t load_start = micros();
+    
     if (!nvs_storage.begin("binsai_cfg", false)) {
         Serial.println("[CONFIG] Failed to open NVS storage");
         return false;
     }
     
-    // Load device identification
-    String device_id = nvs_storage.getString("device_id", "");
-    if (device_id.length() > 0) {
-        strncpy(system_config.device_id, device_id.c_str(), 
-                sizeof(system_config.device_id) - 1);
-    } else {
-        // Generate unique device ID based on MAC address
-        String mac = WiFi.macAddress();
-        snprintf(system_config.device_id, sizeof(system_config.device_id),
-                 "BINSAI-%s", mac.substring(9).c_str());
-        nvs_storage.putString("device_id", system_config.device_id);
-    }
-    
-    // Load calibration data
-    system_config.mq135_r0_calibrated = nvs_storage.getFloat("mq135_r0", 10.0f);
-    system_config.ultrasonic_offset_cm = nvs_storage.getFloat("us_offset", 3.0f);
-    
-    // Load operational parameters
-    system_config.critical_capacity_threshold = nvs_storage.getFloat("crit_cap", 90.0f);
-    system_config.critical_gas_threshold = nvs_storage.getFloat("crit_gas", 800.0f);
-    system_config.sms_cooldown_period = nvs_storage.getUInt("sms_cd", 300000);
+    ConfigLoadResult_t result = config_store.load(&system_config);
+    bool needs_commit = false;
     
-    // Load network configuration
-    String wifi_ssid = nvs_storage.getString("wifi_ssid", "");
-    if (wifi_ssid.length() > 0) {
-        strncpy(system_config.wifi_ssid, wifi_ssid.c_str(),
-                sizeof(system_config.wifi_ssid) - 1);
+    switch (result) {
+        case CONFIG_LOAD_OK:
+            break;
+            
+        case CONFIG_LOAD_MIGRATED:
+            Serial.printf("[CONFIG] Migrated schema v%u -> v%u\n",
+                         config_store.loadedSchemaVersion(), CONFIG_SCHEMA_VERSION);
+            needs_commit = true;
+            break;
+            
+        case CONFIG_LOAD_EMPTY:
+            // First boot with blob format: pull in legacy per-key values
+            Serial.println("[CONFIG] No config blob, importing legacy keys");
+            importLegacyConfiguration();
+            needs_commit = true;
+            break;
+            
+        case CONFIG_LOAD_CORRUPT:
+            Serial.println("[CONFIG] All config slots corrupt, restoring defaults");
+            needs_commit = true;
+            break;
     }
     
-    String wifi_pass = nvs_storage.getString("wifi_pass", "");
-    if (wifi_pass.length() > 0) {
-        strncpy(system_config.wifi_password, wifi_pass.c_str(),
-                sizeof(system_config.wifi_password) - 1);
+    // Firmware version always reflects the running image
+    strncpy(system_config.firmware_version, FIRMWARE_VERSION,
+            sizeof(system_config.firmware_version) - 1);
+    
+    if (needs_commit && !config_store.commit(system_config)) {
+        Serial.println("[CONFIG] Failed to commit configuration blob");
     }
     
     nvs_storage.end();
     
-    Serial.println("[CONFIG] Configuration loaded successfully");
+    Serial.printf("[CONFIG] Configuration loaded from slot %c (seq %lu) in %lu us\n",
+                 config_store.activeSlot() == 0 ? 'A' : 'B',
+                 (unsigned long)config_store.sequence(),
+                 (unsigned long)(micros() - load_start));
     Serial.printf("[CONFIG] Device ID: %s\n", system_config.device_id);
     Serial.printf("[CONFIG] MQ135 R0: %.2f\n", system_config.mq135_r0_calibrated);
     
-    return true;
+    return result != CONFIG_LOAD_CORRUPT;
+}
+
+/**
+ * Persist the current configuration as a new blob commit
+ * @return true if configuration saved successfully
+ */
+bool saveSystemConfiguration() {
+    if (!nvs_storage.begin("binsai_cfg", false)) {
+        Serial.println("[CONFIG] Failed to open NVS storage");
+        return false;
+    }
+    
+    bool saved = config_store.commit(system_config);
+    nvs_storage.end();
+    
+    if (!saved) {
+        Serial.println("[CONFIG] Failed to commit configuration blob");
+    }
+    return saved;
 }
 
 /**
  * Initialize default system configuration
  */
 void initializeDefaultConfiguration() {
+    memset(&system_config, 0, sizeof(system_config));
+    
     // Set firmware version
-    strcpy(system_config.firmware_version, "2.0.0");
+    strcpy(system_config.firmware_version, FIRMWARE_VERSION);
     
     // Generate device ID from MAC address
-    String mac = WiFi.macAddress();
+    uint8_t mac[6];
+    WiFi.macAddress(mac);
     snprintf(system_config.device_id, sizeof(system_config.device_id),
-             "BINSAI-%s", mac.substring(9).c_str());
+             "BINSAI-%02X:%02X:%02X", mac[3], mac[4], mac[5]);
     
     // Default calibration values (from research paper)
-    system_config.mq135_r0_calibrated = 10.0f;
+    system_config.mq135_r0_calibrated = MQ135_R0_REFERENCE;
     system_config.ultrasonic_offset_cm = 3.0f;
+    system_config.mq135_temp_compensation = 1.0f;      // No correction
+    system_config.mq135_humidity_compensation = 1.0f;  // No correction
+    system_config.mq135_r0_confidence = 0.0f;          // Default R0, not measured
+    system_config.mq135_auto_baseline = true;
+    system_config.ultrasonic_probe_count = 1;
     
     // Default thresholds (from research paper)
     system_config.critical_capacity_threshold = 90.0f;
@@ -481,6 +1046,16 @@ void initializeDefaultConfiguration() {
     system_config.is_modular_unit = true;
     system_config.deployment_zone = 0;
     strcpy(system_config.location_description, "Research Laboratory");
+    
+    // Classification tables (Section 3.4.1 / Appendix 5)
+    ClassifierTable_t table;
+    classifierDefaultCapacityTable(&table);
+    memcpy(system_config.capacity_breakpoints, table.breakpoints, sizeof(table.breakpoints));
+    system_config.capacity_hysteresis = table.hysteresis;
+    classifierDefaultGasTable(&table);
+    memcpy(system_config.gas_breakpoints, table.breakpoints, sizeof(table.breakpoints));
+    system_config.gas_hysteresis = table.hysteresis;
+    system_config.classification_dwell_ms = table.min_dwell_ms;
 }
 
 // ============================================================================
@@ -488,40 +1063,164 @@ void initializeDefaultConfiguration() {
 // ============================================================================
 
 /**
- * Read ultrasonic sensor with error correction
- * @return Distance in centimeters, or -1 on error
+ * Echo-pin edge interrupt: timestamps the rising edge and the echo width
  */
-float readUltrasonicDistance() {
-    // Ensure trigger is low
-    digitalWrite(PIN_ULTRASONIC_TRIG, LOW);
-    delayMicroseconds(2);
+void IRAM_ATTR onProbeEchoEdge(void* arg) {
+    EchoCapture_t* capture = (EchoCapture_t*)arg;
+    if (!capture->armed) {
+        return;
+    }
     
-    // Send 10µs pulse
-    digitalWrite(PIN_ULTRASONIC_TRIG, HIGH);
-    delayMicroseconds(10);
-    digitalWrite(PIN_ULTRASONIC_TRIG, LOW);
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    if (gpio_get_level(capture->pin)) {
+        capture->rise_us = now;
+        capture->high = true;
+    } else if (capture->high) {
+        capture->width_us = now - capture->rise_us;
+        capture->armed = false;
+    }
+}
+
+/**
+ * Attach / detach probes to match ultrasonic_probe_count. Health scores
+ * of newly attached probes start fresh.
+ */
+void applyProbeConfiguration() {
+    uint8_t count = system_config.ultrasonic_probe_count;
+    if (count < 1 || count > PROBE_ARRAY_MAX) {
+        Serial.println("[CONFIG] Invalid ultrasonic_probe_count, using 1");
+        count = 1;
+    }
+    if (count == probe_count) {
+        return;
+    }
     
-    // Measure echo pulse width with timeout
-    long duration = pulseIn(PIN_ULTRASONIC_ECHO, HIGH, 30000);
+    for (uint8_t p = count; p < probe_count; p++) {
+        detachInterrupt(PROBE_ECHO_PINS[p]);
+    }
+    for (uint8_t p = probe_count; p < count; p++) {
+        pinMode(PROBE_TRIG_PINS[p], OUTPUT);
+        digitalWrite(PROBE_TRIG_PINS[p], LOW);
+        pinMode(PROBE_ECHO_PINS[p], INPUT);
+        probe_capture[p].pin = PROBE_ECHO_PINS[p];
+        probe_capture[p].armed = false;
+        attachInterruptArg(PROBE_ECHO_PINS[p], onProbeEchoEdge, &probe_capture[p], CHANGE);
+        probeHealthInit(&probe_health[p]);
+    }
+    probe_count = count;
+    Serial.printf("[INIT] Ultrasonic probes: %u\n", probe_count);
+}
+
+/**
+ * One round: trigger every probe in this round's staggered order and
+ * collect all echoes through the edge interrupts
+ * @param round Round index within the burst (rotates order and stagger)
+ * @param echo_us Echo width per probe for this round, 0 if none
+ */
+void runProbeRound(uint8_t round, uint32_t timeout_us, uint32_t* echo_us) {
+    uint32_t stagger_us = probeStaggerUs(round, probe_count);
+    for (uint8_t p = 0; p < probe_count; p++) {
+        probe_capture[p].high = false;
+        probe_capture[p].width_us = 0;
+        probe_capture[p].armed = true;
+    }
+    
+    uint32_t start = micros();
+    for (uint8_t slot = 0; slot < probe_count; slot++) {
+        uint32_t elapsed = micros() - start;
+        if (elapsed < slot * stagger_us) {
+            delayMicroseconds(slot * stagger_us - elapsed);
+        }
+        
+        // 10µs trigger pulse
+        gpio_num_t trig = PROBE_TRIG_PINS[probeInSlot(slot, round, probe_count)];
+        digitalWrite(trig, HIGH);
+        delayMicroseconds(10);
+        digitalWrite(trig, LOW);
+    }
     
-    // Check for timeout or invalid reading
-    if (duration == 0 || duration > 30000) {
-        Serial.println("[SENSOR] Ultrasonic sensor timeout");
-        return -1.0f;
+    // Wait out the last probe's echo window
+    uint32_t window_us = (probe_count - 1) * stagger_us + ULTRASONIC_ECHO_LEAD_US + timeout_us;
+    uint32_t elapsed = micros() - start;
+    if (elapsed < window_us) {
+        delayMicroseconds(window_us - elapsed);
     }
     
-    // Calculate distance (sound speed = 343 m/s = 0.0343 cm/µs)
-    // Distance = (time × speed) / 2 (round trip)
-    float distance_cm = duration * 0.0343f / 2.0f;
+    for (uint8_t p = 0; p < probe_count; p++) {
+        probe_capture[p].armed = false;
+        uint32_t width = probe_capture[p].width_us;
+        echo_us[p] = width <= timeout_us ? width : 0;
+    }
+}
+
+/**
+ * Read the ultrasonic probes: ULTRASONIC_BURST_PINGS staggered rounds,
+ * one trimmed surface estimate per probe (cross-talk and blind-zone
+ * echoes rejected), health scoring and volumetric fusion.
+ * Also sets distance_spread_cm, distance_confidence, peak_fill_percentage
+ * and probes_used.
+ * @return Distance in centimeters (single-probe equivalent of the fused
+ *         fill), or -1 on error
+ */
+float readUltrasonicDistance() {
+    METRIC_TIME_SCOPE(metric_ultrasonic_us);
+    
+    // Speed of sound at the current air temperature (cached by updateEnvironment())
+    float speed = env_compensation.sound_speed_cm_us;
+    float range_cm = BIN_HEIGHT_CM + system_config.ultrasonic_offset_cm;
+    if (range_cm > BURST_MAX_RANGE_CM) range_cm = BURST_MAX_RANGE_CM;
+    uint32_t timeout_us = burstEchoTimeoutUs(range_cm, speed);
+    uint32_t period_us = probeRoundPeriodUs(probe_count, speed);
+    
+    // Rounds spaced so the previous echoes have died out before the next triggers
+    uint32_t echo_us[PROBE_ARRAY_MAX][ULTRASONIC_BURST_PINGS];
+    uint32_t round_echo_us[PROBE_ARRAY_MAX];
+    uint32_t round_start = 0;
+    for (uint8_t round = 0; round < ULTRASONIC_BURST_PINGS; round++) {
+        if (round > 0) {
+            uint32_t elapsed = micros() - round_start;
+            if (elapsed < period_us) {
+                delayMicroseconds(period_us - elapsed);
+            }
+        }
+        round_start = micros();
+        runProbeRound(round, timeout_us, round_echo_us);
+        for (uint8_t p = 0; p < probe_count; p++) {
+            echo_us[p][round] = round_echo_us[p];
+        }
+    }
     
-    // Apply sensor mounting offset
-    distance_cm += system_config.ultrasonic_offset_cm;
+    BurstEstimate_t estimates[PROBE_ARRAY_MAX];
+    bool valid[PROBE_ARRAY_MAX];
+    for (uint8_t p = 0; p < probe_count; p++) {
+        valid[p] = burstEstimate(echo_us[p], ULTRASONIC_BURST_PINGS, speed, range_cm, &estimates[p]);
+        probeHealthUpdate(&probe_health[p], valid[p], estimates[p].confidence);
+        if (!valid[p]) {
+            Serial.printf("[SENSOR] Probe %u burst rejected: %u no echo, %u blind, %u outliers of %u\n",
+                          p + 1, estimates[p].no_echo, estimates[p].blind, estimates[p].outliers,
+                          estimates[p].pings);
+            metric_ultrasonic_errors.add();
+        } else if (estimates[p].in_blind_zone) {
+            // Surface at the sensor face: reads as full (ISSUES.md #003)
+            Serial.printf("[SENSOR] Probe %u blind zone - assuming full capacity\n", p + 1);
+        }
+    }
     
-    // Validate range (HC-SR04 range: 2cm to 400cm)
-    if (distance_cm < 2.0f || distance_cm > 400.0f) {
-        Serial.printf("[SENSOR] Ultrasonic reading out of range: %.2f cm\n", distance_cm);
+    ProbeFusion_t fusion;
+    bool fused = probeArrayFuse(estimates, valid, probe_health, probe_count, BIN_HEIGHT_CM, &fusion);
+    current_sensor_data.distance_spread_cm = fusion.spread_cm;
+    current_sensor_data.distance_confidence = fusion.confidence;
+    current_sensor_data.peak_fill_percentage = fusion.peak_fill_percentage;
+    current_sensor_data.probes_used = fusion.used;
+    if (!fused) {
         return -1.0f;
     }
+    if (fusion.degraded) {
+        Serial.println("[SENSOR] No healthy ultrasonic probe, using degraded readings");
+    }
+    
+    // Apply sensor mounting offset
+    float distance_cm = fusion.distance_cm + system_config.ultrasonic_offset_cm;
     
     // Update rolling average
     distance_rolling_avg[rolling_avg_index] = distance_cm;
@@ -530,28 +1229,94 @@ float readUltrasonicDistance() {
 }
 
 /**
- * Read MQ-135 gas sensor with temperature compensation
- * @return Gas concentration in PPM
+ * Name of the eFuse data esp_adc_cal used
  */
-float readGasConcentration() {
-    // Take multiple samples for averaging
-    uint32_t adc_sum = 0;
-    const uint8_t sample_count = 10;
+const char* adcSourceName(esp_adc_cal_value_t source) {
+    switch (source) {
+        case ESP_ADC_CAL_VAL_EFUSE_VREF: return "efuse_vref";
+        case ESP_ADC_CAL_VAL_EFUSE_TP:   return "efuse_two_point";
+        default:                         return "default_vref";
+    }
+}
+
+/**
+ * Rebuild the gas pin LUT: eFuse curve at every knot plus the bench correction
+ */
+void buildGasAdcLut() {
+    esp_adc_cal_characteristics_t characteristics;
+    gas_adc_source = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12,
+                                              ADC_DEFAULT_VREF_MV, &characteristics);
     
-    for (uint8_t i = 0; i < sample_count; i++) {
-        adc_sum += analogRead(PIN_GAS_SENSOR);
-        delay(10);
+    for (uint8_t i = 0; i < ADC_LUT_POINTS; i++) {
+        gas_adc_lut.mv[i] = esp_adc_cal_raw_to_voltage(adcLutKnotRaw(i), &characteristics);
     }
+    adcLutApplyCorrection(&gas_adc_lut, &gas_adc_correction);
+}
+
+/**
+ * Load the per-device ADC correction from NVS and build the LUT
+ */
+void initializeAdcCalibration() {
+    memset(&gas_adc_correction, 0, sizeof(gas_adc_correction));
     
-    uint16_t adc_average = adc_sum / sample_count;
-    current_sensor_data.adc_raw = adc_average;
+    Preferences prefs;
+    if (prefs.begin("binsai_adc", true)) {
+        if (prefs.isKey("gas")) {
+            prefs.getBytes("gas", &gas_adc_correction, sizeof(gas_adc_correction));
+        }
+        prefs.end();
+    }
+    if (!adcCorrectionIsValid(&gas_adc_correction)) {
+        memset(&gas_adc_correction, 0, sizeof(gas_adc_correction));
+    }
+    
+    buildGasAdcLut();
+    Serial.printf("[ADC] Gas pin: %s curve, %s\n", adcSourceName(gas_adc_source),
+                 adcCorrectionIsValid(&gas_adc_correction) ? "bench corrected" : "no bench correction");
+}
+
+/**
+ * Read MQ-135 gas sensor with temperature compensation
+ * @return Gas concentration in PPM
+ */
+float readGasConcentration() {
+    METRIC_TIME_SCOPE(metric_gas_read_us);
+    
+    // Take multiple samples for averaging
+    uint32_t adc_sum = 0;
+    const uint8_t sample_count = 10;
+    
+    for (uint8_t i = 0; i < sample_count; i++) {
+        adc_sum += analogRead(PIN_GAS_SENSOR);
+        delay(10);
+    }
+    
+    uint16_t adc_average = adc_sum / sample_count;
+    current_sensor_data.adc_raw = adc_average;
+    current_sensor_data.gas_millivolts = adcLutMillivolts(&gas_adc_lut, adc_average);
+    
+    // Environmental compensation: RS at the regression's lab conditions,
+    // then the same RS/R0 ratio on the reference sensor (so CALIBRATE and
+    // the background baseline correct drift), back to the output voltage
+    // that sensor would give there
+    float rs = mq135CompensatedResistance();
+    if (system_config.mq135_r0_calibrated > 0.0f) {
+        rs *= MQ135_R0_REFERENCE / system_config.mq135_r0_calibrated;
+    }
+    float v_out = MQ135_SUPPLY_MV * MQ135_LOAD_RESISTOR / (rs + MQ135_LOAD_RESISTOR);
     
     // Apply power-law regression from research: PPM = 0.002348 * ADC^2.856
-    float ppm_value = MQ135_COEFFICIENT_A * pow(adc_average, MQ135_COEFFICIENT_B);
+    // on the count an ideal linear ADC would give for that voltage
+    float adc_linear = v_out * ADC_RAW_MAX / MQ135_SUPPLY_MV;
+    float ppm_value = MQ135_COEFFICIENT_A * pow(adc_linear, MQ135_COEFFICIENT_B);
     
-    // Apply environmental compensation
-    ppm_value *= system_config.mq135_temp_compensation;
-    ppm_value *= system_config.mq135_humidity_compensation;
+    // Per-device trims on top (1.0 = none; unset trims are ignored)
+    if (system_config.mq135_temp_compensation > 0.0f) {
+        ppm_value *= system_config.mq135_temp_compensation;
+    }
+    if (system_config.mq135_humidity_compensation > 0.0f) {
+        ppm_value *= system_config.mq135_humidity_compensation;
+    }
     
     // Clamp to valid range
     if (ppm_value < 0) ppm_value = 0;
@@ -563,6 +1328,167 @@ float readGasConcentration() {
     return ppm_value;
 }
 
+/**
+ * MQ-135 sensor resistance from the calibrated output voltage
+ * RS = ((VCC / V_OUT) - 1) * RL
+ * @return RS in kOhm
+ */
+float mq135SensorResistance(uint16_t millivolts) {
+    float v_out = millivolts;
+    if (v_out < 50.0f) v_out = 50.0f;
+    if (v_out > MQ135_SUPPLY_MV - 50.0f) v_out = MQ135_SUPPLY_MV - 50.0f;
+    return ((MQ135_SUPPLY_MV / v_out) - 1.0f) * MQ135_LOAD_RESISTOR;
+}
+
+/**
+ * RS of the last gas reading, corrected to the default temperature/humidity
+ * @return kOhm
+ */
+float mq135CompensatedResistance() {
+    return envCompensateRs(&env_compensation, mq135SensorResistance(current_sensor_data.gas_millivolts));
+}
+
+/**
+ * Probe for an SHT3x on the LCD bus; without one the defaults stay in use
+ */
+void initializeEnvironmentSensor() {
+    envInit(&env_compensation);
+    
+    const uint8_t addresses[] = { ENV_SHT3X_ADDRESS, ENV_SHT3X_ADDRESS_ALT };
+    for (uint8_t i = 0; i < sizeof(addresses); i++) {
+        Wire.beginTransmission(addresses[i]);
+        if (Wire.endTransmission() == 0) {
+            env_sensor_address = addresses[i];
+            break;
+        }
+    }
+    
+    if (env_sensor_address != 0) {
+        Serial.printf("[ENV] SHT3x found at 0x%02X\n", env_sensor_address);
+    } else {
+        Serial.printf("[ENV] No T/RH sensor, using %.0f C / %.0f %%RH\n",
+                     ENV_DEFAULT_TEMPERATURE_C, ENV_DEFAULT_HUMIDITY_PCT);
+    }
+}
+
+/**
+ * Collect the pending SHT3x measurement and start the next one
+ * The 15 ms conversion runs between sensor cycles, so nothing waits on it
+ */
+void updateEnvironment() {
+    uint32_t now = millis();
+    
+    if (env_sensor_address != 0) {
+        if (env_measurement_pending) {
+            uint8_t frame[ENV_SHT3X_FRAME_SIZE];
+            uint8_t received = Wire.requestFrom(env_sensor_address, (uint8_t)ENV_SHT3X_FRAME_SIZE);
+            for (uint8_t i = 0; i < received && i < ENV_SHT3X_FRAME_SIZE; i++) {
+                frame[i] = Wire.read();
+            }
+            
+            float temperature_c, humidity_pct;
+            if (received == ENV_SHT3X_FRAME_SIZE &&
+                envSht3xDecode(frame, &temperature_c, &humidity_pct)) {
+                envUpdate(&env_compensation, temperature_c, humidity_pct, now);
+            }
+        }
+        
+        Wire.beginTransmission(env_sensor_address);
+        Wire.write(ENV_SHT3X_MEASURE_MSB);
+        Wire.write(ENV_SHT3X_MEASURE_LSB);
+        env_measurement_pending = Wire.endTransmission() == 0;
+    }
+    
+    if (envExpire(&env_compensation, now)) {
+        Serial.println("[ENV] T/RH sensor silent, back to default conditions");
+    }
+    current_sensor_data.temperature_c = env_compensation.temperature_c;
+    current_sensor_data.humidity_pct = env_compensation.humidity_pct;
+}
+
+/**
+ * Restore the baseline window from NVS, or start a fresh one
+ */
+void loadGasBaseline() {
+    Preferences prefs;
+    size_t length = 0;
+    if (prefs.begin("binsai_gas", true)) {
+        if (prefs.isKey("state")) {
+            length = prefs.getBytes("state", &gas_baseline_state, sizeof(gas_baseline_state));
+        }
+        prefs.end();
+    }
+    
+    if (length != sizeof(gas_baseline_state) || !baselineIsValid(&gas_baseline_state)) {
+        baselineInit(&gas_baseline_state, millis() / 1000);
+    }
+    
+    current_sensor_data.r0_calibrated = system_config.mq135_r0_calibrated;
+    calibration_complete = system_config.mq135_r0_confidence >= BASELINE_MIN_CONFIDENCE;
+    Serial.printf("[GAS] Baseline: %u/%u days, R0 %.2f (confidence %.0f%%)\n",
+                 gas_baseline_state.day_count, BASELINE_WINDOW_DAYS,
+                 system_config.mq135_r0_calibrated, system_config.mq135_r0_confidence);
+}
+
+/**
+ * Checkpoint the baseline window to NVS
+ */
+void saveGasBaseline() {
+    last_gas_baseline_save = millis();
+    
+    Preferences prefs;
+    if (!prefs.begin("binsai_gas", false)) {
+        return;
+    }
+    prefs.putBytes("state", &gas_baseline_state, sizeof(gas_baseline_state));
+    prefs.end();
+}
+
+/**
+ * A baseline day closed: store the new R0 if the window is confident
+ */
+void applyGasBaseline() {
+    GasBaselineEstimate_t estimate;
+    if (!baselineEstimate(&gas_baseline_state, MQ135_CLEAN_AIR_RATIO, &estimate)) {
+        return;
+    }
+    
+    Serial.printf("[GAS] Baseline day %u: RS clean %.2f kOhm, R0 %.2f, confidence %.0f%%\n",
+                 gas_baseline_state.days_total, estimate.rs_clean_kohm,
+                 estimate.r0_kohm, estimate.confidence);
+    
+    float next_r0;
+    if (!baselineNextR0(&estimate, system_config.mq135_r0_calibrated,
+                        system_config.mq135_r0_confidence, &next_r0)) {
+        return;
+    }
+    
+    system_config.mq135_r0_calibrated = next_r0;
+    system_config.mq135_r0_confidence = estimate.confidence;
+    current_sensor_data.r0_calibrated = next_r0;
+    calibration_complete = true;
+    saveSystemConfiguration();
+}
+
+/**
+ * Feed the latest gas reading to the background R0 baseline
+ * One histogram update per minute, never blocks the sample loop
+ */
+void updateGasBaseline() {
+    uint32_t now = millis();
+    if (!system_config.mq135_auto_baseline || now < GAS_BASELINE_WARMUP_MS) {
+        return;
+    }
+    
+    float rs = mq135CompensatedResistance();
+    if (baselineUpdate(&gas_baseline_state, rs, now / 1000)) {
+        applyGasBaseline();
+        saveGasBaseline();
+    } else if (now - last_gas_baseline_save >= GAS_BASELINE_PERSIST_MS) {
+        saveGasBaseline();
+    }
+}
+
 /**
  * Calculate fill percentage from distance measurement
  * @param distance_cm Measured distance from sensor to waste surface
@@ -573,17 +1499,9 @@ float calculateFillPercentage(float distance_cm) {
         return 0.0f;  // Invalid reading
     }
     
-    // Calculate effective distance (account for sensor mounting)
-    float effective_distance = distance_cm - system_config.ultrasonic_offset_cm;
-    
-    // Calculate percentage based on bin height
-    float fill_percentage = (1.0f - (effective_distance / BIN_HEIGHT_CM)) * 100.0f;
-    
-    // Clamp to valid range
-    if (fill_percentage < 0.0f) fill_percentage = 0.0f;
-    if (fill_percentage > 100.0f) fill_percentage = 100.0f;
-    
-    return fill_percentage;
+    // Effective distance (account for sensor mounting), clamped to 0-100
+    // and never NaN, even with a corrupt offset
+    return probeFillPercentage(distance_cm - system_config.ultrasonic_offset_cm, BIN_HEIGHT_CM);
 }
 
 /**
@@ -607,7 +1525,7 @@ float calculateMovingAverage(float buffer[], uint8_t size) {
 }
 
 // ============================================================================
-// SECTION 12: GPS MODULE INTERFACE
+// SECTION 12: GPS MODULE INTERFACE & TIME SERVICE
 // ============================================================================
 
 /**
@@ -642,6 +1560,7 @@ bool initializeGPSModule() {
                 break;
             }
         }
+        esp_task_wdt_reset();
         delay(10);
     }
     
@@ -684,12 +1603,91 @@ void updateGPSData() {
         gps_valid_fix = false;
     }
     
-    // Update timestamp
-    if (gps_parser.time.isValid() && 
-        gps_parser.date.isValid()) {
-        // Convert to Unix timestamp (simplified)
-        current_sensor_data.timestamp_unix = 0;  // Would need proper conversion
+    // UTC from RMC, back-dated by the time since the sentence was parsed.
+    // Only with a position fix: before that the receiver may not have the
+    // current GPS-UTC leap second offset
+    // TinyGPSPlus does not range-check the ddmmyy / hhmmss fields
+    if (gps_valid_fix && gps_parser.time.isValid() && gps_parser.date.isValid() &&
+        gps_parser.time.isUpdated() && gps_parser.time.age() < 1000 &&
+        timeCivilValid(gps_parser.date.year(), gps_parser.date.month(), gps_parser.date.day(),
+                       gps_parser.time.hour(), gps_parser.time.minute(), gps_parser.time.second())) {
+        int64_t unix_ms = timeFromCivil(gps_parser.date.year(), gps_parser.date.month(),
+                                        gps_parser.date.day(), gps_parser.time.hour(),
+                                        gps_parser.time.minute(), gps_parser.time.second()) * 1000
+                          + gps_parser.time.centisecond() * 10;
+        uint64_t mono_us = esp_clk_rtc_time() - (uint64_t)gps_parser.time.age() * 1000;
+        syncTimeService(TIME_SOURCE_GPS, unix_ms, mono_us);
+    }
+}
+
+/**
+ * SNTP sync notification (lwIP task): hand the result to loop()
+ */
+void onSntpSync(struct timeval* tv) {
+    sntp_sync_mono_us = esp_clk_rtc_time();
+    sntp_sync_unix_ms = (int64_t)tv->tv_sec * 1000 + tv->tv_usec / 1000;
+    sntp_sync_pending = true;
+}
+
+/**
+ * Keep the retained clock if the RTC kept counting and start SNTP
+ * (retries on its own once WiFi is up)
+ */
+void initializeTimeService() {
+    if (timeServiceRestore(&time_state, esp_clk_rtc_time())) {
+        Serial.printf("[TIME] Retained %s time, drift %.1f ppm\n",
+                      timeSourceName(time_state.source), time_state.drift_ppm);
+    }
+    sntp_set_time_sync_notification_cb(onSntpSync);
+    configTime(0, 0, "pool.ntp.org", "time.google.com");
+}
+
+/**
+ * Offer a reading to the time service and log source changes and steps
+ */
+void syncTimeService(uint8_t source, int64_t unix_ms, uint64_t mono_us) {
+    uint8_t previous = time_state.source;
+    if (!timeServiceSync(&time_state, source, unix_ms, mono_us)) {
+        return;
+    }
+    if (source != previous || abs(time_state.last_step_ms) >= TIME_STEP_LOG_MS) {
+        Serial.printf("[TIME] %s sync, step %ld ms, drift %.1f ppm\n", timeSourceName(source),
+                      (long)time_state.last_step_ms, time_state.drift_ppm);
+    }
+}
+
+/**
+ * Apply pending SNTP results, poll the SIM800L clock when it could be the
+ * best source, and stamp the current sample
+ */
+void updateTimeService() {
+    if (sntp_sync_pending) {
+        sntp_sync_pending = false;
+        syncTimeService(TIME_SOURCE_NTP, sntp_sync_unix_ms, sntp_sync_mono_us);
+    }
+    
+    uint64_t mono_us = esp_clk_rtc_time();
+    bool better_source_fresh = time_state.source > TIME_SOURCE_GSM &&
+                               timeServiceSyncAgeS(&time_state, mono_us) < TIME_HOLDOVER_S;
+    uint32_t poll_interval = timeServiceValid(&time_state) ? INTERVAL_GSM_TIME_MS : INTERVAL_GSM_TIME_RETRY_MS;
+    uint32_t now = millis();
+    if (gsm_module_ready && !notification_state.sms_in_progress && !better_source_fresh &&
+        (last_gsm_time_poll == 0 || now - last_gsm_time_poll >= poll_interval) &&
+        modem_arbiter.tryAcquire(MODEM_USER_TIME, now)) {
+        // A refused poll stays queued in the arbiter and retries next sample
+        last_gsm_time_poll = now;
+        FixedText<64> reply;
+        sendGSMCommandWithResponse("AT+CCLK?", 300, reply);
+        modem_arbiter.release(MODEM_USER_TIME);
+        int64_t unix_ms;
+        if (timeParseCclk(reply.c_str(), &unix_ms)) {
+            syncTimeService(TIME_SOURCE_GSM, unix_ms, mono_us);
+        }
     }
+    
+    int64_t now_ms = timeServiceNowMs(&time_state, esp_clk_rtc_time());
+    current_sensor_data.timestamp_unix = (uint32_t)(now_ms / 1000);
+    current_sensor_data.timestamp_millis = millis();
 }
 
 // ============================================================================
@@ -744,8 +1742,14 @@ bool initializeGSMModule() {
         }
     }
     
+    // Network time (NITZ) into the module clock, read back by AT+CCLK?
+    if (!sendGSMCommand("AT+CLTS=1", "OK", 1000) || !sendGSMCommand("AT&W", "OK", 1000)) {
+        Serial.println("[GSM] Network time not enabled");
+    }
+    
     // Get signal quality
-    String response = sendGSMCommandWithResponse("AT+CSQ", 2000);
+    FixedText<64> response;
+    sendGSMCommandWithResponse("AT+CSQ", 2000, response);
     Serial.printf("[GSM] Signal quality: %s\n", response.c_str());
     
     Serial.println("[GSM] Module initialized successfully");
@@ -763,22 +1767,24 @@ bool initializeGSMModule() {
 bool sendGSMCommand(const char* command, const char* expected_response, uint32_t timeout_ms) {
     gsm_serial.println(command);
     
+    // Only the newest bytes are kept: a token is matched the moment its
+    // last character arrives, so it is always at the end of the window
     uint32_t start_time = millis();
-    String response = "";
+    FixedText<GSM_REPLY_WINDOW> response;
     
     while (millis() - start_time < timeout_ms) {
         while (gsm_serial.available()) {
-            char c = gsm_serial.read();
-            response += c;
+            response.pushRolling((char)gsm_serial.read());
             
-            if (expected_response && response.indexOf(expected_response) >= 0) {
+            if (expected_response && response.endsWith(expected_response)) {
                 return true;
             }
             
-            if (response.indexOf("ERROR") >= 0) {
+            if (response.endsWith("ERROR")) {
                 return false;
             }
         }
+        esp_task_wdt_reset();
         delay(10);
     }
     
@@ -786,26 +1792,27 @@ bool sendGSMCommand(const char* command, const char* expected_response, uint32_t
 }
 
 /**
- * Send AT command and return response
+ * Send AT command and collect the response
  * @param command AT command string
  * @param timeout_ms Timeout in milliseconds
- * @return Response string
+ * @param response Receives the reply (truncated at its capacity)
+ * @return Bytes stored in response
  */
-String sendGSMCommandWithResponse(const char* command, uint32_t timeout_ms) {
+size_t sendGSMCommandWithResponse(const char* command, uint32_t timeout_ms, TextBuffer& response) {
     gsm_serial.println(command);
     
     uint32_t start_time = millis();
-    String response = "";
+    response.clear();
     
     while (millis() - start_time < timeout_ms) {
         while (gsm_serial.available()) {
-            char c = gsm_serial.read();
-            response += c;
+            response.append((char)gsm_serial.read());
         }
+        esp_task_wdt_reset();
         delay(10);
     }
     
-    return response;
+    return response.length();
 }
 
 /**
@@ -815,17 +1822,24 @@ String sendGSMCommandWithResponse(const char* command, uint32_t timeout_ms) {
  * @return true if SMS sent successfully
  */
 bool sendSMSMessage(const char* phone_number, const char* message) {
+    METRIC_TIME_SCOPE(metric_sms_send_us);
+    
     if (!gsm_module_ready) {
         Serial.println("[SMS] GSM module not ready");
         return false;
     }
     
+    if (!acquireModem(MODEM_USER_SMS, MODEM_ACQUIRE_TIMEOUT_MS)) {
+        Serial.println("[SMS] Modem busy");
+        return false;
+    }
+    
     // Set recipient number
-    String command = "AT+CMGS=\"";
-    command += phone_number;
-    command += "\"";
+    FixedText<40> command;
+    command.append("AT+CMGS=\"").append(phone_number).append('"');
     
     if (!sendGSMCommand(command.c_str(), ">", 5000)) {
+        modem_arbiter.release(MODEM_USER_SMS);
         Serial.println("[SMS] Failed to set recipient");
         return false;
     }
@@ -838,7 +1852,9 @@ bool sendSMSMessage(const char* phone_number, const char* message) {
     gsm_serial.write(26);
     
     // Wait for confirmation
-    if (sendGSMCommand("", "OK", 10000)) {
+    bool sent = sendGSMCommand("", "OK", 10000);
+    modem_arbiter.release(MODEM_USER_SMS);
+    if (sent) {
         Serial.printf("[SMS] Message sent to %s\n", phone_number);
         return true;
     }
@@ -847,39 +1863,74 @@ bool sendSMSMessage(const char* phone_number, const char* message) {
     return false;
 }
 
+/**
+ * Wait for the modem, letting an in-flight GPRS exchange finish
+ * @param user Arbiter user (blocks lower-priority users while waiting)
+ * @param timeout_ms Give up after this long
+ * @return true if the modem is held by user
+ */
+bool acquireModem(ModemUser_t user, uint32_t timeout_ms) {
+    uint32_t start_time = millis();
+    
+    while (!modem_arbiter.tryAcquire(user, millis())) {
+        if (millis() - start_time >= timeout_ms) {
+            modem_arbiter.cancel(user);
+            return false;
+        }
+        gprs_transport.loop(millis());
+        esp_task_wdt_reset();
+        delay(10);
+    }
+    
+    return true;
+}
+
 // ============================================================================
 // SECTION 14: DATA CLASSIFICATION & ANALYSIS
 // ============================================================================
 
+/**
+ * Load classification tables from system_config into the classifiers
+ * Invalid tables (unsorted, NaN) fall back to the research defaults
+ */
+void applyClassifierConfiguration() {
+    ClassifierTable_t table;
+    
+    memcpy(table.breakpoints, system_config.capacity_breakpoints, sizeof(table.breakpoints));
+    table.hysteresis = system_config.capacity_hysteresis;
+    table.min_dwell_ms = system_config.classification_dwell_ms;
+    if (!capacity_classifier.configure(table)) {
+        Serial.println("[CONFIG] Invalid capacity table, using defaults");
+        classifierDefaultCapacityTable(&table);
+        capacity_classifier.configure(table);
+    }
+    
+    memcpy(table.breakpoints, system_config.gas_breakpoints, sizeof(table.breakpoints));
+    table.hysteresis = system_config.gas_hysteresis;
+    table.min_dwell_ms = system_config.classification_dwell_ms;
+    if (!gas_classifier.configure(table)) {
+        Serial.println("[CONFIG] Invalid gas table, using defaults");
+        classifierDefaultGasTable(&table);
+        gas_classifier.configure(table);
+    }
+}
+
 /**
  * Classify waste based on gas concentration and fill level
+ * Levels use hysteresis and dwell time so boundary noise cannot flap them
  */
 void classifyWasteData() {
-    // Determine capacity level
-    if (current_sensor_data.fill_percentage <= THRESHOLD_EMPTY_PERCENT) {
-        current_sensor_data.capacity_level = 0;  // Empty
-    } else if (current_sensor_data.fill_percentage <= THRESHOLD_HALF_PERCENT) {
-        current_sensor_data.capacity_level = 1;  // Half
-    } else if (current_sensor_data.fill_percentage <= THRESHOLD_ALMOST_FULL) {
-        current_sensor_data.capacity_level = 2;  // Almost Full
-    } else {
-        current_sensor_data.capacity_level = 3;  // Full
-    }
-    
-    // Determine waste classification based on PPM
-    if (current_sensor_data.ppm_calculated <= PPM_CLEAN_AIR_MAX) {
-        current_sensor_data.waste_classification = 0;  // Clean/Normal
-        current_sensor_data.priority_level = 0;         // Normal priority
-    } else if (current_sensor_data.ppm_calculated <= PPM_INORGANIC_MAX) {
-        current_sensor_data.waste_classification = 1;  // Inorganic
-        current_sensor_data.priority_level = 1;         // Medium priority
-    } else if (current_sensor_data.ppm_calculated <= PPM_ORGANIC_L1_MAX) {
-        current_sensor_data.waste_classification = 2;  // Organic Level 1
-        current_sensor_data.priority_level = 2;         // High priority
-    } else {
-        current_sensor_data.waste_classification = 3;  // Organic Level 2
-        current_sensor_data.priority_level = 3;         // Critical priority
-    }
+    uint32_t now = millis();
+    
+    // Capacity level: 0=Empty, 1=Half, 2=Almost Full, 3=Full
+    current_sensor_data.capacity_level = 
+        capacity_classifier.update(current_sensor_data.fill_percentage, now);
+    
+    // Waste classification: 0=Clean, 1=Inorganic, 2=Organic L1, 3=Organic L2
+    // Priority follows the gas level (0=Normal ... 3=Critical)
+    current_sensor_data.waste_classification = 
+        gas_classifier.update(current_sensor_data.ppm_calculated, now);
+    current_sensor_data.priority_level = current_sensor_data.waste_classification;
     
     // Check for critical condition (both capacity >90% AND gas >800ppm)
     critical_condition_active = 
@@ -887,6 +1938,36 @@ void classifyWasteData() {
         (current_sensor_data.ppm_calculated > system_config.critical_gas_threshold);
 }
 
+/**
+ * Timestamp for the fill forecaster, read from the time service directly
+ * (its state survives soft resets, so the first sample after a reboot is
+ * already on the same base as the retained buckets)
+ * @return Unix time, or 0 while no source has set the clock
+ */
+uint32_t forecastClock() {
+    return (uint32_t)(timeServiceNowMs(&time_state, esp_clk_rtc_time()) / 1000);
+}
+
+/**
+ * Feed the current fill level to the forecaster and refresh time-to-full
+ * Without wall time the retained trend is held rather than fed uptime,
+ * which would reset it and later close a bucket spanning decades
+ */
+void updateFillForecast() {
+    uint32_t now_s = forecastClock();
+    if (now_s == 0) {
+        return;
+    }
+    
+    // Uptime-stamped state kept from an older build is not comparable
+    if (!forecastIsValid(&fill_forecast_state) || fill_forecast_state.bucket_start_s < TIME_MIN_UNIX_S) {
+        forecastInit(&fill_forecast_state, now_s);
+    }
+    
+    forecastUpdate(&fill_forecast_state, current_sensor_data.fill_percentage, now_s);
+    current_sensor_data.hours_to_full = forecastHoursToFull(&fill_forecast_state, now_s);
+}
+
 // ============================================================================
 // SECTION 15: BLYNK IOT PLATFORM INTEGRATION
 // ============================================================================
@@ -910,6 +1991,7 @@ bool connectBlynkPlatform() {
             connected = true;
             break;
         }
+        esp_task_wdt_reset();
         delay(500);
     }
     
@@ -918,8 +2000,9 @@ bool connectBlynkPlatform() {
         Serial.println("[BLYNK] Connected successfully");
         
         // Send system startup event
-        Blynk.logEvent("system_start", 
-            String("BINSAI Device ") + system_config.device_id + " is now online");
+        FixedText<64> event;
+        event.append("BINSAI Device ").append(system_config.device_id).append(" is now online");
+        Blynk.logEvent("system_start", event.c_str());
         
         return true;
     } else {
@@ -930,33 +2013,35 @@ bool connectBlynkPlatform() {
 }
 
 /**
- * Update all Blynk virtual pins with current data
+ * Update all Blynk virtual pins with one sample
+ * @param data Sample to publish (one virtualWrite per pin)
  */
-void updateBlynkVirtualPins() {
+void updateBlynkVirtualPins(const SensorData_t& data) {
     if (!blynk_connected) {
         return;
     }
+    METRIC_TIME_SCOPE(metric_blynk_pins_us);
     
     try {
         // Capacity Data (V0-V6)
-        Blynk.virtualWrite(V0_FILL_PERCENTAGE, (int)current_sensor_data.fill_percentage);
-        Blynk.virtualWrite(V5_DISTANCE_RAW, current_sensor_data.distance_cm);
+        Blynk.virtualWrite(V0_FILL_PERCENTAGE, (int)data.fill_percentage);
+        Blynk.virtualWrite(V5_DISTANCE_RAW, data.distance_cm);
         
         // LED Status Indicators (V1-V4)
-        Blynk.virtualWrite(V1_LED_FULL, (current_sensor_data.capacity_level == 3) ? 255 : 0);
-        Blynk.virtualWrite(V2_LED_ALMOST_FULL, (current_sensor_data.capacity_level == 2) ? 255 : 0);
-        Blynk.virtualWrite(V3_LED_HALF, (current_sensor_data.capacity_level == 1) ? 255 : 0);
-        Blynk.virtualWrite(V4_LED_EMPTY, (current_sensor_data.capacity_level == 0) ? 255 : 0);
+        Blynk.virtualWrite(V1_LED_FULL, (data.capacity_level == 3) ? 255 : 0);
+        Blynk.virtualWrite(V2_LED_ALMOST_FULL, (data.capacity_level == 2) ? 255 : 0);
+        Blynk.virtualWrite(V3_LED_HALF, (data.capacity_level == 1) ? 255 : 0);
+        Blynk.virtualWrite(V4_LED_EMPTY, (data.capacity_level == 0) ? 255 : 0);
         
         // Gas Sensor Data (V10)
-        Blynk.virtualWrite(V10_GAS_PPM, (int)current_sensor_data.ppm_calculated);
+        Blynk.virtualWrite(V10_GAS_PPM, (int)data.ppm_calculated);
         
         // Classification Data (V11-V13)
-        Blynk.virtualWrite(V11_PRIORITY_LEVEL, current_sensor_data.priority_level);
+        Blynk.virtualWrite(V11_PRIORITY_LEVEL, data.priority_level);
         
         // Determine waste type string
         const char* waste_type_str;
-        switch (current_sensor_data.waste_classification) {
+        switch (data.waste_classification) {
             case 0: waste_type_str = "CLEAN"; break;
             case 1: waste_type_str = "INORGANIC"; break;
             case 2: waste_type_str = "ORGANIC L1"; break;
@@ -967,7 +2052,7 @@ void updateBlynkVirtualPins() {
         
         // Determine recommendation
         const char* recommendation_str;
-        switch (current_sensor_data.priority_level) {
+        switch (data.priority_level) {
             case 0: recommendation_str = "Monitor only"; break;
             case 1: recommendation_str = "Schedule routine collection"; break;
             case 2: recommendation_str = "Prepare special bags and compartments"; break;
@@ -976,15 +2061,18 @@ void updateBlynkVirtualPins() {
         }
         Blynk.virtualWrite(V13_RECOMMENDATION, recommendation_str);
         
+        // Fill Forecast (V14)
+        Blynk.virtualWrite(V14_TIME_TO_FULL, data.hours_to_full);
+        
         // GPS Data (V20-V21)
         if (gps_valid_fix) {
-            Blynk.virtualWrite(V20_LATITUDE, current_sensor_data.latitude);
-            Blynk.virtualWrite(V21_LONGITUDE, current_sensor_data.longitude);
+            Blynk.virtualWrite(V20_LATITUDE, data.latitude);
+            Blynk.virtualWrite(V21_LONGITUDE, data.longitude);
         }
         
         // Update capacity status text (V6)
         const char* capacity_str;
-        switch (current_sensor_data.capacity_level) {
+        switch (data.capacity_level) {
             case 0: capacity_str = "EMPTY"; break;
             case 1: capacity_str = "HALF"; break;
             case 2: capacity_str = "ALMOST FULL"; break;
@@ -998,6 +2086,182 @@ void updateBlynkVirtualPins() {
     }
 }
 
+/**
+ * Frame metadata for the current device state
+ * @param sequence Per-channel sequence number
+ */
+TelemetryFrameMeta_t buildTelemetryMeta(uint32_t sequence) {
+    TelemetryFrameMeta_t meta;
+    meta.device_id = system_config.device_id;
+    meta.sequence = sequence;
+    meta.flags = (gps_valid_fix ? TELEMETRY_FLAG_GPS_FIX : 0) |
+                 (critical_condition_active ? TELEMETRY_FLAG_CRITICAL : 0);
+    meta.deployment_zone = system_config.deployment_zone;
+    meta.trace_us = 0;
+    meta.boot_epoch = telemetryBootEpoch(health_monitor.stats().boots);
+    return meta;
+}
+
+/**
+ * Blynk as a telemetry transport: samples are dropped while offline
+ */
+class BlynkTelemetryTransport : public TelemetryTransport {
+public:
+    const char* name() const override { return "Blynk"; }
+    
+    void loop(uint32_t now_ms) override {
+        if (blynk_connected) {
+            METRIC_TIME_SCOPE(metric_blynk_run_us);
+            Blynk.run();
+        } else if (wifi_connected && (now_ms % 30000 < 100)) {
+            // Attempt reconnection every 30 seconds
+            connectBlynkPlatform();
+        }
+    }
+    
+    bool connected() const override { return blynk_connected; }
+    
+    bool publishSample(const SensorData_t& data, const TelemetryFrameMeta_t& meta,
+                       uint32_t now_ms) override {
+        if (!blynk_connected) {
+            return false;
+        }
+        updateBlynkVirtualPins(data);
+        return true;
+    }
+    
+    bool publishHealth(const HealthReport_t& report, uint32_t now_ms) override {
+        if (!blynk_connected) {
+            return false;
+        }
+        FixedText<256> text;
+        healthReportFormat(report, text);
+        Blynk.logEvent("device_health", text.c_str());
+        return true;
+    }
+};
+
+BlynkTelemetryTransport blynk_transport;
+TelemetryTransport* telemetry_transports[2];
+uint8_t telemetry_transport_count = 0;
+uint32_t telemetry_sequence = 0;
+
+/**
+ * Enable Blynk, plus MQTT when MQTT_BROKER_HOST is set
+ */
+void registerTelemetryTransports() {
+    telemetry_transport_count = 0;
+    telemetry_transports[telemetry_transport_count++] = &blynk_transport;
+    
+    if (MQTT_BROKER_HOST[0] != '\0' &&
+        mqttTelemetryTopic(system_config.device_id, mqtt_topic, sizeof(mqtt_topic)) &&
+        mqttHealthTopic(system_config.device_id, mqtt_health_topic, sizeof(mqtt_health_topic))) {
+        telemetry_transports[telemetry_transport_count++] = &mqtt_transport;
+        Serial.printf("[MQTT] Publishing to %s:%d %s\n", MQTT_BROKER_HOST, MQTT_BROKER_PORT, mqtt_topic);
+    }
+}
+
+/**
+ * Hand the current sample to every registered transport
+ */
+void publishTelemetrySample() {
+    TelemetryFrameMeta_t meta = buildTelemetryMeta(++telemetry_sequence);
+    uint32_t now_ms = millis();
+    
+    for (uint8_t i = 0; i < telemetry_transport_count; i++) {
+        telemetry_transports[i]->publishSample(current_sensor_data, meta, now_ms);
+    }
+}
+
+/**
+ * Deliver the boot health report once any uplink is up; the first
+ * connection also ends the restart-time measurement
+ */
+void publishHealthReport(uint32_t now_ms) {
+    bool online = false;
+    for (uint8_t i = 0; i < telemetry_transport_count; i++) {
+        online = online || telemetry_transports[i]->connected();
+    }
+    if (!online) {
+        return;
+    }
+    health_monitor.markReady(now_ms);
+    
+    bool delivered = false;
+    for (uint8_t i = 0; i < telemetry_transport_count; i++) {
+        if (telemetry_transports[i]->connected() &&
+            telemetry_transports[i]->publishHealth(health_monitor.report(), now_ms)) {
+            delivered = true;
+        }
+    }
+    if (delivered) {
+        health_monitor.reportDelivered();
+        Serial.printf("[HEALTH] Boot report sent, restart %lu ms\n",
+                     (unsigned long)health_monitor.report().restart_ms);
+    }
+}
+
+/**
+ * Choose the fleet uplink bearer: WiFi while connected (free), else GPRS
+ * when the modem and an APN are available
+ */
+void updateTelemetryBearer() {
+    wifi_connected = (WiFi.status() == WL_CONNECTED);
+    
+    BearerStatus_t bearers[BEARER_COUNT];
+    bearers[BEARER_WIFI].available = wifi_connected;
+    bearers[BEARER_WIFI].cost_per_kb = 0;
+    bearers[BEARER_WIFI].latency_ms = 0;
+    bearers[BEARER_GPRS].available = gsm_module_ready && GPRS_APN[0] != '\0' && FLEET_INGEST_HOST[0] != '\0';
+    bearers[BEARER_GPRS].cost_per_kb = GPRS_COST_PER_KB;
+    bearers[BEARER_GPRS].latency_ms = gprs_transport.expectedLatencyMs();
+    
+    int bearer = bearerSelect(bearers, BEARER_COUNT, BEARER_MAX_LATENCY_MS);
+    if (bearer != fleet_bearer) {
+        Serial.printf("[FLEET] Bearer %s -> %s\n", bearerName(fleet_bearer), bearerName(bearer));
+        fleet_bearer = bearer;
+    }
+    gprs_transport.setActive(bearer == BEARER_GPRS);
+}
+
+/**
+ * Send the current sample to the fleet ingest server as one UDP datagram
+ * over WiFi, or queue it for a batched GPRS datagram
+ * Fire-and-forget: the server detects loss from sequence gaps
+ */
+void sendFleetTelemetry() {
+    if (FLEET_INGEST_HOST[0] == '\0') {
+        return;
+    }
+    
+    if (fleet_bearer == BEARER_GPRS) {
+        // Budget window: UTC day once the clock is set, RTC time before
+        uint64_t mono_us = esp_clk_rtc_time();
+        gprs_transport.setBudgetClock((uint32_t)(timeServiceNowMs(&time_state, mono_us) / 1000),
+                                      (uint32_t)(mono_us / 1000000));
+        
+        // Numbered only once queued, so refused frames are not counted as lost
+        TelemetryFrameMeta_t meta = buildTelemetryMeta(fleet_sequence + 1);
+        if (gprs_transport.publishSample(current_sensor_data, meta, millis())) {
+            fleet_sequence++;
+        }
+        return;
+    }
+    if (fleet_bearer != BEARER_WIFI) {
+        return;
+    }
+    
+    TelemetryFrameMeta_t meta = buildTelemetryMeta(++fleet_sequence);
+    uint8_t frame[TELEMETRY_FRAME_SIZE];
+    size_t length = telemetryEncode(current_sensor_data, meta, frame, sizeof(frame));
+    
+    if (!fleet_udp.beginPacket(FLEET_INGEST_HOST, FLEET_INGEST_PORT) ||
+        fleet_udp.write(frame, length) != length ||
+        !fleet_udp.endPacket()) {
+        Serial.println("[FLEET] Telemetry frame send failed");
+    }
+}
+
 // ============================================================================
 // SECTION 16: NOTIFICATION MANAGEMENT SYSTEM
 // ============================================================================
@@ -1035,20 +2299,17 @@ void triggerCriticalNotification() {
     Serial.println("[NOTIFY] Critical condition detected! Triggering SMS alerts...");
     
     // Prepare SMS message
-    snprintf(notification_state.sms_message_buffer, 
-             sizeof(notification_state.sms_message_buffer),
-             "[BINSAI CRITICAL ALERT] Device: %s\n"
-             "Capacity: %.0f%% | Gas: %.0f ppm\n"
-             "Priority: %d | Type: %s\n"
-             "Location: https://maps.google.com/?q=%.6f,%.6f\n"
-             "Action Required: Immediate collection needed",
-             system_config.device_id,
-             current_sensor_data.fill_percentage,
-             current_sensor_data.ppm_calculated,
-             current_sensor_data.priority_level,
-             getWasteTypeString(current_sensor_data.waste_classification),
-             current_sensor_data.latitude,
-             current_sensor_data.longitude);
+    TextBuffer sms(notification_state.sms_message_buffer, 
+                   sizeof(notification_state.sms_message_buffer));
+    sms.append("[BINSAI CRITICAL ALERT] Device: ").append(system_config.device_id)
+       .append("\nCapacity: ").appendFixed(current_sensor_data.fill_percentage, 0)
+       .append("% | Gas: ").appendFixed(current_sensor_data.ppm_calculated, 0)
+       .append(" ppm\nPriority: ").appendUnsigned(current_sensor_data.priority_level)
+       .append(" | Type: ").append(getWasteTypeString(current_sensor_data.waste_classification))
+       .append("\nLocation: https://maps.google.com/?q=")
+       .appendFixed(current_sensor_data.latitude, 6).append(',')
+       .appendFixed(current_sensor_data.longitude, 6)
+       .append("\nAction Required: Immediate collection needed");
     
     // Set notification state
     notification_state.sms_notification_pending = true;
@@ -1063,10 +2324,10 @@ void triggerCriticalNotification() {
     
     // Log event to Blynk
     if (blynk_connected) {
-        Blynk.logEvent("critical_alert", 
-            String("Critical condition: ") + 
-            String(current_sensor_data.fill_percentage, 0) + "% full, " +
-            String(current_sensor_data.ppm_calculated, 0) + " ppm");
+        FixedText<64> event;
+        event.append("Critical condition: ").appendFixed(current_sensor_data.fill_percentage, 0)
+             .append("% full, ").appendFixed(current_sensor_data.ppm_calculated, 0).append(" ppm");
+        Blynk.logEvent("critical_alert", event.c_str());
     }
 }
 
@@ -1111,9 +2372,10 @@ void processSMSNotifications() {
         notification_state.sms_recipient_index++;
         
         // Update display
-        displayNotification("SMS Progress", 
-            String(notification_state.sms_recipient_index) + "/" + 
-            String(EMERGENCY_NUMBERS_COUNT));
+        FixedText<17> progress;
+        progress.appendUnsigned(notification_state.sms_recipient_index).append('/')
+                .appendUnsigned(EMERGENCY_NUMBERS_COUNT);
+        displayNotification("SMS Progress", progress.c_str());
         
         delay(2000);  // Delay between SMS sends
         
@@ -1130,8 +2392,9 @@ void processSMSNotifications() {
                      notification_state.sms_failed_count);
         
         if (notification_state.sms_sent_count > 0) {
-            displayNotification("SMS Complete", 
-                String(notification_state.sms_sent_count) + " sent");
+            FixedText<17> summary;
+            summary.appendUnsigned(notification_state.sms_sent_count).append(" sent");
+            displayNotification("SMS Complete", summary.c_str());
             beepPattern(3);  // Success beep
         } else {
             displayNotification("SMS Failed", 
@@ -1189,25 +2452,15 @@ void displayNotification(const char* title, const char* message) {
 }
 
 /**
- * Rotate through display screens
+ * Draw one of the rotating screens
+ * @param screen 0 capacity, 1 gas, 2 system status, 3 device
  */
-void rotateDisplayScreens() {
-    static uint8_t screen_index = 0;
-    static uint32_t last_rotate = 0;
-    
-    if (millis() - last_rotate < INTERVAL_DISPLAY_ROTATE_MS) {
-        return;
-    }
-    
-    last_rotate = millis();
-    
-    if (!lcd_display || notification_state.sms_in_progress) {
-        return;
-    }
+void renderDisplayScreen(uint8_t screen) {
+    METRIC_TIME_SCOPE(metric_lcd_render_us);
     
     lcd_display.clear();
     
-    switch (screen_index % 4) {
+    switch (screen % 4) {
         case 0:  // Capacity screen
             lcd_display.setCursor(0, 0);
             lcd_display.print("Capacity:");
@@ -1243,67 +2496,89 @@ void rotateDisplayScreens() {
             lcd_display.print(system_config.device_id);
             break;
     }
-    
-    screen_index++;
 }
 
 /**
- * Get capacity level as string
- * @param level Capacity level code
- * @return String description
+ * Rotate through display screens
  */
-const char* getCapacityLevelString(uint8_t level) {
-    switch (level) {
-        case 0: return "EMPTY";
-        case 1: return "HALF";
-        case 2: return "ALMOST";
-        case 3: return "FULL";
-        default: return "UNKNOWN";
-    }
-}
+void rotateDisplayScreens() {
+    static uint8_t screen_index = 0;
+    static uint32_t last_rotate = 0;
+    
+    if (millis() - last_rotate < INTERVAL_DISPLAY_ROTATE_MS) {
+        return;
+    }
+    
+    last_rotate = millis();
+    
+    if (!lcd_display || notification_state.sms_in_progress) {
+        return;
+    }
+    
+    renderDisplayScreen(screen_index);
+    screen_index++;
+}
+
+/**
+ * Get capacity level as string
+ * @param level Capacity level code
+ * @return String description
+ */
+const char* getCapacityLevelString(uint8_t level) {
+    switch (level) {
+        case 0: return "EMPTY";
+        case 1: return "HALF";
+        case 2: return "ALMOST";
+        case 3: return "FULL";
+        default: return "UNKNOWN";
+    }
+}
 
 // ============================================================================
 // SECTION 18: AUDIO FEEDBACK
 // ============================================================================
 
 /**
- * Play beep pattern for feedback
- * @param pattern Pattern code (1=error, 2=warning, 3=success)
+ * Buzzer timer callback (esp_timer task context)
+ * Advances the sequencer and drives the buzzer pin
  */
-void beepPattern(uint8_t pattern) {
-    switch (pattern) {
-        case 1:  // Error pattern
-            for (int i = 0; i < 3; i++) {
-                digitalWrite(PIN_BUZZER, HIGH);
-                delay(100);
-                digitalWrite(PIN_BUZZER, LOW);
-                delay(100);
-            }
-            break;
-            
-        case 2:  // Warning pattern
-            for (int i = 0; i < 2; i++) {
-                digitalWrite(PIN_BUZZER, HIGH);
-                delay(200);
-                digitalWrite(PIN_BUZZER, LOW);
-                delay(200);
-            }
-            break;
-            
-        case 3:  // Success pattern
-            digitalWrite(PIN_BUZZER, HIGH);
-            delay(50);
-            digitalWrite(PIN_BUZZER, LOW);
-            delay(50);
-            digitalWrite(PIN_BUZZER, HIGH);
-            delay(50);
-            digitalWrite(PIN_BUZZER, LOW);
-            delay(50);
-            digitalWrite(PIN_BUZZER, HIGH);
-            delay(150);
-            digitalWrite(PIN_BUZZER, LOW);
-            break;
+void buzzerTimerCallback(void* arg) {
+    portENTER_CRITICAL(&buzzer_mux);
+    bool level = buzzer_sequencer.tick(millis());
+    portEXIT_CRITICAL(&buzzer_mux);
+    
+    digitalWrite(PIN_BUZZER, level ? HIGH : LOW);
+}
+
+/**
+ * Start the periodic buzzer timer
+ * @return true if timer started successfully
+ */
+bool initializeBuzzer() {
+    const esp_timer_create_args_t timer_args = {
+        .callback = &buzzerTimerCallback,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "buzzer"
+    };
+    
+    if (esp_timer_create(&timer_args, &buzzer_timer) != ESP_OK) {
+        return false;
     }
+    
+    return esp_timer_start_periodic(buzzer_timer, 
+        BUZZER_TICK_INTERVAL_MS * 1000ULL) == ESP_OK;
+}
+
+/**
+ * Play beep pattern for feedback (non-blocking)
+ * Higher priority patterns preempt lower ones; lower ones are dropped
+ * @param pattern Pattern code (1=error, 2=warning, 3=success, 4=halt)
+ */
+void beepPattern(uint8_t pattern) {
+    portENTER_CRITICAL(&buzzer_mux);
+    buzzer_sequencer.play(pattern, millis());
+    portEXIT_CRITICAL(&buzzer_mux);
 }
 
 // ============================================================================
@@ -1314,18 +2589,41 @@ void setup() {
     // Record system start time
     system_start_time = millis();
     
+    // setup() and loop() share the Arduino loop task: its allocations, not
+    // those of the WiFi / lwIP / esp_timer tasks, make loop_heap_allocs
+    heapCounterTrackCurrentTask();
+    
+    // Fold the previous run (reset reason, crash context) into the health
+    // stats, then watch this task from here on
+    health_monitor.onBoot(healthResetReason(esp_reset_reason()), system_start_time);
+    armTaskWatchdog();
+    
+    // Count this boot against a freshly installed update before anything
+    // else can crash; a crash-looping image goes back to the previous slot
+    if (firmware_boot_guard.onBoot(millis(), FIRMWARE_VERSION) == FIRMWARE_BOOT_ROLLBACK) {
+        ESP.restart();
+    }
+    if (!firmware_updater.hasSigningKey()) {
+        Serial.println("[OTA] Placeholder signing key, updates disabled (binsai-fleet ota-keygen)");
+    }
+    current_sensor_data.hours_to_full = FORECAST_UNKNOWN;
+    
     // Initialize hardware components
     if (!initializeHardwareComponents()) {
         Serial.println("[ERROR] Hardware initialization failed. System halted.");
+        // Looping halt pattern is played by the buzzer timer
+        beepPattern(BUZZER_PATTERN_HALT);
         while (1) {
-            // Blink LED to indicate error
-            digitalWrite(PIN_BUZZER, HIGH);
-            delay(100);
-            digitalWrite(PIN_BUZZER, LOW);
-            delay(900);
+            esp_task_wdt_reset();
+            delay(1000);
         }
     }
     
+    FixedText<256> health_line;
+    health_line.append("[HEALTH] ");
+    healthReportFormat(health_monitor.report(), health_line);
+    Serial.println(health_line.c_str());
+    
     // Display startup sequence
     displayNotification("BINSAI v2.0", "Initializing...");
     
@@ -1351,6 +2649,7 @@ void setup() {
     
     uint32_t wifi_timeout = millis() + WIFI_CONNECT_TIMEOUT_MS;
     while (WiFi.status() != WL_CONNECTED && millis() < wifi_timeout) {
+        esp_task_wdt_reset();
         delay(500);
         Serial.print(".");
     }
@@ -1367,10 +2666,15 @@ void setup() {
         beepPattern(1);
     }
     
+    // Wall clock (SNTP, GPS, GSM), then the GPRS budget on the same RTC clock
+    initializeTimeService();
+    gprs_transport.attachBudget(&gprs_budget, (uint32_t)(esp_clk_rtc_time() / 1000000));
+    
     // Connect to Blynk
     if (wifi_connected) {
         connectBlynkPlatform();
     }
+    registerTelemetryTransports();
     
     // System ready
     system_initialized = true;
@@ -1389,18 +2693,42 @@ void setup() {
 void loop() {
     // Current timestamp for timing control
     uint32_t current_time = millis();
+    uint32_t loop_start_us = micros();
+    uint32_t loop_start_allocs = heapTaskAllocationCount();
+    if (loop_last_start_us != 0) {
+        metric_loop_period_us.record(loop_start_us - loop_last_start_us);
+    }
+    loop_last_start_us = loop_start_us;
+    
+    // Watchdog feed and run-time accounting; the phase markers below name
+    // the step a crash or watchdog reset interrupted
+    esp_task_wdt_reset();
+    health_monitor.loop(current_time);
+    
+    // 1. Service telemetry transports (Blynk events, MQTT session and queue,
+    //    GPRS fallback bearer)
+    health_monitor.setPhase(HEALTH_PHASE_TRANSPORTS);
+    {
+        METRIC_TIME_SCOPE(metric_transports_us);
+        for (uint8_t i = 0; i < telemetry_transport_count; i++) {
+            telemetry_transports[i]->loop(current_time);
+        }
+        updateTelemetryBearer();
+        gprs_transport.loop(current_time);
+    }
     
-    // 1. Handle Blynk connection and events
-    if (blynk_connected) {
-        Blynk.run();
-    } else if (wifi_connected && (current_time % 30000 < 100)) {
-        // Attempt reconnection every 30 seconds
-        connectBlynkPlatform();
+    // 1b. Previous-run health report, once per boot when an uplink is up
+    if (!health_monitor.ready() || health_monitor.reportPending()) {
+        publishHealthReport(current_time);
     }
     
     // 2. Read sensors at 2-second interval (for Blynk updates)
     if (current_time - last_sensor_update >= INTERVAL_SENSOR_READ_MS) {
         last_sensor_update = current_time;
+        health_monitor.setPhase(HEALTH_PHASE_SENSORS);
+        
+        // Temperature/humidity for this cycle's compensation
+        updateEnvironment();
         
         // Read ultrasonic sensor
         float distance = readUltrasonicDistance();
@@ -1409,6 +2737,7 @@ void loop() {
                 calculateMovingAverage(distance_rolling_avg, 10);
             current_sensor_data.fill_percentage = 
                 calculateFillPercentage(current_sensor_data.distance_cm);
+            updateFillForecast();
         }
         
         // Read gas sensor
@@ -1417,9 +2746,14 @@ void loop() {
             current_sensor_data.ppm_calculated = 
                 calculateMovingAverage(ppm_rolling_avg, 10);
         }
+        updateGasBaseline();
+        if (firmwareSensorCycleOk(distance, current_sensor_data.gas_millivolts, MQ135_SUPPLY_MV)) {
+            last_sensor_ok = current_time;
+        }
         
-        // Update GPS data
+        // Update GPS data and the wall clock
         updateGPSData();
+        updateTimeService();
         
         // Classify waste data
         classifyWasteData();
@@ -1427,23 +2761,34 @@ void loop() {
         // Update rolling index
         rolling_avg_index = (rolling_avg_index + 1) % 10;
         
-        // Update Blynk virtual pins
-        updateBlynkVirtualPins();
+        sampleHeapMetrics();
+        
+        // Publish to Blynk virtual pins / MQTT
+        publishTelemetrySample();
         
         // Debug output
-        Serial.printf("[DATA] Dist: %.1fcm, Fill: %.1f%%, PPM: %.1f, GPS: %s\n",
-                     current_sensor_data.distance_cm,
-                     current_sensor_data.fill_percentage,
-                     current_sensor_data.ppm_calculated,
-                     gps_valid_fix ? "OK" : "NO");
+        FixedText<80> line;
+        line.append("[DATA] Dist: ").appendFixed(current_sensor_data.distance_cm, 1)
+            .append("cm, Fill: ").appendFixed(current_sensor_data.fill_percentage, 1)
+            .append("%, PPM: ").appendFixed(current_sensor_data.ppm_calculated, 1)
+            .append(", GPS: ").append(gps_valid_fix ? "OK\n" : "NO\n");
+        Serial.write((const uint8_t*)line.c_str(), line.length());
     }
     
     // 3. Log data at 60-second interval (for research purposes)
     if (current_time - last_data_log >= INTERVAL_DATA_LOG_MS) {
         last_data_log = current_time;
+        health_monitor.setPhase(HEALTH_PHASE_LOGGING);
         logResearchData();
     }
     
+    // 3b. Send telemetry frame to the fleet ingest server
+    if (current_time - last_fleet_uplink >= INTERVAL_FLEET_UPLINK_MS) {
+        last_fleet_uplink = current_time;
+        health_monitor.setPhase(HEALTH_PHASE_FLEET);
+        sendFleetTelemetry();
+    }
+    
     // 4. Check GPS status periodically
     if (current_time - last_gps_check >= INTERVAL_GPS_CHECK_MS) {
         last_gps_check = current_time;
@@ -1455,17 +2800,35 @@ void loop() {
     }
     
     // 5. Check notification conditions
+    health_monitor.setPhase(HEALTH_PHASE_NOTIFY);
     checkNotificationConditions();
     
     // 6. Process pending SMS notifications
     if (notification_state.sms_in_progress) {
+        health_monitor.setPhase(HEALTH_PHASE_SMS);
         processSMSNotifications();
     }
     
     // 7. Update display
+    health_monitor.setPhase(HEALTH_PHASE_DISPLAY);
     rotateDisplayScreens();
     
-    // 8. Small delay to prevent watchdog timer issues
+    // 8. Handle serial console commands
+    health_monitor.setPhase(HEALTH_PHASE_CONSOLE);
+    processSerialConsole();
+    
+    // 8b. Confirm or roll back a freshly installed firmware image
+    if (firmware_boot_guard.onTrial()) {
+        health_monitor.setPhase(HEALTH_PHASE_FIRMWARE);
+        checkFirmwareHealth(current_time);
+    }
+    
+    // Loop timing metrics (excludes the idle delay below)
+    metric_loop_us.record(micros() - loop_start_us);
+    metric_loop_heap_allocs.set((int32_t)(heapTaskAllocationCount() - loop_start_allocs));
+    
+    // 9. Yield so the idle tasks run (their watchdog subscription)
+    health_monitor.setPhase(HEALTH_PHASE_IDLE);
     delay(10);
 }
 
@@ -1474,30 +2837,135 @@ void loop() {
 // ============================================================================
 
 /**
- * Log research data for analysis
+ * Mount LittleFS (formatted on first use) and resume the research log
+ * after the newest intact block
+ * @return false if the file system is unavailable (log disabled)
+ */
+bool initializeResearchLog() {
+    if (!LittleFS.begin(true)) {
+        Serial.println("[LOG] LittleFS mount failed, research log disabled");
+        return false;
+    }
+    LittleFS.mkdir(RESEARCH_LOG_DIR);
+    
+    ResearchLogConfig_t config;
+    config.file_bytes = RESEARCH_LOG_FILE_BYTES;
+    config.budget_bytes = RESEARCH_LOG_BUDGET_BYTES;
+    config.sync_blocks = RESEARCH_LOG_SYNC_BLOCKS;
+    config.flush_interval_ms = RESEARCH_LOG_FLUSH_MS;
+    research_logger.begin(config);
+    Serial.printf("[LOG] Research log: %lu B used, next block %lu\n",
+                  (unsigned long)research_logger.usedBytes(), (unsigned long)research_logger.nextSequence());
+    return true;
+}
+
+/**
+ * Research record in the [RESEARCH] CSV column order (no prefix / EOL)
+ */
+void formatResearchCsv(const ResearchLogRecord_t& record, TextBuffer& line) {
+    line.appendUnsigned(record.millis).append(',')
+        .appendFixed(record.distance_cm, 2).append(',')
+        .appendFixed(record.fill_percentage, 2).append(',')
+        .appendFixed(record.ppm_calculated, 2).append(',')
+        .appendUnsigned(record.adc_raw).append(',')
+        .appendUnsigned(record.gps_fix ? 1 : 0).append(',')
+        .appendFixed(record.latitude, 6).append(',')
+        .appendFixed(record.longitude, 6).append(',')
+        .appendUnsigned(record.satellite_count).append(',')
+        .appendUnsigned(record.capacity_level).append(',')
+        .appendUnsigned(record.waste_classification).append(',')
+        .appendUnsigned(record.priority_level).append(',')
+        .appendFixed(record.hours_to_full, 1).append(',');
+    
+    // Wall clock in ms (0 until the first sync): seconds fit in 32 bits
+    if (record.unix_ms > 0) {
+        uint32_t ms = (uint32_t)(record.unix_ms % 1000);
+        line.appendUnsigned((uint32_t)(record.unix_ms / 1000))
+            .append((char)('0' + ms / 100)).append((char)('0' + ms / 10 % 10)).append((char)('0' + ms % 10));
+    } else {
+        line.append('0');
+    }
+}
+
+/**
+ * Log research data for analysis: CSV to Serial and a staged record in
+ * the on-flash research log
  */
 void logResearchData() {
-    // This would typically log to SD card or cloud service
-    // For now, we'll output to Serial in CSV format
-    
-    Serial.print("[RESEARCH] ");
-    Serial.print(millis()); Serial.print(",");
-    Serial.print(current_sensor_data.distance_cm, 2); Serial.print(",");
-    Serial.print(current_sensor_data.fill_percentage, 2); Serial.print(",");
-    Serial.print(current_sensor_data.ppm_calculated, 2); Serial.print(",");
-    Serial.print(current_sensor_data.adc_raw); Serial.print(",");
-    Serial.print(gps_valid_fix ? 1 : 0); Serial.print(",");
-    Serial.print(current_sensor_data.latitude, 6); Serial.print(",");
-    Serial.print(current_sensor_data.longitude, 6); Serial.print(",");
-    Serial.print(current_sensor_data.satellite_count); Serial.print(",");
-    Serial.print(current_sensor_data.capacity_level); Serial.print(",");
-    Serial.print(current_sensor_data.waste_classification); Serial.print(",");
-    Serial.println(current_sensor_data.priority_level);
+    ResearchLogRecord_t record;
+    record.millis = millis();
+    record.unix_ms = timeServiceNowMs(&time_state, esp_clk_rtc_time());
+    record.distance_cm = current_sensor_data.distance_cm;
+    record.fill_percentage = current_sensor_data.fill_percentage;
+    record.ppm_calculated = current_sensor_data.ppm_calculated;
+    record.adc_raw = current_sensor_data.adc_raw;
+    record.gps_fix = gps_valid_fix;
+    record.latitude = current_sensor_data.latitude;
+    record.longitude = current_sensor_data.longitude;
+    record.satellite_count = current_sensor_data.satellite_count;
+    record.capacity_level = current_sensor_data.capacity_level;
+    record.waste_classification = current_sensor_data.waste_classification;
+    record.priority_level = current_sensor_data.priority_level;
+    record.hours_to_full = current_sensor_data.hours_to_full;
+    
+    // One write per line
+    FixedText<192> line;
+    line.append("[RESEARCH] ");
+    formatResearchCsv(record, line);
+    line.append("\r\n");
+    Serial.write((const uint8_t*)line.c_str(), line.length());
+    
+    if (research_logger.ready()) {
+        research_logger.append(record, record.millis);
+        research_logger.loop(record.millis);
+    }
+    
+    logRuntimeMetrics();
     
     // Update Blynk with log event
     if (blynk_connected) {
-        Blynk.virtualWrite(V13_RECOMMENDATION, 
-            String("Last log: ") + String(millis() / 1000) + "s");
+        FixedText<32> status;
+        status.append("Last log: ").appendUnsigned(millis() / 1000).append('s');
+        Blynk.virtualWrite(V13_RECOMMENDATION, status.c_str());
+    }
+}
+
+/**
+ * Record heap level and fragmentation (largest free block vs total free)
+ */
+void sampleHeapMetrics() {
+    uint32_t free_bytes = ESP.getFreeHeap();
+    uint32_t max_block = ESP.getMaxAllocHeap();
+    
+    metric_heap_free.set((int32_t)free_bytes);
+    metric_heap_max_block.set((int32_t)max_block);
+    metric_heap_frag_pct.set(free_bytes ? (int32_t)(100 - (uint64_t)max_block * 100 / free_bytes) : 0);
+}
+
+/**
+ * Close the metrics window: one [METRICS] line per metric with the deltas
+ * since the previous research log, plus a summary on V15
+ */
+void logRuntimeMetrics() {
+    char line[128];
+    runtime_metrics.closeWindow();
+    
+    for (const Metric* metric = runtime_metrics.first(); metric; metric = metric->next()) {
+        metric->format(line, sizeof(line), true);
+        Serial.print("[METRICS] ");
+        Serial.println(line);
+    }
+    
+    if (blynk_connected) {
+        const MetricHistogramSnapshot_t& loop_window = metric_loop_us.window();
+        const MetricHistogramSnapshot_t& blynk_window = metric_blynk_run_us.window();
+        TextBuffer summary(line, sizeof(line));
+        summary.append("loop p99 ").appendUnsigned(metricsQuantileUs(loop_window, 0.99f))
+               .append(" us max ").appendUnsigned(loop_window.max_us)
+               .append(" us | blynk p99 ").appendUnsigned(metricsQuantileUs(blynk_window, 0.99f))
+               .append(" us | heap ").appendSigned(metric_heap_free.value())
+               .append(" B frag ").appendSigned(metric_heap_frag_pct.value()).append('%');
+        Blynk.virtualWrite(V15_RUNTIME_METRICS, summary.c_str());
     }
 }
 
@@ -1531,6 +2999,668 @@ BLYNK_DISCONNECTED() {
     Serial.println("[BLYNK] Disconnected from server");
 }
 
+// ============================================================================
+// SECTION 23: SERIAL COMMAND CONSOLE
+// ============================================================================
+
+/**
+ * Console output adapter for the USB serial port
+ */
+class SerialPortOutput : public ConsoleOutput {
+public:
+    void write(const char* data, size_t length) override {
+        Serial.write((const uint8_t*)data, length);
+    }
+};
+
+/**
+ * HELP - list available commands
+ */
+void handleHelpCommand(uint8_t argc, char* argv[], ConsoleOutput& out);
+
+/**
+ * STATUS - dump current SensorData_t as a single JSON line
+ */
+void handleStatusCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    StaticJsonDocument<768> doc;   // Fixed pool, no heap allocation
+    
+    doc["device_id"] = system_config.device_id;
+    doc["timestamp_millis"] = millis();
+    doc["timestamp_unix"] = current_sensor_data.timestamp_unix;
+    doc["time_source"] = timeSourceName(time_state.source);
+    doc["distance_cm"] = current_sensor_data.distance_cm;
+    doc["fill_percentage"] = current_sensor_data.fill_percentage;
+    doc["distance_spread_cm"] = current_sensor_data.distance_spread_cm;
+    doc["distance_confidence"] = current_sensor_data.distance_confidence;
+    doc["peak_fill_percentage"] = current_sensor_data.peak_fill_percentage;
+    doc["probes_used"] = current_sensor_data.probes_used;
+    JsonArray probe_scores = doc.createNestedArray("probe_health");
+    for (uint8_t p = 0; p < probe_count; p++) {
+        probe_scores.add(probe_health[p].score);
+    }
+    doc["adc_raw"] = current_sensor_data.adc_raw;
+    doc["gas_mv"] = current_sensor_data.gas_millivolts;
+    doc["temperature_c"] = current_sensor_data.temperature_c;
+    doc["humidity_pct"] = current_sensor_data.humidity_pct;
+    doc["ppm"] = current_sensor_data.ppm_calculated;
+    doc["r0"] = system_config.mq135_r0_calibrated;
+    doc["r0_confidence"] = system_config.mq135_r0_confidence;
+    doc["gps_fix"] = (bool)gps_valid_fix;
+    doc["latitude"] = current_sensor_data.latitude;
+    doc["longitude"] = current_sensor_data.longitude;
+    doc["satellites"] = current_sensor_data.satellite_count;
+    doc["hdop"] = current_sensor_data.hdop;
+    doc["capacity_level"] = current_sensor_data.capacity_level;
+    doc["waste_classification"] = current_sensor_data.waste_classification;
+    doc["priority_level"] = current_sensor_data.priority_level;
+    doc["hours_to_full"] = current_sensor_data.hours_to_full;
+    
+    char json[768];
+    size_t length = serializeJson(doc, json, sizeof(json));
+    out.write(json, length);
+    out.println("");
+}
+
+/**
+ * GET [field] - print one or all configuration fields
+ */
+void handleGetCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    char value[72];
+    
+    if (argc >= 2) {
+        const ConfigField_t* field = configFieldFind(argv[1]);
+        if (field == NULL) {
+            out.printf("ERROR unknown field: %s\r\n", argv[1]);
+            return;
+        }
+        configFieldFormat(&system_config, field, value, sizeof(value));
+        out.printf("%s=%s\r\n", field->name, value);
+        return;
+    }
+    
+    for (uint8_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        configFieldFormat(&system_config, &CONFIG_FIELDS[i], value, sizeof(value));
+        out.printf("%s=%s\r\n", CONFIG_FIELDS[i].name, value);
+    }
+}
+
+/**
+ * SET <field> <value> - update a configuration field in RAM
+ */
+void handleSetCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    const ConfigField_t* field = configFieldFind(argv[1]);
+    if (field == NULL) {
+        out.printf("ERROR unknown field: %s\r\n", argv[1]);
+        return;
+    }
+    
+    if (!configFieldSet(&system_config, field, argv[2])) {
+        out.printf("ERROR invalid value for %s\r\n", field->name);
+        return;
+    }
+    
+    // Classification tables and probe count take effect immediately
+    applyClassifierConfiguration();
+    applyProbeConfiguration();
+    
+    out.println("OK (use SAVE to persist)");
+}
+
+/**
+ * SAVE - commit the configuration blob to NVS
+ */
+void handleSaveCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    out.println(saveSystemConfiguration() ? "OK" : "ERROR");
+}
+
+/**
+ * CALIBRATE - capture MQ-135 R0 from the current clean-air reading
+ */
+void handleCalibrateCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    out.println("Calibrating...");
+    
+    // R0 = RS / clean air ratio; a manual reading is fully trusted and
+    // restarts the background window
+    float rs = mq135CompensatedResistance();
+    
+    system_config.mq135_r0_calibrated = rs / MQ135_CLEAN_AIR_RATIO;
+    system_config.mq135_r0_confidence = 100.0f;
+    current_sensor_data.r0_calibrated = system_config.mq135_r0_calibrated;
+    calibration_complete = true;
+    baselineInit(&gas_baseline_state, millis() / 1000);
+    saveGasBaseline();
+    
+    out.printf("R0=%.4f\r\n", system_config.mq135_r0_calibrated);
+    out.println(saveSystemConfiguration() ? "Done" : "ERROR");
+}
+
+/**
+ * ADCCAL [ADD <mV> | SAVE | CLEAR] - bench correction of the gas pin ADC
+ * ADD records the averaged raw reading against a metered input voltage,
+ * SAVE fits the recorded points and stores the correction in NVS
+ */
+void handleAdcCalCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    if (argc == 1) {
+        out.printf("source=%s corrected=%u bench_points=%u\r\n", adcSourceName(gas_adc_source),
+                  adcCorrectionIsValid(&gas_adc_correction) ? 1 : 0, adc_bench_count);
+        for (uint8_t i = 0; i < adc_bench_count; i++) {
+            out.printf("raw=%u mv=%u lut_mv=%u\r\n", adc_bench_points[i].raw, adc_bench_points[i].mv,
+                      adcLutMillivolts(&gas_adc_lut, adc_bench_points[i].raw));
+        }
+        return;
+    }
+    
+    if (strcasecmp(argv[1], "ADD") == 0 && argc == 3) {
+        char* end;
+        unsigned long mv = strtoul(argv[2], &end, 10);
+        if (*end != '\0' || mv == 0 || mv > MQ135_SUPPLY_MV) {
+            out.println("ERROR: mV out of range");
+            return;
+        }
+        if (adc_bench_count >= ADC_BENCH_MAX_POINTS) {
+            out.println("ERROR: bench table full, SAVE or CLEAR");
+            return;
+        }
+        
+        uint32_t raw_sum = 0;
+        for (uint8_t i = 0; i < ADC_BENCH_SAMPLES; i++) {
+            raw_sum += analogRead(PIN_GAS_SENSOR);
+            delay(2);
+        }
+        AdcBenchPoint_t& point = adc_bench_points[adc_bench_count++];
+        point.raw = (uint16_t)((raw_sum + ADC_BENCH_SAMPLES / 2) / ADC_BENCH_SAMPLES);
+        point.mv = (uint16_t)mv;
+        out.printf("raw=%u mv=%u lut_mv=%u\r\n", point.raw, point.mv,
+                  adcLutMillivolts(&gas_adc_lut, point.raw));
+        return;
+    }
+    
+    if (strcasecmp(argv[1], "SAVE") == 0 && argc == 2) {
+        // Fit against the plain eFuse curve, keep the old correction on failure
+        AdcCorrection_t previous = gas_adc_correction;
+        memset(&gas_adc_correction, 0, sizeof(gas_adc_correction));
+        buildGasAdcLut();
+        
+        AdcCorrection_t fitted;
+        if (!adcCorrectionFit(&fitted, &gas_adc_lut, adc_bench_points, adc_bench_count)) {
+            gas_adc_correction = previous;
+            buildGasAdcLut();
+            out.println("ERROR: need 2+ points with rising raw and mV");
+            return;
+        }
+        
+        gas_adc_correction = fitted;
+        buildGasAdcLut();
+        adc_bench_count = 0;
+        
+        Preferences prefs;
+        bool saved = prefs.begin("binsai_adc", false) &&
+                     prefs.putBytes("gas", &fitted, sizeof(fitted)) == sizeof(fitted);
+        prefs.end();
+        out.println(saved ? "OK" : "ERROR: NVS write failed");
+        return;
+    }
+    
+    if (strcasecmp(argv[1], "CLEAR") == 0 && argc == 2) {
+        Preferences prefs;
+        if (prefs.begin("binsai_adc", false)) {
+            prefs.remove("gas");
+            prefs.end();
+        }
+        memset(&gas_adc_correction, 0, sizeof(gas_adc_correction));
+        buildGasAdcLut();
+        adc_bench_count = 0;
+        out.println("OK");
+        return;
+    }
+    
+    out.println("ERROR usage: ADCCAL [ADD <mV> | SAVE | CLEAR]");
+}
+
+/**
+ * RESET - clear sensor filters and derived state
+ */
+void handleResetCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    memset(distance_rolling_avg, 0, sizeof(distance_rolling_avg));
+    memset(ppm_rolling_avg, 0, sizeof(ppm_rolling_avg));
+    rolling_avg_index = 0;
+    
+    current_sensor_data.distance_cm = 0;
+    current_sensor_data.fill_percentage = 0;
+    current_sensor_data.distance_spread_cm = 0;
+    current_sensor_data.distance_confidence = 0;
+    current_sensor_data.peak_fill_percentage = 0;
+    current_sensor_data.probes_used = 0;
+    current_sensor_data.ppm_calculated = 0;
+    for (uint8_t p = 0; p < probe_count; p++) {
+        probeHealthInit(&probe_health[p]);
+    }
+    critical_condition_active = false;
+    capacity_classifier.reset();
+    gas_classifier.reset();
+    
+    out.println("OK");
+}
+
+/**
+ * METRICS [RESET] - runtime counters and latency histograms (lifetime)
+ */
+void handleMetricsCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    if (argc > 1) {
+        if (strcasecmp(argv[1], "RESET") != 0) {
+            out.println("ERROR usage: METRICS [RESET]");
+            return;
+        }
+        runtime_metrics.reset();
+        out.println("OK");
+        return;
+    }
+    
+    out.printf("uptime_s=%lu\r\n", (unsigned long)((millis() - system_start_time) / 1000));
+    out.printf("heap_free=%lu\r\n", (unsigned long)ESP.getFreeHeap());
+    out.printf("heap_min_free=%lu\r\n", (unsigned long)ESP.getMinFreeHeap());
+    out.printf("heap_max_block=%lu\r\n", (unsigned long)ESP.getMaxAllocHeap());
+    if (heapCounterEnabled()) {
+        out.printf("heap_allocs=%lu heap_frees=%lu\r\n",
+                  (unsigned long)heapAllocationCount(), (unsigned long)heapFreeCount());
+    }
+    out.printf("sms_sent=%u sms_failed=%u\r\n",
+              notification_state.sms_sent_count, notification_state.sms_failed_count);
+    
+    const MqttStats_t& mqtt = mqtt_transport.client().stats();
+    out.printf("mqtt_connected=%u mqtt_queued=%u\r\n",
+              mqtt_transport.connected() ? 1 : 0, (unsigned)mqtt_transport.client().queued());
+    out.printf("mqtt_acked=%lu mqtt_resent=%lu mqtt_dropped=%lu\r\n",
+              (unsigned long)mqtt.acked, (unsigned long)mqtt.resent, (unsigned long)mqtt.dropped);
+    out.printf("mqtt_latency_ms=%lu mqtt_latency_max_ms=%lu\r\n",
+              (unsigned long)mqtt.last_latency_ms, (unsigned long)mqtt.max_latency_ms);
+    out.printf("firmware=%s firmware_trial=%u boot_attempts=%u\r\n", FIRMWARE_VERSION,
+              firmware_boot_guard.onTrial() ? 1 : 0, (unsigned)firmware_boot_guard.record().attempts);
+    
+    const HealthStats_t& health = health_monitor.stats();
+    out.printf("reset_reason=%s boots=%lu failures=%lu brownouts=%lu wdt_resets=%lu panics=%lu\r\n",
+              healthResetReasonName(health_monitor.report().reset_reason), (unsigned long)health.boots,
+              (unsigned long)health.failures, (unsigned long)health.brownouts,
+              (unsigned long)health.watchdog_resets, (unsigned long)health.panics);
+    if (health_monitor.mtbfSeconds() == HEALTH_MTBF_NONE) {
+        out.print("mtbf_s=-");
+    } else {
+        out.printf("mtbf_s=%lu", (unsigned long)health_monitor.mtbfSeconds());
+    }
+    out.printf(" restart_ms=%lu restart_mean_ms=%lu\r\n",
+              (unsigned long)health.last_restart_ms, (unsigned long)health_monitor.meanRestartMs());
+    
+    uint64_t mono_us = esp_clk_rtc_time();
+    out.printf("time_source=%s time_syncs=%u", timeSourceName(time_state.source), (unsigned)time_state.syncs);
+    if (timeServiceValid(&time_state)) {
+        out.printf(" time_age_s=%lu", (unsigned long)timeServiceSyncAgeS(&time_state, mono_us));
+    } else {
+        out.print(" time_age_s=-");
+    }
+    out.printf(" time_step_ms=%ld drift_ppm=%.1f drift_samples=%u\r\n", (long)time_state.last_step_ms,
+              time_state.drift_ppm, (unsigned)time_state.drift_samples);
+    
+    char line[128];
+    for (const Metric* metric = runtime_metrics.first(); metric; metric = metric->next()) {
+        metric->format(line, sizeof(line), false);
+        out.println(line);
+    }
+}
+
+/**
+ * One replayed research record as a [RESEARCH] line
+ */
+void dumpResearchRecord(const ResearchLogRecord_t& record, void* context) {
+    ConsoleOutput& out = *(ConsoleOutput*)context;
+    FixedText<192> line;
+    line.append("[RESEARCH] ");
+    formatResearchCsv(record, line);
+    line.append("\r\n");
+    out.write(line.c_str(), line.length());
+    esp_task_wdt_reset();
+}
+
+/**
+ * LOG [FLUSH | DUMP] - research log status, write staged records now, or
+ * print every stored record (oldest first) in the [RESEARCH] CSV format
+ */
+void handleLogCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    if (!research_logger.ready()) {
+        out.println("ERROR: research log not mounted");
+        return;
+    }
+    
+    if (argc > 1) {
+        if (strcasecmp(argv[1], "FLUSH") == 0) {
+            out.println(research_logger.flush() ? "OK" : "ERROR: write failed");
+        } else if (strcasecmp(argv[1], "DUMP") == 0) {
+            research_logger.flush();
+            ResearchLogScan_t scan;
+            researchLogReplay(research_log_backend, dumpResearchRecord, &out, &scan);
+            out.printf("OK records=%lu blocks=%lu corrupt=%lu gaps=%lu\r\n", (unsigned long)scan.records,
+                      (unsigned long)scan.blocks, (unsigned long)scan.corrupt_blocks,
+                      (unsigned long)scan.sequence_gaps);
+        } else {
+            out.println("ERROR usage: LOG [FLUSH | DUMP]");
+        }
+        return;
+    }
+    
+    const ResearchLogStats_t& stats = research_logger.stats();
+    out.printf("log_file=%lu log_used=%lu log_budget=%lu log_staged=%u\r\n",
+              (unsigned long)research_logger.fileIndex(), (unsigned long)research_logger.usedBytes(),
+              (unsigned long)RESEARCH_LOG_BUDGET_BYTES, (unsigned)research_logger.staged());
+    out.printf("log_records=%lu log_written=%lu log_dropped=%lu log_blocks=%lu log_partial=%lu\r\n",
+              (unsigned long)stats.records, (unsigned long)stats.records_written,
+              (unsigned long)stats.records_dropped, (unsigned long)stats.blocks,
+              (unsigned long)stats.partial_blocks);
+    out.printf("log_syncs=%lu log_files=%lu log_removed=%lu log_errors=%lu log_bytes=%lu\r\n",
+              (unsigned long)stats.syncs, (unsigned long)stats.files_opened, (unsigned long)stats.files_removed,
+              (unsigned long)stats.write_errors, (unsigned long)stats.bytes_written);
+}
+
+/**
+ * GPRS - fleet uplink bearer, GPRS link and batching counters
+ */
+void handleGprsCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    GprsLink& link = gprs_transport.link();
+    const GprsLinkStats_t& link_stats = link.stats();
+    const GprsUplinkStats_t& stats = gprs_transport.stats();
+    out.printf("bearer=%s gprs_state=%s gprs_latency_ms=%lu modem_owner=%s\r\n", bearerName(fleet_bearer),
+              gprsLinkStateName(link.state()), (unsigned long)gprs_transport.expectedLatencyMs(),
+              modemUserName(modem_arbiter.owner()));
+    out.printf("gprs_opens=%lu gprs_open_failures=%lu gprs_drops=%lu gprs_send_failures=%lu\r\n",
+              (unsigned long)link_stats.opens, (unsigned long)link_stats.open_failures,
+              (unsigned long)link_stats.drops, (unsigned long)link_stats.send_failures);
+    out.printf("gprs_queued=%u gprs_frames_sent=%lu gprs_urgent=%lu gprs_dropped_full=%lu gprs_dropped_budget=%lu\r\n",
+              (unsigned)gprs_transport.queued(), (unsigned long)stats.frames_sent,
+              (unsigned long)stats.frames_urgent, (unsigned long)stats.frames_dropped_full,
+              (unsigned long)stats.frames_dropped_budget);
+    out.printf("gprs_datagrams=%lu gprs_wire_bytes=%lu gprs_budget_used=%lu gprs_budget=%lu gprs_max_delay_ms=%lu\r\n",
+              (unsigned long)stats.datagrams, (unsigned long)stats.wire_bytes,
+              (unsigned long)stats.budget_used_bytes, (unsigned long)GPRS_DAILY_BUDGET_BYTES,
+              (unsigned long)stats.max_delay_ms);
+}
+
+/**
+ * BENCH cases: one timed call each, false when the operation failed
+ */
+bool benchUltrasonicRead(void* context) {
+    return readUltrasonicDistance() > 0;
+}
+
+bool benchGasRead(void* context) {
+    return readGasConcentration() >= 0;
+}
+
+/**
+ * "AT" to "OK" without sendGSMCommand's 10 ms polling step, so the round
+ * trip is resolved to the byte
+ */
+bool benchGsmRoundTrip(void* context) {
+    while (gsm_serial.available()) {
+        gsm_serial.read();
+    }
+    gsm_serial.println("AT");
+    
+    uint32_t start_time = millis();
+    FixedText<GSM_REPLY_WINDOW> response;
+    while (millis() - start_time < BENCH_GSM_TIMEOUT_MS) {
+        while (gsm_serial.available()) {
+            response.pushRolling((char)gsm_serial.read());
+            if (response.endsWith("OK\r\n")) {
+                return true;
+            }
+        }
+        esp_task_wdt_reset();
+    }
+    return false;
+}
+
+bool benchBlynkPublish(void* context) {
+    updateBlynkVirtualPins(current_sensor_data);
+    return blynk_connected;
+}
+
+bool benchLcdRender(void* context) {
+    uint8_t* screen = (uint8_t*)context;
+    renderDisplayScreen((*screen)++);
+    return true;
+}
+
+void benchYield() {
+    esp_task_wdt_reset();
+}
+
+void benchReportLine(const char* line, size_t length, void* context) {
+    ((ConsoleOutput*)context)->println(line);
+}
+
+/**
+ * BENCH [iterations] - time the hardware paths on this device and print a
+ * binsai-perf JSON report (compare two with binsai-fleet perf-compare).
+ * Blocks the loop for the duration; loop_us / loop_period_us are the live
+ * histograms since boot or METRICS RESET.
+ */
+void handleBenchCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    static uint32_t bench_samples_ns[BENCH_MAX_ITERATIONS];
+    
+    unsigned long iterations = BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        char* end;
+        iterations = strtoul(argv[1], &end, 10);
+        if (*end != '\0' || iterations == 0 || iterations > BENCH_MAX_ITERATIONS) {
+            out.printf("ERROR usage: BENCH [1-%u]\r\n", (unsigned)BENCH_MAX_ITERATIONS);
+            return;
+        }
+    }
+    
+    PerfBench bench(bench_samples_ns, BENCH_MAX_ITERATIONS);
+    bench.setYield(benchYield);
+    PerfReportWriter report(benchReportLine, &out);
+    PerfReportHeader_t header = {FIRMWARE_VERSION, "esp32", system_config.device_id};
+    PerfBenchStats_t stats;
+    MetricHistogramSnapshot_t snapshot;
+    
+    report.begin(header);
+    
+    metric_loop_us.snapshot(&snapshot);
+    perfStatsFromHistogram(snapshot, &stats);
+    report.add("loop_us", stats);
+    metric_loop_period_us.snapshot(&snapshot);
+    perfStatsFromHistogram(snapshot, &stats);
+    report.add("loop_period_us", stats);
+    
+    bench.run(benchUltrasonicRead, nullptr, iterations, 1, 1, &stats);
+    report.add("ultrasonic_read", stats);
+    bench.run(benchGasRead, nullptr, iterations, 1, 1, &stats);
+    report.add("gas_read", stats);
+    
+    // Unavailable paths stay in the report with n=0
+    memset(&stats, 0, sizeof(stats));
+    if (gsm_module_ready && acquireModem(MODEM_USER_TIME, MODEM_ACQUIRE_TIMEOUT_MS)) {
+        bench.run(benchGsmRoundTrip, nullptr, iterations, 1, 1, &stats);
+        modem_arbiter.release(MODEM_USER_TIME);
+    }
+    report.add("gsm_at_rtt", stats);
+    
+    memset(&stats, 0, sizeof(stats));
+    if (blynk_connected) {
+        bench.run(benchBlynkPublish, nullptr, iterations, 1, 1, &stats);
+    }
+    report.add("blynk_publish", stats);
+    
+    memset(&stats, 0, sizeof(stats));
+    uint8_t screen = 0;
+    if (lcd_display && !notification_state.sms_in_progress) {
+        bench.run(benchLcdRender, &screen, iterations, 1, 1, &stats);
+    }
+    report.add("lcd_render", stats);
+    
+    report.end();
+}
+
+/**
+ * REBOOT - restart the device
+ */
+void handleRebootCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    research_logger.flush();
+    out.println("Rebooting...");
+    Serial.flush();
+    ESP.restart();
+}
+
+/**
+ * Stream a signed update file ([manifest][payload]) into the inactive slot
+ * Any Arduino Stream works: WiFiClient today, a SIM800L GPRS client later
+ * @return Final updater status (Ready on success)
+ */
+FirmwareUpdateStatus_t runFirmwareUpdate(Stream& stream, ConsoleOutput& out) {
+    FirmwareManifest_t manifest;
+    stream.setTimeout(OTA_STALL_TIMEOUT_MS);
+    if (stream.readBytes((uint8_t*)&manifest, sizeof(manifest)) != sizeof(manifest)) {
+        return FIRMWARE_UPDATE_BAD_MANIFEST;
+    }
+    
+    FirmwareUpdateStatus_t status = firmware_updater.begin(manifest);
+    if (status != FIRMWARE_UPDATE_RECEIVING) {
+        return status;
+    }
+    out.printf("OTA %.16s: %lu B payload (%s)\r\n", manifest.version, (unsigned long)manifest.payload_size,
+              (manifest.flags & FIRMWARE_FLAG_DELTA) ? "delta" : "full");
+    
+    uint8_t chunk[OTA_CHUNK_SIZE];
+    uint32_t last_data = millis();
+    while (status == FIRMWARE_UPDATE_RECEIVING) {
+        size_t wanted = manifest.payload_size - firmware_updater.payloadReceived();
+        size_t available = (size_t)stream.available();
+        if (available == 0) {
+            if (millis() - last_data > OTA_STALL_TIMEOUT_MS) {
+                firmware_updater.abort();
+                return FIRMWARE_UPDATE_PATCH_ERROR;
+            }
+            delay(1);
+            continue;
+        }
+        size_t length = stream.readBytes(chunk, min(min(available, wanted), sizeof(chunk)));
+        status = firmware_updater.write(chunk, length);
+        esp_task_wdt_reset();
+        last_data = millis();
+    }
+    return status;
+}
+
+/**
+ * OTA <url> - download, verify and install a signed update, then reboot
+ * Plain HTTP is acceptable: the manifest signature and digests carry trust
+ */
+void handleOtaCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    if (!firmware_updater.hasSigningKey()) {
+        out.println("ERROR: OTA disabled, no signing key compiled in");
+        return;
+    }
+    if (WiFi.status() != WL_CONNECTED) {
+        out.println("ERROR: WiFi offline");
+        return;
+    }
+    
+    HTTPClient http;
+    if (!http.begin(argv[1])) {
+        out.println("ERROR: bad URL");
+        return;
+    }
+    int code = http.GET();
+    if (code != HTTP_CODE_OK) {
+        out.printf("ERROR: HTTP %d\r\n", code);
+        http.end();
+        return;
+    }
+    
+    uint32_t started = millis();
+    FirmwareUpdateStatus_t status = runFirmwareUpdate(*http.getStreamPtr(), out);
+    http.end();
+    if (status != FIRMWARE_UPDATE_READY) {
+        out.printf("ERROR: %s\r\n", firmwareUpdateStatusName(status));
+        return;
+    }
+    
+    out.printf("OK %lu B image in %lu ms, rebooting\r\n",
+              (unsigned long)firmware_updater.imageWritten(), (unsigned long)(millis() - started));
+    if (!firmware_updater.activate()) {
+        out.println("ERROR: cannot select new slot");
+        return;
+    }
+    research_logger.flush();
+    Serial.flush();
+    ESP.restart();
+}
+
+/**
+ * Health check for an image on trial: the loop is running (this is called
+ * from it), a sensor cycle fused a distance with the gas output off the
+ * rails lately (see firmwareSensorCycleOk()) and any uplink is up, GPRS
+ * included. A unit with no uplink for the whole window still rolls back:
+ * an image that breaks networking could never be replaced remotely
+ */
+void checkFirmwareHealth(uint32_t now) {
+    bool uplink_ok = blynk_connected || mqtt_transport.connected() || gprs_transport.connected();
+    bool healthy = firmwareHealthy(system_initialized, uplink_ok, last_sensor_ok,
+                                   2 * INTERVAL_SENSOR_READ_MS, now);
+    
+    switch (firmware_boot_guard.loop(now, healthy)) {
+        case FIRMWARE_BOOT_HEALTHY:
+            Serial.printf("[OTA] Firmware %s confirmed\n", FIRMWARE_VERSION);
+            break;
+        case FIRMWARE_BOOT_ROLLBACK:
+            Serial.printf("[OTA] Firmware %s failed health check, rolling back\n", FIRMWARE_VERSION);
+            Serial.flush();
+            ESP.restart();
+            break;
+        default:
+            break;
+    }
+}
+
+// Command table (names hashed at compile time)
+static constexpr ConsoleCommand_t CONSOLE_COMMANDS[] = {
+    CONSOLE_COMMAND("HELP",      0, "HELP", handleHelpCommand),
+    CONSOLE_COMMAND("STATUS",    0, "STATUS", handleStatusCommand),
+    CONSOLE_COMMAND("GET",       0, "GET [field]", handleGetCommand),
+    CONSOLE_COMMAND("SET",       2, "SET <field> <value>", handleSetCommand),
+    CONSOLE_COMMAND("SAVE",      0, "SAVE", handleSaveCommand),
+    CONSOLE_COMMAND("CALIBRATE", 0, "CALIBRATE", handleCalibrateCommand),
+    CONSOLE_COMMAND("ADCCAL",    0, "ADCCAL [ADD <mV> | SAVE | CLEAR]", handleAdcCalCommand),
+    CONSOLE_COMMAND("RESET",     0, "RESET", handleResetCommand),
+    CONSOLE_COMMAND("METRICS",   0, "METRICS [RESET]", handleMetricsCommand),
+    CONSOLE_COMMAND("LOG",       0, "LOG [FLUSH | DUMP]", handleLogCommand),
+    CONSOLE_COMMAND("GPRS",      0, "GPRS", handleGprsCommand),
+    CONSOLE_COMMAND("BENCH",     0, "BENCH [iterations]", handleBenchCommand),
+    CONSOLE_COMMAND("REBOOT",    0, "REBOOT", handleRebootCommand),
+    CONSOLE_COMMAND("OTA",       1, "OTA <url>", handleOtaCommand),
+};
+static constexpr size_t CONSOLE_COMMAND_COUNT = 
+    sizeof(CONSOLE_COMMANDS) / sizeof(CONSOLE_COMMANDS[0]);
+static_assert(consoleTableIsValid(CONSOLE_COMMANDS, CONSOLE_COMMAND_COUNT),
+              "Duplicate serial console command");
+
+SerialPortOutput serial_console_output;
+SerialConsole serial_console(CONSOLE_COMMANDS, CONSOLE_COMMAND_COUNT, serial_console_output);
+
+void handleHelpCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    for (size_t i = 0; i < CONSOLE_COMMAND_COUNT; i++) {
+        out.println(CONSOLE_COMMANDS[i].usage);
+    }
+}
+
+/**
+ * Drain pending serial input into the console (non-blocking)
+ */
+void processSerialConsole() {
+    while (Serial.available() > 0) {
+        serial_console.feed((char)Serial.read());
+    }
+}
+
 // ============================================================================
 // END OF BINSAI RESEARCH SYSTEM CODE
 // ============================================================================
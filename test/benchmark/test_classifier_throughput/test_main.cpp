@@ -0,0 +1,92 @@
+/**
+ * BINSAI Benchmark - Classifier Throughput
+ * Compares the legacy if/else ladder with the branch-free table lookup and
+ * the full hysteresis classifier on random (unpredictable) input.
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <WasteClassifier.h>
+
+#define BENCH_SAMPLES       1000000
+#define BENCH_ROUNDS        20
+
+static float samples[BENCH_SAMPLES];
+static volatile uint32_t sink;
+
+/**
+ * Legacy classifyWasteData() capacity ladder (reference implementation)
+ */
+static uint8_t ladderLevel(float fill) {
+    if (fill <= THRESHOLD_EMPTY_PERCENT) return 0;
+    else if (fill <= THRESHOLD_HALF_PERCENT) return 1;
+    else if (fill <= THRESHOLD_ALMOST_FULL) return 2;
+    return 3;
+}
+
+static double nanosPerSample(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ((double)BENCH_SAMPLES * BENCH_ROUNDS);
+}
+
+void setUp() {
+    uint32_t state = 0x12345678UL;
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        state = state * 1664525UL + 1013904223UL;     // LCG, deterministic
+        samples[i] = (float)(state >> 8) / (float)(1UL << 24) * 100.0f;
+    }
+}
+
+void tearDown() {}
+
+void test_lookup_matches_ladder() {
+    ClassifierTable_t table;
+    classifierDefaultCapacityTable(&table);
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        TEST_ASSERT_EQUAL_UINT8(ladderLevel(samples[i]), classifyLevel(table.breakpoints, samples[i]));
+    }
+}
+
+void test_benchmark_classifier_throughput() {
+    ClassifierTable_t table;
+    classifierDefaultCapacityTable(&table);
+    HysteresisClassifier classifier;
+    classifier.configure(table);
+
+    uint32_t acc = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) acc += ladderLevel(samples[i]);
+    }
+    double ladder_ns = nanosPerSample(start);
+    sink = acc;
+
+    acc = 0;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) acc += classifyLevel(table.breakpoints, samples[i]);
+    }
+    double lookup_ns = nanosPerSample(start);
+    sink = acc;
+
+    acc = 0;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            acc += classifier.update(samples[i], (uint32_t)i * 2000);
+        }
+    }
+    double hysteresis_ns = nanosPerSample(start);
+    sink = acc;
+
+    printf("[BENCH] classifier ladder=%.2f ns/sample lookup=%.2f ns/sample hysteresis=%.2f ns/sample\n",
+           ladder_ns, lookup_ns, hysteresis_ns);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_lookup_matches_ladder);
+    RUN_TEST(test_benchmark_classifier_throughput);
+    return UNITY_END();
+}
@@ -0,0 +1,191 @@
+/**
+ * BINSAI Benchmark - Firmware Update Patch Size
+ * Full (LZSS) vs delta payload size for typical release changes on a
+ * 1.2 MB relinked image, download time over WiFi and SIM800L GPRS, and
+ * host-side diff / apply / verify cost.
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <DeltaPatch.h>
+#include <Ed25519.h>
+#include <FirmwareUpdate.h>
+#include <Sha512.h>
+
+#define IMAGE_SIZE                  (1200 * 1024)
+#define WIFI_GOODPUT_BPS            1000000.0   // Weak-signal HTTP on a roadside bin
+#define GPRS_GOODPUT_BPS            40000.0     // SIM800L AT+HTTPREAD, class 10
+
+typedef struct {
+    const char* label;
+    size_t insert_at;               // Where new code lands (addresses after it move)
+    size_t insert_length;
+    size_t replace_at;              // Region rebuilt from scratch (library bump)
+    size_t replace_length;
+    uint32_t constant_edits;        // Scattered literal changes
+} Release_t;
+
+/**
+ * Opcode-like words from a small vocabulary plus absolute addresses into
+ * the image, so inserted code shifts every later pointer like a relink
+ */
+static std::vector<uint8_t> makeImage(const Release_t& release) {
+    std::vector<uint8_t> image;
+    image.reserve(IMAGE_SIZE + release.insert_length);
+    uint32_t state = 2024;
+    uint32_t fresh = 99;
+
+    for (size_t word = 0; image.size() < IMAGE_SIZE + release.insert_length; word++) {
+        size_t offset = word * 4;
+        if (release.insert_length && offset == release.insert_at) {
+            for (size_t i = 0; i < release.insert_length; i += 4) {
+                fresh = fresh * 1103515245UL + 12345;
+                uint32_t value = (fresh >> 8) & 0x00FF0F3F;
+                for (int b = 0; b < 4; b++) image.push_back((uint8_t)(value >> (8 * b)));
+            }
+        }
+
+        state = state * 1103515245UL + 12345;
+        uint32_t value;
+        uint32_t kind = (state >> 8) % 8;
+        if (kind < 2) {
+            uint32_t target = ((state >> 4) & 0xFFFFC) % IMAGE_SIZE;
+            value = 0x400D0000UL + target + (target >= release.insert_at ? release.insert_length : 0);
+        } else if (kind == 2) {
+            value = 0;
+        } else {
+            value = (state >> 8) & 0x00FF0F3F;
+        }
+
+        if (offset >= release.replace_at && offset < release.replace_at + release.replace_length) {
+            fresh = fresh * 1103515245UL + 12345;
+            value = (fresh >> 8) & 0x00FF0F3F;
+        }
+        for (int b = 0; b < 4; b++) image.push_back((uint8_t)(value >> (8 * b)));
+    }
+
+    uint32_t edit = 7;
+    for (uint32_t i = 0; i < release.constant_edits; i++) {
+        edit = edit * 1103515245UL + 12345;
+        image[(edit >> 4) % image.size()] ^= 0x20;
+    }
+    image.resize(IMAGE_SIZE + release.insert_length);
+    return image;
+}
+
+class VectorPatchIo : public PatchSource, public PatchSink {
+public:
+    const std::vector<uint8_t>* source;
+    size_t written;
+
+    bool readSource(uint32_t offset, void* buffer, size_t length) override {
+        if (offset + length > source->size()) return false;
+        memcpy(buffer, source->data() + offset, length);
+        return true;
+    }
+
+    bool writeTarget(const void*, size_t length) override {
+        written += length;
+        return true;
+    }
+};
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_benchmark_patch_sizes() {
+    const Release_t none = { "base", (size_t)-1, 0, (size_t)-1, 0, 0 };
+    const Release_t releases[] = {
+        { "threshold tweak", (size_t)-1, 0, (size_t)-1, 0, 4 },
+        { "new 2 KB function", 400 * 1024, 2048, (size_t)-1, 0, 8 },
+        { "bugfix + 200 B", 900 * 1024, 200, (size_t)-1, 0, 2 },
+        { "library bump 64 KB", 300 * 1024, 4096, 700 * 1024, 64 * 1024, 16 },
+    };
+    std::vector<uint8_t> base = makeImage(none);
+
+    std::vector<uint8_t> full;
+    DeltaPatchStats_t full_stats;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    deltaPatchCreate(NULL, 0, base.data(), base.size(), &full, &full_stats);
+    double full_ms = elapsedMs(start);
+    printf("[BENCH] image %zu B, full LZSS payload %u B (%.1f%%) in %.0f ms: WiFi %.1f s, GPRS %.0f s\n",
+           base.size(), full_stats.patch_bytes, 100.0 * full_stats.patch_bytes / base.size(), full_ms,
+           full_stats.patch_bytes * 8 / WIFI_GOODPUT_BPS, full_stats.patch_bytes * 8 / GPRS_GOODPUT_BPS);
+
+    for (size_t r = 0; r < sizeof(releases) / sizeof(releases[0]); r++) {
+        std::vector<uint8_t> image = makeImage(releases[r]);
+        std::vector<uint8_t> patch;
+        DeltaPatchStats_t stats;
+
+        start = std::chrono::steady_clock::now();
+        deltaPatchCreate(base.data(), base.size(), image.data(), image.size(), &patch, &stats);
+        double diff_ms = elapsedMs(start);
+
+        VectorPatchIo io;
+        io.source = &base;
+        io.written = 0;
+        DeltaPatchApplier applier(io, io);
+        start = std::chrono::steady_clock::now();
+        DeltaApplyStatus_t status = DELTA_APPLY_RUNNING;
+        for (size_t offset = 0; offset < patch.size(); offset += 1024) {
+            status = applier.write(patch.data() + offset, patch.size() - offset < 1024 ? patch.size() - offset : 1024);
+        }
+        double apply_ms = elapsedMs(start);
+
+        printf("[BENCH] %-20s delta %7u B (%5.2f%% of full, %3u records, %6u extra) "
+               "WiFi %5.2f s GPRS %5.1f s | diff %5.0f ms apply %4.1f ms\n",
+               releases[r].label, stats.patch_bytes, 100.0 * stats.patch_bytes / full_stats.patch_bytes,
+               stats.records, stats.extra_bytes, stats.patch_bytes * 8 / WIFI_GOODPUT_BPS,
+               stats.patch_bytes * 8 / GPRS_GOODPUT_BPS, diff_ms, apply_ms);
+
+        TEST_ASSERT_EQUAL_INT(DELTA_APPLY_DONE, status);
+        TEST_ASSERT_EQUAL_UINT32(image.size(), io.written);
+        TEST_ASSERT_TRUE(stats.patch_bytes < full_stats.patch_bytes / 4);
+    }
+}
+
+void test_benchmark_verify_cost() {
+    std::vector<uint8_t> image(IMAGE_SIZE, 0xA5);
+    uint8_t digest[SHA512_DIGEST_SIZE];
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Sha512::hash(image.data(), image.size(), digest);
+    double hash_ms = elapsedMs(start);
+
+    uint8_t seed[ED25519_SEED_SIZE] = { 42 };
+    FirmwareManifest_t manifest;
+    memset(&manifest, 0, sizeof(manifest));
+    manifest.magic = FIRMWARE_MANIFEST_MAGIC;
+    memcpy(manifest.target_digest, digest, sizeof(digest));
+    uint8_t public_key[ED25519_PUBLIC_KEY_SIZE];
+    ed25519PublicKey(seed, public_key);
+
+    start = std::chrono::steady_clock::now();
+    firmwareManifestSign(&manifest, seed);
+    double sign_ms = elapsedMs(start);
+
+    const int rounds = 20;
+    bool valid = true;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        valid = valid && firmwareManifestVerify(manifest, public_key);
+    }
+    double verify_ms = elapsedMs(start) / rounds;
+
+    printf("[BENCH] SHA-512 %.1f MB/s | manifest %zu B, Ed25519 sign %.2f ms, verify %.2f ms (host)\n",
+           image.size() / hash_ms / 1000.0, sizeof(FirmwareManifest_t), sign_ms, verify_ms);
+    TEST_ASSERT_TRUE(valid);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_patch_sizes);
+    RUN_TEST(test_benchmark_verify_cost);
+    return UNITY_END();
+}
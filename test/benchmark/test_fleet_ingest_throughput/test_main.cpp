@@ -0,0 +1,94 @@
+/**
+ * BINSAI Benchmark - Fleet Ingest Throughput
+ * Parse + state-table update cost per frame for a 10k-bin fleet, then an
+ * end-to-end UDP loopback run reporting throughput and p99 latency.
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+#include <TelemetryFrame.h>
+#include <FleetStore.h>
+#include <IngestServer.h>
+#include <LatencyHistogram.h>
+#include <LoadGenerator.h>
+
+#define BENCH_BINS          10000
+#define BENCH_ROUNDS        50
+
+static std::vector<uint8_t> frames;
+
+void setUp() {
+    frames.assign((size_t)BENCH_BINS * BENCH_ROUNDS * TELEMETRY_FRAME_SIZE, 0);
+    SensorData_t data;
+    memset(&data, 0, sizeof(data));
+    char id[TELEMETRY_DEVICE_ID_LEN + 1];
+    TelemetryFrameMeta_t meta;
+    memset(&meta, 0, sizeof(meta));
+    meta.device_id = id;
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        for (uint32_t bin = 0; bin < BENCH_BINS; bin++) {
+            loadGeneratorDeviceId(bin, id, sizeof(id));
+            data.fill_percentage = (float)((bin + round) % 100);
+            uint8_t* frame = &frames[((size_t)round * BENCH_BINS + bin) * TELEMETRY_FRAME_SIZE];
+            meta.sequence = round + 1;
+            telemetryEncode(data, meta, frame, TELEMETRY_FRAME_SIZE);
+        }
+    }
+}
+
+void tearDown() {}
+
+void test_benchmark_store_ingest() {
+    FleetStore store;
+    size_t total = (size_t)BENCH_BINS * BENCH_ROUNDS;
+    size_t accepted = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < total; i++) {
+        TelemetryFrameView view(&frames[i * TELEMETRY_FRAME_SIZE], TELEMETRY_FRAME_SIZE);
+        accepted += store.ingest(view, (uint32_t)i) <= FLEET_INGEST_NEW_BIN;
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    TEST_ASSERT_EQUAL(total, accepted);
+    TEST_ASSERT_EQUAL(BENCH_BINS, store.binCount());
+    printf("[BENCH] store ingest: %.1f ns/frame (%.2f M frames/s, %d bins, 1 thread)\n",
+           elapsed.count() / total, total * 1e3 / elapsed.count(), BENCH_BINS);
+}
+
+void test_benchmark_udp_loopback() {
+    FleetStore store;
+    IngestServer server(store);
+    TEST_ASSERT_TRUE(server.start(0, 2));
+
+    LoadGeneratorConfig_t config;
+    loadGeneratorDefaults(&config);
+    config.port = server.port();
+    config.duration_ms = 2000;
+    LoadGeneratorResult_t result = runLoadGenerator(config);
+    usleep(200000);
+    server.stop();
+
+    IngestStats_t stats = server.stats();
+    LatencyHistogram latency;
+    server.latency(&latency);
+
+    TEST_ASSERT_EQUAL(LOADGEN_DEFAULT_BINS, store.binCount());
+    printf("[BENCH] udp loopback: %u bins, %.0f frames/s ingested, %.2f%% lost\n", config.bin_count,
+           stats.accepted * 1000.0 / result.elapsed_ms,
+           100.0 * (result.frames_sent - stats.accepted) / result.frames_sent);
+    printf("[BENCH] udp loopback latency: p50=%u us p99=%u us max=%u us\n", latency.percentile(50),
+           latency.percentile(99), latency.max());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_store_ingest);
+    RUN_TEST(test_benchmark_udp_loopback);
+    return UNITY_END();
+}
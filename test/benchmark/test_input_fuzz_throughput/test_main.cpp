@@ -0,0 +1,342 @@
+/**
+ * BINSAI Benchmark - Input Fuzz Throughput
+ * Executions per second of each fuzz target on mutated seed inputs, and
+ * the slowest single input (re-timed to filter out preemption). A
+ * pathological slow path shows up as a worst case far above the median.
+ */
+
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <ConfigFields.h>
+#include <ConfigStore.h>
+#include <GprsLink.h>
+#include <ModemArbiter.h>
+#include <ProbeArray.h>
+#include <SerialConsole.h>
+#include <TextBuffer.h>
+#include <TimeService.h>
+#include <WasteClassifier.h>
+
+#define BENCH_INPUTS        20000
+#define BENCH_INPUT_MAX     256
+#define BENCH_SUSPECTS      16            // Slowest first-pass inputs re-timed
+#define BENCH_RETIMES       5
+#define BENCH_SLOW_INPUT_US 1000          // ~10-20 ms on the ESP32: a visible loop stall
+
+static const char* const MODEM_SEEDS[] = {
+    "\r\nOK\r\n",
+    "\r\nRDY\r\n\r\n+CFUN: 1\r\n\r\n+CPIN: READY\r\n\r\nCall Ready\r\n\r\nSMS Ready\r\n",
+    "\r\n+CREG: 0,1\r\n\r\nOK\r\n",
+    "\r\n+CCLK: \"26/10/19,19:00:00+28\"\r\n\r\nOK\r\n",
+    "\r\nOK\r\n\r\nCONNECT OK\r\n",
+    "\r\n> ",
+    "\r\nSEND OK\r\n",
+    "\r\n+PDP: DEACT\r\n",
+};
+
+static const char* const CONSOLE_SEEDS[] = {
+    "STATUS",
+    "SET wifi_ssid \"Kampus Wifi\"",
+    "SET critical_gas_threshold 800",
+    "ADCCAL ADD 1650",
+};
+
+static const char* const VALUE_SEEDS[] = { "BINSAI-YK-0042", "9.85", "1e38", "0x1F", "4294967295", "true" };
+
+typedef struct {
+    uint8_t data[BENCH_INPUT_MAX + 1];
+    size_t length;
+} BenchInput_t;
+
+static std::vector<BenchInput_t> inputs;
+static uint32_t fuzz_state;
+static volatile uint32_t sink;
+
+static uint32_t fuzzNext() {
+    fuzz_state ^= fuzz_state << 13;     // xorshift32
+    fuzz_state ^= fuzz_state >> 17;
+    fuzz_state ^= fuzz_state << 5;
+    return fuzz_state;
+}
+
+/**
+ * Seed with 1-4 byte mutations (flip, replace, insert, delete, truncate)
+ */
+static void mutateInputs(const char* const* seeds, size_t seed_count) {
+    inputs.resize(BENCH_INPUTS);
+    for (size_t n = 0; n < inputs.size(); n++) {
+        BenchInput_t& input = inputs[n];
+        const char* seed = seeds[fuzzNext() % seed_count];
+        input.length = strlen(seed);
+        memcpy(input.data, seed, input.length);
+        for (uint32_t m = 1 + fuzzNext() % 4; m > 0 && input.length > 0; m--) {
+            size_t at = fuzzNext() % input.length;
+            switch (fuzzNext() % 5) {
+                case 0: input.data[at] ^= (uint8_t)(1 << (fuzzNext() % 8)); break;
+                case 1: input.data[at] = (uint8_t)fuzzNext(); break;
+                case 2:
+                    if (input.length < BENCH_INPUT_MAX) {
+                        memmove(input.data + at + 1, input.data + at, input.length - at);
+                        input.data[at] = (uint8_t)fuzzNext();
+                        input.length++;
+                    }
+                    break;
+                case 3:
+                    memmove(input.data + at, input.data + at + 1, input.length - at - 1);
+                    input.length--;
+                    break;
+                default: input.length = at; break;
+            }
+        }
+        input.data[input.length] = '\0';
+    }
+}
+
+typedef uint32_t (*FuzzTarget_t)(const BenchInput_t& input);
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * Time every input, then re-time the BENCH_SUSPECTS slowest ones
+ * BENCH_RETIMES times each; an input's cost is the fastest of its re-runs
+ */
+static void benchTarget(const char* name, FuzzTarget_t target) {
+    std::vector<double> times(inputs.size());
+    std::vector<size_t> order(inputs.size());
+    uint32_t acc = 0;
+
+    std::chrono::steady_clock::time_point total = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < inputs.size(); i++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        acc += target(inputs[i]);
+        times[i] = secondsSince(start);
+        order[i] = i;
+    }
+    double elapsed = secondsSince(total);
+
+    std::sort(order.begin(), order.end(), [&times](size_t a, size_t b) { return times[a] > times[b]; });
+    double worst = 0.0;
+    size_t slowest = order[0];
+    for (size_t s = 0; s < BENCH_SUSPECTS; s++) {
+        double best = times[order[s]];
+        for (int r = 0; r < BENCH_RETIMES; r++) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            acc += target(inputs[order[s]]);
+            best = std::min(best, secondsSince(start));
+        }
+        if (best > worst) {
+            worst = best;
+            slowest = order[s];
+        }
+    }
+    std::sort(times.begin(), times.end());
+    sink = acc;
+
+    printf("[BENCH] fuzz %s execs=%u execs_per_s=%.0f median=%.2f us p99=%.2f us worst=%.2f us "
+           "(input %u, %u bytes)\n",
+           name, (unsigned)inputs.size(), inputs.size() / elapsed, times[times.size() / 2] * 1e6,
+           times[times.size() * 99 / 100] * 1e6, worst * 1e6, (unsigned)slowest,
+           (unsigned)inputs[slowest].length);
+    TEST_ASSERT_TRUE(worst * 1e6 < BENCH_SLOW_INPUT_US);
+}
+
+static uint32_t fuzzReplyMatch(const BenchInput_t& input) {
+    FixedText<64> window;
+    uint32_t matches = 0;
+    for (size_t i = 0; i < input.length; i++) {
+        window.pushRolling((char)input.data[i]);
+        matches += window.endsWith("OK") + window.endsWith("ERROR");
+    }
+    return matches;
+}
+
+static uint32_t fuzzCclk(const BenchInput_t& input) {
+    int64_t unix_ms = 0;
+    return timeParseCclk((const char*)input.data, &unix_ms) ? (uint32_t)unix_ms : 0;
+}
+
+/**
+ * Modem port replaying one input, then silent
+ */
+class ReplayModemPort : public ModemPort {
+public:
+    const uint8_t* data;
+    size_t remaining;
+
+    size_t write(const uint8_t* bytes, size_t length) override {
+        (void)bytes;
+        return length;
+    }
+
+    size_t read(uint8_t* buffer, size_t capacity) override {
+        size_t count = remaining < capacity ? remaining : capacity;
+        memcpy(buffer, data, count);
+        data += count;
+        remaining -= count;
+        return count;
+    }
+};
+
+static uint32_t fuzzGprsReplies(const BenchInput_t& input) {
+    ReplayModemPort port;
+    port.data = input.data;
+    port.remaining = 0;
+    ModemArbiter arbiter;
+    GprsLinkConfig_t config;
+    gprsLinkDefaults(&config);
+    config.host = "fleet.example";
+    config.port = 47100;
+    GprsLink link(port, arbiter, config);
+
+    link.open(0);
+    link.loop(0);                       // AT+CIPSHUT written
+    port.remaining = input.length;
+    link.loop(10);
+    return (uint32_t)link.state();
+}
+
+static uint32_t console_dispatches;
+
+static void handleBenchCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    (void)argv;
+    (void)out;
+    console_dispatches += argc;
+}
+
+class NullOutput : public ConsoleOutput {
+public:
+    void write(const char* data, size_t length) override {
+        (void)data;
+        (void)length;
+    }
+};
+
+static constexpr ConsoleCommand_t BENCH_COMMANDS[] = {
+    CONSOLE_COMMAND("STATUS", 0, "STATUS", handleBenchCommand),
+    CONSOLE_COMMAND("SET",    2, "SET <field> <value>", handleBenchCommand),
+    CONSOLE_COMMAND("ADCCAL", 0, "ADCCAL [ADD <mV> | SAVE | CLEAR]", handleBenchCommand),
+};
+
+static NullOutput null_output;
+static SerialConsole console(BENCH_COMMANDS, sizeof(BENCH_COMMANDS) / sizeof(BENCH_COMMANDS[0]), null_output);
+
+static uint32_t fuzzConsoleLine(const BenchInput_t& input) {
+    for (size_t i = 0; i < input.length; i++) {
+        console.feed((char)input.data[i]);
+    }
+    console.feed('\n');
+    return console_dispatches;
+}
+
+static uint32_t fuzzConfigField(const BenchInput_t& input) {
+    static SystemConfig_t config;
+    uint32_t stored = 0;
+    for (uint8_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        stored += configFieldSet(&config, &CONFIG_FIELDS[i], (const char*)input.data);
+    }
+    return stored;
+}
+
+/**
+ * Both slots hold the input as a blob (header bytes included)
+ */
+class InputConfigBackend : public ConfigStorageBackend {
+public:
+    const BenchInput_t* input;
+
+    size_t readSlot(uint8_t slot, void* buffer, size_t capacity) override {
+        (void)slot;
+        size_t n = input->length < capacity ? input->length : capacity;
+        memcpy(buffer, input->data, n);
+        return n;
+    }
+
+    bool writeSlot(uint8_t slot, const void* data, size_t length) override {
+        (void)slot;
+        (void)data;
+        (void)length;
+        return false;
+    }
+};
+
+static uint32_t fuzzConfigLoad(const BenchInput_t& input) {
+    InputConfigBackend backend;
+    backend.input = &input;
+    ConfigStore store(backend);
+    SystemConfig_t config;
+    memset(&config, 0, sizeof(config));
+    return (uint32_t)store.load(&config);
+}
+
+static float inputFloat(const BenchInput_t& input, size_t offset) {
+    uint8_t bytes[4] = { 0, 0, 0, 0 };
+    for (size_t i = 0; i < 4 && offset + i < input.length; i++) bytes[i] = input.data[offset + i];
+    float value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+static uint32_t fuzzFillAndClassify(const BenchInput_t& input) {
+    static HysteresisClassifier classifier;
+    uint32_t acc = 0;
+    for (size_t offset = 0; offset < input.length; offset += 4) {
+        float fill = probeFillPercentage(inputFloat(input, offset), 40.0f);
+        acc += classifier.update(fill, (uint32_t)offset * 2000) + (uint32_t)fill;
+    }
+    return acc;
+}
+
+void setUp() {
+    fuzz_state = 0x9E3779B9UL;
+}
+
+void tearDown() {}
+
+void test_benchmark_modem_targets() {
+    mutateInputs(MODEM_SEEDS, sizeof(MODEM_SEEDS) / sizeof(MODEM_SEEDS[0]));
+    benchTarget("reply_match", fuzzReplyMatch);
+    benchTarget("cclk_parse", fuzzCclk);
+    benchTarget("gprs_replies", fuzzGprsReplies);
+}
+
+void test_benchmark_console_and_config_targets() {
+    mutateInputs(CONSOLE_SEEDS, sizeof(CONSOLE_SEEDS) / sizeof(CONSOLE_SEEDS[0]));
+    benchTarget("console_line", fuzzConsoleLine);
+    mutateInputs(VALUE_SEEDS, sizeof(VALUE_SEEDS) / sizeof(VALUE_SEEDS[0]));
+    benchTarget("config_field_set", fuzzConfigField);
+
+    // Blob-shaped inputs: a real header followed by mutated payload bytes
+    mutateInputs(VALUE_SEEDS, sizeof(VALUE_SEEDS) / sizeof(VALUE_SEEDS[0]));
+    ConfigBlobHeader_t header = { CONFIG_BLOB_MAGIC, CONFIG_SCHEMA_VERSION, 0, 1, 0 };
+    for (size_t n = 0; n < inputs.size(); n++) {
+        BenchInput_t& input = inputs[n];
+        size_t payload = input.length < BENCH_INPUT_MAX - sizeof(header) ? input.length
+                                                                          : BENCH_INPUT_MAX - sizeof(header);
+        memmove(input.data + sizeof(header), input.data, payload);
+        header.payload_length = (uint16_t)payload;
+        header.crc32 = (n % 2) ? configCrc32(input.data + sizeof(header), payload) : 0;
+        memcpy(input.data, &header, sizeof(header));
+        input.length = sizeof(header) + payload;
+    }
+    benchTarget("config_load", fuzzConfigLoad);
+}
+
+void test_benchmark_fill_and_classify_target() {
+    mutateInputs(VALUE_SEEDS, sizeof(VALUE_SEEDS) / sizeof(VALUE_SEEDS[0]));
+    benchTarget("fill_classify", fuzzFillAndClassify);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_modem_targets);
+    RUN_TEST(test_benchmark_console_and_config_targets);
+    RUN_TEST(test_benchmark_fill_and_classify_target);
+    return UNITY_END();
+}
@@ -0,0 +1,72 @@
+/**
+ * BINSAI Benchmark - LoRa Channel Capacity
+ * Payload size and time on air per encoding, then delivery ratio for a
+ * growing fleet at SF7/SF9/SF12 and 10 / 15 minute reporting intervals.
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <LoraAirtime.h>
+#include <LoraUplink.h>
+#include <TelemetryFrame.h>
+
+void setUp() {}
+void tearDown() {}
+
+void test_benchmark_payload_airtime() {
+    const size_t sizes[] = { sizeof(SensorData_t), TELEMETRY_FRAME_SIZE, LORA_UPLINK_ANCHOR_SIZE, LORA_UPLINK_STATUS_SIZE };
+    const char* labels[] = { "SensorData_t (raw)", "TelemetryFrame", "LoRa anchor", "LoRa status" };
+    LoraRadioConfig_t radio;
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        printf("[BENCH] %-20s %3zu B:", labels[i], sizes[i]);
+        for (uint8_t sf = 7; sf <= 12; sf++) {
+            loraRadioDefaults(&radio, sf);
+            printf(" SF%u %7.1f ms", sf, loraAirtimeMs(radio, sizes[i]));
+        }
+        printf("\n");
+    }
+
+    loraRadioDefaults(&radio, 12);
+    TEST_ASSERT_TRUE(loraAirtimeMs(radio, LORA_UPLINK_STATUS_SIZE) < loraAirtimeMs(radio, TELEMETRY_FRAME_SIZE) / 2);
+}
+
+void test_benchmark_fleet_delivery_ratio() {
+    const uint32_t fleet_sizes[] = { 100, 500, 1000, 2000, 5000 };
+    const uint8_t spreading_factors[] = { 7, 9, 12 };
+    const uint32_t intervals_s[] = { 600, 900 };
+    uint64_t simulated = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t s = 0; s < sizeof(spreading_factors); s++) {
+        for (size_t k = 0; k < sizeof(intervals_s) / sizeof(intervals_s[0]); k++) {
+            printf("[BENCH] SF%-2u every %4us, 2 ch:", spreading_factors[s], intervals_s[k]);
+            for (size_t f = 0; f < sizeof(fleet_sizes) / sizeof(fleet_sizes[0]); f++) {
+                LoraSimConfig_t config;
+                loraSimDefaults(&config);
+                loraRadioDefaults(&config.radio, spreading_factors[s]);
+                config.bins = fleet_sizes[f];
+                config.interval_s = intervals_s[k];
+
+                LoraSimResult_t result = loraSimulateChannel(config);
+                simulated += result.transmissions;
+                printf("  %4u bins %5.1f%%", fleet_sizes[f], result.delivery_ratio * 100.0);
+                TEST_ASSERT_EQUAL_UINT64(result.transmissions, result.delivered + result.collided);
+            }
+            printf("\n");
+        }
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    printf("[BENCH] simulated %llu uplinks (24 h each) in %.0f ms (%.1f M uplinks/s)\n",
+           (unsigned long long)simulated, elapsed.count(), simulated / elapsed.count() / 1e3);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_payload_airtime);
+    RUN_TEST(test_benchmark_fleet_delivery_ratio);
+    return UNITY_END();
+}
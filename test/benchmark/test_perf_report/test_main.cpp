@@ -0,0 +1,227 @@
+/**
+ * BINSAI Benchmark - Performance Report (host)
+ * The CPU side of each firmware path the ESP32 BENCH command times on real
+ * hardware: burst reduction and fill of an ultrasonic read, ADC / RS
+ * conversion of a gas read, AT reply matching, telemetry encoding for a
+ * publish and LCD screen formatting. Emits the same binsai-perf JSON report
+ * as the firmware, so two builds compare with
+ *   binsai-fleet perf-compare old.log new.log
+ * BINSAI_PERF_FIRMWARE labels the report, BINSAI_PERF_REPORT also writes
+ * it to that file.
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <AdcCalibration.h>
+#include <EnvCompensation.h>
+#include <PerfBench.h>
+#include <PerfCompare.h>
+#include <ProbeArray.h>
+#include <RuntimeMetrics.h>
+#include <TelemetryFrame.h>
+#include <TextBuffer.h>
+#include <UltrasonicBurst.h>
+
+#define BENCH_ITERATIONS    200
+#define BENCH_WARMUP        10
+#define BENCH_BIN_HEIGHT_CM 100.0f
+#define BENCH_PINGS         7
+
+static uint32_t samples_ns[BENCH_ITERATIONS];
+static std::string report_text;
+static volatile uint32_t bench_sink = 0;    // Keeps results observable
+static uint32_t bench_round = 0;            // Varies inputs between calls
+
+static void collectLine(const char* line, size_t length, void* context) {
+    (void)context;
+    printf("%s\n", line);
+    report_text.append(line, length).append("\n");
+}
+
+// ============================================================================
+// Cases
+// ============================================================================
+
+static bool ultrasonicEstimateCase(void* context) {
+    (void)context;
+    uint32_t echo_us[BENCH_PINGS];
+    for (uint8_t i = 0; i < BENCH_PINGS; i++) {
+        echo_us[i] = 2900 + ((bench_round * 7 + i * 13) % 40);
+    }
+    echo_us[3] = 900;                       // One cross-talk echo
+    bench_round++;
+
+    BurstEstimate_t estimate;
+    if (!burstEstimate(echo_us, BENCH_PINGS, 0.0346f, 400.0f, &estimate)) {
+        return false;
+    }
+    float fill = probeFillPercentage(estimate.distance_cm, BENCH_BIN_HEIGHT_CM);
+    bench_sink = bench_sink + (uint32_t)fill;
+    return true;
+}
+
+static bool gasConvertCase(void* context) {
+    const AdcLut_t* lut = (const AdcLut_t*)context;
+    static EnvCompensation_t env;
+    static bool env_ready = false;
+    if (!env_ready) {
+        envInit(&env);
+        envUpdate(&env, 31.0f, 78.0f, 0);
+        env_ready = true;
+    }
+
+    uint16_t raw = (uint16_t)(1200 + (bench_round++ % 900));
+    uint16_t mv = adcLutMillivolts(lut, raw);
+    float rs = 10.0f * (3300.0f - mv) / (mv > 0 ? mv : 1);
+    bench_sink = bench_sink + (uint32_t)envCompensateRs(&env, rs);
+    return true;
+}
+
+static bool gsmReplyMatchCase(void* context) {
+    (void)context;
+    static const char REPLY[] = "AT+CSQ\r\r\n+CSQ: 17,0\r\n\r\nOK\r\n";
+    FixedText<64> window;
+    for (size_t i = 0; i < sizeof(REPLY) - 1; i++) {
+        window.pushRolling(REPLY[i]);
+        if (window.endsWith("OK")) {
+            bench_sink = bench_sink + (uint32_t)i;
+            return true;
+        }
+        if (window.endsWith("ERROR")) {
+            return false;
+        }
+    }
+    return false;
+}
+
+static bool telemetryEncodeCase(void* context) {
+    SensorData_t* data = (SensorData_t*)context;
+    data->fill_percentage = (float)(bench_round % 100);
+    data->timestamp_unix = 1792400000UL + bench_round;
+
+    TelemetryFrameMeta_t meta;
+    memset(&meta, 0, sizeof(meta));
+    meta.device_id = "BINSAI-001";
+    meta.sequence = bench_round++;
+
+    uint8_t frame[TELEMETRY_FRAME_SIZE];
+    size_t length = telemetryEncode(*data, meta, frame, sizeof(frame));
+    bench_sink = bench_sink + frame[length - 1];
+    return length == TELEMETRY_FRAME_SIZE;
+}
+
+static bool lcdFormatCase(void* context) {
+    (void)context;
+    static const char* const LEVELS[] = {"EMPTY", "HALF", "ALMOST", "FULL"};
+    float fill = (float)(bench_round % 100);
+    float ppm = 120.0f + (bench_round % 300);
+    bench_round++;
+
+    // The four rotating screens, two 16-column rows each
+    FixedText<17> rows[8];
+    rows[0].append("Capacity:");
+    rows[1].appendFixed(fill, 0).append("% ").append(LEVELS[(uint32_t)fill / 25]);
+    rows[2].append("Gas Level:");
+    rows[3].appendFixed(ppm, 0).append(" ppm ").append("ORGANIC L1");
+    rows[4].append("System Status");
+    rows[5].append("GPS:").append("OK").append(" SMS:").append("ON");
+    rows[6].append("Device:");
+    rows[7].append("BINSAI-001");
+    for (uint8_t i = 0; i < 8; i++) {
+        bench_sink = bench_sink + (uint32_t)rows[i].length();
+    }
+    return true;
+}
+
+static bool loopScopeCase(void* context) {
+    METRIC_TIME_SCOPE(*(MetricHistogram*)context);
+    bench_sink = bench_sink + 1;
+    return true;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_benchmark_perf_report() {
+    AdcLut_t lut;
+    adcLutLinear(&lut, 3300);
+
+    SensorData_t data;
+    memset(&data, 0, sizeof(data));
+    data.distance_cm = 42.0f;
+    data.ppm_calculated = 180.0f;
+
+    MetricsRegistry registry;
+    MetricHistogram loop_us(registry, "loop_us");
+
+    typedef struct {
+        const char* name;
+        PerfBenchCase_t fn;
+        void* context;
+        uint32_t batch;                     // ~100 us per sample on the host
+    } BenchCase_t;
+    const BenchCase_t cases[] = {
+        {"ultrasonic_estimate", ultrasonicEstimateCase, NULL, 500},
+        {"gas_convert", gasConvertCase, &lut, 4000},
+        {"gsm_reply_match", gsmReplyMatchCase, NULL, 500},
+        {"telemetry_encode", telemetryEncodeCase, &data, 2000},
+        {"lcd_format", lcdFormatCase, NULL, 500},
+        {"loop_scope", loopScopeCase, &loop_us, 2000},
+    };
+    const size_t case_count = sizeof(cases) / sizeof(cases[0]);
+
+    const char* firmware = getenv("BINSAI_PERF_FIRMWARE");
+    PerfReportHeader_t header = {firmware ? firmware : "host-dev", "host", "benchmark"};
+    PerfReportWriter writer(collectLine, NULL);
+    PerfBench bench(samples_ns, BENCH_ITERATIONS);
+
+    writer.begin(header);
+    for (size_t i = 0; i < case_count; i++) {
+        PerfBenchStats_t stats;
+        TEST_ASSERT_TRUE(bench.run(cases[i].fn, cases[i].context, BENCH_ITERATIONS, BENCH_WARMUP,
+                                   cases[i].batch, &stats));
+        TEST_ASSERT_EQUAL_UINT32(0, stats.failures);
+        writer.add(cases[i].name, stats);
+    }
+    writer.end();
+
+    // The report reads back and is clean against itself
+    PerfReport_t report;
+    std::string error;
+    TEST_ASSERT_TRUE_MESSAGE(perfReportParse(report_text.data(), report_text.size(), &report, &error),
+                             error.c_str());
+    TEST_ASSERT_EQUAL_size_t(case_count, report.cases.size());
+    for (size_t i = 0; i < report.cases.size(); i++) {
+        const PerfBenchStats_t& stats = report.cases[i].stats;
+        TEST_ASSERT_EQUAL_UINT32(BENCH_ITERATIONS, stats.samples);
+        printf("[BENCH] %-20s p50 %8.1f ns  p99 %8.1f ns\n", report.cases[i].name.c_str(),
+               stats.p50_us * 1000.0f, stats.p99_us * 1000.0f);
+    }
+    PerfCompareConfig_t config;
+    perfCompareDefaults(&config, "host");
+    std::vector<PerfComparison_t> results;
+    TEST_ASSERT_EQUAL_size_t(0, perfCompare(report, report, config, &results));
+
+    const char* path = getenv("BINSAI_PERF_REPORT");
+    if (path) {
+        FILE* file = fopen(path, "w");
+        TEST_ASSERT_NOT_NULL(file);
+        fwrite(report_text.data(), 1, report_text.size(), file);
+        fclose(file);
+        printf("[BENCH] report written to %s\n", path);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_perf_report);
+    return UNITY_END();
+}
@@ -0,0 +1,204 @@
+/**
+ * BINSAI Benchmark - Research Logger Flash Cost
+ * One week of research records (1 per minute) written to a modeled
+ * LittleFS-on-SPI-NOR partition: data is programmed in 256 B pages, a
+ * sync programs the partial tail page (programmed again once it fills)
+ * plus one metadata page, and every 16 pages cost one 4 KB sector erase.
+ * Compares per-record CSV / binary appends with fsync (what a plain
+ * File.print + flush logger does) against the staged block writer at
+ * several policies: flash bytes and write amplification per record,
+ * records at risk on a power cut and the sustained record rate the flash
+ * allows. Host encode + CRC cost is also timed (ESP32 estimated at 15x).
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <ResearchLogger.h>
+
+#define RECORDS                 10080       // One week at 1 per minute
+#define INTERVAL_MS             60000
+#define PAGE_SIZE               256
+#define PAGES_PER_SECTOR        16
+#define PAGE_PROGRAM_US         700         // Typical SPI NOR page program
+#define SECTOR_ERASE_US         45000       // Typical 4 KB sector erase
+#define THROUGHPUT_RECORDS      2000000
+#define ESP32_SLOWDOWN          15.0
+
+/**
+ * Counts page programs of a LittleFS-like file system; keeps no data
+ */
+class FlashModelBackend : public ResearchLogBackend {
+public:
+    uint64_t data_pages;
+    uint64_t metadata_pages;
+    uint32_t tail_bytes;            // Bytes in the current (unprogrammed) page
+    uint32_t size;
+    bool open;
+
+    FlashModelBackend() : data_pages(0), metadata_pages(0), tail_bytes(0), size(0), open(false) {}
+
+    bool fileRange(uint32_t*, uint32_t*) { return false; }
+    uint32_t fileSize(uint32_t) { return size; }
+    bool readFile(uint32_t, uint32_t, void*, size_t) { return false; }
+
+    bool openAppend(uint32_t) {
+        open = true;
+        size = 0;
+        tail_bytes = 0;
+        metadata_pages++;           // Directory entry
+        return true;
+    }
+
+    bool append(const void*, size_t length) {
+        size += (uint32_t)length;
+        tail_bytes += (uint32_t)length;
+        data_pages += tail_bytes / PAGE_SIZE;
+        tail_bytes %= PAGE_SIZE;
+        return true;
+    }
+
+    bool sync() {
+        if (tail_bytes > 0) data_pages++;   // Partial page now, again once full
+        metadata_pages++;
+        return true;
+    }
+
+    void close() {
+        if (open) sync();
+        open = false;
+    }
+
+    bool removeFile(uint32_t) {
+        metadata_pages++;
+        return true;
+    }
+
+    uint64_t programmedBytes() const {
+        return (data_pages + metadata_pages) * PAGE_SIZE;
+    }
+
+    double flashSeconds() const {
+        uint64_t pages = data_pages + metadata_pages;
+        return (pages * (double)PAGE_PROGRAM_US + pages * (double)SECTOR_ERASE_US / PAGES_PER_SECTOR) / 1e6;
+    }
+};
+
+static ResearchLogRecord_t sample(uint32_t i) {
+    ResearchLogRecord_t record;
+    memset(&record, 0, sizeof(record));
+    record.millis = i * INTERVAL_MS;
+    record.unix_ms = 1792411200000LL + (int64_t)i * INTERVAL_MS;
+    record.distance_cm = 10.0f + (i % 300) / 10.0f;
+    record.fill_percentage = 100.0f - record.distance_cm * 2.0f;
+    record.ppm_calculated = 400.0f + (i % 97);
+    record.adc_raw = (uint16_t)(1500 + i % 700);
+    record.gps_fix = true;
+    record.latitude = -7.7956123;
+    record.longitude = 110.3694881;
+    record.satellite_count = 8;
+    record.capacity_level = 2;
+    record.waste_classification = 1;
+    record.priority_level = 2;
+    record.hours_to_full = 17.3f;
+    return record;
+}
+
+/**
+ * Same columns as the firmware [RESEARCH] line
+ */
+static int formatCsv(const ResearchLogRecord_t& r, char* line, size_t capacity) {
+    return snprintf(line, capacity, "%lu,%.2f,%.2f,%.2f,%u,%u,%.6f,%.6f,%u,%u,%u,%u,%.1f,%lld\r\n",
+                    (unsigned long)r.millis, r.distance_cm, r.fill_percentage, r.ppm_calculated, r.adc_raw,
+                    r.gps_fix ? 1 : 0, r.latitude, r.longitude, r.satellite_count, r.capacity_level,
+                    r.waste_classification, r.priority_level, r.hours_to_full, (long long)r.unix_ms);
+}
+
+static void report(const char* name, const FlashModelBackend& flash, uint32_t at_risk) {
+    double per_record = (double)flash.programmedBytes() / RECORDS;
+    printf("[BENCH] %-20s %6.1f B flash/record, amplification %5.2fx, at risk %2u records, "
+           "flash-bound %6.0f records/s\n",
+           name, per_record, per_record / RESEARCH_LOG_RECORD_SIZE, at_risk, RECORDS / flash.flashSeconds());
+}
+
+static FlashModelBackend runPerRecord(bool csv) {
+    FlashModelBackend flash;
+    flash.openAppend(0);
+    char line[160];
+    uint8_t encoded[RESEARCH_LOG_RECORD_SIZE];
+    for (uint32_t i = 0; i < RECORDS; i++) {
+        ResearchLogRecord_t record = sample(i);
+        if (csv) {
+            flash.append(line, (size_t)formatCsv(record, line, sizeof(line)));
+        } else {
+            researchLogEncodeRecord(record, encoded);
+            flash.append(encoded, sizeof(encoded));
+        }
+        flash.sync();
+    }
+    return flash;
+}
+
+static FlashModelBackend runLogger(uint8_t sync_blocks, uint32_t flush_interval_ms) {
+    FlashModelBackend flash;
+    ResearchLogger logger(flash);
+    ResearchLogConfig_t config = { 65536, 1048576, sync_blocks, flush_interval_ms };
+    logger.begin(config);
+    for (uint32_t i = 0; i < RECORDS; i++) {
+        uint32_t now = i * INTERVAL_MS;
+        logger.append(sample(i), now);
+        logger.loop(now);
+    }
+    logger.flush();
+    TEST_ASSERT_EQUAL_UINT32(RECORDS, logger.stats().records_written);
+    return flash;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_benchmark_flash_cost() {
+    FlashModelBackend csv = runPerRecord(true);
+    FlashModelBackend binary = runPerRecord(false);
+    report("csv + fsync/record", csv, 0);
+    report("bin + fsync/record", binary, 0);
+
+    FlashModelBackend block = runLogger(1, 0);
+    FlashModelBackend batched = runLogger(8, 0);
+    FlashModelBackend firmware = runLogger(1, 600000);
+    report("block, sync 1", block, RESEARCH_LOG_BLOCK_RECORDS - 1);
+    report("block, sync 8", batched, 8 * RESEARCH_LOG_BLOCK_RECORDS - 1);
+    report("block, 10 min flush", firmware, 10);
+
+    TEST_ASSERT_TRUE(block.programmedBytes() * 5 < binary.programmedBytes());
+    TEST_ASSERT_TRUE(firmware.programmedBytes() * 5 < binary.programmedBytes());
+    TEST_ASSERT_TRUE(batched.programmedBytes() < block.programmedBytes());
+    TEST_ASSERT_TRUE((double)firmware.programmedBytes() / RECORDS < 2.5 * RESEARCH_LOG_RECORD_SIZE);
+}
+
+void test_benchmark_encode_throughput() {
+    FlashModelBackend flash;
+    ResearchLogger logger(flash);
+    ResearchLogConfig_t config = { 65536, 1048576, 1, 0 };
+    logger.begin(config);
+    ResearchLogRecord_t record = sample(1);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < THROUGHPUT_RECORDS; i++) {
+        record.millis = i;
+        logger.append(record, i);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double host_rate = THROUGHPUT_RECORDS / seconds;
+    printf("[BENCH] encode + CRC: %.2f M records/s host, ~%.0f k records/s ESP32 (%.1f us/record)\n",
+           host_rate / 1e6, host_rate / ESP32_SLOWDOWN / 1e3, ESP32_SLOWDOWN * 1e6 / host_rate);
+    TEST_ASSERT_EQUAL_UINT32(THROUGHPUT_RECORDS / RESEARCH_LOG_BLOCK_RECORDS, logger.stats().blocks);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_flash_cost);
+    RUN_TEST(test_benchmark_encode_throughput);
+    return UNITY_END();
+}
@@ -0,0 +1,65 @@
+/**
+ * BINSAI Benchmark - Route Planner Scaling
+ * Plans deterministic synthetic cities of 50, 500 and 5,000 bins and
+ * reports phase timings, fleet size and the gain of 2-opt/Or-opt over the
+ * raw savings routes, single-threaded and on all cores.
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+#include <RoutePlanner.h>
+
+#define BENCH_SEED          20260112UL
+
+static void benchmarkCity(uint32_t bins) {
+    std::vector<RouteStop_t> stops;
+    routeSyntheticCity(bins, BENCH_SEED, &stops);
+
+    RoutePlannerConfig_t config;
+    routePlannerDefaults(&config);
+
+    unsigned cores = std::thread::hardware_concurrency();
+    unsigned thread_counts[2] = {1, cores ? cores : 1};
+    double lengths[2];
+
+    for (int t = 0; t < 2; t++) {
+        config.thread_count = thread_counts[t];
+        RoutePlan_t plan = RoutePlanner(config).plan(stops);
+        lengths[t] = plan.total_length_m;
+
+        printf("[BENCH] route %5u bins, %2u threads: graph %.2f ms, savings %.2f ms, improve %.2f ms | "
+               "%zu trucks, %.1f km (savings only %.1f km, -%.1f%%), %zu edges\n",
+               bins, thread_counts[t], plan.graph_ms, plan.savings_ms, plan.improve_ms,
+               plan.routes.size(), plan.total_length_m / 1000.0, plan.savings_length_m / 1000.0,
+               100.0 * (plan.savings_length_m - plan.total_length_m) / plan.savings_length_m,
+               plan.graph_edges);
+        TEST_ASSERT_TRUE(plan.total_length_m <= plan.savings_length_m);
+    }
+    TEST_ASSERT_TRUE(lengths[0] == lengths[1]);
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_benchmark_route_50() {
+    benchmarkCity(50);
+}
+
+void test_benchmark_route_500() {
+    benchmarkCity(500);
+}
+
+void test_benchmark_route_5000() {
+    benchmarkCity(5000);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_route_50);
+    RUN_TEST(test_benchmark_route_500);
+    RUN_TEST(test_benchmark_route_5000);
+    return UNITY_END();
+}
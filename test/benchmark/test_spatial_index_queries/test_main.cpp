@@ -0,0 +1,113 @@
+/**
+ * BINSAI Benchmark - Spatial Index Queries
+ * 100k bins over a ~22 km square: insert and move throughput, 1 km radius
+ * and 10-NN query latency, compared with a linear scan.
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+#include <SpatialIndex.h>
+
+#define BENCH_POINTS        100000
+#define BENCH_QUERIES       2000
+#define BENCH_RADIUS_M      1000.0
+#define CITY_LATITUDE       -7.7956
+#define CITY_LONGITUDE      110.3695
+
+static std::vector<SpatialPoint_t> points;
+static std::vector<SpatialPoint_t> queries;
+static volatile size_t sink;
+
+static double randomUnit(uint32_t* seed) {
+    *seed = *seed * 1664525UL + 1013904223UL;
+    return (double)(*seed >> 8) / (double)(1UL << 24);
+}
+
+static SpatialPoint_t randomPoint(uint64_t id, uint32_t* seed) {
+    SpatialPoint_t point;
+    point.id = id;
+    point.latitude = CITY_LATITUDE + (randomUnit(seed) - 0.5) * 0.2;
+    point.longitude = CITY_LONGITUDE + (randomUnit(seed) - 0.5) * 0.2;
+    point.zone = (uint8_t)(id % 14 + 1);
+    point.priority = (uint8_t)(id % 4);
+    return point;
+}
+
+static double elapsedNs(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void setUp() {
+    uint32_t seed = 2026;
+    points.clear();
+    queries.clear();
+    for (uint64_t id = 0; id < BENCH_POINTS; id++) points.push_back(randomPoint(id, &seed));
+    for (uint64_t q = 0; q < BENCH_QUERIES; q++) queries.push_back(randomPoint(q, &seed));
+}
+
+void tearDown() {}
+
+void test_benchmark_spatial_index() {
+    SpatialIndex index;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < points.size(); i++) index.upsert(points[i]);
+    double insert_ns = elapsedNs(start) / points.size();
+
+    // Re-report every bin with ~30 m of GPS drift (mostly same-cell updates)
+    uint32_t seed = 77;
+    for (size_t i = 0; i < points.size(); i++) {
+        points[i].latitude += (randomUnit(&seed) - 0.5) * 0.0005;
+        points[i].longitude += (randomUnit(&seed) - 0.5) * 0.0005;
+    }
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < points.size(); i++) index.upsert(points[i]);
+    double update_ns = elapsedNs(start) / points.size();
+
+    std::vector<SpatialHit_t> hits;
+    size_t total_hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t q = 0; q < queries.size(); q++) {
+        total_hits += index.withinRadius(queries[q].latitude, queries[q].longitude, BENCH_RADIUS_M, 3, &hits);
+    }
+    double radius_ns = elapsedNs(start) / queries.size();
+
+    start = std::chrono::steady_clock::now();
+    for (size_t q = 0; q < queries.size(); q++) {
+        sink = index.nearest(queries[q].latitude, queries[q].longitude, 10, 0, &hits);
+    }
+    double knn_ns = elapsedNs(start) / queries.size();
+
+    // Linear scan reference for the same radius query
+    size_t linear_hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t q = 0; q < 200; q++) {
+        for (size_t i = 0; i < points.size(); i++) {
+            if (points[i].priority >= 3 &&
+                SpatialIndex::distanceMetres(queries[q].latitude, queries[q].longitude,
+                                             points[i].latitude, points[i].longitude) <= BENCH_RADIUS_M) {
+                linear_hits++;
+            }
+        }
+    }
+    double linear_ns = elapsedNs(start) / 200;
+
+    TEST_ASSERT_EQUAL(BENCH_POINTS, index.size());
+    TEST_ASSERT_TRUE(total_hits > 0);
+    sink = linear_hits;
+
+    printf("[BENCH] spatial %d points: insert %.0f ns, move %.0f ns (%.2f M updates/s)\n", BENCH_POINTS,
+           insert_ns, update_ns, 1e3 / update_ns);
+    printf("[BENCH] spatial radius 1 km (critical only): %.1f us/query, %.1f hits avg; linear scan %.1f us (%.0fx)\n",
+           radius_ns / 1e3, (double)total_hits / queries.size(), linear_ns / 1e3, linear_ns / radius_ns);
+    printf("[BENCH] spatial 10-NN: %.1f us/query\n", knn_ns / 1e3);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_spatial_index);
+    return UNITY_END();
+}
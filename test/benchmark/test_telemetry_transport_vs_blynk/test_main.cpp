@@ -0,0 +1,229 @@
+/**
+ * BINSAI Benchmark - Telemetry Transport vs Blynk
+ * Bytes on the wire and publish latency per 2 s sample: the Blynk path
+ * (14 virtualWrite() calls, one TLS record each) vs one QoS 1 MQTT
+ * publish of a TelemetryFrame, over the same modelled uplink.
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <MqttClient.h>
+#include <MqttLoopbackBroker.h>
+#include <TelemetryTransport.h>
+
+#define BENCH_SAMPLES       1800            // One hour at INTERVAL_SENSOR_READ_MS
+#define BENCH_INTERVAL_MS   2000
+#define BENCH_ONE_WAY_MS    60              // Device -> cloud broker
+#define BENCH_BITS_PER_MS   1000            // 1 Mbit/s effective uplink
+#define BLYNK_HEADER_SIZE   5               // cmd, msg id (2), length (2)
+
+static SensorData_t sample;
+
+void setUp() {
+    memset(&sample, 0, sizeof(sample));
+    sample.fill_percentage = 67.0f;
+    sample.distance_cm = 12.21f;
+    sample.capacity_level = 2;
+    sample.ppm_calculated = 212.0f;
+    sample.priority_level = 2;
+    sample.waste_classification = 2;
+    sample.hours_to_full = 17.25f;
+    sample.latitude = -7.7956123;
+    sample.longitude = 110.3694876;
+}
+
+void tearDown() {}
+
+/**
+ * One Blynk hardware message: header + "vw\0<pin>\0<value>"
+ */
+static size_t blynkWriteSize(int pin, const char* value) {
+    char pin_text[8];
+    snprintf(pin_text, sizeof(pin_text), "%d", pin);
+    return BLYNK_HEADER_SIZE + 3 + strlen(pin_text) + 1 + strlen(value);
+}
+
+/**
+ * Application bytes of each virtualWrite() in updateBlynkVirtualPins(),
+ * formatted as BlynkParam does (float 3 decimals, double 7)
+ */
+static size_t blynkSampleWrites(size_t* sizes) {
+    char value[32];
+    size_t count = 0;
+
+    snprintf(value, sizeof(value), "%d", (int)sample.fill_percentage);
+    sizes[count++] = blynkWriteSize(0, value);
+    snprintf(value, sizeof(value), "%.3f", sample.distance_cm);
+    sizes[count++] = blynkWriteSize(5, value);
+    for (int pin = 1; pin <= 4; pin++) {
+        sizes[count++] = blynkWriteSize(pin, pin == 2 ? "255" : "0");
+    }
+    snprintf(value, sizeof(value), "%d", (int)sample.ppm_calculated);
+    sizes[count++] = blynkWriteSize(10, value);
+    sizes[count++] = blynkWriteSize(11, "2");
+    sizes[count++] = blynkWriteSize(12, "ORGANIC L1");
+    sizes[count++] = blynkWriteSize(13, "Prepare special bags and compartments");
+    snprintf(value, sizeof(value), "%.3f", sample.hours_to_full);
+    sizes[count++] = blynkWriteSize(14, value);
+    snprintf(value, sizeof(value), "%.7f", sample.latitude);
+    sizes[count++] = blynkWriteSize(20, value);
+    snprintf(value, sizeof(value), "%.7f", sample.longitude);
+    sizes[count++] = blynkWriteSize(21, value);
+    sizes[count++] = blynkWriteSize(6, "ALMOST FULL");
+    return count;
+}
+
+typedef struct {
+    double wire_bytes;
+    double segments;
+    double mean_latency_ms;
+    uint32_t max_latency_ms;
+} PathResult_t;
+
+/**
+ * Blynk writes are fire-and-forget: latency is first write -> last pin
+ * arriving at the server
+ */
+static PathResult_t runBlynk(uint16_t segment_overhead) {
+    size_t sizes[16];
+    size_t count = blynkSampleWrites(sizes);
+    uint32_t busy_until = 0;
+    uint64_t wire = 0;
+    PathResult_t result;
+    memset(&result, 0, sizeof(result));
+
+    double latency_sum = 0.0;
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        uint32_t start = i * BENCH_INTERVAL_MS;
+        if (busy_until < start) busy_until = start;
+        for (size_t w = 0; w < count; w++) {
+            uint32_t bytes = (uint32_t)sizes[w] + segment_overhead;
+            busy_until += (bytes * 8 + BENCH_BITS_PER_MS - 1) / BENCH_BITS_PER_MS;
+            wire += bytes;
+        }
+        uint32_t latency = busy_until + BENCH_ONE_WAY_MS - start;
+        latency_sum += latency;
+        if (latency > result.max_latency_ms) result.max_latency_ms = latency;
+    }
+
+    result.wire_bytes = (double)wire / BENCH_SAMPLES;
+    result.segments = (double)count;
+    result.mean_latency_ms = latency_sum / BENCH_SAMPLES;
+    return result;
+}
+
+/**
+ * MQTT latency is publishSample() -> PUBACK back on the device
+ */
+static PathResult_t runMqtt(uint16_t segment_overhead) {
+    MqttLinkModel_t link;
+    link.one_way_ms = BENCH_ONE_WAY_MS;
+    link.bits_per_ms = BENCH_BITS_PER_MS;
+    link.segment_overhead = segment_overhead;
+
+    MqttClientConfig_t config;
+    char topic[48];
+    mqttClientDefaults(&config);
+    mqttTelemetryTopic("BINSAI-AA:BB:CC", topic, sizeof(topic));
+    config.client_id = "BINSAI-AA:BB:CC";
+    config.topic = topic;
+
+    MqttLoopbackBroker broker(link);
+    MqttTelemetryTransport transport(broker.stream(), config);
+    TelemetryFrameMeta_t meta;
+    memset(&meta, 0, sizeof(meta));
+    meta.device_id = "BINSAI-AA:BB:CC";
+
+    uint32_t now = 0;
+    for (; now < 1000; now++) {
+        broker.advance(now);
+        transport.loop(now);
+    }
+    MqttBrokerStats_t before = broker.stats();
+
+    double latency_sum = 0.0;
+    uint32_t acked = 0;
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        meta.sequence = i + 1;
+        transport.publishSample(sample, meta, now);
+        for (uint32_t end = now + BENCH_INTERVAL_MS; now < end; now++) {
+            broker.advance(now);
+            transport.loop(now);
+            if (transport.client().stats().acked != acked) {
+                acked = transport.client().stats().acked;
+                latency_sum += transport.client().stats().last_latency_ms;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(BENCH_SAMPLES, acked);
+
+    PathResult_t result;
+    result.wire_bytes = (double)(broker.stats().wire_bytes_up - before.wire_bytes_up) / BENCH_SAMPLES;
+    result.segments = (double)(broker.stats().segments_up - before.segments_up) / BENCH_SAMPLES;
+    result.mean_latency_ms = latency_sum / BENCH_SAMPLES;
+    result.max_latency_ms = transport.client().stats().max_latency_ms;
+    return result;
+}
+
+static void printResult(const char* label, const PathResult_t& result) {
+    printf("[BENCH] %-18s %6.1f B/sample up, %4.1f segments, latency mean %.1f ms max %u ms\n",
+           label, result.wire_bytes, result.segments, result.mean_latency_ms, result.max_latency_ms);
+}
+
+void test_benchmark_wire_bytes_and_latency() {
+    PathResult_t blynk = runBlynk(MQTT_LINK_TCPIP_OVERHEAD + MQTT_LINK_TLS_OVERHEAD);
+    PathResult_t mqtt_tls = runMqtt(MQTT_LINK_TCPIP_OVERHEAD + MQTT_LINK_TLS_OVERHEAD);
+    PathResult_t mqtt_plain = runMqtt(MQTT_LINK_TCPIP_OVERHEAD);
+
+    printf("[BENCH] link: %u ms one way, %u kbit/s, TCP/IP %u B + TLS %u B per segment\n",
+           BENCH_ONE_WAY_MS, BENCH_BITS_PER_MS, MQTT_LINK_TCPIP_OVERHEAD, MQTT_LINK_TLS_OVERHEAD);
+    printResult("Blynk (TLS)", blynk);
+    printResult("MQTT QoS1 (TLS)", mqtt_tls);
+    printResult("MQTT QoS1 (plain)", mqtt_plain);
+    printf("[BENCH] MQTT over TLS sends %.1fx fewer bytes and %.0fx fewer segments than Blynk\n",
+           blynk.wire_bytes / mqtt_tls.wire_bytes, blynk.segments / mqtt_tls.segments);
+
+    TEST_ASSERT_TRUE(mqtt_tls.wire_bytes < blynk.wire_bytes);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1.0, mqtt_tls.segments);
+}
+
+void test_benchmark_publish_cpu_cost() {
+    MqttLinkModel_t link;
+    memset(&link, 0, sizeof(link));
+    MqttClientConfig_t config;
+    mqttClientDefaults(&config);
+    MqttLoopbackBroker broker(link);
+    MqttTelemetryTransport transport(broker.stream(), config);
+    TelemetryFrameMeta_t meta;
+    memset(&meta, 0, sizeof(meta));
+    meta.device_id = "BINSAI-AA:BB:CC";
+
+    broker.advance(0);
+    transport.loop(0);
+    broker.advance(0);
+    transport.loop(0);
+    TEST_ASSERT_TRUE(transport.connected());
+
+    const uint32_t rounds = 200000;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++) {
+        meta.sequence = i + 1;
+        transport.publishSample(sample, meta, i);
+        broker.advance(i);
+        transport.loop(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    TEST_ASSERT_EQUAL_UINT32(rounds, transport.client().stats().acked);
+    printf("[BENCH] MQTT publish + ack round trip on host (encode, queue, packet build, loopback broker): %.0f ns/sample\n",
+           elapsed.count() / rounds);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_wire_bytes_and_latency);
+    RUN_TEST(test_benchmark_publish_cpu_cost);
+    return UNITY_END();
+}
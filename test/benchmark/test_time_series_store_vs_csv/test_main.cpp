@@ -0,0 +1,184 @@
+/**
+ * BINSAI Benchmark - Time-Series Store vs CSV
+ * 20 bins x 30 days of 60 s research records. Compares on-disk size,
+ * full scan throughput and an hourly fill aggregate against the
+ * logResearchData() CSV format parsed with researchRecordFromCsv().
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <TimeSeriesStore.h>
+
+#define BENCH_DEVICES       20
+#define BENCH_DAYS          30
+#define BENCH_PER_DEVICE    (BENCH_DAYS * 24 * 60)
+#define TRACE_START_MS      1767225600000LL
+#define HOUR_MS             3600000LL
+
+static char root[64];
+static volatile double sink;
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+static float noise(uint32_t* seed) {
+    *seed = *seed * 1664525UL + 1013904223UL;
+    return (float)(*seed >> 8) / (float)(1UL << 24) - 0.5f;
+}
+
+/**
+ * Sensor-like trace: filling bin with ultrasonic noise, diurnal gas,
+ * millis() jitter, GPS wander in the 7th decimal
+ */
+static void generateDevice(uint32_t device, std::vector<ResearchRecord_t>* records) {
+    uint32_t seed = 1000 + device;
+    float fill = 10.0f;
+    float rate = 0.01f + device * 0.002f;
+    records->clear();
+    for (uint32_t i = 0; i < BENCH_PER_DEVICE; i++) {
+        ResearchRecord_t record;
+        memset(&record, 0, sizeof(record));
+        record.timestamp_ms = TRACE_START_MS + (int64_t)i * 60000 + (int64_t)(noise(&seed) * 30.0f);
+        fill += rate;
+        if (fill > 98.0f) fill = 5.0f;
+        record.fill_percentage = fill + noise(&seed) * 0.8f;
+        record.distance_cm = 37.0f * (1.0f - record.fill_percentage / 100.0f);
+        record.ppm_calculated = 220.0f + 80.0f * sinf(i * 2.0f * 3.14159f / 1440.0f) + noise(&seed) * 6.0f;
+        record.hours_to_full = (98.0f - fill) / (rate * 60.0f);
+        record.adc_raw = (uint16_t)(1500 + record.ppm_calculated * 0.8f);
+        record.gps_fix = 1;
+        record.latitude = -7.7956 - device * 0.003 + (double)(int)(noise(&seed) * 4.0f) * 1e-6;
+        record.longitude = 110.3695 + device * 0.002;
+        record.satellite_count = 8;
+        record.capacity_level = fill > 90.0f ? 3 : fill > 50.0f ? 2 : fill > 35.0f ? 1 : 0;
+        record.waste_classification = record.ppm_calculated > 199.0f ? 1 : 0;
+        record.priority_level = record.capacity_level;
+        records->push_back(record);
+    }
+}
+
+void setUp() {
+    strcpy(root, "/tmp/binsai_tsbench_XXXXXX");
+    TEST_ASSERT_NOT_NULL(mkdtemp(root));
+}
+
+void tearDown() {
+    std::string command = std::string("rm -rf '") + root + "'";
+    TEST_ASSERT_EQUAL_INT(0, system(command.c_str()));
+}
+
+void test_benchmark_store_vs_csv() {
+    std::vector<ResearchRecord_t> records;
+    std::vector<std::string> csv_paths;
+    uint64_t csv_bytes = 0;
+    char line[192];
+    char device_id[32];
+
+    TimeSeriesStore writer(root);
+    TEST_ASSERT_TRUE(writer.open());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double csv_write_ms = 0.0;
+
+    for (uint32_t device = 0; device < BENCH_DEVICES; device++) {
+        generateDevice(device, &records);
+        snprintf(device_id, sizeof(device_id), "BINSAI-%02u", device);
+
+        std::chrono::steady_clock::time_point csv_start = std::chrono::steady_clock::now();
+        std::string path = std::string(root) + "/" + device_id + ".csv";
+        FILE* csv = fopen(path.c_str(), "w");
+        for (size_t i = 0; i < records.size(); i++) {
+            researchRecordToCsv(records[i], TRACE_START_MS, line, sizeof(line));
+            csv_bytes += fprintf(csv, "[RESEARCH] %s\n", line);
+        }
+        fclose(csv);
+        csv_paths.push_back(path);
+        csv_write_ms += elapsedMs(csv_start);
+
+        for (size_t i = 0; i < records.size(); i++) writer.append(device_id, records[i]);
+    }
+    writer.flush();
+    double store_write_ms = elapsedMs(start) - csv_write_ms;
+    uint64_t total_records = (uint64_t)BENCH_DEVICES * BENCH_PER_DEVICE;
+
+    // Fresh instance: every read goes through mmap
+    TimeSeriesStore store(root);
+    TEST_ASSERT_TRUE(store.open());
+    TEST_ASSERT_EQUAL_UINT64(total_records, store.storedRecords());
+
+    start = std::chrono::steady_clock::now();
+    uint64_t csv_rows = 0;
+    double csv_fill_sum = 0.0;
+    for (size_t d = 0; d < csv_paths.size(); d++) {
+        FILE* csv = fopen(csv_paths[d].c_str(), "r");
+        ResearchRecord_t record;
+        while (fgets(line, sizeof(line), csv)) {
+            if (researchRecordFromCsv(line, TRACE_START_MS, &record)) {
+                csv_fill_sum += record.fill_percentage;
+                csv_rows++;
+            }
+        }
+        fclose(csv);
+    }
+    double csv_scan_ms = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    uint64_t store_rows = 0;
+    double store_fill_sum = 0.0;
+    std::vector<std::string> devices = store.devices();
+    for (size_t d = 0; d < devices.size(); d++) {
+        store_rows += store.scan(devices[d].c_str(), INT64_MIN, INT64_MAX, [&](const ResearchRecord_t& record) {
+            store_fill_sum += record.fill_percentage;
+        });
+    }
+    double store_scan_ms = elapsedMs(start);
+
+    // Hourly mean fill for one bin over the whole month
+    start = std::chrono::steady_clock::now();
+    double csv_hourly[BENCH_DAYS * 24] = {0};
+    FILE* csv = fopen(csv_paths[0].c_str(), "r");
+    ResearchRecord_t record;
+    while (fgets(line, sizeof(line), csv)) {
+        if (researchRecordFromCsv(line, TRACE_START_MS, &record)) {
+            csv_hourly[(record.timestamp_ms - TRACE_START_MS) / HOUR_MS % (BENCH_DAYS * 24)] += record.fill_percentage;
+        }
+    }
+    fclose(csv);
+    double csv_aggregate_ms = elapsedMs(start);
+    sink = csv_hourly[0];
+
+    std::vector<TsAggregate_t> hourly;
+    start = std::chrono::steady_clock::now();
+    store.aggregate("BINSAI-00", TS_COLUMN_FILL, INT64_MIN, INT64_MAX, HOUR_MS, &hourly);
+    double store_aggregate_ms = elapsedMs(start);
+
+    TEST_ASSERT_EQUAL_UINT64(total_records, csv_rows);
+    TEST_ASSERT_EQUAL_UINT64(total_records, store_rows);
+    TEST_ASSERT_FLOAT_WITHIN(total_records * 0.01, store_fill_sum, csv_fill_sum);
+    TEST_ASSERT_TRUE(hourly.size() >= BENCH_DAYS * 24);
+    sink = csv_fill_sum + store_fill_sum;
+
+    printf("[BENCH] tsdb %llu records (%d bins x %d days): CSV %.2f MB (%.1f B/rec), store %.2f MB (%.1f B/rec), %.1fx smaller\n",
+           (unsigned long long)total_records, BENCH_DEVICES, BENCH_DAYS, csv_bytes / 1e6,
+           (double)csv_bytes / total_records, store.storedBytes() / 1e6,
+           (double)store.storedBytes() / total_records, (double)csv_bytes / store.storedBytes());
+    printf("[BENCH] tsdb write: CSV %.0f ms, store %.0f ms\n", csv_write_ms, store_write_ms);
+    printf("[BENCH] tsdb full scan: CSV parse %.0f ms (%.1f M rec/s), store mmap %.0f ms (%.1f M rec/s), %.1fx faster\n",
+           csv_scan_ms, total_records / csv_scan_ms / 1e3, store_scan_ms, total_records / store_scan_ms / 1e3,
+           csv_scan_ms / store_scan_ms);
+    printf("[BENCH] tsdb hourly fill aggregate (1 bin, 30 days): CSV %.2f ms, store %.2f ms, %.1fx faster\n",
+           csv_aggregate_ms, store_aggregate_ms, csv_aggregate_ms / store_aggregate_ms);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_store_vs_csv);
+    return UNITY_END();
+}
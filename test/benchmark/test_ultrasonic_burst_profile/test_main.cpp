@@ -0,0 +1,158 @@
+/**
+ * BINSAI Benchmark - Ultrasonic Burst vs Single Ping
+ * Simulated HC-SR04 over an uneven waste surface: each ping lands somewhere
+ * on a +-4 cm heap with 0.3 cm timing noise, 8% of echoes are cross-talk
+ * (stale or multipath, arriving early) and 3% are lost. Compares the legacy
+ * single-ping read with 5/7/9-ping bursts on estimate spread, gross errors
+ * and time per measurement (air time from the ping schedule plus the
+ * estimate cost, ESP32 estimated at 15x the host).
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <UltrasonicBurst.h>
+
+#define TRIALS                  20000
+#define SPEED                   0.0346f     // cm/us at 25 C
+#define BIN_RANGE               45.0f
+#define SURFACE_CM              20.0f
+#define HEAP_CM                 4.0f        // Surface points within +-HEAP_CM
+#define JITTER_CM               0.3f
+#define CROSS_TALK_RATE         0.08f
+#define LOST_RATE               0.03f
+#define LEGACY_TIMEOUT_US       30000       // pulseIn timeout of the single-ping path
+#define GROSS_ERROR_CM          HEAP_CM     // Beyond the heap: cross-talk reached the result
+#define ESP32_SLOWDOWN          15.0
+
+static uint32_t rng_state = 0x2545F491UL;
+
+static float uniform() {
+    rng_state = rng_state * 1664525UL + 1013904223UL;     // LCG, deterministic
+    return (float)(rng_state >> 8) / (float)(1UL << 24);
+}
+
+static float gaussian() {
+    // Irwin-Hall approximation
+    float sum = 0.0f;
+    for (int i = 0; i < 12; i++) sum += uniform();
+    return sum - 6.0f;
+}
+
+/**
+ * One simulated echo width (0 = lost)
+ */
+static uint32_t simulatedEcho() {
+    float roll = uniform();
+    if (roll < LOST_RATE) {
+        return 0;
+    }
+    float cm;
+    if (roll < LOST_RATE + CROSS_TALK_RATE) {
+        cm = 1.0f + uniform() * (SURFACE_CM - 4.0f);
+    } else {
+        cm = SURFACE_CM + (2.0f * uniform() - 1.0f) * HEAP_CM + JITTER_CM * gaussian();
+    }
+    return (uint32_t)(2.0f * cm / SPEED + 0.5f);
+}
+
+typedef struct {
+    double sum;
+    double sum_sq;
+    uint32_t valid;
+    uint32_t gross;
+    double air_us;
+} Stats_t;
+
+static void addResult(Stats_t* stats, bool ok, float cm) {
+    if (!ok) return;
+    stats->valid++;
+    stats->sum += cm;
+    stats->sum_sq += (double)cm * cm;
+    if (fabsf(cm - SURFACE_CM) > GROSS_ERROR_CM) stats->gross++;
+}
+
+static double stddev(const Stats_t& stats) {
+    double mean = stats.sum / stats.valid;
+    return sqrt(stats.sum_sq / stats.valid - mean * mean);
+}
+
+/**
+ * Legacy readUltrasonicDistance(): one ping, blind zone / timeout rejected
+ */
+static Stats_t runSingle() {
+    Stats_t stats = {};
+    for (uint32_t t = 0; t < TRIALS; t++) {
+        uint32_t echo = simulatedEcho();
+        float cm = echo * SPEED / 2.0f;
+        bool ok = echo != 0 && cm >= BURST_BLIND_ZONE_CM;
+        stats.air_us += echo != 0 ? echo : LEGACY_TIMEOUT_US;
+        addResult(&stats, ok, cm);
+    }
+    return stats;
+}
+
+static Stats_t runBurst(uint8_t pings, double* estimate_ns) {
+    Stats_t stats = {};
+    uint32_t echo[BURST_MAX_PINGS];
+    uint32_t period = burstPingPeriodUs(SPEED);
+    uint32_t timeout = burstEchoTimeoutUs(BIN_RANGE, SPEED);
+    double compute_ns = 0.0;
+
+    for (uint32_t t = 0; t < TRIALS; t++) {
+        for (uint8_t i = 0; i < pings; i++) {
+            echo[i] = simulatedEcho();
+        }
+        uint32_t last = echo[pings - 1] != 0 ? echo[pings - 1] : timeout;
+        stats.air_us += (double)(pings - 1) * period + last;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        BurstEstimate_t estimate;
+        bool ok = burstEstimate(echo, pings, SPEED, BIN_RANGE, &estimate);
+        compute_ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        addResult(&stats, ok && !estimate.in_blind_zone, estimate.distance_cm);
+    }
+    *estimate_ns = compute_ns / TRIALS;
+    return stats;
+}
+
+static void report(const char* name, const Stats_t& stats, double estimate_ns) {
+    double esp_us = estimate_ns * ESP32_SLOWDOWN / 1000.0;
+    printf("[BENCH] %-8s sd %.2f cm, gross >%.0f cm %.2f%%, failed %.2f%%, %.1f ms/read (estimate %.1f us ESP32)\n",
+           name, stddev(stats), GROSS_ERROR_CM, 100.0 * stats.gross / stats.valid,
+           100.0 * (TRIALS - stats.valid) / TRIALS,
+           stats.air_us / TRIALS / 1000.0 + esp_us / 1000.0, esp_us);
+}
+
+void setUp() {
+    rng_state = 0x2545F491UL;
+}
+
+void tearDown() {}
+
+void test_benchmark_burst_vs_single() {
+    Stats_t single = runSingle();
+    report("single", single, 0.0);
+
+    const uint8_t sizes[] = { 5, 7, 9 };
+    for (uint8_t s = 0; s < sizeof(sizes); s++) {
+        double estimate_ns = 0.0;
+        Stats_t burst = runBurst(sizes[s], &estimate_ns);
+        char name[16];
+        snprintf(name, sizeof(name), "burst %u", sizes[s]);
+        report(name, burst, estimate_ns);
+
+        // Cross-talk no longer reaches the estimate; roughness averages out
+        TEST_ASSERT_TRUE(stddev(burst) < stddev(single) / 2.0);
+        TEST_ASSERT_TRUE(burst.gross * 5 < single.gross);
+        // Fits comfortably inside the 2 s sample interval
+        TEST_ASSERT_TRUE(burst.air_us / TRIALS < 250000.0);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_burst_vs_single);
+    return UNITY_END();
+}
@@ -6,6 +6,7 @@
 // Libraries
 #include <Wire.h>
 #include <LiquidCrystal_I2C.h>
+#include <WasteClassifier.h>      // Shared firmware classifier (lib/)
 
 // ============ PIN DEFINITION (ESP32) ============
 // HC-SR04 Ultrasonic Sensor
@@ -22,12 +23,10 @@
 #define SENSOR_TIMEOUT 30000    // Sensor timeout 30ms (~5m)
 
 // ============ STATUS THRESHOLDS ============
-#define EMPTY_MAX 35.0
-#define HALF_MIN 36.0
-#define HALF_MAX 50.0
-#define ALMOST_FULL_MIN 51.0
-#define ALMOST_FULL_MAX 90.0
-#define FULL_MIN 91.0
+// Same breakpoints and hysteresis as the firmware (include/definitions.h)
+#define LEVEL_ALMOST_FULL 2
+#define LEVEL_FULL 3
+const char* LEVEL_NAMES[CLASSIFICATION_LEVEL_COUNT] = {"EMPTY", "HALF", "ALMOST FULL", "FULL"};
 
 // ============ GLOBAL VARIABLES ============
 float measuredDistance = 0.0;            // Distance in cm
@@ -42,6 +41,8 @@ const int screenChangeInterval = 3000;   // Change screen every 3 seconds
 int sensorErrorCount = 0;
 int lcdErrorCount = 0;
 String lastError = "NONE";
+HysteresisClassifier capacityClassifier;  // Defaults to research capacity table
+uint8_t capacityLevel = 0;
 unsigned long systemUptime = 0;
 unsigned long lastErrorTime = 0;
 
@@ -77,8 +78,8 @@ void setup() {
   // Display startup completion
   Serial.println("\n✅ SYSTEM READY FOR OPERATION!");
   Serial.println("📏 Bin Height: " + String(BIN_MAX_HEIGHT) + " cm");
-  Serial.println("📊 Thresholds: Empty(0-35%), Half(36-50%)");
-  Serial.println("                Almost Full(51-90%), Full(91-100%)");
+  Serial.println("📊 Thresholds: Empty(0-35%), Half(>35-50%)");
+  Serial.println("                Almost Full(>50-90%), Full(>90%)");
   Serial.println(String(78, '=') + "\n");
   
   // LCD welcome message
@@ -288,16 +289,9 @@ void calculateFillPercentage() {
   if (fillPercentage < 0.0) fillPercentage = 0.0;
   if (fillPercentage > 100.0) fillPercentage = 100.0;
   
-  // Classify status according to thresholds
-  if (fillPercentage <= EMPTY_MAX) {
-    capacityStatus = "EMPTY";
-  } else if (fillPercentage >= HALF_MIN && fillPercentage <= HALF_MAX) {
-    capacityStatus = "HALF";
-  } else if (fillPercentage >= ALMOST_FULL_MIN && fillPercentage <= ALMOST_FULL_MAX) {
-    capacityStatus = "ALMOST FULL";
-  } else if (fillPercentage >= FULL_MIN) {
-    capacityStatus = "FULL";
-  }
+  // Classify status with the shared table-driven classifier
+  capacityLevel = capacityClassifier.update(fillPercentage, millis());
+  capacityStatus = LEVEL_NAMES[capacityLevel];
 }
 
 // =============================================
@@ -519,10 +513,10 @@ void loop() {
     printSensorData();
     
     // Check for critical conditions
-    if (fillPercentage >= FULL_MIN) {
+    if (capacityLevel >= LEVEL_FULL) {
       Serial.println("🚨 CRITICAL: Bin is FULL! Immediate attention required!");
       // Here you could trigger an alarm or notification
-    } else if (fillPercentage >= ALMOST_FULL_MIN) {
+    } else if (capacityLevel >= LEVEL_ALMOST_FULL) {
       Serial.println("⚠️  WARNING: Bin is ALMOST FULL. Schedule collection soon.");
     }
   }
@@ -35,9 +35,8 @@ private:
     
     // Internal resistance calculation with ESP32 ADC Non-linearity compensation
     float readResistance() {
-        int rawADC = analogRead(_pin);
-        // ESP32 12-bit ADC (0-4095) with 3.3V Reference
-        float v_out = (rawADC / 4095.0) * 3.3;
+        // eFuse-calibrated reading; raw counts are not linear near the rails
+        float v_out = analogReadMilliVolts(_pin) / 1000.0;
         
         // Safety margin to prevent division by zero or infinite resistance
         if (v_out >= 3.25) v_out = 3.25;
@@ -110,8 +109,11 @@ void setup() {
     
     if (result.is_valid) {
         Serial.println(F("Status            : [SUCCESS] Data is stable."));
-        Serial.println(F("\nCopy this value to your config.h:"));
-        Serial.print(F("#define SENSOR_MQ135_R0 ")); Serial.println(result.r0, 4);
+        Serial.println(F("\nThe firmware tracks R0 in the background; to seed it, enter on the"));
+        Serial.println(F("device console (check RL matches MQ135_LOAD_RESISTOR first):"));
+        Serial.print(F("SET mq135_r0_calibrated ")); Serial.println(result.r0, 4);
+        Serial.println(F("SET mq135_r0_confidence 100"));
+        Serial.println(F("SAVE"));
     } else {
         Serial.println(F("Status            : [FAILED] High fluctuation detected."));
         Serial.println(F("Action            : Check wiring or increase pre-heating time."));
@@ -0,0 +1,162 @@
+/**
+ * BINSAI Unit Test - ADC Calibration
+ * LUT lookup against the exact line, and a bench fit on a simulated
+ * ESP32-like ADC (dead zone, saturation and a bowed transfer curve).
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include <AdcCalibration.h>
+
+void setUp() {}
+void tearDown() {}
+
+/**
+ * Simulated chip: nothing below 120 mV, saturated above 3150 mV and
+ * up to ~60 counts of bow in between
+ */
+static uint16_t simulatedRaw(float mv) {
+    if (mv <= 120.0f) return 0;
+    if (mv >= 3150.0f) return ADC_RAW_MAX;
+    float x = (mv - 120.0f) / (3150.0f - 120.0f);
+    float raw = x * ADC_RAW_MAX + 60.0f * sinf(3.14159265f * x);
+    if (raw > ADC_RAW_MAX) raw = ADC_RAW_MAX;
+    return (uint16_t)(raw + 0.5f);
+}
+
+static AdcLut_t linear3300() {
+    AdcLut_t lut;
+    adcLutLinear(&lut, 3300);
+    return lut;
+}
+
+/**
+ * Bench steps every 370 mV from 140 mV to 3100 mV, as ADCCAL ADD would
+ * record them
+ */
+static uint8_t benchPoints(AdcBenchPoint_t* points) {
+    uint8_t count = 0;
+    for (float mv = 140.0f; mv <= 3100.0f; mv += 370.0f) {
+        points[count].raw = simulatedRaw(mv);
+        points[count].mv = (uint16_t)mv;
+        count++;
+    }
+    return count;
+}
+
+static float maxError(const AdcLut_t& lut, float from_mv, float to_mv) {
+    float worst = 0.0f;
+    for (float mv = from_mv; mv <= to_mv; mv += 5.0f) {
+        float error = fabsf(adcLutMillivolts(&lut, simulatedRaw(mv)) - mv);
+        if (error > worst) worst = error;
+    }
+    return worst;
+}
+
+void test_linear_lut_matches_exact_line() {
+    AdcLut_t lut = linear3300();
+    TEST_ASSERT_EQUAL_UINT8(33, ADC_LUT_POINTS);
+    TEST_ASSERT_EQUAL_UINT16(ADC_RAW_MAX, adcLutKnotRaw(ADC_LUT_POINTS - 1));
+    TEST_ASSERT_EQUAL_UINT16(0, adcLutMillivolts(&lut, 0));
+    TEST_ASSERT_EQUAL_UINT16(3300, adcLutMillivolts(&lut, ADC_RAW_MAX));
+    TEST_ASSERT_EQUAL_UINT16(3300, adcLutMillivolts(&lut, 5000));   // Clamped
+
+    uint16_t previous = 0;
+    for (uint16_t raw = 0; raw <= ADC_RAW_MAX; raw++) {
+        uint16_t mv = adcLutMillivolts(&lut, raw);
+        TEST_ASSERT_TRUE(mv >= previous);
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, raw * 3300.0f / ADC_RAW_MAX, mv);
+        previous = mv;
+    }
+}
+
+void test_bench_fit_removes_nonlinearity() {
+    AdcLut_t base = linear3300();
+    AdcBenchPoint_t points[ADC_BENCH_MAX_POINTS];
+    uint8_t count = benchPoints(points);
+
+    float before = maxError(base, 200.0f, 3100.0f);
+    TEST_ASSERT_TRUE(before > 100.0f);
+
+    AdcCorrection_t correction;
+    TEST_ASSERT_TRUE(adcCorrectionFit(&correction, &base, points, count));
+    TEST_ASSERT_TRUE(adcCorrectionIsValid(&correction));
+    TEST_ASSERT_EQUAL_UINT8(count, correction.points);
+
+    AdcLut_t corrected = base;
+    adcLutApplyCorrection(&corrected, &correction);
+    float after = maxError(corrected, 200.0f, 3100.0f);
+    TEST_ASSERT_TRUE(after < 12.0f);
+
+    // Exact at the bench points themselves (up to LUT rounding)
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_UINT32_WITHIN(4, points[i].mv, adcLutMillivolts(&corrected, points[i].raw));
+    }
+}
+
+void test_fit_ignores_point_order_and_holds_edges() {
+    AdcLut_t base = linear3300();
+    AdcBenchPoint_t points[ADC_BENCH_MAX_POINTS];
+    uint8_t count = benchPoints(points);
+
+    AdcCorrection_t sorted_fit;
+    TEST_ASSERT_TRUE(adcCorrectionFit(&sorted_fit, &base, points, count));
+
+    AdcBenchPoint_t reversed[ADC_BENCH_MAX_POINTS];
+    for (uint8_t i = 0; i < count; i++) {
+        reversed[i] = points[count - 1 - i];
+    }
+    AdcCorrection_t reversed_fit;
+    TEST_ASSERT_TRUE(adcCorrectionFit(&reversed_fit, &base, reversed, count));
+    TEST_ASSERT_EQUAL_MEMORY(&sorted_fit, &reversed_fit, sizeof(sorted_fit));
+
+    // Knots outside the bench range keep the outermost residual
+    TEST_ASSERT_EQUAL_INT16(points[0].mv - adcLutMillivolts(&base, points[0].raw),
+                            sorted_fit.offset_mv[0]);
+    TEST_ASSERT_EQUAL_INT16(points[count - 1].mv - adcLutMillivolts(&base, points[count - 1].raw),
+                            sorted_fit.offset_mv[ADC_LUT_POINTS - 1]);
+}
+
+void test_bad_bench_data_rejected() {
+    AdcLut_t base = linear3300();
+    AdcCorrection_t correction;
+    AdcBenchPoint_t points[3] = { { 500, 450 }, { 2000, 1700 }, { 3000, 2500 } };
+
+    TEST_ASSERT_FALSE(adcCorrectionFit(&correction, &base, points, 1));
+
+    points[1].raw = 500;                    // Same reading at two voltages
+    TEST_ASSERT_FALSE(adcCorrectionFit(&correction, &base, points, 3));
+
+    points[1].raw = 2000;
+    points[1].mv = 2600;                    // Voltage fell while raw rose
+    TEST_ASSERT_FALSE(adcCorrectionFit(&correction, &base, points, 3));
+
+    // An unfitted correction leaves the LUT alone
+    memset(&correction, 0, sizeof(correction));
+    AdcLut_t lut = base;
+    adcLutApplyCorrection(&lut, &correction);
+    TEST_ASSERT_EQUAL_MEMORY(&base, &lut, sizeof(lut));
+}
+
+void test_correction_clamps_at_rails() {
+    AdcLut_t lut = linear3300();
+    AdcCorrection_t correction;
+    memset(&correction, 0, sizeof(correction));
+    correction.magic = ADC_CORRECTION_MAGIC;
+    correction.points = 2;
+    correction.offset_mv[0] = -200;
+    adcLutApplyCorrection(&lut, &correction);
+    TEST_ASSERT_EQUAL_UINT16(0, lut.mv[0]);
+    TEST_ASSERT_EQUAL_UINT16(0, adcLutMillivolts(&lut, 0));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_linear_lut_matches_exact_line);
+    RUN_TEST(test_bench_fit_removes_nonlinearity);
+    RUN_TEST(test_fit_ignores_point_order_and_holds_edges);
+    RUN_TEST(test_bad_bench_data_rejected);
+    RUN_TEST(test_correction_clamps_at_rails);
+    return UNITY_END();
+}
@@ -0,0 +1,103 @@
+/**
+ * BINSAI Unit Test - Buzzer Sequencer
+ * Verifies pattern timing and priority preemption on a virtual clock.
+ */
+
+#include <unity.h>
+#include <BuzzerSequencer.h>
+
+static BuzzerSequencer sequencer;
+
+void setUp() {
+    sequencer.stop();
+}
+
+void tearDown() {}
+
+/**
+ * Run the sequencer on a 1 ms virtual clock and count ON time
+ * @return Milliseconds spent with the buzzer ON
+ */
+static uint32_t runAndMeasureOnTime(uint32_t start_ms, uint32_t duration_ms) {
+    uint32_t on_ms = 0;
+    for (uint32_t t = start_ms; t < start_ms + duration_ms; t++) {
+        if (sequencer.tick(t)) on_ms++;
+    }
+    return on_ms;
+}
+
+void test_success_pattern_timing() {
+    TEST_ASSERT_TRUE(sequencer.play(BUZZER_PATTERN_SUCCESS, 1000));
+    TEST_ASSERT_TRUE(sequencer.tick(1000));
+    TEST_ASSERT_TRUE(sequencer.tick(1049));
+    TEST_ASSERT_FALSE(sequencer.tick(1050));
+    TEST_ASSERT_TRUE(sequencer.tick(1100));
+    TEST_ASSERT_TRUE(sequencer.tick(1200));
+    TEST_ASSERT_TRUE(sequencer.tick(1349));
+    TEST_ASSERT_FALSE(sequencer.tick(1350));
+    TEST_ASSERT_FALSE(sequencer.isActive());
+}
+
+void test_pattern_on_time_matches_table() {
+    sequencer.play(BUZZER_PATTERN_ERROR, 0);
+    TEST_ASSERT_EQUAL_UINT32(300, runAndMeasureOnTime(0, 1000));
+    TEST_ASSERT_EQUAL_UINT32(600, BuzzerSequencer::patternDurationMs(BUZZER_PATTERN_ERROR));
+
+    sequencer.play(BUZZER_PATTERN_WARNING, 5000);
+    TEST_ASSERT_EQUAL_UINT32(400, runAndMeasureOnTime(5000, 1000));
+    TEST_ASSERT_EQUAL_UINT32(800, BuzzerSequencer::patternDurationMs(BUZZER_PATTERN_WARNING));
+}
+
+void test_critical_preempts_success() {
+    sequencer.play(BUZZER_PATTERN_SUCCESS, 0);
+    sequencer.tick(20);
+    TEST_ASSERT_TRUE(sequencer.play(BUZZER_PATTERN_ERROR, 20));
+    TEST_ASSERT_EQUAL_UINT8(BUZZER_PATTERN_ERROR, sequencer.activePattern());
+}
+
+void test_success_does_not_preempt_critical() {
+    sequencer.play(BUZZER_PATTERN_ERROR, 0);
+    TEST_ASSERT_FALSE(sequencer.play(BUZZER_PATTERN_SUCCESS, 50));
+    TEST_ASSERT_EQUAL_UINT8(BUZZER_PATTERN_ERROR, sequencer.activePattern());
+
+    // Once finished, lower priority patterns are accepted again
+    sequencer.tick(600);
+    TEST_ASSERT_TRUE(sequencer.play(BUZZER_PATTERN_SUCCESS, 600));
+}
+
+void test_late_tick_catches_up_without_drift() {
+    sequencer.play(BUZZER_PATTERN_HALT, 0);
+    // A single late tick jumps several loops; phase stays aligned to 1 s
+    TEST_ASSERT_TRUE(sequencer.tick(3050));
+    TEST_ASSERT_FALSE(sequencer.tick(3100));
+    TEST_ASSERT_TRUE(sequencer.tick(4000));
+    TEST_ASSERT_TRUE(sequencer.isActive());
+}
+
+void test_clock_wraparound() {
+    uint32_t start = 0xFFFFFFF0u;
+    sequencer.play(BUZZER_PATTERN_WARNING, start);
+    TEST_ASSERT_TRUE(sequencer.tick(start + 199));
+    TEST_ASSERT_FALSE(sequencer.tick(start + 200));
+    TEST_ASSERT_TRUE(sequencer.tick(start + 400));
+    sequencer.tick(start + 800);
+    TEST_ASSERT_FALSE(sequencer.isActive());
+}
+
+void test_invalid_pattern_rejected() {
+    TEST_ASSERT_FALSE(sequencer.play(BUZZER_PATTERN_NONE, 0));
+    TEST_ASSERT_FALSE(sequencer.play(BUZZER_PATTERN_COUNT, 0));
+    TEST_ASSERT_FALSE(sequencer.tick(10));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_success_pattern_timing);
+    RUN_TEST(test_pattern_on_time_matches_table);
+    RUN_TEST(test_critical_preempts_success);
+    RUN_TEST(test_success_does_not_preempt_critical);
+    RUN_TEST(test_late_tick_catches_up_without_drift);
+    RUN_TEST(test_clock_wraparound);
+    RUN_TEST(test_invalid_pattern_rejected);
+    return UNITY_END();
+}
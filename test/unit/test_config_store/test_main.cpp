@@ -0,0 +1,266 @@
+/**
+ * BINSAI Unit Test - Configuration Store
+ * Verifies A/B commits, CRC rejection of torn writes and schema handling.
+ */
+
+#include <unity.h>
+#include <stddef.h>
+#include <string.h>
+#include <ConfigStore.h>
+
+/**
+ * RAM-backed slot storage with write failure injection
+ */
+class RamConfigBackend : public ConfigStorageBackend {
+public:
+    uint8_t slots[CONFIG_SLOT_COUNT][CONFIG_BLOB_MAX_SIZE];
+    size_t lengths[CONFIG_SLOT_COUNT];
+    size_t torn_write_bytes;        // >0: next write stops after N bytes
+    uint32_t read_count;
+
+    void reset() {
+        memset(slots, 0, sizeof(slots));
+        memset(lengths, 0, sizeof(lengths));
+        torn_write_bytes = 0;
+        read_count = 0;
+    }
+
+    size_t readSlot(uint8_t slot, void* buffer, size_t capacity) {
+        read_count++;
+        size_t n = lengths[slot] < capacity ? lengths[slot] : capacity;
+        memcpy(buffer, slots[slot], n);
+        return n;
+    }
+
+    bool writeSlot(uint8_t slot, const void* data, size_t length) {
+        if (torn_write_bytes > 0) {
+            // Simulate power loss mid-write: partial data, full length recorded
+            memcpy(slots[slot], data, torn_write_bytes);
+            memset(slots[slot] + torn_write_bytes, 0xFF, length - torn_write_bytes);
+            lengths[slot] = length;
+            torn_write_bytes = 0;
+            return false;
+        }
+        memcpy(slots[slot], data, length);
+        lengths[slot] = length;
+        return true;
+    }
+};
+
+static RamConfigBackend backend;
+
+static SystemConfig_t makeConfig(float r0) {
+    SystemConfig_t config;
+    memset(&config, 0, sizeof(config));
+    strcpy(config.device_id, "BINSAI-TEST");
+    strcpy(config.blynk_auth_token, "TOKEN");
+    config.mq135_r0_calibrated = r0;
+    config.deployment_zone = 7;
+    return config;
+}
+
+void setUp() {
+    backend.reset();
+}
+
+void tearDown() {}
+
+void test_empty_storage_reports_empty() {
+    ConfigStore store(backend);
+    SystemConfig_t config = makeConfig(1.0f);
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_EMPTY, store.load(&config));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, config.mq135_r0_calibrated);
+}
+
+void test_commit_roundtrip_all_fields() {
+    ConfigStore writer(backend);
+    SystemConfig_t saved = makeConfig(9.85f);
+    TEST_ASSERT_TRUE(writer.commit(saved));
+
+    ConfigStore reader(backend);
+    SystemConfig_t loaded = makeConfig(0.0f);
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_OK, reader.load(&loaded));
+    TEST_ASSERT_EQUAL_MEMORY(&saved, &loaded, sizeof(SystemConfig_t));
+    TEST_ASSERT_EQUAL_UINT32(CONFIG_SLOT_COUNT, backend.read_count);
+}
+
+void test_commits_alternate_slots() {
+    ConfigStore store(backend);
+    SystemConfig_t config = makeConfig(1.0f);
+    store.commit(config);
+    uint8_t first = store.activeSlot();
+    store.commit(config);
+    TEST_ASSERT_NOT_EQUAL(first, store.activeSlot());
+    TEST_ASSERT_EQUAL_UINT32(2, store.sequence());
+}
+
+void test_newest_sequence_wins() {
+    ConfigStore store(backend);
+    store.commit(makeConfig(1.0f));
+    store.commit(makeConfig(2.0f));
+    store.commit(makeConfig(3.0f));
+
+    ConfigStore reader(backend);
+    SystemConfig_t loaded = makeConfig(0.0f);
+    reader.load(&loaded);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, loaded.mq135_r0_calibrated);
+    TEST_ASSERT_EQUAL_UINT32(3, reader.sequence());
+}
+
+void test_torn_write_keeps_previous_config() {
+    ConfigStore store(backend);
+    store.commit(makeConfig(5.0f));
+
+    backend.torn_write_bytes = sizeof(ConfigBlobHeader_t) + 10;
+    TEST_ASSERT_FALSE(store.commit(makeConfig(6.0f)));
+
+    ConfigStore reader(backend);
+    SystemConfig_t loaded = makeConfig(0.0f);
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_OK, reader.load(&loaded));
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, loaded.mq135_r0_calibrated);
+}
+
+void test_bit_flip_detected_by_crc() {
+    ConfigStore store(backend);
+    store.commit(makeConfig(5.0f));
+    backend.slots[store.activeSlot()][sizeof(ConfigBlobHeader_t) + 3] ^= 0x10;
+
+    ConfigStore reader(backend);
+    SystemConfig_t loaded = makeConfig(0.0f);
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_CORRUPT, reader.load(&loaded));
+}
+
+void test_sequence_wraparound() {
+    ConfigStore store(backend);
+    SystemConfig_t config = makeConfig(1.0f);
+    store.commit(config);
+
+    // Rewrite slot header with a sequence just below wraparound
+    ConfigBlobHeader_t header;
+    memcpy(&header, backend.slots[store.activeSlot()], sizeof(header));
+    header.sequence = 0xFFFFFFFFUL;
+    memcpy(backend.slots[store.activeSlot()], &header, sizeof(header));
+
+    ConfigStore reader(backend);
+    reader.load(&config);
+    reader.commit(makeConfig(4.0f));   // sequence wraps to 0
+    TEST_ASSERT_EQUAL_UINT32(0, reader.sequence());
+
+    ConfigStore again(backend);
+    SystemConfig_t loaded = makeConfig(0.0f);
+    again.load(&loaded);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, loaded.mq135_r0_calibrated);
+}
+
+void test_future_schema_is_ignored() {
+    ConfigStore store(backend);
+    store.commit(makeConfig(1.0f));
+
+    ConfigBlobHeader_t header;
+    memcpy(&header, backend.slots[store.activeSlot()], sizeof(header));
+    header.schema_version = CONFIG_SCHEMA_VERSION + 1;
+    memcpy(backend.slots[store.activeSlot()], &header, sizeof(header));
+
+    ConfigStore reader(backend);
+    SystemConfig_t loaded = makeConfig(0.0f);
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_CORRUPT, reader.load(&loaded));
+}
+
+void test_v1_blob_migrates_classification_tables() {
+    // Schema v1 payload ends right before the classification tables
+    SystemConfig_t v1 = makeConfig(7.5f);
+    uint16_t v1_length = (uint16_t)offsetof(SystemConfig_t, capacity_breakpoints);
+
+    ConfigBlobHeader_t header;
+    header.magic = CONFIG_BLOB_MAGIC;
+    header.schema_version = 1;
+    header.payload_length = v1_length;
+    header.sequence = 1;
+    header.crc32 = configCrc32(&v1, v1_length);
+    memcpy(backend.slots[0], &header, sizeof(header));
+    memcpy(backend.slots[0] + sizeof(header), &v1, v1_length);
+    backend.lengths[0] = sizeof(header) + v1_length;
+
+    ConfigStore store(backend);
+    SystemConfig_t loaded = makeConfig(0.0f);
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_MIGRATED, store.load(&loaded));
+    TEST_ASSERT_EQUAL_UINT16(1, store.loadedSchemaVersion());
+    TEST_ASSERT_EQUAL_FLOAT(7.5f, loaded.mq135_r0_calibrated);
+    TEST_ASSERT_EQUAL_FLOAT(THRESHOLD_HALF_PERCENT, loaded.capacity_breakpoints[1]);
+    TEST_ASSERT_EQUAL_FLOAT(PPM_ORGANIC_L1_MAX, loaded.gas_breakpoints[2]);
+    TEST_ASSERT_EQUAL_UINT32(CLASSIFICATION_DWELL_MS, loaded.classification_dwell_ms);
+
+    // Re-commit upgrades the stored schema
+    TEST_ASSERT_TRUE(store.commit(loaded));
+    ConfigStore reader(backend);
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_OK, reader.load(&loaded));
+}
+
+void test_v2_blob_migrates_auto_baseline() {
+    // Schema v2 payload ends right before the auto-baseline fields
+    SystemConfig_t v2 = makeConfig(7.5f);
+    uint16_t v2_length = (uint16_t)offsetof(SystemConfig_t, mq135_r0_confidence);
+
+    ConfigBlobHeader_t header;
+    header.magic = CONFIG_BLOB_MAGIC;
+    header.schema_version = 2;
+    header.payload_length = v2_length;
+    header.sequence = 1;
+    header.crc32 = configCrc32(&v2, v2_length);
+    memcpy(backend.slots[0], &header, sizeof(header));
+    memcpy(backend.slots[0] + sizeof(header), &v2, v2_length);
+    backend.lengths[0] = sizeof(header) + v2_length;
+
+    ConfigStore store(backend);
+    SystemConfig_t loaded = makeConfig(0.0f);
+    loaded.mq135_r0_confidence = 100.0f;
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_MIGRATED, store.load(&loaded));
+    TEST_ASSERT_EQUAL_UINT16(2, store.loadedSchemaVersion());
+    TEST_ASSERT_EQUAL_FLOAT(7.5f, loaded.mq135_r0_calibrated);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, loaded.mq135_r0_confidence);
+    TEST_ASSERT_TRUE(loaded.mq135_auto_baseline);
+}
+
+void test_v3_blob_migrates_probe_count() {
+    SystemConfig_t v3 = makeConfig(7.5f);
+    v3.mq135_r0_confidence = 80.0f;
+    uint16_t v3_length = (uint16_t)offsetof(SystemConfig_t, ultrasonic_probe_count);
+
+    ConfigBlobHeader_t header;
+    header.magic = CONFIG_BLOB_MAGIC;
+    header.schema_version = 3;
+    header.payload_length = v3_length;
+    header.sequence = 1;
+    header.crc32 = configCrc32(&v3, v3_length);
+    memcpy(backend.slots[0], &header, sizeof(header));
+    memcpy(backend.slots[0] + sizeof(header), &v3, v3_length);
+    backend.lengths[0] = sizeof(header) + v3_length;
+
+    ConfigStore store(backend);
+    SystemConfig_t loaded = makeConfig(0.0f);
+    TEST_ASSERT_EQUAL(CONFIG_LOAD_MIGRATED, store.load(&loaded));
+    TEST_ASSERT_EQUAL_UINT16(3, store.loadedSchemaVersion());
+    TEST_ASSERT_EQUAL_FLOAT(80.0f, loaded.mq135_r0_confidence);
+    TEST_ASSERT_EQUAL_UINT8(1, loaded.ultrasonic_probe_count);
+}
+
+void test_crc32_reference_vector() {
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926UL, configCrc32("123456789", 9));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_storage_reports_empty);
+    RUN_TEST(test_commit_roundtrip_all_fields);
+    RUN_TEST(test_commits_alternate_slots);
+    RUN_TEST(test_newest_sequence_wins);
+    RUN_TEST(test_torn_write_keeps_previous_config);
+    RUN_TEST(test_bit_flip_detected_by_crc);
+    RUN_TEST(test_sequence_wraparound);
+    RUN_TEST(test_future_schema_is_ignored);
+    RUN_TEST(test_v1_blob_migrates_classification_tables);
+    RUN_TEST(test_v2_blob_migrates_auto_baseline);
+    RUN_TEST(test_v3_blob_migrates_probe_count);
+    RUN_TEST(test_crc32_reference_vector);
+    return UNITY_END();
+}
@@ -0,0 +1,118 @@
+/**
+ * BINSAI Unit Test - Environmental Compensation
+ * Correction tables against the closed-form curves, fallback to defaults,
+ * SHT3x frame decoding, and the range error removed on a hot day.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <EnvCompensation.h>
+
+void setUp() {}
+void tearDown() {}
+
+static float exactSoundSpeed(float temperature_c, float humidity_pct) {
+    return 0.03313f * sqrtf(1.0f + temperature_c / 273.15f) + 0.00000124f * humidity_pct;
+}
+
+static float exactCf(float temperature_c, float humidity_pct) {
+    return 0.00035f * temperature_c * temperature_c - 0.02718f * temperature_c + 1.39538f -
+           0.0018f * (humidity_pct - 33.0f);
+}
+
+void test_defaults_leave_readings_unchanged() {
+    EnvCompensation_t env;
+    envInit(&env);
+    TEST_ASSERT_EQUAL_UINT8(ENV_SOURCE_DEFAULT, env.source);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, env.gas_rs_factor);
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, envCompensateRs(&env, 12.5f));
+    TEST_ASSERT_FLOAT_WITHIN(0.00001f, exactSoundSpeed(25.0f, 60.0f), env.sound_speed_cm_us);
+}
+
+void test_sound_table_matches_formula() {
+    for (float t = -20.0f; t <= 60.0f; t += 0.5f) {
+        // 5 C steps of a square root: interpolation error well under 0.01%
+        TEST_ASSERT_FLOAT_WITHIN(0.000004f, exactSoundSpeed(t, 50.0f), envSoundSpeed(t, 50.0f));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.00001f, 0.03313f, envSoundSpeed(0.0f, 0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(envSoundSpeed(60.0f, 0.0f), envSoundSpeed(80.0f, 0.0f));   // Held
+}
+
+void test_mq135_table_matches_datasheet_fit() {
+    float reference = exactCf(ENV_DEFAULT_TEMPERATURE_C, ENV_DEFAULT_HUMIDITY_PCT);
+    for (float t = -10.0f; t <= 40.0f; t += 0.5f) {
+        for (float h = 20.0f; h <= 95.0f; h += 15.0f) {
+            TEST_ASSERT_FLOAT_WITHIN(0.003f, exactCf(t, h) / reference, envMq135Factor(t, h));
+        }
+    }
+
+    // Warmer and wetter air lowers RS; the fit's upturn above 40 C is cut off
+    TEST_ASSERT_TRUE(envMq135Factor(35.0f, 60.0f) < 1.0f);
+    TEST_ASSERT_TRUE(envMq135Factor(25.0f, 90.0f) < envMq135Factor(25.0f, 40.0f));
+    TEST_ASSERT_EQUAL_FLOAT(envMq135Factor(40.0f, 60.0f), envMq135Factor(50.0f, 60.0f));
+}
+
+void test_sensor_readings_and_stale_fallback() {
+    EnvCompensation_t env;
+    envInit(&env);
+
+    TEST_ASSERT_TRUE(envUpdate(&env, 34.0f, 85.0f, 1000));
+    TEST_ASSERT_EQUAL_UINT8(ENV_SOURCE_SENSOR, env.source);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, envMq135Factor(34.0f, 85.0f), env.gas_rs_factor);
+    TEST_ASSERT_TRUE(envCompensateRs(&env, 12.5f) > 12.5f);  // Hot, wet air reads low
+
+    // Implausible values (bus glitch) are ignored
+    TEST_ASSERT_FALSE(envUpdate(&env, 130.0f, 50.0f, 2000));
+    TEST_ASSERT_FALSE(envUpdate(&env, 30.0f, 101.0f, 2000));
+    TEST_ASSERT_FALSE(envUpdate(&env, NAN, 50.0f, 2000));
+    TEST_ASSERT_EQUAL_FLOAT(34.0f, env.temperature_c);
+
+    TEST_ASSERT_FALSE(envExpire(&env, 1000 + ENV_STALE_MS - 1));
+    TEST_ASSERT_TRUE(envExpire(&env, 1000 + ENV_STALE_MS));
+    TEST_ASSERT_EQUAL_UINT8(ENV_SOURCE_DEFAULT, env.source);
+    TEST_ASSERT_EQUAL_FLOAT(ENV_DEFAULT_TEMPERATURE_C, env.temperature_c);
+    TEST_ASSERT_FALSE(envExpire(&env, 1000 + 2 * ENV_STALE_MS));
+}
+
+void test_sht3x_frame_decode() {
+    const uint8_t crc_vector[] = { 0xBE, 0xEF };
+    TEST_ASSERT_EQUAL_HEX8(0x92, envSht3xCrc(crc_vector, sizeof(crc_vector)));
+
+    // 0x6666 -> 25.0 C, 0x8000 -> 50.0 %RH
+    uint8_t frame[ENV_SHT3X_FRAME_SIZE] = { 0x66, 0x66, 0, 0x80, 0x00, 0 };
+    frame[2] = envSht3xCrc(frame, 2);
+    frame[5] = envSht3xCrc(frame + 3, 2);
+
+    float t = 0.0f, h = 0.0f;
+    TEST_ASSERT_TRUE(envSht3xDecode(frame, &t, &h));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 25.0f, t);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, h);
+
+    frame[4] ^= 0x01;
+    TEST_ASSERT_FALSE(envSht3xDecode(frame, &t, &h));
+}
+
+void test_hot_bin_range_error_removed() {
+    // 100 cm at 40 C: the old fixed 343 m/s reads ~3.5% short
+    float speed = exactSoundSpeed(40.0f, 70.0f);
+    float echo_us = 2.0f * 100.0f / speed;
+
+    float fixed_cm = echo_us * 0.0343f / 2.0f;
+    TEST_ASSERT_TRUE(100.0f - fixed_cm > 3.0f);
+
+    EnvCompensation_t env;
+    envInit(&env);
+    envUpdate(&env, 40.0f, 70.0f, 0);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 100.0f, echo_us * env.sound_speed_cm_us / 2.0f);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_defaults_leave_readings_unchanged);
+    RUN_TEST(test_sound_table_matches_formula);
+    RUN_TEST(test_mq135_table_matches_datasheet_fit);
+    RUN_TEST(test_sensor_readings_and_stale_fallback);
+    RUN_TEST(test_sht3x_frame_decode);
+    RUN_TEST(test_hot_bin_range_error_removed);
+    return UNITY_END();
+}
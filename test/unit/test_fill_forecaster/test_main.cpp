@@ -0,0 +1,165 @@
+/**
+ * BINSAI Unit Test - Fill Forecaster
+ * Replays synthetic fill traces and checks time-to-full accuracy.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <FillForecaster.h>
+
+#define TRACE_START_S       1767225600UL   // 2026-01-01 00:00 UTC (Thursday)
+#define TRACE_STEP_S        60             // One sample per minute
+#define HOUR_S              3600UL
+
+static FillForecastState_t state;
+
+/**
+ * Deterministic noise in [-amplitude, amplitude]
+ */
+static float traceNoise(uint32_t* seed, float amplitude) {
+    *seed = *seed * 1664525UL + 1013904223UL;
+    return ((float)(*seed >> 8) / (float)(1UL << 24) * 2.0f - 1.0f) * amplitude;
+}
+
+/**
+ * Fill rate of the weekly trace: weekends (local time) fill three times faster
+ */
+static float weeklyRate(uint32_t t) {
+    uint8_t day = forecastDayOfWeek(t);
+    return (day == 0 || day == 6) ? 3.0f : 1.0f;
+}
+
+void setUp() {
+    forecastInit(&state, TRACE_START_S);
+}
+
+void tearDown() {}
+
+void test_state_validity() {
+    TEST_ASSERT_TRUE(forecastIsValid(&state));
+    FillForecastState_t garbage;
+    memset(&garbage, 0xA5, sizeof(garbage));
+    TEST_ASSERT_FALSE(forecastIsValid(&garbage));
+}
+
+void test_unknown_until_enough_buckets() {
+    for (uint32_t t = TRACE_START_S; t < TRACE_START_S + HOUR_S / 2; t += TRACE_STEP_S) {
+        forecastUpdate(&state, 10.0f, t);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(FORECAST_UNKNOWN, forecastHoursToFull(&state, TRACE_START_S + HOUR_S / 2));
+}
+
+void test_linear_trace_with_noise() {
+    uint32_t seed = 1;
+    uint32_t t = TRACE_START_S;
+    float fill = 0.0f;
+
+    // 2 %/h for 25 h -> 50% full, 25 h remaining
+    for (; t < TRACE_START_S + 25 * HOUR_S; t += TRACE_STEP_S) {
+        fill = 2.0f * (float)(t - TRACE_START_S) / HOUR_S;
+        forecastUpdate(&state, fill + traceNoise(&seed, 1.5f), t);
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 2.0f, forecastFillRate(&state));
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 25.0f, forecastHoursToFull(&state, t));
+}
+
+void test_flat_trace_reports_horizon() {
+    for (uint32_t t = TRACE_START_S; t < TRACE_START_S + 6 * HOUR_S; t += TRACE_STEP_S) {
+        forecastUpdate(&state, 30.0f, t);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(FORECAST_HORIZON_HOURS, forecastHoursToFull(&state, TRACE_START_S + 6 * HOUR_S));
+}
+
+void test_full_bin_reports_zero() {
+    for (uint32_t t = TRACE_START_S; t < TRACE_START_S + 6 * HOUR_S; t += TRACE_STEP_S) {
+        forecastUpdate(&state, 100.0f, t);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, forecastHoursToFull(&state, TRACE_START_S + 6 * HOUR_S));
+}
+
+void test_collection_restarts_trend() {
+    uint32_t t = TRACE_START_S;
+    for (; t < TRACE_START_S + 10 * HOUR_S; t += TRACE_STEP_S) {
+        forecastUpdate(&state, 5.0f * (float)(t - TRACE_START_S) / HOUR_S, t);
+    }
+    forecastUpdate(&state, 2.0f, t);
+    TEST_ASSERT_EQUAL_UINT32(1, state.collections);
+    TEST_ASSERT_EQUAL_FLOAT(FORECAST_UNKNOWN, forecastHoursToFull(&state, t));
+}
+
+void test_clock_going_backwards_restarts_window() {
+    for (uint32_t t = TRACE_START_S; t < TRACE_START_S + 6 * HOUR_S; t += TRACE_STEP_S) {
+        forecastUpdate(&state, 2.0f * (float)(t - TRACE_START_S) / HOUR_S, t);
+    }
+    // Uptime-based clock after a reboot
+    forecastUpdate(&state, 12.0f, 30);
+    TEST_ASSERT_EQUAL_FLOAT(FORECAST_UNKNOWN, forecastHoursToFull(&state, 30));
+    TEST_ASSERT_FALSE(forecastUpdate(&state, 12.0f, 90));
+}
+
+void test_ring_is_bounded() {
+    for (uint32_t t = TRACE_START_S; t < TRACE_START_S + 48 * HOUR_S; t += TRACE_STEP_S) {
+        forecastUpdate(&state, 50.0f, t);
+    }
+    TEST_ASSERT_EQUAL_UINT8(FORECAST_RING_SIZE, state.ring_count);
+    TEST_ASSERT_EQUAL_UINT8(100, state.ring[(state.ring_head + FORECAST_RING_SIZE - 1) % FORECAST_RING_SIZE]);
+}
+
+/**
+ * Replay five weeks of a weekday/weekend trace with collections at 95%.
+ * Forecasts from the last week are scored against the true time-to-full.
+ */
+void test_weekly_trace_replay_accuracy() {
+    uint32_t seed = 7;
+    const uint32_t end_s = TRACE_START_S + 35 * 24 * HOUR_S;
+    const uint32_t score_from_s = end_s - 7 * 24 * HOUR_S;
+    float fill = 0.0f;
+    float error_sum = 0.0f;
+    uint32_t scored = 0;
+
+    for (uint32_t t = TRACE_START_S; t < end_s; t += TRACE_STEP_S) {
+        fill += weeklyRate(t) * TRACE_STEP_S / HOUR_S;
+        if (fill >= 95.0f) fill = 0.0f;              // Collection
+        forecastUpdate(&state, fill + traceNoise(&seed, 1.0f), t);
+
+        // Score hourly while the bin is between 20% and 80%
+        if (t >= score_from_s && (t - TRACE_START_S) % HOUR_S == 0 && fill > 20.0f && fill < 80.0f) {
+            float predicted = forecastHoursToFull(&state, t);
+            if (predicted == FORECAST_UNKNOWN) continue;
+
+            // Ground truth: integrate the trace rate until 100%
+            float actual = 0.0f;
+            float level = fill;
+            for (uint32_t u = t; level < 100.0f; u += TRACE_STEP_S) {
+                level += weeklyRate(u) * TRACE_STEP_S / HOUR_S;
+                actual += (float)TRACE_STEP_S / HOUR_S;
+            }
+
+            error_sum += fabsf(predicted - actual) / actual;
+            scored++;
+        }
+    }
+
+    float mean_relative_error = error_sum / scored;
+    printf("[FORECAST] weekly replay: %u forecasts, mean relative error %.1f%%\n",
+           (unsigned)scored, mean_relative_error * 100.0f);
+    TEST_ASSERT_GREATER_THAN(50, scored);
+    TEST_ASSERT_LESS_THAN(0.20f, mean_relative_error);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_state_validity);
+    RUN_TEST(test_unknown_until_enough_buckets);
+    RUN_TEST(test_linear_trace_with_noise);
+    RUN_TEST(test_flat_trace_reports_horizon);
+    RUN_TEST(test_full_bin_reports_zero);
+    RUN_TEST(test_collection_restarts_trend);
+    RUN_TEST(test_clock_going_backwards_restarts_window);
+    RUN_TEST(test_ring_is_bounded);
+    RUN_TEST(test_weekly_trace_replay_accuracy);
+    return UNITY_END();
+}
@@ -0,0 +1,558 @@
+/**
+ * BINSAI Unit Test - Firmware Update
+ * Verifies SHA-512 / Ed25519 against published vectors, LZSS and delta
+ * round trips, signed slot updates and the health-checked rollback.
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <DeltaPatch.h>
+#include <Ed25519.h>
+#include <FirmwareUpdate.h>
+#include <LzssCodec.h>
+#include <Sha512.h>
+
+static void fromHex(const char* hex, uint8_t* out) {
+    for (size_t i = 0; hex[2 * i]; i++) {
+        unsigned value = 0;
+        for (int k = 0; k < 2; k++) {
+            char c = hex[2 * i + k];
+            value = value * 16 + (c <= '9' ? c - '0' : c - 'a' + 10);
+        }
+        out[i] = (uint8_t)value;
+    }
+}
+
+/**
+ * Deterministic "app image": opcode-like words with absolute addresses that
+ * move when code is inserted, like a relinked ESP32 build
+ */
+static std::vector<uint8_t> makeImage(size_t size, size_t insert_at, size_t insert_length) {
+    std::vector<uint8_t> image;
+    uint32_t state = 12345;
+    uint32_t inserted = 777;
+    for (size_t word = 0; image.size() < size; word++) {
+        if (insert_length && word * 4 == insert_at) {
+            for (size_t i = 0; i < insert_length; i++) {
+                inserted = inserted * 1103515245UL + 12345;
+                image.push_back((uint8_t)(inserted >> 16));
+            }
+        }
+        state = state * 1103515245UL + 12345;
+        uint32_t value = (state >> 8) % 6 == 0
+                             ? 0x400D0000UL + ((state >> 4) & 0xFFFC) + (word * 4 >= insert_at ? insert_length : 0)
+                             : (state >> 8) & 0x00FF0F3F;
+        for (int i = 0; i < 4; i++) {
+            image.push_back((uint8_t)(value >> (8 * i)));
+        }
+    }
+    image.resize(size);
+    return image;
+}
+
+/**
+ * Two RAM app slots and a boot record
+ */
+class RamFirmwareBackend : public FirmwareUpdateBackend {
+public:
+    std::vector<uint8_t> slots[2];
+    uint8_t running;
+    uint8_t boot;
+    bool open;
+    uint32_t aborts;
+    uint32_t confirms;
+    FirmwareBootRecord_t record;
+    bool has_record;
+
+    void reset(const std::vector<uint8_t>& image) {
+        slots[0] = image;
+        slots[1].assign(64, 0xFF);
+        running = 0;
+        boot = 0;
+        open = false;
+        aborts = 0;
+        confirms = 0;
+        has_record = false;
+    }
+
+    void restart() { running = boot; }
+
+    bool readSource(uint32_t offset, void* buffer, size_t length) override {
+        if (offset + length > slots[running].size()) return false;
+        memcpy(buffer, slots[running].data() + offset, length);
+        return true;
+    }
+
+    bool writeTarget(const void* data, size_t length) override {
+        if (!open) return false;
+        const uint8_t* bytes = (const uint8_t*)data;
+        slots[1 - running].insert(slots[1 - running].end(), bytes, bytes + length);
+        return true;
+    }
+
+    bool beginUpdate(uint32_t) override {
+        slots[1 - running].clear();
+        open = true;
+        return true;
+    }
+
+    bool finishUpdate() override {
+        open = false;
+        return true;
+    }
+
+    void abortUpdate() override {
+        open = false;
+        aborts++;
+    }
+
+    bool switchSlot() override {
+        boot = 1 - running;
+        return true;
+    }
+
+    void confirmSlot() override { confirms++; }
+
+    bool loadBootRecord(FirmwareBootRecord_t* out) override {
+        if (!has_record) return false;
+        *out = record;
+        return true;
+    }
+
+    bool saveBootRecord(const FirmwareBootRecord_t& in) override {
+        record = in;
+        has_record = true;
+        return true;
+    }
+};
+
+static const char* SIGNING_SEED_HEX = "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb";
+static const uint32_t RUNNING_SECURITY_VERSION = 7;
+
+static RamFirmwareBackend backend;
+static uint8_t seed[ED25519_SEED_SIZE];
+static uint8_t public_key[ED25519_PUBLIC_KEY_SIZE];
+
+/**
+ * Build a signed update file the way binsai-fleet ota-pack does
+ */
+static FirmwareManifest_t makeManifest(const std::vector<uint8_t>& base, const std::vector<uint8_t>& image,
+                                       bool delta, std::vector<uint8_t>* payload) {
+    FirmwareManifest_t manifest;
+    memset(&manifest, 0, sizeof(manifest));
+    manifest.magic = FIRMWARE_MANIFEST_MAGIC;
+    manifest.format = FIRMWARE_MANIFEST_FORMAT;
+    strcpy(manifest.version, "2.1.0");
+    manifest.security_version = RUNNING_SECURITY_VERSION + 1;
+    manifest.target_size = (uint32_t)image.size();
+    Sha512::hash(image.data(), image.size(), manifest.target_digest);
+
+    payload->clear();
+    if (delta) {
+        manifest.flags = FIRMWARE_FLAG_DELTA;
+        manifest.source_size = (uint32_t)base.size();
+        Sha512::hash(base.data(), base.size(), manifest.source_digest);
+        deltaPatchCreate(base.data(), base.size(), image.data(), image.size(), payload, NULL);
+    } else {
+        deltaPatchCreate(NULL, 0, image.data(), image.size(), payload, NULL);
+    }
+    manifest.payload_size = (uint32_t)payload->size();
+    firmwareManifestSign(&manifest, seed);
+    return manifest;
+}
+
+static FirmwareUpdateStatus_t feed(FirmwareUpdater& updater, const std::vector<uint8_t>& payload, size_t chunk) {
+    FirmwareUpdateStatus_t status = updater.status();
+    for (size_t offset = 0; offset < payload.size() && status == FIRMWARE_UPDATE_RECEIVING; offset += chunk) {
+        size_t length = payload.size() - offset < chunk ? payload.size() - offset : chunk;
+        status = updater.write(payload.data() + offset, length);
+    }
+    return status;
+}
+
+void setUp() {
+    fromHex(SIGNING_SEED_HEX, seed);
+    ed25519PublicKey(seed, public_key);
+}
+
+void tearDown() {}
+
+// ============================================================================
+// PRIMITIVES
+// ============================================================================
+
+void test_sha512_matches_fips_vectors_and_streams() {
+    uint8_t digest[SHA512_DIGEST_SIZE];
+    uint8_t expected[SHA512_DIGEST_SIZE];
+
+    Sha512::hash("abc", 3, digest);
+    fromHex("ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+            "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f", expected);
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, SHA512_DIGEST_SIZE);
+
+    Sha512::hash("", 0, digest);
+    fromHex("cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+            "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e", expected);
+    TEST_ASSERT_EQUAL_MEMORY(expected, digest, SHA512_DIGEST_SIZE);
+
+    // Odd-sized updates across block boundaries equal one-shot
+    std::vector<uint8_t> data = makeImage(1000, 0, 0);
+    uint8_t streamed[SHA512_DIGEST_SIZE];
+    Sha512 sha;
+    for (size_t offset = 0; offset < data.size(); offset += 37) {
+        sha.update(data.data() + offset, data.size() - offset < 37 ? data.size() - offset : 37);
+    }
+    sha.finish(streamed);
+    Sha512::hash(data.data(), data.size(), digest);
+    TEST_ASSERT_EQUAL_MEMORY(digest, streamed, SHA512_DIGEST_SIZE);
+}
+
+void test_ed25519_matches_rfc8032_and_rejects_tampering() {
+    uint8_t key_seed[ED25519_SEED_SIZE], key[ED25519_PUBLIC_KEY_SIZE], expected[ED25519_SIGNATURE_SIZE];
+    uint8_t derived[ED25519_PUBLIC_KEY_SIZE], signature[ED25519_SIGNATURE_SIZE];
+
+    // RFC 8032 section 7.1, TEST 1 (empty message)
+    fromHex("9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60", key_seed);
+    fromHex("d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a", key);
+    fromHex("e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555"
+            "fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b", expected);
+    ed25519PublicKey(key_seed, derived);
+    TEST_ASSERT_EQUAL_MEMORY(key, derived, ED25519_PUBLIC_KEY_SIZE);
+    ed25519Sign(key_seed, key, "", 0, signature);
+    TEST_ASSERT_EQUAL_MEMORY(expected, signature, ED25519_SIGNATURE_SIZE);
+    TEST_ASSERT_TRUE(ed25519Verify(key, "", 0, signature));
+
+    // TEST 2 (one byte 0x72)
+    const uint8_t message = 0x72;
+    fromHex("3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c", key);
+    fromHex("92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da"
+            "085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00", expected);
+    TEST_ASSERT_TRUE(ed25519Verify(key, &message, 1, expected));
+
+    const uint8_t other = 0x73;
+    TEST_ASSERT_FALSE(ed25519Verify(key, &other, 1, expected));
+    expected[10] ^= 0x01;
+    TEST_ASSERT_FALSE(ed25519Verify(key, &message, 1, expected));
+    expected[10] ^= 0x01;
+    expected[63] |= 0xF0;           // S >= L must be rejected, not reduced
+    TEST_ASSERT_FALSE(ed25519Verify(key, &message, 1, expected));
+}
+
+void test_lzss_round_trip_in_small_chunks() {
+    std::vector<uint8_t> data = makeImage(20000, 0, 0);
+    data.insert(data.end(), 5000, 0x00);
+    std::vector<uint8_t> packed;
+    lzssCompress(data.data(), data.size(), &packed);
+    TEST_ASSERT_TRUE(packed.size() < data.size());
+
+    LzssDecoder decoder;
+    std::vector<uint8_t> unpacked;
+    uint8_t out[33];
+    for (size_t offset = 0; offset < packed.size();) {
+        size_t chunk = packed.size() - offset < 5 ? packed.size() - offset : 5;
+        size_t consumed = 0;
+        size_t produced;
+        do {
+            produced = decoder.decode(packed.data() + offset, chunk, &consumed, out, sizeof(out));
+            unpacked.insert(unpacked.end(), out, out + produced);
+            offset += consumed;
+            chunk -= consumed;
+        } while (produced == sizeof(out));
+    }
+    TEST_ASSERT_FALSE(decoder.corrupt());
+    TEST_ASSERT_EQUAL_UINT32(data.size(), unpacked.size());
+    TEST_ASSERT_TRUE(unpacked == data);
+
+    // Back-reference before the first byte
+    const uint8_t bogus[] = { 0x00, 0x10, 0x00 };
+    size_t consumed;
+    decoder.reset();
+    decoder.decode(bogus, sizeof(bogus), &consumed, out, sizeof(out));
+    TEST_ASSERT_TRUE(decoder.corrupt());
+}
+
+// ============================================================================
+// DELTA PATCH
+// ============================================================================
+
+class VectorPatchIo : public PatchSource, public PatchSink {
+public:
+    const std::vector<uint8_t>* source;
+    std::vector<uint8_t> target;
+
+    bool readSource(uint32_t offset, void* buffer, size_t length) override {
+        if (offset + length > source->size()) return false;
+        memcpy(buffer, source->data() + offset, length);
+        return true;
+    }
+
+    bool writeTarget(const void* data, size_t length) override {
+        target.insert(target.end(), (const uint8_t*)data, (const uint8_t*)data + length);
+        return true;
+    }
+};
+
+void test_delta_patch_rebuilds_relinked_image() {
+    std::vector<uint8_t> base = makeImage(96 * 1024, 0xFFFFFFF, 0);
+    std::vector<uint8_t> image = makeImage(97 * 1024, 40000, 1024);
+    image[70000] ^= 0x5A;
+
+    std::vector<uint8_t> patch, full;
+    DeltaPatchStats_t delta_stats, full_stats;
+    deltaPatchCreate(base.data(), base.size(), image.data(), image.size(), &patch, &delta_stats);
+    deltaPatchCreate(NULL, 0, image.data(), image.size(), &full, &full_stats);
+    TEST_ASSERT_EQUAL_UINT32(patch.size(), delta_stats.patch_bytes);
+    TEST_ASSERT_EQUAL_UINT32(image.size(), delta_stats.diff_bytes + delta_stats.extra_bytes);
+    TEST_ASSERT_TRUE(patch.size() * 4 < full.size());
+
+    const size_t chunks[] = { 1, 13, 1500, patch.size() };
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        VectorPatchIo io;
+        io.source = &base;
+        DeltaPatchApplier applier(io, io);
+        DeltaApplyStatus_t status = DELTA_APPLY_RUNNING;
+        for (size_t offset = 0; offset < patch.size(); offset += chunks[c]) {
+            size_t length = patch.size() - offset < chunks[c] ? patch.size() - offset : chunks[c];
+            status = applier.write(patch.data() + offset, length);
+        }
+        TEST_ASSERT_EQUAL_INT(DELTA_APPLY_DONE, status);
+        TEST_ASSERT_TRUE(io.target == image);
+    }
+
+    // Full image: no source reads at all
+    std::vector<uint8_t> empty;
+    VectorPatchIo io;
+    io.source = &empty;
+    DeltaPatchApplier applier(io, io);
+    TEST_ASSERT_EQUAL_INT(DELTA_APPLY_DONE, applier.write(full.data(), full.size()));
+    TEST_ASSERT_TRUE(io.target == image);
+}
+
+void test_delta_patch_rejects_bad_header_and_short_source() {
+    std::vector<uint8_t> base = makeImage(8192, 0xFFFFFFF, 0);
+    std::vector<uint8_t> image = makeImage(8192, 4096, 64);
+    std::vector<uint8_t> patch;
+    deltaPatchCreate(base.data(), base.size(), image.data(), image.size(), &patch, NULL);
+
+    VectorPatchIo io;
+    io.source = &base;
+    std::vector<uint8_t> bad = patch;
+    bad[0] ^= 0xFF;
+    DeltaPatchApplier applier(io, io);
+    TEST_ASSERT_EQUAL_INT(DELTA_APPLY_BAD_HEADER, applier.write(bad.data(), bad.size()));
+
+    // Base image shorter than the patch expects
+    std::vector<uint8_t> truncated(base.begin(), base.begin() + 1024);
+    io.source = &truncated;
+    io.target.clear();
+    applier.reset();
+    TEST_ASSERT_EQUAL_INT(DELTA_APPLY_SOURCE_ERROR, applier.write(patch.data(), patch.size()));
+}
+
+// ============================================================================
+// SIGNED UPDATE
+// ============================================================================
+
+void test_signed_delta_update_is_verified_and_activated() {
+    std::vector<uint8_t> base = makeImage(64 * 1024, 0xFFFFFFF, 0);
+    std::vector<uint8_t> image = makeImage(66 * 1024, 20000, 2048);
+    std::vector<uint8_t> payload;
+    backend.reset(base);
+    FirmwareManifest_t manifest = makeManifest(base, image, true, &payload);
+
+    FirmwareUpdater updater(backend, public_key, RUNNING_SECURITY_VERSION);
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_RECEIVING, updater.begin(manifest));
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_READY, feed(updater, payload, 512));
+    TEST_ASSERT_TRUE(backend.slots[1] == image);
+    TEST_ASSERT_EQUAL_UINT32(payload.size(), updater.payloadReceived());
+
+    TEST_ASSERT_TRUE(updater.activate());
+    TEST_ASSERT_EQUAL_UINT8(1, backend.boot);
+    TEST_ASSERT_EQUAL_UINT8(FIRMWARE_BOOT_PENDING, backend.record.state);
+    TEST_ASSERT_EQUAL_STRING("2.1.0", backend.record.version);
+}
+
+void test_update_rejects_forged_wrong_base_and_corrupt_payloads() {
+    std::vector<uint8_t> base = makeImage(32 * 1024, 0xFFFFFFF, 0);
+    std::vector<uint8_t> image = makeImage(32 * 1024, 1000, 16);
+    std::vector<uint8_t> payload;
+    backend.reset(base);
+    FirmwareManifest_t manifest = makeManifest(base, image, true, &payload);
+    FirmwareUpdater updater(backend, public_key, RUNNING_SECURITY_VERSION);
+
+    FirmwareManifest_t forged = manifest;
+    strcpy(forged.version, "9.9.9");
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_BAD_SIGNATURE, updater.begin(forged));
+
+    uint8_t other_seed[ED25519_SEED_SIZE] = { 1 };
+    forged = manifest;
+    firmwareManifestSign(&forged, other_seed);
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_BAD_SIGNATURE, updater.begin(forged));
+
+    // Device runs a different build than the delta was made against
+    backend.slots[0][100] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_WRONG_BASE, updater.begin(manifest));
+    backend.slots[0][100] ^= 0x01;
+
+    // Flipped payload bit: either the patch or the final digest catches it
+    std::vector<uint8_t> corrupt = payload;
+    corrupt[corrupt.size() / 2] ^= 0x04;
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_RECEIVING, updater.begin(manifest));
+    FirmwareUpdateStatus_t status = feed(updater, corrupt, 256);
+    TEST_ASSERT_TRUE(status == FIRMWARE_UPDATE_DIGEST_MISMATCH || status == FIRMWARE_UPDATE_PATCH_ERROR);
+    TEST_ASSERT_EQUAL_UINT32(1, backend.aborts);
+    TEST_ASSERT_FALSE(updater.activate());
+    TEST_ASSERT_EQUAL_UINT8(0, backend.boot);
+    TEST_ASSERT_FALSE(backend.has_record);
+}
+
+void test_update_refuses_placeholder_key_and_replayed_releases() {
+    std::vector<uint8_t> base = makeImage(16 * 1024, 0xFFFFFFF, 0);
+    std::vector<uint8_t> image = makeImage(16 * 1024, 512, 32);
+    std::vector<uint8_t> payload;
+    backend.reset(base);
+    FirmwareManifest_t manifest = makeManifest(base, image, false, &payload);
+
+    // All-zero key decodes to a point of order 4: with R = 1*B and S = 1,
+    // every challenge k = 0 (mod 4) used to verify. Try enough versions to
+    // hit several of them
+    const uint8_t zero_key[ED25519_PUBLIC_KEY_SIZE] = { 0 };
+    FirmwareManifest_t forged = manifest;
+    memset(forged.signature, 0x66, 32);
+    forged.signature[0] = 0x58;                         // Base point B
+    memset(forged.signature + 32, 0, 32);
+    forged.signature[32] = 1;
+    for (uint32_t attempt = 0; attempt < 64; attempt++) {
+        forged.security_version = RUNNING_SECURITY_VERSION + 1 + attempt;
+        TEST_ASSERT_FALSE(firmwareManifestVerify(forged, zero_key));
+    }
+
+    FirmwareUpdater placeholder(backend, zero_key, RUNNING_SECURITY_VERSION);
+    TEST_ASSERT_FALSE(placeholder.hasSigningKey());
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_NO_SIGNING_KEY, placeholder.begin(forged));
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_NO_SIGNING_KEY, placeholder.begin(manifest));
+
+    // A genuinely signed but older (or same) release is a downgrade
+    FirmwareUpdater updater(backend, public_key, RUNNING_SECURITY_VERSION);
+    TEST_ASSERT_TRUE(updater.hasSigningKey());
+    FirmwareManifest_t replayed = manifest;
+    replayed.security_version = RUNNING_SECURITY_VERSION;
+    firmwareManifestSign(&replayed, seed);
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_DOWNGRADE, updater.begin(replayed));
+    replayed.security_version = RUNNING_SECURITY_VERSION - 1;
+    firmwareManifestSign(&replayed, seed);
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_DOWNGRADE, updater.begin(replayed));
+    TEST_ASSERT_EQUAL_UINT32(0, backend.aborts);
+
+    // Raising the counter without re-signing breaks the signature
+    replayed.security_version = RUNNING_SECURITY_VERSION + 1;
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_BAD_SIGNATURE, updater.begin(replayed));
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_UPDATE_RECEIVING, updater.begin(manifest));
+}
+
+// ============================================================================
+// BOOT GUARD
+// ============================================================================
+
+/**
+ * Install image as a pending update and restart into it
+ */
+static void bootPendingImage() {
+    std::vector<uint8_t> base = makeImage(16 * 1024, 0xFFFFFFF, 0);
+    std::vector<uint8_t> image = makeImage(16 * 1024, 512, 32);
+    std::vector<uint8_t> payload;
+    backend.reset(base);
+    FirmwareManifest_t manifest = makeManifest(base, image, false, &payload);
+    FirmwareUpdater updater(backend, public_key, RUNNING_SECURITY_VERSION);
+    updater.begin(manifest);
+    feed(updater, payload, 1024);
+    updater.activate();
+    backend.restart();
+}
+
+void test_boot_guard_confirms_healthy_image_after_settle() {
+    bootPendingImage();
+    FirmwareBootGuard guard(backend);
+
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_TRIAL, guard.onBoot(1000, "2.1.0"));
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_TRIAL, guard.loop(5000, true));   // Too early
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_TRIAL, guard.loop(20000, false));
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_HEALTHY, guard.loop(1000 + FIRMWARE_HEALTH_SETTLE_MS, true));
+    TEST_ASSERT_EQUAL_UINT8(FIRMWARE_BOOT_CONFIRMED, backend.record.state);
+    TEST_ASSERT_EQUAL_UINT32(1, backend.confirms);
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_NORMAL, guard.loop(999999, false));
+
+    backend.restart();
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_NORMAL, guard.onBoot(0, "2.1.0"));
+    TEST_ASSERT_EQUAL_UINT8(1, backend.running);
+}
+
+void test_boot_guard_rolls_back_unhealthy_or_crashing_image() {
+    // Never healthy within the window
+    bootPendingImage();
+    FirmwareBootGuard guard(backend);
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_TRIAL, guard.onBoot(0, "2.1.0"));
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_TRIAL, guard.loop(FIRMWARE_HEALTH_WINDOW_MS - 1, false));
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_ROLLBACK, guard.loop(FIRMWARE_HEALTH_WINDOW_MS, false));
+    backend.restart();
+    TEST_ASSERT_EQUAL_UINT8(0, backend.running);
+    TEST_ASSERT_EQUAL_UINT8(FIRMWARE_BOOT_ROLLED_BACK, backend.record.state);
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_NORMAL, guard.onBoot(0, "2.0.0"));
+
+    // Resets before the health check ever runs (watchdog / panic loop)
+    bootPendingImage();
+    for (uint8_t boot = 1; boot <= FIRMWARE_MAX_BOOT_ATTEMPTS; boot++) {
+        TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_TRIAL, guard.onBoot(0, "2.1.0"));
+        backend.restart();
+    }
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_ROLLBACK, guard.onBoot(0, "2.1.0"));
+    backend.restart();
+    TEST_ASSERT_EQUAL_UINT8(0, backend.running);
+
+    // Slot switch never took effect: old build must not switch away
+    bootPendingImage();
+    backend.boot = 0;
+    backend.restart();
+    TEST_ASSERT_EQUAL_INT(FIRMWARE_BOOT_NORMAL, guard.onBoot(0, "2.0.0"));
+    TEST_ASSERT_EQUAL_UINT8(0, backend.boot);
+    TEST_ASSERT_EQUAL_UINT8(FIRMWARE_BOOT_ROLLED_BACK, backend.record.state);
+}
+
+void test_health_verdict_needs_real_sensor_readings() {
+    // Fused distance (blind zone reads 0) with the gas output off the rails
+    TEST_ASSERT_TRUE(firmwareSensorCycleOk(62.5f, 900, 3300));
+    TEST_ASSERT_TRUE(firmwareSensorCycleOk(0.0f, 900, 3300));
+    // Every probe failed, whatever the gas sensor says
+    TEST_ASSERT_FALSE(firmwareSensorCycleOk(-1.0f, 900, 3300));
+    // Gas output pinned at either rail: open or shorted divider
+    TEST_ASSERT_FALSE(firmwareSensorCycleOk(62.5f, 0, 3300));
+    TEST_ASSERT_FALSE(firmwareSensorCycleOk(62.5f, FIRMWARE_HEALTH_RAIL_MV, 3300));
+    TEST_ASSERT_FALSE(firmwareSensorCycleOk(62.5f, 3300 - FIRMWARE_HEALTH_RAIL_MV, 3300));
+    TEST_ASSERT_FALSE(firmwareSensorCycleOk(62.5f, 3300, 3300));
+
+    TEST_ASSERT_TRUE(firmwareHealthy(true, true, 10000, 4000, 14000));
+    TEST_ASSERT_FALSE(firmwareHealthy(true, true, 10000, 4000, 14001));   // Sensors went quiet
+    TEST_ASSERT_FALSE(firmwareHealthy(true, true, 0, 4000, 2000));        // No good cycle yet
+    TEST_ASSERT_FALSE(firmwareHealthy(true, false, 10000, 4000, 12000));  // No uplink
+    TEST_ASSERT_FALSE(firmwareHealthy(false, true, 10000, 4000, 12000));
+    // Across the millis() wrap
+    TEST_ASSERT_TRUE(firmwareHealthy(true, true, 0xFFFFF000UL, 8000, 1000));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_sha512_matches_fips_vectors_and_streams);
+    RUN_TEST(test_ed25519_matches_rfc8032_and_rejects_tampering);
+    RUN_TEST(test_lzss_round_trip_in_small_chunks);
+    RUN_TEST(test_delta_patch_rebuilds_relinked_image);
+    RUN_TEST(test_delta_patch_rejects_bad_header_and_short_source);
+    RUN_TEST(test_signed_delta_update_is_verified_and_activated);
+    RUN_TEST(test_update_rejects_forged_wrong_base_and_corrupt_payloads);
+    RUN_TEST(test_update_refuses_placeholder_key_and_replayed_releases);
+    RUN_TEST(test_boot_guard_confirms_healthy_image_after_settle);
+    RUN_TEST(test_boot_guard_rolls_back_unhealthy_or_crashing_image);
+    RUN_TEST(test_health_verdict_needs_real_sensor_readings);
+    return UNITY_END();
+}
@@ -0,0 +1,410 @@
+/**
+ * BINSAI Unit Test - Fleet Ingest
+ * Telemetry frame round trip, sharded store semantics, UDP loopback runs
+ * with single-frame and batched (GPRS) datagrams.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <TelemetryFrame.h>
+#include <FleetStore.h>
+#include <IngestServer.h>
+#include <LatencyHistogram.h>
+#include <LoadGenerator.h>
+
+static SensorData_t sample;
+static uint8_t frame[TELEMETRY_FRAME_SIZE];
+
+void setUp() {
+    memset(&sample, 0, sizeof(sample));
+    sample.distance_cm = 12.3f;
+    sample.fill_percentage = 67.89f;
+    sample.adc_raw = 1834;
+    sample.ppm_calculated = 512.4f;
+    sample.latitude = -7.7956123;
+    sample.longitude = 110.3694876;
+    sample.satellite_count = 9;
+    sample.hdop = 0.87f;
+    sample.capacity_level = 2;
+    sample.waste_classification = 2;
+    sample.priority_level = 1;
+    sample.timestamp_unix = 1767225600UL;
+    sample.timestamp_millis = 123456;
+    sample.hours_to_full = 17.25f;
+}
+
+void tearDown() {}
+
+static size_t encode(const char* id, uint32_t sequence, uint8_t boot_epoch = 0) {
+    TelemetryFrameMeta_t meta;
+    meta.device_id = id;
+    meta.sequence = sequence;
+    meta.flags = TELEMETRY_FLAG_GPS_FIX;
+    meta.deployment_zone = 4;
+    meta.trace_us = 0;
+    meta.boot_epoch = boot_epoch;
+    return telemetryEncode(sample, meta, frame, sizeof(frame));
+}
+
+void test_frame_round_trip() {
+    TEST_ASSERT_EQUAL(TELEMETRY_FRAME_SIZE, encode("BINSAI-AA:BB:CC", 7));
+
+    TelemetryFrameView view(frame, sizeof(frame));
+    TEST_ASSERT_TRUE(view.validate());
+    TEST_ASSERT_EQUAL_UINT32(7, view.sequence());
+    TEST_ASSERT_EQUAL_UINT8(4, view.deploymentZone());
+    TEST_ASSERT_EQUAL_UINT8(0, view.bootEpoch());
+    TEST_ASSERT_EQUAL_UINT8(1, telemetryBootEpoch(0));
+    TEST_ASSERT_EQUAL_UINT8(255, telemetryBootEpoch(254));
+    TEST_ASSERT_EQUAL_UINT8(1, telemetryBootEpoch(255));
+    TEST_ASSERT_EQUAL(15, view.deviceIdLength());
+    TEST_ASSERT_EQUAL_INT(0, strncmp("BINSAI-AA:BB:CC", view.deviceId(), 15));
+
+    SensorData_t decoded;
+    view.decode(&decoded);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 67.89f, decoded.fill_percentage);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 12.3f, decoded.distance_cm);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 512.4f, decoded.ppm_calculated);
+    TEST_ASSERT_EQUAL_UINT16(1834, decoded.adc_raw);
+    TEST_ASSERT_TRUE(fabs(decoded.latitude - sample.latitude) < 1e-7);
+    TEST_ASSERT_TRUE(fabs(decoded.longitude - sample.longitude) < 1e-7);
+    TEST_ASSERT_EQUAL_UINT8(9, decoded.satellite_count);
+    TEST_ASSERT_EQUAL_UINT32(1767225600UL, decoded.timestamp_unix);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 17.3f, decoded.hours_to_full);
+}
+
+void test_crc16_check_value() {
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, telemetryCrc16(check, sizeof(check)));
+}
+
+void test_frame_saturates_and_keeps_unknown_forecast() {
+    sample.ppm_calculated = 99999.0f;
+    sample.fill_percentage = -5.0f;
+    sample.hours_to_full = -1.0f;
+    encode("X", 1);
+
+    TelemetryFrameView view(frame, sizeof(frame));
+    TEST_ASSERT_EQUAL_UINT16(65535, view.ppmDeci());
+    TEST_ASSERT_EQUAL_UINT16(0, view.fillCentiPercent());
+    TEST_ASSERT_EQUAL_INT16(-10, view.hoursToFullDeci());
+}
+
+void test_frame_rejects_corruption() {
+    encode("BINSAI-AA:BB:CC", 1);
+    TEST_ASSERT_FALSE(TelemetryFrameView(frame, TELEMETRY_FRAME_SIZE - 1).validate());
+
+    frame[41] ^= 0x01;
+    TEST_ASSERT_FALSE(TelemetryFrameView(frame, sizeof(frame)).validate());
+    TelemetryFrameMeta_t meta = {"X", 1, 0, 0, 0, 0};
+    TEST_ASSERT_EQUAL(0, telemetryEncode(sample, meta, frame, TELEMETRY_FRAME_SIZE - 1));
+}
+
+void test_store_sequence_tracking() {
+    FleetStore store(4);
+    encode("BIN-1", 10);
+    TEST_ASSERT_EQUAL(FLEET_INGEST_NEW_BIN, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 1));
+    TEST_ASSERT_EQUAL(FLEET_INGEST_DUPLICATE, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 2));
+
+    encode("BIN-1", 13);  // 11 and 12 lost
+    TEST_ASSERT_EQUAL(FLEET_INGEST_OK, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 3));
+    encode("BIN-1", 12);  // Late arrival
+    TEST_ASSERT_EQUAL(FLEET_INGEST_DUPLICATE, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 4));
+
+    frame[0] = 0;
+    TEST_ASSERT_EQUAL(FLEET_INGEST_INVALID, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 5));
+
+    BinState_t state;
+    TEST_ASSERT_TRUE(store.lookup("BIN-1", &state));
+    TEST_ASSERT_EQUAL_UINT32(13, state.last_sequence);
+    TEST_ASSERT_EQUAL_UINT32(2, state.frames_accepted);
+    TEST_ASSERT_EQUAL_UINT32(2, state.frames_duplicate);
+    TEST_ASSERT_EQUAL_UINT32(2, state.frames_lost);
+    TEST_ASSERT_EQUAL_UINT16(6789, state.latest.fill_centi);
+    TEST_ASSERT_FALSE(store.lookup("BIN-2", &state));
+}
+
+void test_store_accepts_device_restart() {
+    FleetStore store(1);
+    sample.fill_percentage = 40.0f;
+    for (uint32_t sequence = 1; sequence <= 1000; sequence++) {
+        encode("BIN-R", sequence, 7);
+        store.ingest(TelemetryFrameView(frame, sizeof(frame)), sequence);
+    }
+
+    // Reboot: the sequence starts again at 1 under the next boot epoch
+    sample.fill_percentage = 75.0f;
+    for (uint32_t sequence = 1; sequence <= 500; sequence++) {
+        encode("BIN-R", sequence, 8);
+        TEST_ASSERT_EQUAL(FLEET_INGEST_OK, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 1000 + sequence));
+    }
+
+    // Queued before the reboot, delivered after it
+    encode("BIN-R", 1001, 7);
+    TEST_ASSERT_EQUAL(FLEET_INGEST_DUPLICATE, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 2000));
+    encode("BIN-R", 500, 8);
+    TEST_ASSERT_EQUAL(FLEET_INGEST_DUPLICATE, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 2001));
+
+    // The epoch cycles through 1..255
+    encode("BIN-R", 1, 0x80);
+    TEST_ASSERT_EQUAL(FLEET_INGEST_OK, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 2002));
+    encode("BIN-R", 1, 0xFF);
+    TEST_ASSERT_EQUAL(FLEET_INGEST_OK, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 2003));
+    encode("BIN-R", 1, 0x01);
+    TEST_ASSERT_EQUAL(FLEET_INGEST_OK, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 2004));
+
+    BinState_t state;
+    TEST_ASSERT_TRUE(store.lookup("BIN-R", &state));
+    TEST_ASSERT_EQUAL_UINT32(1503, state.frames_accepted);
+    TEST_ASSERT_EQUAL_UINT32(4, state.restarts);
+    TEST_ASSERT_EQUAL_UINT32(0, state.frames_lost);
+    TEST_ASSERT_EQUAL_UINT32(2, state.frames_duplicate);
+    TEST_ASSERT_EQUAL_UINT16(7500, state.latest.fill_centi);
+}
+
+void test_store_sequence_wraps() {
+    FleetStore store(1);
+    encode("BIN-W", 0xFFFFFFFFUL);
+    store.ingest(TelemetryFrameView(frame, sizeof(frame)), 0);
+    encode("BIN-W", 0);
+    TEST_ASSERT_EQUAL(FLEET_INGEST_OK, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 0));
+}
+
+void test_store_history_ring() {
+    FleetStore store(2);
+    for (uint32_t i = 1; i <= FLEET_HISTORY_DEPTH + 10; i++) {
+        sample.fill_percentage = (float)i / 10.0f;
+        encode("BIN-H", i);
+        store.ingest(TelemetryFrameView(frame, sizeof(frame)), i);
+    }
+
+    BinSample_t history[FLEET_HISTORY_DEPTH];
+    TEST_ASSERT_EQUAL(FLEET_HISTORY_DEPTH, store.history("BIN-H", history, FLEET_HISTORY_DEPTH));
+    TEST_ASSERT_EQUAL_UINT32(11, history[0].received_ms);
+    TEST_ASSERT_EQUAL_UINT32(FLEET_HISTORY_DEPTH + 10, history[FLEET_HISTORY_DEPTH - 1].received_ms);
+
+    TEST_ASSERT_EQUAL(3, store.history("BIN-H", history, 3));
+    TEST_ASSERT_EQUAL_UINT32(FLEET_HISTORY_DEPTH + 8, history[0].received_ms);
+}
+
+void test_store_many_bins_across_shards() {
+    FleetStore store(8);
+    char id[TELEMETRY_DEVICE_ID_LEN + 1];
+    for (uint32_t i = 0; i < 5000; i++) {
+        loadGeneratorDeviceId(i, id, sizeof(id));
+        sample.adc_raw = (uint16_t)i;
+        encode(id, 1);
+        TEST_ASSERT_EQUAL(FLEET_INGEST_NEW_BIN, store.ingest(TelemetryFrameView(frame, sizeof(frame)), 0));
+    }
+    TEST_ASSERT_EQUAL(5000, store.binCount());
+
+    size_t visited = 0;
+    store.forEach([&visited](const BinState_t&) { visited++; });
+    TEST_ASSERT_EQUAL(5000, visited);
+
+    BinState_t state;
+    loadGeneratorDeviceId(4321, id, sizeof(id));
+    TEST_ASSERT_TRUE(store.lookup(id, &state));
+    TEST_ASSERT_EQUAL_STRING(id, state.device_id);
+}
+
+void test_store_spatial_queries() {
+    FleetStore store(4);
+    char id[TELEMETRY_DEVICE_ID_LEN + 1];
+    double base_latitude = sample.latitude;
+    for (uint32_t i = 0; i < 20; i++) {
+        loadGeneratorDeviceId(i, id, sizeof(id));
+        sample.latitude = base_latitude + i * 0.001;     // ~111 m apart
+        sample.priority_level = (i % 2) ? 3 : 0;
+        encode(id, 1);
+        store.ingest(TelemetryFrameView(frame, sizeof(frame)), 0);
+    }
+
+    std::vector<SpatialHit_t> hits;
+    TEST_ASSERT_EQUAL(5, store.binsWithinRadius(base_latitude, sample.longitude, 1100.0, 3, &hits));
+    BinState_t state;
+    TEST_ASSERT_TRUE(store.lookupHash(hits[0].id, &state));
+    TEST_ASSERT_EQUAL_STRING("SIM-000001", state.device_id);
+
+    TEST_ASSERT_EQUAL(2, store.nearestBins(base_latitude, sample.longitude, 2, 0, &hits));
+    std::vector<uint64_t> zone;
+    TEST_ASSERT_EQUAL(20, store.binsInZone(4, &zone));
+
+    // Losing the GPS fix takes the bin out of spatial queries
+    sample.latitude = base_latitude;
+    sample.priority_level = 0;
+    TelemetryFrameMeta_t meta = {"SIM-000000", 2, 0, 4, 0, 0};
+    telemetryEncode(sample, meta, frame, sizeof(frame));
+    store.ingest(TelemetryFrameView(frame, sizeof(frame)), 0);
+    TEST_ASSERT_EQUAL(19, store.binsInZone(4, &zone));
+    store.nearestBins(base_latitude, sample.longitude, 1, 0, &hits);
+    TEST_ASSERT_TRUE(store.lookupHash(hits[0].id, &state));
+    TEST_ASSERT_EQUAL_STRING("SIM-000001", state.device_id);
+}
+
+void test_latency_histogram_percentiles() {
+    LatencyHistogram histogram;
+    for (uint32_t i = 1; i <= 1000; i++) {
+        histogram.record(i);
+    }
+    TEST_ASSERT_EQUAL_UINT64(1000, histogram.count());
+    TEST_ASSERT_EQUAL_UINT32(1000, histogram.max());
+    // Bucket upper bound, within ~3% above the exact value
+    TEST_ASSERT_UINT32_WITHIN(16, 508, histogram.percentile(50));
+    TEST_ASSERT_UINT32_WITHIN(32, 1000, histogram.percentile(99));
+    TEST_ASSERT_EQUAL_UINT32(10, histogram.percentile(1));
+
+    LatencyHistogram other;
+    other.record(0xFFFFFFFFUL);
+    histogram.merge(other);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFUL, histogram.percentile(100));
+}
+
+void test_udp_loopback_ingest() {
+    FleetStore store;
+    IngestServer server(store);
+    TEST_ASSERT_TRUE(server.start(0, 2));
+
+    LoadGeneratorConfig_t config;
+    loadGeneratorDefaults(&config);
+    config.port = server.port();
+    config.bin_count = 500;
+    config.rate_per_second = 20000;
+    config.duration_ms = 200;
+    LoadGeneratorResult_t result = runLoadGenerator(config);
+
+    for (int i = 0; i < 50 && server.stats().datagrams < result.frames_sent; i++) {
+        usleep(10000);
+    }
+    server.stop();
+
+    IngestStats_t stats = server.stats();
+    TEST_ASSERT_TRUE(result.frames_sent > 0);
+    TEST_ASSERT_EQUAL_UINT64(result.frames_sent, stats.accepted);
+    TEST_ASSERT_EQUAL_UINT64(500, stats.new_bins);
+    TEST_ASSERT_EQUAL(500, store.binCount());
+
+    LatencyHistogram latency;
+    server.latency(&latency);
+    TEST_ASSERT_EQUAL_UINT64(stats.accepted, latency.count());
+}
+
+void test_udp_batched_datagram() {
+    size_t frames, frame_length;
+    fleetDatagramFrames(TELEMETRY_FRAME_SIZE * 8, &frames, &frame_length);
+    TEST_ASSERT_EQUAL(8, frames);
+    TEST_ASSERT_EQUAL(TELEMETRY_FRAME_SIZE, frame_length);
+    fleetDatagramFrames(TELEMETRY_FRAME_SIZE + 1, &frames, &frame_length);
+    TEST_ASSERT_EQUAL(1, frames);
+    TEST_ASSERT_EQUAL(TELEMETRY_FRAME_SIZE + 1, frame_length);
+
+    FleetStore store;
+    IngestServer server(store);
+    TEST_ASSERT_TRUE(server.start(0, 1));
+
+    // Four frames of one bin in one datagram, then a truncated one
+    uint8_t batch[TELEMETRY_FRAME_SIZE * 4];
+    for (uint32_t i = 0; i < 4; i++) {
+        encode("BIN-GPRS", 10 + i);
+        memcpy(batch + i * TELEMETRY_FRAME_SIZE, frame, TELEMETRY_FRAME_SIZE);
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(server.port());
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_INT((int)sizeof(batch),
+                          (int)sendto(fd, batch, sizeof(batch), 0, (struct sockaddr*)&addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(40, (int)sendto(fd, batch, 40, 0, (struct sockaddr*)&addr, sizeof(addr)));
+    close(fd);
+
+    for (int i = 0; i < 50 && server.stats().datagrams < 2; i++) {
+        usleep(10000);
+    }
+    server.stop();
+
+    IngestStats_t stats = server.stats();
+    TEST_ASSERT_EQUAL_UINT64(2, stats.datagrams);
+    TEST_ASSERT_EQUAL_UINT64(4, stats.accepted);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.new_bins);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.invalid);
+}
+
+/**
+ * Send count single-frame datagrams for one bin to the loopback port
+ */
+static void sendFrames(uint16_t port, const char* device, uint32_t first_sequence, uint32_t count) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    TEST_ASSERT_TRUE(fd >= 0);
+    for (uint32_t i = 0; i < count; i++) {
+        encode(device, first_sequence + i);
+        TEST_ASSERT_EQUAL_INT((int)TELEMETRY_FRAME_SIZE,
+                              (int)sendto(fd, frame, TELEMETRY_FRAME_SIZE, 0, (struct sockaddr*)&addr, sizeof(addr)));
+    }
+    close(fd);
+}
+
+void test_server_restart_drops_old_workers() {
+    FleetStore store;
+    IngestServer server(store);
+    TEST_ASSERT_TRUE(server.start(0, 2));
+    sendFrames(server.port(), "BIN-A", 1, 5);
+    for (int i = 0; i < 50 && server.stats().datagrams < 5; i++) {
+        usleep(10000);
+    }
+    server.stop();
+    TEST_ASSERT_EQUAL_UINT64(5, server.stats().accepted);       // Readable after stop()
+
+    // Second session counts only its own traffic, on its own workers
+    TEST_ASSERT_TRUE(server.start(0, 1));
+    TEST_ASSERT_EQUAL_UINT64(0, server.stats().datagrams);
+    sendFrames(server.port(), "BIN-B", 1, 3);
+    for (int i = 0; i < 50 && server.stats().datagrams < 3; i++) {
+        usleep(10000);
+    }
+    server.stop();
+
+    IngestStats_t stats = server.stats();
+    TEST_ASSERT_EQUAL_UINT64(3, stats.datagrams);
+    TEST_ASSERT_EQUAL_UINT64(3, stats.accepted);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.new_bins);
+    TEST_ASSERT_EQUAL(2, store.binCount());
+
+    // Stopping twice and restarting after that are harmless
+    server.stop();
+    TEST_ASSERT_TRUE(server.start(0, 1));
+    server.stop();
+    TEST_ASSERT_EQUAL_UINT64(0, server.stats().datagrams);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_round_trip);
+    RUN_TEST(test_crc16_check_value);
+    RUN_TEST(test_frame_saturates_and_keeps_unknown_forecast);
+    RUN_TEST(test_frame_rejects_corruption);
+    RUN_TEST(test_store_sequence_tracking);
+    RUN_TEST(test_store_accepts_device_restart);
+    RUN_TEST(test_store_sequence_wraps);
+    RUN_TEST(test_store_history_ring);
+    RUN_TEST(test_store_many_bins_across_shards);
+    RUN_TEST(test_store_spatial_queries);
+    RUN_TEST(test_latency_histogram_percentiles);
+    RUN_TEST(test_udp_loopback_ingest);
+    RUN_TEST(test_udp_batched_datagram);
+    RUN_TEST(test_server_restart_drops_old_workers);
+    return UNITY_END();
+}
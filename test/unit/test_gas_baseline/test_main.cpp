@@ -0,0 +1,179 @@
+/**
+ * BINSAI Unit Test - Gas Baseline
+ * Simulated days of MQ-135 resistance with gas events: point averaging,
+ * the daily clean-air percentile, window median / confidence, and the
+ * R0 update rule.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <GasBaseline.h>
+
+#define CLEAN_AIR_RATIO 3.6f
+#define SAMPLE_S        2
+
+static GasBaselineState_t state;
+static uint32_t clock_s;
+
+void setUp() {
+    clock_s = 1000;
+    baselineInit(&state, clock_s);
+}
+
+void tearDown() {}
+
+/**
+ * One baseline day of 2 s samples: clean air at clean_rs, except the
+ * gas_fraction of each hour where waste gas pulls RS down to gas_rs
+ * @return Days closed while feeding
+ */
+static uint8_t feedDay(float clean_rs, float gas_rs, float gas_fraction) {
+    uint8_t closed = 0;
+    uint32_t samples = (uint32_t)BASELINE_DAY_POINTS * BASELINE_POINT_S / SAMPLE_S;
+    uint32_t gas_samples_per_hour = (uint32_t)(gas_fraction * 3600 / SAMPLE_S);
+    for (uint32_t i = 0; i < samples; i++) {
+        bool gas = (i % (3600 / SAMPLE_S)) < gas_samples_per_hour;
+        clock_s += SAMPLE_S;
+        if (baselineUpdate(&state, gas ? gas_rs : clean_rs, clock_s)) {
+            closed++;
+        }
+    }
+    return closed;
+}
+
+void test_day_closes_after_full_point_count() {
+    TEST_ASSERT_EQUAL_UINT8(1, feedDay(30.0f, 5.0f, 0.3f));
+    TEST_ASSERT_EQUAL_UINT8(1, state.day_count);
+    TEST_ASSERT_EQUAL_UINT16(1, state.days_total);
+
+    // A reboot mid-day (uptime restarts) keeps collecting into the same day
+    clock_s = 20;
+    for (uint16_t i = 0; i < 600; i++) {
+        clock_s += SAMPLE_S;
+        TEST_ASSERT_FALSE(baselineUpdate(&state, 30.0f, clock_s));
+    }
+    TEST_ASSERT_EQUAL_UINT16(20, state.day_points);
+    TEST_ASSERT_EQUAL_UINT8(1, state.day_count);
+}
+
+void test_daily_percentile_ignores_gas_events() {
+    // Bin is dirty 30% of the time; the clean-air reading must not move
+    feedDay(30.0f, 5.0f, 0.3f);
+    TEST_ASSERT_FLOAT_WITHIN(30.0f * 0.08f, 30.0f, state.day_rs[0]);
+
+    // Half the day in gas is still below the 90th percentile
+    feedDay(30.0f, 2.0f, 0.5f);
+    TEST_ASSERT_FLOAT_WITHIN(30.0f * 0.08f, 30.0f, state.day_rs[1]);
+}
+
+void test_percentile_of_open_day() {
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, baselineDayPercentile(&state, 0.5f));
+    for (uint16_t i = 0; i < 100 * BASELINE_POINT_S / SAMPLE_S; i++) {
+        clock_s += SAMPLE_S;
+        baselineUpdate(&state, i < 50 * BASELINE_POINT_S / SAMPLE_S ? 1.0f : 10.0f, clock_s);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.08f, 1.0f, baselineDayPercentile(&state, 0.25f));
+    TEST_ASSERT_FLOAT_WITHIN(0.8f, 10.0f, baselineDayPercentile(&state, 0.75f));
+}
+
+void test_confidence_grows_with_window_coverage() {
+    GasBaselineEstimate_t estimate;
+    TEST_ASSERT_FALSE(baselineEstimate(&state, CLEAN_AIR_RATIO, &estimate));
+
+    feedDay(36.0f, 5.0f, 0.2f);
+    TEST_ASSERT_TRUE(baselineEstimate(&state, CLEAN_AIR_RATIO, &estimate));
+    TEST_ASSERT_EQUAL_UINT8(1, estimate.days);
+    TEST_ASSERT_FLOAT_WITHIN(0.8f, 10.0f, estimate.r0_kohm);
+    TEST_ASSERT_TRUE(estimate.confidence < BASELINE_MIN_CONFIDENCE);
+
+    float next_r0 = 0.0f;
+    TEST_ASSERT_FALSE(baselineNextR0(&estimate, 10.0f, 0.0f, &next_r0));
+
+    for (uint8_t day = 1; day < BASELINE_WINDOW_DAYS; day++) {
+        feedDay(36.0f, 5.0f, 0.2f);
+    }
+    TEST_ASSERT_TRUE(baselineEstimate(&state, CLEAN_AIR_RATIO, &estimate));
+    TEST_ASSERT_EQUAL_UINT8(BASELINE_WINDOW_DAYS, estimate.days);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 100.0f, estimate.confidence);
+    TEST_ASSERT_FLOAT_WITHIN(0.8f, 10.0f, estimate.r0_kohm);
+}
+
+void test_unstable_days_lower_confidence() {
+    const float days[] = { 20.0f, 45.0f, 25.0f, 50.0f, 18.0f, 40.0f, 30.0f };
+    for (uint8_t day = 0; day < BASELINE_WINDOW_DAYS; day++) {
+        feedDay(days[day], 5.0f, 0.2f);
+    }
+
+    GasBaselineEstimate_t estimate;
+    TEST_ASSERT_TRUE(baselineEstimate(&state, CLEAN_AIR_RATIO, &estimate));
+    TEST_ASSERT_TRUE(estimate.confidence < BASELINE_MIN_CONFIDENCE);
+    TEST_ASSERT_FLOAT_WITHIN(30.0f * 0.08f, 30.0f, estimate.rs_clean_kohm);   // Median
+}
+
+void test_window_slides_with_sensor_drift() {
+    for (uint8_t day = 0; day < BASELINE_WINDOW_DAYS; day++) {
+        feedDay(36.0f, 5.0f, 0.2f);
+    }
+    // Aged sensor: clean-air RS settles 20% lower
+    for (uint8_t day = 0; day < BASELINE_WINDOW_DAYS; day++) {
+        feedDay(28.8f, 5.0f, 0.2f);
+    }
+
+    GasBaselineEstimate_t estimate;
+    TEST_ASSERT_TRUE(baselineEstimate(&state, CLEAN_AIR_RATIO, &estimate));
+    TEST_ASSERT_EQUAL_UINT16(2 * BASELINE_WINDOW_DAYS, state.days_total);
+    TEST_ASSERT_FLOAT_WITHIN(0.65f, 8.0f, estimate.r0_kohm);
+    TEST_ASSERT_TRUE(estimate.confidence > 90.0f);
+}
+
+void test_next_r0_replaces_untrusted_and_limits_trusted() {
+    GasBaselineEstimate_t estimate;
+    memset(&estimate, 0, sizeof(estimate));
+    estimate.r0_kohm = 8.0f;
+    estimate.confidence = 80.0f;
+    estimate.days = BASELINE_WINDOW_DAYS;
+
+    float next_r0 = 0.0f;
+    TEST_ASSERT_TRUE(baselineNextR0(&estimate, 10.0f, 0.0f, &next_r0));
+    TEST_ASSERT_EQUAL_FLOAT(8.0f, next_r0);
+
+    TEST_ASSERT_TRUE(baselineNextR0(&estimate, 10.0f, 100.0f, &next_r0));
+    TEST_ASSERT_EQUAL_FLOAT(10.0f * (1.0f - BASELINE_MAX_STEP), next_r0);
+
+    estimate.r0_kohm = 10.2f;
+    TEST_ASSERT_TRUE(baselineNextR0(&estimate, 10.0f, 100.0f, &next_r0));
+    TEST_ASSERT_EQUAL_FLOAT(10.2f, next_r0);
+
+    estimate.confidence = BASELINE_MIN_CONFIDENCE - 1.0f;
+    TEST_ASSERT_FALSE(baselineNextR0(&estimate, 10.0f, 100.0f, &next_r0));
+}
+
+void test_invalid_state_detected() {
+    TEST_ASSERT_TRUE(baselineIsValid(&state));
+
+    GasBaselineState_t stored = state;
+    stored.magic = 0;
+    TEST_ASSERT_FALSE(baselineIsValid(&stored));
+
+    stored = state;
+    stored.day_head = BASELINE_WINDOW_DAYS;
+    TEST_ASSERT_FALSE(baselineIsValid(&stored));
+
+    // Bad samples are dropped, not averaged in
+    baselineUpdate(&state, -1.0f, clock_s + 1);
+    baselineUpdate(&state, 0.0f, clock_s + 2);
+    TEST_ASSERT_EQUAL_UINT16(0, state.point_samples);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_day_closes_after_full_point_count);
+    RUN_TEST(test_daily_percentile_ignores_gas_events);
+    RUN_TEST(test_percentile_of_open_day);
+    RUN_TEST(test_confidence_grows_with_window_coverage);
+    RUN_TEST(test_unstable_days_lower_confidence);
+    RUN_TEST(test_window_slides_with_sensor_drift);
+    RUN_TEST(test_next_r0_replaces_untrusted_and_limits_trusted);
+    RUN_TEST(test_invalid_state_detected);
+    return UNITY_END();
+}
@@ -0,0 +1,491 @@
+/**
+ * BINSAI Unit Test - GPRS Uplink
+ * Bearer selection, modem arbitration, SIM800L bring-up / send / failure
+ * handling and batched telemetry against the fake modem on a virtual
+ * clock: batching, max delay, urgent frames, resend after a dropped
+ * context, SMS preempting the bearer, the retained daily budget and
+ * hand-back to WiFi.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <FakeSim800.h>
+#include <GprsLink.h>
+#include <GprsUplink.h>
+#include <ModemArbiter.h>
+
+static const FakeSim800Timing_t TIMING = { 50, 2000 };
+
+static SensorData_t sample;
+static GprsLinkConfig_t link_config;
+static GprsUplinkPolicy_t policy;
+static uint32_t now_ms;
+static uint32_t sequence;
+static uint32_t mono_offset_s;      // RTC clock at the start of this "boot"
+static uint32_t unix_offset_s;      // UTC at now_ms = 0, 0 = clock not set
+
+void setUp() {
+    memset(&sample, 0, sizeof(sample));
+    sample.fill_percentage = 61.0f;
+    sample.distance_cm = 15.6f;
+    sample.ppm_calculated = 210.0f;
+    sample.latitude = -7.7956;
+    sample.longitude = 110.3695;
+
+    gprsLinkDefaults(&link_config);
+    link_config.host = "fleet.example";
+    link_config.port = 47100;
+    gprsUplinkDefaults(&policy);
+    now_ms = 1000;
+    sequence = 0;
+    mono_offset_s = 0;
+    unix_offset_s = 0;
+}
+
+void tearDown() {}
+
+static void runLink(FakeSim800& modem, GprsLink& link, uint32_t duration_ms) {
+    uint32_t end = now_ms + duration_ms;
+    while (now_ms < end) {
+        now_ms += 10;
+        modem.advance(now_ms);
+        link.loop(now_ms);
+    }
+}
+
+/**
+ * Firmware sensor loop: a sample every 2 s, critical flag as given
+ */
+static void runTransport(FakeSim800& modem, GprsTelemetryTransport& transport, uint32_t duration_ms,
+                         bool critical = false) {
+    uint32_t end = now_ms + duration_ms;
+    while (now_ms < end) {
+        now_ms += 10;
+        modem.advance(now_ms);
+        if (now_ms % 2000 == 0) {
+            TelemetryFrameMeta_t meta;
+            meta.device_id = "BIN-07";
+            meta.sequence = ++sequence;
+            meta.flags = critical ? TELEMETRY_FLAG_CRITICAL : 0;
+            meta.deployment_zone = 1;
+            meta.trace_us = 0;
+            meta.boot_epoch = 0;
+            transport.setBudgetClock(unix_offset_s ? unix_offset_s + now_ms / 1000 : 0,
+                                     mono_offset_s + now_ms / 1000);
+            transport.publishSample(sample, meta, now_ms);
+        }
+        transport.loop(now_ms);
+    }
+}
+
+/**
+ * Frame sequences of every datagram, in order; all frames must be valid
+ */
+static size_t datagramSequences(const FakeSim800& modem, uint32_t* sequences, size_t capacity) {
+    size_t count = 0;
+    for (size_t d = 0; d < modem.datagrams().size(); d++) {
+        const std::vector<uint8_t>& datagram = modem.datagrams()[d];
+        TEST_ASSERT_EQUAL(0, datagram.size() % TELEMETRY_FRAME_SIZE);
+        for (size_t offset = 0; offset < datagram.size() && count < capacity; offset += TELEMETRY_FRAME_SIZE) {
+            TelemetryFrameView view(&datagram[offset], TELEMETRY_FRAME_SIZE);
+            TEST_ASSERT_TRUE(view.validate());
+            sequences[count++] = view.sequence();
+        }
+    }
+    return count;
+}
+
+void test_bearer_select() {
+    BearerStatus_t bearers[BEARER_COUNT] = {
+        { true, 0, 300 },           // WiFi
+        { true, 40, 4000 }          // GPRS
+    };
+    TEST_ASSERT_EQUAL_INT(BEARER_WIFI, bearerSelect(bearers, BEARER_COUNT, 60000));
+
+    bearers[BEARER_WIFI].available = false;
+    TEST_ASSERT_EQUAL_INT(BEARER_GPRS, bearerSelect(bearers, BEARER_COUNT, 60000));
+    TEST_ASSERT_EQUAL_INT(BEARER_GPRS, bearerSelect(bearers, BEARER_COUNT, 1000));     // Fastest left
+
+    bearers[BEARER_GPRS].available = false;
+    TEST_ASSERT_EQUAL_INT(-1, bearerSelect(bearers, BEARER_COUNT, 60000));
+    TEST_ASSERT_EQUAL_STRING("none", bearerName(-1));
+
+    // Cheap but slow vs fast but dear: the latency bound decides
+    BearerStatus_t links[3] = { { true, 5, 20000 }, { true, 50, 1500 }, { false, 0, 100 } };
+    TEST_ASSERT_EQUAL_INT(0, bearerSelect(links, 3, 60000));
+    TEST_ASSERT_EQUAL_INT(1, bearerSelect(links, 3, 5000));
+    TEST_ASSERT_EQUAL_INT(1, bearerSelect(links, 3, 500));
+}
+
+void test_arbiter_priority_and_lease() {
+    ModemArbiter arbiter(10000);
+    TEST_ASSERT_TRUE(arbiter.tryAcquire(MODEM_USER_GPRS, 0));
+    TEST_ASSERT_TRUE(arbiter.tryAcquire(MODEM_USER_GPRS, 10));     // Re-entrant
+    TEST_ASSERT_FALSE(arbiter.tryAcquire(MODEM_USER_SMS, 20));
+    TEST_ASSERT_TRUE(arbiter.yieldRequested(MODEM_USER_GPRS, 30));
+    TEST_ASSERT_FALSE(arbiter.yieldRequested(MODEM_USER_SMS, 30));
+
+    // GPRS ends its exchange but may not start another while SMS waits
+    arbiter.release(MODEM_USER_GPRS);
+    TEST_ASSERT_FALSE(arbiter.tryAcquire(MODEM_USER_GPRS, 40));
+    TEST_ASSERT_FALSE(arbiter.tryAcquire(MODEM_USER_TIME, 40));
+    TEST_ASSERT_TRUE(arbiter.tryAcquire(MODEM_USER_SMS, 50));
+    TEST_ASSERT_EQUAL(MODEM_USER_SMS, arbiter.owner());
+
+    // A hung holder is evicted after its lease
+    TEST_ASSERT_FALSE(arbiter.tryAcquire(MODEM_USER_TIME, 9000));
+    TEST_ASSERT_TRUE(arbiter.tryAcquire(MODEM_USER_TIME, 10050));
+    TEST_ASSERT_EQUAL_UINT32(1, arbiter.stats().evictions);
+    arbiter.release(MODEM_USER_TIME);
+
+    // A waiter that stopped retrying no longer blocks lower users
+    TEST_ASSERT_TRUE(arbiter.tryAcquire(MODEM_USER_SMS, 11000));
+    TEST_ASSERT_FALSE(arbiter.tryAcquire(MODEM_USER_TIME, 11000));
+    arbiter.release(MODEM_USER_SMS);
+    TEST_ASSERT_FALSE(arbiter.tryAcquire(MODEM_USER_GPRS, 12000));
+    TEST_ASSERT_TRUE(arbiter.tryAcquire(MODEM_USER_GPRS, 21001));
+    TEST_ASSERT_EQUAL_STRING("gprs", modemUserName(arbiter.owner()));
+}
+
+void test_link_bring_up_and_send() {
+    FakeSim800 modem(TIMING);
+    ModemArbiter arbiter;
+    GprsLink link(modem, arbiter, link_config);
+
+    link.open(now_ms);
+    runLink(modem, link, 10000);
+    TEST_ASSERT_TRUE(link.ready());
+    TEST_ASSERT_EQUAL(MODEM_USER_NONE, arbiter.owner());
+
+    const char* expected[] = {
+        "AT+CIPSHUT", "AT+CGATT=1", "AT+CSTT=\"internet\",\"\",\"\"", "AT+CIICR", "AT+CIFSR",
+        "AT+CIPSTART=\"UDP\",\"fleet.example\",47100"
+    };
+    TEST_ASSERT_EQUAL(6, modem.commands().size());
+    for (size_t i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_STRING(expected[i], modem.commands()[i].c_str());
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, link.stats().opens);
+    TEST_ASSERT_TRUE(link.stats().last_open_ms >= 2 * TIMING.network_ms);
+
+    const uint8_t payload[3] = { 0xB1, 0x00, 0x5A };
+    TEST_ASSERT_FALSE(link.send(payload, GPRS_MAX_PAYLOAD + 1, now_ms));
+    TEST_ASSERT_TRUE(link.send(payload, sizeof(payload), now_ms));
+    TEST_ASSERT_EQUAL(GPRS_SEND_BUSY, link.sendStatus());
+    TEST_ASSERT_FALSE(link.send(payload, sizeof(payload), now_ms));     // One at a time
+    runLink(modem, link, 1000);
+
+    TEST_ASSERT_EQUAL(GPRS_SEND_DONE, link.sendStatus());
+    TEST_ASSERT_EQUAL(1, modem.datagrams().size());
+    TEST_ASSERT_EQUAL(3, modem.datagrams()[0].size());
+    TEST_ASSERT_EQUAL_HEX8(0x5A, modem.datagrams()[0][2]);
+    TEST_ASSERT_TRUE(link.latencyMs() > 0 && link.latencyMs() < 500);
+    TEST_ASSERT_EQUAL_UINT32(0, modem.interleaves());
+
+    link.close();
+    runLink(modem, link, 1000);
+    TEST_ASSERT_EQUAL(GPRS_LINK_DOWN, link.state());
+    TEST_ASSERT_FALSE(modem.contextActive());
+    TEST_ASSERT_EQUAL_STRING("down", gprsLinkStateName(link.state()));
+}
+
+void test_link_activation_backoff() {
+    FakeSim800 modem(TIMING);
+    ModemArbiter arbiter;
+    GprsLink link(modem, arbiter, link_config);
+    modem.failActivations(2);
+
+    link.open(now_ms);
+    runLink(modem, link, 3000);
+    TEST_ASSERT_EQUAL_UINT32(1, link.stats().open_failures);
+    TEST_ASSERT_EQUAL(GPRS_LINK_DOWN, link.state());
+
+    // No new attempt before retry_min_ms, the second wait is doubled
+    runLink(modem, link, link_config.retry_min_ms - 1500);
+    TEST_ASSERT_EQUAL(1, modem.count("AT+CIICR"));
+    runLink(modem, link, 3000);
+    TEST_ASSERT_EQUAL(2, modem.count("AT+CIICR"));
+    runLink(modem, link, 2 * link_config.retry_min_ms - 1000);
+    TEST_ASSERT_EQUAL(2, modem.count("AT+CIICR"));
+    runLink(modem, link, 10000);
+    TEST_ASSERT_TRUE(link.ready());
+    TEST_ASSERT_EQUAL_UINT32(2, link.stats().open_failures);
+
+    // Unregistered: attach fails before any activation
+    FakeSim800 offline(TIMING);
+    GprsLink idle(offline, arbiter, link_config);
+    offline.setRegistered(false);
+    idle.open(now_ms);
+    runLink(offline, idle, 2000);
+    TEST_ASSERT_EQUAL(0, offline.count("AT+CIICR"));
+    TEST_ASSERT_EQUAL_UINT32(1, idle.stats().open_failures);
+}
+
+void test_batches_frames() {
+    FakeSim800 modem(TIMING);
+    ModemArbiter arbiter;
+    GprsTelemetryTransport transport(modem, arbiter, link_config, policy);
+    TEST_ASSERT_EQUAL_STRING("GPRS", transport.name());
+
+    // Inactive (WiFi selected): samples are not taken
+    runTransport(modem, transport, 60000);
+    TEST_ASSERT_EQUAL(0, transport.queued());
+    TEST_ASSERT_EQUAL(0, modem.commands().size());
+
+    transport.setActive(true);
+    runTransport(modem, transport, (GPRS_BATCH_MAX - 2) * policy.sample_interval_ms + 30000);
+    TEST_ASSERT_TRUE(transport.connected());            // Opened with the first frame
+    TEST_ASSERT_EQUAL(0, modem.datagrams().size());
+    TEST_ASSERT_EQUAL(GPRS_BATCH_MAX - 1, transport.queued());
+    runTransport(modem, transport, policy.sample_interval_ms);
+
+    TEST_ASSERT_EQUAL(1, modem.datagrams().size());
+    TEST_ASSERT_EQUAL(GPRS_MAX_PAYLOAD, modem.datagrams()[0].size());
+    uint32_t sequences[16];
+    TEST_ASSERT_EQUAL(GPRS_BATCH_MAX, datagramSequences(modem, sequences, 16));
+    for (size_t i = 1; i < GPRS_BATCH_MAX; i++) {
+        TEST_ASSERT_EQUAL_UINT32(30, sequences[i] - sequences[i - 1]);   // One per minute
+    }
+
+    const GprsUplinkStats_t& stats = transport.stats();
+    TEST_ASSERT_EQUAL_UINT32(GPRS_BATCH_MAX, stats.frames_sent);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.datagrams);
+    TEST_ASSERT_EQUAL_UINT32(GPRS_MAX_PAYLOAD + GPRS_DATAGRAM_OVERHEAD, stats.wire_bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, transport.queued());
+    TEST_ASSERT_EQUAL_UINT32(0, modem.interleaves());
+}
+
+void test_max_delay_and_urgent_frames() {
+    FakeSim800 modem(TIMING);
+    ModemArbiter arbiter;
+    policy.max_delay_ms = 180000;
+    GprsTelemetryTransport transport(modem, arbiter, link_config, policy);
+    transport.setActive(true);
+
+    runTransport(modem, transport, policy.max_delay_ms + 5000);
+    TEST_ASSERT_EQUAL(1, modem.datagrams().size());
+    TEST_ASSERT_EQUAL(4 * TELEMETRY_FRAME_SIZE, modem.datagrams()[0].size());
+    TEST_ASSERT_TRUE(transport.stats().max_delay_ms <= policy.max_delay_ms + 1000);
+    TEST_ASSERT_TRUE(transport.stats().max_delay_ms >= policy.max_delay_ms);
+
+    // Critical condition: its first sample goes out at once, later ones
+    // follow the normal schedule
+    runTransport(modem, transport, 10000);
+    runTransport(modem, transport, 3000, true);
+    TEST_ASSERT_EQUAL(2, modem.datagrams().size());
+    TelemetryFrameView urgent(&modem.datagrams()[1][modem.datagrams()[1].size() - TELEMETRY_FRAME_SIZE],
+                              TELEMETRY_FRAME_SIZE);
+    TEST_ASSERT_TRUE(urgent.validate());
+    TEST_ASSERT_TRUE((urgent.flags() & TELEMETRY_FLAG_CRITICAL) != 0);
+    TEST_ASSERT_EQUAL_UINT32(1, transport.stats().frames_urgent);
+
+    runTransport(modem, transport, 60000, true);
+    TEST_ASSERT_EQUAL(2, modem.datagrams().size());
+    TEST_ASSERT_EQUAL_UINT32(1, transport.stats().frames_urgent);
+}
+
+void test_dropped_context_resends_frames() {
+    FakeSim800 modem(TIMING);
+    ModemArbiter arbiter;
+    policy.batch_frames = 2;
+    GprsTelemetryTransport transport(modem, arbiter, link_config, policy);
+    transport.setActive(true);
+
+    runTransport(modem, transport, 70000);
+    TEST_ASSERT_EQUAL(1, modem.datagrams().size());
+    TEST_ASSERT_TRUE(transport.connected());
+
+    // Network deactivates the context; frames queue and go out after the
+    // automatic reconnect
+    modem.dropContext();
+    runTransport(modem, transport, 100);
+    TEST_ASSERT_FALSE(transport.connected());
+    TEST_ASSERT_EQUAL_UINT32(1, transport.link().stats().drops);
+    runTransport(modem, transport, 2 * policy.sample_interval_ms);
+    TEST_ASSERT_EQUAL(2, modem.datagrams().size());
+    TEST_ASSERT_EQUAL_UINT32(2, transport.link().stats().opens);
+
+    // A failed send keeps the batch for the next datagram
+    modem.failSends(1);
+    runTransport(modem, transport, 2 * policy.sample_interval_ms + 10000);
+    TEST_ASSERT_EQUAL_UINT32(1, transport.link().stats().send_failures);
+    TEST_ASSERT_EQUAL(3, modem.datagrams().size());
+
+    uint32_t sequences[16];
+    size_t count = datagramSequences(modem, sequences, 16);
+    TEST_ASSERT_EQUAL(6, count);
+    TEST_ASSERT_EQUAL_UINT32(6, transport.stats().frames_sent);
+    for (size_t i = 1; i < count; i++) {
+        TEST_ASSERT_TRUE(sequences[i] > sequences[i - 1]);     // No loss, no duplicates
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, modem.interleaves());
+}
+
+void test_sms_preempts_bearer() {
+    FakeSim800 modem(TIMING);
+    ModemArbiter arbiter;
+    GprsTelemetryTransport transport(modem, arbiter, link_config, policy);
+    transport.setActive(true);
+
+    // First frame starts the bring-up; stop while AT+CIICR is in flight
+    runTransport(modem, transport, 2000);
+    while (modem.count("AT+CIICR") == 0) {
+        runTransport(modem, transport, 10);
+    }
+    TEST_ASSERT_EQUAL(MODEM_USER_GPRS, arbiter.owner());
+
+    // SMS alert: waits for the exchange, then holds the modem while the
+    // GPRS transport keeps running (it must neither write nor read)
+    uint32_t requested = now_ms;
+    while (!arbiter.tryAcquire(MODEM_USER_SMS, now_ms)) {
+        runTransport(modem, transport, 10);
+    }
+    TEST_ASSERT_TRUE(now_ms - requested < TIMING.network_ms + 100);
+    size_t commands = modem.commands().size();
+
+    const char* command = "AT+CMGS=\"+620000\"\r\n";
+    modem.write((const uint8_t*)command, strlen(command));
+    std::string reply;
+    uint8_t buffer[32];
+    while (reply.find('>') == std::string::npos) {
+        runTransport(modem, transport, 10);
+        size_t n = modem.read(buffer, sizeof(buffer));
+        reply.append((const char*)buffer, n);
+    }
+    const char* text = "[BINSAI CRITICAL ALERT]\x1A";
+    modem.write((const uint8_t*)text, strlen(text));
+    while (reply.find("OK") == std::string::npos) {
+        runTransport(modem, transport, 10);
+        size_t n = modem.read(buffer, sizeof(buffer));
+        reply.append((const char*)buffer, n);
+    }
+    TEST_ASSERT_TRUE(reply.find("+CMGS: 7") != std::string::npos);
+    TEST_ASSERT_EQUAL(commands + 1, modem.commands().size());      // Only AT+CMGS
+    arbiter.release(MODEM_USER_SMS);
+
+    runTransport(modem, transport, 10000);
+    TEST_ASSERT_TRUE(transport.connected());
+    TEST_ASSERT_EQUAL(1, modem.messages().size());
+    TEST_ASSERT_EQUAL_UINT32(0, modem.interleaves());
+    TEST_ASSERT_TRUE(arbiter.stats().contended > 0);
+}
+
+void test_budget_limits_normal_frames() {
+    FakeSim800 modem(TIMING);
+    ModemArbiter arbiter;
+    policy.daily_budget_bytes = 500;
+    policy.idle_close_ms = 120000;
+    GprsTelemetryTransport transport(modem, arbiter, link_config, policy);
+    transport.setActive(true);
+
+    runTransport(modem, transport, GPRS_BATCH_MAX * policy.sample_interval_ms);
+    TEST_ASSERT_EQUAL(1, modem.datagrams().size());
+    TEST_ASSERT_TRUE(transport.stats().budget_used_bytes >= policy.daily_budget_bytes);
+
+    // Over budget: normal samples are refused and the idle context is shut
+    runTransport(modem, transport, 3 * policy.sample_interval_ms);
+    TEST_ASSERT_EQUAL_UINT32(3, transport.stats().frames_dropped_budget);
+    TEST_ASSERT_EQUAL(0, transport.queued());
+    TEST_ASSERT_EQUAL(GPRS_LINK_DOWN, transport.link().state());
+
+    // Urgent frames still go out, reopening the context
+    runTransport(modem, transport, 10000, true);
+    TEST_ASSERT_EQUAL(2, modem.datagrams().size());
+    TEST_ASSERT_EQUAL(TELEMETRY_FRAME_SIZE, modem.datagrams()[1].size());
+    TEST_ASSERT_EQUAL_UINT32(2, transport.link().stats().opens);
+
+    // Next budget window
+    runTransport(modem, transport, GPRS_BUDGET_WINDOW_S * 1000 - 11 * policy.sample_interval_ms);
+    uint32_t refused = transport.stats().frames_dropped_budget;
+    runTransport(modem, transport, 2 * policy.sample_interval_ms);
+    TEST_ASSERT_EQUAL_UINT32(refused, transport.stats().frames_dropped_budget);
+    TEST_ASSERT_TRUE(transport.queued() > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, modem.interleaves());
+}
+
+void test_budget_survives_reboot_and_follows_calendar_day() {
+    policy.daily_budget_bytes = 500;
+    policy.idle_close_ms = 120000;
+    GprsBudget_t retained;
+    memset(&retained, 0xA5, sizeof(retained));          // RTC_NOINIT after power-up
+    {
+        FakeSim800 modem(TIMING);
+        ModemArbiter arbiter;
+        GprsTelemetryTransport transport(modem, arbiter, link_config, policy);
+        transport.attachBudget(&retained, mono_offset_s);
+        TEST_ASSERT_EQUAL_UINT32(0, transport.stats().budget_used_bytes);
+        transport.setActive(true);
+        runTransport(modem, transport, GPRS_BATCH_MAX * policy.sample_interval_ms);
+        TEST_ASSERT_EQUAL(1, modem.datagrams().size());
+        TEST_ASSERT_TRUE(retained.used_bytes >= policy.daily_budget_bytes);
+    }
+
+    // Crash reset: uptime starts over, the RTC clock and memory do not
+    mono_offset_s += now_ms / 1000;
+    now_ms = 1000;
+    FakeSim800 modem(TIMING);
+    ModemArbiter arbiter;
+    GprsTelemetryTransport transport(modem, arbiter, link_config, policy);
+    transport.attachBudget(&retained, mono_offset_s);
+    transport.setActive(true);
+    TEST_ASSERT_EQUAL_UINT32(retained.used_bytes, transport.stats().budget_used_bytes);
+    runTransport(modem, transport, 3 * policy.sample_interval_ms);
+    TEST_ASSERT_EQUAL_UINT32(3, transport.stats().frames_dropped_budget);
+    TEST_ASSERT_EQUAL(0, modem.datagrams().size());
+
+    // Clock set 10 min before UTC midnight: the spent window becomes today's
+    const uint32_t day = 20500;
+    unix_offset_s = day * GPRS_BUDGET_WINDOW_S - 600 - now_ms / 1000;
+    runTransport(modem, transport, 5 * policy.sample_interval_ms);
+    TEST_ASSERT_EQUAL_UINT32(8, transport.stats().frames_dropped_budget);
+    TEST_ASSERT_EQUAL_UINT32(day - 1, retained.day);
+
+    // Midnight opens a new window
+    runTransport(modem, transport, 6 * policy.sample_interval_ms);
+    TEST_ASSERT_EQUAL_UINT32(day, retained.day);
+    TEST_ASSERT_TRUE(transport.stats().frames_dropped_budget < 14);
+    TEST_ASSERT_TRUE(transport.queued() > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, modem.interleaves());
+}
+
+void test_hand_back_to_wifi() {
+    FakeSim800 modem(TIMING);
+    ModemArbiter arbiter;
+    GprsTelemetryTransport transport(modem, arbiter, link_config, policy);
+    transport.setActive(true);
+    runTransport(modem, transport, 3 * policy.sample_interval_ms);
+    TEST_ASSERT_EQUAL(3, transport.queued());
+    TEST_ASSERT_TRUE(transport.connected());
+    TEST_ASSERT_TRUE(transport.expectedLatencyMs() < 15000);
+
+    // WiFi back: no new samples, the queue is drained over GPRS, then the
+    // context is shut
+    transport.setActive(false);
+    runTransport(modem, transport, 5000);
+    TEST_ASSERT_EQUAL(1, modem.datagrams().size());
+    TEST_ASSERT_EQUAL(3 * TELEMETRY_FRAME_SIZE, modem.datagrams()[0].size());
+    TEST_ASSERT_EQUAL(0, transport.queued());
+    TEST_ASSERT_EQUAL(GPRS_LINK_DOWN, transport.link().state());
+    TEST_ASSERT_FALSE(modem.contextActive());
+    TEST_ASSERT_EQUAL(2, modem.count("AT+CIPSHUT"));
+    runTransport(modem, transport, 60000);
+    TEST_ASSERT_EQUAL(1, modem.datagrams().size());
+    TEST_ASSERT_EQUAL_UINT32(3, transport.stats().frames_sent);
+    TEST_ASSERT_EQUAL_UINT32(0, modem.interleaves());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_bearer_select);
+    RUN_TEST(test_arbiter_priority_and_lease);
+    RUN_TEST(test_link_bring_up_and_send);
+    RUN_TEST(test_link_activation_backoff);
+    RUN_TEST(test_batches_frames);
+    RUN_TEST(test_max_delay_and_urgent_frames);
+    RUN_TEST(test_dropped_context_resends_frames);
+    RUN_TEST(test_sms_preempts_bearer);
+    RUN_TEST(test_budget_limits_normal_frames);
+    RUN_TEST(test_budget_survives_reboot_and_follows_calendar_day);
+    RUN_TEST(test_hand_back_to_wifi);
+    return UNITY_END();
+}
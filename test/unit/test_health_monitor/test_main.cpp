@@ -0,0 +1,253 @@
+/**
+ * BINSAI Unit Test - Health Monitor
+ * Simulated reboots over a RAM store and RTC record: reset classification,
+ * crash context carried to the next boot, MTBF and restart time, run time
+ * lost on power cuts, and the binary / text boot report.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <HealthMonitor.h>
+
+/**
+ * NVS stand-in that survives "reboots" (new HealthMonitor instances)
+ */
+class RamHealthStore : public HealthStore {
+public:
+    RamHealthStore() : saves(0), _valid(false) {}
+
+    bool loadStats(HealthStats_t* stats) override {
+        if (!_valid) return false;
+        *stats = _stats;
+        return true;
+    }
+
+    bool saveStats(const HealthStats_t& stats) override {
+        _stats = stats;
+        _valid = true;
+        saves++;
+        return true;
+    }
+
+    const HealthStats_t& saved() const { return _stats; }
+
+    uint32_t saves;
+
+private:
+    HealthStats_t _stats;
+    bool _valid;
+};
+
+static RamHealthStore store;
+static HealthRtcRecord_t rtc;
+
+void setUp() {
+    store = RamHealthStore();
+    memset(&rtc, 0xA5, sizeof(rtc));   // Power-on RTC contents are random
+}
+
+void tearDown() {}
+
+/**
+ * Advance run_s seconds of loop() calls in the given phase
+ */
+static void runFor(HealthMonitor& monitor, uint32_t start_ms, uint32_t run_s, HealthPhase_t phase) {
+    monitor.setPhase(phase);
+    for (uint32_t s = 1; s <= run_s; s++) {
+        monitor.loop(start_ms + s * 1000);
+    }
+}
+
+/**
+ * What the panic hook writes from the fault handler
+ */
+static void simulatePanic(HealthFault_t fault, uint8_t depth) {
+    rtc.fault = (uint8_t)fault;
+    rtc.backtrace_depth = depth;
+    for (uint8_t i = 0; i < depth; i++) {
+        rtc.backtrace[i] = 0x400D1000UL + 0x10 * i;
+    }
+}
+
+void test_power_on_boot_has_no_previous_run() {
+    HealthMonitor monitor(store, rtc);
+    monitor.onBoot(HEALTH_RESET_POWER_ON, 50);
+
+    const HealthReport_t& report = monitor.report();
+    TEST_ASSERT_EQUAL_UINT8(HEALTH_RESET_POWER_ON, report.reset_reason);
+    TEST_ASSERT_EQUAL_UINT8(0, report.flags & HEALTH_REPORT_FLAG_PREVIOUS);
+    TEST_ASSERT_EQUAL_UINT32(1, report.boots);
+    TEST_ASSERT_EQUAL_UINT32(0, report.failures);
+    TEST_ASSERT_EQUAL_UINT32(HEALTH_MTBF_NONE, monitor.mtbfSeconds());
+    TEST_ASSERT_EQUAL_UINT32(HEALTH_RTC_MAGIC, rtc.magic);
+    TEST_ASSERT_EQUAL_UINT8(HEALTH_PHASE_SETUP, rtc.phase);
+    TEST_ASSERT_FALSE(monitor.reportPending());
+    TEST_ASSERT_EQUAL_UINT32(1, store.saved().boots);
+}
+
+void test_crash_context_reported_on_next_boot() {
+    {
+        HealthMonitor monitor(store, rtc);
+        monitor.onBoot(HEALTH_RESET_POWER_ON, 0);
+        runFor(monitor, 0, 3600, HEALTH_PHASE_SENSORS);
+        simulatePanic(HEALTH_FAULT_PANIC, 5);
+    }
+
+    HealthMonitor monitor(store, rtc);
+    monitor.onBoot(HEALTH_RESET_PANIC, 0);
+    const HealthReport_t& report = monitor.report();
+    TEST_ASSERT_EQUAL_UINT8(HEALTH_REPORT_FLAG_PREVIOUS, report.flags);
+    TEST_ASSERT_EQUAL_UINT8(HEALTH_PHASE_SENSORS, report.phase);
+    TEST_ASSERT_EQUAL_UINT8(HEALTH_FAULT_PANIC, report.fault);
+    TEST_ASSERT_EQUAL_UINT32(3600, report.previous_uptime_s);
+    TEST_ASSERT_EQUAL_UINT8(5, report.backtrace_depth);
+    TEST_ASSERT_EQUAL_HEX32(0x400D1040UL, report.backtrace[4]);
+    TEST_ASSERT_EQUAL_UINT32(2, report.boots);
+    TEST_ASSERT_EQUAL_UINT32(1, report.failures);
+    TEST_ASSERT_EQUAL_UINT32(1, report.panics);
+    TEST_ASSERT_EQUAL_UINT32(3600, report.mtbf_s);
+
+    // Re-armed: the fault belongs to the previous run only
+    TEST_ASSERT_EQUAL_UINT8(HEALTH_FAULT_NONE, rtc.fault);
+    TEST_ASSERT_EQUAL_UINT8(0, rtc.backtrace_depth);
+    TEST_ASSERT_EQUAL_UINT32(0, rtc.uptime_s);
+}
+
+void test_reset_classification_and_mtbf() {
+    // power on, then 4 runs of 1000 s ending in: task wdt (via panic),
+    // brownout, software restart, interrupt wdt
+    const HealthResetReason_t resets[] = {
+        HEALTH_RESET_POWER_ON, HEALTH_RESET_PANIC, HEALTH_RESET_BROWNOUT,
+        HEALTH_RESET_SOFTWARE, HEALTH_RESET_INT_WDT
+    };
+    for (size_t i = 0; i < sizeof(resets) / sizeof(resets[0]); i++) {
+        if (resets[i] == HEALTH_RESET_PANIC) {
+            simulatePanic(HEALTH_FAULT_TASK_WDT, 0);
+        }
+        HealthMonitor monitor(store, rtc);
+        monitor.onBoot(resets[i], 0);
+        if (i + 1 < sizeof(resets) / sizeof(resets[0])) {
+            runFor(monitor, 0, 1000, HEALTH_PHASE_TRANSPORTS);
+        }
+    }
+
+    const HealthStats_t& stats = store.saved();
+    TEST_ASSERT_EQUAL_UINT32(5, stats.boots);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.failures);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.brownouts);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.watchdog_resets);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.panics);
+    TEST_ASSERT_EQUAL_UINT32(4000, stats.uptime_s);
+
+    HealthMonitor monitor(store, rtc);
+    monitor.onBoot(HEALTH_RESET_SOFTWARE, 0);
+    TEST_ASSERT_EQUAL_UINT32(4000 / 3, monitor.mtbfSeconds());
+    TEST_ASSERT_TRUE(healthResetIsFailure(HEALTH_RESET_OTHER_WDT));
+    TEST_ASSERT_FALSE(healthResetIsFailure(HEALTH_RESET_DEEP_SLEEP));
+    TEST_ASSERT_FALSE(healthResetIsFailure(HEALTH_RESET_EXTERNAL));
+}
+
+void test_power_cut_loses_at_most_one_interval() {
+    {
+        HealthMonitor monitor(store, rtc, 600);
+        monitor.onBoot(HEALTH_RESET_POWER_ON, 0);
+        runFor(monitor, 0, 1500, HEALTH_PHASE_IDLE);
+        TEST_ASSERT_EQUAL_UINT32(1200, store.saved().uptime_s);
+        TEST_ASSERT_EQUAL_UINT32(3, store.saves);   // boot + 2 flushes
+    }
+
+    memset(&rtc, 0x5A, sizeof(rtc));
+    HealthMonitor monitor(store, rtc, 600);
+    monitor.onBoot(HEALTH_RESET_POWER_ON, 0);
+    TEST_ASSERT_EQUAL_UINT32(1200, store.saved().uptime_s);
+    TEST_ASSERT_EQUAL_UINT8(0, monitor.report().flags);
+}
+
+void test_run_time_across_millis_wrap() {
+    HealthMonitor monitor(store, rtc);
+    uint32_t start = UINT32_MAX - 2500;
+    monitor.onBoot(HEALTH_RESET_POWER_ON, start);
+    monitor.loop(start + 999);
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.uptimeSeconds());
+    monitor.loop(start + 10500);            // wrapped
+    TEST_ASSERT_EQUAL_UINT32(10, monitor.uptimeSeconds());
+    monitor.loop(start + 11000);
+    TEST_ASSERT_EQUAL_UINT32(11, monitor.uptimeSeconds());
+}
+
+void test_restart_time_and_single_report() {
+    {
+        HealthMonitor monitor(store, rtc);
+        monitor.onBoot(HEALTH_RESET_POWER_ON, 100);
+        monitor.markReady(8100);
+    }
+
+    HealthMonitor monitor(store, rtc);
+    monitor.onBoot(HEALTH_RESET_BROWNOUT, 100);
+    TEST_ASSERT_FALSE(monitor.reportPending());
+    monitor.markReady(12100);
+    TEST_ASSERT_TRUE(monitor.reportPending());
+    TEST_ASSERT_EQUAL_UINT32(12000, monitor.report().restart_ms);
+    TEST_ASSERT_EQUAL_UINT32(10000, monitor.meanRestartMs());
+
+    monitor.reportDelivered();
+    monitor.markReady(50000);               // Reconnects are not restarts
+    TEST_ASSERT_FALSE(monitor.reportPending());
+    TEST_ASSERT_EQUAL_UINT32(2, store.saved().restarts_timed);
+    TEST_ASSERT_EQUAL_UINT32(12000, store.saved().last_restart_ms);
+}
+
+void test_report_encode_decode_and_format() {
+    HealthReport_t report;
+    memset(&report, 0, sizeof(report));
+    report.reset_reason = HEALTH_RESET_TASK_WDT;
+    report.phase = HEALTH_PHASE_SMS;
+    report.fault = HEALTH_FAULT_TASK_WDT;
+    report.backtrace_depth = 2;
+    report.flags = HEALTH_REPORT_FLAG_PREVIOUS;
+    report.previous_uptime_s = 86400;
+    report.boots = 12;
+    report.failures = 3;
+    report.brownouts = 2;
+    report.watchdog_resets = 1;
+    report.mtbf_s = 28800;
+    report.restart_ms = 8200;
+    report.backtrace[0] = 0x400D2F3CUL;
+    report.backtrace[1] = 0x400E0012UL;
+
+    uint8_t buffer[HEALTH_REPORT_SIZE];
+    TEST_ASSERT_EQUAL(0, healthReportEncode(report, buffer, sizeof(buffer) - 1));
+    TEST_ASSERT_EQUAL(HEALTH_REPORT_SIZE, healthReportEncode(report, buffer, sizeof(buffer)));
+
+    HealthReport_t decoded;
+    TEST_ASSERT_TRUE(healthReportDecode(buffer, sizeof(buffer), &decoded));
+    TEST_ASSERT_EQUAL_MEMORY(&report, &decoded, sizeof(report));
+
+    buffer[10] ^= 0x01;
+    TEST_ASSERT_FALSE(healthReportDecode(buffer, sizeof(buffer), &decoded));
+
+    FixedText<192> line;
+    healthReportFormat(report, line);
+    TEST_ASSERT_EQUAL_STRING("reset=task_wdt phase=sms fault=task_wdt run=86400s boots=12 failures=3 "
+                             "brownouts=2 wdt=1 panics=0 mtbf=28800s restart=8200ms "
+                             "bt=0x400d2f3c,0x400e0012", line.c_str());
+
+    report.flags = 0;
+    report.mtbf_s = HEALTH_MTBF_NONE;
+    line.clear();
+    healthReportFormat(report, line);
+    TEST_ASSERT_EQUAL_STRING("reset=task_wdt boots=12 failures=3 brownouts=2 wdt=1 panics=0 "
+                             "mtbf=- restart=8200ms", line.c_str());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_power_on_boot_has_no_previous_run);
+    RUN_TEST(test_crash_context_reported_on_next_boot);
+    RUN_TEST(test_reset_classification_and_mtbf);
+    RUN_TEST(test_power_cut_loses_at_most_one_interval);
+    RUN_TEST(test_run_time_across_millis_wrap);
+    RUN_TEST(test_restart_time_and_single_report);
+    RUN_TEST(test_report_encode_decode_and_format);
+    return UNITY_END();
+}
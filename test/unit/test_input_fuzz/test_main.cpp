@@ -0,0 +1,665 @@
+/**
+ * BINSAI Unit Test - Input Fuzzing
+ * Property tests over mutated seed inputs for the code that consumes
+ * untrusted bytes (SIM800L replies, +CCLK and GPS dates, console lines,
+ * config blobs and fields) and for the fill / classification core.
+ * Mutations are seeded, so a failure reproduces on every run.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <ConfigFields.h>
+#include <ConfigStore.h>
+#include <GprsLink.h>
+#include <ModemArbiter.h>
+#include <ProbeArray.h>
+#include <SerialConsole.h>
+#include <TextBuffer.h>
+#include <TimeService.h>
+#include <WasteClassifier.h>
+
+#define FUZZ_ITERATIONS     20000
+#define FUZZ_INPUT_MAX      512
+
+// SIM800L output seen by the firmware: boot URCs, registration, clock,
+// GPRS bring-up and send, SMS submission, errors
+static const char* const MODEM_SEEDS[] = {
+    "\r\nOK\r\n",
+    "\r\nERROR\r\n",
+    "\r\n+CME ERROR: 100\r\n",
+    "\r\nRDY\r\n\r\n+CFUN: 1\r\n\r\n+CPIN: READY\r\n\r\nCall Ready\r\n\r\nSMS Ready\r\n",
+    "\r\n+CPIN: READY\r\n\r\nOK\r\n",
+    "\r\n+CREG: 0,1\r\n\r\nOK\r\n",
+    "\r\n+CSQ: 17,0\r\n\r\nOK\r\n",
+    "\r\n+CCLK: \"26/10/19,19:00:00+28\"\r\n\r\nOK\r\n",
+    "\r\n+CCLK: \"04/01/01,00:00:38+00\"\r\n\r\nOK\r\n",
+    "\r\nSHUT OK\r\n",
+    "\r\n10.64.12.7\r\n",
+    "\r\nOK\r\n\r\nCONNECT OK\r\n",
+    "\r\n> ",
+    "\r\nSEND OK\r\n",
+    "\r\nSEND FAIL\r\n",
+    "\r\nCLOSED\r\n",
+    "\r\n+PDP: DEACT\r\n",
+    "\r\n+CMGS: 42\r\n\r\nOK\r\n",
+};
+
+static const char* const CONSOLE_SEEDS[] = {
+    "STATUS",
+    "GET device_id",
+    "SET wifi_ssid \"Kampus Wifi\"",
+    "SET critical_gas_threshold 800",
+    "ADCCAL ADD 1650",
+    "LOG DUMP",
+    "OTA http://10.0.0.2/v2.1.0.bota",
+};
+
+// Values as typed on the console, plus numeric edge cases
+static const char* const VALUE_SEEDS[] = {
+    "BINSAI-YK-0042", "Kampus Wifi", "9.85", "-3.5", "1e38", "inf", "nan", "0x1F", "255", "256",
+    "4294967295", "4294967296", "true", "FALSE", "", "12abc",
+};
+
+static uint32_t fuzz_state;
+
+static uint32_t fuzzNext() {
+    fuzz_state ^= fuzz_state << 13;     // xorshift32
+    fuzz_state ^= fuzz_state >> 17;
+    fuzz_state ^= fuzz_state << 5;
+    return fuzz_state;
+}
+
+static uint32_t fuzzBelow(uint32_t bound) {
+    return fuzzNext() % bound;
+}
+
+/**
+ * Seed copy with 1-4 mutations: bit flip, interesting byte, insertion,
+ * deletion, chunk duplication or truncation
+ * @return Length written (at most capacity)
+ */
+static size_t fuzzMutate(const char* seed, uint8_t* out, size_t capacity) {
+    static const uint8_t INTERESTING[] = { 0x00, 0xFF, '\r', '\n', '"', '-', '+', ',', '/', ':', '9', '>', ' ' };
+    size_t length = strlen(seed) < capacity ? strlen(seed) : capacity;
+    memcpy(out, seed, length);
+
+    uint32_t mutations = 1 + fuzzBelow(4);
+    for (uint32_t m = 0; m < mutations; m++) {
+        size_t at = length ? fuzzBelow((uint32_t)length) : 0;
+        switch (fuzzBelow(6)) {
+            case 0:
+                if (length) out[at] ^= (uint8_t)(1 << fuzzBelow(8));
+                break;
+            case 1:
+                if (length) out[at] = INTERESTING[fuzzBelow(sizeof(INTERESTING))];
+                break;
+            case 2:
+                if (length < capacity) {
+                    memmove(out + at + 1, out + at, length - at);
+                    out[at] = (uint8_t)fuzzNext();
+                    length++;
+                }
+                break;
+            case 3:
+                if (length) {
+                    memmove(out + at, out + at + 1, length - at - 1);
+                    length--;
+                }
+                break;
+            case 4: {
+                size_t chunk = length - at < 16 ? length - at : 16;
+                if (length + chunk <= capacity) {
+                    memmove(out + at + chunk, out + at, length - at);
+                    length += chunk;
+                }
+                break;
+            }
+            default:
+                length = at;
+                break;
+        }
+    }
+    return length;
+}
+
+/**
+ * Random finite values plus NaN, infinities, zeros and huge magnitudes
+ */
+static float fuzzFloat(float scale) {
+    switch (fuzzBelow(8)) {
+        case 0:  return NAN;
+        case 1:  return fuzzBelow(2) ? INFINITY : -INFINITY;
+        case 2:  return fuzzBelow(2) ? 0.0f : -0.0f;
+        case 3: {
+            uint32_t bits = fuzzNext();
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        default: return ((float)fuzzNext() / 4294967296.0f - 0.25f) * scale;
+    }
+}
+
+void setUp() {
+    fuzz_state = 0x9E3779B9UL;
+}
+
+void tearDown() {}
+
+/**
+ * The rolling reply window of sendGSMCommand() matches a token at the
+ * same byte as a search over the whole stream would
+ */
+void test_rolling_reply_match_equals_full_stream() {
+    static const char* const TOKENS[] = { "OK", "ERROR", ">", "READY", "+CREG: 0,1", "SEND OK", "SHUT OK" };
+    uint8_t stream[FUZZ_INPUT_MAX];
+
+    for (uint32_t n = 0; n < FUZZ_ITERATIONS; n++) {
+        size_t length = 0;
+        uint32_t parts = 1 + fuzzBelow(4);
+        for (uint32_t p = 0; p < parts && length < sizeof(stream) - 128; p++) {
+            const char* seed = MODEM_SEEDS[fuzzBelow(sizeof(MODEM_SEEDS) / sizeof(MODEM_SEEDS[0]))];
+            length += fuzzMutate(seed, stream + length, 128);
+        }
+        const char* token = TOKENS[fuzzBelow(sizeof(TOKENS) / sizeof(TOKENS[0]))];
+        size_t token_length = strlen(token);
+
+        FixedText<64> window;
+        std::string full;
+        for (size_t i = 0; i < length; i++) {
+            window.pushRolling((char)stream[i]);
+            full.push_back((char)stream[i]);
+            bool expected = full.size() >= token_length &&
+                            full.compare(full.size() - token_length, token_length, token) == 0;
+            TEST_ASSERT_EQUAL(expected, window.endsWith(token));
+            TEST_ASSERT_TRUE(window.length() < window.capacity());
+        }
+    }
+}
+
+/**
+ * Any accepted +CCLK reply is a real calendar time within the modem's
+ * two-digit year range and the world's time zones
+ */
+void test_cclk_parse_accepts_only_valid_times() {
+    uint8_t input[FUZZ_INPUT_MAX + 1];
+    uint32_t accepted = 0;
+
+    for (uint32_t n = 0; n < FUZZ_ITERATIONS; n++) {
+        size_t length = fuzzMutate(MODEM_SEEDS[7 + fuzzBelow(2)], input, FUZZ_INPUT_MAX);
+        input[length] = '\0';
+
+        int64_t unix_ms = 0;
+        if (!timeParseCclk((const char*)input, &unix_ms)) {
+            continue;
+        }
+        accepted++;
+        TEST_ASSERT_TRUE(unix_ms >= (timeFromCivil(2000, 1, 1, 0, 0, 0) - 14 * 3600) * 1000);
+        TEST_ASSERT_TRUE(unix_ms <= (timeFromCivil(2100, 1, 1, 0, 0, 0) + 12 * 3600) * 1000);
+        TEST_ASSERT_EQUAL_INT64(0, unix_ms % 1000);
+    }
+    TEST_ASSERT_TRUE(accepted > 0);
+
+    // Signed fields that %2d used to let through
+    int64_t unix_ms;
+    TEST_ASSERT_FALSE(timeParseCclk("+CCLK: \"26/10/19,-1:00:00+28\"", &unix_ms));
+    TEST_ASSERT_FALSE(timeParseCclk("+CCLK: \"26/10/19,19:-5:00+28\"", &unix_ms));
+    TEST_ASSERT_FALSE(timeParseCclk("+CCLK: \"-1/10/19,19:00:00+28\"", &unix_ms));
+    TEST_ASSERT_FALSE(timeParseCclk("+CCLK: \"26/10/19,19:00:00+-4\"", &unix_ms));
+    TEST_ASSERT_FALSE(timeParseCclk("+CCLK: \"26/10/19,19:00:00+99\"", &unix_ms));
+    TEST_ASSERT_FALSE(timeParseCclk("+CCLK: \"26/02/30,19:00:00+28\"", &unix_ms));
+}
+
+/**
+ * timeCivilValid() agrees with a day-by-day calendar walk, and every
+ * date it accepts converts exactly (GPS RMC fields are not range-checked
+ * by the NMEA parser)
+ */
+void test_civil_dates_match_calendar_walk() {
+    static const int DAYS[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    int64_t days = 0;
+    for (int year = 1970; year < 2100; year++) {
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        for (int month = 1; month <= 12; month++) {
+            int month_days = DAYS[month - 1] + (month == 2 && leap ? 1 : 0);
+            for (int day = 1; day <= 31; day++) {
+                bool valid = day <= month_days;
+                TEST_ASSERT_EQUAL(valid, timeCivilValid(year, month, day, 12, 0, 0));
+                if (valid) {
+                    TEST_ASSERT_EQUAL_INT64(days * 86400 + 43200, timeFromCivil(year, month, day, 12, 0, 0));
+                    days++;
+                }
+            }
+        }
+    }
+
+    // ddmmyy / hhmmss digits as a corrupted sentence could carry them
+    for (uint32_t n = 0; n < FUZZ_ITERATIONS; n++) {
+        int year = 2000 + (int)fuzzBelow(100);
+        int month = (int)fuzzBelow(100);
+        int day = (int)fuzzBelow(100);
+        int hour = (int)fuzzBelow(100);
+        int minute = (int)fuzzBelow(100);
+        int second = (int)fuzzBelow(100);
+        if (!timeCivilValid(year, month, day, hour, minute, second)) {
+            continue;
+        }
+        int64_t midnight = timeFromCivil(year, month, day, 0, 0, 0);
+        int64_t stamp = timeFromCivil(year, month, day, hour, minute, second);
+        TEST_ASSERT_TRUE(stamp - midnight >= 0 && stamp - midnight <= 86400);
+    }
+}
+
+/**
+ * Modem port replaying mutated replies, a few bytes per read
+ */
+class ReplayModemPort : public ModemPort {
+public:
+    uint8_t pending[4096];
+    size_t head;
+    size_t tail;
+    uint32_t payload_writes;
+
+    ReplayModemPort() : head(0), tail(0), payload_writes(0) {}
+
+    size_t write(const uint8_t* data, size_t length) override {
+        if (length >= 2 && memcmp(data, "AT", 2) != 0 && memcmp(data, "\r\n", 2) != 0) {
+            payload_writes++;
+        }
+        return length;
+    }
+
+    size_t read(uint8_t* buffer, size_t capacity) override {
+        size_t count = 1 + fuzzBelow(24);
+        if (count > capacity) count = capacity;
+        if (count > tail - head) count = tail - head;
+        memcpy(buffer, pending + head, count);
+        head += count;
+        return count;
+    }
+
+    void queue(const uint8_t* data, size_t length) {
+        if (head == tail) head = tail = 0;
+        if (tail + length <= sizeof(pending)) {
+            memcpy(pending + tail, data, length);
+            tail += length;
+        }
+    }
+};
+
+/**
+ * Random reply streams never wedge the link: the state stays valid, the
+ * modem is only held while an exchange can be in progress, and SEND OK
+ * is only counted for datagrams that were started
+ */
+void test_gprs_link_survives_random_replies() {
+    uint8_t reply[FUZZ_INPUT_MAX];
+    uint8_t payload[GPRS_MAX_PAYLOAD];
+    memset(payload, 0x5A, sizeof(payload));
+
+    for (uint32_t run = 0; run < 200; run++) {
+        ReplayModemPort port;
+        ModemArbiter arbiter;
+        GprsLinkConfig_t config;
+        gprsLinkDefaults(&config);
+        config.host = "fleet.example";
+        config.port = 47100;
+        GprsLink link(port, arbiter, config);
+
+        uint32_t now_ms = 0;
+        uint32_t started = 0;
+        link.open(now_ms);
+        for (uint32_t step = 0; step < 2000; step++) {
+            now_ms += 10 + fuzzBelow(500);
+            if (fuzzBelow(4) == 0) {
+                const char* seed = MODEM_SEEDS[fuzzBelow(sizeof(MODEM_SEEDS) / sizeof(MODEM_SEEDS[0]))];
+                size_t length = fuzzBelow(3) ? fuzzMutate(seed, reply, sizeof(reply)) : strlen(seed);
+                port.queue(fuzzBelow(3) ? reply : (const uint8_t*)seed, length);
+            }
+            if (fuzzBelow(200) == 0) {
+                size_t length = 96 + fuzzBelow(300);
+                for (size_t i = 0; i < length; i++) reply[i] = (uint8_t)('A' + fuzzBelow(26));
+                port.queue(reply, length);          // Line longer than GPRS_LINE_MAX
+            }
+            if (link.ready() && fuzzBelow(3) == 0) {
+                started += link.send(payload, 1 + fuzzBelow(GPRS_MAX_PAYLOAD), now_ms);
+            }
+            if (fuzzBelow(500) == 0) {
+                link.close();
+            } else if (fuzzBelow(500) == 0) {
+                link.open(now_ms);
+            }
+            link.loop(now_ms);
+
+            GprsLinkState_t state = link.state();
+            TEST_ASSERT_TRUE(state <= GPRS_LINK_CLOSING);
+            if (arbiter.owner() == MODEM_USER_GPRS) {
+                TEST_ASSERT_TRUE(state == GPRS_LINK_OPENING || state == GPRS_LINK_SENDING ||
+                                 state == GPRS_LINK_CLOSING);
+            }
+        }
+        TEST_ASSERT_TRUE(link.stats().sends <= started);
+        TEST_ASSERT_TRUE(port.payload_writes <= started);
+    }
+}
+
+static uint32_t console_dispatches;
+
+static void handleFuzzCommand(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    TEST_ASSERT_TRUE(argc >= 1 && argc <= CONSOLE_MAX_TOKENS);
+    for (uint8_t i = 0; i < argc; i++) {
+        TEST_ASSERT_NOT_NULL(argv[i]);
+        TEST_ASSERT_TRUE(strlen(argv[i]) < CONSOLE_LINE_MAX);
+    }
+    console_dispatches++;
+    out.println("OK");
+}
+
+class NullOutput : public ConsoleOutput {
+public:
+    size_t bytes;
+    NullOutput() : bytes(0) {}
+    void write(const char* data, size_t length) override {
+        (void)data;
+        bytes += length;
+    }
+};
+
+static constexpr ConsoleCommand_t FUZZ_COMMANDS[] = {
+    CONSOLE_COMMAND("STATUS", 0, "STATUS", handleFuzzCommand),
+    CONSOLE_COMMAND("GET",    0, "GET [field]", handleFuzzCommand),
+    CONSOLE_COMMAND("SET",    2, "SET <field> <value>", handleFuzzCommand),
+    CONSOLE_COMMAND("ADCCAL", 0, "ADCCAL [ADD <mV> | SAVE | CLEAR]", handleFuzzCommand),
+    CONSOLE_COMMAND("LOG",    0, "LOG [FLUSH | DUMP]", handleFuzzCommand),
+    CONSOLE_COMMAND("OTA",    1, "OTA <url>", handleFuzzCommand),
+};
+
+/**
+ * Tokens stay inside the line and within the token limit, and the console
+ * dispatches only known commands with enough arguments
+ */
+void test_console_tokenizer_and_dispatch() {
+    uint8_t input[FUZZ_INPUT_MAX];
+    NullOutput output;
+    SerialConsole console(FUZZ_COMMANDS, sizeof(FUZZ_COMMANDS) / sizeof(FUZZ_COMMANDS[0]), output);
+    console_dispatches = 0;
+
+    for (uint32_t n = 0; n < FUZZ_ITERATIONS; n++) {
+        const char* seed = CONSOLE_SEEDS[fuzzBelow(sizeof(CONSOLE_SEEDS) / sizeof(CONSOLE_SEEDS[0]))];
+        size_t length = fuzzMutate(seed, input, CONSOLE_LINE_MAX - 1);
+
+        char line[CONSOLE_LINE_MAX];
+        memcpy(line, input, length);
+        line[length] = '\0';
+        size_t text_length = strlen(line);
+        char* tokens[CONSOLE_MAX_TOKENS];
+        uint8_t count = consoleTokenize(line, tokens, CONSOLE_MAX_TOKENS);
+        TEST_ASSERT_TRUE(count <= CONSOLE_MAX_TOKENS);
+        for (uint8_t i = 0; i < count; i++) {
+            TEST_ASSERT_TRUE(tokens[i] >= line && tokens[i] <= line + text_length);
+            TEST_ASSERT_TRUE(tokens[i] + strlen(tokens[i]) <= line + text_length);
+        }
+
+        for (size_t i = 0; i < length; i++) {
+            console.feed((char)input[i]);
+        }
+        console.feed('\n');
+    }
+
+    // Unterminated overlong input is dropped, then the console recovers
+    for (size_t i = 0; i < 3 * CONSOLE_LINE_MAX; i++) console.feed('A');
+    console.feed('\n');
+    uint32_t before = console_dispatches;
+    const char* status = "STATUS\n";
+    for (size_t i = 0; status[i]; i++) console.feed(status[i]);
+    TEST_ASSERT_EQUAL_UINT32(before + 1, console_dispatches);
+    TEST_ASSERT_TRUE(console.commandCount() > 0);
+}
+
+/**
+ * configFieldSet() either rejects a value or stores one that formats back
+ * to a terminated string; it never writes outside the field
+ */
+void test_config_field_set_random_values() {
+    uint8_t input[FUZZ_INPUT_MAX];
+
+    for (uint32_t n = 0; n < FUZZ_ITERATIONS; n++) {
+        SystemConfig_t config;
+        memset(&config, 0xA5, sizeof(config));
+        SystemConfig_t before = config;
+
+        const ConfigField_t* field = &CONFIG_FIELDS[fuzzBelow(CONFIG_FIELD_COUNT)];
+        const char* seed = VALUE_SEEDS[fuzzBelow(sizeof(VALUE_SEEDS) / sizeof(VALUE_SEEDS[0]))];
+        size_t length = fuzzBelow(4) ? fuzzMutate(seed, input, 96) : strlen(seed);
+        char value[97];
+        memcpy(value, fuzzBelow(4) ? input : (const uint8_t*)seed, length);
+        value[length] = '\0';
+
+        bool stored = configFieldSet(&config, field, value);
+        const uint8_t* a = (const uint8_t*)&before;
+        const uint8_t* b = (const uint8_t*)&config;
+        for (size_t i = 0; i < sizeof(config); i++) {
+            if (i < field->offset || i >= (size_t)field->offset + field->size) {
+                TEST_ASSERT_EQUAL_HEX8(a[i], b[i]);
+            }
+        }
+        if (stored && field->type == CONFIG_FIELD_STRING) {
+            TEST_ASSERT_TRUE(memchr(b + field->offset, '\0', field->size) != NULL);
+        }
+        if (stored && field->type == CONFIG_FIELD_FLOAT) {
+            float parsed;
+            memcpy(&parsed, b + field->offset, sizeof(parsed));
+            TEST_ASSERT_FALSE(isnan(parsed));
+        }
+
+        char text[96];
+        size_t written = configFieldFormat(&config, field, text, fuzzBelow(2) ? sizeof(text) : 1 + fuzzBelow(8));
+        TEST_ASSERT_EQUAL(strlen(text), written);
+    }
+}
+
+/**
+ * RAM slots for ConfigStore
+ */
+class RamConfigBackend : public ConfigStorageBackend {
+public:
+    uint8_t slots[CONFIG_SLOT_COUNT][CONFIG_BLOB_MAX_SIZE];
+    size_t lengths[CONFIG_SLOT_COUNT];
+
+    size_t readSlot(uint8_t slot, void* buffer, size_t capacity) override {
+        size_t n = lengths[slot] < capacity ? lengths[slot] : capacity;
+        memcpy(buffer, slots[slot], n);
+        return n;
+    }
+
+    bool writeSlot(uint8_t slot, const void* data, size_t length) override {
+        memcpy(slots[slot], data, length);
+        lengths[slot] = length;
+        return true;
+    }
+};
+
+/**
+ * Structure-aware blob: random payload under a header with a valid CRC
+ */
+static size_t randomValidBlob(uint8_t* blob) {
+    ConfigBlobHeader_t header;
+    header.magic = CONFIG_BLOB_MAGIC;
+    header.schema_version = (uint16_t)(1 + fuzzBelow(CONFIG_SCHEMA_VERSION));
+    header.payload_length = (uint16_t)fuzzBelow(sizeof(SystemConfig_t) + 1);
+    header.sequence = fuzzNext();
+    uint8_t* payload = blob + sizeof(header);
+    for (size_t i = 0; i < header.payload_length; i++) payload[i] = (uint8_t)fuzzNext();
+    header.crc32 = configCrc32(payload, header.payload_length);
+    memcpy(blob, &header, sizeof(header));
+    return sizeof(header) + header.payload_length;
+}
+
+static void assertStringsTerminated(const SystemConfig_t& config) {
+    for (uint8_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        if (CONFIG_FIELDS[i].type == CONFIG_FIELD_STRING) {
+            const char* text = (const char*)&config + CONFIG_FIELDS[i].offset;
+            TEST_ASSERT_TRUE(memchr(text, '\0', CONFIG_FIELDS[i].size) != NULL);
+        }
+    }
+}
+
+/**
+ * Loading garbage, bit-flipped and CRC-valid random blobs never returns
+ * a flipped blob and always yields terminated strings
+ */
+void test_config_load_random_blobs() {
+    static RamConfigBackend backend;
+
+    SystemConfig_t reference;
+    memset(&reference, 0, sizeof(reference));
+    strcpy(reference.device_id, "BINSAI-YK-0042");
+    strcpy(reference.wifi_ssid, "Kampus Wifi");
+    reference.mq135_r0_calibrated = 9.85f;
+    reference.ultrasonic_probe_count = 1;
+
+    for (uint32_t n = 0; n < FUZZ_ITERATIONS / 4; n++) {
+        memset(backend.slots, 0, sizeof(backend.slots));
+        memset(backend.lengths, 0, sizeof(backend.lengths));
+        ConfigStore writer(backend);
+        TEST_ASSERT_TRUE(writer.commit(reference));             // Slot 0, sequence 1
+        uint8_t good_slot = 0;
+
+        uint8_t other = 1;
+        uint32_t mode = fuzzBelow(3);
+        switch (mode) {
+            case 0:
+                backend.lengths[other] = fuzzBelow(CONFIG_BLOB_MAX_SIZE + 1);
+                for (size_t i = 0; i < backend.lengths[other]; i++) backend.slots[other][i] = (uint8_t)fuzzNext();
+                break;
+            case 1:
+                // Newer copy of the reference with one flipped bit
+                memcpy(backend.slots[other], backend.slots[good_slot], CONFIG_BLOB_MAX_SIZE);
+                backend.lengths[other] = CONFIG_BLOB_MAX_SIZE;
+                backend.slots[other][8] = 2;                    // Sequence, little-endian
+                {
+                    size_t bit = sizeof(ConfigBlobHeader_t) * 8 +
+                                 fuzzBelow((uint32_t)sizeof(SystemConfig_t) * 8);
+                    backend.slots[other][bit / 8] ^= (uint8_t)(1 << (bit % 8));
+                }
+                break;
+            default:
+                backend.lengths[other] = randomValidBlob(backend.slots[other]);
+                break;
+        }
+
+        SystemConfig_t loaded;
+        memset(&loaded, 0x5A, sizeof(loaded));
+        ConfigStore reader(backend);
+        ConfigLoadResult_t result = reader.load(&loaded);
+        TEST_ASSERT_TRUE(result == CONFIG_LOAD_OK || result == CONFIG_LOAD_MIGRATED);
+        assertStringsTerminated(loaded);
+        if (mode == 1) {
+            TEST_ASSERT_EQUAL_UINT8(good_slot, reader.activeSlot());   // CRC-32 catches every 1-bit error
+        }
+        if (reader.activeSlot() == good_slot) {
+            TEST_ASSERT_EQUAL_MEMORY(&reference, &loaded, sizeof(reference));
+        }
+    }
+}
+
+/**
+ * Fill is always a number in 0-100 and does not rise with distance
+ */
+void test_fill_percentage_bounded_and_monotonic() {
+    for (uint32_t n = 0; n < FUZZ_ITERATIONS * 5; n++) {
+        float height = fuzzBelow(8) ? 40.0f : fuzzFloat(100.0f);
+        float distance = fuzzFloat(120.0f);
+        float fill = probeFillPercentage(distance, height);
+        TEST_ASSERT_FALSE(isnan(fill));
+        TEST_ASSERT_TRUE(fill >= 0.0f && fill <= 100.0f);
+
+        float farther = distance + fabsf(fuzzFloat(10.0f));
+        if (isfinite(distance) && isfinite(farther) && height > 0.0f) {
+            TEST_ASSERT_TRUE(probeFillPercentage(farther, height) <= fill);
+        }
+    }
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, probeFillPercentage(-1.0f, 40.0f));
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, probeFillPercentage(20.0f, 40.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, probeFillPercentage(NAN, 40.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, probeFillPercentage(20.0f, 0.0f));
+}
+
+/**
+ * Random tables are accepted only when finite and ascending; a classifier
+ * fed random values (NaN and infinities included) reports a level in
+ * range, never changes it twice within the dwell time, and without
+ * hysteresis or dwell agrees with the plain lookup
+ */
+void test_classifier_random_tables_and_values() {
+    for (uint32_t n = 0; n < FUZZ_ITERATIONS; n++) {
+        ClassifierTable_t table;
+        for (uint8_t i = 0; i < CLASSIFICATION_BREAKPOINTS; i++) table.breakpoints[i] = fuzzFloat(1000.0f);
+        table.hysteresis = fuzzFloat(50.0f);
+        table.min_dwell_ms = fuzzNext();
+
+        bool expected = isfinite(table.hysteresis) && table.hysteresis >= 0.0f;
+        for (uint8_t i = 0; i < CLASSIFICATION_BREAKPOINTS; i++) {
+            expected = expected && isfinite(table.breakpoints[i]) &&
+                       (i == 0 || table.breakpoints[i] > table.breakpoints[i - 1]);
+        }
+        HysteresisClassifier classifier;
+        TEST_ASSERT_EQUAL(expected, classifier.configure(table));
+    }
+
+    ClassifierTable_t gas;
+    classifierDefaultGasTable(&gas);
+    for (uint32_t run = 0; run < 50; run++) {
+        HysteresisClassifier classifier;
+        TEST_ASSERT_TRUE(classifier.configure(gas));
+        uint32_t now_ms = 0;
+        uint32_t changed_ms = 0;
+        uint8_t level = 0;
+        float value = 300.0f;
+        for (uint32_t i = 0; i < 2000; i++) {
+            now_ms += 2000;
+            value = fuzzBelow(50) ? value + ((float)fuzzBelow(200) - 100.0f) : fuzzFloat(3000.0f);
+            uint8_t reported = classifier.update(value, now_ms);
+            if (!isfinite(value)) {
+                value = 300.0f;
+            }
+            TEST_ASSERT_TRUE(reported <= CLASSIFICATION_BREAKPOINTS);
+            if (i > 0 && reported != level) {
+                TEST_ASSERT_TRUE(now_ms - changed_ms >= gas.min_dwell_ms);
+                changed_ms = now_ms;
+            }
+            level = reported;
+        }
+    }
+
+    ClassifierTable_t plain;
+    classifierDefaultCapacityTable(&plain);
+    plain.hysteresis = 0.0f;
+    plain.min_dwell_ms = 0;
+    HysteresisClassifier classifier;
+    TEST_ASSERT_TRUE(classifier.configure(plain));
+    for (uint32_t n = 0; n < FUZZ_ITERATIONS; n++) {
+        float value = fuzzFloat(250.0f);
+        uint8_t reported = classifier.update(value, n);
+        if (!isnan(value)) {
+            TEST_ASSERT_EQUAL_UINT8(classifyLevel(plain.breakpoints, value), reported);
+        }
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_rolling_reply_match_equals_full_stream);
+    RUN_TEST(test_cclk_parse_accepts_only_valid_times);
+    RUN_TEST(test_civil_dates_match_calendar_walk);
+    RUN_TEST(test_gprs_link_survives_random_replies);
+    RUN_TEST(test_console_tokenizer_and_dispatch);
+    RUN_TEST(test_config_field_set_random_values);
+    RUN_TEST(test_config_load_random_blobs);
+    RUN_TEST(test_fill_percentage_bounded_and_monotonic);
+    RUN_TEST(test_classifier_random_tables_and_values);
+    return UNITY_END();
+}
@@ -0,0 +1,228 @@
+/**
+ * BINSAI Unit Test - LoRa Uplink
+ * Encoder/decoder parity over randomized samples, anchor/status selection,
+ * time-on-air against published values and channel model sanity checks.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include <LoraUplink.h>
+#include <LoraAirtime.h>
+#include <TelemetryFrame.h>
+
+static SensorData_t sample;
+static uint8_t buffer[LORA_UPLINK_MAX_SIZE];
+
+void setUp() {
+    memset(&sample, 0, sizeof(sample));
+    sample.fill_percentage = 67.3f;
+    sample.ppm_calculated = 512.4f;
+    sample.capacity_level = 2;
+    sample.waste_classification = 3;
+    sample.priority_level = 1;
+    sample.hours_to_full = 17.25f;
+    sample.latitude = -7.7956123;
+    sample.longitude = 110.3694876;
+}
+
+void tearDown() {}
+
+static uint32_t lcg(uint32_t* state) {
+    *state = *state * 1664525UL + 1013904223UL;
+    return *state >> 8;
+}
+
+void test_first_fix_sends_anchor_then_status() {
+    LoraUplinkEncoder encoder;
+    LoraUplinkDecoder decoder;
+    SensorData_t decoded;
+    uint8_t flags = 0;
+
+    TEST_ASSERT_EQUAL(LORA_UPLINK_ANCHOR_SIZE, encoder.encode(sample, TELEMETRY_FLAG_GPS_FIX, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_UINT8(LORA_FRAME_ANCHOR, loraFrameType(buffer));
+    TEST_ASSERT_TRUE(decoder.decode(buffer, LORA_UPLINK_ANCHOR_SIZE, &decoded, &flags));
+    TEST_ASSERT_TRUE(decoder.hasAnchor());
+
+    sample.latitude += 0.0003;  // ~33 m
+    TEST_ASSERT_EQUAL(LORA_UPLINK_STATUS_SIZE, encoder.encode(sample, TELEMETRY_FLAG_GPS_FIX, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_UINT8(LORA_FRAME_STATUS, loraFrameType(buffer));
+    TEST_ASSERT_TRUE(decoder.decode(buffer, LORA_UPLINK_STATUS_SIZE, &decoded, &flags));
+    TEST_ASSERT_FLOAT_WITHIN(0.6e-5, sample.latitude, decoded.latitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.6e-5, sample.longitude, decoded.longitude);
+    TEST_ASSERT_EQUAL_UINT8(TELEMETRY_FLAG_GPS_FIX, flags);
+}
+
+void test_status_without_anchor_rejected_only_with_fix() {
+    LoraUplinkEncoder encoder;
+    LoraUplinkEncoder other;
+    LoraUplinkDecoder decoder;
+    SensorData_t decoded;
+    uint8_t flags = 0;
+
+    // No fix: status frame, decodable without an anchor, position zeroed
+    TEST_ASSERT_EQUAL(LORA_UPLINK_STATUS_SIZE, encoder.encode(sample, 0, buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(decoder.decode(buffer, LORA_UPLINK_STATUS_SIZE, &decoded, &flags));
+    TEST_ASSERT_EQUAL_UINT8(0, flags);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, (float)decoded.latitude);
+
+    // Decoder that missed the anchor cannot place a status frame
+    other.encode(sample, TELEMETRY_FLAG_GPS_FIX, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(LORA_UPLINK_STATUS_SIZE, other.encode(sample, TELEMETRY_FLAG_GPS_FIX, buffer, sizeof(buffer)));
+    TEST_ASSERT_FALSE(decoder.decode(buffer, LORA_UPLINK_STATUS_SIZE, &decoded, &flags));
+    TEST_ASSERT_FALSE(decoder.decode(buffer, LORA_UPLINK_ANCHOR_SIZE, &decoded, &flags));
+}
+
+void test_anchor_refresh_and_out_of_range_delta() {
+    LoraUplinkEncoder encoder(4);
+    size_t sizes[6];
+
+    for (int i = 0; i < 6; i++) {
+        sizes[i] = encoder.encode(sample, TELEMETRY_FLAG_GPS_FIX, buffer, sizeof(buffer));
+    }
+    TEST_ASSERT_EQUAL(LORA_UPLINK_ANCHOR_SIZE, sizes[0]);
+    TEST_ASSERT_EQUAL(LORA_UPLINK_STATUS_SIZE, sizes[4]);
+    TEST_ASSERT_EQUAL(LORA_UPLINK_ANCHOR_SIZE, sizes[5]);
+
+    sample.longitude += 0.03;  // ~3.3 km, beyond +-2047e-5
+    TEST_ASSERT_EQUAL(LORA_UPLINK_ANCHOR_SIZE, encoder.encode(sample, TELEMETRY_FLAG_GPS_FIX, buffer, sizeof(buffer)));
+
+    encoder.forceAnchor();
+    TEST_ASSERT_EQUAL(LORA_UPLINK_ANCHOR_SIZE, encoder.encode(sample, TELEMETRY_FLAG_GPS_FIX, buffer, sizeof(buffer)));
+}
+
+void test_randomized_encode_decode_parity() {
+    LoraUplinkEncoder encoder(16);
+    LoraUplinkDecoder decoder;
+    uint32_t state = 12345;
+
+    for (int i = 0; i < 20000; i++) {
+        sample.fill_percentage = (lcg(&state) % 10001) / 100.0f;
+        sample.ppm_calculated = (lcg(&state) % 20461) / 10.0f;
+        sample.capacity_level = (uint8_t)(lcg(&state) & 3);
+        sample.waste_classification = (uint8_t)(lcg(&state) & 3);
+        sample.priority_level = (uint8_t)(lcg(&state) & 3);
+        sample.hours_to_full = (lcg(&state) % 8 == 0) ? -1.0f : (lcg(&state) % 5110) / 10.0f;
+        sample.latitude = -7.80 + (lcg(&state) % 20000) * 1e-6;
+        sample.longitude = 110.36 + (lcg(&state) % 20000) * 1e-6;
+        uint8_t flags = (uint8_t)(lcg(&state) & (TELEMETRY_FLAG_GPS_FIX | TELEMETRY_FLAG_CRITICAL));
+
+        size_t length = encoder.encode(sample, flags, buffer, sizeof(buffer));
+        TEST_ASSERT_TRUE(length == LORA_UPLINK_STATUS_SIZE || length == LORA_UPLINK_ANCHOR_SIZE);
+
+        SensorData_t decoded;
+        uint8_t decoded_flags = 0;
+        TEST_ASSERT_TRUE(decoder.decode(buffer, length, &decoded, &decoded_flags));
+        TEST_ASSERT_EQUAL_UINT8(flags, decoded_flags);
+        TEST_ASSERT_FLOAT_WITHIN(0.25f, sample.fill_percentage, decoded.fill_percentage);
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, sample.ppm_calculated, decoded.ppm_calculated);
+        TEST_ASSERT_EQUAL_UINT8(sample.capacity_level, decoded.capacity_level);
+        TEST_ASSERT_EQUAL_UINT8(sample.waste_classification, decoded.waste_classification);
+        TEST_ASSERT_EQUAL_UINT8(sample.priority_level, decoded.priority_level);
+        if (sample.hours_to_full < 0.0f) {
+            TEST_ASSERT_EQUAL_FLOAT(-1.0f, decoded.hours_to_full);
+        } else {
+            TEST_ASSERT_FLOAT_WITHIN(0.25f, sample.hours_to_full, decoded.hours_to_full);
+        }
+        if (flags & TELEMETRY_FLAG_GPS_FIX) {
+            TEST_ASSERT_TRUE(fabs(sample.latitude - decoded.latitude) <= 0.5e-5 + 1e-9);
+            TEST_ASSERT_TRUE(fabs(sample.longitude - decoded.longitude) <= 0.5e-5 + 1e-9);
+        }
+    }
+}
+
+void test_out_of_range_values_saturate() {
+    LoraUplinkEncoder encoder;
+    LoraUplinkDecoder decoder;
+    SensorData_t decoded;
+    uint8_t flags = 0;
+
+    sample.fill_percentage = 140.0f;
+    sample.ppm_calculated = 9000.0f;
+    sample.hours_to_full = 2000.0f;
+    encoder.encode(sample, 0, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(decoder.decode(buffer, LORA_UPLINK_STATUS_SIZE, &decoded, &flags));
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, decoded.fill_percentage);
+    TEST_ASSERT_EQUAL_FLOAT(2046.0f, decoded.ppm_calculated);
+    TEST_ASSERT_EQUAL_FLOAT(511.0f, decoded.hours_to_full);
+
+    sample.fill_percentage = -3.0f;
+    sample.ppm_calculated = NAN;
+    encoder.encode(sample, 0, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(decoder.decode(buffer, LORA_UPLINK_STATUS_SIZE, &decoded, &flags));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, decoded.fill_percentage);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, decoded.ppm_calculated);
+
+    TEST_ASSERT_EQUAL(0, encoder.encode(sample, 0, buffer, LORA_UPLINK_MAX_SIZE - 1));
+}
+
+void test_airtime_matches_reference_values() {
+    LoraRadioConfig_t radio;
+
+    // 11-byte application payload (24-byte PHYPayload), 125 kHz, 4/5
+    loraRadioDefaults(&radio, 7);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 61.7, loraAirtimeMs(radio, 11));
+    loraRadioDefaults(&radio, 10);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 370.7, loraAirtimeMs(radio, 11));
+    loraRadioDefaults(&radio, 12);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 1482.8, loraAirtimeMs(radio, 11));
+
+    // Status frames never cost more than anchors
+    loraRadioDefaults(&radio, 9);
+    TEST_ASSERT_TRUE(loraAirtimeMs(radio, LORA_UPLINK_STATUS_SIZE) <= loraAirtimeMs(radio, LORA_UPLINK_ANCHOR_SIZE));
+}
+
+void test_channel_model_matches_aloha_without_capture() {
+    LoraSimConfig_t config;
+    loraSimDefaults(&config);
+    config.bins = 2000;
+    config.interval_s = 300;
+    config.channels = 1;
+    config.capture_db = -1.0;
+
+    LoraSimResult_t result = loraSimulateChannel(config);
+    TEST_ASSERT_EQUAL_UINT64(result.transmissions, result.delivered + result.collided);
+    TEST_ASSERT_EQUAL_UINT64(0, result.captured);
+    TEST_ASSERT_TRUE(result.offered_load > 0.5 && result.offered_load < 2.0);
+    TEST_ASSERT_FLOAT_WITHIN(0.03, result.aloha_expected, result.delivery_ratio);
+
+    // Capture can only help, and the model is deterministic per seed
+    config.capture_db = 6.0;
+    LoraSimResult_t captured = loraSimulateChannel(config);
+    TEST_ASSERT_TRUE(captured.delivery_ratio > result.delivery_ratio);
+    TEST_ASSERT_EQUAL_UINT64(captured.delivered, loraSimulateChannel(config).delivered);
+}
+
+void test_single_bin_and_duty_cycle_limit() {
+    LoraSimConfig_t config;
+    loraSimDefaults(&config);
+    config.bins = 1;
+    config.radio.spreading_factor = 12;
+    config.radio.low_data_rate_optimize = true;
+    config.payload_bytes = LORA_UPLINK_ANCHOR_SIZE;
+    config.jitter_ms = 0;
+
+    LoraSimResult_t result = loraSimulateChannel(config);
+    TEST_ASSERT_EQUAL_UINT64(result.transmissions, result.delivered);
+    TEST_ASSERT_EQUAL_UINT64(0, result.duty_deferred);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 148.3, result.min_interval_s);
+
+    // 60 s reports at SF12 break a 1 % duty cycle: uplinks get pushed back
+    config.interval_s = 60;
+    result = loraSimulateChannel(config);
+    TEST_ASSERT_TRUE(result.duty_deferred > 0);
+    TEST_ASSERT_TRUE(result.transmissions < config.duration_s / 60);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_fix_sends_anchor_then_status);
+    RUN_TEST(test_status_without_anchor_rejected_only_with_fix);
+    RUN_TEST(test_anchor_refresh_and_out_of_range_delta);
+    RUN_TEST(test_randomized_encode_decode_parity);
+    RUN_TEST(test_out_of_range_values_saturate);
+    RUN_TEST(test_airtime_matches_reference_values);
+    RUN_TEST(test_channel_model_matches_aloha_without_capture);
+    RUN_TEST(test_single_bin_and_duty_cycle_limit);
+    return UNITY_END();
+}
@@ -0,0 +1,314 @@
+/**
+ * BINSAI Unit Test - Performance Bench
+ * Verifies nearest-rank statistics, the runner on a virtual clock, the
+ * exact report text (schema stability), reading reports back out of a log
+ * and the regression rules of the comparator.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <string>
+#include <PerfBench.h>
+#include <PerfCompare.h>
+
+static uint32_t fake_now_us = 0;
+
+static uint32_t fakeClockUs() {
+    return fake_now_us;
+}
+
+static std::string report_text;
+
+static void captureLine(const char* line, size_t length, void* context) {
+    std::string* text = (std::string*)context;
+    TEST_ASSERT_EQUAL_size_t(strlen(line), length);
+    text->append(line, length);
+    text->append("\n");
+}
+
+static PerfBenchStats_t makeStats(uint32_t samples, uint32_t failures, float p50_us, float p99_us) {
+    PerfBenchStats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.samples = samples;
+    stats.failures = failures;
+    stats.min_us = p50_us / 2;
+    stats.p50_us = p50_us;
+    stats.p90_us = (p50_us + p99_us) / 2;
+    stats.p99_us = p99_us;
+    stats.max_us = p99_us;
+    stats.mean_us = p50_us;
+    return stats;
+}
+
+static void addCase(PerfReport_t* report, const char* name, const PerfBenchStats_t& stats) {
+    PerfReportCase_t entry;
+    entry.name = name;
+    entry.stats = stats;
+    report->cases.push_back(entry);
+}
+
+void setUp() {
+    metricsSetClock(fakeClockUs);
+    fake_now_us = 0;
+    report_text.clear();
+}
+
+void tearDown() {
+    metricsSetClock(nullptr);
+}
+
+void test_stats_nearest_rank() {
+    uint32_t samples[100];
+    for (uint32_t i = 0; i < 100; i++) {
+        samples[i] = (100 - i) * 1000;          // 100 us .. 1 us, reversed
+    }
+    PerfBenchStats_t stats;
+    perfStatsFromSamples(samples, 100, 2, &stats);
+
+    TEST_ASSERT_EQUAL_UINT32(100, stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.failures);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, stats.min_us);
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, stats.p50_us);
+    TEST_ASSERT_EQUAL_FLOAT(90.0f, stats.p90_us);
+    TEST_ASSERT_EQUAL_FLOAT(99.0f, stats.p99_us);
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, stats.max_us);
+    TEST_ASSERT_EQUAL_FLOAT(50.5f, stats.mean_us);
+
+    uint32_t single = 2500;
+    perfStatsFromSamples(&single, 1, 0, &stats);
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, stats.p50_us);
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, stats.p99_us);
+
+    perfStatsFromSamples(samples, 0, 1, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.samples);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, stats.max_us);
+}
+
+void test_stats_from_histogram() {
+    MetricsRegistry registry;
+    MetricHistogram latency(registry, "loop_us");
+    for (uint32_t i = 0; i < 90; i++) {
+        latency.record(300);                    // Bucket [256, 512)
+    }
+    for (uint32_t i = 0; i < 10; i++) {
+        latency.record(5000);
+    }
+    MetricHistogramSnapshot_t snapshot;
+    latency.snapshot(&snapshot);
+
+    PerfBenchStats_t stats;
+    perfStatsFromHistogram(snapshot, &stats);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.samples);
+    TEST_ASSERT_EQUAL_FLOAT(256.0f, stats.min_us);
+    TEST_ASSERT_TRUE(stats.p50_us >= 256.0f && stats.p50_us < 512.0f);
+    TEST_ASSERT_TRUE(stats.p99_us > 4096.0f && stats.p99_us <= 5000.0f);
+    TEST_ASSERT_EQUAL_FLOAT(5000.0f, stats.max_us);
+    TEST_ASSERT_EQUAL_FLOAT(770.0f, stats.mean_us);
+
+    MetricHistogramSnapshot_t empty;
+    memset(&empty, 0, sizeof(empty));
+    perfStatsFromHistogram(empty, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.samples);
+}
+
+static uint32_t case_calls = 0;
+static uint32_t yield_calls = 0;
+
+static bool steppingCase(void* context) {
+    uint32_t step_us = *(uint32_t*)context;
+    case_calls++;
+    fake_now_us += step_us * (case_calls % 2 ? 1 : 3);
+    return case_calls % 10 != 0;
+}
+
+static void countYield() {
+    yield_calls++;
+}
+
+void test_runner_times_batches_on_clock() {
+    uint32_t storage[16];
+    PerfBench bench(storage, 16);
+    bench.setYield(countYield);
+    case_calls = 0;
+    yield_calls = 0;
+
+    // Odd calls take 1 step, even calls 3: a batch of 2 averages 2 steps
+    uint32_t step_us = 5;
+    PerfBenchStats_t stats;
+    TEST_ASSERT_TRUE(bench.run(steppingCase, &step_us, 10, 4, 2, &stats));
+    TEST_ASSERT_EQUAL_UINT32(24, case_calls);
+    TEST_ASSERT_EQUAL_UINT32(14, yield_calls);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.samples);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, stats.min_us);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, stats.max_us);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.failures);    // Calls 10 and 20 (timed)
+
+    // Clamped to the storage, rejected without iterations or batch
+    TEST_ASSERT_TRUE(bench.run(steppingCase, &step_us, 100, 0, 1, &stats));
+    TEST_ASSERT_EQUAL_UINT32(16, stats.samples);
+    TEST_ASSERT_FALSE(bench.run(steppingCase, &step_us, 0, 0, 1, &stats));
+    TEST_ASSERT_FALSE(bench.run(steppingCase, &step_us, 4, 0, 0, &stats));
+}
+
+void test_report_text_is_stable() {
+    PerfReportWriter writer(captureLine, &report_text);
+    PerfReportHeader_t header = {"2.0.0", "esp32", "BIN\"01\\\n"};
+    writer.begin(header);
+    writer.add("loop_us", makeStats(5120, 0, 812.5f, 9876.125f));
+    writer.add("gsm_at_rtt", makeStats(0, 0, 0.0f, 0.0f));
+    writer.end();
+
+    TEST_ASSERT_EQUAL_size_t(2, writer.cases());
+    std::string expected =
+        "{\"schema\":\"binsai-perf/1\",\"firmware\":\"2.0.0\",\"target\":\"esp32\","
+        "\"device\":\"BIN\\\"01\\\\\\u000a\",\"cases\":[\n"
+        "{\"name\":\"loop_us\",\"n\":5120,\"failures\":0,\"min_us\":406.250,\"p50_us\":812.500,"
+        "\"p90_us\":5344.313,\"p99_us\":9876.125,\"max_us\":9876.125,\"mean_us\":812.500}\n"
+        ",{\"name\":\"gsm_at_rtt\",\"n\":0,\"failures\":0,\"min_us\":0.000,\"p50_us\":0.000,"
+        "\"p90_us\":0.000,\"p99_us\":0.000,\"max_us\":0.000,\"mean_us\":0.000}\n"
+        "]}\n";
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), report_text.c_str());
+}
+
+void test_parse_reads_back_from_a_log() {
+    PerfReportWriter writer(captureLine, &report_text);
+    PerfReportHeader_t header = {"2.1.0-rc1", "host", "ci"};
+    writer.begin(header);
+    writer.add("telemetry_encode", makeStats(200, 1, 0.25f, 0.75f));
+    writer.add("lcd_format", makeStats(200, 0, 1.5f, 3.0f));
+    writer.end();
+
+    std::string log = "test/benchmark/test_perf_report/test_main.cpp:80:test_x:PASS\n"
+                      "[BENCH] report follows\n" + report_text + "-----\n1 Tests 0 Failures\n";
+    PerfReport_t report;
+    std::string error;
+    TEST_ASSERT_TRUE_MESSAGE(perfReportParse(log.data(), log.size(), &report, &error), error.c_str());
+    TEST_ASSERT_EQUAL_STRING(PERF_REPORT_SCHEMA, report.schema.c_str());
+    TEST_ASSERT_EQUAL_STRING("2.1.0-rc1", report.firmware.c_str());
+    TEST_ASSERT_EQUAL_STRING("host", report.target.c_str());
+    TEST_ASSERT_EQUAL_size_t(2, report.cases.size());
+
+    const PerfReportCase_t* encode = perfReportFind(report, "telemetry_encode");
+    TEST_ASSERT_NOT_NULL(encode);
+    TEST_ASSERT_EQUAL_UINT32(200, encode->stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(1, encode->stats.failures);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, encode->stats.p50_us);
+    TEST_ASSERT_EQUAL_FLOAT(0.75f, encode->stats.p99_us);
+    TEST_ASSERT_NULL(perfReportFind(report, "missing"));
+
+    // Escapes round-trip
+    const char escaped[] = "{\"schema\":\"binsai-perf/1\",\"device\":\"BIN\\\"01\\\\\\u000a\\u00e9\",\"cases\":[]}";
+    TEST_ASSERT_TRUE(perfReportParse(escaped, strlen(escaped), &report, NULL));
+    TEST_ASSERT_EQUAL_STRING("BIN\"01\\\n\xC3\xA9", report.device.c_str());
+    TEST_ASSERT_EQUAL_size_t(0, report.cases.size());
+}
+
+void test_parse_accepts_additive_fields() {
+    // A later minor revision: new fields, nested values, whitespace
+    const char text[] =
+        "{ \"schema\" : \"binsai-perf/1.3\", \"build\": {\"flags\": [\"-O2\", null, true], \"lto\": false},\n"
+        "  \"cases\": [ { \"name\": \"loop_us\", \"n\": 10, \"p50_us\": 1.5e3, \"p99_us\": -0,"
+        " \"stddev_us\": 12.5, \"tags\": [] } ] }";
+    PerfReport_t report;
+    std::string error;
+    TEST_ASSERT_TRUE_MESSAGE(perfReportParse(text, strlen(text), &report, &error), error.c_str());
+    TEST_ASSERT_EQUAL_size_t(1, report.cases.size());
+    TEST_ASSERT_EQUAL_FLOAT(1500.0f, report.cases[0].stats.p50_us);
+    TEST_ASSERT_EQUAL_UINT32(10, report.cases[0].stats.samples);
+}
+
+void test_parse_rejects_malformed_reports() {
+    const char* bad[] = {
+        "no report here",
+        "{\"schema\":\"binsai-perf/2\",\"cases\":[]}",
+        "{\"schema\":\"other/1\",\"cases\":[]}",
+        "{\"schema\":\"binsai-perf/1\",\"cases\":[{\"n\":3}]}",
+        "{\"schema\":\"binsai-perf/1\",\"cases\":[{\"name\":\"x\",\"n\":-1}]}",
+        "{\"schema\":\"binsai-perf/1\",\"cases\":[{\"name\":\"x\",\"n\":2.5}]}",
+        "{\"schema\":\"binsai-perf/1\",\"cases\":[{\"name\":\"x\",\"p50_us\":.5}]}",
+        "{\"schema\":\"binsai-perf/1\",\"cases\":[{\"name\":\"x\"},]}",
+        "{\"schema\":\"binsai-perf/1\",\"cases\":[{\"name\":\"x\"}]",
+        "{\"schema\":\"binsai-perf/1\",\"device\":\"a\tb\",\"cases\":[]}",
+        "{\"schema\":\"binsai-perf/1\",\"x\":[[[[[[[[[[1]]]]]]]]]]}",
+        "{\"schema\":\"binsai-perf/1\",\"cases\":[{\"name\":\"\\uZZZZ\"}]}",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        PerfReport_t report;
+        std::string error;
+        TEST_ASSERT_TRUE_MESSAGE(!perfReportParse(bad[i], strlen(bad[i]), &report, &error), bad[i]);
+        TEST_ASSERT_TRUE_MESSAGE(error.compare(0, 7, "offset ") == 0, bad[i]);
+    }
+
+    // Truncated anywhere: never accepted, never read past the end
+    const char whole[] = "{\"schema\":\"binsai-perf/1\",\"cases\":[{\"name\":\"x\",\"n\":12,\"p50_us\":3.25}]}";
+    for (size_t length = 0; length < strlen(whole); length++) {
+        PerfReport_t report;
+        TEST_ASSERT_FALSE(perfReportParse(whole, length, &report, NULL));
+    }
+}
+
+void test_compare_flags_regressions() {
+    PerfReport_t baseline, candidate;
+    addCase(&baseline, "ultrasonic_read", makeStats(20, 0, 12000.0f, 14000.0f));
+    addCase(&baseline, "gas_read", makeStats(20, 0, 100.0f, 110.0f));
+    addCase(&baseline, "lcd_render", makeStats(20, 0, 8.0f, 9.0f));
+    addCase(&baseline, "blynk_publish", makeStats(20, 0, 900.0f, 1000.0f));
+    addCase(&baseline, "gsm_at_rtt", makeStats(20, 0, 50000.0f, 60000.0f));
+    addCase(&baseline, "loop_us", makeStats(5000, 0, 800.0f, 4000.0f));
+    addCase(&baseline, "sms_send", makeStats(3, 0, 4e6f, 5e6f));
+    addCase(&baseline, "removed", makeStats(20, 0, 10.0f, 10.0f));
+
+    addCase(&candidate, "ultrasonic_read", makeStats(20, 0, 13500.0f, 15000.0f));  // Median +12.5%
+    addCase(&candidate, "gas_read", makeStats(20, 0, 105.0f, 200.0f));             // Tail +82%
+    addCase(&candidate, "lcd_render", makeStats(20, 0, 16.0f, 18.0f));             // 2x, under the floor
+    addCase(&candidate, "blynk_publish", makeStats(20, 0, 600.0f, 700.0f));        // Faster
+    addCase(&candidate, "gsm_at_rtt", makeStats(20, 2, 50000.0f, 60000.0f));       // Timeouts
+    addCase(&candidate, "loop_us", makeStats(5000, 0, 860.0f, 4800.0f));           // Within tolerance
+    addCase(&candidate, "sms_send", makeStats(3, 0, 9e6f, 9e6f));                  // Too few samples
+    addCase(&candidate, "probe_fuse", makeStats(20, 0, 30.0f, 40.0f));
+
+    PerfCompareConfig_t config;
+    perfCompareDefaults(&config, "esp32");
+    std::vector<PerfComparison_t> results;
+    TEST_ASSERT_EQUAL_size_t(4, perfCompare(baseline, candidate, config, &results));
+    TEST_ASSERT_EQUAL_size_t(9, results.size());
+
+    const PerfVerdict_t expected[] = {
+        PERF_VERDICT_REGRESSED, PERF_VERDICT_REGRESSED, PERF_VERDICT_SAME, PERF_VERDICT_IMPROVED,
+        PERF_VERDICT_REGRESSED, PERF_VERDICT_SAME, PERF_VERDICT_SKIPPED, PERF_VERDICT_MISSING,
+        PERF_VERDICT_ADDED
+    };
+    for (size_t i = 0; i < results.size(); i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(expected[i], results[i].verdict, results[i].name.c_str());
+    }
+    TEST_ASSERT_EQUAL_STRING("p50_us", results[0].metric);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.5f, results[0].change_pct);
+    TEST_ASSERT_EQUAL_STRING("p99_us", results[1].metric);
+    TEST_ASSERT_EQUAL_STRING("failures", results[4].metric);
+    TEST_ASSERT_EQUAL_STRING("probe_fuse", results[8].name.c_str());
+    TEST_ASSERT_EQUAL_STRING("REGRESSED", perfVerdictName(results[0].verdict));
+
+    // A report compared with itself is clean; a looser tolerance clears the median
+    TEST_ASSERT_EQUAL_size_t(0, perfCompare(baseline, baseline, config, &results));
+    config.tolerance_pct = 20.0f;
+    perfCompare(baseline, candidate, config, &results);
+    TEST_ASSERT_EQUAL_INT(PERF_VERDICT_SAME, results[0].verdict);
+
+    // Host reports: no ESP32 timer floor, so the doubled LCD case counts
+    perfCompareDefaults(&config, "host");
+    perfCompare(baseline, candidate, config, &results);
+    TEST_ASSERT_EQUAL_INT(PERF_VERDICT_REGRESSED, results[2].verdict);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_stats_nearest_rank);
+    RUN_TEST(test_stats_from_histogram);
+    RUN_TEST(test_runner_times_batches_on_clock);
+    RUN_TEST(test_report_text_is_stable);
+    RUN_TEST(test_parse_reads_back_from_a_log);
+    RUN_TEST(test_parse_accepts_additive_fields);
+    RUN_TEST(test_parse_rejects_malformed_reports);
+    RUN_TEST(test_compare_flags_regressions);
+    return UNITY_END();
+}
@@ -0,0 +1,184 @@
+/**
+ * BINSAI Unit Test - Probe Array
+ * Rotating trigger schedule, cross-talk rejection across rounds, health
+ * scoring and volumetric fusion of several HC-SR04 probes.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <ProbeArray.h>
+
+#define SPEED       0.0346f     // cm/us at 25 C
+#define BIN_CM      40.0f
+#define RANGE_CM    45.0f
+
+void setUp() {}
+void tearDown() {}
+
+static BurstEstimate_t surface(float distance_cm, float spread_cm, uint8_t confidence) {
+    BurstEstimate_t estimate = {};
+    estimate.distance_cm = distance_cm;
+    estimate.spread_cm = spread_cm;
+    estimate.confidence = confidence;
+    return estimate;
+}
+
+void test_schedule_rotates_every_slot() {
+    for (uint8_t count = 1; count <= PROBE_ARRAY_MAX; count++) {
+        uint8_t slot_uses[PROBE_ARRAY_MAX][PROBE_ARRAY_MAX] = {};
+        for (uint8_t round = 0; round < 2 * count; round++) {
+            uint8_t seen = 0;
+            for (uint8_t probe = 0; probe < count; probe++) {
+                uint8_t slot = probeTriggerSlot(probe, round, count);
+                TEST_ASSERT_TRUE(slot < count);
+                TEST_ASSERT_EQUAL_UINT8(probe, probeInSlot(slot, round, count));
+                seen |= (uint8_t)(1 << slot);
+                slot_uses[probe][slot]++;
+            }
+            TEST_ASSERT_EQUAL_UINT8((1 << count) - 1, seen);     // A permutation
+        }
+        for (uint8_t probe = 0; probe < count; probe++) {
+            for (uint8_t slot = 0; slot < count; slot++) {
+                TEST_ASSERT_EQUAL_UINT8(2, slot_uses[probe][slot]);
+            }
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(burstPingPeriodUs(SPEED), probeRoundPeriodUs(1, SPEED));
+    TEST_ASSERT_EQUAL_UINT32(burstPingPeriodUs(SPEED) + 3 * (PROBE_STAGGER_US + 3 * PROBE_DITHER_US),
+                            probeRoundPeriodUs(4, SPEED));
+}
+
+void test_rotation_turns_cross_talk_into_outliers() {
+    // Probe 1 also hears probe 0's ping over a 140 cm wall bounce when
+    // probe 0 fires first, cutting its own 25 cm echo short
+    const uint8_t count = 2;
+    const uint8_t rounds = 7;
+    uint32_t echo[rounds];
+    uint8_t contaminated = 0;
+    for (uint8_t round = 0; round < rounds; round++) {
+        int32_t slots = (int32_t)probeTriggerSlot(1, round, count) - (int32_t)probeTriggerSlot(0, round, count);
+        float own_us = 2.0f * 25.0f / SPEED;
+        float heard_us = 140.0f / SPEED - slots * (float)probeStaggerUs(round, count);
+        if (heard_us > 0.0f && heard_us < own_us) {
+            echo[round] = (uint32_t)heard_us;
+            contaminated++;
+        } else {
+            echo[round] = (uint32_t)(own_us + 0.5f);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(2, contaminated);
+
+    BurstEstimate_t estimate;
+    TEST_ASSERT_TRUE(burstEstimate(echo, rounds, SPEED, RANGE_CM, &estimate));
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 25.0f, estimate.distance_cm);
+    TEST_ASSERT_EQUAL_UINT8(rounds - contaminated, estimate.accepted);
+
+    // Dither: each rotation uses a new stagger, then repeats
+    TEST_ASSERT_EQUAL_UINT32(PROBE_STAGGER_US, probeStaggerUs(1, count));
+    TEST_ASSERT_EQUAL_UINT32(PROBE_STAGGER_US + PROBE_DITHER_US, probeStaggerUs(2, count));
+    TEST_ASSERT_EQUAL_UINT32(PROBE_STAGGER_US, probeStaggerUs(2 * PROBE_DITHER_STEPS, count));
+}
+
+void test_health_tracks_failures_and_recovers() {
+    ProbeHealth_t health;
+    probeHealthInit(&health);
+    TEST_ASSERT_TRUE(probeHealthy(&health));
+
+    uint8_t failures = 0;
+    while (probeHealthy(&health)) {
+        probeHealthUpdate(&health, false, 0);
+        failures++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(4, failures);      // 100 -> 75 -> 57 -> 43 -> 33
+    TEST_ASSERT_EQUAL_UINT8(4, health.failure_streak);
+
+    for (uint8_t i = 0; i < 40; i++) {
+        probeHealthUpdate(&health, false, 0);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, health.score);  // Converges all the way
+
+    uint8_t recoveries = 0;
+    while (!probeHealthy(&health)) {
+        probeHealthUpdate(&health, true, 95);
+        recoveries++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(2, recoveries);
+    TEST_ASSERT_EQUAL_UINT8(0, health.failure_streak);
+    TEST_ASSERT_EQUAL_UINT32(44 + recoveries, health.bursts);
+    TEST_ASSERT_EQUAL_UINT32(44, health.failed_bursts);
+}
+
+void test_volumetric_fusion() {
+    // Heap under probe 0, probes 1-3 over a lower surface
+    BurstEstimate_t estimates[4] = { surface(10.0f, 1.0f, 90), surface(30.0f, 1.0f, 90),
+                                     surface(30.0f, 1.0f, 90), surface(30.0f, 1.0f, 90) };
+    bool valid[4] = { true, true, true, true };
+    ProbeHealth_t health[4];
+    for (uint8_t i = 0; i < 4; i++) probeHealthInit(&health[i]);
+
+    ProbeFusion_t fusion;
+    TEST_ASSERT_TRUE(probeArrayFuse(estimates, valid, health, 4, BIN_CM, &fusion));
+    TEST_ASSERT_EQUAL_UINT8(4, fusion.used);
+    TEST_ASSERT_FALSE(fusion.degraded);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 37.5f, fusion.fill_percentage);   // (75 + 3 x 25) / 4
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 75.0f, fusion.peak_fill_percentage);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 25.0f, fusion.distance_cm);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, sqrtf(1.0f + 75.0f), fusion.spread_cm);
+    TEST_ASSERT_EQUAL_UINT8(90, fusion.confidence);
+
+    // Overflowing heap is clamped per probe, not averaged past 100%
+    estimates[0].distance_cm = 0.0f;
+    estimates[1].distance_cm = 0.0f;
+    TEST_ASSERT_TRUE(probeArrayFuse(estimates, valid, health, 4, BIN_CM, &fusion));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 62.5f, fusion.fill_percentage);
+}
+
+void test_unhealthy_and_missing_probes() {
+    BurstEstimate_t estimates[3] = { surface(20.0f, 0.5f, 80), surface(5.0f, 0.5f, 80),
+                                     surface(20.0f, 0.5f, 80) };
+    bool valid[3] = { true, true, false };
+    ProbeHealth_t health[3];
+    for (uint8_t i = 0; i < 3; i++) probeHealthInit(&health[i]);
+    health[1].score = PROBE_HEALTHY_SCORE - 1;     // Obstructed probe
+
+    ProbeFusion_t fusion;
+    TEST_ASSERT_TRUE(probeArrayFuse(estimates, valid, health, 3, BIN_CM, &fusion));
+    TEST_ASSERT_EQUAL_UINT8(1, fusion.used);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f, fusion.distance_cm);
+    TEST_ASSERT_EQUAL_UINT8(26, fusion.confidence);    // One of three probes
+
+    // Only the unhealthy probe has a reading: used, flagged degraded
+    valid[0] = false;
+    TEST_ASSERT_TRUE(probeArrayFuse(estimates, valid, health, 3, BIN_CM, &fusion));
+    TEST_ASSERT_TRUE(fusion.degraded);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 5.0f, fusion.distance_cm);
+
+    valid[1] = false;
+    TEST_ASSERT_FALSE(probeArrayFuse(estimates, valid, health, 3, BIN_CM, &fusion));
+}
+
+void test_single_probe_matches_burst() {
+    BurstEstimate_t estimate = surface(17.3f, 0.8f, 93);
+    bool valid = true;
+    ProbeHealth_t health;
+    probeHealthInit(&health);
+
+    ProbeFusion_t fusion;
+    TEST_ASSERT_TRUE(probeArrayFuse(&estimate, &valid, &health, 1, BIN_CM, &fusion));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 17.3f, fusion.distance_cm);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.8f, fusion.spread_cm);
+    TEST_ASSERT_EQUAL_UINT8(93, fusion.confidence);
+    TEST_ASSERT_EQUAL_FLOAT(fusion.fill_percentage, fusion.peak_fill_percentage);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_schedule_rotates_every_slot);
+    RUN_TEST(test_rotation_turns_cross_talk_into_outliers);
+    RUN_TEST(test_health_tracks_failures_and_recovers);
+    RUN_TEST(test_volumetric_fusion);
+    RUN_TEST(test_unhealthy_and_missing_probes);
+    RUN_TEST(test_single_probe_matches_burst);
+    return UNITY_END();
+}
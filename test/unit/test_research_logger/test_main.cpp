@@ -0,0 +1,331 @@
+/**
+ * BINSAI Unit Test - Research Logger
+ * Record codec, block staging, flush interval, rotation under a byte
+ * budget, power cuts (unsynced and torn blocks) and write failures.
+ */
+
+#include <unity.h>
+#include <map>
+#include <vector>
+#include <math.h>
+#include <string.h>
+#include <ResearchLogger.h>
+
+/**
+ * RAM file system: appended bytes become durable on sync(); powerCut()
+ * discards the rest, optionally leaving a torn fragment behind
+ */
+class RamLogBackend : public ResearchLogBackend {
+public:
+    std::map<uint32_t, std::vector<uint8_t> > files;
+    std::map<uint32_t, size_t> durable;
+    bool has_open;
+    uint32_t open_index;
+    uint32_t syncs;
+    uint32_t fail_appends;          // >0: next N appends fail
+
+    void reset() {
+        files.clear();
+        durable.clear();
+        has_open = false;
+        syncs = 0;
+        fail_appends = 0;
+    }
+
+    void powerCut(size_t torn_bytes) {
+        for (std::map<uint32_t, std::vector<uint8_t> >::iterator it = files.begin(); it != files.end(); ++it) {
+            size_t keep = durable[it->first];
+            if (it->second.size() > keep) {
+                size_t torn = it->second.size() - keep < torn_bytes ? it->second.size() - keep : torn_bytes;
+                it->second.resize(keep + torn);
+                if (torn > 0) it->second[keep + torn - 1] ^= 0x5A;    // Half-programmed byte
+            }
+        }
+        has_open = false;
+    }
+
+    bool fileRange(uint32_t* first, uint32_t* last) {
+        if (files.empty()) return false;
+        *first = files.begin()->first;
+        *last = files.rbegin()->first;
+        return true;
+    }
+
+    uint32_t fileSize(uint32_t index) {
+        std::map<uint32_t, std::vector<uint8_t> >::iterator it = files.find(index);
+        return it == files.end() ? 0 : (uint32_t)it->second.size();
+    }
+
+    bool readFile(uint32_t index, uint32_t offset, void* buffer, size_t length) {
+        if (offset + length > fileSize(index)) return false;
+        memcpy(buffer, &files[index][offset], length);
+        return true;
+    }
+
+    bool openAppend(uint32_t index) {
+        files[index];
+        durable[index];
+        has_open = true;
+        open_index = index;
+        return true;
+    }
+
+    bool append(const void* data, size_t length) {
+        if (!has_open) return false;
+        if (fail_appends > 0) {
+            fail_appends--;
+            return false;
+        }
+        const uint8_t* bytes = (const uint8_t*)data;
+        files[open_index].insert(files[open_index].end(), bytes, bytes + length);
+        return true;
+    }
+
+    bool sync() {
+        if (!has_open) return false;
+        durable[open_index] = files[open_index].size();
+        syncs++;
+        return true;
+    }
+
+    void close() {
+        has_open = false;
+    }
+
+    bool removeFile(uint32_t index) {
+        durable.erase(index);
+        return files.erase(index) == 1;
+    }
+};
+
+static RamLogBackend backend;
+
+static ResearchLogConfig_t makeConfig(uint32_t file_blocks, uint32_t budget_blocks, uint8_t sync_blocks,
+                                      uint32_t flush_interval_ms) {
+    ResearchLogConfig_t config;
+    config.file_bytes = file_blocks * RESEARCH_LOG_BLOCK_SIZE;
+    config.budget_bytes = budget_blocks * RESEARCH_LOG_BLOCK_SIZE;
+    config.sync_blocks = sync_blocks;
+    config.flush_interval_ms = flush_interval_ms;
+    return config;
+}
+
+static ResearchLogRecord_t sample(uint32_t i) {
+    ResearchLogRecord_t record;
+    memset(&record, 0, sizeof(record));
+    record.millis = 60000 * i;
+    record.unix_ms = i % 3 == 0 ? 0 : 1792411200000LL + 60000LL * i;
+    record.distance_cm = 12.34f + (i % 10);
+    record.fill_percentage = 66.5f;
+    record.ppm_calculated = 512.3f;
+    record.adc_raw = (uint16_t)(1800 + i);
+    record.gps_fix = (i & 1) != 0;
+    record.latitude = -7.7956123;
+    record.longitude = 110.3694881;
+    record.satellite_count = 9;
+    record.capacity_level = 2;
+    record.waste_classification = 1;
+    record.priority_level = 3;
+    record.hours_to_full = i % 4 == 0 ? -1.0f : 17.3f;
+    return record;
+}
+
+static std::vector<ResearchLogRecord_t> replayed;
+
+static void collect(const ResearchLogRecord_t& record, void*) {
+    replayed.push_back(record);
+}
+
+static ResearchLogScan_t replayAll() {
+    replayed.clear();
+    ResearchLogScan_t scan;
+    researchLogReplay(backend, collect, NULL, &scan);
+    return scan;
+}
+
+void setUp() {
+    backend.reset();
+}
+
+void tearDown() {}
+
+void test_record_codec_round_trip() {
+    TEST_ASSERT_EQUAL_UINT32(13, RESEARCH_LOG_BLOCK_RECORDS);
+
+    uint8_t encoded[RESEARCH_LOG_RECORD_SIZE];
+    for (uint32_t i = 0; i < 8; i++) {
+        ResearchLogRecord_t in = sample(i);
+        ResearchLogRecord_t out;
+        researchLogEncodeRecord(in, encoded);
+        researchLogDecodeRecord(encoded, &out);
+        TEST_ASSERT_EQUAL_UINT32(in.millis, out.millis);
+        TEST_ASSERT_TRUE(in.unix_ms == out.unix_ms);
+        TEST_ASSERT_FLOAT_WITHIN(0.005f, in.distance_cm, out.distance_cm);
+        TEST_ASSERT_FLOAT_WITHIN(0.05f, in.ppm_calculated, out.ppm_calculated);
+        TEST_ASSERT_EQUAL_UINT16(in.adc_raw, out.adc_raw);
+        TEST_ASSERT_EQUAL(in.gps_fix, out.gps_fix);
+        TEST_ASSERT_TRUE(fabs(in.latitude - out.latitude) < 1e-7);
+        TEST_ASSERT_TRUE(fabs(in.longitude - out.longitude) < 1e-7);
+        TEST_ASSERT_EQUAL_UINT8(in.priority_level, out.priority_level);
+        TEST_ASSERT_FLOAT_WITHIN(0.05f, in.hours_to_full, out.hours_to_full);
+    }
+}
+
+void test_full_blocks_are_written_and_replayed() {
+    ResearchLogger logger(backend);
+    TEST_ASSERT_TRUE(logger.begin(makeConfig(64, 256, 1, 0)));
+    TEST_ASSERT_TRUE(backend.files.empty());     // Nothing created before the first block
+
+    for (uint32_t i = 0; i < 30; i++) {
+        TEST_ASSERT_TRUE(logger.append(sample(i), i * 60000));
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, logger.stats().blocks);
+    TEST_ASSERT_EQUAL_UINT8(4, logger.staged());
+    TEST_ASSERT_EQUAL_UINT32(2 * RESEARCH_LOG_BLOCK_SIZE, backend.fileSize(0));
+    TEST_ASSERT_EQUAL_UINT32(2, backend.syncs);
+
+    ResearchLogScan_t scan = replayAll();
+    TEST_ASSERT_EQUAL_UINT32(26, scan.records);
+    TEST_ASSERT_EQUAL_UINT32(0, scan.corrupt_blocks);
+    for (uint32_t i = 0; i < 26; i++) {
+        TEST_ASSERT_EQUAL_UINT32(sample(i).millis, replayed[i].millis);
+    }
+
+    TEST_ASSERT_TRUE(logger.flush());
+    scan = replayAll();
+    TEST_ASSERT_EQUAL_UINT32(30, scan.records);
+    TEST_ASSERT_EQUAL_UINT32(1, logger.stats().partial_blocks);
+    TEST_ASSERT_EQUAL_UINT32(3 * RESEARCH_LOG_BLOCK_SIZE, logger.stats().bytes_written);
+}
+
+void test_flush_interval_bounds_staging_time() {
+    ResearchLogger logger(backend);
+    TEST_ASSERT_TRUE(logger.begin(makeConfig(64, 256, 1, 600000)));
+
+    uint32_t now = 0;
+    for (uint32_t i = 0; i < 10; i++, now += 60000) {
+        logger.append(sample(i), now);
+        logger.loop(now);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, logger.stats().blocks);   // First record waited 9 min
+
+    logger.append(sample(10), now);
+    logger.loop(now);
+    TEST_ASSERT_EQUAL_UINT32(1, logger.stats().partial_blocks);
+    TEST_ASSERT_EQUAL_UINT8(0, logger.staged());
+    TEST_ASSERT_EQUAL_UINT32(1, backend.syncs);
+    TEST_ASSERT_EQUAL_UINT32(11, replayAll().records);
+}
+
+void test_rotation_keeps_log_under_budget() {
+    ResearchLogger logger(backend);
+    TEST_ASSERT_TRUE(logger.begin(makeConfig(2, 6, 1, 0)));
+
+    const uint32_t total = RESEARCH_LOG_BLOCK_RECORDS * 20;
+    for (uint32_t i = 0; i < total; i++) {
+        logger.append(sample(i), i);
+        uint32_t used = 0;
+        for (std::map<uint32_t, std::vector<uint8_t> >::iterator it = backend.files.begin();
+             it != backend.files.end(); ++it) {
+            used += (uint32_t)it->second.size();
+        }
+        TEST_ASSERT_TRUE(used <= 6 * RESEARCH_LOG_BLOCK_SIZE);
+        TEST_ASSERT_EQUAL_UINT32(used, logger.usedBytes());
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, logger.stats().files_opened);
+    TEST_ASSERT_EQUAL_UINT32(7, logger.stats().files_removed);
+    TEST_ASSERT_EQUAL_UINT32(3, backend.files.size());
+
+    // Newest six blocks survive, in order and without gaps
+    ResearchLogScan_t scan = replayAll();
+    TEST_ASSERT_EQUAL_UINT32(6, scan.blocks);
+    TEST_ASSERT_EQUAL_UINT32(0, scan.sequence_gaps);
+    TEST_ASSERT_EQUAL_UINT32(sample(total - 6 * RESEARCH_LOG_BLOCK_RECORDS).millis, replayed[0].millis);
+    TEST_ASSERT_EQUAL_UINT32(sample(total - 1).millis, replayed.back().millis);
+}
+
+void test_power_cut_loses_only_unsynced_blocks() {
+    {
+        ResearchLogger logger(backend);
+        TEST_ASSERT_TRUE(logger.begin(makeConfig(64, 256, 4, 0)));
+        for (uint32_t i = 0; i < RESEARCH_LOG_BLOCK_RECORDS * 6; i++) {
+            logger.append(sample(i), i);
+        }
+        TEST_ASSERT_EQUAL_UINT32(1, backend.syncs);       // After block 4
+    }
+    backend.powerCut(RESEARCH_LOG_BLOCK_SIZE + 100);      // Block 5 made it, block 6 torn
+
+    ResearchLogScan_t scan = replayAll();
+    TEST_ASSERT_EQUAL_UINT32(5, scan.blocks);
+    TEST_ASSERT_EQUAL_UINT32(0, scan.corrupt_blocks);      // Trailing fragment is not a block
+
+    // Restart: new file, sequence continues after the newest intact block
+    ResearchLogger logger(backend);
+    TEST_ASSERT_TRUE(logger.begin(makeConfig(64, 256, 4, 0)));
+    TEST_ASSERT_EQUAL_UINT32(5, logger.nextSequence());
+    for (uint32_t i = 0; i < RESEARCH_LOG_BLOCK_RECORDS; i++) {
+        logger.append(sample(i), i);
+    }
+    TEST_ASSERT_TRUE(logger.flush());
+    TEST_ASSERT_EQUAL_UINT32(1, logger.fileIndex());
+    scan = replayAll();
+    TEST_ASSERT_EQUAL_UINT32(6, scan.blocks);
+    TEST_ASSERT_EQUAL_UINT32(0, scan.sequence_gaps);
+}
+
+void test_torn_block_is_skipped() {
+    {
+        ResearchLogger logger(backend);
+        TEST_ASSERT_TRUE(logger.begin(makeConfig(64, 256, 1, 0)));
+        for (uint32_t i = 0; i < RESEARCH_LOG_BLOCK_RECORDS * 3; i++) {
+            logger.append(sample(i), i);
+        }
+    }
+    // Flash kept the full length of the last block but not its contents
+    backend.files[0][2 * RESEARCH_LOG_BLOCK_SIZE + 200] ^= 0xFF;
+
+    ResearchLogger logger(backend);
+    TEST_ASSERT_TRUE(logger.begin(makeConfig(64, 256, 1, 0)));
+    TEST_ASSERT_EQUAL_UINT32(2, logger.nextSequence());
+    ResearchLogScan_t scan = replayAll();
+    TEST_ASSERT_EQUAL_UINT32(2, scan.blocks);
+    TEST_ASSERT_EQUAL_UINT32(1, scan.corrupt_blocks);
+    TEST_ASSERT_EQUAL_UINT32(2 * RESEARCH_LOG_BLOCK_RECORDS, scan.records);
+}
+
+void test_write_failure_drops_block_and_reopens() {
+    ResearchLogger logger(backend);
+    TEST_ASSERT_TRUE(logger.begin(makeConfig(64, 256, 1, 0)));
+    for (uint32_t i = 0; i < RESEARCH_LOG_BLOCK_RECORDS; i++) {
+        logger.append(sample(i), i);
+    }
+
+    backend.fail_appends = 1;
+    bool ok = true;
+    for (uint32_t i = 0; i < RESEARCH_LOG_BLOCK_RECORDS; i++) {
+        ok = logger.append(sample(i), i) && ok;
+    }
+    TEST_ASSERT_FALSE(ok);
+    TEST_ASSERT_EQUAL_UINT32(1, logger.stats().write_errors);
+    TEST_ASSERT_EQUAL_UINT32(RESEARCH_LOG_BLOCK_RECORDS, logger.stats().records_dropped);
+
+    for (uint32_t i = 0; i < RESEARCH_LOG_BLOCK_RECORDS; i++) {
+        TEST_ASSERT_TRUE(logger.append(sample(i), i));
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, logger.fileIndex());      // Moved to a fresh file
+    ResearchLogScan_t scan = replayAll();
+    TEST_ASSERT_EQUAL_UINT32(2, scan.blocks);
+    TEST_ASSERT_EQUAL_UINT32(1, scan.sequence_gaps);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_record_codec_round_trip);
+    RUN_TEST(test_full_blocks_are_written_and_replayed);
+    RUN_TEST(test_flush_interval_bounds_staging_time);
+    RUN_TEST(test_rotation_keeps_log_under_budget);
+    RUN_TEST(test_power_cut_loses_only_unsynced_blocks);
+    RUN_TEST(test_torn_block_is_skipped);
+    RUN_TEST(test_write_failure_drops_block_and_reopens);
+    return UNITY_END();
+}
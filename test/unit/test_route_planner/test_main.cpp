@@ -0,0 +1,164 @@
+/**
+ * BINSAI Unit Test - Route Planner
+ * Coverage, capacity and ordering invariants on small synthetic cities.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include <vector>
+#include <RoutePlanner.h>
+
+static RoutePlannerConfig_t config;
+
+void setUp() {
+    routePlannerDefaults(&config);
+    config.thread_count = 1;
+}
+
+void tearDown() {}
+
+static RouteStop_t stopAt(uint32_t id, double north_m, double east_m, float demand, uint8_t priority) {
+    RouteStop_t stop;
+    stop.id = id;
+    stop.latitude = config.depot_latitude + north_m / 111320.0;
+    stop.longitude = config.depot_longitude + east_m / (111320.0 * cos(config.depot_latitude * M_PI / 180.0));
+    stop.demand = demand;
+    stop.priority = priority;
+    return stop;
+}
+
+/**
+ * Every stop appears in exactly one route and no route exceeds capacity
+ */
+static void assertValidPlan(const std::vector<RouteStop_t>& stops, const RoutePlan_t& plan) {
+    std::vector<int> seen(stops.size(), 0);
+    for (size_t r = 0; r < plan.routes.size(); r++) {
+        float load = 0.0f;
+        for (size_t i = 0; i < plan.routes[r].stops.size(); i++) {
+            uint32_t index = plan.routes[r].stops[i];
+            TEST_ASSERT_TRUE(index < stops.size());
+            seen[index]++;
+            load += stops[index].demand;
+        }
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, load, plan.routes[r].load);
+        if (plan.routes[r].stops.size() > 1) {
+            TEST_ASSERT_TRUE(load <= config.vehicle_capacity + 0.01f);
+        }
+    }
+    for (size_t i = 0; i < stops.size(); i++) {
+        TEST_ASSERT_EQUAL_INT(1, seen[i]);
+    }
+}
+
+void test_synthetic_city_is_deterministic() {
+    std::vector<RouteStop_t> a, b, c;
+    routeSyntheticCity(200, 7, &a);
+    routeSyntheticCity(200, 7, &b);
+    routeSyntheticCity(200, 8, &c);
+    TEST_ASSERT_EQUAL(200, a.size());
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&a[0], &b[0], a.size() * sizeof(RouteStop_t)));
+    TEST_ASSERT_TRUE(memcmp(&a[0], &c[0], a.size() * sizeof(RouteStop_t)) != 0);
+}
+
+void test_stop_from_sensor_clamps_fill() {
+    SensorData_t data;
+    memset(&data, 0, sizeof(data));
+    data.fill_percentage = 130.0f;
+    data.priority_level = 3;
+    data.latitude = -7.8;
+    RouteStop_t stop = routeStopFromSensor(data, 5, 120.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 120.0f, stop.demand);
+    TEST_ASSERT_EQUAL_UINT8(3, stop.priority);
+    TEST_ASSERT_EQUAL_UINT32(5, stop.id);
+}
+
+void test_collinear_stops_form_one_route() {
+    std::vector<RouteStop_t> stops;
+    for (uint32_t i = 0; i < 10; i++) {
+        stops.push_back(stopAt(i, 0.0, 500.0 * (i + 1), 50.0f, 1));
+    }
+    RoutePlan_t plan = RoutePlanner(config).plan(stops);
+    TEST_ASSERT_EQUAL(1, plan.routes.size());
+    TEST_ASSERT_FLOAT_WITHIN(1.0, 2.0 * 5000.0 * config.circuity_factor, plan.total_length_m);
+    assertValidPlan(stops, plan);
+}
+
+void test_capacity_splits_routes() {
+    std::vector<RouteStop_t> stops;
+    for (uint32_t i = 0; i < 12; i++) {
+        stops.push_back(stopAt(i, 300.0 * (i % 4), 300.0 * (i / 4) + 1000.0, 1000.0f, 1));
+    }
+    config.vehicle_capacity = 3000.0f;
+    RoutePlan_t plan = RoutePlanner(config).plan(stops);
+    TEST_ASSERT_TRUE(plan.routes.size() >= 4);
+    assertValidPlan(stops, plan);
+}
+
+void test_oversized_stop_gets_own_route() {
+    std::vector<RouteStop_t> stops;
+    stops.push_back(stopAt(0, 1000.0, 0.0, 100.0f, 1));
+    stops.push_back(stopAt(1, 1100.0, 0.0, 9000.0f, 1));
+    stops.push_back(stopAt(2, 1200.0, 0.0, 100.0f, 1));
+    RoutePlan_t plan = RoutePlanner(config).plan(stops);
+    TEST_ASSERT_EQUAL(2, plan.routes.size());
+    assertValidPlan(stops, plan);
+}
+
+void test_max_stops_per_route() {
+    std::vector<RouteStop_t> stops;
+    routeSyntheticCity(100, 3, &stops);
+    config.max_stops_per_route = 8;
+    RoutePlan_t plan = RoutePlanner(config).plan(stops);
+    for (size_t r = 0; r < plan.routes.size(); r++) {
+        TEST_ASSERT_TRUE(plan.routes[r].stops.size() <= 8);
+    }
+    assertValidPlan(stops, plan);
+}
+
+void test_critical_routes_first() {
+    std::vector<RouteStop_t> stops;
+    stops.push_back(stopAt(0, 500.0, 0.0, 6000.0f, 1));
+    stops.push_back(stopAt(1, -8000.0, 0.0, 6000.0f, 3));
+    RoutePlan_t plan = RoutePlanner(config).plan(stops);
+    TEST_ASSERT_EQUAL(2, plan.routes.size());
+    TEST_ASSERT_EQUAL_UINT8(3, plan.routes[0].max_priority);
+    TEST_ASSERT_EQUAL_UINT32(1, plan.routes[0].stops[0]);
+}
+
+void test_local_search_never_worse_than_savings() {
+    std::vector<RouteStop_t> stops;
+    routeSyntheticCity(500, 11, &stops);
+    RoutePlan_t plan = RoutePlanner(config).plan(stops);
+    assertValidPlan(stops, plan);
+    TEST_ASSERT_TRUE(plan.total_length_m <= plan.savings_length_m + 1e-6);
+    TEST_ASSERT_TRUE(plan.graph_edges <= 500 * ROUTE_DEFAULT_NEIGHBORS);
+}
+
+void test_result_independent_of_thread_count() {
+    std::vector<RouteStop_t> stops;
+    routeSyntheticCity(400, 21, &stops);
+    RoutePlan_t single = RoutePlanner(config).plan(stops);
+    config.thread_count = 4;
+    RoutePlan_t parallel = RoutePlanner(config).plan(stops);
+
+    TEST_ASSERT_EQUAL(single.routes.size(), parallel.routes.size());
+    TEST_ASSERT_TRUE(fabs(single.total_length_m - parallel.total_length_m) < 1e-6);
+    for (size_t r = 0; r < single.routes.size(); r++) {
+        TEST_ASSERT_TRUE(single.routes[r].stops == parallel.routes[r].stops);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_synthetic_city_is_deterministic);
+    RUN_TEST(test_stop_from_sensor_clamps_fill);
+    RUN_TEST(test_collinear_stops_form_one_route);
+    RUN_TEST(test_capacity_splits_routes);
+    RUN_TEST(test_oversized_stop_gets_own_route);
+    RUN_TEST(test_max_stops_per_route);
+    RUN_TEST(test_critical_routes_first);
+    RUN_TEST(test_local_search_never_worse_than_savings);
+    RUN_TEST(test_result_independent_of_thread_count);
+    return UNITY_END();
+}
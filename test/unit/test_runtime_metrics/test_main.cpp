@@ -0,0 +1,213 @@
+/**
+ * BINSAI Unit Test - Runtime Metrics
+ * Verifies bucket boundaries, quantile estimates, interval windows, scoped
+ * timing on a virtual clock and lock-free updates from several threads.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include <RuntimeMetrics.h>
+
+static MetricsRegistry registry;
+static MetricCounter test_events(registry, "events");
+static MetricGauge test_heap(registry, "heap_free");
+static MetricHistogram test_latency(registry, "latency_us");
+
+static uint32_t fake_now_us = 0;
+
+static uint32_t fakeClockUs() {
+    return fake_now_us;
+}
+
+void setUp() {
+    registry.reset();
+    metricsSetClock(fakeClockUs);
+    fake_now_us = 0;
+}
+
+void tearDown() {
+    metricsSetClock(nullptr);
+}
+
+void test_registry_keeps_declaration_order() {
+    TEST_ASSERT_EQUAL_UINT32(3, registry.count());
+    TEST_ASSERT_EQUAL_STRING("events", registry.first()->name());
+    TEST_ASSERT_EQUAL_STRING("heap_free", registry.first()->next()->name());
+    TEST_ASSERT_TRUE(registry.find("latency_us") == &test_latency);
+    TEST_ASSERT_TRUE(registry.find("missing") == nullptr);
+}
+
+void test_bucket_boundaries() {
+    TEST_ASSERT_EQUAL_UINT8(0, metricsBucketIndex(0));
+    TEST_ASSERT_EQUAL_UINT8(0, metricsBucketIndex(63));
+    TEST_ASSERT_EQUAL_UINT8(1, metricsBucketIndex(64));
+    TEST_ASSERT_EQUAL_UINT8(1, metricsBucketIndex(127));
+    TEST_ASSERT_EQUAL_UINT8(2, metricsBucketIndex(128));
+    TEST_ASSERT_EQUAL_UINT8(14, metricsBucketIndex(1000000));
+    TEST_ASSERT_EQUAL_UINT8(METRICS_HISTOGRAM_BUCKETS - 1, metricsBucketIndex(UINT32_MAX));
+
+    for (uint8_t bucket = 0; bucket < METRICS_HISTOGRAM_BUCKETS - 1; bucket++) {
+        uint32_t upper = metricsBucketUpperUs(bucket);
+        TEST_ASSERT_EQUAL_UINT8(bucket, metricsBucketIndex(upper - 1));
+        TEST_ASSERT_EQUAL_UINT8(bucket + 1, metricsBucketIndex(upper));
+    }
+}
+
+void test_quantiles_within_one_bucket_width() {
+    // 1..10000 us uniformly: true p50 = 5000, p90 = 9000, p99 = 9900
+    for (uint32_t us = 1; us <= 10000; us++) {
+        test_latency.record(us);
+    }
+    MetricHistogramSnapshot_t snapshot;
+    test_latency.snapshot(&snapshot);
+    TEST_ASSERT_EQUAL_UINT32(10000, snapshot.count);
+    TEST_ASSERT_EQUAL_UINT32(10000, snapshot.max_us);
+    TEST_ASSERT_EQUAL_UINT32(50005000UL, snapshot.sum_us);
+
+    // Linear interpolation inside power-of-two buckets is exact for a
+    // uniform distribution
+    TEST_ASSERT_UINT32_WITHIN(50, 5000, metricsQuantileUs(snapshot, 0.50f));
+    TEST_ASSERT_UINT32_WITHIN(90, 9000, metricsQuantileUs(snapshot, 0.90f));
+    TEST_ASSERT_UINT32_WITHIN(99, 9900, metricsQuantileUs(snapshot, 0.99f));
+    TEST_ASSERT_EQUAL_UINT32(10000, metricsQuantileUs(snapshot, 1.0f));
+
+    MetricHistogramSnapshot_t empty;
+    memset(&empty, 0, sizeof(empty));
+    TEST_ASSERT_EQUAL_UINT32(0, metricsQuantileUs(empty, 0.5f));
+}
+
+void test_quantile_capped_at_max() {
+    // A single slow sample in the open-ended bucket
+    test_latency.record(3000000);
+    MetricHistogramSnapshot_t snapshot;
+    test_latency.snapshot(&snapshot);
+    TEST_ASSERT_EQUAL_UINT32(3000000, metricsQuantileUs(snapshot, 0.99f));
+}
+
+void test_windows_report_interval_deltas() {
+    test_events.add(5);
+    test_latency.record(100);
+    test_latency.record(5000);
+    registry.closeWindow();
+    TEST_ASSERT_EQUAL_UINT32(5, test_events.window());
+    TEST_ASSERT_EQUAL_UINT32(2, test_latency.window().count);
+    TEST_ASSERT_EQUAL_UINT32(5000, test_latency.window().max_us);
+
+    test_events.add(2);
+    test_latency.record(200);
+    registry.closeWindow();
+    TEST_ASSERT_EQUAL_UINT32(2, test_events.window());
+    TEST_ASSERT_EQUAL_UINT32(7, test_events.value());
+    TEST_ASSERT_EQUAL_UINT32(1, test_latency.window().count);
+    TEST_ASSERT_EQUAL_UINT32(200, test_latency.window().sum_us);
+    TEST_ASSERT_EQUAL_UINT32(200, test_latency.window().max_us);
+
+    MetricHistogramSnapshot_t lifetime;
+    test_latency.snapshot(&lifetime);
+    TEST_ASSERT_EQUAL_UINT32(3, lifetime.count);
+    TEST_ASSERT_EQUAL_UINT32(5000, lifetime.max_us);
+}
+
+void test_gauge_watermarks() {
+    char line[96];
+    test_heap.format(line, sizeof(line), false);
+    TEST_ASSERT_EQUAL_STRING("heap_free value=-", line);
+
+    test_heap.set(150000);
+    test_heap.set(120000);
+    test_heap.set(140000);
+    registry.closeWindow();
+    test_heap.set(145000);
+    TEST_ASSERT_EQUAL_INT32(145000, test_heap.value());
+    TEST_ASSERT_EQUAL_INT32(120000, test_heap.min());
+    TEST_ASSERT_EQUAL_INT32(150000, test_heap.max());
+
+    test_heap.format(line, sizeof(line), true);
+    TEST_ASSERT_EQUAL_STRING("heap_free value=145000 min=120000 max=150000", line);
+    registry.closeWindow();
+    test_heap.format(line, sizeof(line), true);
+    TEST_ASSERT_EQUAL_STRING("heap_free value=145000 min=145000 max=145000", line);
+}
+
+static void timedSection(uint32_t duration_us) {
+    METRIC_TIME_SCOPE(test_latency);
+    fake_now_us += duration_us;
+}
+
+void test_scoped_timer_and_clock_wrap() {
+    fake_now_us = 1000;
+    timedSection(250);
+    fake_now_us = UINT32_MAX - 100;      // micros() wraps every ~71 minutes
+    timedSection(300);
+
+    registry.closeWindow();
+    TEST_ASSERT_EQUAL_UINT32(2, test_latency.window().count);
+    TEST_ASSERT_EQUAL_UINT32(550, test_latency.window().sum_us);
+    TEST_ASSERT_EQUAL_UINT32(300, test_latency.window().max_us);
+}
+
+void test_format_lines() {
+    char line[128];
+    test_events.add(3);
+    test_latency.record(1000);
+    test_latency.record(3000);
+    registry.closeWindow();
+
+    test_events.format(line, sizeof(line), false);
+    TEST_ASSERT_EQUAL_STRING("events total=3", line);
+    test_events.add(1);
+    test_events.format(line, sizeof(line), true);
+    TEST_ASSERT_EQUAL_STRING("events delta=3", line);
+    test_latency.format(line, sizeof(line), true);
+    TEST_ASSERT_TRUE(strncmp(line, "latency_us n=2 mean=2000 p50=", 29) == 0);
+    TEST_ASSERT_TRUE(strstr(line, "max=3000") != nullptr);
+
+    // Truncation keeps the buffer terminated and reports what fit
+    char small[10];
+    TEST_ASSERT_EQUAL_UINT32(9, test_latency.format(small, sizeof(small), false));
+    TEST_ASSERT_EQUAL_STRING("latency_u", small);
+}
+
+void test_concurrent_updates_are_not_lost() {
+    const int threads = 4;
+    const uint32_t per_thread = 100000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(std::thread([t, per_thread]() {
+            for (uint32_t i = 0; i < per_thread; i++) {
+                test_events.add();
+                test_latency.record((i % 1000) + (uint32_t)t);
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+
+    MetricHistogramSnapshot_t snapshot;
+    test_latency.snapshot(&snapshot);
+    uint32_t bucket_total = 0;
+    for (uint8_t i = 0; i < METRICS_HISTOGRAM_BUCKETS; i++) {
+        bucket_total += snapshot.buckets[i];
+    }
+    TEST_ASSERT_EQUAL_UINT32(threads * per_thread, test_events.value());
+    TEST_ASSERT_EQUAL_UINT32(threads * per_thread, snapshot.count);
+    TEST_ASSERT_EQUAL_UINT32(threads * per_thread, bucket_total);
+    TEST_ASSERT_EQUAL_UINT32(999 + threads - 1, snapshot.max_us);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_registry_keeps_declaration_order);
+    RUN_TEST(test_bucket_boundaries);
+    RUN_TEST(test_quantiles_within_one_bucket_width);
+    RUN_TEST(test_quantile_capped_at_max);
+    RUN_TEST(test_windows_report_interval_deltas);
+    RUN_TEST(test_gauge_watermarks);
+    RUN_TEST(test_scoped_timer_and_clock_wrap);
+    RUN_TEST(test_format_lines);
+    RUN_TEST(test_concurrent_updates_are_not_lost);
+    return UNITY_END();
+}
@@ -0,0 +1,175 @@
+/**
+ * BINSAI Unit Test - Serial Console
+ * Verifies tokenizer, constexpr command table dispatch and config field access.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <SerialConsole.h>
+#include <ConfigFields.h>
+
+/**
+ * Output sink capturing into a fixed buffer
+ */
+class BufferOutput : public ConsoleOutput {
+public:
+    char text[512];
+    size_t length;
+
+    void clear() { length = 0; text[0] = '\0'; }
+
+    void write(const char* data, size_t n) {
+        if (length + n >= sizeof(text)) n = sizeof(text) - 1 - length;
+        memcpy(text + length, data, n);
+        length += n;
+        text[length] = '\0';
+    }
+};
+
+static BufferOutput output;
+static uint8_t last_argc = 0;
+static char last_arg[32];
+
+static void handleEcho(uint8_t argc, char* argv[], ConsoleOutput& out) {
+    last_argc = argc;
+    strncpy(last_arg, argv[argc - 1], sizeof(last_arg) - 1);
+    out.println("OK");
+}
+
+static constexpr ConsoleCommand_t TEST_COMMANDS[] = {
+    CONSOLE_COMMAND("STATUS", 0, "STATUS", handleEcho),
+    CONSOLE_COMMAND("SET", 2, "SET <field> <value>", handleEcho),
+};
+static_assert(consoleTableIsValid(TEST_COMMANDS, 2), "duplicate console command");
+static_assert(consoleHash("status") == consoleHash("STATUS"), "hash must ignore case");
+
+void setUp() {
+    output.clear();
+    last_argc = 0;
+    memset(last_arg, 0, sizeof(last_arg));
+}
+
+void tearDown() {}
+
+void test_tokenize_whitespace_and_quotes() {
+    char line[] = "  SET  wifi_ssid \"Kampus Wifi\"  ";
+    char* tokens[CONSOLE_MAX_TOKENS];
+    TEST_ASSERT_EQUAL_UINT8(3, consoleTokenize(line, tokens, CONSOLE_MAX_TOKENS));
+    TEST_ASSERT_EQUAL_STRING("SET", tokens[0]);
+    TEST_ASSERT_EQUAL_STRING("wifi_ssid", tokens[1]);
+    TEST_ASSERT_EQUAL_STRING("Kampus Wifi", tokens[2]);
+}
+
+void test_tokenize_respects_max_tokens() {
+    char line[] = "a b c d e";
+    char* tokens[3];
+    TEST_ASSERT_EQUAL_UINT8(3, consoleTokenize(line, tokens, 3));
+}
+
+void test_lookup_is_case_insensitive() {
+    TEST_ASSERT_NOT_NULL(consoleFind(TEST_COMMANDS, 2, "status"));
+    TEST_ASSERT_NULL(consoleFind(TEST_COMMANDS, 2, "STATU"));
+    TEST_ASSERT_NULL(consoleFind(TEST_COMMANDS, 2, "STATUSX"));
+}
+
+void test_feed_dispatches_on_newline() {
+    SerialConsole console(TEST_COMMANDS, 2, output);
+    const char* input = "set zone 4\r\n";
+    bool dispatched = false;
+    for (const char* c = input; *c; c++) {
+        dispatched |= console.feed(*c);
+    }
+    TEST_ASSERT_TRUE(dispatched);
+    TEST_ASSERT_EQUAL_UINT8(3, last_argc);
+    TEST_ASSERT_EQUAL_STRING("4", last_arg);
+    TEST_ASSERT_EQUAL_UINT32(1, console.commandCount());
+}
+
+void test_missing_arguments_reports_usage() {
+    SerialConsole console(TEST_COMMANDS, 2, output);
+    char line[] = "SET zone";
+    TEST_ASSERT_FALSE(console.execute(line));
+    TEST_ASSERT_NOT_NULL(strstr(output.text, "ERROR usage"));
+}
+
+void test_overlong_line_is_rejected() {
+    SerialConsole console(TEST_COMMANDS, 2, output);
+    for (int i = 0; i < CONSOLE_LINE_MAX + 10; i++) {
+        console.feed('A');
+    }
+    TEST_ASSERT_FALSE(console.feed('\n'));
+    TEST_ASSERT_NOT_NULL(strstr(output.text, "too long"));
+    TEST_ASSERT_EQUAL_UINT32(1, console.errorCount());
+}
+
+void test_config_fields_cover_every_member() {
+    size_t covered = 0;
+    for (uint8_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        covered += CONFIG_FIELDS[i].size;
+    }
+    // Everything except padding is addressable by name
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(SystemConfig_t), covered);
+    TEST_ASSERT_GREATER_THAN(sizeof(SystemConfig_t) - 8, covered);
+}
+
+void test_config_field_set_and_format() {
+    SystemConfig_t config;
+    memset(&config, 0, sizeof(config));
+    char text[40];
+
+    const ConfigField_t* zone = configFieldFind("DEPLOYMENT_ZONE");
+    TEST_ASSERT_TRUE(configFieldSet(&config, zone, "12"));
+    TEST_ASSERT_EQUAL_UINT8(12, config.deployment_zone);
+    TEST_ASSERT_FALSE(configFieldSet(&config, zone, "256"));
+    TEST_ASSERT_FALSE(configFieldSet(&config, zone, "-1"));
+
+    const ConfigField_t* r0 = configFieldFind("mq135_r0_calibrated");
+    TEST_ASSERT_TRUE(configFieldSet(&config, r0, "9.85"));
+    TEST_ASSERT_FALSE(configFieldSet(&config, r0, "9.85x"));
+    configFieldFormat(&config, r0, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("9.8500", text);
+
+    const ConfigField_t* modular = configFieldFind("is_modular_unit");
+    TEST_ASSERT_TRUE(configFieldSet(&config, modular, "true"));
+    TEST_ASSERT_TRUE(config.is_modular_unit);
+}
+
+void test_config_string_fields_refuse_truncation() {
+    SystemConfig_t config;
+    memset(&config, 0, sizeof(config));
+    const ConfigField_t* ssid = configFieldFind("wifi_ssid");
+
+    TEST_ASSERT_TRUE(configFieldSet(&config, ssid, "Kampus Wifi"));
+    TEST_ASSERT_EQUAL_STRING("Kampus Wifi", config.wifi_ssid);
+    TEST_ASSERT_FALSE(configFieldSet(&config, ssid, "0123456789012345678901234567890123"));
+    TEST_ASSERT_EQUAL_STRING("Kampus Wifi", config.wifi_ssid);
+}
+
+void test_config_secret_and_readonly_fields() {
+    SystemConfig_t config;
+    memset(&config, 0, sizeof(config));
+    char text[40];
+
+    const ConfigField_t* password = configFieldFind("wifi_password");
+    configFieldSet(&config, password, "hunter2");
+    configFieldFormat(&config, password, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("********", text);
+
+    TEST_ASSERT_FALSE(configFieldSet(&config, configFieldFind("firmware_version"), "9.9.9"));
+    TEST_ASSERT_NULL(configFieldFind("no_such_field"));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tokenize_whitespace_and_quotes);
+    RUN_TEST(test_tokenize_respects_max_tokens);
+    RUN_TEST(test_lookup_is_case_insensitive);
+    RUN_TEST(test_feed_dispatches_on_newline);
+    RUN_TEST(test_missing_arguments_reports_usage);
+    RUN_TEST(test_overlong_line_is_rejected);
+    RUN_TEST(test_config_fields_cover_every_member);
+    RUN_TEST(test_config_field_set_and_format);
+    RUN_TEST(test_config_string_fields_refuse_truncation);
+    RUN_TEST(test_config_secret_and_readonly_fields);
+    return UNITY_END();
+}
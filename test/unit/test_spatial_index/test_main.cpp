@@ -0,0 +1,193 @@
+/**
+ * BINSAI Unit Test - Spatial Index
+ * Radius, k-NN and zone queries checked against brute force, plus moves
+ * and removals that reshuffle bucket slots.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include <SpatialIndex.h>
+
+#define CITY_LATITUDE       -7.7956
+#define CITY_LONGITUDE      110.3695
+#define POINT_COUNT         5000
+
+static std::vector<SpatialPoint_t> points;
+
+static double randomUnit(uint32_t* seed) {
+    *seed = *seed * 1664525UL + 1013904223UL;
+    return (double)(*seed >> 8) / (double)(1UL << 24);
+}
+
+static SpatialPoint_t randomPoint(uint64_t id, uint32_t* seed) {
+    SpatialPoint_t point;
+    point.id = id;
+    point.latitude = CITY_LATITUDE + (randomUnit(seed) - 0.5) * 0.2;
+    point.longitude = CITY_LONGITUDE + (randomUnit(seed) - 0.5) * 0.2;
+    point.zone = (uint8_t)(id % 14 + 1);
+    point.priority = (uint8_t)(id % 4);
+    return point;
+}
+
+static std::vector<SpatialHit_t> bruteForce(double lat, double lon, double radius_m, uint8_t min_priority) {
+    std::vector<SpatialHit_t> hits;
+    for (size_t i = 0; i < points.size(); i++) {
+        if (points[i].priority < min_priority) continue;
+        double d = SpatialIndex::distanceMetres(lat, lon, points[i].latitude, points[i].longitude);
+        if (d <= radius_m) {
+            SpatialHit_t hit = {points[i].id, d};
+            hits.push_back(hit);
+        }
+    }
+    std::sort(hits.begin(), hits.end(), [](const SpatialHit_t& a, const SpatialHit_t& b) {
+        return a.distance_m != b.distance_m ? a.distance_m < b.distance_m : a.id < b.id;
+    });
+    return hits;
+}
+
+static void assertSameHits(const std::vector<SpatialHit_t>& expected, const std::vector<SpatialHit_t>& actual) {
+    TEST_ASSERT_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        TEST_ASSERT_TRUE(expected[i].id == actual[i].id);
+    }
+}
+
+void setUp() {
+    points.clear();
+    uint32_t seed = 99;
+    for (uint64_t id = 0; id < POINT_COUNT; id++) {
+        points.push_back(randomPoint(id, &seed));
+    }
+}
+
+void tearDown() {}
+
+static void fill(SpatialIndex& index) {
+    for (size_t i = 0; i < points.size(); i++) {
+        TEST_ASSERT_TRUE(index.upsert(points[i]));
+    }
+}
+
+void test_distance_matches_haversine_at_city_scale() {
+    // 1 km due east and north of the depot
+    double east = SpatialIndex::distanceMetres(CITY_LATITUDE, CITY_LONGITUDE, CITY_LATITUDE,
+                                               CITY_LONGITUDE + 1000.0 / (111320.0 * cos(CITY_LATITUDE * M_PI / 180.0)));
+    double north = SpatialIndex::distanceMetres(CITY_LATITUDE, CITY_LONGITUDE, CITY_LATITUDE + 1000.0 / 111320.0,
+                                                CITY_LONGITUDE);
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 1000.0, east);
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 1000.0, north);
+}
+
+void test_radius_matches_brute_force() {
+    SpatialIndex index;
+    fill(index);
+    std::vector<SpatialHit_t> hits;
+    uint32_t seed = 7;
+    for (int q = 0; q < 50; q++) {
+        SpatialPoint_t center = randomPoint(0, &seed);
+        double radius = 200.0 + randomUnit(&seed) * 3000.0;
+        uint8_t min_priority = (uint8_t)(q % 4);
+        index.withinRadius(center.latitude, center.longitude, radius, min_priority, &hits);
+        assertSameHits(bruteForce(center.latitude, center.longitude, radius, min_priority), hits);
+    }
+}
+
+void test_large_radius_uses_full_scan() {
+    SpatialIndex index;
+    fill(index);
+    std::vector<SpatialHit_t> hits;
+    TEST_ASSERT_EQUAL(POINT_COUNT, index.withinRadius(CITY_LATITUDE, CITY_LONGITUDE, 50000.0, 0, &hits));
+}
+
+void test_nearest_matches_brute_force() {
+    SpatialIndex index;
+    fill(index);
+    std::vector<SpatialHit_t> hits;
+    uint32_t seed = 13;
+    for (int q = 0; q < 50; q++) {
+        SpatialPoint_t center = randomPoint(0, &seed);
+        uint8_t min_priority = (uint8_t)(q % 4);
+        index.nearest(center.latitude, center.longitude, 10, min_priority, &hits);
+        std::vector<SpatialHit_t> expected = bruteForce(center.latitude, center.longitude, 1e9, min_priority);
+        expected.resize(10);
+        assertSameHits(expected, hits);
+    }
+}
+
+void test_nearest_far_from_all_points() {
+    SpatialIndex index;
+    fill(index);
+    std::vector<SpatialHit_t> hits;
+    TEST_ASSERT_EQUAL(3, index.nearest(-6.2, 106.8, 3, 0, &hits));  // Jakarta
+    std::vector<SpatialHit_t> expected = bruteForce(-6.2, 106.8, 1e9, 0);
+    expected.resize(3);
+    assertSameHits(expected, hits);
+}
+
+void test_moves_and_removals_keep_index_consistent() {
+    SpatialIndex index;
+    fill(index);
+    uint32_t seed = 21;
+    for (int round = 0; round < 3; round++) {
+        for (size_t i = 0; i < points.size(); i += 3) {
+            uint64_t id = points[i].id;
+            points[i] = randomPoint(id, &seed);
+            points[i].zone = (uint8_t)((id + round) % 14 + 1);
+            TEST_ASSERT_FALSE(index.upsert(points[i]));
+        }
+    }
+    for (size_t i = 0; i < points.size(); i += 5) {
+        TEST_ASSERT_TRUE(index.remove(points[i].id));
+    }
+    TEST_ASSERT_FALSE(index.remove(points[0].id));
+    std::vector<SpatialPoint_t> remaining;
+    for (size_t i = 0; i < points.size(); i++) {
+        if (i % 5 != 0) remaining.push_back(points[i]);
+    }
+    points.swap(remaining);
+    TEST_ASSERT_EQUAL(points.size(), index.size());
+
+    SpatialPoint_t found;
+    for (size_t i = 0; i < points.size(); i++) {
+        TEST_ASSERT_TRUE(index.find(points[i].id, &found));
+        TEST_ASSERT_TRUE(found.latitude == points[i].latitude && found.zone == points[i].zone);
+    }
+
+    std::vector<SpatialHit_t> hits;
+    index.withinRadius(CITY_LATITUDE, CITY_LONGITUDE, 2500.0, 0, &hits);
+    assertSameHits(bruteForce(CITY_LATITUDE, CITY_LONGITUDE, 2500.0, 0), hits);
+}
+
+void test_zone_query() {
+    SpatialIndex index;
+    fill(index);
+    points[0].zone = 200;
+    index.upsert(points[0]);
+    index.remove(points[14].id);  // Zone 1
+
+    std::vector<uint64_t> ids;
+    TEST_ASSERT_EQUAL(1, index.inZone(200, &ids));
+    TEST_ASSERT_TRUE(ids[0] == points[0].id);
+
+    index.inZone(1, &ids);
+    std::sort(ids.begin(), ids.end());
+    std::vector<uint64_t> expected;
+    for (size_t i = 0; i < points.size(); i++) {
+        if (points[i].zone == 1 && i != 14 && i != 0) expected.push_back(points[i].id);
+    }
+    TEST_ASSERT_TRUE(ids == expected);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_distance_matches_haversine_at_city_scale);
+    RUN_TEST(test_radius_matches_brute_force);
+    RUN_TEST(test_large_radius_uses_full_scan);
+    RUN_TEST(test_nearest_matches_brute_force);
+    RUN_TEST(test_nearest_far_from_all_points);
+    RUN_TEST(test_moves_and_removals_keep_index_consistent);
+    RUN_TEST(test_zone_query);
+    return UNITY_END();
+}
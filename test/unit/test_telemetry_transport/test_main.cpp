@@ -0,0 +1,278 @@
+/**
+ * BINSAI Unit Test - Telemetry Transport
+ * MQTT client against the loopback broker on a virtual clock: QoS 1 acks,
+ * offline queueing, DUP resend on a resumed session, queue overflow and
+ * health reports on the event topic.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <MqttClient.h>
+#include <MqttLoopbackBroker.h>
+#include <TelemetryTransport.h>
+
+static SensorData_t sample;
+static MqttClientConfig_t config;
+static char topic[48];
+static uint32_t now_ms;
+
+void setUp() {
+    memset(&sample, 0, sizeof(sample));
+    sample.fill_percentage = 42.5f;
+    sample.distance_cm = 21.0f;
+    sample.ppm_calculated = 180.0f;
+    sample.latitude = -7.7956;
+    sample.longitude = 110.3695;
+
+    TEST_ASSERT_TRUE(mqttTelemetryTopic("BIN-01", topic, sizeof(topic)));
+    mqttClientDefaults(&config);
+    config.client_id = "BIN-01";
+    config.topic = topic;
+    now_ms = 0;
+}
+
+void tearDown() {}
+
+static MqttLinkModel_t link(uint32_t one_way_ms) {
+    MqttLinkModel_t model;
+    model.one_way_ms = one_way_ms;
+    model.bits_per_ms = 0;
+    model.segment_overhead = MQTT_LINK_TCPIP_OVERHEAD;
+    return model;
+}
+
+static void run(MqttLoopbackBroker& broker, TelemetryTransport& transport, uint32_t duration_ms) {
+    uint32_t end = now_ms + duration_ms;
+    while (now_ms < end) {
+        broker.advance(++now_ms);
+        transport.loop(now_ms);
+    }
+}
+
+static void publish(MqttTelemetryTransport& transport, uint32_t sequence) {
+    TelemetryFrameMeta_t meta;
+    meta.device_id = "BIN-01";
+    meta.sequence = sequence;
+    meta.flags = 0;
+    meta.deployment_zone = 3;
+    meta.trace_us = 0;
+    meta.boot_epoch = 0;
+    TEST_ASSERT_TRUE(transport.publishSample(sample, meta, now_ms));
+}
+
+static uint32_t messageSequence(const MqttBrokerMessage_t& message) {
+    TelemetryFrameView view(&message.payload[0], message.payload.size());
+    TEST_ASSERT_TRUE(view.validate());
+    return view.sequence();
+}
+
+void test_remaining_length_varint() {
+    const uint32_t values[] = { 0, 127, 128, 16383, 16384, 2097151, 2097152, 268435455 };
+    const size_t sizes[] = { 1, 1, 2, 2, 3, 3, 4, 4 };
+    uint8_t buffer[4];
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        uint32_t decoded = 0;
+        TEST_ASSERT_EQUAL(sizes[i], mqttEncodeLength(values[i], buffer));
+        TEST_ASSERT_EQUAL_INT((int)sizes[i], mqttDecodeLength(buffer, sizes[i], &decoded));
+        TEST_ASSERT_EQUAL_UINT32(values[i], decoded);
+    }
+
+    const uint8_t incomplete[2] = { 0x80, 0x80 };
+    const uint8_t malformed[5] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x01 };
+    uint32_t decoded = 0;
+    TEST_ASSERT_EQUAL_INT(0, mqttDecodeLength(incomplete, sizeof(incomplete), &decoded));
+    TEST_ASSERT_EQUAL_INT(-1, mqttDecodeLength(malformed, sizeof(malformed), &decoded));
+}
+
+void test_publish_is_acknowledged() {
+    MqttLoopbackBroker broker(link(20));
+    MqttTelemetryTransport transport(broker.stream(), config);
+
+    run(broker, transport, 100);
+    TEST_ASSERT_TRUE(transport.connected());
+
+    publish(transport, 1);
+    run(broker, transport, 100);
+
+    TEST_ASSERT_EQUAL(1, broker.messages().size());
+    const MqttBrokerMessage_t& message = broker.messages()[0];
+    TEST_ASSERT_EQUAL_STRING("binsai/BIN-01/telemetry", message.topic.c_str());
+    TEST_ASSERT_EQUAL_UINT8(1, message.qos);
+    TEST_ASSERT_FALSE(message.dup);
+    TEST_ASSERT_EQUAL(TELEMETRY_FRAME_SIZE, message.payload.size());
+    TEST_ASSERT_EQUAL_UINT32(1, messageSequence(message));
+
+    const MqttStats_t& stats = transport.client().stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.acked);
+    TEST_ASSERT_EQUAL_UINT32(40, stats.last_latency_ms);  // One round trip
+    TEST_ASSERT_EQUAL(0, transport.client().queued());
+    TEST_ASSERT_EQUAL_UINT32(1, broker.stats().connects);
+}
+
+void test_offline_samples_delivered_in_order() {
+    MqttLoopbackBroker broker(link(10));
+    MqttTelemetryTransport transport(broker.stream(), config);
+    run(broker, transport, 100);
+
+    broker.setOnline(false);
+    for (uint32_t sequence = 1; sequence <= 10; sequence++) {
+        publish(transport, sequence);
+        run(broker, transport, 2000);
+    }
+    TEST_ASSERT_FALSE(transport.connected());
+    TEST_ASSERT_EQUAL(10, transport.client().queued());
+    TEST_ASSERT_EQUAL(0, broker.messages().size());
+
+    broker.setOnline(true);
+    run(broker, transport, MQTT_RECONNECT_MAX_MS + 1000);
+
+    TEST_ASSERT_TRUE(transport.connected());
+    TEST_ASSERT_EQUAL(0, transport.client().queued());
+    TEST_ASSERT_EQUAL(10, broker.messages().size());
+    for (size_t i = 0; i < broker.messages().size(); i++) {
+        TEST_ASSERT_EQUAL_UINT32(i + 1, messageSequence(broker.messages()[i]));
+        TEST_ASSERT_FALSE(broker.messages()[i].dup);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, transport.client().stats().dropped);
+    TEST_ASSERT_EQUAL_UINT32(1, broker.stats().sessions_resumed);
+}
+
+void test_lost_ack_resent_with_dup_on_resumed_session() {
+    MqttLoopbackBroker broker(link(5));
+    MqttTelemetryTransport transport(broker.stream(), config);
+    run(broker, transport, 50);
+
+    broker.setAcking(false);
+    publish(transport, 1);
+    publish(transport, 2);
+    run(broker, transport, 100);
+    TEST_ASSERT_EQUAL(2, broker.messages().size());
+    TEST_ASSERT_EQUAL(2, transport.client().queued());
+
+    // No PUBACK within ack_timeout_ms: reconnect and resend as DUP
+    broker.setAcking(true);
+    run(broker, transport, config.ack_timeout_ms + MQTT_RECONNECT_MIN_MS + 500);
+
+    TEST_ASSERT_EQUAL(0, transport.client().queued());
+    TEST_ASSERT_EQUAL(4, broker.messages().size());
+    TEST_ASSERT_TRUE(broker.messages()[2].dup);
+    TEST_ASSERT_TRUE(broker.messages()[3].dup);
+    TEST_ASSERT_EQUAL_UINT16(broker.messages()[0].packet_id, broker.messages()[2].packet_id);
+    TEST_ASSERT_EQUAL_UINT32(1, messageSequence(broker.messages()[2]));
+    TEST_ASSERT_EQUAL_UINT32(2, transport.client().stats().resent);
+    TEST_ASSERT_EQUAL_UINT32(1, transport.client().stats().session_resumed);
+}
+
+void test_full_queue_drops_oldest() {
+    MqttLoopbackBroker broker(link(5));
+    MqttTelemetryTransport transport(broker.stream(), config);
+    broker.setOnline(false);
+
+    for (uint32_t sequence = 1; sequence <= MQTT_QUEUE_DEPTH + 8; sequence++) {
+        publish(transport, sequence);
+        run(broker, transport, 10);
+    }
+    TEST_ASSERT_EQUAL(MQTT_QUEUE_DEPTH, transport.client().queued());
+    TEST_ASSERT_EQUAL_UINT32(8, transport.client().stats().dropped);
+
+    broker.setOnline(true);
+    run(broker, transport, MQTT_RECONNECT_MAX_MS + 1000);
+
+    TEST_ASSERT_EQUAL(MQTT_QUEUE_DEPTH, broker.messages().size());
+    TEST_ASSERT_EQUAL_UINT32(9, messageSequence(broker.messages()[0]));
+    TEST_ASSERT_EQUAL_UINT32(MQTT_QUEUE_DEPTH + 8, messageSequence(broker.messages().back()));
+}
+
+void test_inflight_window_limits_unacked_publishes() {
+    config.max_inflight = 2;
+    MqttLoopbackBroker broker(link(5));
+    MqttTelemetryTransport transport(broker.stream(), config);
+    run(broker, transport, 50);
+
+    broker.setAcking(false);
+    for (uint32_t sequence = 1; sequence <= 6; sequence++) {
+        publish(transport, sequence);
+    }
+    run(broker, transport, 100);
+    TEST_ASSERT_EQUAL(2, broker.messages().size());
+    TEST_ASSERT_EQUAL_UINT32(2, broker.stats().pubacks_withheld);
+}
+
+void test_keepalive_ping_holds_idle_connection() {
+    config.keepalive_s = 5;
+    MqttLoopbackBroker broker(link(30));
+    MqttTelemetryTransport transport(broker.stream(), config);
+
+    run(broker, transport, 61000);
+
+    TEST_ASSERT_TRUE(transport.connected());
+    TEST_ASSERT_EQUAL_UINT32(1, transport.client().stats().connects);
+    // CONNECT + one PINGREQ per idle keepalive period
+    TEST_ASSERT_EQUAL_UINT64(1 + 60 / 5, broker.stats().segments_up);
+}
+
+void test_oversized_payload_rejected() {
+    MqttLoopbackBroker broker(link(0));
+    MqttClient client(broker.stream(), config);
+    uint8_t payload[MQTT_MAX_PAYLOAD + 1] = {0};
+
+    TEST_ASSERT_FALSE(client.publish(payload, sizeof(payload), 0));
+    TEST_ASSERT_TRUE(client.publish(payload, MQTT_MAX_PAYLOAD, 0));
+    TEST_ASSERT_EQUAL(1, client.queued());
+}
+
+void test_health_report_on_event_topic() {
+    char health_topic[48];
+    TEST_ASSERT_TRUE(mqttHealthTopic("BIN-01", health_topic, sizeof(health_topic)));
+
+    HealthReport_t report;
+    memset(&report, 0, sizeof(report));
+    report.reset_reason = HEALTH_RESET_BROWNOUT;
+    report.boots = 7;
+    report.failures = 2;
+    report.mtbf_s = 43200;
+
+    // No event topic configured: the transport declines
+    MqttLoopbackBroker plain_broker(link(0));
+    MqttTelemetryTransport plain(plain_broker.stream(), config);
+    TEST_ASSERT_FALSE(plain.publishHealth(report, now_ms));
+
+    config.event_topic = health_topic;
+    MqttLoopbackBroker broker(link(10));
+    MqttTelemetryTransport transport(broker.stream(), config);
+    run(broker, transport, 50);
+
+    publish(transport, 1);
+    TEST_ASSERT_TRUE(transport.publishHealth(report, now_ms));
+    publish(transport, 2);
+    run(broker, transport, 100);
+
+    // Shares the QoS 1 queue, so ordering with samples is kept
+    TEST_ASSERT_EQUAL(3, broker.messages().size());
+    TEST_ASSERT_EQUAL_STRING("binsai/BIN-01/telemetry", broker.messages()[0].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("binsai/BIN-01/health", broker.messages()[1].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("binsai/BIN-01/telemetry", broker.messages()[2].topic.c_str());
+    TEST_ASSERT_EQUAL_UINT32(2, messageSequence(broker.messages()[2]));
+
+    const MqttBrokerMessage_t& message = broker.messages()[1];
+    HealthReport_t decoded;
+    TEST_ASSERT_TRUE(healthReportDecode(&message.payload[0], message.payload.size(), &decoded));
+    TEST_ASSERT_EQUAL_UINT8(HEALTH_RESET_BROWNOUT, decoded.reset_reason);
+    TEST_ASSERT_EQUAL_UINT32(43200, decoded.mtbf_s);
+    TEST_ASSERT_EQUAL_UINT32(3, transport.client().stats().acked);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_remaining_length_varint);
+    RUN_TEST(test_publish_is_acknowledged);
+    RUN_TEST(test_offline_samples_delivered_in_order);
+    RUN_TEST(test_lost_ack_resent_with_dup_on_resumed_session);
+    RUN_TEST(test_full_queue_drops_oldest);
+    RUN_TEST(test_inflight_window_limits_unacked_publishes);
+    RUN_TEST(test_keepalive_ping_holds_idle_connection);
+    RUN_TEST(test_oversized_payload_rejected);
+    RUN_TEST(test_health_report_on_event_topic);
+    return UNITY_END();
+}
@@ -0,0 +1,215 @@
+/**
+ * BINSAI Unit Test - Text Buffer
+ * Verifies bounded appends, Arduino-compatible number formatting, rolling
+ * AT reply matching and that building every alert / telemetry message
+ * performs zero heap allocations (counted through the linker-wrapped
+ * allocator, see HeapCounter.h), counted per task.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <HeapCounter.h>
+#include <TextBuffer.h>
+
+// Route operator new through malloc inside this binary so std::string
+// allocations are visible to the wrapped allocator as well
+void* operator new(size_t size) {
+    void* pointer = malloc(size ? size : 1);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_append_and_truncate() {
+    FixedText<12> text;
+    text.append("AT+CMGS=\"").append("+62").append('"');
+    TEST_ASSERT_EQUAL_STRING("AT+CMGS=\"+6", text.c_str());
+    TEST_ASSERT_EQUAL_UINT32(11, text.length());
+    TEST_ASSERT_TRUE(text.truncated());
+
+    text.clear();
+    TEST_ASSERT_FALSE(text.truncated());
+    text.appendSigned(-2147483647 - 1).append(' ');
+    TEST_ASSERT_EQUAL_STRING("-2147483648", text.c_str());
+
+    char storage[16];
+    TextBuffer external(storage, sizeof(storage));
+    external.appendUnsigned(4294967295UL).append('/').appendUnsigned(0);
+    TEST_ASSERT_EQUAL_STRING("4294967295/0", storage);
+}
+
+/**
+ * Reference: Arduino Print::printFloat, which the firmware used through
+ * Serial.print(value, digits) and String(value, digits)
+ */
+static void arduinoPrintFloat(char* out, double number, uint8_t digits) {
+    if (isnan(number)) { strcpy(out, "nan"); return; }
+    if (isinf(number)) { strcpy(out, "inf"); return; }
+    if (number > 4294967040.0) { strcpy(out, "ovf"); return; }
+    if (number < -4294967040.0) { strcpy(out, "-ovf"); return; }
+    if (number < 0.0) { *out++ = '-'; number = -number; }
+    double rounding = 0.5;
+    for (uint8_t i = 0; i < digits; i++) rounding /= 10.0;
+    number += rounding;
+    unsigned long int_part = (unsigned long)number;
+    double remainder = number - (double)int_part;
+    out += sprintf(out, "%lu", int_part);
+    if (digits > 0) *out++ = '.';
+    while (digits-- > 0) {
+        remainder *= 10.0;
+        int digit = (int)remainder;
+        *out++ = (char)('0' + digit);
+        remainder -= digit;
+    }
+    *out = '\0';
+}
+
+void test_fixed_matches_arduino_print() {
+    const double values[] = {
+        0.0, 0.004, 0.005, 1.5, 2.5, 99.995, 100.0, -0.5, -7.764200, 110.389300,
+        1999.96, 75.55f, 4294967040.0, 5e9, -5e9, NAN, INFINITY, -INFINITY
+    };
+    char expected[48];
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        for (uint8_t digits = 0; digits <= 6; digits++) {
+            FixedText<48> text;
+            text.appendFixed(values[i], digits);
+            arduinoPrintFloat(expected, values[i], digits);
+            TEST_ASSERT_EQUAL_STRING(expected, text.c_str());
+        }
+    }
+
+    FixedText<16> text;
+    text.appendFixed(450.4f, 0).append(" ppm");
+    TEST_ASSERT_EQUAL_STRING("450 ppm", text.c_str());
+}
+
+void test_rolling_reply_match() {
+    // Long +CMGL style reply followed by the final result code
+    FixedText<32> reply;
+    const char* stream = "\r\n+CSQ: 17,0\r\n\r\n+CREG: 0,1 lots of unsolicited noise here\r\n\r\nOK\r\n";
+    bool matched = false;
+    for (const char* p = stream; *p && !matched; p++) {
+        reply.pushRolling(*p);
+        matched = reply.endsWith("OK");
+    }
+    TEST_ASSERT_TRUE(matched);
+    TEST_ASSERT_TRUE(reply.length() < reply.capacity());
+    TEST_ASSERT_FALSE(reply.endsWith("ERROR"));
+    TEST_ASSERT_TRUE(reply.contains("\r\nOK"));
+}
+
+/**
+ * The message set built on the alert and logging paths of src/main.cpp
+ */
+static size_t buildSteadyStateMessages(uint32_t tick) {
+    char sms_storage[320];
+    TextBuffer sms(sms_storage, sizeof(sms_storage));
+    sms.append("[BINSAI CRITICAL ALERT] Device: ").append("BINSAI_001")
+       .append("\nCapacity: ").appendFixed(93.7, 0)
+       .append("% | Gas: ").appendFixed(812.4, 0)
+       .append(" ppm\nLocation: https://maps.google.com/?q=")
+       .appendFixed(-7.7642, 6).append(',').appendFixed(110.3893, 6);
+
+    FixedText<64> event;
+    event.append("Critical condition: ").appendFixed(93.7, 0).append("% full, ")
+         .appendFixed(812.4, 0).append(" ppm");
+
+    FixedText<17> progress;
+    progress.appendUnsigned(tick % 3).append('/').appendUnsigned(3);
+
+    FixedText<160> csv;
+    csv.append("[RESEARCH] ").appendUnsigned(tick * 60000).append(',')
+       .appendFixed(31.25, 2).append(',').appendFixed(68.75, 2).append(',')
+       .appendFixed(450.0, 2).append(',').appendUnsigned(1712).append(',')
+       .appendFixed(-7.7642, 6).append(',').appendFixed(110.3893, 6);
+
+    FixedText<40> command;
+    command.append("AT+CMGS=\"").append("+6281234567890").append('"');
+
+    FixedText<64> reply;
+    const char* at = "\r\n> \r\n+CMGS: 42\r\n\r\nOK\r\n";
+    for (const char* p = at; *p; p++) {
+        reply.pushRolling(*p);
+        if (reply.endsWith("OK")) break;
+    }
+    return sms.length() + event.length() + progress.length() + csv.length() +
+           command.length() + reply.length();
+}
+
+void test_hot_path_messages_do_not_allocate() {
+    if (!heapCounterEnabled()) {
+        TEST_IGNORE_MESSAGE("build with -DBINSAI_HEAP_COUNTER and --wrap=malloc,calloc,realloc,free");
+    }
+
+    // The counter sees allocations made from this binary
+    uint32_t before = heapAllocationCount();
+    std::string legacy = std::string("Critical condition: ") + std::to_string(93) + "% full, " +
+                         std::to_string(812) + " ppm, plus enough text to leave SSO";
+    TEST_ASSERT_TRUE(heapAllocationCount() > before);
+    TEST_ASSERT_TRUE(legacy.size() > 0);
+
+    // 1,000 iterations of the steady-state message set: zero allocations
+    before = heapAllocationCount();
+    size_t total = 0;
+    for (uint32_t tick = 0; tick < 1000; tick++) {
+        total += buildSteadyStateMessages(tick);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, heapAllocationCount() - before);
+    TEST_ASSERT_TRUE(total > 0);
+}
+
+static void allocateAndFree(int count) {
+    for (int i = 0; i < count; i++) {
+        void* volatile pointer = malloc(64);        // volatile: the pair is not elided
+        free(pointer);
+    }
+}
+
+void test_task_counter_ignores_other_threads() {
+    if (!heapCounterEnabled()) {
+        TEST_IGNORE_MESSAGE("build with -DBINSAI_HEAP_COUNTER and --wrap=malloc,calloc,realloc,free");
+    }
+    heapCounterTrackCurrentTask();
+
+    // A second thread (the WiFi / lwIP tasks on the ESP32) allocates while
+    // this one waits in join(): the totals see it, the task count does not
+    uint32_t task_seen = 0;
+    uint32_t total_seen = 0;
+    std::thread other([&task_seen, &total_seen]() {
+        uint32_t task_before = heapTaskAllocationCount();
+        uint32_t total_before = heapAllocationCount();
+        allocateAndFree(10);
+        task_seen = heapTaskAllocationCount() - task_before;
+        total_seen = heapAllocationCount() - total_before;
+    });
+    other.join();
+    TEST_ASSERT_EQUAL_UINT32(0, task_seen);
+    TEST_ASSERT_TRUE(total_seen >= 10);
+
+    uint32_t before = heapTaskAllocationCount();
+    allocateAndFree(3);
+    TEST_ASSERT_EQUAL_UINT32(3, heapTaskAllocationCount() - before);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_append_and_truncate);
+    RUN_TEST(test_fixed_matches_arduino_print);
+    RUN_TEST(test_rolling_reply_match);
+    RUN_TEST(test_hot_path_messages_do_not_allocate);
+    RUN_TEST(test_task_counter_ignores_other_threads);
+    return UNITY_END();
+}
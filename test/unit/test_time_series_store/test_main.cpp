@@ -0,0 +1,285 @@
+/**
+ * BINSAI Unit Test - Time-Series Store
+ * Gorilla codec round trips, CSV import, segment persistence through mmap,
+ * range scans across segment boundaries and downsampled aggregates.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include <GorillaCodec.h>
+#include <TimeSeriesStore.h>
+
+#define TRACE_START_MS      1767225600000LL     // 2026-01-01 00:00 UTC
+#define MINUTE_MS           60000LL
+
+static char root[64];
+
+static void removeTree(const std::string& path) {
+    std::string command = "rm -rf '" + path + "'";
+    TEST_ASSERT_EQUAL_INT(0, system(command.c_str()));
+}
+
+/**
+ * One sample per minute with millis() jitter, slowly filling bin
+ */
+static ResearchRecord_t traceRecord(uint32_t i) {
+    ResearchRecord_t record;
+    memset(&record, 0, sizeof(record));
+    record.timestamp_ms = TRACE_START_MS + i * MINUTE_MS + (int64_t)((i * 7919) % 40);
+    record.fill_percentage = fmodf(i * 0.05f, 100.0f);
+    record.distance_cm = 37.0f * (1.0f - record.fill_percentage / 100.0f);
+    record.ppm_calculated = 180.0f + (i % 60) * 1.5f;
+    record.hours_to_full = (i % 100 == 0) ? -1.0f : 20.0f - (i % 200) * 0.1f;
+    record.latitude = -7.7956123;
+    record.longitude = 110.3694876 + ((i % 17 == 0) ? 1e-6 : 0.0);
+    record.adc_raw = (uint16_t)(1200 + i % 13);
+    record.gps_fix = 1;
+    record.satellite_count = 8;
+    record.capacity_level = record.fill_percentage > 90.0f ? 3 : record.fill_percentage > 50.0f ? 2 : 0;
+    record.waste_classification = 1;
+    record.priority_level = record.capacity_level;
+    return record;
+}
+
+void setUp() {
+    strcpy(root, "/tmp/binsai_tsdb_XXXXXX");
+    TEST_ASSERT_NOT_NULL(mkdtemp(root));
+}
+
+void tearDown() {
+    removeTree(root);
+}
+
+void test_timestamp_codec_round_trip() {
+    const int64_t timestamps[] = {
+        TRACE_START_MS, TRACE_START_MS + 60000, TRACE_START_MS + 120000,     // dod 0
+        TRACE_START_MS + 180064, TRACE_START_MS + 239937,                   // +-64 edges
+        TRACE_START_MS + 300193, TRACE_START_MS + 362000,                   // 9 and 12 bit
+        TRACE_START_MS + 99999999, TRACE_START_MS - 5,                      // 64-bit fallbacks
+    };
+    const size_t count = sizeof(timestamps) / sizeof(timestamps[0]);
+
+    std::vector<uint8_t> bytes;
+    BitWriter writer(&bytes);
+    TimestampEncoder encoder(&writer);
+    for (size_t i = 0; i < count; i++) encoder.append(timestamps[i]);
+    writer.flush();
+
+    BitReader reader(bytes.data(), bytes.size());
+    TimestampDecoder decoder(&reader);
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_TRUE(decoder.next() == timestamps[i]);
+    }
+    TEST_ASSERT_FALSE(reader.overrun());
+}
+
+void test_xor_codec_round_trip() {
+    float floats[] = {12.5f, 12.5f, 12.75f, -0.0f, INFINITY, NAN, 1e-38f, 3.4e38f, 0.1f, 0.1f};
+    double doubles[] = {-7.7956123, -7.7956123, -7.7956124, 110.3694876, 0.0, -1e300};
+
+    std::vector<uint8_t> bytes;
+    BitWriter writer(&bytes);
+    XorEncoder float_encoder(&writer, 32);
+    for (size_t i = 0; i < 10; i++) {
+        uint32_t bits;
+        memcpy(&bits, &floats[i], 4);
+        float_encoder.append(bits);
+    }
+    writer.flush();
+    size_t float_bytes = bytes.size();
+    BitWriter double_writer(&bytes);
+    XorEncoder double_encoder(&double_writer, 64);
+    for (size_t i = 0; i < 6; i++) {
+        uint64_t bits;
+        memcpy(&bits, &doubles[i], 8);
+        double_encoder.append(bits);
+    }
+    double_writer.flush();
+
+    BitReader float_reader(bytes.data(), float_bytes);
+    XorDecoder float_decoder(&float_reader, 32);
+    for (size_t i = 0; i < 10; i++) {
+        uint32_t expected;
+        memcpy(&expected, &floats[i], 4);
+        TEST_ASSERT_EQUAL_UINT32(expected, (uint32_t)float_decoder.next());
+    }
+    BitReader double_reader(bytes.data() + float_bytes, bytes.size() - float_bytes);
+    XorDecoder double_decoder(&double_reader, 64);
+    for (size_t i = 0; i < 6; i++) {
+        uint64_t expected;
+        memcpy(&expected, &doubles[i], 8);
+        TEST_ASSERT_TRUE(expected == double_decoder.next());
+    }
+}
+
+void test_csv_round_trip() {
+    ResearchRecord_t record;
+    TEST_ASSERT_TRUE(researchRecordFromCsv(
+        "[RESEARCH] 61234,12.34,66.50,512.25,1834,1,-7.795612,110.369488,9,2,2,1,17.3\r\n",
+        TRACE_START_MS, &record));
+    TEST_ASSERT_TRUE(record.timestamp_ms == TRACE_START_MS + 61234);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 66.5f, record.fill_percentage);
+    TEST_ASSERT_EQUAL_UINT16(1834, record.adc_raw);
+    TEST_ASSERT_EQUAL_UINT8(9, record.satellite_count);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 17.3f, record.hours_to_full);
+
+    char line[160];
+    researchRecordToCsv(record, TRACE_START_MS, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("61234,12.34,66.50,512.25,1834,1,-7.795612,110.369488,9,2,2,1,17.3", line);
+
+    TEST_ASSERT_FALSE(researchRecordFromCsv("61234,12.34,66.50", 0, &record));
+    TEST_ASSERT_FALSE(researchRecordFromCsv("a,1,2,3,4,5,6,7,8,9,10,11,12", 0, &record));
+    TEST_ASSERT_FALSE(researchRecordFromCsv("0,1,2,3,4,5,6,7,8,9,10,11,12,13,14", 0, &record));
+    TEST_ASSERT_FALSE(researchRecordFromCsv("0,1,2,3,4,5,6,7,8,9,10,11,12,", 0, &record));
+}
+
+void test_csv_synced_wall_clock() {
+    ResearchRecord_t record;
+    TEST_ASSERT_TRUE(researchRecordFromCsv(
+        "[RESEARCH] 61234,12.34,66.50,512.25,1834,1,-7.795612,110.369488,9,2,2,1,17.3,1792411200123\r\n",
+        TRACE_START_MS, &record));
+    TEST_ASSERT_TRUE(record.timestamp_ms == 1792411200123LL);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 17.3f, record.hours_to_full);
+
+    // Not synced yet: falls back to base + millis
+    TEST_ASSERT_TRUE(researchRecordFromCsv(
+        "61234,12.34,66.50,512.25,1834,1,-7.795612,110.369488,9,2,2,1,17.3,0", TRACE_START_MS, &record));
+    TEST_ASSERT_TRUE(record.timestamp_ms == TRACE_START_MS + 61234);
+}
+
+void test_persist_and_reopen_bit_exact() {
+    const uint32_t count = TS_SEGMENT_RECORDS + 500;   // One full segment + partial
+    {
+        TimeSeriesStore store(root);
+        TEST_ASSERT_TRUE(store.open());
+        for (uint32_t i = 0; i < count; i++) {
+            TEST_ASSERT_TRUE(store.append("BINSAI-AA:BB:CC", traceRecord(i)));
+        }
+        TEST_ASSERT_TRUE(store.flush());
+    }
+
+    TimeSeriesStore store(root);
+    TEST_ASSERT_TRUE(store.open());
+    TEST_ASSERT_EQUAL_UINT64(count, store.storedRecords());
+    TEST_ASSERT_EQUAL(1, store.devices().size());
+
+    uint32_t index = 0;
+    bool exact = true;
+    store.scan("BINSAI-AA:BB:CC", INT64_MIN, INT64_MAX, [&](const ResearchRecord_t& record) {
+        ResearchRecord_t expected = traceRecord(index++);
+        exact = exact && memcmp(&expected, &record, sizeof(record)) == 0;
+    });
+    TEST_ASSERT_EQUAL_UINT32(count, index);
+    TEST_ASSERT_TRUE(exact);
+
+    // Compression: well below the raw in-memory record size
+    TEST_ASSERT_TRUE(store.storedBytes() < (uint64_t)count * sizeof(ResearchRecord_t) / 3);
+}
+
+void test_range_scan_across_segments() {
+    TimeSeriesStore store(root);
+    TEST_ASSERT_TRUE(store.open());
+    for (uint32_t i = 0; i < TS_SEGMENT_RECORDS * 2; i++) {
+        store.append("BIN-R", traceRecord(i));
+    }
+    store.flush();
+
+    // Minutes [8000, 8400) straddle the first segment boundary (8192)
+    int64_t from = TRACE_START_MS + 8000 * MINUTE_MS;
+    int64_t to = TRACE_START_MS + 8400 * MINUTE_MS;
+    int64_t first = 0, last = 0;
+    size_t visited = store.scan("BIN-R", from, to, [&](const ResearchRecord_t& record) {
+        if (first == 0) first = record.timestamp_ms;
+        last = record.timestamp_ms;
+    });
+    TEST_ASSERT_EQUAL(400, visited);
+    TEST_ASSERT_TRUE(first >= from && last < to);
+    TEST_ASSERT_EQUAL(0, store.scan("BIN-R", to, from, [](const ResearchRecord_t&) {}));
+    TEST_ASSERT_EQUAL(0, store.scan("UNKNOWN", from, to, [](const ResearchRecord_t&) {}));
+}
+
+void test_hourly_aggregate_matches_brute_force() {
+    TimeSeriesStore store(root);
+    TEST_ASSERT_TRUE(store.open());
+    const uint32_t count = 3 * 24 * 60;
+    for (uint32_t i = 0; i < count; i++) store.append("BIN-A", traceRecord(i));
+    store.flush();
+
+    std::vector<TsAggregate_t> hours;
+    const int64_t hour = 60 * MINUTE_MS;
+    TEST_ASSERT_EQUAL(72, store.aggregate("BIN-A", TS_COLUMN_PPM, INT64_MIN, INT64_MAX, hour, &hours));
+
+    for (size_t h = 0; h < hours.size(); h++) {
+        double sum = 0.0, min = 1e9, max = -1e9;
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            ResearchRecord_t record = traceRecord(i);
+            if (record.timestamp_ms / hour * hour != hours[h].bucket_start_ms) continue;
+            sum += record.ppm_calculated;
+            min = fmin(min, record.ppm_calculated);
+            max = fmax(max, record.ppm_calculated);
+            n++;
+        }
+        TEST_ASSERT_EQUAL_UINT32(n, hours[h].count);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, sum / n, hours[h].mean);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, min, hours[h].min);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, max, hours[h].max);
+    }
+    TEST_ASSERT_EQUAL(TS_COLUMN_FILL, tsColumnFromName("FILL"));
+    TEST_ASSERT_EQUAL(-1, tsColumnFromName("volume"));
+}
+
+void test_rejects_bad_input() {
+    TimeSeriesStore store(root);
+    TEST_ASSERT_TRUE(store.open());
+    TEST_ASSERT_FALSE(store.append("", traceRecord(0)));
+    TEST_ASSERT_FALSE(store.append("../etc", traceRecord(0)));
+    TEST_ASSERT_FALSE(store.append("a/b", traceRecord(0)));
+
+    TEST_ASSERT_TRUE(store.append("BIN-O", traceRecord(10)));
+    TEST_ASSERT_FALSE(store.append("BIN-O", traceRecord(9)));
+    store.flush();
+    TEST_ASSERT_FALSE(store.append("BIN-O", traceRecord(10)));
+    TEST_ASSERT_TRUE(store.append("BIN-O", traceRecord(11)));
+}
+
+void test_open_skips_torn_and_corrupt_segments() {
+    {
+        TimeSeriesStore store(root);
+        store.open();
+        for (uint32_t i = 0; i < 100; i++) store.append("BIN-C", traceRecord(i));
+        store.flush();
+    }
+    std::string partition = std::string(root) + "/BIN-C/";
+    FILE* torn = fopen((partition + "00000000deadbeef.tsb.tmp").c_str(), "wb");
+    fputs("partial", torn);
+    fclose(torn);
+    FILE* corrupt = fopen((partition + "00000000cafebabe.tsb").c_str(), "wb");
+    fputs("not a segment header but long enough to be read as one.................", corrupt);
+    fclose(corrupt);
+
+    TimeSeriesStore store(root);
+    TEST_ASSERT_TRUE(store.open());
+    TEST_ASSERT_EQUAL_UINT64(100, store.storedRecords());
+    TEST_ASSERT_EQUAL_INT(-1, access((partition + "00000000deadbeef.tsb.tmp").c_str(), F_OK));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_timestamp_codec_round_trip);
+    RUN_TEST(test_xor_codec_round_trip);
+    RUN_TEST(test_csv_round_trip);
+    RUN_TEST(test_csv_synced_wall_clock);
+    RUN_TEST(test_persist_and_reopen_bit_exact);
+    RUN_TEST(test_range_scan_across_segments);
+    RUN_TEST(test_hourly_aggregate_matches_brute_force);
+    RUN_TEST(test_rejects_bad_input);
+    RUN_TEST(test_open_skips_torn_and_corrupt_segments);
+    return UNITY_END();
+}
@@ -0,0 +1,163 @@
+/**
+ * BINSAI Unit Test - Time Service
+ * Calendar conversion, SIM800L clock parsing, source priority with
+ * holdover, RTC drift estimation and retention across deep sleep.
+ */
+
+#include <unity.h>
+#include <TimeService.h>
+
+#define T0_MS       1792411200000LL     // 2026-10-19 12:00:00 UTC
+#define HOUR_US     3600000000ULL
+
+void setUp() {}
+void tearDown() {}
+
+void test_civil_vectors() {
+    TEST_ASSERT_EQUAL_INT64(0, timeFromCivil(1970, 1, 1, 0, 0, 0));
+    TEST_ASSERT_EQUAL_INT64(TIME_MIN_UNIX_S, timeFromCivil(2025, 1, 1, 0, 0, 0));
+    TEST_ASSERT_EQUAL_INT64(1709251199LL, timeFromCivil(2024, 2, 29, 23, 59, 59));
+    TEST_ASSERT_EQUAL_INT64(T0_MS / 1000, timeFromCivil(2026, 10, 19, 12, 0, 0));
+}
+
+void test_parse_cclk() {
+    int64_t unix_ms = 0;
+    TEST_ASSERT_TRUE(timeParseCclk("\r\n+CCLK: \"26/10/19,19:00:00+28\"\r\n\r\nOK\r\n", &unix_ms));
+    TEST_ASSERT_EQUAL_INT64(T0_MS, unix_ms);     // WIB, UTC+7
+
+    TEST_ASSERT_TRUE(timeParseCclk("+CCLK: \"26/10/19,08:30:00-14\"", &unix_ms));
+    TEST_ASSERT_EQUAL_INT64(T0_MS, unix_ms);     // UTC-3:30
+
+    TEST_ASSERT_FALSE(timeParseCclk("ERROR", &unix_ms));
+    TEST_ASSERT_FALSE(timeParseCclk("+CCLK: \"26/13/19,19:00:00+28\"", &unix_ms));
+    TEST_ASSERT_FALSE(timeParseCclk("+CCLK: \"26/10/19,19:00\"", &unix_ms));
+}
+
+void test_unset_modem_clock_rejected() {
+    TimeState_t state;
+    timeServiceInit(&state);
+
+    // SIM800L without NITZ reports its 2004 default
+    int64_t unix_ms = 0;
+    TEST_ASSERT_TRUE(timeParseCclk("+CCLK: \"04/01/01,00:00:12+00\"", &unix_ms));
+    TEST_ASSERT_FALSE(timeServiceSync(&state, TIME_SOURCE_GSM, unix_ms, 1000000ULL));
+    TEST_ASSERT_FALSE(timeServiceValid(&state));
+    TEST_ASSERT_EQUAL_INT64(0, timeServiceNowMs(&state, 2000000ULL));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, timeServiceSyncAgeS(&state, 2000000ULL));
+}
+
+void test_source_priority_and_holdover() {
+    TimeState_t state;
+    timeServiceInit(&state);
+    uint64_t mono = 5000000ULL;
+
+    TEST_ASSERT_TRUE(timeServiceSync(&state, TIME_SOURCE_GSM, T0_MS, mono));
+    TEST_ASSERT_EQUAL_UINT8(TIME_SOURCE_GSM, state.source);
+    TEST_ASSERT_EQUAL_INT64(T0_MS + 2000, timeServiceNowMs(&state, mono + 2000000ULL));
+
+    // GPS takes over and steps the clock by the GSM error
+    mono += 60000000ULL;
+    TEST_ASSERT_TRUE(timeServiceSync(&state, TIME_SOURCE_GPS, T0_MS + 60400, mono));
+    TEST_ASSERT_EQUAL_UINT8(TIME_SOURCE_GPS, state.source);
+    TEST_ASSERT_EQUAL_INT32(400, state.last_step_ms);
+
+    // GSM is ignored while the GPS sync is within the holdover
+    mono += HOUR_US;
+    TEST_ASSERT_FALSE(timeServiceSync(&state, TIME_SOURCE_GSM, T0_MS + 3660000, mono));
+    TEST_ASSERT_EQUAL_UINT8(TIME_SOURCE_GPS, state.source);
+    TEST_ASSERT_EQUAL_UINT32(3600, timeServiceSyncAgeS(&state, mono));
+
+    // ... and accepted once GPS has been gone for longer
+    mono += (uint64_t)TIME_HOLDOVER_S * 1000000ULL;
+    int64_t truth = T0_MS + 60400 + (int64_t)(HOUR_US / 1000) + TIME_HOLDOVER_S * 1000LL;
+    TEST_ASSERT_TRUE(timeServiceSync(&state, TIME_SOURCE_GSM, truth, mono));
+    TEST_ASSERT_EQUAL_UINT8(TIME_SOURCE_GSM, state.source);
+
+    // NTP always wins
+    mono += 1000000ULL;
+    TEST_ASSERT_TRUE(timeServiceSync(&state, TIME_SOURCE_NTP, truth + 1000, mono));
+    TEST_ASSERT_EQUAL_UINT16(4, state.syncs);
+    TEST_ASSERT_EQUAL_STRING("ntp", timeSourceName(state.source));
+}
+
+void test_drift_estimate_shrinks_holdover_error() {
+    // RTC slow clock runs 200 ppm fast; NTP syncs hourly for 4 hours with
+    // frequent GPS fixes in between
+    const double ppm = 200.0;
+    TimeState_t state;
+    timeServiceInit(&state);
+    uint64_t mono = 0;
+    int64_t truth = T0_MS;
+    for (uint32_t minute = 0; minute <= 240; minute++) {
+        if (minute % 60 == 0) {
+            TEST_ASSERT_TRUE(timeServiceSync(&state, TIME_SOURCE_NTP, truth, mono));
+        } else if (minute % 60 < 5) {
+            timeServiceSync(&state, TIME_SOURCE_GPS, truth, mono);
+        }
+        truth += 60000;
+        mono += (uint64_t)(60000000.0 * (1.0 + ppm * 1e-6));
+    }
+    TEST_ASSERT_TRUE(state.drift_samples >= 3);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 200.0f, state.drift_ppm);
+
+    // Six hours of holdover: uncorrected error would be about 4.3 s
+    TimeState_t uncorrected = state;
+    uncorrected.drift_ppm = 0.0f;
+    int64_t anchor = state.anchor_unix_ms;
+    uint64_t held = state.anchor_mono_us + (uint64_t)(6.0 * HOUR_US * (1.0 + ppm * 1e-6));
+    int64_t expected = anchor + 6 * (int64_t)(HOUR_US / 1000);
+    int64_t error = timeServiceNowMs(&state, held) - expected;
+    int64_t raw_error = timeServiceNowMs(&uncorrected, held) - expected;
+    TEST_ASSERT_TRUE(raw_error > 4000);
+    TEST_ASSERT_TRUE(error < 100 && error > -100);
+}
+
+void test_gsm_and_bad_samples_do_not_train_drift() {
+    TimeState_t state;
+    timeServiceInit(&state);
+    TEST_ASSERT_TRUE(timeServiceSync(&state, TIME_SOURCE_GSM, T0_MS, 0));
+    TEST_ASSERT_TRUE(timeServiceSync(&state, TIME_SOURCE_GSM, T0_MS + 3600000 + 1000, HOUR_US));
+    TEST_ASSERT_EQUAL_UINT8(0, state.drift_samples);
+
+    // A GPS fix 30 s off after an hour is a bad fix, not 8000 ppm of drift
+    TEST_ASSERT_TRUE(timeServiceSync(&state, TIME_SOURCE_GPS, T0_MS + 7200000, 2 * HOUR_US));
+    TEST_ASSERT_TRUE(timeServiceSync(&state, TIME_SOURCE_GPS, T0_MS + 10800000 + 30000, 3 * HOUR_US));
+    TEST_ASSERT_EQUAL_UINT8(0, state.drift_samples);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, state.drift_ppm);
+}
+
+void test_restore_across_sleep_and_power_loss() {
+    TimeState_t state;
+    timeServiceInit(&state);
+    TEST_ASSERT_FALSE(timeServiceRestore(&state, 10));     // Kept, but no time yet
+    TEST_ASSERT_EQUAL_UINT32(TIME_STATE_MAGIC, state.magic);
+
+    TEST_ASSERT_TRUE(timeServiceSync(&state, TIME_SOURCE_NTP, T0_MS, 2 * HOUR_US));
+
+    // Deep sleep: RTC kept counting
+    TEST_ASSERT_TRUE(timeServiceRestore(&state, 3 * HOUR_US));
+    TEST_ASSERT_EQUAL_INT64(T0_MS + 3600000, timeServiceNowMs(&state, 3 * HOUR_US));
+
+    // Power loss: monotonic clock restarted below the anchor
+    TEST_ASSERT_FALSE(timeServiceRestore(&state, 1000000ULL));
+    TEST_ASSERT_FALSE(timeServiceValid(&state));
+    TEST_ASSERT_EQUAL_INT64(0, timeServiceNowMs(&state, 2000000ULL));
+
+    // Garbage in RTC memory after a cold boot
+    state.magic = 0xDEADBEEF;
+    state.source = TIME_SOURCE_NTP;
+    TEST_ASSERT_FALSE(timeServiceRestore(&state, 5 * HOUR_US));
+    TEST_ASSERT_FALSE(timeServiceValid(&state));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_civil_vectors);
+    RUN_TEST(test_parse_cclk);
+    RUN_TEST(test_unset_modem_clock_rejected);
+    RUN_TEST(test_source_priority_and_holdover);
+    RUN_TEST(test_drift_estimate_shrinks_holdover_error);
+    RUN_TEST(test_gsm_and_bad_samples_do_not_train_drift);
+    RUN_TEST(test_restore_across_sleep_and_power_loss);
+    return UNITY_END();
+}
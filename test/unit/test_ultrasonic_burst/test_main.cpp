@@ -0,0 +1,126 @@
+/**
+ * BINSAI Unit Test - Ultrasonic Burst
+ * Ping timing, cross-talk and blind-zone rejection, trimmed surface
+ * estimate, spread and confidence on synthetic bursts.
+ */
+
+#include <unity.h>
+#include <UltrasonicBurst.h>
+
+#define SPEED       0.0346f     // cm/us at 25 C
+#define BIN_RANGE   45.0f       // Bin depth plus mounting offset
+
+void setUp() {}
+void tearDown() {}
+
+static uint32_t echoFor(float cm) {
+    return (uint32_t)(2.0f * cm / SPEED + 0.5f);
+}
+
+static void fillBurst(uint32_t* echo, const float* cm, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        echo[i] = cm[i] > 0.0f ? echoFor(cm[i]) : 0;
+    }
+}
+
+void test_ping_timing() {
+    // 400 cm round trip at 346 m/s plus ring-down
+    TEST_ASSERT_UINT32_WITHIN(5, 23121 + BURST_RING_DOWN_US, burstPingPeriodUs(SPEED));
+    TEST_ASSERT_UINT32_WITHIN(2, 2601, burstEchoTimeoutUs(BIN_RANGE, SPEED));
+    // Slower sound in cold air: longer period
+    TEST_ASSERT_TRUE(burstPingPeriodUs(0.0331f) > burstPingPeriodUs(SPEED));
+}
+
+void test_flat_surface() {
+    const float cm[7] = { 20.1f, 19.9f, 20.0f, 20.2f, 19.8f, 20.0f, 20.1f };
+    uint32_t echo[7];
+    fillBurst(echo, cm, 7);
+
+    BurstEstimate_t estimate;
+    TEST_ASSERT_TRUE(burstEstimate(echo, 7, SPEED, BIN_RANGE, &estimate));
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 20.0f, estimate.distance_cm);
+    TEST_ASSERT_TRUE(estimate.spread_cm < 0.2f);
+    TEST_ASSERT_EQUAL_UINT8(7, estimate.accepted);
+    TEST_ASSERT_EQUAL_UINT8(0, estimate.outliers);
+    TEST_ASSERT_TRUE(estimate.confidence >= 97);
+    TEST_ASSERT_FALSE(estimate.in_blind_zone);
+}
+
+void test_cross_talk_and_timeouts_rejected() {
+    // Two stale echoes from the previous ping and one lost echo
+    const float cm[7] = { 30.2f, 6.5f, 29.8f, 30.0f, 0.0f, 11.0f, 30.1f };
+    uint32_t echo[7];
+    fillBurst(echo, cm, 7);
+
+    BurstEstimate_t estimate;
+    TEST_ASSERT_TRUE(burstEstimate(echo, 7, SPEED, BIN_RANGE, &estimate));
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 30.0f, estimate.distance_cm);
+    TEST_ASSERT_EQUAL_UINT8(4, estimate.accepted);
+    TEST_ASSERT_EQUAL_UINT8(2, estimate.outliers);
+    TEST_ASSERT_EQUAL_UINT8(1, estimate.no_echo);
+    TEST_ASSERT_TRUE(estimate.confidence < 60);   // Only 4 of 7 pings agree
+
+    // Echo from beyond the bin (lid open, wall behind) counts as missing
+    echo[4] = echoFor(120.0f);
+    TEST_ASSERT_TRUE(burstEstimate(echo, 7, SPEED, BIN_RANGE, &estimate));
+    TEST_ASSERT_EQUAL_UINT8(1, estimate.no_echo);
+}
+
+void test_uneven_surface_spread() {
+    // Heap: pings land between 15 and 25 cm
+    const float cm[9] = { 15.0f, 25.0f, 18.0f, 22.0f, 20.0f, 16.5f, 23.5f, 19.0f, 21.0f };
+    uint32_t echo[9];
+    fillBurst(echo, cm, 9);
+
+    BurstEstimate_t estimate;
+    TEST_ASSERT_TRUE(burstEstimate(echo, 9, SPEED, BIN_RANGE, &estimate));
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, 20.0f, estimate.distance_cm);
+    TEST_ASSERT_EQUAL_UINT8(9, estimate.accepted);   // Wide but consistent: nothing rejected
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, 3.0f, estimate.spread_cm);
+    TEST_ASSERT_UINT32_WITHIN(2, 70, estimate.confidence);
+}
+
+void test_blind_zone_majority_reads_full() {
+    const float cm[5] = { 1.2f, 1.5f, 0.0f, 1.0f, 3.5f };
+    uint32_t echo[5];
+    fillBurst(echo, cm, 5);
+
+    BurstEstimate_t estimate;
+    TEST_ASSERT_TRUE(burstEstimate(echo, 5, SPEED, BIN_RANGE, &estimate));
+    TEST_ASSERT_TRUE(estimate.in_blind_zone);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, estimate.distance_cm);
+    TEST_ASSERT_EQUAL_UINT8(3, estimate.blind);
+    TEST_ASSERT_EQUAL_UINT8(60, estimate.confidence);
+}
+
+void test_no_majority_fails() {
+    const float cm[6] = { 0.0f, 0.0f, 1.0f, 25.0f, 0.0f, 24.8f };
+    uint32_t echo[6];
+    fillBurst(echo, cm, 6);
+
+    BurstEstimate_t estimate;
+    TEST_ASSERT_FALSE(burstEstimate(echo, 6, SPEED, BIN_RANGE, &estimate));
+    TEST_ASSERT_EQUAL_UINT8(3, estimate.no_echo);
+    TEST_ASSERT_FALSE(burstEstimate(echo, 0, SPEED, BIN_RANGE, &estimate));
+}
+
+void test_single_ping_matches_legacy_path() {
+    uint32_t echo = echoFor(33.0f);
+    BurstEstimate_t estimate;
+    TEST_ASSERT_TRUE(burstEstimate(&echo, 1, SPEED, BIN_RANGE, &estimate));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, echo * SPEED / 2.0f, estimate.distance_cm);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, estimate.spread_cm);
+    TEST_ASSERT_EQUAL_UINT8(100, estimate.confidence);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ping_timing);
+    RUN_TEST(test_flat_surface);
+    RUN_TEST(test_cross_talk_and_timeouts_rejected);
+    RUN_TEST(test_uneven_surface_spread);
+    RUN_TEST(test_blind_zone_majority_reads_full);
+    RUN_TEST(test_no_majority_fails);
+    RUN_TEST(test_single_ping_matches_legacy_path);
+    return UNITY_END();
+}
@@ -0,0 +1,123 @@
+/**
+ * BINSAI Unit Test - Waste Classifier
+ * Verifies breakpoint semantics, hysteresis bands and dwell time.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <WasteClassifier.h>
+
+static HysteresisClassifier classifier;
+static ClassifierTable_t capacity_table;
+
+void setUp() {
+    classifierDefaultCapacityTable(&capacity_table);
+    classifier.configure(capacity_table);
+    classifier.reset();
+}
+
+void tearDown() {}
+
+void test_boundaries_match_research_thresholds() {
+    const float* bp = capacity_table.breakpoints;
+    TEST_ASSERT_EQUAL_UINT8(0, classifyLevel(bp, 0.0f));
+    TEST_ASSERT_EQUAL_UINT8(0, classifyLevel(bp, 35.0f));
+    TEST_ASSERT_EQUAL_UINT8(1, classifyLevel(bp, 35.5f));
+    TEST_ASSERT_EQUAL_UINT8(1, classifyLevel(bp, 50.0f));
+    TEST_ASSERT_EQUAL_UINT8(2, classifyLevel(bp, 50.5f));
+    TEST_ASSERT_EQUAL_UINT8(2, classifyLevel(bp, 90.0f));
+    TEST_ASSERT_EQUAL_UINT8(3, classifyLevel(bp, 90.1f));
+    TEST_ASSERT_EQUAL_UINT8(3, classifyLevel(bp, 100.0f));
+}
+
+void test_gas_table_levels() {
+    ClassifierTable_t gas;
+    classifierDefaultGasTable(&gas);
+    TEST_ASSERT_EQUAL_UINT8(0, classifyLevel(gas.breakpoints, 199.0f));
+    TEST_ASSERT_EQUAL_UINT8(1, classifyLevel(gas.breakpoints, 200.0f));
+    TEST_ASSERT_EQUAL_UINT8(2, classifyLevel(gas.breakpoints, 450.0f));
+    TEST_ASSERT_EQUAL_UINT8(3, classifyLevel(gas.breakpoints, 801.0f));
+}
+
+void test_first_sample_reported_immediately() {
+    TEST_ASSERT_EQUAL_UINT8(2, classifier.update(70.0f, 0));
+}
+
+void test_noise_at_boundary_does_not_flap() {
+    classifier.update(49.0f, 0);
+    // Jitter of +/-1.5% around the 50% breakpoint stays inside the 2% band
+    for (uint32_t t = 2000; t < 120000; t += 2000) {
+        float value = ((t / 2000) % 2) ? 51.5f : 48.5f;
+        TEST_ASSERT_EQUAL_UINT8(1, classifier.update(value, t));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, classifier.transitionCount());
+}
+
+void test_level_change_requires_dwell() {
+    classifier.update(40.0f, 0);
+    TEST_ASSERT_EQUAL_UINT8(1, classifier.update(60.0f, 2000));
+    TEST_ASSERT_EQUAL_UINT8(1, classifier.update(60.0f, 4000));
+    TEST_ASSERT_EQUAL_UINT8(1, classifier.update(60.0f, 6000));
+    TEST_ASSERT_EQUAL_UINT8(2, classifier.update(60.0f, 8000));
+    TEST_ASSERT_EQUAL_UINT32(1, classifier.transitionCount());
+}
+
+void test_interrupted_candidate_restarts_dwell() {
+    classifier.update(40.0f, 0);
+    classifier.update(60.0f, 2000);
+    classifier.update(40.0f, 4000);      // Back inside current level
+    classifier.update(60.0f, 6000);
+    TEST_ASSERT_EQUAL_UINT8(1, classifier.update(60.0f, 10000));
+    TEST_ASSERT_EQUAL_UINT8(2, classifier.update(60.0f, 12000));
+}
+
+void test_falling_requires_band_below_breakpoint() {
+    classifier.update(95.0f, 0);
+    // 89% is below 90 but inside the band: stays FULL
+    for (uint32_t t = 2000; t <= 20000; t += 2000) {
+        TEST_ASSERT_EQUAL_UINT8(3, classifier.update(89.0f, t));
+    }
+    classifier.update(87.0f, 22000);
+    TEST_ASSERT_EQUAL_UINT8(2, classifier.update(87.0f, 28000));
+}
+
+void test_bin_emptied_jumps_multiple_levels() {
+    classifier.update(95.0f, 0);
+    classifier.update(5.0f, 2000);
+    TEST_ASSERT_EQUAL_UINT8(0, classifier.update(5.0f, 8000));
+}
+
+void test_invalid_tables_rejected() {
+    ClassifierTable_t bad = capacity_table;
+    bad.breakpoints[1] = 20.0f;           // Not ascending
+    TEST_ASSERT_FALSE(classifierTableValid(bad));
+    TEST_ASSERT_FALSE(classifier.configure(bad));
+
+    bad = capacity_table;
+    bad.hysteresis = -1.0f;
+    TEST_ASSERT_FALSE(classifierTableValid(bad));
+
+    bad = capacity_table;
+    bad.breakpoints[0] = NAN;
+    TEST_ASSERT_FALSE(classifierTableValid(bad));
+}
+
+void test_nan_sample_keeps_level() {
+    classifier.update(70.0f, 0);
+    TEST_ASSERT_EQUAL_UINT8(2, classifier.update(NAN, 2000));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_boundaries_match_research_thresholds);
+    RUN_TEST(test_gas_table_levels);
+    RUN_TEST(test_first_sample_reported_immediately);
+    RUN_TEST(test_noise_at_boundary_does_not_flap);
+    RUN_TEST(test_level_change_requires_dwell);
+    RUN_TEST(test_interrupted_candidate_restarts_dwell);
+    RUN_TEST(test_falling_requires_band_below_breakpoint);
+    RUN_TEST(test_bin_emptied_jumps_multiple_levels);
+    RUN_TEST(test_invalid_tables_rejected);
+    RUN_TEST(test_nan_sample_keeps_level);
+    return UNITY_END();
+}